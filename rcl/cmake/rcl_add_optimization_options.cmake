@@ -0,0 +1,83 @@
+# Copyright 2019 Open Source Robotics Foundation, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+#
+# Applies the optional link time and profile guided optimization settings to
+# a library target.
+# The settings are controlled by cache variables so they apply uniformly to
+# all of the rcl libraries in a workspace build:
+#
+# - RCL_ENABLE_LTO (default OFF): compile and link with link time optimization.
+# - RCL_PGO_MODE (default "off"): "generate" instruments the library so running
+#   a training workload writes profile data, "use" compiles with a previously
+#   recorded profile.
+# - RCL_PGO_PROFILE_DIR: directory the profile data is written to and read
+#   from.
+#
+# The expected profile guided optimization flow is to build the workspace with
+# RCL_PGO_MODE=generate, run a representative workload (the package test
+# suites exercise the publish/take/wait/timer loops and the yaml parser
+# corpus), and then rebuild with RCL_PGO_MODE=use pointing at the same
+# profile directory.
+#
+# Both settings are only supported for gcc and clang and are silently skipped
+# for other compilers.
+#
+# :param library_target: the library target
+# :type library_target: string
+#
+# @public
+#
+function(rcl_add_optimization_options library_target)
+  option(RCL_ENABLE_LTO "Enable link time optimization for the rcl libraries" OFF)
+  set(RCL_PGO_MODE "off" CACHE STRING
+    "Profile guided optimization mode for the rcl libraries (off, generate, or use)")
+  set_property(CACHE RCL_PGO_MODE PROPERTY STRINGS "off" "generate" "use")
+  set(RCL_PGO_PROFILE_DIR "${CMAKE_BINARY_DIR}/rcl_pgo_profiles" CACHE PATH
+    "Directory profile guided optimization data is written to and read from")
+
+  if(NOT (CMAKE_C_COMPILER_ID STREQUAL "GNU" OR CMAKE_C_COMPILER_ID MATCHES "Clang"))
+    if(RCL_ENABLE_LTO OR NOT RCL_PGO_MODE STREQUAL "off")
+      message(WARNING
+        "rcl_add_optimization_options() skipped: only supported for gcc and clang")
+    endif()
+    return()
+  endif()
+
+  set(_optimization_flags "")
+  if(RCL_ENABLE_LTO)
+    list(APPEND _optimization_flags "-flto")
+  endif()
+  if(RCL_PGO_MODE STREQUAL "generate")
+    list(APPEND _optimization_flags "-fprofile-generate=${RCL_PGO_PROFILE_DIR}")
+  elseif(RCL_PGO_MODE STREQUAL "use")
+    list(APPEND _optimization_flags "-fprofile-use=${RCL_PGO_PROFILE_DIR}")
+    if(CMAKE_C_COMPILER_ID STREQUAL "GNU")
+      # tolerate counters that are missing or inconsistent, e.g. from
+      # training runs with multiple threads
+      list(APPEND _optimization_flags "-fprofile-correction")
+    endif()
+  elseif(NOT RCL_PGO_MODE STREQUAL "off")
+    message(FATAL_ERROR
+      "rcl_add_optimization_options() unsupported RCL_PGO_MODE: '${RCL_PGO_MODE}'")
+  endif()
+
+  if(_optimization_flags)
+    target_compile_options(${library_target} PRIVATE ${_optimization_flags})
+    # the same flags have to be present at link time for both lto and pgo
+    string(REPLACE ";" " " _optimization_link_flags "${_optimization_flags}")
+    set_property(TARGET ${library_target} APPEND_STRING
+      PROPERTY LINK_FLAGS " ${_optimization_link_flags}")
+  endif()
+endfunction()
@@ -150,6 +150,34 @@ rcl_arguments_get_unparsed(
   rcl_allocator_t allocator,
   int ** output_unparsed_indices);
 
+/// Return a borrowed view of the indices of unparsed arguments.
+/**
+ * Unlike rcl_arguments_get_unparsed this does not copy the indices; the
+ * returned array is owned by the arguments structure and stays valid until
+ * it is finalized. The caller must not modify or free it.
+ * Use rcl_arguments_get_count_unparsed() to get its length.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] args An arguments structure that has been parsed.
+ * \param[out] unparsed_indices The borrowed array of indices into the original argv array.
+ *   The output is NULL if there are no unparsed args.
+ * \return `RCL_RET_OK` if everything goes correctly, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any function arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_arguments_get_unparsed_view(
+  const rcl_arguments_t * args,
+  const int ** unparsed_indices);
+
 /// Return the number of parameter yaml files given in the arguments.
 /**
  * <hr>
@@ -199,6 +227,34 @@ rcl_arguments_get_param_files(
   rcl_allocator_t allocator,
   char *** parameter_files);
 
+/// Return a borrowed view of the yaml parameter file paths.
+/**
+ * Unlike rcl_arguments_get_param_files this does not copy anything; the
+ * returned array and the strings it points to are owned by the arguments
+ * structure and stay valid until it is finalized.
+ * The caller must not modify or free them.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] arguments An arguments structure that has been parsed.
+ * \param[out] parameter_files The borrowed array of paramter file names.
+ *   The output is NULL if there were no paramter files.
+ * \return `RCL_RET_OK` if everything goes correctly, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any function arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_arguments_get_param_files_view(
+  const rcl_arguments_t * arguments,
+  const char * const ** parameter_files);
+
 /// Return a list of arguments with ROS-specific arguments removed.
 /**
  * Some arguments may not have been intended as ROS arguments.
@@ -238,16 +294,20 @@ rcl_remove_ros_arguments(
 
 /// Copy one arguments structure into another.
 /**
+ * Parsed arguments are immutable, so the copy shares the compiled set of
+ * rules with the original by reference instead of duplicating it; the
+ * underlying storage is freed when the last structure sharing it is passed
+ * to rcl_arguments_fini().
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | Yes
- * Thread-Safe        | No
- * Uses Atomics       | No
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
  * Lock-Free          | Yes
  *
  * \param[in] args The structure to be copied.
- *  Its allocator is used to copy memory into the new structure.
  * \param[out] args_out A zero-initialized arguments structure to be copied into.
  * \return `RCL_RET_OK` if the structure was copied successfully, or
  * \return `RCL_RET_INVALID_ARGUMENT` if any function arguments are invalid, or
@@ -43,8 +43,27 @@ typedef struct rcl_client_options_t
   /// Custom allocator for the client, used for incidental allocations.
   /** For default behavior (malloc/free), use: rcl_get_default_allocator() */
   rcl_allocator_t allocator;
+  /// Capacity of the pending request table used by rcl_send_request_pipelined().
+  /**
+   * When `0` (the default) no table is allocated and the pipelined functions
+   * return an error; plain rcl_send_request() is unaffected either way.
+   */
+  size_t max_pending_requests;
 } rcl_client_options_t;
 
+/// Meta-information about one entry from rcl_client_take_ready_responses().
+typedef struct rcl_client_response_info_t
+{
+  /// Sequence number of the request this response or timeout belongs to.
+  int64_t sequence_number;
+  /// User cookie given to rcl_send_request_pipelined() for this request,
+  /// or `NULL` if the response does not match a pending request.
+  const void * user_cookie;
+  /// True if the request's deadline expired before a response arrived; in
+  /// that case the response message slot with the same index is untouched.
+  bool timed_out;
+} rcl_client_response_info_t;
+
 /// Return a rcl_client_t struct with members set to `NULL`.
 /**
  * Should be called to get a null rcl_client_t before passing to
@@ -246,6 +265,104 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_send_request(const rcl_client_t * client, const void * ros_request, int64_t * sequence_number);
 
+/// Borrow a loaned request message.
+/**
+ * The memory allocated for the ros request belongs to the middleware and must not be deallocated
+ * other than by a call to \sa rcl_return_loaned_request_from_client.
+ * The request is only returned to the middleware on a successful call to
+ * \sa rcl_send_loaned_request or \sa rcl_return_loaned_request_from_client.
+ * This enables a zero-copy request send on middlewares which support loaning,
+ * as the caller writes directly into a transport-owned buffer.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] client Client to which the allocated request is associated.
+ * \param[in] type_support Typesupport to which the internal ros request is allocated.
+ * \param[out] ros_request The pointer to be filled to a valid ros request by the middleware.
+ * \return `RCL_RET_OK` if the ros request was correctly initialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if an argument other than the ros request is null, or
+ * \return `RCL_RET_BAD_ALLOC` if the ros request could not be correctly created, or
+ * \return `RCL_RET_CLIENT_INVALID` if the client is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support request loaning, or
+ * \return `RCL_RET_ERROR` if an unexpected error occured.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_borrow_loaned_request(
+  const rcl_client_t * client,
+  const rosidl_service_type_support_t * type_support,
+  void ** ros_request);
+
+/// Return a loaned request previously borrowed from a client.
+/**
+ * The ownership of the passed in ros request will be transferred back to the middleware.
+ * Use this to give up a loan without sending; after \sa rcl_send_loaned_request succeeds the
+ * loan is returned implicitly and this must not be called for it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] client Client to which the loaned request is associated.
+ * \param[in] loaned_request Loaned request to be returned.
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if an argument is null, or
+ * \return `RCL_RET_CLIENT_INVALID` if the client is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support request loaning, or
+ * \return `RCL_RET_ERROR` if an unexpected error occured.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_return_loaned_request_from_client(
+  const rcl_client_t * client,
+  void * loaned_request);
+
+/// Send a previously borrowed request without copying it.
+/**
+ * Behaves like rcl_send_request(), except that `ros_request` must have been
+ * borrowed with \sa rcl_borrow_loaned_request from the same client, and its
+ * ownership passes back to the middleware on success so no serialization
+ * copy out of a caller buffer is needed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] client handle to the client which will make the request
+ * \param[in] ros_request pointer to the borrowed ROS request message
+ * \param[out] sequence_number the sequence number
+ * \return `RCL_RET_OK` if the request was sent successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_CLIENT_INVALID` if the client is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support request loaning, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_send_loaned_request(
+  const rcl_client_t * client,
+  void * ros_request,
+  int64_t * sequence_number);
 
 /// Take a ROS response using a client
 /**
@@ -290,6 +407,98 @@ rcl_take_response(
   rmw_request_id_t * request_header,
   void * ros_response);
 
+/// Send a request and record it in the client's pending request table.
+/**
+ * Behaves like rcl_send_request(), and additionally stores the user cookie
+ * and deadline with the returned sequence number so that
+ * rcl_client_take_ready_responses() can correlate responses and report
+ * timeouts without any bookkeeping in the caller.
+ * This is intended for clients which keep many requests in flight.
+ *
+ * The client must have been initialized with `max_pending_requests > 0` in
+ * its options; the table holds at most that many requests in flight and this
+ * function fails when all slots are taken.
+ * The slot is claimed lock-free, so several threads may send concurrently.
+ *
+ * The cookie is only stored, never dereferenced, so it may be any value that
+ * is meaningful to the caller.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] client handle to the client which will make the response
+ * \param[in] ros_request type-erased pointer to the ROS request message
+ * \param[in] user_cookie opaque value returned with the matching response
+ * \param[in] timeout duration in nanoseconds after which the request is
+ *   reported as timed out, or `0` for no deadline
+ * \param[out] sequence_number the sequence number
+ * \return `RCL_RET_OK` if the request was sent successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_CLIENT_INVALID` if the client is invalid, or
+ * \return `RCL_RET_ERROR` if the table is full or an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_send_request_pipelined(
+  const rcl_client_t * client,
+  const void * ros_request,
+  const void * user_cookie,
+  int64_t timeout,
+  int64_t * sequence_number);
+
+/// Take every arrived response and report expired requests in one call.
+/**
+ * Drains responses from the middleware until none is ready or `capacity`
+ * entries are filled, matching each against the pending request table
+ * populated by rcl_send_request_pipelined(); afterwards, pending requests
+ * whose deadline has passed are appended as entries with `timed_out` set and
+ * removed from the table.
+ * One call therefore replaces a wake + take round trip per response.
+ *
+ * `ros_responses` must hold `capacity` pointers to allocated response
+ * messages of the client's type; entry `i` of `response_infos` describes
+ * what, if anything, was written into `ros_responses[i]`.
+ * Responses that do not match a pending request (e.g. sent with plain
+ * rcl_send_request()) are still returned, with a `NULL` cookie.
+ *
+ * Unlike the sending side this function is not thread-safe: only one thread
+ * may drain a given client at a time.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ * <i>[1] only if required when filling a message, avoided for fixed sizes</i>
+ *
+ * \param[in] client handle to the client which will take the responses
+ * \param[in] capacity number of entries in ros_responses and response_infos
+ * \param[inout] ros_responses preallocated response messages to fill
+ * \param[out] response_infos per-entry sequence number, cookie, and timeout flag
+ * \param[out] count number of entries filled
+ * \return `RCL_RET_OK` if zero or more responses were taken, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_CLIENT_INVALID` if the client is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_take_ready_responses(
+  const rcl_client_t * client,
+  size_t capacity,
+  void ** ros_responses,
+  rcl_client_response_info_t * response_infos,
+  size_t * count);
+
 /// Get the name of the service that this client will request a response from.
 /**
  * This function returns the client's internal service name string.
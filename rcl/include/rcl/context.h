@@ -283,6 +283,73 @@ RCL_WARN_UNUSED
 rmw_context_t *
 rcl_context_get_rmw_context(rcl_context_t * context);
 
+/// Event counters of a context, see rcl_context_get_counters().
+typedef struct rcl_context_counters_t
+{
+  /// Number of messages successfully published by publishers on this context.
+  uint64_t messages_published;
+  /// Number of messages successfully taken by subscriptions on this context.
+  uint64_t messages_taken;
+  /// Number of completed rcl_wait() calls on wait sets of this context.
+  uint64_t wait_cycles;
+  /// Number of timer callbacks fired through rcl_timer_call().
+  uint64_t timer_calls;
+  /// Bytes moved through the serialized message publish and take calls.
+  uint64_t serialized_bytes;
+} rcl_context_counters_t;
+
+/// Enable or disable the event counters of a context.
+/**
+ * The counters are off by default, so entities on a context that never opts
+ * in pay nothing for them; while enabled, every successful publish, take,
+ * wait cycle, and timer call on the context performs one atomic add.
+ * Disabling stops the updates but keeps the accumulated values.
+ *
+ * Allocation accounting is not part of the counters; use an instrumented
+ * allocator from rcl/instrumented_allocator.h to attribute allocations.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] context object whose counters should be enabled or disabled
+ * \param[in] enabled whether the counters should be maintained from now on
+ * \return `RCL_RET_OK` if the setting was applied, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if context is `NULL` or not initialized.
+ */
+RCL_PUBLIC
+rcl_ret_t
+rcl_context_set_counters_enabled(rcl_context_t * context, bool enabled);
+
+/// Take a snapshot of the event counters of a context.
+/**
+ * The counters accumulate while enabled via
+ * rcl_context_set_counters_enabled() and read as zero beforehand.
+ * Each counter is loaded atomically, but the snapshot as a whole is only
+ * consistent if the context is quiescent while it is taken.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] context object whose counters should be read
+ * \param[out] counters where the counter values are written
+ * \return `RCL_RET_OK` if the counters were read, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_context_get_counters(rcl_context_t * context, rcl_context_counters_t * counters);
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,9 +15,16 @@
 #ifndef RCL__ERROR_HANDLING_H_
 #define RCL__ERROR_HANDLING_H_
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "rcutils/error_handling.h"
 
-/// The error handling in RCL is just an alias to the error handling in rcutils.
+#include "rcl/visibility_control.h"
+
+/// The error handling in RCL is just an alias to the error handling in rcutils,
+/// except that formatted error messages are captured lazily, see
+/// RCL_SET_ERROR_MSG_WITH_FORMAT_STRING.
 
 typedef rcutils_error_state_t rcl_error_state_t;
 typedef rcutils_error_string_t rcl_error_string_t;
@@ -27,23 +34,77 @@ typedef rcutils_error_string_t rcl_error_string_t;
 
 #define rcl_set_error_state rcutils_set_error_state
 
+// Argument null checks only guard against caller error, so they can be
+// compiled out for deployments validated externally; see the
+// RCL_DISABLE_RUNTIME_VALIDATION option in the CMake lists.
+// RCL_CHECK_FOR_NULL_WITH_MSG stays unconditional because it also guards
+// values that can legitimately be null at runtime, e.g. allocation results.
+#ifdef RCL_DISABLE_RUNTIME_VALIDATION
+#define RCL_CHECK_ARGUMENT_FOR_NULL(argument, error_return_type) (void)(argument)
+#else
 #define RCL_CHECK_ARGUMENT_FOR_NULL(argument, error_return_type) \
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(argument, error_return_type)
+#endif
 
 #define RCL_CHECK_FOR_NULL_WITH_MSG(value, msg, error_statement) \
   RCUTILS_CHECK_FOR_NULL_WITH_MSG(value, msg, error_statement)
 
 #define RCL_SET_ERROR_MSG(msg) RCUTILS_SET_ERROR_MSG(msg)
 
+/// Record a formatted error message without formatting it yet.
+/**
+ * The format string and its arguments are captured into thread-local storage
+ * and the message is only rendered when the error state is actually read via
+ * rcl_get_error_string() or rcl_get_error_state().
+ * Many callers only branch on the returned rcl_ret_t and reset the error
+ * without ever reading the string, and on those paths the snprintf() work is
+ * skipped entirely.
+ *
+ * The format string must outlive the error state, so in practice it must be a
+ * string literal.
+ * String arguments are copied when the error is recorded, so they may go out
+ * of scope afterwards; they are truncated if longer than 255 characters.
+ * Format strings using conversions that cannot be captured (e.g. `*` field
+ * widths or `%Lf`) are formatted immediately instead.
+ */
 #define RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(fmt_str, ...) \
-  RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(fmt_str, __VA_ARGS__)
+  rcl_set_error_state_deferred(__FILE__, (uint64_t)__LINE__, fmt_str, __VA_ARGS__)
+
+/// Capture a format string and its arguments as a deferred error.
+/**
+ * This is the implementation of RCL_SET_ERROR_MSG_WITH_FORMAT_STRING and is
+ * not meant to be called directly; see that macro for the supported
+ * conversions and the lifetime requirements.
+ */
+RCL_PUBLIC
+void
+rcl_set_error_state_deferred(
+  const char * file, uint64_t line, const char * format_string, ...);
+
+/// Format any pending deferred error into the rcutils error state.
+/** Implementation detail of rcl_get_error_string() and rcl_get_error_state(). */
+RCL_PUBLIC
+void
+rcl_error_state_materialize(void);
+
+/// Drop any pending deferred error without formatting it.
+/** Implementation detail of rcl_reset_error(). */
+RCL_PUBLIC
+void
+rcl_error_state_clear_deferred(void);
+
+/// Return true if a deferred error is pending.
+/** Implementation detail of rcl_error_is_set(). */
+RCL_PUBLIC
+bool
+rcl_error_state_is_deferred(void);
 
-#define rcl_error_is_set rcutils_error_is_set
+#define rcl_error_is_set() (rcl_error_state_is_deferred() || rcutils_error_is_set())
 
-#define rcl_get_error_state rcutils_get_error_state
+#define rcl_get_error_state() (rcl_error_state_materialize(), rcutils_get_error_state())
 
-#define rcl_get_error_string rcutils_get_error_string
+#define rcl_get_error_string() (rcl_error_state_materialize(), rcutils_get_error_string())
 
-#define rcl_reset_error rcutils_reset_error
+#define rcl_reset_error() (rcl_error_state_clear_deferred(), rcutils_reset_error())
 
 #endif  // RCL__ERROR_HANDLING_H_
@@ -117,6 +117,36 @@ rcl_take_event(
   const rcl_event_t * event,
   void * event_info);
 
+// Take and coalesce all queued events using the event handle.
+/**
+ * Drain every queued instance of the event with repeated takes, leaving the
+ * most recent status in event_info and reporting how many instances were
+ * consumed.
+ * A liveliness flap or network partition can queue hundreds of instances of
+ * the same event; consuming them one rcl_take_event() call per wait set wake
+ * costs one rmw round trip each, while only the latest status matters.  The
+ * status structs carry cumulative counts, so intermediate instances hold no
+ * information beyond the change count returned here.
+ *
+ * If no event was queued, `RCL_RET_EVENT_TAKE_FAILED` is returned and
+ * event_info is untouched, matching rcl_take_event().
+ *
+ * \param[in] event event object to take from
+ * \param[in, out] event_info event info object to write the latest taken data into
+ * \param[out] events_taken number of event instances consumed, 0 on failure
+ * \return `RCL_RET_OK` if at least one event was taken, or
+ * \return `RCL_RET_EVENT_TAKE_FAILED` if no event was queued, or
+ * \return `RCL_RET_BAD_ALLOC` if memory allocation failed, or
+ * \return `RCL_RET_ERROR` if an unexpected error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_event_coalesced(
+  const rcl_event_t * event,
+  void * event_info,
+  size_t * events_taken);
+
 // Finalize an event.
 /**
  * Finalize an event.
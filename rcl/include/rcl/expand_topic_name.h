@@ -122,6 +122,57 @@ rcl_expand_topic_name(
   rcl_allocator_t allocator,
   char ** output_topic_name);
 
+/// Expand a given topic name into a caller provided buffer.
+/**
+ * This is equivalent to rcl_expand_topic_name(), except that the expanded
+ * topic name is written into `buffer` instead of being allocated, so it can
+ * be used where heap allocation is not acceptable.
+ *
+ * The number of bytes the expanded name occupies, including the terminating
+ * null byte, is always stored in `required_size` when the inputs pass
+ * validation.
+ * If `buffer_size` is smaller than that, nothing is written, the error
+ * message is set, and RCL_RET_ERROR is returned; the caller can retry with a
+ * buffer of at least `*required_size` bytes.
+ *
+ * An error message may still be allocated internally if expansion fails.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] input_topic_name topic name to be expanded
+ * \param[in] node_name name of the node associated with the topic
+ * \param[in] node_namespace namespace of the node associated with the topic
+ * \param[in] substitutions string map with possible substitutions
+ * \param[out] buffer buffer the expanded topic name is written into
+ * \param[in] buffer_size size of buffer in bytes
+ * \param[out] required_size size the expanded topic name needs, including the
+ *   terminating null byte
+ * \return `RCL_RET_OK` if the topic name was expanded successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_TOPIC_NAME_INVALID` if the given topic name is invalid, or
+ * \return `RCL_RET_NODE_INVALID_NAME` if the name is invalid, or
+ * \return `RCL_RET_NODE_INVALID_NAMESPACE` if the namespace_ is invalid, or
+ * \return `RCL_RET_UNKNOWN_SUBSTITUTION` for unknown substitutions in name, or
+ * \return `RCL_RET_ERROR` if the buffer is too small, or an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_expand_topic_name_with_buffer(
+  const char * input_topic_name,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions,
+  char * buffer,
+  size_t buffer_size,
+  size_t * required_size);
+
 /// Fill a given string map with the default substitution pairs.
 /**
  * If the string map is not initialized RCL_RET_INVALID_ARGUMENT is returned.
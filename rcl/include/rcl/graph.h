@@ -30,6 +30,8 @@ extern "C"
 #include "rcl/macros.h"
 #include "rcl/client.h"
 #include "rcl/node.h"
+#include "rcl/publisher.h"
+#include "rcl/subscription.h"
 #include "rcl/visibility_control.h"
 
 typedef rmw_names_and_types_t rcl_names_and_types_t;
@@ -321,6 +323,111 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_names_and_types_fini(rcl_names_and_types_t * names_and_types);
 
+/// Copy a rcl_names_and_types_t, reusing the destination's storage if it can.
+/**
+ * If `dst` is already populated with content equal to `src`, nothing is
+ * allocated or freed and `dst` (including every string pointer inside it) is
+ * left untouched; otherwise `dst` is finalized if needed and repopulated with
+ * a deep copy of `src`.
+ *
+ * This lets graph pollers keep one long-lived result struct: refreshed from a
+ * new query (or from the graph cache) each cycle, it costs zero allocations
+ * whenever the graph did not actually change, instead of an init/fini
+ * allocation storm per poll.
+ *
+ * `dst` must be either zero initialized (see
+ * rmw_get_zero_initialized_names_and_types()) or previously populated; on
+ * repopulation the allocator given here is used, so pass the same allocator
+ * across calls.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if the destination's content differs from the source's</i>
+ *
+ * \param[in] src the populated struct to copy from
+ * \param[inout] dst the zero initialized or previously populated destination
+ * \param[in] allocator allocator used for the destination's storage
+ * \return `RCL_RET_OK` if the copy was successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_names_and_types_copy(
+  const rcl_names_and_types_t * src,
+  rcl_names_and_types_t * dst,
+  rcl_allocator_t * allocator);
+
+/// Sort a rcl_names_and_types_t lexicographically by name.
+/**
+ * The rcl_get_*_names_and_types() functions return their results in
+ * middleware order, which is unspecified.
+ * Sorting once enables binary search membership tests with
+ * rcl_names_and_types_find(), instead of a linear scan per lookup or a
+ * re-sort per caller.
+ *
+ * Each set of types moves together with its name; the sets themselves are
+ * not reordered internally.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] scratch space for the duration of the call</i>
+ *
+ * \param[inout] names_and_types populated struct to sort in place
+ * \return `RCL_RET_OK` if the sort was successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating scratch memory failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_names_and_types_sort(rcl_names_and_types_t * names_and_types);
+
+/// Binary search a sorted rcl_names_and_types_t for a name.
+/**
+ * The struct must have been sorted with rcl_names_and_types_sort() (and not
+ * modified since); on unsorted input names may be missed.
+ *
+ * `found` is always written; `index` may be `NULL` when only a membership
+ * test is needed, and is only written when the name was found.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] as long as no thread modifies the struct concurrently</i>
+ *
+ * \param[in] names_and_types sorted, populated struct to search
+ * \param[in] name the name to look for
+ * \param[out] found set to `true` if the name is present, `false` otherwise
+ * \param[out] index position of the name when found, may be `NULL`
+ * \return `RCL_RET_OK` if the search ran (found or not), or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_names_and_types_find(
+  const rcl_names_and_types_t * names_and_types,
+  const char * name,
+  bool * found,
+  size_t * index);
+
 /// Return a list of available nodes in the ROS graph.
 /**
  * The `node` parameter must point to a valid node.
@@ -465,6 +572,49 @@ rcl_count_subscribers(
   const char * topic_name,
   size_t * count);
 
+/// Count the publishers and subscribers on each of a batch of topics.
+/**
+ * Equivalent to calling rcl_count_publishers() and rcl_count_subscribers()
+ * for each of the `topics_size` names in `topic_names`, but the node handle
+ * and arguments are resolved and validated once for the whole sweep, and the
+ * batch is the single place to plug in a batched middleware traversal when
+ * one is available.
+ * Monitoring loops that watch hundreds of topics per sweep should prefer it
+ * over per-topic calls.
+ *
+ * `publisher_counts` and `subscriber_counts` must each point to an array of
+ * at least `topics_size` elements; entry `i` of each receives the counts for
+ * `topic_names[i]`.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] topic_names the fully qualified topic names to count entities on
+ * \param[in] topics_size number of entries in `topic_names`
+ * \param[out] publisher_counts array receiving the publisher count per topic
+ * \param[out] subscriber_counts array receiving the subscriber count per topic
+ * \return `RCL_RET_OK` if the query was successful, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_count_entities_batch(
+  const rcl_node_t * node,
+  const char * const * topic_names,
+  size_t topics_size,
+  size_t * publisher_counts,
+  size_t * subscriber_counts);
+
 /// Check if a service server is available for the given service client.
 /**
  * This function will return true for `is_available` if there is a service server
@@ -508,6 +658,425 @@ rcl_service_server_is_available(
   const rcl_client_t * client,
   bool * is_available);
 
+/// Block until a server for the client's service is available or a timeout expires.
+/**
+ * Replaces the wait-on-graph-guard-condition then re-query loop that callers
+ * otherwise build around rcl_service_server_is_available().
+ * This function checks availability once up front and then sleeps on the
+ * graph guard condition from rcl_node_get_graph_guard_condition(), only
+ * re-checking this client's service when the graph actually changes, so
+ * many clients waiting at once do not re-run full graph queries on every
+ * wake.
+ * Each wake also invalidates the context's graph cache on the caller's
+ * behalf, see rcl_graph_cache_invalidate().
+ *
+ * A negative timeout blocks indefinitely, a timeout of 0 is a non-blocking
+ * availability check, and a positive timeout is an upper bound on the time
+ * spent waiting, in nanoseconds.
+ *
+ * This function waits on the node's graph guard condition and therefore must
+ * not be called concurrently with another wait on the same guard condition.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node used to watch the ROS graph
+ * \param[in] client the handle to the client whose service is awaited
+ * \param[in] timeout how long to wait for a server, in nanoseconds
+ * \return `RCL_RET_OK` if a server for the client's service is available, or
+ * \return `RCL_RET_TIMEOUT` if no server became available in time, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_wait_for_service(
+  const rcl_node_t * node,
+  const rcl_client_t * client,
+  int64_t timeout);
+
+/// Block until a publisher has at least `count` matched subscribers.
+/**
+ * Replaces the poll-query-sleep loops callers otherwise build around
+ * rcl_count_subscribers().
+ * This function counts subscribers on the publisher's topic once up front and
+ * then sleeps on the graph guard condition from
+ * rcl_node_get_graph_guard_condition(), re-counting only when the graph
+ * actually changes, so waiting for matches consumes no CPU between graph
+ * events.
+ * Each wake also invalidates the context's graph cache on the caller's
+ * behalf, see rcl_graph_cache_invalidate().
+ *
+ * The given publisher and node must match, i.e. the publisher must have been
+ * created using the given node.
+ *
+ * A negative timeout blocks indefinitely, a timeout of 0 is a non-blocking
+ * count check, and a positive timeout is an upper bound on the time spent
+ * waiting, in nanoseconds.
+ *
+ * This function waits on the node's graph guard condition and therefore must
+ * not be called concurrently with another wait on the same guard condition.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node used to watch the ROS graph
+ * \param[in] publisher the handle to the publisher whose matches are awaited
+ * \param[in] count the number of matched subscribers to wait for
+ * \param[in] timeout how long to wait for the matches, in nanoseconds
+ * \return `RCL_RET_OK` if at least `count` subscribers are matched, or
+ * \return `RCL_RET_TIMEOUT` if the count was not reached in time, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_wait_for_subscribers(
+  const rcl_node_t * node,
+  const rcl_publisher_t * publisher,
+  size_t count,
+  int64_t timeout);
+
+/// Block until a subscription has at least `count` matched publishers.
+/**
+ * The subscription-side counterpart of rcl_publisher_wait_for_subscribers(),
+ * built on the same graph guard condition wait instead of polling
+ * rcl_count_publishers() in a loop.
+ *
+ * The given subscription and node must match, i.e. the subscription must have
+ * been created using the given node.
+ *
+ * A negative timeout blocks indefinitely, a timeout of 0 is a non-blocking
+ * count check, and a positive timeout is an upper bound on the time spent
+ * waiting, in nanoseconds.
+ *
+ * This function waits on the node's graph guard condition and therefore must
+ * not be called concurrently with another wait on the same guard condition.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node used to watch the ROS graph
+ * \param[in] subscription the handle to the subscription whose matches are awaited
+ * \param[in] count the number of matched publishers to wait for
+ * \param[in] timeout how long to wait for the matches, in nanoseconds
+ * \return `RCL_RET_OK` if at least `count` publishers are matched, or
+ * \return `RCL_RET_TIMEOUT` if the count was not reached in time, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_wait_for_publishers(
+  const rcl_node_t * node,
+  const rcl_subscription_t * subscription,
+  size_t count,
+  int64_t timeout);
+
+/// A set of changes between two snapshots of the ROS graph.
+/**
+ * Produced by rcl_graph_get_changes_since().
+ * Should be initialized with rcl_get_zero_initialized_graph_diff() and
+ * finalized with rcl_graph_diff_fini().
+ */
+typedef struct rcl_graph_diff_t
+{
+  /// Topic names present now but absent from the caller's snapshot.
+  rcutils_string_array_t added_topics;
+  /// Topic names present in the caller's snapshot but gone now.
+  rcutils_string_array_t removed_topics;
+  /// The graph cache epoch this diff brings the caller up to.
+  uint64_t epoch;
+  /// True if no baseline existed for the caller's epoch; `added_topics` then
+  /// holds the complete current topic list rather than a delta, and
+  /// `removed_topics` is empty.
+  bool is_resync;
+} rcl_graph_diff_t;
+
+/// Return a rcl_graph_diff_t struct with members initialized to zero values.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_graph_diff_t
+rcl_get_zero_initialized_graph_diff(void);
+
+/// Finalize a graph diff, reclaiming the memory held by its name lists.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] diff the diff to be finalized
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_graph_diff_fini(rcl_graph_diff_t * diff);
+
+/// Get the topics added and removed since a caller-held graph cache epoch.
+/**
+ * Instead of re-downloading the full topic list on every graph change
+ * notification and diffing it in application code, the caller remembers the
+ * `epoch` of the last diff it consumed and passes it here; only the entities
+ * that changed since then are returned, so the cost is proportional to the
+ * changes, not to the size of the graph.
+ *
+ * The epochs are those of the context's graph cache, advanced by
+ * rcl_graph_cache_invalidate() whenever the graph guard condition fires.
+ * The cache retains exactly one retired snapshot, so a caller that consumes
+ * every change notification always gets a true delta; a caller that skipped
+ * notifications, or that passes an epoch the cache cannot diff against
+ * (e.g. `UINT64_MAX` on the very first call), receives the complete current
+ * topic list with `is_resync` set instead.
+ *
+ * `diff` should be a rcl_graph_diff_t struct initialized with
+ * rcl_get_zero_initialized_graph_diff(); the caller owns the result and
+ * finalizes it with rcl_graph_diff_fini().
+ * `diff->epoch` is the epoch to pass on the next call.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] epoch the graph cache epoch of the caller's last consumed diff
+ * \param[out] diff set to the changes since `epoch`
+ * \return `RCL_RET_OK` if the query was successful, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_graph_get_changes_since(
+  const rcl_node_t * node,
+  uint64_t epoch,
+  rcl_graph_diff_t * diff);
+
+/// Return the cached list of topic names and types in the ROS graph.
+/**
+ * Like rcl_get_topic_names_and_types() with `no_demangle` false, but the
+ * result is snapshotted into a cache shared by all nodes of the context and
+ * repeat queries are served from memory without an rmw discovery round trip
+ * or a fresh allocation.
+ *
+ * The cache does not observe the middleware by itself: whoever waits on the
+ * graph guard condition from rcl_node_get_graph_guard_condition() has to call
+ * rcl_graph_cache_invalidate() when it fires, which drops the snapshot so the
+ * next query repopulates it.
+ *
+ * The returned pointer refers to storage owned by the cache and is valid
+ * until the cache is invalidated or the context is finalized; the caller must
+ * not fini or modify it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [2]
+ * <i>[1] only on the first query after an invalidation</i>
+ *
+ * <i>[2] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[out] topic_names_and_types set to the cached list of topic names and their types
+ * \return `RCL_RET_OK` if the query was successful, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_graph_cache_get_topic_names_and_types(
+  const rcl_node_t * node,
+  const rcl_names_and_types_t ** topic_names_and_types);
+
+/// Return the cached list of available node names in the ROS graph.
+/**
+ * Like rcl_get_node_names(), but served from the context's graph cache; see
+ * rcl_graph_cache_get_topic_names_and_types() for the caching and
+ * invalidation behavior and the lifetime of the returned pointers.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [2]
+ * <i>[1] only on the first query after an invalidation</i>
+ *
+ * <i>[2] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[out] node_names set to the cached list of node names
+ * \param[out] node_namespaces set to the cached list of corresponding node namespaces
+ * \return `RCL_RET_OK` if the query was successful, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_graph_cache_get_node_names(
+  const rcl_node_t * node,
+  const rcutils_string_array_t ** node_names,
+  const rcutils_string_array_t ** node_namespaces);
+
+/// Get the nodes whose namespace is, or is nested under, the given namespace.
+/**
+ * Answers "what is running under this subtree" directly instead of making
+ * the caller fetch the full node list with rcl_get_node_names() and prefix
+ * match it in application code.
+ * The query is served from a trie over the namespaces of the context's
+ * cached node name snapshot, built lazily on the first hierarchical query
+ * after an invalidation, so its cost is proportional to the subtree rather
+ * than to the whole graph; see rcl_graph_cache_get_topic_names_and_types()
+ * for the caching and invalidation behavior.
+ *
+ * The namespace must be absolute, e.g. `/fleet/robot7`; matching is per
+ * namespace segment, so it does not match nodes under `/fleet/robot77`.
+ * Passing `/` returns every node.
+ *
+ * `node_names` and `node_namespaces` must point to zero initialized string
+ * arrays; on success they hold one entry per matched node, are owned by the
+ * caller, and have to be finalized with rcutils_string_array_fini().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] namespace_ the absolute namespace whose subtree is queried
+ * \param[out] node_names set to the names of the nodes in the subtree
+ * \param[out] node_namespaces set to the corresponding node namespaces
+ * \return `RCL_RET_OK` if the query was successful, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_get_nodes_in_namespace(
+  const rcl_node_t * node,
+  const char * namespace_,
+  rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces);
+
+/// Get the topics whose names are nested under the given namespace.
+/**
+ * The topic counterpart of rcl_get_nodes_in_namespace(): returns the names
+ * and types of every topic whose fully qualified name lies under the given
+ * absolute namespace, served from a trie over the context's cached topic
+ * snapshot instead of a scan of the full topic list.
+ *
+ * `topic_names_and_types` must point to a zero initialized
+ * rcl_names_and_types_t; on success it is owned by the caller and has to be
+ * finalized with rcl_names_and_types_fini().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] namespace_ the absolute namespace whose subtree is queried
+ * \param[out] topic_names_and_types set to the topics in the subtree and their types
+ * \return `RCL_RET_OK` if the query was successful, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_get_topic_names_and_types_in_namespace(
+  const rcl_node_t * node,
+  const char * namespace_,
+  rcl_names_and_types_t * topic_names_and_types);
+
+/// Invalidate the context's graph cache.
+/**
+ * Drops the cached snapshots so the next cached query queries rmw again.
+ * Call this whenever the graph guard condition of a node of this context
+ * fires, typically from the wait loop watching
+ * rcl_node_get_graph_guard_condition().
+ * A context whose cache was never queried is valid input and a no-op.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] context the context whose graph cache to invalidate
+ * \return `RCL_RET_OK` if the cache was invalidated, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_graph_cache_invalidate(rcl_context_t * context);
+
 #ifdef __cplusplus
 }
 #endif
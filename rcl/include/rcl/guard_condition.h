@@ -20,6 +20,8 @@ extern "C"
 {
 #endif
 
+#include <stdint.h>
+
 #include "rcl/allocator.h"
 #include "rcl/context.h"
 #include "rcl/macros.h"
@@ -43,6 +45,17 @@ typedef struct rcl_guard_condition_options_t
 {
   /// Custom allocator for the guard condition, used for internal allocations.
   rcl_allocator_t allocator;
+  /// If true, only the first trigger after a (re)arm reaches the middleware.
+  /**
+   * In edge-triggered mode an atomic armed flag tracks whether a wakeup is
+   * already pending; rcl_trigger_guard_condition() only calls into rmw while
+   * disarmed and is a single atomic operation otherwise, so producers that
+   * trigger per enqueued item do not generate redundant middleware wakeups.
+   * rcl_wait() re-arms the guard condition when it comes back ready; consumers
+   * driving the guard condition without a wait set have to re-arm it
+   * themselves with rcl_guard_condition_rearm().
+   */
+  bool edge_triggered;
 } rcl_guard_condition_options_t;
 
 /// Return a rcl_guard_condition_t struct with members set to `NULL`.
@@ -168,6 +181,7 @@ rcl_guard_condition_fini(rcl_guard_condition_t * guard_condition);
  * The defaults are:
  *
  * - allocator = rcl_get_default_allocator()
+ * - edge_triggered = false
  */
 RCL_PUBLIC
 RCL_WARN_UNUSED
@@ -201,6 +215,96 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_trigger_guard_condition(rcl_guard_condition_t * guard_condition);
 
+/// Trigger a rcl guard condition, attaching a 64-bit payload.
+/**
+ * Like rcl_trigger_guard_condition(), but additionally deposits `payload` in
+ * a slot on the guard condition which the woken side reads with
+ * rcl_guard_condition_take_payload().
+ * This collapses the common single-producer wake channel — a queue of one
+ * value plus a doorbell — into the guard condition itself.
+ *
+ * The slot holds one value and is last-writer-wins: a second trigger before
+ * the first payload was taken overwrites it.
+ * Channels that must not lose values still need a real queue and should
+ * trigger without a payload.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No [1]
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ * <i>[1] it can be called concurrently with itself, even on the same guard condition</i>
+ *
+ * \param[in] guard_condition handle to the guard_condition to be triggered
+ * \param[in] payload value deposited for the woken side, zero reads as "empty"
+ * \return `RCL_RET_OK` if the guard condition was triggered, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_trigger_guard_condition_with_payload(
+  rcl_guard_condition_t * guard_condition,
+  uint64_t payload);
+
+/// Consume the payload attached to the last trigger, emptying the slot.
+/**
+ * Atomically exchanges the payload slot with zero; a result of zero means no
+ * payload-carrying trigger happened since the last take (or a producer
+ * deposited the value zero, which is therefore best avoided as a payload).
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [1]
+ * <i>[1] if `atomic_is_lock_free()` returns true for `atomic_uint_least64_t`</i>
+ *
+ * \param[in] guard_condition handle to the guard_condition to read from
+ * \param[out] payload the deposited value, or zero if the slot was empty
+ * \return `RCL_RET_OK` if the slot was read, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_guard_condition_take_payload(
+  rcl_guard_condition_t * guard_condition,
+  uint64_t * payload);
+
+/// Re-arm an edge-triggered rcl guard condition.
+/**
+ * Marks the pending wakeup as consumed, so the next
+ * rcl_trigger_guard_condition() call reaches the middleware again.
+ * rcl_wait() calls this for edge-triggered guard conditions that come back
+ * ready; it only has to be called manually when the guard condition is
+ * consumed without a wait set.
+ * For guard conditions not initialized with the `edge_triggered` option this
+ * function does nothing.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [1]
+ * <i>[1] if `atomic_is_lock_free()` returns true for `atomic_bool`</i>
+ *
+ * \param[in] guard_condition handle to the guard_condition to be re-armed
+ * \return `RCL_RET_OK` if the guard condition was re-armed, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_guard_condition_rearm(rcl_guard_condition_t * guard_condition);
+
 /// Return the guard condition options.
 /**
  * Returned is a pointer to the internally held rcl_guard_condition_options_t.
@@ -257,6 +361,147 @@ RCL_WARN_UNUSED
 rmw_guard_condition_t *
 rcl_guard_condition_get_rmw_handle(const rcl_guard_condition_t * guard_condition);
 
+/// Internal rcl multiplexed guard condition implementation struct.
+struct rcl_guard_condition_mux_impl_t;
+
+/// A multiplexer which shares one rmw guard condition between many logical
+/// conditions.
+/**
+ * Each logical condition is addressed by an index and only costs a bit of
+ * atomic state, rather than a wait set slot and an rmw condition each.
+ * Triggering a logical condition sets its bit and triggers the shared rmw
+ * guard condition at most once per wait cycle.
+ */
+typedef struct rcl_guard_condition_mux_t
+{
+  struct rcl_guard_condition_mux_impl_t * impl;
+} rcl_guard_condition_mux_t;
+
+/// Return a rcl_guard_condition_mux_t struct with members set to `NULL`.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_guard_condition_mux_t
+rcl_get_zero_initialized_guard_condition_mux(void);
+
+/// Initialize a multiplexed guard condition.
+/**
+ * One rmw guard condition is created to back all of the logical conditions;
+ * add it to a wait set via rcl_guard_condition_mux_get_guard_condition().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] guard_condition_mux the handle to be initialized
+ * \param[in] context the context instance with which the mux is associated
+ * \param[in] number_of_conditions number of logical conditions to multiplex
+ * \param[in] options the guard condition's options (allocator is used for the mux)
+ * \return `RCL_RET_OK` if the mux was initialized successfully, or
+ * \return `RCL_RET_ALREADY_INIT` if the mux is already initialized, or
+ * \return `RCL_RET_NOT_INIT` if the given context is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_guard_condition_mux_init(
+  rcl_guard_condition_mux_t * guard_condition_mux,
+  rcl_context_t * context,
+  size_t number_of_conditions,
+  const rcl_guard_condition_options_t options);
+
+/// Finalize a multiplexed guard condition.
+/**
+ * \param[inout] guard_condition_mux handle to be finalized
+ * \return `RCL_RET_OK` if finalized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the argument is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_guard_condition_mux_fini(rcl_guard_condition_mux_t * guard_condition_mux);
+
+/// Return the shared guard condition backing the multiplexer.
+/**
+ * Add the returned guard condition to a wait set to be woken when any of the
+ * logical conditions is triggered; it occupies a single slot regardless of
+ * the number of logical conditions.
+ *
+ * \param[in] guard_condition_mux pointer to the rcl guard condition mux
+ * \return the backing guard condition if successful, otherwise `NULL`
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_guard_condition_t *
+rcl_guard_condition_mux_get_guard_condition(
+  const rcl_guard_condition_mux_t * guard_condition_mux);
+
+/// Trigger one logical condition of a multiplexed guard condition.
+/**
+ * Sets the fired bit for the given logical condition and triggers the shared
+ * rmw guard condition only if no trigger is already pending, so repeated
+ * triggers between two waits cost just a pair of atomic operations.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] guard_condition_mux the mux holding the logical condition
+ * \param[in] index the logical condition to trigger
+ * \return `RCL_RET_OK` if triggered successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_guard_condition_mux_trigger(
+  rcl_guard_condition_mux_t * guard_condition_mux,
+  size_t index);
+
+/// Take the bitmap of logical conditions fired since the last take.
+/**
+ * Atomically consumes the fired state: bit `i` of
+ * `fired_bits[i / 64]` is set if logical condition `i` was triggered since
+ * the previous call.
+ * The output array must hold at least `(number_of_conditions + 63) / 64`
+ * elements.
+ * Triggers which race with this call are kept for the next take.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] guard_condition_mux the mux to take the fired conditions from
+ * \param[out] fired_bits caller-provided bitmap storage to fill
+ * \param[in] fired_bits_size number of elements in `fired_bits`
+ * \return `RCL_RET_OK` if taken successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid or the
+ *   output array is too small.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_guard_condition_mux_take_fired(
+  rcl_guard_condition_mux_t * guard_condition_mux,
+  uint64_t * fired_bits,
+  size_t fired_bits_size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -81,6 +81,48 @@ rcl_init(
   const rcl_init_options_t * options,
   rcl_context_t * context);
 
+/// Initialize a new context from an already initialized one.
+/**
+ * This is a fast path for processes which create several contexts with the
+ * same configuration, e.g. one context per domain in a bridge.
+ * The new context shares the immutable configuration of the source context:
+ * the init options and command line arguments are copied from it, the parsed
+ * arguments are shared by reference, and the process wide logging
+ * configuration done by the original `rcl_init()` is left as is.
+ * Only the middleware is initialized anew, so middleware settings read at
+ * initialization time (e.g. the ROS domain id from the environment) are
+ * picked up by this call.
+ *
+ * The given source context must have been initialized with `rcl_init()` or
+ * this function and must still be valid.
+ * The given `rcl_context_t` to initialize must be zero initialized with
+ * `rcl_get_zero_initialized_context()`, and is finalized like any other
+ * context, with `rcl_shutdown()` and `rcl_context_fini()`.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [1]
+ * <i>[1] if `atomic_is_lock_free()` returns true for `atomic_uint_least64_t`</i>
+ *
+ * \param[in] src_context a valid context to take the configuration from
+ * \param[out] context resulting context object that represents this init
+ * \return `RCL_RET_OK` if initialization is successful, or
+ * \return `RCL_RET_ALREADY_INIT` if the output context is already initialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_init_from_context(
+  rcl_context_t * src_context,
+  rcl_context_t * context);
+
 /// Shutdown a given rcl context.
 /**
  * The given context must have been initialized with `rcl_init()`.
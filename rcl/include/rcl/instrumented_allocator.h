@@ -0,0 +1,130 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__INSTRUMENTED_ALLOCATOR_H_
+#define RCL__INSTRUMENTED_ALLOCATOR_H_
+
+#include <stdint.h>
+
+#include "rcl/allocator.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Allocation statistics gathered by an instrumented allocator.
+/**
+ * The structure doubles as the state of the instrumented allocator: the
+ * wrapping allocator returned by rcl_get_instrumented_allocator() carries a
+ * pointer to it in its `state` field, so one statistics structure per tag
+ * (node init, wait set, yaml parse, ...) attributes allocations to that tag.
+ *
+ * The counters are updated atomically by the implementation, so the
+ * allocator may be used from multiple threads; a read of several counters is
+ * however not a consistent snapshot unless the allocator is quiescent.
+ *
+ * The structure must outlive every allocation made through the instrumented
+ * allocator, since deallocations update its counters.
+ */
+typedef struct rcl_allocator_stats_t
+{
+  /// Label for what the allocator is used for, set by the caller; not owned.
+  const char * tag;
+  /// Allocator calls are forwarded to; set by rcl_get_instrumented_allocator().
+  rcl_allocator_t base_allocator;
+  /// Number of allocate, zero allocate, and reallocate calls.
+  uint64_t allocation_count;
+  /// Number of deallocate calls with a non-null pointer.
+  uint64_t deallocation_count;
+  /// Total bytes requested over the lifetime of the allocator.
+  uint64_t total_bytes_allocated;
+  /// Bytes currently allocated and not yet deallocated.
+  uint64_t bytes_in_use;
+  /// Highest value bytes_in_use has reached.
+  uint64_t peak_bytes_in_use;
+} rcl_allocator_stats_t;
+
+/// Return a zero initialized rcl_allocator_stats_t struct.
+/**
+ * The caller should set the `tag` field afterwards, before reporting.
+ */
+RCL_PUBLIC
+rcl_allocator_stats_t
+rcl_get_zero_initialized_allocator_stats(void);
+
+/// Return an allocator which forwards to another one and gathers statistics.
+/**
+ * Every block handed out by the returned allocator is prefixed with a small
+ * header recording its size, so that deallocations and reallocations can be
+ * attributed in bytes as well as in calls.
+ * Because of that header, memory allocated with the returned allocator must
+ * be deallocated with it (or with another instrumented allocator), never
+ * with the base allocator directly, and vice versa.
+ *
+ * The given statistics structure is used as the state of the returned
+ * allocator and must outlive every allocation made through it.
+ * Its counters are not reset by this function, so one structure may be
+ * handed to several instrumented allocators to aggregate, or zero
+ * initialized between measurements.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] base_allocator valid allocator to forward allocator calls to
+ * \param[in,out] stats statistics structure to update on every allocator call
+ * \return an instrumented allocator, or
+ * \return a zero initialized allocator if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_allocator_t
+rcl_get_instrumented_allocator(
+  const rcl_allocator_t * base_allocator,
+  rcl_allocator_stats_t * stats);
+
+/// Log the given allocation statistics at INFO severity.
+/**
+ * One line is logged with the tag, call counts, and byte counts, using the
+ * logger named \"rcl\"; this is intended for comparing allocation behavior
+ * between runs or releases without attaching external malloc hooks.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] stats statistics to report
+ * \return `RCL_RET_OK` if the statistics were reported, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if stats is `NULL`.
+ */
+RCL_PUBLIC
+rcl_ret_t
+rcl_allocator_stats_report(const rcl_allocator_stats_t * stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__INSTRUMENTED_ALLOCATOR_H_
@@ -15,6 +15,7 @@
 #ifndef RCL__LEXER_LOOKAHEAD_H_
 #define RCL__LEXER_LOOKAHEAD_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 
 #include "rcl/allocator.h"
@@ -28,13 +29,27 @@ extern "C"
 {
 #endif
 
-// Forward declaration
-struct rcl_lexer_lookahead2_impl_t;
-
 /// Track lexical analysis and allow looking ahead 2 lexemes.
+/**
+ * The buffer is self-contained and borrows only the text under analysis,
+ * so it can live on the caller's stack; initializing it does not allocate.
+ */
 typedef struct rcl_lexer_lookahead2_t
 {
-  struct rcl_lexer_lookahead2_impl_t * impl;
+  /// Text that is being analyzed for lexemes.
+  const char * text;
+  /// Where in the text analysis is being performed.
+  size_t text_idx;
+  /// First character of each buffered lexeme.
+  size_t start[2];
+  /// One past the last character of each buffered lexeme.
+  size_t end[2];
+  /// Type of each buffered lexeme.
+  rcl_lexeme_t type[2];
+  /// Allocator to use if an error occurs.
+  rcl_allocator_t allocator;
+  /// Whether the buffer has been initialized.
+  bool initialized;
 } rcl_lexer_lookahead2_t;
 
 /// Get a zero initialized rcl_lexer_lookahead2_t instance.
@@ -59,13 +74,12 @@ rcl_get_zero_initialized_lexer_lookahead2();
 /**
  * The lookahead2 buffer borrows a reference to the provided text.
  * The text must not be freed before the buffer is finalized.
- * The lookahead2 buffer only needs to be finalized if this function does not return RCL_RET_OK.
  * \sa rcl_lexer_lookahead2_fini()
  *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | Yes
+ * Allocates Memory   | No
  * Thread-Safe        | No
  * Uses Atomics       | No
  * Lock-Free          | Yes
@@ -15,6 +15,9 @@
 #ifndef RCL__LOGGING_H_
 #define RCL__LOGGING_H_
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "rcl/allocator.h"
 #include "rcl/arguments.h"
 #include "rcl/macros.h"
@@ -71,6 +74,138 @@ RCL_PUBLIC
 RCL_WARN_UNUSED
 rcl_ret_t rcl_logging_fini();
 
+/// Enable or disable per thread buffering of log output.
+/**
+ * When enabled, each logging thread collects its records in a thread local
+ * buffer and dispatches them to the output appenders in one batch when the
+ * buffer fills or a record of severity ERROR or above arrives, amortizing
+ * the per record dispatch overhead. Records from different threads may be
+ * reordered relative to each other while buffered.
+ *
+ * Disabling buffering dispatches the records buffered by the calling thread;
+ * other threads dispatch their remaining records on their next log call or
+ * when they call rcl_logging_flush_output().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] enabled true to buffer log records per thread, false to dispatch them inline
+ * \return `RCL_RET_OK` always.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t rcl_logging_set_output_buffering(bool enabled);
+
+/// Dispatch the log records buffered by the calling thread.
+/**
+ * A no-op when the calling thread has no buffered records. Threads that log
+ * rarely should call this periodically so that their records are not held
+ * back indefinitely.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \return `RCL_RET_OK` always.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t rcl_logging_flush_output();
+
+/// A logger handle with a cached effective severity threshold.
+/**
+ * Resolving a logger's effective severity by name walks the global severity
+ * map on every call; for per-message logging that lookup dominates the cost
+ * of a disabled log statement.
+ * A handle resolves the threshold once and remembers the severity epoch it
+ * resolved at, so rcl_logger_handle_is_enabled_for() is a load and a compare
+ * until rcl_logging_severity_changed() bumps the epoch.
+ *
+ * Initialize with rcl_logger_handle_init(); there is nothing to finalize.
+ */
+typedef struct rcl_logger_handle_t
+{
+  /// Name of the logger, borrowed from the caller for re-resolution.
+  const char * name;
+  /// Cached effective severity threshold of the logger.
+  int threshold;
+  /// Severity epoch the threshold was resolved at, see
+  /// rcl_logging_severity_changed().
+  uint64_t epoch;
+} rcl_logger_handle_t;
+
+/// Initialize a logger handle for the given logger name.
+/**
+ * The name is borrowed, not copied; it must outlive the handle and is
+ * typically a string literal or the logger name owned by a node.
+ * The threshold is resolved eagerly so the first is-enabled check is already
+ * on the fast path.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[out] handle the handle to initialize
+ * \param[in] name the logger name the threshold is resolved for
+ * \return `RCL_RET_OK` if the handle was initialized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_logger_handle_init(rcl_logger_handle_t * handle, const char * name);
+
+/// Check whether the handle's logger is enabled for a severity.
+/**
+ * Equivalent to resolving the logger's effective severity and comparing, but
+ * the resolution only happens when the global severity epoch moved since the
+ * handle last resolved; otherwise this is one atomic load and a compare.
+ *
+ * The handle is updated in place, so concurrent checks on the same handle
+ * must be synchronized by the caller; distinct handles for the same logger
+ * are independent.
+ *
+ * \param[in,out] handle an initialized logger handle
+ * \param[in] severity the `RCUTILS_LOG_SEVERITY` value of the log statement
+ * \return true if a log statement of the given severity would be emitted.
+ */
+RCL_PUBLIC
+bool
+rcl_logger_handle_is_enabled_for(rcl_logger_handle_t * handle, int severity);
+
+/// Mark every cached logger severity threshold as stale.
+/**
+ * Bumps the global severity epoch, so each logger handle re-resolves its
+ * threshold on its next is-enabled check.
+ * rcl calls this itself when it applies log level settings, e.g. from the
+ * command line arguments in rcl_logging_configure(); call it manually after
+ * changing logger levels directly through rcutils.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ */
+RCL_PUBLIC
+void
+rcl_logging_severity_changed(void);
+
 #ifdef __cplusplus
 }
 #endif
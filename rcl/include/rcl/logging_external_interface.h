@@ -15,9 +15,13 @@
 #ifndef RCL__LOGGING_EXTERNAL_INTERFACE_H_
 #define RCL__LOGGING_EXTERNAL_INTERFACE_H_
 
+#include <stdarg.h>
+#include <stdbool.h>
+
 #include "rcl/macros.h"
 #include "rcl/types.h"
 #include "rcl/visibility_control.h"
+#include "rcutils/logging.h"
 
 /// Initialize the external logging library.
 /**
@@ -65,6 +69,59 @@ RCL_PUBLIC
 void
 rcl_logging_external_log(int severity, const char * name, const char * msg);
 
+/// A single log call in unformatted form.
+/**
+ * Carries the raw data of a log call so that a backend can defer formatting
+ * off the hot path or write the record in a binary form. The format string
+ * and the argument list are only valid for the duration of the
+ * rcl_logging_external_log_structured() call; a backend that defers
+ * formatting must copy what it needs.
+ */
+typedef struct rcl_logging_external_log_record_t
+{
+  /// The location of the log call, may be NULL.
+  const rcutils_log_location_t * location;
+  /// The severity level of the record.
+  int severity;
+  /// The name of the logger, a null terminated c string or NULL.
+  /// If NULL or empty the record belongs to the root logger.
+  const char * name;
+  /// The time the log call was made, in nanoseconds.
+  rcutils_time_point_value_t timestamp;
+  /// The printf style format string of the log call. Log calls reuse the
+  /// same string literal, so its address can serve as a format id in a
+  /// binary log.
+  const char * format;
+  /// The arguments matching the format string.
+  va_list * args;
+} rcl_logging_external_log_record_t;
+
+/// Check whether the external logging library consumes unformatted records.
+/**
+ * When this returns true, log messages are delivered through
+ * rcl_logging_external_log_structured() without being formatted first;
+ * otherwise they are formatted and delivered through
+ * rcl_logging_external_log().
+ *
+ * \return true if the library implements rcl_logging_external_log_structured(), or
+ * \return false if log messages should be formatted before delivery.
+ */
+RCL_PUBLIC
+bool
+rcl_logging_external_supports_structured_log();
+
+/// Log an unformatted record.
+/**
+ * Only called when rcl_logging_external_supports_structured_log() returns
+ * true.
+ *
+ * \param[in] record The record to be logged. Never NULL, and only valid for
+ *   the duration of the call.
+ */
+RCL_PUBLIC
+void
+rcl_logging_external_log_structured(const rcl_logging_external_log_record_t * record);
+
 /// Set the severity level for a logger.
 /**
  * This function sets the severity level for the specified logger.
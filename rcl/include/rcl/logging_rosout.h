@@ -15,6 +15,9 @@
 #ifndef RCL__LOGGING_ROSOUT_H_
 #define RCL__LOGGING_ROSOUT_H_
 
+#include <stdbool.h>
+#include <stddef.h>
+
 #include "rcl/allocator.h"
 #include "rcl/error_handling.h"
 #include "rcl/node.h"
@@ -72,12 +75,15 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_logging_rosout_fini();
 
-/// Creates a rosout publisher for a node and registers it to be used by the logging system
+/// Registers a rosout publisher for a node to be used by the logging system
 /**
- * Calling this for an rcl_node_t will create a new publisher on that node that will be
- * used by the logging system to publish all log messages from that Node's logger.
+ * Calling this for an rcl_node_t registers the node with the logging system so that all
+ * log messages from that Node's logger are published on its rosout publisher.
+ * The publisher itself is created lazily, by the first log record that is actually
+ * published for the logger, so nodes which never log at a rosout-enabled severity do
+ * not advertise a rosout publisher.
  *
- * If a publisher already exists for this node then a new publisher will NOT be created.
+ * If a publisher is already registered for this node then a new one will NOT be registered.
  *
  * It is expected that after creating a rosout publisher with this function
  * rcl_logging_destroy_rosout_publisher_for_node() will be called for the node to cleanup
@@ -131,6 +137,38 @@ rcl_ret_t
 rcl_logging_rosout_fini_publisher_for_node(
   rcl_node_t * node);
 
+/// Report the rosout bookkeeping held for a node's logger.
+/**
+ * Reports whether the lazily created rosout publisher for the node's logger
+ * exists yet, and the bytes of bookkeeping the logging system holds for the
+ * logger (its map entry, throttling state and pooled Log message storage).
+ * Middleware-side resources of the publisher itself are not included.
+ * If rosout logging is not initialized or the node's logger is not
+ * registered, both outputs are reported as zero.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] node a valid rcl_node_t whose logger is queried
+ * \param[out] publisher_created true if the rosout publisher has been created
+ * \param[out] bookkeeping_bytes bytes of rosout bookkeeping held for the logger
+ * \return `RCL_RET_OK` if the footprint was reported, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_LOCAL
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_logging_rosout_get_footprint_for_node(
+  const rcl_node_t * node,
+  bool * publisher_created,
+  size_t * bookkeeping_bytes);
+
 /// The output handler outputs log messages to rosout topics.
 /**
  * When called with a logger name and log message this function will attempt to
@@ -163,6 +201,162 @@ void rcl_logging_rosout_output_handler(
   const char * format,
   va_list * args);
 
+/// Enable or disable asynchronous rosout publishing.
+/**
+ * In asynchronous mode the output handler no longer publishes on the calling
+ * thread; it copies the formatted message into a bounded lock-free ring and
+ * returns, so a logging call can not block on the middleware. The queued
+ * messages are published by rcl_logging_rosout_drain(). When the ring is full
+ * messages are dropped and counted, see
+ * rcl_logging_rosout_get_num_dropped_messages().
+ *
+ * Disabling the asynchronous mode drains any remaining queued messages.
+ * Toggling the mode while other threads are logging is not supported.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] enabled true to queue log messages, false to publish them inline
+ * \return `RCL_RET_OK` if the mode was set successfully, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_logging_rosout_set_async(bool enabled);
+
+/// Publish all log messages queued in asynchronous mode.
+/**
+ * Publishes every completed entry in the ring and returns; meant to be called
+ * periodically (e.g. from an executor) or from a dedicated thread.
+ * There must be at most one draining thread at a time.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No [1]
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ * <i>[1] safe with respect to concurrent logging threads, but only a single
+ * thread may drain</i>
+ *
+ * \return `RCL_RET_OK` if the queued messages were processed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_logging_rosout_drain(void);
+
+/// Limit the rate of log messages published per logger.
+/**
+ * Each logger gets a token bucket admitting at most max_messages_per_second
+ * messages per second, with a burst capacity of one second worth of messages.
+ * Messages beyond the limit are silently discarded before a Log message is
+ * built, protecting the rosout topic from flooding loggers.
+ *
+ * The limit applies process wide, to both the synchronous and the
+ * asynchronous publishing paths. Passing 0 disables the limit.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] max_messages_per_second messages admitted per logger per second, 0 for no limit
+ * \return `RCL_RET_OK` always.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_logging_rosout_set_rate_limit(size_t max_messages_per_second);
+
+/// Enable or disable collapsing of repeated log messages.
+/**
+ * When enabled, a message whose text matches the previously published message
+ * of the same logger is not published; instead a count is kept and a single
+ * "last message repeated N times" record is published when a different
+ * message arrives.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] enabled true to collapse repeated messages, false to publish every message
+ * \return `RCL_RET_OK` always.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_logging_rosout_set_duplicate_suppression(bool enabled);
+
+/// Collapse the per-node rosout publishers into one per-process publisher.
+/**
+ * Every node normally carries its own publisher on the rosout topic, so a
+ * process with N nodes contributes N endpoints to discovery which all target
+ * the same topic. While shared mode is enabled, records of every logger go
+ * out through a single process-wide publisher instead; records stay
+ * attributable because each one carries its logger name.
+ *
+ * The shared publisher is created lazily on the node of the first logger
+ * that publishes a record, and re-created on a surviving node when that node
+ * is finalized. Disabling the mode finalizes the shared publisher; per-node
+ * publishers are re-created lazily as loggers publish their next record.
+ *
+ * Should be toggled before nodes start logging; per-node publishers that
+ * already exist are kept until their node is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] enabled true to publish all records through one shared publisher
+ * \return `RCL_RET_OK` if the mode was set successfully, or
+ * \return `RCL_RET_ERROR` if finalizing the shared publisher fails.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_logging_rosout_set_shared_publisher(bool enabled);
+
+/// Get the number of log messages dropped because the ring was full.
+/**
+ * The counter is cumulative over the lifetime of the process.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[out] count the number of dropped log messages
+ * \return `RCL_RET_OK` if the count was retrieved, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if count is null.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_logging_rosout_get_num_dropped_messages(uint64_t * count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,36 @@ extern "C"
 
 #define RCL_UNUSED(x) (void)(x)
 
+#ifndef _WIN32
+/// Hint that the condition is expected to be true.
+# define RCL_LIKELY(condition) __builtin_expect((condition), 1)
+/// Hint that the condition is expected to be false, e.g. because it guards
+/// an error handling branch.
+# define RCL_UNLIKELY(condition) __builtin_expect((condition), 0)
+/// Functions with this macro are kept out of line and grouped with other
+/// rarely executed code, so they do not occupy instruction cache on the
+/// callers' hot paths.
+# define RCL_COLD __attribute__((cold, noinline))
+#else
+# define RCL_LIKELY(condition) (condition)
+# define RCL_UNLIKELY(condition) (condition)
+# define RCL_COLD
+#endif
+
+/// Wrap a validity check that only guards against caller error.
+/**
+ * Evaluates to constant true when RCL_DISABLE_RUNTIME_VALIDATION is defined,
+ * removing the check (and any function call inside it) from the build, for
+ * deployments whose integration testing proves the arguments valid.
+ * Must not wrap checks that can fail at runtime on correct usage, such as
+ * allocation results or middleware return codes.
+ */
+#ifdef RCL_DISABLE_RUNTIME_VALIDATION
+# define RCL_RUNTIME_CHECK(check) true
+#else
+# define RCL_RUNTIME_CHECK(check) (check)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
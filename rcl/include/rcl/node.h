@@ -20,6 +20,8 @@ extern "C"
 {
 #endif
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "rcl/allocator.h"
@@ -172,6 +174,45 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_node_fini(rcl_node_t * node);
 
+/// Finalize several nodes, overlapping their middleware teardown.
+/**
+ * Equivalent to calling rcl_node_fini() on every node in the array, except
+ * that the rmw node handles are destroyed concurrently on a small set of
+ * worker threads.
+ * Middleware teardown waits on per-node network unadvertisement, so
+ * finalizing the nodes of a large container back to back dominates process
+ * exit time; overlapping the waits brings the total down to roughly the
+ * slowest node.
+ *
+ * Entries which are zero initialized or already finalized are ignored, as
+ * with rcl_node_fini().
+ * On platforms without worker thread support the nodes are finalized
+ * sequentially.
+ *
+ * If finalizing any node fails the remaining nodes are still finalized and
+ * an error is returned afterwards.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [1]
+ * <i>[1] if `atomic_is_lock_free()` returns true for `atomic_uint_least64_t`</i>
+ *
+ * \param[in] nodes array of nodes to be finalized
+ * \param[in] number_of_nodes length of the nodes array
+ * \return `RCL_RET_OK` if all nodes were finalized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the array pointer is null, or
+ * \return `RCL_RET_NODE_INVALID` if an entry in the array is null, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_nodes_fini(rcl_node_t ** nodes, size_t number_of_nodes);
+
 /// Return `true` if the node is valid, else `false`.
 /**
  * Also return `false` if the node pointer is `NULL` or the allocator is invalid.
@@ -386,6 +427,37 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_node_assert_liveliness(const rcl_node_t * node);
 
+/// Assert liveliness for the node and all of its manual-liveliness publishers.
+/**
+ * One call asserts the node itself, like rcl_node_assert_liveliness(), and
+ * then every publisher created on this node with
+ * RMW_QOS_POLICY_LIVELINESS_MANUAL_BY_TOPIC, so a keepalive timer serving
+ * many publishers makes a single rcl call per period instead of one
+ * rcl_publisher_assert_liveliness() call per publisher.
+ * The publishers are tracked by the node as they are created, so no graph
+ * query is involved.
+ *
+ * This function must be called at least as often as the shortest
+ * liveliness_lease_duration among the node and its publishers.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] node handle to the node whose liveliness is asserted
+ * \return `RCL_RET_OK` if all liveliness assertions completed successfully, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_node_assert_liveliness_batch(const rcl_node_t * node);
+
 /// Return the rmw node handle.
 /**
  * The handle returned is a pointer to the internally held rmw handle.
@@ -456,6 +528,10 @@ rcl_node_get_rcl_instance_id(const rcl_node_t * node);
  * The returned handle is made invalid if the node is finialized or if
  * rcl_shutdown() is called.
  *
+ * The condition is shared by all nodes in the same context, since they all
+ * observe the same graph events; waiting on it through several nodes of one
+ * context therefore costs one middleware condition, not one per node.
+ *
  * The guard condition will be triggered anytime a change to the ROS graph occurs.
  * A ROS graph change includes things like (but not limited to) a new publisher
  * advertises, a new subscription is created, a new service becomes available,
@@ -506,6 +582,66 @@ RCL_WARN_UNUSED
 const char *
 rcl_node_get_logger_name(const rcl_node_t * node);
 
+/// Resource usage of one node, as reported by rcl_node_get_resource_stats().
+typedef struct rcl_node_resource_stats_t
+{
+  /// Number of publishers currently initialized on the node.
+  size_t num_publishers;
+  /// Number of subscriptions currently initialized on the node.
+  size_t num_subscriptions;
+  /// Number of clients currently initialized on the node.
+  size_t num_clients;
+  /// Number of services currently initialized on the node.
+  size_t num_services;
+  /// Bytes held by the node's implementation arena: the implementation
+  /// struct, the name and logger name strings, and any overflow blocks.
+  size_t impl_bytes;
+  /// Bytes of the node's side registries: the resolved name cache and the
+  /// manual liveliness publisher registry, counted at allocated capacity.
+  size_t registry_bytes;
+  /// Whether the node's lazily created rosout publisher exists yet.
+  bool rosout_publisher_created;
+  /// Bytes of rosout bookkeeping held for the node's logger.
+  size_t rosout_bytes;
+} rcl_node_resource_stats_t;
+
+/// Report the entity counts and memory footprint of a node.
+/**
+ * Fills out the given stats struct with the number of entities currently
+ * initialized on the node, by type, and the bytes rcl holds on the node's
+ * behalf, so memory can be attributed per node when planning how many nodes
+ * to co-locate in one process or container.
+ *
+ * The byte counts cover what rcl itself allocates for the node: the
+ * implementation arena, the side registries, and the rosout bookkeeping for
+ * the node's logger.  Memory held by the middleware for the node and its
+ * entities, and memory held by the entities' own implementation structs, is
+ * not visible from here; total process attribution additionally needs the
+ * instrumented allocator (see rcl/instrumented_allocator.h).
+ *
+ * Timers and guard conditions are not created on a node and are therefore
+ * not counted.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] node pointer to the rcl node
+ * \param[out] stats struct filled out with the node's resource usage
+ * \return `RCL_RET_OK` if the stats were reported successfully, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_node_get_resource_stats(const rcl_node_t * node, rcl_node_resource_stats_t * stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -43,6 +43,46 @@ typedef struct rcl_publisher_options_t
   /// Custom allocator for the publisher, used for incidental allocations.
   /** For default behavior (malloc/free), use: rcl_get_default_allocator() */
   rcl_allocator_t allocator;
+  /// If true, deliver directly to same-context subscriptions, bypassing rmw.
+  /**
+   * When the topic has at least one subscription in the same rcl_context_t
+   * which opted into intra-context delivery, rcl_publish() hands the message
+   * pointer to those subscriptions through a lock-free ring and skips the
+   * middleware entirely; see rcl_take_intra_context() for the consumer side
+   * and its ownership requirements.
+   * When no such subscription exists the message is published via the
+   * middleware as usual.
+   */
+  bool enable_intra_context_delivery;
+  /// Number of messages to accumulate before publishing; 0 disables batching.
+  /**
+   * When non-zero, rcl_publish() stages message pointers in a per-publisher
+   * accumulation buffer instead of handing each one to the middleware
+   * immediately.
+   * The buffer is flushed when it holds batch_size messages, when the oldest
+   * staged message is older than batch_timeout, or explicitly via
+   * rcl_publisher_flush().
+   * Staged messages must remain valid and unmodified until flushed.
+   */
+  size_t batch_size;
+  /// Maximum age of a staged message before a flush is forced, in nanoseconds.
+  /**
+   * The deadline is checked on each publish, so a lone staged message can
+   * exceed it if no further publishes happen; use rcl_publisher_flush() to
+   * bound the latency in that case.
+   * Only used when batch_size is non-zero.
+   */
+  int64_t batch_timeout;
+  /// Size in bytes of the largest message the publisher's pool must hold.
+  /**
+   * When both this and message_pool_depth are non-zero, the publisher
+   * preallocates an arena of message_pool_depth slots of this size at init
+   * time, served through rcl_publisher_alloc_message() and
+   * rcl_publisher_free_message() without touching the allocator again.
+   */
+  size_t message_pool_message_size;
+  /// Number of message slots preallocated in the publisher's pool.
+  size_t message_pool_depth;
 } rcl_publisher_options_t;
 
 /// Return a rcl_publisher_t struct with members set to `NULL`.
@@ -188,12 +228,83 @@ rcl_publisher_fini(rcl_publisher_t * publisher, rcl_node_t * node);
  *
  * - qos = rmw_qos_profile_default
  * - allocator = rcl_get_default_allocator()
+ * - enable_intra_context_delivery = false
+ * - batch_size = 0
+ * - batch_timeout = 0
+ * - message_pool_message_size = 0
+ * - message_pool_depth = 0
  */
 RCL_PUBLIC
 RCL_WARN_UNUSED
 rcl_publisher_options_t
 rcl_publisher_get_default_options(void);
 
+/// Borrow a loaned message.
+/**
+ * The memory allocated for the ros message belongs to the middleware and must not be deallocated
+ * other than by a call to \sa rcl_return_loaned_message_from_publisher.
+ * The message is only returned to the middleware on a successful call to
+ * \sa rcl_publish_loaned_message or \sa rcl_return_loaned_message_from_publisher.
+ * This enables a zero-copy publish on middlewares which support message loaning,
+ * as the caller writes directly into a transport-owned buffer.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] publisher Publisher to which the allocated message is associated.
+ * \param[in] type_support Typesupport to which the internal ros message is allocated.
+ * \param[out] ros_message The pointer to be filled to a valid ros message by the middleware.
+ * \return `RCL_RET_OK` if the ros message was correctly initialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if an argument other than the ros message is null, or
+ * \return `RCL_RET_BAD_ALLOC` if the ros message could not be correctly created, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support message loaning, or
+ * \return `RCL_RET_ERROR` if an unexpected error occured.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_borrow_loaned_message(
+  const rcl_publisher_t * publisher,
+  const rosidl_message_type_support_t * type_support,
+  void ** ros_message);
+
+/// Return a loaned message previously borrowed from a publisher.
+/**
+ * The ownership of the passed in ros message will be transferred back to the middleware.
+ * The middleware might deallocate and destroy the message so that the pointer is no longer
+ * guaranteed to be valid after that call.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] publisher Publisher to which the loaned message is associated.
+ * \param[in] loaned_message Loaned message to be returned to the middleware.
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if an argument is null, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support message loaning, or
+ * \return `RCL_RET_ERROR` if an unexpected error occurs and no message can be initialized.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_return_loaned_message_from_publisher(
+  const rcl_publisher_t * publisher,
+  void * loaned_message);
+
 /// Publish a ROS message on a topic using a publisher.
 /**
  * It is the job of the caller to ensure that the type of the ros_message
@@ -260,6 +371,82 @@ rcl_publish(
   rmw_publisher_allocation_t * allocation
 );
 
+/// A validated publisher handle for the trusted publish fast path.
+/**
+ * Obtained with rcl_publisher_get_validation_token() and passed to
+ * rcl_publish_unchecked(), which skips the per-call validation that
+ * rcl_publish() repeats on every message.
+ * The token is a plain value and may be copied; it stays usable until the
+ * publisher it was taken from is finalized or otherwise invalidated.
+ */
+typedef struct rcl_publisher_validation_token_t
+{
+  /// The publisher this token was validated against.
+  const rcl_publisher_t * publisher;
+} rcl_publisher_validation_token_t;
+
+/// Validate a publisher once and store the result in a token.
+/**
+ * This runs the same checks rcl_publish() performs on every call and, on
+ * success, records the publisher in the given token so those checks can be
+ * hoisted out of tight publish loops via rcl_publish_unchecked().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] publisher handle to the publisher to validate
+ * \param[out] token storage for the validated handle
+ * \return `RCL_RET_OK` if the token was populated successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the token is NULL, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_get_validation_token(
+  const rcl_publisher_t * publisher,
+  rcl_publisher_validation_token_t * token);
+
+/// Publish a ROS message using a previously validated publisher.
+/**
+ * Identical to rcl_publish() except that the entity validation is assumed to
+ * have been done by rcl_publisher_get_validation_token(), so neither the
+ * token, the publisher behind it, nor the message is checked again.
+ * The caller must guarantee the publisher outlives every use of the token;
+ * publishing through a token whose publisher has been finalized, or passing a
+ * NULL token or message, is undefined behavior.
+ * Use this only in hot loops where the validation cost has been measured to
+ * matter; everywhere else rcl_publish() is the right call.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] for unique pairs of publishers and messages, see rcl_publish()</i>
+ *
+ * \param[in] token validated handle from rcl_publisher_get_validation_token()
+ * \param[in] ros_message type-erased pointer to the ROS message
+ * \param[in] allocation structure pointer, used for memory preallocation (may be NULL)
+ * \return `RCL_RET_OK` if the message was published successfully, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publish_unchecked(
+  const rcl_publisher_validation_token_t * token,
+  const void * ros_message,
+  rmw_publisher_allocation_t * allocation);
+
 /// Publish a serialized message on a topic using a publisher.
 /**
  * It is the job of the caller to ensure that the type of the serialized message
@@ -300,6 +487,294 @@ rcl_publish_serialized_message(
   rmw_publisher_allocation_t * allocation
 );
 
+/// One segment of a serialized message split across several buffers.
+typedef struct rcl_serialized_segment_t
+{
+  /// Start of the segment; may be NULL if length is zero.
+  const uint8_t * data;
+  /// Length of the segment in bytes.
+  size_t length;
+} rcl_serialized_segment_t;
+
+/// Publish a serialized message given as an array of buffer segments.
+/**
+ * Behaves like rcl_publish_serialized_message(), except that the serialized
+ * byte stream is given as `count` segments which are published as if they had
+ * been concatenated in order.
+ * This lets callers which assemble messages from separate pieces (for example
+ * a fixed header plus a payload slice of a larger file) publish without
+ * first copying the pieces into a contiguous buffer of their own.
+ *
+ * The segments are gathered into a staging buffer owned by the publisher, so
+ * memory is only allocated when a message is larger than any published before
+ * it; steady-state calls do not allocate.
+ * Because that buffer is shared across calls, this function is not thread-safe
+ * with respect to itself on the same publisher.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only when the total length exceeds all previously published lengths</i>
+ *
+ * \param[in] publisher handle to the publisher which will do the publishing
+ * \param[in] segments array of buffer segments forming the serialized message
+ * \param[in] count number of entries in segments, must be non-zero
+ * \param[in] allocation structure pointer, used for memory preallocation (may be NULL)
+ * \return `RCL_RET_OK` if the message was published successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if growing the staging buffer fails, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publish_serialized_segments(
+  const rcl_publisher_t * publisher,
+  const rcl_serialized_segment_t * segments,
+  size_t count,
+  rmw_publisher_allocation_t * allocation
+);
+
+/// Publish a loaned message on a topic using a publisher.
+/**
+ * A previously borrowed loaned message can be sent via this call.
+ * Unlike \sa rcl_publish, this function is an owning call, in that it transfers
+ * the ownership of the loaned message back to the middleware.
+ * The pointer to the loaned message is no longer guaranteed to be valid afterwards,
+ * and the message must not be returned explicitly.
+ *
+ * Apart from this, the `rcl_publish_loaned_message` function has the same behavior
+ * as `rcl_publish`, except that no copy into middleware-owned memory is needed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | Maybe [2]
+ * Lock-Free          | Maybe [2]
+ * <i>[1] for unique pairs of publishers and messages, see above for more</i>
+ * <i>[2] rmw implementation defined</i>
+ *
+ * \param[in] publisher handle to the publisher which will do the publishing
+ * \param[in] ros_message pointer to the previously borrowed loaned message
+ * \param[in] allocation structure pointer, used for memory preallocation (may be NULL)
+ * \return `RCL_RET_OK` if the message was published successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support message loaning, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publish_loaned_message(
+  const rcl_publisher_t * publisher,
+  void * ros_message,
+  rmw_publisher_allocation_t * allocation
+);
+
+/// Block until all published messages are acknowledged or a timeout expires.
+/**
+ * For a publisher with reliable QoS, this waits until every message published
+ * so far has been acknowledged by all matched subscriptions, letting callers
+ * which buffer data for retransmission (for example a store-and-forward
+ * uploader) drop their copies as soon as delivery is confirmed instead of
+ * polling an application-level acknowledgment channel.
+ * The caller is parked on the middleware's acknowledgment condition, so no
+ * CPU is spent while waiting.
+ *
+ * For a publisher with best effort QoS the function returns `RCL_RET_OK`
+ * immediately, as there is nothing to wait for.
+ *
+ * If timeout is negative, the function blocks until all messages are
+ * acknowledged.
+ * If timeout is zero, the current acknowledgment state is reported without
+ * blocking.
+ * If timeout is positive, it is the maximum time to wait in nanoseconds.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] publisher handle to the publisher whose messages to wait on
+ * \param[in] timeout duration to wait for acknowledgments, in nanoseconds
+ * \return `RCL_RET_OK` if all published messages were acknowledged, or
+ * \return `RCL_RET_TIMEOUT` if the timeout expired first, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not report acknowledgments, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_wait_for_acks(
+  const rcl_publisher_t * publisher,
+  int64_t timeout
+);
+
+/// Get the number of messages queued in the publisher, waiting to go out.
+/**
+ * Reports how many messages are staged in the publisher's accumulation
+ * buffer (see batch_size in rcl_publisher_options_t) and have not yet been
+ * handed to the middleware.
+ * The middleware's own transmit queue is not visible to rcl and is not
+ * included.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] publisher handle to the publisher to query
+ * \param[out] queue_depth number of staged, unflushed messages
+ * \return `RCL_RET_OK` if the query succeeded, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_get_queue_depth(
+  const rcl_publisher_t * publisher,
+  size_t * queue_depth);
+
+/// Publish a ROS message only if doing so cannot block.
+/**
+ * With reliable QoS a plain rcl_publish() can block inside the middleware
+ * while its transmit queue is full, stalling the calling loop.
+ * This variant only stages the message into the publisher's accumulation
+ * buffer (see batch_size in rcl_publisher_options_t), which is a bounded,
+ * non-blocking operation; the middleware is never entered.
+ * If the buffer is full, `RCL_RET_TIMEOUT` is returned without publishing so
+ * the caller can shed load or retry, and drain the buffer at a convenient
+ * time with rcl_publisher_flush().
+ *
+ * The publisher must have batching enabled; without an accumulation buffer
+ * there is no way to publish without potentially entering a blocking
+ * middleware call, and `RCL_RET_UNSUPPORTED` is returned.
+ *
+ * As with batched rcl_publish(), the message must stay valid and unmodified
+ * until flushed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] publisher handle to the publisher which will do the publishing
+ * \param[in] ros_message type-erased pointer to the ROS message
+ * \return `RCL_RET_OK` if the message was staged successfully, or
+ * \return `RCL_RET_TIMEOUT` if the accumulation buffer is full, or
+ * \return `RCL_RET_UNSUPPORTED` if the publisher has no accumulation buffer, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publish_if_writable(
+  const rcl_publisher_t * publisher,
+  const void * ros_message);
+
+/// Allocate a message from the publisher's preallocated pool.
+/**
+ * Pops a free slot from the arena set up at init time through the
+ * message_pool_message_size and message_pool_depth options, without calling
+ * into the allocator.
+ * The slot memory is not zeroed or type-initialized; the caller is expected
+ * to run the message type's init function over it if needed.
+ * The slot must be given back with rcl_publisher_free_message().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] publisher handle to the publisher owning the pool
+ * \param[out] ros_message filled with a pointer to the message slot
+ * \return `RCL_RET_OK` if a slot was allocated, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid or the
+ *         publisher was initialized without a pool, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if the pool is exhausted.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_alloc_message(
+  const rcl_publisher_t * publisher,
+  void ** ros_message);
+
+/// Return a message slot to the publisher's preallocated pool.
+/**
+ * The pointer must have been obtained from rcl_publisher_alloc_message() on
+ * the same publisher and must not be used after this call.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] publisher handle to the publisher owning the pool
+ * \param[in] ros_message message slot to return to the pool
+ * \return `RCL_RET_OK` if the slot was returned, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the pointer is not a pool slot, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_free_message(
+  const rcl_publisher_t * publisher,
+  void * ros_message);
+
+/// Flush any messages staged by a batching publisher.
+/**
+ * Publishes all staged messages through the middleware in one tight loop and
+ * empties the accumulation buffer.
+ * A no-op for publishers without batching enabled or with nothing staged.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] publisher handle to the publisher whose staged messages to flush
+ * \return `RCL_RET_OK` if all staged messages were published, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_flush(const rcl_publisher_t * publisher);
+
 /// Manually assert that this Publisher is alive (for RMW_QOS_POLICY_LIVELINESS_MANUAL_BY_TOPIC)
 /**
  * If the rmw Liveliness policy is set to RMW_QOS_POLICY_LIVELINESS_MANUAL_BY_TOPIC, the creator of
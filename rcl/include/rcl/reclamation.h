@@ -0,0 +1,175 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__RECLAMATION_H_
+#define RCL__RECLAMATION_H_
+
+#include <stddef.h>
+
+#include "rcl/context.h"
+#include "rcl/macros.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Maximum number of threads that can register with a context's
+/// reclamation domain at once.
+#define RCL_RECLAMATION_MAX_THREADS 32
+
+/// Finalizer invoked when a retired object becomes safe to reclaim.
+/**
+ * \param[in] object the object given to rcl_reclamation_retire()
+ * \param[in] finalize_context the context given to rcl_reclamation_retire()
+ * \return `RCL_RET_OK` if the object was reclaimed successfully.
+ */
+typedef rcl_ret_t (* rcl_reclamation_finalize_t)(
+  void * object,
+  void * finalize_context);
+
+/// Register the calling thread with the context's reclamation domain.
+/**
+ * Epoch based reclamation defers freeing retired objects until every
+ * registered thread has passed a quiescent point, so entities can be
+ * finalized while executor threads keep spinning instead of pausing the
+ * whole executor around every rcl_*_fini() call.
+ *
+ * Each thread that may hold references to retirable entities between
+ * quiescent points — typically each thread driving rcl_wait() and
+ * dispatching callbacks — registers once and then calls
+ * rcl_reclamation_quiescent() at a point in its loop where it holds no
+ * entity references, e.g. between dispatch cycles.
+ * Threads that never touch retired entities do not need to register and do
+ * not delay reclamation.
+ *
+ * The returned slot identifies the registration and is passed to
+ * rcl_reclamation_quiescent() and rcl_reclamation_unregister_thread().
+ * The domain is created on the first registration or retirement; that first
+ * call must not race with another reclamation call on the same context.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes [1]
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ * <i>[1] only when the call creates the context's domain</i>
+ *
+ * \param[in] context the context whose entities the thread will access
+ * \param[out] slot the thread's registration slot
+ * \return `RCL_RET_OK` if the thread was registered, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if creating the domain failed, or
+ * \return `RCL_RET_ERROR` if all registration slots are taken.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_reclamation_register_thread(rcl_context_t * context, size_t * slot);
+
+/// Unregister a thread from the context's reclamation domain.
+/**
+ * The slot stops delaying reclamation and may be handed out again.
+ * Call this before a registered thread exits; a registered thread that
+ * stops passing quiescent points blocks reclamation indefinitely.
+ *
+ * \param[in] context the context the thread was registered with
+ * \param[in] slot the slot returned by rcl_reclamation_register_thread()
+ * \return `RCL_RET_OK` if the thread was unregistered, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_reclamation_unregister_thread(rcl_context_t * context, size_t slot);
+
+/// Announce that the calling thread holds no entity references.
+/**
+ * Call at a point in the thread's loop where no references to retirable
+ * entities are held, e.g. after dispatching the entities of one wait cycle.
+ * Besides recording the quiescent point, the call opportunistically
+ * reclaims retired objects that every registered thread has moved past.
+ * The common no-work case is a handful of atomic loads and one store.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] context the context the thread is registered with
+ * \param[in] slot the slot returned by rcl_reclamation_register_thread()
+ * \return `RCL_RET_OK` if the quiescent point was recorded, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_reclamation_quiescent(rcl_context_t * context, size_t slot);
+
+/// Retire an object, deferring its finalizer until it is safe to run.
+/**
+ * The finalizer runs once every thread registered at retirement time has
+ * passed a quiescent point, either inside a later
+ * rcl_reclamation_quiescent() call or in rcl_reclamation_drain().
+ * With no registered threads the finalizer still does not run until the
+ * next quiescent or drain call; retirement itself never finalizes, so the
+ * caller can retire from any thread without re-entrancy surprises.
+ *
+ * \param[in] context the context whose threads may reference the object
+ * \param[in] object the object to hand to the finalizer, must stay valid
+ * \param[in] finalize_context extra finalizer argument, may be `NULL`
+ * \param[in] finalize the finalizer to run when the object is reclaimable
+ * \return `RCL_RET_OK` if the object was queued for reclamation, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating the queue entry failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_reclamation_retire(
+  rcl_context_t * context,
+  void * object,
+  void * finalize_context,
+  rcl_reclamation_finalize_t finalize);
+
+/// Run the finalizers of all retired objects unconditionally.
+/**
+ * Only safe once no registered thread can still hold references, e.g.
+ * after the executor threads have stopped during shutdown.
+ * Context cleanup drains the domain itself, but finalizers that need the
+ * node or middleware still alive should be drained before those are torn
+ * down.
+ *
+ * \param[in] context the context whose retired objects are reclaimed
+ * \return `RCL_RET_OK` if all finalizers ran successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if context is `NULL`, or
+ * \return `RCL_RET_ERROR` if a finalizer failed; the rest still run.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_reclamation_drain(rcl_context_t * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__RECLAMATION_H_
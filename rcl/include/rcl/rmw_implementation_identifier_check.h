@@ -0,0 +1,59 @@
+// Copyright 2016 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__RMW_IMPLEMENTATION_IDENTIFIER_CHECK_H_
+#define RCL__RMW_IMPLEMENTATION_IDENTIFIER_CHECK_H_
+
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Check that the RMW implementation in use matches what the user requested.
+/**
+ * Compares the identifier reported by the linked rmw implementation against
+ * the RMW_IMPLEMENTATION and RCL_ASSERT_RMW_ID_MATCHES environment variables.
+ * The comparison runs once; its result is stored in an atomic so that every
+ * later call is a single atomic load and safe to make from hot paths.
+ *
+ * The check also runs at library load time and terminates the process on a
+ * mismatch, so a failure return is normally only seen by the loader itself.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes [1]
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ * <i>[1] only on the first call</i>
+ *
+ * \return `RCL_RET_OK` if the implementation identifiers match or none was requested, or
+ * \return `RCL_RET_MISMATCHED_RMW_ID` if the identifiers do not match, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_rmw_implementation_identifier_check(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__RMW_IMPLEMENTATION_IDENTIFIER_CHECK_H_
@@ -20,6 +20,8 @@ extern "C"
 {
 #endif
 
+#include <stdint.h>
+
 #include "rosidl_generator_c/service_type_support_struct.h"
 
 #include "rcl/macros.h"
@@ -303,6 +305,190 @@ rcl_send_response(
   rmw_request_id_t * response_header,
   void * ros_response);
 
+/// Take up to `count` pending requests from the service queue in one call.
+/**
+ * The service and arguments are validated once, then requests are taken
+ * until the queue is empty or `count` were taken, amortizing the per-call
+ * overhead of rcl_take_request() across a burst of requests.
+ *
+ * `request_headers` and `ros_requests` must each hold `count` entries, with
+ * every request message allocated and of the type associated with the
+ * service; entry `i` of the headers describes the request in entry `i` of
+ * the messages and is what rcl_send_response() (or rcl_send_responses())
+ * needs to reply to it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if required when filling a request, avoided for fixed sizes</i>
+ *
+ * \param[in] service the handle to the service from which to take
+ * \param[in] count number of entries in request_headers and ros_requests
+ * \param[inout] request_headers per-request metadata including the request id
+ * \param[inout] ros_requests preallocated request messages to fill
+ * \param[out] taken number of requests actually taken
+ * \return `RCL_RET_OK` if at least one request was taken, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SERVICE_INVALID` if the service is invalid, or
+ * \return `RCL_RET_SERVICE_TAKE_FAILED` if no request was ready, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_requests(
+  const rcl_service_t * service,
+  size_t count,
+  rmw_request_id_t * request_headers,
+  void ** ros_requests,
+  size_t * taken);
+
+/// Send a batch of responses with one validation of the service.
+/**
+ * Equivalent to calling rcl_send_response() for each of the `count`
+ * header/response pairs, with the service and arguments validated once.
+ *
+ * On failure the error refers to the first response that could not be sent
+ * and `sent` tells how many were, so the caller can resume from
+ * `request_headers[*sent]` without repeating earlier responses.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Maybe [2]
+ * Lock-Free          | Maybe [3]
+ * <i>[1] for unique pairs of clients and services, see rcl_send_response()</i>
+ * <i>[2] only if required by the underlying rmw implementation</i>
+ * <i>[3] if the underlying rmw implementation is lock-free</i>
+ *
+ * \param[in] service handle to the service which will make the responses
+ * \param[in] count number of entries in request_headers and ros_responses
+ * \param[inout] request_headers per-response metadata about the request IDs
+ * \param[in] ros_responses type-erased pointers to the ROS response messages
+ * \param[out] sent number of responses successfully sent
+ * \return `RCL_RET_OK` if all responses were sent successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SERVICE_INVALID` if the service is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_send_responses(
+  const rcl_service_t * service,
+  size_t count,
+  rmw_request_id_t * request_headers,
+  void ** ros_responses,
+  size_t * sent);
+
+/// Borrow a loaned response message.
+/**
+ * The memory allocated for the ros response belongs to the middleware and must not be deallocated
+ * other than by a call to \sa rcl_return_loaned_response_from_service.
+ * The response is only returned to the middleware on a successful call to
+ * \sa rcl_send_loaned_response or \sa rcl_return_loaned_response_from_service.
+ * This enables a zero-copy reply on middlewares which support loaning, as the
+ * service fills a transport-owned buffer in place instead of serializing a
+ * caller-owned response into one.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] service Service to which the allocated response is associated.
+ * \param[in] type_support Typesupport to which the internal ros response is allocated.
+ * \param[out] ros_response The pointer to be filled to a valid ros response by the middleware.
+ * \return `RCL_RET_OK` if the ros response was correctly initialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if an argument other than the ros response is null, or
+ * \return `RCL_RET_BAD_ALLOC` if the ros response could not be correctly created, or
+ * \return `RCL_RET_SERVICE_INVALID` if the service is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support response loaning, or
+ * \return `RCL_RET_ERROR` if an unexpected error occured.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_borrow_loaned_response(
+  const rcl_service_t * service,
+  const rosidl_service_type_support_t * type_support,
+  void ** ros_response);
+
+/// Return a loaned response previously borrowed from a service.
+/**
+ * The ownership of the passed in ros response will be transferred back to the middleware.
+ * Use this to give up a loan without replying; after \sa rcl_send_loaned_response succeeds
+ * the loan is returned implicitly and this must not be called for it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] service Service to which the loaned response is associated.
+ * \param[in] loaned_response Loaned response to be returned.
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if an argument is null, or
+ * \return `RCL_RET_SERVICE_INVALID` if the service is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support response loaning, or
+ * \return `RCL_RET_ERROR` if an unexpected error occured.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_return_loaned_response_from_service(
+  const rcl_service_t * service,
+  void * loaned_response);
+
+/// Send a previously borrowed response without copying it.
+/**
+ * Behaves like rcl_send_response(), except that `ros_response` must have been
+ * borrowed with \sa rcl_borrow_loaned_response from the same service, and its
+ * ownership passes back to the middleware on success so no serialization copy
+ * out of a caller buffer is needed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | Maybe [2]
+ * Lock-Free          | Maybe [2]
+ * <i>[1] for unique pairs of clients and services, see rcl_send_response()</i>
+ * <i>[2] rmw implementation defined</i>
+ *
+ * \param[in] service handle to the service which will make the response
+ * \param[inout] request_header pointer to the struct holding metadata about the request ID
+ * \param[in] ros_response pointer to the borrowed ROS response message
+ * \return `RCL_RET_OK` if the response was sent successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SERVICE_INVALID` if the service is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support response loaning, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_send_loaned_response(
+  const rcl_service_t * service,
+  rmw_request_id_t * request_header,
+  void * ros_response);
+
 /// Get the topic name for the service.
 /**
  * This function returns the service's internal topic name string.
@@ -410,6 +596,96 @@ RCL_PUBLIC
 bool
 rcl_service_is_valid(const rcl_service_t * service);
 
+/// Number of latency histogram buckets in rcl_service_stats_t.
+/**
+ * Bucket `i` counts responses whose take-to-response latency was in
+ * `[2^i, 2^(i+1))` nanoseconds; the last bucket also absorbs anything
+ * larger, covering up to ~4.3 seconds before saturating.
+ */
+#define RCL_SERVICE_STATS_LATENCY_BUCKETS 32
+
+/// Request handling statistics of one service, see rcl_service_enable_stats().
+/**
+ * Latencies are measured from the take in rcl_take_request() (or
+ * rcl_take_requests()) to the matching rcl_send_response() (or
+ * rcl_send_responses() / rcl_send_loaned_response()), correlated by the
+ * request id the middleware assigned, so they include any time the request
+ * waited between the take and the application handler.
+ * All durations are in nanoseconds of steady time.
+ */
+typedef struct rcl_service_stats_t
+{
+  /// Number of responses correlated with a previously taken request.
+  uint64_t request_count;
+  /// Take-to-response latency of the most recent correlated response.
+  uint64_t last_latency;
+  /// Accumulated take-to-response latency.
+  uint64_t total_latency;
+  /// Shortest observed take-to-response latency.
+  uint64_t min_latency;
+  /// Longest observed take-to-response latency.
+  uint64_t max_latency;
+  /// Log2 latency histogram, see RCL_SERVICE_STATS_LATENCY_BUCKETS.
+  uint64_t latency_histogram[RCL_SERVICE_STATS_LATENCY_BUCKETS];
+  /// Requests taken but not yet responded to right now.
+  uint64_t current_inflight;
+  /// Most requests ever in flight at once.
+  uint64_t max_inflight;
+  /// Responses whose request id was not found in the in-flight table,
+  /// e.g. because the take happened before stats were enabled.
+  uint64_t uncorrelated_responses;
+  /// Takes that could not be tracked because the in-flight table was full.
+  uint64_t dropped_correlations;
+} rcl_service_stats_t;
+
+/// Enable or disable collection of latency statistics on a service.
+/**
+ * While enabled, every take records the request id and a steady clock read
+ * in a fixed-size in-flight table, and every response looks its request up
+ * there to accumulate the take-to-response latency, including a log2
+ * histogram for percentile estimates.
+ * Enabling allocates the in-flight table with the service's allocator and
+ * resets any previously collected values; disabling frees it.
+ * Collection costs one clock read and a small table scan per take and per
+ * response, and is off by default.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] service the service to collect statistics for
+ * \param[in] enable true to collect statistics, false to stop
+ * \return `RCL_RET_OK` if the mode was set successfully, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating the in-flight table failed, or
+ * \return `RCL_RET_SERVICE_INVALID` if the service is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_service_enable_stats(const rcl_service_t * service, bool enable);
+
+/// Retrieve the statistics collected since stats were enabled.
+/**
+ * The current values are copied into the given struct.
+ * Fails if statistics collection was not enabled with
+ * rcl_service_enable_stats().
+ *
+ * \param[in] service the service the statistics are collected on
+ * \param[out] stats struct to copy the current values into
+ * \return `RCL_RET_OK` if the statistics were retrieved, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid or stats
+ *   collection is not enabled, or
+ * \return `RCL_RET_SERVICE_INVALID` if the service is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_service_get_stats(const rcl_service_t * service, rcl_service_stats_t * stats);
+
 #ifdef __cplusplus
 }
 #endif
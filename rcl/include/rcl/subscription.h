@@ -24,6 +24,7 @@ extern "C"
 
 #include "rcl/macros.h"
 #include "rcl/node.h"
+#include "rcl/time.h"
 #include "rcl/visibility_control.h"
 
 /// Internal rcl implementation struct.
@@ -35,6 +36,30 @@ typedef struct rcl_subscription_t
   struct rcl_subscription_impl_t * impl;
 } rcl_subscription_t;
 
+/// Message meta-data extended with an rcl-captured arrival timestamp.
+typedef struct rcl_message_info_t
+{
+  /// Meta-data provided by the middleware.
+  rmw_message_info_t rmw_message_info;
+  /// System time at which rcl observed the message's arrival.
+  /**
+   * Captured inside the take call, so latency accounting does not need a
+   * separate clock read per message; batched takes capture it once and stamp
+   * the whole batch with it.
+   */
+  rcutils_time_point_value_t received_timestamp;
+} rcl_message_info_t;
+
+/// Predicate evaluated on serialized messages before deserialization.
+/**
+ * Return true if the message should be delivered to the caller, false if it
+ * should be dropped.
+ * \sa rcl_subscription_options_t.content_filter
+ */
+typedef bool (* rcl_content_filter_predicate_t)(
+  const rcl_serialized_message_t * serialized_message,
+  void * user_data);
+
 /// Options available for a rcl subscription.
 typedef struct rcl_subscription_options_t
 {
@@ -45,6 +70,48 @@ typedef struct rcl_subscription_options_t
   /// Custom allocator for the subscription, used for incidental allocations.
   /** For default behavior (malloc/free), see: rcl_get_default_allocator() */
   rcl_allocator_t allocator;
+  /// Number of serialized message buffers cached per power-of-two size class.
+  /**
+   * When non-zero, the subscription maintains a pool of serialized message
+   * buffers, bucketed by power-of-two capacity classes, which is used by
+   * rcl_subscription_acquire_serialized_message() and refilled by
+   * rcl_subscription_release_serialized_message().
+   * When zero (the default), the pool is disabled and acquire/release fall
+   * back to plain allocation and deallocation.
+   */
+  size_t serialized_buffer_pool_depth;
+  /// If true, accept direct deliveries from same-context publishers.
+  /**
+   * The subscription registers a lock-free ring with its context, into which
+   * publishers with enable_intra_context_delivery enqueue message pointers,
+   * bypassing the middleware; consume them with rcl_take_intra_context().
+   */
+  bool enable_intra_context_delivery;
+  /// Capacity of the intra-context delivery ring; 0 selects a default.
+  /**
+   * Rounded up to the next power of two.
+   * Only used when enable_intra_context_delivery is true.
+   */
+  size_t intra_context_ring_capacity;
+  /// Content filter evaluated before messages are deserialized (may be `NULL`).
+  /**
+   * When set, rcl_take() takes samples in serialized form, runs this
+   * predicate on the raw bytes, and only deserializes and returns samples for
+   * which it returns true; the rest are dropped without paying the
+   * deserialization cost.
+   * Non-matching samples still wake the wait set, since the filter runs on
+   * this side of the middleware.
+   */
+  rcl_content_filter_predicate_t content_filter;
+  /// User data handed to every content_filter invocation (may be `NULL`).
+  void * content_filter_user_data;
+  /// If true, collect arrival statistics on every successful take.
+  /**
+   * Each take folds the inter-arrival period into a running mean and
+   * variance inside rcl_take(), costing one steady clock read per message;
+   * read the accumulated values with rcl_subscription_get_stats().
+   */
+  bool enable_stats;
 } rcl_subscription_options_t;
 
 /// Return a rcl_subscription_t struct with members set to `NULL`.
@@ -187,6 +254,42 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_subscription_fini(rcl_subscription_t * subscription, rcl_node_t * node);
 
+/// Retire a subscription, deferring its finalization until it is safe.
+/**
+ * Behaves like rcl_subscription_fini() except that the actual teardown is
+ * handed to the context's reclamation domain (see rcl/reclamation.h) and
+ * runs once every registered thread has passed a quiescent point, so
+ * executor threads that may still be touching the subscription in
+ * rcl_wait() or rcl_take() do not have to be stopped first.
+ *
+ * The subscription handle is invalidated immediately; no new uses may begin
+ * after this call returns.
+ * The node must stay valid until the deferred finalization has run, i.e.
+ * until a later rcl_reclamation_quiescent() or rcl_reclamation_drain() call
+ * reclaimed the subscription.
+ * Errors from the deferred teardown surface from whichever reclamation call
+ * runs the finalizer.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] subscription handle to the subscription to be retired
+ * \param[in] node handle to the node used to create the subscription
+ * \return `RCL_RET_OK` if the subscription was queued for finalization, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating the deferred state failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_fini_deferred(rcl_subscription_t * subscription, rcl_node_t * node);
+
 /// Return the default subscription options in a rcl_subscription_options_t.
 /**
  * The defaults are:
@@ -194,6 +297,11 @@ rcl_subscription_fini(rcl_subscription_t * subscription, rcl_node_t * node);
  * - ignore_local_publications = false
  * - qos = rmw_qos_profile_default
  * - allocator = rcl_get_default_allocator()
+ * - serialized_buffer_pool_depth = 0
+ * - enable_intra_context_delivery = false
+ * - intra_context_ring_capacity = 0
+ * - content_filter = NULL
+ * - content_filter_user_data = NULL
  */
 RCL_PUBLIC
 RCL_WARN_UNUSED
@@ -266,6 +374,464 @@ rcl_take(
   rmw_subscription_allocation_t * allocation
 );
 
+/// A validated subscription handle for the trusted take fast path.
+/**
+ * Obtained with rcl_subscription_get_validation_token() and passed to
+ * rcl_take_unchecked(), which skips the per-call validation that rcl_take()
+ * repeats on every message.
+ * The token is a plain value and may be copied; it stays usable until the
+ * subscription it was taken from is finalized or otherwise invalidated.
+ */
+typedef struct rcl_subscription_validation_token_t
+{
+  /// The subscription this token was validated against.
+  const rcl_subscription_t * subscription;
+} rcl_subscription_validation_token_t;
+
+/// Validate a subscription once and store the result in a token.
+/**
+ * This runs the same checks rcl_take() performs on every call and, on
+ * success, records the subscription in the given token so those checks can be
+ * hoisted out of tight take loops via rcl_take_unchecked().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] subscription handle to the subscription to validate
+ * \param[out] token storage for the validated handle
+ * \return `RCL_RET_OK` if the token was populated successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the token is NULL, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_get_validation_token(
+  const rcl_subscription_t * subscription,
+  rcl_subscription_validation_token_t * token);
+
+/// Take a ROS message using a previously validated subscription.
+/**
+ * Identical to rcl_take() except that the entity validation is assumed to
+ * have been done by rcl_subscription_get_validation_token(), so neither the
+ * token, the subscription behind it, nor the message is checked again.
+ * The caller must guarantee the subscription outlives every use of the token;
+ * taking through a token whose subscription has been finalized, or passing a
+ * NULL token or message, is undefined behavior.
+ * Use this only in hot loops where the validation cost has been measured to
+ * matter; everywhere else rcl_take() is the right call.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] token validated handle from rcl_subscription_get_validation_token()
+ * \param[inout] ros_message type-erased pointer to an allocated ROS message
+ * \param[out] message_info rmw struct which contains meta-data for the message (may be NULL)
+ * \param[in] allocation structure pointer used for memory preallocation (may be NULL)
+ * \return `RCL_RET_OK` if the message was taken, or
+ * \return `RCL_RET_SUBSCRIPTION_TAKE_FAILED` if take failed but no error
+ *         occurred in the middleware, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_unchecked(
+  const rcl_subscription_validation_token_t * token,
+  void * ros_message,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation);
+
+/// Block until this one subscription has a message, then take it.
+/**
+ * Parks directly on the middleware condition for the subscription, using a
+ * dedicated single-entity rmw wait set created on first use, so a
+ * dedicated-thread consumer skips wait set creation, the add/clear cycle,
+ * and the ready scan of rcl_wait() entirely.
+ *
+ * The timeout follows the rcl_wait() convention: negative blocks until a
+ * message arrives, `0` checks without blocking, positive blocks for at most
+ * that many nanoseconds; `RCL_RET_TIMEOUT` is returned if it expires.
+ * On a wakeup the message is taken like rcl_take(), including the
+ * `RCL_RET_SUBSCRIPTION_TAKE_FAILED` return if the middleware woke this
+ * thread spuriously and had no message after all.
+ *
+ * Only one thread may call this per subscription, and it must not be mixed
+ * with having the subscription in an rcl_wait_set_t: both would park on the
+ * same middleware condition and wake-ups would be split between them.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] on the first call, and when filling the message for dynamic sizes</i>
+ *
+ * \param[in] subscription the handle to the subscription from which to take
+ * \param[in] timeout duration to wait in nanoseconds, negative for no limit
+ * \param[inout] ros_message type-erased pointer to an allocated ROS message
+ * \param[inout] message_info rmw struct containing meta-data for the message,
+ *   may be `NULL` if not needed
+ * \return `RCL_RET_OK` if a message was taken, or
+ * \return `RCL_RET_TIMEOUT` if the timeout expired first, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_SUBSCRIPTION_TAKE_FAILED` if take failed but no error
+ *         occurred in the middleware, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_blocking(
+  const rcl_subscription_t * subscription,
+  int64_t timeout,
+  void * ros_message,
+  rmw_message_info_t * message_info);
+
+/// Take a message delivered directly by a same-context publisher.
+/**
+ * Dequeues the oldest message pointer enqueued by a publisher with
+ * enable_intra_context_delivery on the same topic and context, without any
+ * middleware involvement.
+ * The subscription must have been initialized with
+ * enable_intra_context_delivery in its options.
+ *
+ * The returned pointer is the very message the publisher passed to
+ * rcl_publish(); it is not a copy.
+ * The publishing side must therefore keep the message valid and unmodified
+ * until it has been consumed, and the ownership of the memory stays with the
+ * publishing side.
+ *
+ * Intra-context deliveries do not wake a wait set; this function is expected
+ * to be polled, e.g. once per executor cycle.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ * <i>[1] for a single consumer thread per subscription</i>
+ *
+ * \param[in] subscription the handle to the subscription from which to take
+ * \param[out] ros_message type-erased pointer to the delivered ROS message
+ * \return `RCL_RET_OK` if a message was taken, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_SUBSCRIPTION_TAKE_FAILED` if the ring is empty, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_intra_context(
+  const rcl_subscription_t * subscription,
+  void ** ros_message
+);
+
+/// Take a loaned message from a topic using a rcl subscription.
+/**
+ * In contrast to `rcl_take`, the middleware keeps ownership of the message
+ * memory and lends it to the caller, which on shared-memory transports means
+ * the message is read directly from the transport buffer without a copy.
+ * The caller must not deallocate the message; it has to be given back via
+ * rcl_return_loaned_message_from_subscription() when it is no longer needed.
+ *
+ * Apart from the differences above, this function behaves like `rcl_take`.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] subscription the handle to the subscription from which to take
+ * \param[inout] loaned_message a pointer to the loaned message, must point to `NULL`
+ * \param[out] message_info rmw struct which contains meta-data for the message
+ * \param[in] allocation structure pointer used for memory preallocation (may be NULL)
+ * \return `RCL_RET_OK` if the loaned message sequence was taken, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_SUBSCRIPTION_TAKE_FAILED` if take failed but no error
+ *         occurred in the middleware, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support message loaning, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_loaned_message(
+  const rcl_subscription_t * subscription,
+  void ** loaned_message,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation
+);
+
+/// Return a loaned message from a topic using a rcl subscription.
+/**
+ * Ownership of the loaned message previously obtained via
+ * rcl_take_loaned_message() is transferred back to the middleware, which may
+ * deallocate or reuse the memory; the pointer is no longer guaranteed to be
+ * valid after this call.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] subscription the handle to the subscription which loaned the message
+ * \param[in] loaned_message the message to be returned to the middleware
+ * \return `RCL_RET_OK` if the message was returned successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support message loaning, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_return_loaned_message_from_subscription(
+  const rcl_subscription_t * subscription,
+  void * loaned_message
+);
+
+/// Acquire a serialized message buffer from the subscription's buffer pool.
+/**
+ * Fills in `serialized_message` with a buffer whose capacity is at least
+ * `capacity`, rounded up to the pool's power-of-two size class.
+ * If the pool holds a cached buffer of that class it is recycled without
+ * allocating; otherwise a new buffer is allocated with the subscription's
+ * allocator.
+ * Once every size class in use has been populated, e.g. after the first few
+ * takes of a steady workload, acquire and release no longer allocate.
+ *
+ * The buffer must be given back via
+ * rcl_subscription_release_serialized_message() and must not outlive the
+ * subscription.
+ *
+ * If the pool is disabled (see serialized_buffer_pool_depth in
+ * rcl_subscription_options_t), this allocates a fresh buffer every time.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only when no cached buffer of the required size class is available</i>
+ *
+ * \param[in] subscription the handle to the subscription owning the pool
+ * \param[in] capacity minimum buffer capacity in bytes
+ * \param[out] serialized_message message struct to be filled with the buffer
+ * \return `RCL_RET_OK` if a buffer was acquired successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_acquire_serialized_message(
+  const rcl_subscription_t * subscription,
+  size_t capacity,
+  rcl_serialized_message_t * serialized_message
+);
+
+/// Return a serialized message buffer to the subscription's buffer pool.
+/**
+ * The buffer held by `serialized_message` is cached for reuse if its size
+ * class has room in the pool, and deallocated otherwise.
+ * The message struct is zeroed out and must not be used afterwards without
+ * reacquiring a buffer.
+ *
+ * Buffers that did not come from
+ * rcl_subscription_acquire_serialized_message() may also be released here;
+ * those whose capacity is not a pool size class are simply deallocated with
+ * the message's allocator.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] subscription the handle to the subscription owning the pool
+ * \param[inout] serialized_message message whose buffer should be recycled
+ * \return `RCL_RET_OK` if the buffer was released successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_release_serialized_message(
+  const rcl_subscription_t * subscription,
+  rcl_serialized_message_t * serialized_message
+);
+
+/// Take a message and capture its arrival timestamp in one call.
+/**
+ * Behaves like rcl_take(), but fills an rcl_message_info_t whose
+ * received_timestamp is captured inside the call, saving the separate clock
+ * read per message that latency-accounting pipelines otherwise pay.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if required when filling the message, avoided for fixed sizes</i>
+ *
+ * \param[in] subscription the handle to the subscription from which to take
+ * \param[inout] ros_message type-erased ptr to a allocated ROS message
+ * \param[out] message_info meta-data including the rcl arrival timestamp
+ * \param[in] allocation structure pointer used for memory preallocation (may be NULL)
+ * \return `RCL_RET_OK` if the message was taken, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_SUBSCRIPTION_TAKE_FAILED` if take failed but no error
+ *         occurred in the middleware, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_timestamped(
+  const rcl_subscription_t * subscription,
+  void * ros_message,
+  rcl_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation
+);
+
+/// Take a sequence of messages with a shared arrival timestamp.
+/**
+ * Behaves like rcl_take_sequence(), but fills a contiguous array of
+ * rcl_message_info_t and captures the arrival timestamp once per batch,
+ * stamping every taken message with it; the amortized clock cost makes this
+ * suitable for draining high-rate topics.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if required when filling the messages, avoided for fixed sizes</i>
+ *
+ * \param[in] subscription the handle to the subscription from which to take
+ * \param[in] count maximum number of messages to take
+ * \param[inout] ros_messages array of `count` type-erased ptrs to allocated ROS messages
+ * \param[out] message_infos array of `count` info structs, timestamp included
+ * \param[out] taken number of messages actually taken
+ * \param[in] allocation structure pointer used for memory preallocation (may be NULL)
+ * \return `RCL_RET_OK` if one or more messages were taken, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_SUBSCRIPTION_TAKE_FAILED` if no messages were available, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_sequence_timestamped(
+  const rcl_subscription_t * subscription,
+  size_t count,
+  void ** ros_messages,
+  rcl_message_info_t * message_infos,
+  size_t * taken,
+  rmw_subscription_allocation_t * allocation
+);
+
+/// Take a sequence of messages from a topic using a rcl subscription.
+/**
+ * In contrast to `rcl_take`, this function drains up to `count` messages from
+ * the subscription queue in a single call, so a deep queue can be emptied
+ * without paying the per-call overhead once per message.
+ *
+ * It is the job of the caller to ensure that the type of the `ros_messages`
+ * parameter and the type associate with the subscription (via the type support)
+ * match.
+ * The `ros_messages` argument is an array of `count` type-erased pointers, each
+ * of which must point to an already allocated ROS message of the correct type,
+ * into which taken messages are copied in arrival order.
+ *
+ * The `message_infos` argument, if not `NULL`, must be an already allocated
+ * array of `count` rmw_message_info_t structures, filled pairwise with the
+ * taken messages.
+ *
+ * Fewer than `count` messages may be taken if the queue empties first; `taken`
+ * always reports how many entries of the arrays are valid.
+ * Taking zero messages is reported via `RCL_RET_SUBSCRIPTION_TAKE_FAILED`,
+ * as for `rcl_take`.
+ *
+ * Apart from the differences above, this function behaves like `rcl_take`.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if required when filling the messages, avoided for fixed sizes</i>
+ *
+ * \param[in] subscription the handle to the subscription from which to take
+ * \param[in] count maximum number of messages to take
+ * \param[inout] ros_messages array of `count` type-erased ptrs to allocated ROS messages
+ * \param[out] message_infos array of `count` rmw structs for message meta-data (may be NULL)
+ * \param[out] taken number of messages actually taken
+ * \param[in] allocation structure pointer used for memory preallocation (may be NULL)
+ * \return `RCL_RET_OK` if one or more messages were taken, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_SUBSCRIPTION_TAKE_FAILED` if no messages were available, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_sequence(
+  const rcl_subscription_t * subscription,
+  size_t count,
+  void ** ros_messages,
+  rmw_message_info_t * message_infos,
+  size_t * taken,
+  rmw_subscription_allocation_t * allocation
+);
+
 /// Take a serialized raw message from a topic using a rcl subscription.
 /**
  * In contrast to `rcl_take`, this function stores the taken message in
@@ -311,6 +877,95 @@ rcl_take_serialized_message(
   rmw_message_info_t * message_info,
   rmw_subscription_allocation_t * allocation);
 
+/// Take up to `max_n` serialized messages into one contiguous slab.
+/**
+ * Drains the subscription queue like rcl_take_sequence(), but in serialized
+ * form and packed back to back into the caller-provided `slab`, so a recorder
+ * can hand the whole batch to a single gathered write instead of doing one
+ * take and one write per message.
+ *
+ * The `slab` must have a non-null buffer; its capacity bounds how many bytes
+ * the call packs and its `buffer_length` is set to the bytes used.
+ * `offsets_out` must have room for `max_n` entries; entry `i` is the byte
+ * offset of message `i` in the slab, so message `i` ends where message
+ * `i + 1` starts and the last message ends at `slab->buffer_length`.
+ *
+ * Messages are staged in buffers from the subscription's serialized buffer
+ * pool, so enabling the pool (see serialized_buffer_pool_depth in the
+ * subscription options) makes steady-state calls allocation-free.
+ * A message too large for the remaining slab space is not lost: it is held
+ * by the subscription and returned first by the next call.
+ * The call returns whatever was packed before the oversized message, and a
+ * held message larger than the whole slab fails with
+ * `RCL_RET_INVALID_ARGUMENT` until a larger slab is offered.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] allocation-free when the serialized buffer pool is enabled and warm</i>
+ *
+ * \param[in] subscription the handle to the subscription from which to take
+ * \param[in] max_n maximum number of messages to take
+ * \param[inout] slab caller-provided buffer the messages are packed into
+ * \param[out] offsets_out byte offset of each taken message within the slab
+ * \param[out] taken number of messages packed into the slab
+ * \return `RCL_RET_OK` if at least one message was taken, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_SUBSCRIPTION_TAKE_FAILED` if no messages were ready, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_serialized_sequence(
+  const rcl_subscription_t * subscription,
+  size_t max_n,
+  rcl_serialized_message_t * slab,
+  size_t * offsets_out,
+  size_t * taken);
+
+/// Change the KEEP_LAST history depth of a subscription at runtime.
+/**
+ * Adjusts how many messages the middleware may queue for this subscription
+ * without recreating it, so a long-running node entering a low-memory state
+ * can shrink deep queues, and re-grow them later, without the fini/init
+ * cycle that drops discovery state and stalls the data flow.
+ *
+ * Only subscriptions created with RMW_QOS_POLICY_HISTORY_KEEP_LAST can be
+ * adjusted; all other QoS settings are unchanged.
+ * When the depth is reduced below the number of queued messages, which
+ * messages are discarded is rmw implementation defined.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] subscription the handle to the subscription to adjust
+ * \param[in] depth new history depth, must be non-zero
+ * \return `RCL_RET_OK` if the depth was changed, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware cannot adjust the depth, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_set_history_depth(
+  const rcl_subscription_t * subscription,
+  size_t depth);
+
 /// Get the topic name for the subscription.
 /**
  * This function returns the subscription's internal topic name string.
@@ -445,6 +1100,55 @@ rcl_subscription_get_publisher_count(
   const rcl_subscription_t * subscription,
   size_t * publisher_count);
 
+/// Arrival statistics of one subscription, see the enable_stats option.
+/**
+ * Periods are the steady-time intervals between consecutive successful takes
+ * on this subscription, measured at the take rather than at arrival in the
+ * middleware, so time the message queued before the take is included.
+ * All durations are in nanoseconds.
+ */
+typedef struct rcl_subscription_stats_t
+{
+  /// Number of successful takes recorded.
+  uint64_t received_count;
+  /// Mean of the inter-arrival periods; 0 until two takes were recorded.
+  double period_mean;
+  /// Sample variance of the inter-arrival periods; 0 until three takes
+  /// were recorded.
+  double period_variance;
+} rcl_subscription_stats_t;
+
+/// Retrieve the statistics collected since the subscription was created.
+/**
+ * The current values are copied into the given struct.
+ * Fails if the subscription was not created with the enable_stats option
+ * set.
+ * The mean and variance are maintained incrementally (Welford's method),
+ * so a snapshot is exact for the takes recorded so far, not an estimate
+ * over a window.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] subscription the subscription the statistics are collected on
+ * \param[out] stats struct to copy the current values into
+ * \return `RCL_RET_OK` if the statistics were retrieved, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid or stats
+ *   collection is not enabled, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_get_stats(
+  const rcl_subscription_t * subscription,
+  rcl_subscription_stats_t * stats);
+
 #ifdef __cplusplus
 }
 #endif
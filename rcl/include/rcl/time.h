@@ -121,6 +121,14 @@ typedef struct rcl_clock_t
   rcl_jump_callback_info_t * jump_callbacks;
   /// Number of callbacks in jump_callbacks.
   size_t num_jump_callbacks;
+  /// Allocated capacity of jump_callbacks; grown geometrically as callbacks are added.
+  size_t jump_callbacks_capacity;
+  /// Indices into jump_callbacks, ordered by ascending min_forward threshold.
+  size_t * jump_callbacks_forward_order;
+  /// Indices into jump_callbacks, ordered by descending min_backward threshold.
+  size_t * jump_callbacks_backward_order;
+  /// Most recently cached time value; see rcl_clock_cache_now().
+  rcl_time_point_value_t cached_now;
   rcl_ret_t (* get_now)(void * data, rcl_time_point_value_t * now);
   // void (*set_now) (rcl_time_point_value_t);
   void * data;
@@ -342,6 +350,82 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_clock_get_now(rcl_clock_t * clock, rcl_time_point_value_t * time_point_value);
 
+/// Read the clock and store the value in the clock's cache.
+/**
+ * Refreshes the value returned by rcl_clock_get_now_coarse().
+ * This is called by rcl_wait() for the clock of each timer in the wait set,
+ * so that code running between wakeups can read time without a clock query
+ * per read; it may also be called from a dedicated tick.
+ *
+ * The cache is not synchronized; like wait sets, it is expected to be
+ * refreshed and read from a single thread.
+ *
+ * \param[in] clock The time source to read and cache.
+ * 
+eturn `RCL_RET_OK` if the cache was updated successfully, or
+ * 
+eturn `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * 
+eturn `RCL_RET_ERROR` an unspecified error occur.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_clock_cache_now(rcl_clock_t * clock);
+
+/// Fill the time point value with the most recently cached clock value.
+/**
+ * Returns the value stored by the last rcl_clock_cache_now() call without
+ * querying the underlying time source, trading accuracy for a plain load.
+ * The staleness is bounded by the caching interval, e.g. one wait-loop
+ * iteration.
+ * If the cache has never been filled the clock is queried directly and the
+ * result primes the cache.
+ *
+ * \param[in] clock The time source whose cache to read.
+ * \param[out] time_point_value The time_point value to populate.
+ * 
+eturn `RCL_RET_OK` if a value was retrieved successfully, or
+ * 
+eturn `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * 
+eturn `RCL_RET_ERROR` an unspecified error occur.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_clock_get_now_coarse(rcl_clock_t * clock, rcl_time_point_value_t * time_point_value);
+
+/// Retrieve the override epoch of the clock.
+/**
+ * The epoch is a counter incremented every time the clock's time override
+ * changes, i.e. by rcl_set_ros_time_override(), rcl_enable_ros_time_override()
+ * and rcl_disable_ros_time_override().
+ * Readers can stash the epoch and later detect, with a single atomic load,
+ * whether an override happened in between, instead of being visited eagerly
+ * from the override writer.
+ * For clock types which cannot be overridden the epoch is always 0.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [1]
+ * <i>[1] if `atomic_is_lock_free()` returns true for `atomic_uint_least64_t`</i>
+ *
+ * \param[in] clock The clock whose override epoch to read.
+ * \param[out] epoch The current override epoch of the clock.
+ * \return `RCL_RET_OK` if the epoch was retrieved successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` an unspecified error occur.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_clock_get_override_epoch(rcl_clock_t * clock, uint64_t * epoch);
+
 
 /// Enable the ROS time abstraction override.
 /**
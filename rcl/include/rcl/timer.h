@@ -116,7 +116,7 @@ rcl_get_zero_initialized_timer(void);
  *
  * rcl_timer_t timer = rcl_get_zero_initialized_timer();
  * ret = rcl_timer_init(
- *   &timer, &clock, context, RCL_MS_TO_NS(100), my_timer_callback, allocator);
+ *   &timer, &clock, context, RCL_MS_TO_NS(100), 0, my_timer_callback, allocator);
  * // ... error handling, use the timer with a wait set, or poll it manually, then cleanup
  * ret = rcl_timer_fini(&timer);
  * // ... error handling
@@ -139,6 +139,9 @@ rcl_get_zero_initialized_timer(void);
  * \param[in] clock the clock providing the current time
  * \param[in] context the context that this timer is to be associated with
  * \param[in] period the duration between calls to the callback in nanoseconds
+ * \param[in] slack tolerable wakeup lateness in nanoseconds, used by
+ *   rcl_wait() to coalesce this timer's wakeup with nearby timer deadlines;
+ *   0 disables coalescing for this timer
  * \param[in] callback the user defined function to be called every period
  * \param[in] allocator the allocator to use for allocations
  * \return `RCL_RET_OK` if the timer was initialized successfully, or
@@ -155,6 +158,62 @@ rcl_timer_init(
   rcl_clock_t * clock,
   rcl_context_t * context,
   int64_t period,
+  int64_t slack,
+  const rcl_timer_callback_t callback,
+  rcl_allocator_t allocator);
+
+/// Initialize a timer which fires once at an absolute deadline.
+/**
+ * The timer becomes ready when the given clock reaches `deadline`, fires
+ * once, and cancels itself afterwards.
+ * This replaces the pattern of computing a relative delta with an extra
+ * clock read and canceling a periodic timer after its first call, which
+ * is what schedulers implementing "fire at time T" otherwise have to do.
+ *
+ * The deadline is a time point on the given clock, in nanoseconds.
+ * A deadline at or before the current time makes the timer immediately
+ * ready.
+ * Like any canceled timer, a fired one-shot timer can be reused with
+ * rcl_timer_reset(), which makes it immediately ready again; re-arming at
+ * a new deadline is done by initializing a new timer.
+ *
+ * Apart from the firing behavior the timer behaves exactly as one
+ * initialized with rcl_timer_init(); see that function for the callback
+ * and allocation semantics.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [1][2][3]
+ * <i>[1] if `atomic_is_lock_free()` returns true for `atomic_uintptr_t`</i>
+ *
+ * <i>[2] if `atomic_is_lock_free()` returns true for `atomic_uint_least64_t`</i>
+ *
+ * <i>[3] if `atomic_is_lock_free()` returns true for `atomic_bool`</i>
+ *
+ * \param[inout] timer the timer handle to be initialized
+ * \param[in] clock the clock providing the current time
+ * \param[in] context the context that this timer is to be associated with
+ * \param[in] deadline the time point at which the timer fires, in nanoseconds
+ * \param[in] callback the user defined function to be called at the deadline
+ * \param[in] allocator the allocator to use for allocations
+ * \return `RCL_RET_OK` if the timer was initialized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ALREADY_INIT` if the timer was already initialized, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` an unspecified error occur.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_init_oneshot_at(
+  rcl_timer_t * timer,
+  rcl_clock_t * clock,
+  rcl_context_t * context,
+  rcl_time_point_value_t deadline,
   const rcl_timer_callback_t callback,
   rcl_allocator_t allocator);
 
@@ -233,6 +292,48 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_timer_call(rcl_timer_t * timer);
 
+/// Call every expired timer in a batch, reading the clock only once.
+/**
+ * Equivalent to checking rcl_timer_is_ready() and invoking rcl_timer_call()
+ * for each of the given timers, but the current time is read once for the
+ * whole batch and expired timers fire in deadline order, most overdue first,
+ * amortizing the per-timer clock and bookkeeping overhead that dominates
+ * when an executor fires tens of timers per tick.
+ *
+ * All timers must use the same clock.
+ * The time point `now` should come from that clock; passing `0` makes this
+ * function read the first timer's clock once instead.
+ * The array is permuted so the first `number_called` entries are the timers
+ * which fired, in the order they fired; no entries are lost.
+ * Canceled timers are skipped rather than causing an error.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [1]
+ * <i>[1] if `atomic_is_lock_free()` returns true for `atomic_int_least64_t`</i>
+ *
+ * \param[inout] timers array of timers to check and call; reordered in place
+ * \param[in] number_of_timers number of entries in `timers`
+ * \param[in] now current time of the timers' clock, or `0` to read it here
+ * \param[out] number_called how many timers were expired and fired
+ * \return `RCL_RET_OK` if the batch was processed, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_TIMER_INVALID` if any timer is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timers_call_expired(
+  rcl_timer_t ** timers,
+  size_t number_of_timers,
+  rcl_time_point_value_t now,
+  size_t * number_called);
+
 /// Retrieve the clock of the timer.
 /**
  * This function retrieves the clock pointer and copies it into the given variable.
@@ -383,6 +484,92 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_timer_get_period(const rcl_timer_t * timer, int64_t * period);
 
+/// Retrieve the slack of the timer.
+/**
+ * This function retrieves the slack given to rcl_timer_init() and copies it
+ * into the given variable.
+ * The slack is the lateness the timer tolerates so that rcl_wait() can merge
+ * its wakeup with other timers whose deadlines fall within the slack window.
+ *
+ * The slack argument must be a pointer to an already allocated int64_t.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] timer the handle to the timer which is being queried
+ * \param[out] slack the int64_t in which the slack is stored
+ * \return `RCL_RET_OK` if the slack was retrieved successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_TIMER_INVALID` if the timer is invalid, or
+ * \return `RCL_RET_ERROR` an unspecified error occur.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_get_slack(const rcl_timer_t * timer, int64_t * slack);
+
+/// Enable or disable precision wakeups for this timer.
+/**
+ * While enabled, rcl_wait() shortens the blocking wait for this timer by a
+ * small delta and busy-spins the final stretch to the deadline, so the timer
+ * becomes ready within microseconds of its deadline instead of whatever
+ * wakeup latency the blocking wait exhibits under load.
+ * The delta is calibrated continuously from the wake latency rcl_wait()
+ * observes, so it tracks the load on the machine.
+ *
+ * The spin burns a core for up to the delta before every fire of this timer,
+ * so it is only worthwhile for timers whose accuracy requirement is tighter
+ * than the platform's wakeup latency; precision and slack
+ * (see rcl_timer_get_slack()) are contradictory, and a precision timer is
+ * never coalesced with its neighbors.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [1]
+ * <i>[1] if `atomic_is_lock_free()` returns true for `atomic_bool`</i>
+ *
+ * \param[in] timer the handle to the timer on which to set the mode
+ * \param[in] enabled true to spin the final approach to each deadline
+ * \return `RCL_RET_OK` if the mode was set successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_TIMER_INVALID` if the timer is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_set_precision(const rcl_timer_t * timer, bool enabled);
+
+/// Retrieve the precision wakeup mode of the timer.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [1]
+ * <i>[1] if `atomic_is_lock_free()` returns true for `atomic_bool`</i>
+ *
+ * \param[in] timer the handle to the timer which is being queried
+ * \param[out] enabled true if precision wakeups are enabled
+ * \return `RCL_RET_OK` if the mode was retrieved successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_TIMER_INVALID` if the timer is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_get_precision(const rcl_timer_t * timer, bool * enabled);
+
 /// Exchange the period of the timer and return the previous period.
 /**
  * This function exchanges the period in the timer and copies the old one into
@@ -464,6 +651,63 @@ RCL_WARN_UNUSED
 rcl_timer_callback_t
 rcl_timer_exchange_callback(rcl_timer_t * timer, const rcl_timer_callback_t new_callback);
 
+/// Return the user data pointer of the timer.
+/**
+ * The user data pointer is an opaque pointer set with
+ * rcl_timer_set_user_data() and never interpreted by rcl.
+ * It gives timer callbacks, which only receive the timer handle, constant
+ * time access to their associated context instead of requiring the client
+ * library to keep a side lookup from timer to context.
+ * The pointer is `NULL` until it is set.
+ *
+ * This function can fail, and therefore return `NULL`, if:
+ *   - timer is `NULL`
+ *   - timer has not been initialized (the implementation is invalid)
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [1]
+ * <i>[1] if `atomic_is_lock_free()` returns true for `atomic_uintptr_t`</i>
+ *
+ * \param[in] timer handle to the timer which is being queried
+ * \return the user data pointer, or `NULL` if unset or an error occurred
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+void *
+rcl_timer_get_user_data(const rcl_timer_t * timer);
+
+/// Set the user data pointer of the timer.
+/**
+ * The pointer is stored as-is and can be retrieved with
+ * rcl_timer_get_user_data(); the lifetime of whatever it points to is the
+ * caller's responsibility.
+ * Setting `NULL` clears the user data.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [1]
+ * <i>[1] if `atomic_is_lock_free()` returns true for `atomic_uintptr_t`</i>
+ *
+ * \param[inout] timer handle to the timer which is being modified
+ * \param[in] user_data opaque pointer stored with the timer, may be `NULL`
+ * \return `RCL_RET_OK` if the user data was set successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_TIMER_INVALID` if the timer is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_set_user_data(rcl_timer_t * timer, void * user_data);
+
 /// Cancel a timer.
 /**
  * When a timer is canceled, rcl_timer_is_ready() will return false for that
@@ -588,6 +832,72 @@ RCL_WARN_UNUSED
 rcl_guard_condition_t *
 rcl_timer_get_guard_condition(const rcl_timer_t * timer);
 
+/// Get the earliest deadline across all timers registered with a context.
+/**
+ * Timers register with their context's shared timer wheel during
+ * rcl_timer_init(), so the next deadline is available without scanning the
+ * individual timer objects.
+ * The deadline is an absolute steady time point, in nanoseconds, suitable for
+ * computing a wait timeout; `INT64_MAX` is reported when the context has no
+ * registered timers.
+ *
+ * Deadlines in the wheel are approximations which are re-verified against the
+ * timers as they expire, so a reported deadline can be earlier than the
+ * owning timer's true readiness, but never later by more than the wheel's
+ * resolution.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] context the context whose timer wheel should be queried
+ * \param[out] deadline earliest absolute steady-time deadline, in nanoseconds
+ * \return `RCL_RET_OK` if the query succeeded, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_wheel_next_deadline(rcl_context_t * context, int64_t * deadline);
+
+/// Take the timers of a context which are ready to be called.
+/**
+ * Advances the context's shared timer wheel to the current steady time and
+ * returns up to `batch_size` timers which are ready, verified with
+ * rcl_timer_is_ready(); the cost is proportional to the number of expired
+ * timers, not to the number registered.
+ * The returned timers are expected to be called with rcl_timer_call(); they
+ * are automatically re-armed in the wheel at their next deadline.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] context the context whose timer wheel should be advanced
+ * \param[out] timers array of `batch_size` entries filled with ready timers
+ * \param[in] batch_size maximum number of timers to return
+ * \param[out] taken number of ready timers returned
+ * \return `RCL_RET_OK` if the wheel was advanced successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_wheel_take_expired(
+  rcl_context_t * context,
+  const rcl_timer_t ** timers,
+  size_t batch_size,
+  size_t * taken);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,115 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__TRACEPOINT_H_
+#define RCL__TRACEPOINT_H_
+
+#include <stdbool.h>
+
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+#include "rcutils/time.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Signature of a tracepoint callback.
+/**
+ * \param[in] name stable identifier of the tracepoint, e.g. "rcl_publish_entry";
+ *   a string literal with static storage duration, usable as a key by address
+ * \param[in] entity handle of the entity the tracepoint refers to, e.g. the
+ *   `rcl_publisher_t` pointer for publish tracepoints; only usable as an
+ *   identifier, not to be dereferenced
+ * \param[in] timestamp steady clock time at which the tracepoint fired, in
+ *   nanoseconds, or `0` if the time could not be read
+ */
+typedef void (* rcl_tracepoint_callback_t)(
+  const char * name,
+  const void * entity,
+  rcutils_time_point_value_t timestamp);
+
+/// Set the callback invoked whenever a compiled-in tracepoint fires.
+/**
+ * Tracepoints are compiled into rcl's hot paths (publish, take, wait, timer
+ * call, send request, take response) only when rcl was built with the
+ * `RCL_ENABLE_TRACEPOINTS` CMake option; otherwise they do not exist in the
+ * binary and this callback is never invoked.
+ * Use rcl_tracepoint_is_compiled_in() to tell the two builds apart.
+ *
+ * The callback runs on the thread that hit the tracepoint and should return
+ * quickly; it may be invoked concurrently from several threads.
+ * Passing `NULL` clears the callback.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] callback callback to invoke per tracepoint, or `NULL` to clear
+ * \return `RCL_RET_OK` always.
+ */
+RCL_PUBLIC
+rcl_ret_t
+rcl_tracepoint_set_callback(rcl_tracepoint_callback_t callback);
+
+/// Return true if tracepoints were compiled into this rcl build.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ */
+RCL_PUBLIC
+bool
+rcl_tracepoint_is_compiled_in(void);
+
+/// Fire a tracepoint, invoking the registered callback if there is one.
+/**
+ * This is called by the RCL_TRACEPOINT() macro at instrumented sites; it is
+ * not intended to be called directly.
+ * When no callback is registered the cost is a single atomic load.
+ *
+ * \param[in] name stable identifier of the tracepoint; must be a string
+ *   literal or otherwise have static storage duration
+ * \param[in] entity handle of the entity the tracepoint refers to
+ */
+RCL_PUBLIC
+void
+rcl_tracepoint_fire(const char * name, const void * entity);
+
+/// Emit a tracepoint with the given stable identifier and entity handle.
+/**
+ * Expands to nothing unless built with the `RCL_ENABLE_TRACEPOINTS` CMake
+ * option, so instrumented code pays no cost in a regular build.
+ */
+#ifdef RCL_ENABLE_TRACEPOINTS
+#define RCL_TRACEPOINT(event, entity) \
+  rcl_tracepoint_fire(#event, (const void *)(entity))
+#else
+#define RCL_TRACEPOINT(event, entity) (void)(entity)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__TRACEPOINT_H_
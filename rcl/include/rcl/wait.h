@@ -22,6 +22,7 @@ extern "C"
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "rcl/client.h"
 #include "rcl/guard_condition.h"
@@ -35,6 +36,45 @@ extern "C"
 
 struct rcl_wait_set_impl_t;
 
+/// The types of entities which can be stored in a wait set.
+typedef enum rcl_wait_set_entity_type_t
+{
+  RCL_WAIT_SET_SUBSCRIPTION = 0,
+  RCL_WAIT_SET_GUARD_CONDITION,
+  RCL_WAIT_SET_TIMER,
+  RCL_WAIT_SET_CLIENT,
+  RCL_WAIT_SET_SERVICE,
+  RCL_WAIT_SET_EVENT,
+  /// Number of entity types, not a valid type.
+  RCL_WAIT_SET_ENTITY_TYPES
+} rcl_wait_set_entity_type_t;
+
+/// Per-cycle wait statistics, see rcl_wait_set_enable_stats().
+/**
+ * All durations are in nanoseconds of steady time.
+ */
+typedef struct rcl_wait_set_stats_t
+{
+  /// Number of completed rcl_wait() cycles since stats were enabled.
+  uint64_t cycle_count;
+  /// Time blocked in rmw_wait during the last cycle.
+  uint64_t last_rmw_wait_time;
+  /// Accumulated time blocked in rmw_wait.
+  uint64_t total_rmw_wait_time;
+  /// Shortest observed rmw_wait block.
+  uint64_t min_rmw_wait_time;
+  /// Longest observed rmw_wait block.
+  uint64_t max_rmw_wait_time;
+  /// rcl-side overhead (timeout computation and pruning) of the last cycle.
+  uint64_t last_overhead_time;
+  /// Accumulated rcl-side overhead.
+  uint64_t total_overhead_time;
+  /// Number of entities found ready in the last cycle.
+  uint64_t last_ready_entities;
+  /// Accumulated number of ready entities.
+  uint64_t total_ready_entities;
+} rcl_wait_set_stats_t;
+
 /// Container for subscription's, guard condition's, etc to be waited on.
 typedef struct rcl_wait_set_t
 {
@@ -248,6 +288,188 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_wait_set_clear(rcl_wait_set_t * wait_set);
 
+/// Enable or disable persistent registration of entities in the wait set.
+/**
+ * By default a wait set is cleared and repopulated on every spin cycle:
+ * rcl_wait_set_clear() empties all of the sets and each entity has to be
+ * added again before the next call to rcl_wait().
+ *
+ * In persistent mode, entities stay attached to the wait set once added.
+ * rcl_wait_set_clear() then only restores the entries which rcl_wait() set to
+ * `NULL` because they were not ready, using an internal snapshot of the
+ * attached entities, instead of emptying the sets.
+ * This avoids re-validating and re-adding every entity on every cycle, which
+ * matters at high spin rates with many entities.
+ *
+ * When enabling persistent mode the currently added entities are snapshotted,
+ * so this can be called before or after populating the wait set.
+ * Entities added while persistent mode is active also become part of the
+ * registration.
+ * Calling rcl_wait_set_resize() discards the registration; entities have to
+ * be re-added afterwards.
+ * Disabling persistent mode releases the snapshot and restores the
+ * clear-and-rebuild behavior.
+ *
+ * The entities in a persistent registration must outlive the registration;
+ * disable persistent mode or resize the wait set before finalizing an
+ * attached entity.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set struct which should keep its entities across clears
+ * \param[in] persistent true to enable persistent registration, false to disable
+ * \return `RCL_RET_OK` if the mode was set successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_set_persistent(rcl_wait_set_t * wait_set, bool persistent);
+
+/// Get the indices of the entities found ready by the last rcl_wait().
+/**
+ * rcl_wait() maintains a compact list of the ready indices per entity type
+ * while it prunes the not ready entries, so dispatching after a wake can
+ * iterate over just the ready entities instead of scanning every slot of a
+ * potentially large, sparse set.
+ *
+ * The returned pointer refers to storage owned by the wait set and is valid
+ * until the next call to rcl_wait(), rcl_wait_set_clear(),
+ * rcl_wait_set_resize(), or rcl_wait_set_fini().
+ * The indices index into the corresponding entity array of the wait set,
+ * e.g. `wait_set->subscriptions` for `RCL_WAIT_SET_SUBSCRIPTION`.
+ * For `RCL_WAIT_SET_TIMER` the indices are ordered most overdue first, so
+ * dispatching in list order fires starved timers before less urgent ones;
+ * other entity types are in slot order.
+ * When priority classes are assigned with rcl_wait_set_set_entity_priority(),
+ * higher classes come first and the orders above apply within a class.
+ * Before the first call to rcl_wait(), and after a clear, the count is zero.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] wait_set the wait set which has been waited on
+ * \param[in] type the type of entity to retrieve the ready indices for
+ * \param[out] indices pointer to the internal array of ready indices
+ * \param[out] count number of valid entries in `indices`
+ * \return `RCL_RET_OK` if the ready entities were retrieved, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_get_ready_entities(
+  const rcl_wait_set_t * wait_set,
+  rcl_wait_set_entity_type_t type,
+  const size_t ** indices,
+  size_t * count);
+
+/// Assign a priority class to an entity slot of the wait set.
+/**
+ * The ready lists reported by rcl_wait_set_get_ready_entities(), and thereby
+ * the dispatch order of the on-ready callback, are ordered so entities with a
+ * higher priority class come first after every rcl_wait().
+ * This lets an executor notice an urgent entity, such as an emergency-stop
+ * subscription, before working through bulk-data entities that became ready
+ * in the same cycle, without restructuring the application.
+ *
+ * Every slot starts in the default class `0`; within a class the usual order
+ * is kept, so wait sets which never assign priorities behave exactly as
+ * before and skip the reordering entirely.
+ * The priority belongs to the slot at `index`, as reported by the
+ * rcl_wait_set_add_* call, so it is assigned after adding the entity.
+ * Like the entities themselves, priorities are dropped by
+ * rcl_wait_set_clear() unless the wait set is persistent, in which case they
+ * are kept.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set struct holding the entity to prioritize
+ * \param[in] type the type of the entity
+ * \param[in] index the index of the entity's slot, from the add call
+ * \param[in] priority the priority class, higher values dispatch first
+ * \return `RCL_RET_OK` if the priority was assigned successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_set_entity_priority(
+  rcl_wait_set_t * wait_set,
+  rcl_wait_set_entity_type_t type,
+  size_t index,
+  uint8_t priority);
+
+/// Signature of the callback invoked by rcl_wait() for each ready entity.
+/**
+ * \param[in] wait_set the wait set that was waited on
+ * \param[in] type the type of the ready entity
+ * \param[in] index the index of the ready entity in the corresponding array
+ * \param[in] user_data the pointer given when the callback was registered
+ */
+typedef void (* rcl_wait_set_on_ready_callback_t)(
+  const rcl_wait_set_t * wait_set,
+  rcl_wait_set_entity_type_t type,
+  size_t index,
+  void * user_data);
+
+/// Register a callback to be invoked by rcl_wait() for each ready entity.
+/**
+ * When a callback is registered, rcl_wait() invokes it once per ready entity
+ * before returning, in entity type order and in ready-list order within a
+ * type, see rcl_wait_set_get_ready_entities().
+ * This saves latency-sensitive callers the round trip of waking up, scanning
+ * the set, and dispatching: the dispatch happens directly on the waiting
+ * thread while the ready entities are hot in cache.
+ *
+ * The callback runs on the thread calling rcl_wait() and must not call
+ * functions which modify the wait set it is invoked for.
+ * Passing `NULL` as the callback unregisters it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set the wait set to dispatch readiness notifications for
+ * \param[in] callback the callback to invoke, or `NULL` to unregister
+ * \param[in] user_data opaque pointer passed through to the callback
+ * \return `RCL_RET_OK` if the callback was set successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if wait_set is `NULL`, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_set_on_ready_callback(
+  rcl_wait_set_t * wait_set,
+  rcl_wait_set_on_ready_callback_t callback,
+  void * user_data);
+
 /// Reallocate space for entities in the wait set.
 /**
  * This function will deallocate and reallocate the memory for all entity sets.
@@ -362,6 +584,398 @@ rcl_wait_set_add_event(
   const rcl_event_t * event,
   size_t * index);
 
+/// The file descriptor is ready for reading.
+#define RCL_WAIT_SET_FD_READABLE (1u << 0)
+/// The file descriptor is ready for writing.
+#define RCL_WAIT_SET_FD_WRITABLE (1u << 1)
+/// The file descriptor is in an error state (always reported when it occurs).
+#define RCL_WAIT_SET_FD_ERROR (1u << 2)
+
+/// A file descriptor attached to a wait set, see rcl_wait_set_add_fd().
+typedef struct rcl_wait_set_fd_t
+{
+  /// The file descriptor being waited on.
+  int fd;
+  /// Events of interest, a bitmask of the `RCL_WAIT_SET_FD_*` flags.
+  uint32_t events;
+  /// Events observed by the last rcl_wait(), same flags as `events`.
+  uint32_t revents;
+} rcl_wait_set_fd_t;
+
+/// Attach a file descriptor to the wait set.
+/**
+ * rcl_wait() then reports readiness of the file descriptor alongside the
+ * middleware entities, so sockets and device descriptors can be served from
+ * the same thread without a separate I/O thread relaying readiness through a
+ * guard condition.
+ *
+ * The middleware cannot block on file descriptors, so while any are attached
+ * rcl_wait() polls them before and after the middleware wait and bounds one
+ * block to the poll period, see rcl_wait_set_set_fd_poll_period().
+ * As a consequence rcl_wait() may return `RCL_RET_TIMEOUT` after the poll
+ * period rather than the full timeout; callers should treat a timeout as
+ * "nothing ready" and wait again.
+ *
+ * File descriptor storage grows on demand, so attachment is not bounded by
+ * the capacities given to rcl_wait_set_init().
+ * Like the middleware entities, the attachments are dropped by
+ * rcl_wait_set_clear() unless the wait set is persistent, in which case they
+ * are kept.
+ * Readiness is reported through the `revents` member, retrieved with
+ * rcl_wait_set_get_fds().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set struct where the file descriptor is stored
+ * \param[in] fd a valid file descriptor to be waited on
+ * \param[in] events bitmask of the `RCL_WAIT_SET_FD_*` flags of interest
+ * \param[out] index the index of the attached file descriptor in the storage,
+ *   or `NULL` if unused
+ * \return `RCL_RET_OK` if added successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_UNSUPPORTED` on platforms without poll().
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_add_fd(
+  rcl_wait_set_t * wait_set,
+  int fd,
+  uint32_t events,
+  size_t * index);
+
+/// Set the polling period used while file descriptors are attached.
+/**
+ * While file descriptors are attached, one blocking middleware wait inside
+ * rcl_wait() is bounded by this period so that file descriptor readiness is
+ * noticed in time.
+ * Smaller periods reduce the worst-case latency for file descriptor events at
+ * the cost of more wakeups while idle.
+ * The default is one millisecond.
+ *
+ * \param[inout] wait_set the wait set to set the period on
+ * \param[in] period the polling period in nanoseconds, has to be positive
+ * \return `RCL_RET_OK` if the period was set successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_set_fd_poll_period(rcl_wait_set_t * wait_set, int64_t period);
+
+/// Get the attached file descriptors and their readiness.
+/**
+ * The returned array is owned by the wait set and is valid until the wait set
+ * is cleared, resized, or finalized.
+ * The `revents` members reflect the outcome of the last rcl_wait().
+ *
+ * \param[in] wait_set the wait set holding the file descriptors
+ * \param[out] fds points to the file descriptor storage afterwards
+ * \param[out] count the number of attached file descriptors
+ * \return `RCL_RET_OK` if the storage was retrieved, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_get_fds(
+  const rcl_wait_set_t * wait_set,
+  const rcl_wait_set_fd_t ** fds,
+  size_t * count);
+
+/// A pre-validated handle to an entity, used for unchecked wait set adds.
+/**
+ * Created with rcl_wait_set_entity_token_init(), which performs the argument
+ * and validity checking once and caches the underlying rmw handle.
+ * Treat the members as opaque.
+ */
+typedef struct rcl_wait_set_entity_token_t
+{
+  /// The type of the referenced entity.
+  rcl_wait_set_entity_type_t type;
+  /// The rcl entity, e.g. a `const rcl_subscription_t *`.
+  const void * entity;
+  /// The cached rmw representation of the entity.
+  void * rmw_data;
+} rcl_wait_set_entity_token_t;
+
+/// Validate an entity once and produce a token for unchecked adds.
+/**
+ * The entity has to outlive the token and the token becomes invalid if the
+ * entity is finalized; re-validate after finalizing and re-initializing an
+ * entity.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[out] token the token to initialize
+ * \param[in] type the type of the given entity
+ * \param[in] entity the entity to validate, e.g. a `const rcl_subscription_t *`
+ * \return `RCL_RET_OK` if the token was initialized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if the entity's rmw handle cannot be retrieved.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_entity_token_init(
+  rcl_wait_set_entity_token_t * token,
+  rcl_wait_set_entity_type_t type,
+  const void * entity);
+
+/// Add a pre-validated entity to the wait set without per-call checking.
+/**
+ * Equivalent to the typed rcl_wait_set_add_* call for the token's entity
+ * type, but skips the argument and validity checks which were already done
+ * by rcl_wait_set_entity_token_init(), leaving only the capacity check on
+ * the hot path.
+ * Passing a `NULL` wait set, an invalid wait set, or a token which was not
+ * initialized with rcl_wait_set_entity_token_init() is undefined behavior.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set struct in which the entity is to be stored
+ * \param[in] token pre-validated token referencing the entity to add
+ * \param[out] index the index of the added entity in the storage container.
+ *   This parameter is optional and can be set to `NULL` to be ignored.
+ * \return `RCL_RET_OK` if added successfully, or
+ * \return `RCL_RET_WAIT_SET_FULL` if the corresponding set is full, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_add_token(
+  rcl_wait_set_t * wait_set,
+  const rcl_wait_set_entity_token_t * token,
+  size_t * index);
+
+/// Enable or disable collection of per-cycle statistics in rcl_wait().
+/**
+ * While enabled, rcl_wait() brackets the rmw_wait call with steady clock
+ * reads and accumulates how long it was blocked in the middleware, how much
+ * time the rcl side spent on timeout computation and pruning, and how many
+ * entities were ready, separating middleware blocking from rcl overhead
+ * without external clocks around rcl_wait().
+ * Enabling resets any previously collected values.
+ * Collection costs three extra clock reads per cycle and is off by default.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set the wait set to collect statistics for
+ * \param[in] enable true to collect statistics, false to stop
+ * \return `RCL_RET_OK` if the mode was set successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if wait_set is `NULL`, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_enable_stats(rcl_wait_set_t * wait_set, bool enable);
+
+/// Retrieve the statistics collected since stats were enabled.
+/**
+ * The current values are copied into the given struct.
+ * Fails if statistics collection was not enabled with
+ * rcl_wait_set_enable_stats().
+ *
+ * \param[in] wait_set the wait set the statistics are collected on
+ * \param[out] stats struct to copy the current values into
+ * \return `RCL_RET_OK` if the statistics were retrieved, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid or stats
+ *   collection is not enabled, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_get_stats(const rcl_wait_set_t * wait_set, rcl_wait_set_stats_t * stats);
+
+/// Set how long rcl_wait() spins before falling into the blocking wait.
+/**
+ * While a spin duration is set, rcl_wait() first probes readiness with
+ * zero-timeout middleware waits for up to `spin_duration` nanoseconds
+ * before blocking.
+ * An entity that becomes ready within that window is picked up without
+ * paying the sleep/wake cost of the blocking wait, which cuts wakeup
+ * latency on pinned cores for paths where the next message usually
+ * arrives within a few tens of microseconds.
+ * The spinning thread occupies its core for the whole window, so this is
+ * a deliberate trade of CPU for latency; keep the duration small and use
+ * it only on latency-critical wait loops.
+ *
+ * The spin phase only takes effect on persistent wait sets (see
+ * rcl_wait_set_set_persistent()), because every fruitless probe prunes
+ * the entity arrays and the persistent shadow storage is what re-arms
+ * them between probes.
+ * Attached file descriptors are polled during the spin as well.
+ * The blocking wait that follows an unsuccessful spin is shortened by the
+ * time spent spinning, so overall timeouts are unaffected.
+ * A duration of zero, the default, disables the spin phase.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set the wait set to set the spin duration on
+ * \param[in] spin_duration how long to probe before blocking, in nanoseconds
+ * \return `RCL_RET_OK` if the duration was set successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_set_spin_duration(rcl_wait_set_t * wait_set, int64_t spin_duration);
+
+/// Internal rcl wait set group implementation struct.
+struct rcl_wait_set_group_impl_t;
+
+/// A group of wait sets which shards entities for multi-threaded executors.
+/**
+ * Each shard is an independent rcl_wait_set_t backed by its own rmw wait set,
+ * so one executor thread per shard can block in rcl_wait() without contending
+ * with the others, instead of sharing a single wait set or duplicating
+ * entities across sets.
+ * Distributing entities across the shards is up to the caller;
+ * rcl_wait_set_group_next_wait_set() provides a balanced round-robin pick.
+ * Cross-shard dispatch policies such as work stealing belong to the executor
+ * layer on top of this.
+ */
+typedef struct rcl_wait_set_group_t
+{
+  /// Storage for the wait sets, one per shard.
+  rcl_wait_set_t * wait_sets;
+  size_t size_of_wait_sets;
+  /// Implementation specific storage.
+  struct rcl_wait_set_group_impl_t * impl;
+} rcl_wait_set_group_t;
+
+/// Return a rcl_wait_set_group_t struct with members set to `NULL`.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_wait_set_group_t
+rcl_get_zero_initialized_wait_set_group(void);
+
+/// Initialize a group of wait sets sharing one context.
+/**
+ * The given entity capacities are totals for the whole group; they are
+ * divided across the shards, rounding up.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set_group the group struct to be initialized
+ * \param[in] number_of_wait_sets non-zero number of shards to create
+ * \param[in] number_of_subscriptions total size of the subscriptions sets
+ * \param[in] number_of_guard_conditions total size of the guard conditions sets
+ * \param[in] number_of_timers total size of the timers sets
+ * \param[in] number_of_clients total size of the clients sets
+ * \param[in] number_of_services total size of the services sets
+ * \param[in] number_of_events total size of the events sets
+ * \param[in] context the context that the wait sets should be associated with
+ * \param[in] allocator the allocator to use when allocating space in the sets
+ * \return `RCL_RET_OK` if the group is initialized successfully, or
+ * \return `RCL_RET_ALREADY_INIT` if the group is not zero initialized, or
+ * \return `RCL_RET_NOT_INIT` if the given context is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_group_init(
+  rcl_wait_set_group_t * wait_set_group,
+  size_t number_of_wait_sets,
+  size_t number_of_subscriptions,
+  size_t number_of_guard_conditions,
+  size_t number_of_timers,
+  size_t number_of_clients,
+  size_t number_of_services,
+  size_t number_of_events,
+  rcl_context_t * context,
+  rcl_allocator_t allocator);
+
+/// Finalize a wait set group and all of its wait sets.
+/**
+ * \param[inout] wait_set_group the group struct to be finalized.
+ * \return `RCL_RET_OK` if the finalization was successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_group_fini(rcl_wait_set_group_t * wait_set_group);
+
+/// Return the wait set of the given shard, or `NULL` on invalid arguments.
+/**
+ * Each shard is intended to be owned by one executor thread; waiting on
+ * different shards from different threads is safe, waiting on the same shard
+ * from multiple threads is not.
+ *
+ * \param[in] wait_set_group the group holding the wait sets
+ * \param[in] index the shard to retrieve, less than `size_of_wait_sets`
+ * \return the shard's wait set if successful, otherwise `NULL`
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_wait_set_t *
+rcl_wait_set_group_get_wait_set(
+  const rcl_wait_set_group_t * wait_set_group,
+  size_t index);
+
+/// Return the next wait set in round-robin order, or `NULL` on invalid arguments.
+/**
+ * Use this when attaching entities to spread them evenly across the shards.
+ * The round-robin cursor is atomic, so concurrent attachment from multiple
+ * threads stays balanced.
+ *
+ * \param[in] wait_set_group the group holding the wait sets
+ * \return one of the group's wait sets if successful, otherwise `NULL`
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_wait_set_t *
+rcl_wait_set_group_next_wait_set(rcl_wait_set_group_t * wait_set_group);
+
 /// Block until the wait set is ready or until the timeout has been exceeded.
 /**
  * This function will collect the items in the rcl_wait_set_t and pass them
@@ -459,6 +1073,68 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout);
 
+/// Wait on several wait sets, possibly from different contexts, at once.
+/**
+ * One thread can block across wait sets whose entities live in different
+ * contexts, e.g. one wait set per domain in a bridge process, instead of
+ * dedicating a waiting thread to each context and handing work between
+ * threads.
+ *
+ * rmw can only block on one wait set at a time, so this function rotates:
+ * each round one wait set is waited on for up to `rotation_period`
+ * nanoseconds while the other sets are polled without blocking, and the
+ * blocking slot moves to the next set in the following round.
+ * An event on the currently blocked set wakes the call immediately; an
+ * event on any other set is observed by the poll that follows, so
+ * `rotation_period` bounds the added latency for entities outside the
+ * blocked set.
+ * A non-positive `rotation_period` selects the default of one millisecond.
+ *
+ * All wait sets have to be persistent, see rcl_wait_set_set_persistent().
+ * This function re-arms each set internally between rounds, which would
+ * discard the attachments of a non-persistent set.
+ * With a single wait set this call behaves exactly like rcl_wait() and the
+ * persistence requirement does not apply.
+ *
+ * When `RCL_RET_OK` is returned at least one entity across the sets is
+ * ready, and every wait set is left pruned exactly as by rcl_wait(),
+ * reflecting its last wait of the final round.
+ *
+ * The timeout follows the rcl_wait() convention: a negative timeout blocks
+ * indefinitely, zero polls every set exactly once, and a positive timeout
+ * is the overall bound in nanoseconds.
+ *
+ * This function is thread-safe for unique sets of wait sets with unique
+ * contents, with the same caveats as rcl_wait().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_sets the wait sets to be waited on, pruned if not ready
+ * \param[in] number_of_wait_sets non-zero length of the wait_sets array
+ * \param[in] timeout the overall duration to wait, in nanoseconds
+ * \param[in] rotation_period upper bound on one blocking wait, in nanoseconds
+ * \return `RCL_RET_OK` something in one of the wait sets became ready, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if a wait set is zero initialized, or
+ * \return `RCL_RET_WAIT_SET_EMPTY` if a wait set contains no items, or
+ * \return `RCL_RET_TIMEOUT` if the timeout expired before something was ready, or
+ * \return `RCL_RET_ERROR` an unspecified error occur.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_multiple(
+  rcl_wait_set_t ** wait_sets,
+  size_t number_of_wait_sets,
+  int64_t timeout,
+  int64_t rotation_period);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,173 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./arena.h"
+
+#include <string.h>
+
+/// \internal Header preceding every allocation handed out by an arena.
+/**
+ * Records the payload size so that reallocate can copy the old contents, and
+ * links overflow blocks into the arena's list so that rcl_arena_destroy()
+ * can release them.  For allocations served from the bump space the link is
+ * unused.
+ */
+typedef struct rcl_arena_overflow_header_t
+{
+  size_t size;
+  struct rcl_arena_overflow_header_t * next;
+} rcl_arena_overflow_header_t;
+
+// Implementation only
+static size_t
+_arena_align(size_t size)
+{
+  const size_t alignment = sizeof(rcl_arena_overflow_header_t);
+  return (size + alignment - 1) & ~(alignment - 1);
+}
+
+// Implementation only
+static void *
+_arena_allocate(size_t size, void * state)
+{
+  rcl_arena_t * arena = (rcl_arena_t *)state;
+  size_t total = _arena_align(sizeof(rcl_arena_overflow_header_t) + size);
+  rcl_arena_overflow_header_t * header;
+  if (arena->capacity - arena->used >= total) {
+    header = (rcl_arena_overflow_header_t *)(arena->buffer + arena->used);
+    arena->used += total;
+  } else {
+    // the bump space ran out; fall back to the backing allocator and track
+    // the block so that rcl_arena_destroy() still releases it
+    header = (rcl_arena_overflow_header_t *)arena->backing_allocator.allocate(
+      total, arena->backing_allocator.state);
+    if (NULL == header) {
+      return NULL;
+    }
+    header->next = arena->overflow;
+    arena->overflow = header;
+  }
+  header->size = size;
+  return (void *)(header + 1);
+}
+
+// Implementation only
+static void
+_arena_deallocate(void * pointer, void * state)
+{
+  // everything is released at once by rcl_arena_destroy()
+  (void)pointer;
+  (void)state;
+}
+
+// Implementation only
+static void *
+_arena_reallocate(void * pointer, size_t size, void * state)
+{
+  if (NULL == pointer) {
+    return _arena_allocate(size, state);
+  }
+  rcl_arena_overflow_header_t * header = ((rcl_arena_overflow_header_t *)pointer) - 1;
+  if (header->size >= size) {
+    return pointer;
+  }
+  void * grown = _arena_allocate(size, state);
+  if (NULL == grown) {
+    return NULL;
+  }
+  memcpy(grown, pointer, header->size);
+  // the old block stays in the arena until rcl_arena_destroy()
+  return grown;
+}
+
+// Implementation only
+static void *
+_arena_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  size_t size = number_of_elements * size_of_element;
+  void * pointer = _arena_allocate(size, state);
+  if (NULL != pointer) {
+    memset(pointer, 0, size);
+  }
+  return pointer;
+}
+
+rcl_arena_t *
+rcl_arena_create(size_t capacity, const rcl_allocator_t * backing_allocator)
+{
+  rcl_arena_t * arena = (rcl_arena_t *)backing_allocator->allocate(
+    sizeof(rcl_arena_t) + capacity, backing_allocator->state);
+  if (NULL == arena) {
+    return NULL;
+  }
+  arena->buffer = (uint8_t *)(arena + 1);
+  arena->capacity = capacity;
+  arena->used = 0;
+  arena->overflow = NULL;
+  arena->backing_allocator = *backing_allocator;
+  return arena;
+}
+
+rcl_allocator_t
+rcl_arena_get_allocator(rcl_arena_t * arena)
+{
+  rcl_allocator_t allocator = {
+    .allocate = _arena_allocate,
+    .deallocate = _arena_deallocate,
+    .reallocate = _arena_reallocate,
+    .zero_allocate = _arena_zero_allocate,
+    .state = arena,
+  };
+  return allocator;
+}
+
+size_t
+rcl_arena_bytes_in_use(const rcl_arena_t * arena)
+{
+  if (NULL == arena) {
+    return 0;
+  }
+  size_t bytes = sizeof(rcl_arena_t) + arena->capacity;
+  const rcl_arena_overflow_header_t * overflow = arena->overflow;
+  while (NULL != overflow) {
+    bytes += _arena_align(sizeof(rcl_arena_overflow_header_t) + overflow->size);
+    overflow = overflow->next;
+  }
+  return bytes;
+}
+
+void
+rcl_arena_destroy(rcl_arena_t * arena)
+{
+  if (NULL == arena) {
+    return;
+  }
+  rcl_allocator_t backing_allocator = arena->backing_allocator;
+  rcl_arena_overflow_header_t * overflow = arena->overflow;
+  while (NULL != overflow) {
+    rcl_arena_overflow_header_t * next = overflow->next;
+    backing_allocator.deallocate(overflow, backing_allocator.state);
+    overflow = next;
+  }
+  backing_allocator.deallocate(arena, backing_allocator.state);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,98 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__ARENA_H_
+#define RCL__ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcl/allocator.h"
+#include "rcl/visibility_control.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// \internal A bump allocator over one sized block, freed as a whole.
+/**
+ * Groups the many small allocations made during the initialization of a
+ * long-lived object (node impl struct, name strings, guard condition) into
+ * one block from the backing allocator, so that initialization costs one
+ * allocator round trip instead of dozens and the allocations end up adjacent
+ * in memory.  The arena lives at the head of its own block.
+ *
+ * Individual deallocation is a no-op; everything the arena handed out is
+ * released at once by rcl_arena_destroy().  Allocations that do not fit in
+ * the block fall back to the backing allocator and are tracked in a list so
+ * that rcl_arena_destroy() still releases everything.
+ */
+typedef struct rcl_arena_t
+{
+  /// Start of the bump space, directly after this struct.
+  uint8_t * buffer;
+  /// Size of the bump space in bytes.
+  size_t capacity;
+  /// Bytes of the bump space handed out so far.
+  size_t used;
+  /// Blocks allocated from the backing allocator after the space ran out.
+  struct rcl_arena_overflow_header_t * overflow;
+  /// The allocator the block was allocated with.
+  rcl_allocator_t backing_allocator;
+} rcl_arena_t;
+
+/// \internal Allocate an arena with the given bump space capacity.
+/**
+ * \param[in] capacity size of the bump space in bytes
+ * \param[in] backing_allocator allocator for the block and any overflow
+ * \return the new arena, or NULL if allocating memory failed.
+ */
+RCL_LOCAL
+RCL_WARN_UNUSED
+rcl_arena_t *
+rcl_arena_create(size_t capacity, const rcl_allocator_t * backing_allocator);
+
+/// \internal Get an rcl_allocator_t that allocates from the arena.
+/**
+ * The returned allocator's deallocate is a no-op and its state points into
+ * the arena, so it must not be used after rcl_arena_destroy().
+ */
+RCL_LOCAL
+RCL_WARN_UNUSED
+rcl_allocator_t
+rcl_arena_get_allocator(rcl_arena_t * arena);
+
+/// \internal Return the bytes the arena holds from the backing allocator.
+/**
+ * Counts the arena's own block (struct plus bump space, whether or not the
+ * space has been handed out yet) and every overflow block, headers included,
+ * so the result is what rcl_arena_destroy() would return to the backing
+ * allocator.
+ */
+RCL_LOCAL
+RCL_WARN_UNUSED
+size_t
+rcl_arena_bytes_in_use(const rcl_arena_t * arena);
+
+/// \internal Release the arena, its overflow blocks and everything in them.
+RCL_LOCAL
+void
+rcl_arena_destroy(rcl_arena_t * arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__ARENA_H_
@@ -16,6 +16,7 @@
 
 #include "rcl/arguments.h"
 
+#include <stdint.h>
 #include <string.h>
 
 #include "./arguments_impl.h"
@@ -72,6 +73,105 @@ _rcl_parse_param_file_rule(
   rcl_allocator_t allocator,
   char ** param_file);
 
+/// Alignment of blocks handed out by the parse arena.
+#define ARENA_BLOCK_ALIGNMENT sizeof(uint64_t)
+
+/// Per-argument arena slack covering transient lexer state and the scratch
+/// allocations of the severity level parser.
+#define ARENA_PER_ARG_SLACK 512
+
+static void *
+_rcl_arguments_arena_allocate(size_t size, void * state)
+{
+  rcl_arguments_arena_t * arena = state;
+  size_t aligned_used =
+    (arena->used + (ARENA_BLOCK_ALIGNMENT - 1)) & ~(ARENA_BLOCK_ALIGNMENT - 1);
+  if (aligned_used > arena->size || size > arena->size - aligned_used) {
+    return NULL;
+  }
+  void * block = arena->buffer + aligned_used;
+  arena->used = aligned_used + size;
+  return block;
+}
+
+static void
+_rcl_arguments_arena_deallocate(void * pointer, void * state)
+{
+  // Individual blocks are never reclaimed; the buffer is freed as a whole.
+  (void)pointer;
+  (void)state;
+}
+
+static void *
+_rcl_arguments_arena_reallocate(void * pointer, size_t size, void * state)
+{
+  if (NULL == pointer) {
+    return _rcl_arguments_arena_allocate(size, state);
+  }
+  void * block = _rcl_arguments_arena_allocate(size, state);
+  if (NULL != block) {
+    // The arena is monotonic, so pointer + size cannot pass the new block's
+    // end and the copy stays inside the buffer even when growing.
+    memmove(block, pointer, size);
+  }
+  return block;
+}
+
+static void *
+_rcl_arguments_arena_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  void * block = _rcl_arguments_arena_allocate(number_of_elements * size_of_element, state);
+  if (NULL != block) {
+    memset(block, 0, number_of_elements * size_of_element);
+  }
+  return block;
+}
+
+/// Return an rcl allocator that bump-allocates out of the arena.
+static rcl_allocator_t
+_rcl_arguments_arena_allocator(rcl_arguments_arena_t * arena)
+{
+  rcl_allocator_t allocator = {
+    .allocate = _rcl_arguments_arena_allocate,
+    .deallocate = _rcl_arguments_arena_deallocate,
+    .reallocate = _rcl_arguments_arena_reallocate,
+    .zero_allocate = _rcl_arguments_arena_zero_allocate,
+    .state = arena,
+  };
+  return allocator;
+}
+
+/// Allocate the arena buffer; size zero leaves the arena empty but usable.
+static rcl_ret_t
+_rcl_arguments_arena_init(
+  rcl_arguments_arena_t * arena, size_t size, rcl_allocator_t base_allocator)
+{
+  arena->buffer = NULL;
+  arena->size = 0;
+  arena->used = 0;
+  arena->base_allocator = base_allocator;
+  if (size > 0) {
+    arena->buffer = base_allocator.allocate(size, base_allocator.state);
+    if (NULL == arena->buffer) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    arena->size = size;
+  }
+  return RCL_RET_OK;
+}
+
+/// Free the arena buffer and everything ever allocated from it.
+static void
+_rcl_arguments_arena_fini(rcl_arguments_arena_t * arena)
+{
+  if (NULL != arena->buffer) {
+    arena->base_allocator.deallocate(arena->buffer, arena->base_allocator.state);
+    arena->buffer = NULL;
+  }
+  arena->size = 0;
+  arena->used = 0;
+}
+
 rcl_ret_t
 rcl_arguments_get_param_files(
   const rcl_arguments_t * arguments,
@@ -115,6 +215,18 @@ rcl_arguments_get_param_files_count(
   return args->impl->num_param_files_args;
 }
 
+rcl_ret_t
+rcl_arguments_get_param_files_view(
+  const rcl_arguments_t * arguments,
+  const char * const ** parameter_files)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(arguments, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(arguments->impl, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(parameter_files, RCL_RET_INVALID_ARGUMENT);
+  *(parameter_files) = (const char * const *)arguments->impl->parameter_files;
+  return RCL_RET_OK;
+}
+
 /// Parse an argument that may or may not be a log level rule.
 /**
  * \param[in] arg the argument to parse
@@ -213,6 +325,10 @@ rcl_parse_arguments(
   rcl_arguments_impl_t * args_impl = args_output->impl;
   args_impl->num_remap_rules = 0;
   args_impl->remap_rules = NULL;
+  args_impl->static_remap_indices = NULL;
+  args_impl->num_static_remap_indices = 0;
+  args_impl->dynamic_remap_indices = NULL;
+  args_impl->num_dynamic_remap_indices = 0;
   args_impl->log_level = -1;
   args_impl->external_log_config_file = NULL;
   args_impl->unparsed_args = NULL;
@@ -222,25 +338,47 @@ rcl_parse_arguments(
   args_impl->log_stdout_disabled = false;
   args_impl->log_rosout_disabled = false;
   args_impl->log_ext_lib_disabled = false;
+  args_impl->arena.buffer = NULL;
+  args_impl->arena.size = 0;
+  args_impl->arena.used = 0;
+  args_impl->arena.base_allocator = allocator;
   args_impl->allocator = allocator;
+  atomic_init(&args_impl->ref_count, 1);
 
   if (argc == 0) {
     // there are no arguments to parse
     return RCL_RET_OK;
   }
 
+  // Size the arena with a counting pre-pass: every argument could become a
+  // remap rule holding a handful of strings no longer than the argument
+  // itself, on top of the over-allocated arrays below.  Parsing then never
+  // touches the allocator again and fini frees the arena in one call.
+  size_t arena_size =
+    (size_t)argc * (sizeof(rcl_remap_t) + sizeof(int) + sizeof(char *));
+  for (int i = 0; i < argc; ++i) {
+    arena_size += sizeof(rcl_remap_impl_t) + 6 * (strlen(argv[i]) + 1) + ARENA_PER_ARG_SLACK;
+  }
+  ret = _rcl_arguments_arena_init(&args_impl->arena, arena_size, allocator);
+  if (RCL_RET_OK != ret) {
+    goto fail;
+  }
+  rcl_allocator_t arena_allocator = _rcl_arguments_arena_allocator(&args_impl->arena);
+
   // over-allocate arrays to match the number of arguments
-  args_impl->remap_rules = allocator.allocate(sizeof(rcl_remap_t) * argc, allocator.state);
+  args_impl->remap_rules =
+    arena_allocator.allocate(sizeof(rcl_remap_t) * argc, arena_allocator.state);
   if (NULL == args_impl->remap_rules) {
     ret = RCL_RET_BAD_ALLOC;
     goto fail;
   }
-  args_impl->unparsed_args = allocator.allocate(sizeof(int) * argc, allocator.state);
+  args_impl->unparsed_args = arena_allocator.allocate(sizeof(int) * argc, arena_allocator.state);
   if (NULL == args_impl->unparsed_args) {
     ret = RCL_RET_BAD_ALLOC;
     goto fail;
   }
-  args_impl->parameter_files = allocator.allocate(sizeof(char *) * argc, allocator.state);
+  args_impl->parameter_files =
+    arena_allocator.allocate(sizeof(char *) * argc, arena_allocator.state);
   if (NULL == args_impl->parameter_files) {
     ret = RCL_RET_BAD_ALLOC;
     goto fail;
@@ -251,7 +389,7 @@ rcl_parse_arguments(
     args_impl->parameter_files[args_impl->num_param_files_args] = NULL;
     if (
       RCL_RET_OK == _rcl_parse_param_file_rule(
-        argv[i], allocator, &(args_impl->parameter_files[args_impl->num_param_files_args])))
+        argv[i], arena_allocator, &(args_impl->parameter_files[args_impl->num_param_files_args])))
     {
       ++(args_impl->num_param_files_args);
       RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME,
@@ -268,7 +406,7 @@ rcl_parse_arguments(
     // Attempt to parse argument as remap rule
     rcl_remap_t * rule = &(args_impl->remap_rules[args_impl->num_remap_rules]);
     *rule = rcl_get_zero_initialized_remap();
-    if (RCL_RET_OK == _rcl_parse_remap_rule(argv[i], allocator, rule)) {
+    if (RCL_RET_OK == _rcl_parse_remap_rule(argv[i], arena_allocator, rule)) {
       ++(args_impl->num_remap_rules);
       continue;
     }
@@ -279,7 +417,7 @@ rcl_parse_arguments(
 
     // Attempt to parse argument as log level configuration
     int log_level;
-    if (RCL_RET_OK == _rcl_parse_log_level_rule(argv[i], allocator, &log_level)) {
+    if (RCL_RET_OK == _rcl_parse_log_level_rule(argv[i], arena_allocator, &log_level)) {
       args_impl->log_level = log_level;
       continue;
     }
@@ -290,7 +428,7 @@ rcl_parse_arguments(
 
     // Attempt to parse argument as log configuration file
     rcl_ret_t ret = _rcl_parse_external_log_config_file(
-      argv[i], allocator, &args_impl->external_log_config_file);
+      argv[i], arena_allocator, &args_impl->external_log_config_file);
     if (RCL_RET_OK == ret) {
       continue;
     }
@@ -338,43 +476,21 @@ rcl_parse_arguments(
     ++(args_impl->num_unparsed_args);
   }
 
-  // Shrink remap_rules array to match number of successfully parsed rules
-  if (args_impl->num_remap_rules > 0) {
-    args_impl->remap_rules = rcutils_reallocf(
-      args_impl->remap_rules, sizeof(rcl_remap_t) * args_impl->num_remap_rules, &allocator);
-    if (NULL == args_impl->remap_rules) {
-      ret = RCL_RET_BAD_ALLOC;
-      goto fail;
-    }
-  } else {
-    // No remap rules
-    allocator.deallocate(args_impl->remap_rules, allocator.state);
+  // The arrays live in the arena, so there is nothing to gain by shrinking
+  // them to the parsed counts; just drop the empty ones.
+  if (0 == args_impl->num_remap_rules) {
     args_impl->remap_rules = NULL;
   }
-  // Shrink Parameter files
+  // Compile the remap rules into the lookup index probed at remap time
+  ret = rcl_remap_build_index(args_impl);
+  if (RCL_RET_OK != ret) {
+    goto fail;
+  }
   if (0 == args_impl->num_param_files_args) {
-    allocator.deallocate(args_impl->parameter_files, allocator.state);
     args_impl->parameter_files = NULL;
-  } else if (args_impl->num_param_files_args < argc) {
-    args_impl->parameter_files = rcutils_reallocf(
-      args_impl->parameter_files, sizeof(char *) * args_impl->num_param_files_args, &allocator);
-    if (NULL == args_impl->parameter_files) {
-      ret = RCL_RET_BAD_ALLOC;
-      goto fail;
-    }
   }
-  // Shrink unparsed_args
   if (0 == args_impl->num_unparsed_args) {
-    // No unparsed args
-    allocator.deallocate(args_impl->unparsed_args, allocator.state);
     args_impl->unparsed_args = NULL;
-  } else if (args_impl->num_unparsed_args < argc) {
-    args_impl->unparsed_args = rcutils_reallocf(
-      args_impl->unparsed_args, sizeof(int) * args_impl->num_unparsed_args, &allocator);
-    if (NULL == args_impl->unparsed_args) {
-      ret = RCL_RET_BAD_ALLOC;
-      goto fail;
-    }
   }
 
   return RCL_RET_OK;
@@ -424,6 +540,18 @@ rcl_arguments_get_unparsed(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_arguments_get_unparsed_view(
+  const rcl_arguments_t * args,
+  const int ** unparsed_indices)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(args, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(args->impl, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(unparsed_indices, RCL_RET_INVALID_ARGUMENT);
+  *unparsed_indices = args->impl->unparsed_args;
+  return RCL_RET_OK;
+}
+
 rcl_arguments_t
 rcl_get_zero_initialized_arguments(void)
 {
@@ -453,9 +581,9 @@ rcl_remove_ros_arguments(
     return RCL_RET_INVALID_ARGUMENT;
   }
 
-  int * unparsed_indices = NULL;
+  const int * unparsed_indices = NULL;
   rcl_ret_t ret;
-  ret = rcl_arguments_get_unparsed(args, allocator, &unparsed_indices);
+  ret = rcl_arguments_get_unparsed_view(args, &unparsed_indices);
 
   if (RCL_RET_OK != ret) {
     return ret;
@@ -464,14 +592,12 @@ rcl_remove_ros_arguments(
   size_t alloc_size = sizeof(char *) * *nonros_argc;
   *nonros_argv = allocator.allocate(alloc_size, allocator.state);
   if (NULL == *nonros_argv) {
-    allocator.deallocate(unparsed_indices, allocator.state);
     return RCL_RET_BAD_ALLOC;
   }
   for (int i = 0; i < *nonros_argc; ++i) {
     (*nonros_argv)[i] = argv[unparsed_indices[i]];
   }
 
-  allocator.deallocate(unparsed_indices, allocator.state);
   return RCL_RET_OK;
 }
 
@@ -488,85 +614,12 @@ rcl_arguments_copy(
     return RCL_RET_INVALID_ARGUMENT;
   }
 
-  rcl_allocator_t allocator = args->impl->allocator;
-
-  args_out->impl = allocator.allocate(sizeof(rcl_arguments_impl_t), allocator.state);
-  if (NULL == args_out->impl) {
-    return RCL_RET_BAD_ALLOC;
-  }
-
-  args_out->impl->allocator = allocator;
-
-  // Zero so it's safe to call rcl_arguments_fini() if an error occurrs while copying.
-  args_out->impl->num_remap_rules = 0;
-  args_out->impl->remap_rules = NULL;
-  args_out->impl->unparsed_args = NULL;
-  args_out->impl->num_unparsed_args = 0;
-  args_out->impl->parameter_files = NULL;
-  args_out->impl->num_param_files_args = 0;
-
-  if (args->impl->num_unparsed_args) {
-    // Copy unparsed args
-    args_out->impl->unparsed_args = allocator.allocate(
-      sizeof(int) * args->impl->num_unparsed_args, allocator.state);
-    if (NULL == args_out->impl->unparsed_args) {
-      if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-        RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-      }
-      return RCL_RET_BAD_ALLOC;
-    }
-    for (int i = 0; i < args->impl->num_unparsed_args; ++i) {
-      args_out->impl->unparsed_args[i] = args->impl->unparsed_args[i];
-    }
-    args_out->impl->num_unparsed_args = args->impl->num_unparsed_args;
-  }
-
-  if (args->impl->num_remap_rules) {
-    // Copy remap rules
-    args_out->impl->remap_rules = allocator.allocate(
-      sizeof(rcl_remap_t) * args->impl->num_remap_rules, allocator.state);
-    if (NULL == args_out->impl->remap_rules) {
-      if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-        RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-      }
-      return RCL_RET_BAD_ALLOC;
-    }
-    args_out->impl->num_remap_rules = args->impl->num_remap_rules;
-    for (int i = 0; i < args->impl->num_remap_rules; ++i) {
-      args_out->impl->remap_rules[i] = rcl_get_zero_initialized_remap();
-      rcl_ret_t ret = rcl_remap_copy(
-        &(args->impl->remap_rules[i]), &(args_out->impl->remap_rules[i]));
-      if (RCL_RET_OK != ret) {
-        if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-          RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-        }
-        return ret;
-      }
-    }
-  }
-
-  // Copy parameter files
-  if (args->impl->num_param_files_args) {
-    args_out->impl->parameter_files = allocator.allocate(
-      sizeof(char *) * args->impl->num_param_files_args, allocator.state);
-    if (NULL == args_out->impl->parameter_files) {
-      if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-        RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-      }
-      return RCL_RET_BAD_ALLOC;
-    }
-    args_out->impl->num_param_files_args = args->impl->num_param_files_args;
-    for (int i = 0; i < args->impl->num_param_files_args; ++i) {
-      args_out->impl->parameter_files[i] =
-        rcutils_strdup(args->impl->parameter_files[i], allocator);
-      if (NULL == args_out->impl->parameter_files[i]) {
-        if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-          RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-        }
-        return RCL_RET_BAD_ALLOC;
-      }
-    }
-  }
+  // A parsed rcl_arguments_t is immutable, so copies share the compiled rule
+  // set by reference instead of duplicating the remap and parameter rules
+  // per holder; composed processes hand the same global arguments to every
+  // node.  The last holder to be finalized frees the impl.
+  rcutils_atomic_fetch_add_uint64_t(&args->impl->ref_count, 1);
+  args_out->impl = args->impl;
   return RCL_RET_OK;
 }
 
@@ -577,6 +630,12 @@ rcl_arguments_fini(
   RCL_CHECK_ARGUMENT_FOR_NULL(args, RCL_RET_INVALID_ARGUMENT);
   if (args->impl) {
     rcl_ret_t ret = RCL_RET_OK;
+    // Drop this holder's reference; only the last one tears the impl down.
+    if (rcutils_atomic_fetch_add_uint64_t(&args->impl->ref_count, -1) > 1) {
+      args->impl = NULL;
+      return RCL_RET_OK;
+    }
+    rcl_remap_free_index(args->impl);
     if (args->impl->remap_rules) {
       for (int i = 0; i < args->impl->num_remap_rules; ++i) {
         rcl_ret_t remap_ret = rcl_remap_fini(&(args->impl->remap_rules[i]));
@@ -587,25 +646,17 @@ rcl_arguments_fini(
             "Failed to finalize remap rule while finalizing arguments. Continuing...");
         }
       }
-      args->impl->allocator.deallocate(args->impl->remap_rules, args->impl->allocator.state);
       args->impl->remap_rules = NULL;
       args->impl->num_remap_rules = 0;
     }
 
-    args->impl->allocator.deallocate(args->impl->unparsed_args, args->impl->allocator.state);
     args->impl->num_unparsed_args = 0;
     args->impl->unparsed_args = NULL;
+    args->impl->num_param_files_args = 0;
+    args->impl->parameter_files = NULL;
 
-    if (args->impl->parameter_files) {
-      for (int p = 0; p < args->impl->num_param_files_args; ++p) {
-        args->impl->allocator.deallocate(
-          args->impl->parameter_files[p], args->impl->allocator.state);
-      }
-      args->impl->allocator.deallocate(args->impl->parameter_files, args->impl->allocator.state);
-      args->impl->num_param_files_args = 0;
-      args->impl->parameter_files = NULL;
-    }
-
+    // The arrays, rules and strings above all live in the arena.
+    _rcl_arguments_arena_fini(&args->impl->arena);
     args->impl->allocator.deallocate(args->impl, args->impl->allocator.state);
     args->impl = NULL;
     return ret;
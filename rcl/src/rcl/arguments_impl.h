@@ -16,6 +16,7 @@
 #define RCL__ARGUMENTS_IMPL_H_
 
 #include "rcl/arguments.h"
+#include "rcutils/stdatomic_helper.h"
 #include "./remap_impl.h"
 
 #ifdef __cplusplus
@@ -23,6 +24,25 @@ extern "C"
 {
 #endif
 
+/// \internal Bump arena holding every parse-time allocation of one
+/// rcl_arguments_t: rule arrays, rule impls and their strings.
+/**
+ * The arena is sized with a counting pre-pass over argv before parsing
+ * starts, so parsing performs no further heap allocations and finalizing
+ * the arguments is a single free of the buffer.
+ */
+typedef struct rcl_arguments_arena_t
+{
+  /// Arena storage; `NULL` if no arguments were parsed.
+  char * buffer;
+  /// Total capacity of buffer in bytes.
+  size_t size;
+  /// Bytes handed out so far; the arena never reclaims individual blocks.
+  size_t used;
+  /// Allocator the buffer itself was allocated with.
+  rcl_allocator_t base_allocator;
+} rcl_arguments_arena_t;
+
 /// \internal
 typedef struct rcl_arguments_impl_t
 {
@@ -42,6 +62,17 @@ typedef struct rcl_arguments_impl_t
   /// Length of remap_rules.
   int num_remap_rules;
 
+  /// Indices into remap_rules of topic and service rules whose match side is
+  /// a literal fully qualified name, sorted by match string so lookups can
+  /// binary search instead of walking every rule.
+  int * static_remap_indices;
+  /// Length of static_remap_indices.
+  int num_static_remap_indices;
+  /// Indices into remap_rules of the remaining rules, in original rule order.
+  int * dynamic_remap_indices;
+  /// Length of dynamic_remap_indices.
+  int num_dynamic_remap_indices;
+
   /// Default log level (represented by `RCUTILS_LOG_SEVERITY` enum) or -1 if not specified.
   int log_level;
   /// A file used to configure the external logging library
@@ -53,7 +84,18 @@ typedef struct rcl_arguments_impl_t
   /// A boolean value indicating if the external lib handler should be used for log output
   bool log_ext_lib_disabled;
 
-  /// Allocator used to allocate objects in this struct
+  /// Number of rcl_arguments_t holders sharing this impl.
+  /**
+   * Parsed arguments are immutable, so rcl_arguments_copy() shares the
+   * compiled rule set by reference and the last rcl_arguments_fini() frees
+   * it.  Incremented and decremented atomically so nodes can be created in
+   * parallel from the same global arguments.
+   */
+  atomic_uint_least64_t ref_count;
+
+  /// Arena backing all of the arrays, rules and strings above.
+  rcl_arguments_arena_t arena;
+  /// Allocator used to allocate the impl and the arena buffer.
   rcl_allocator_t allocator;
 } rcl_arguments_impl_t;
 
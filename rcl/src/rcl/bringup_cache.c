@@ -0,0 +1,252 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./bringup_cache.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "rcutils/format_string.h"
+#include "rcutils/get_env.h"
+#include "rcutils/logging_macros.h"
+#include "rcutils/strdup.h"
+
+#include "./context_impl.h"
+
+// Keys and values are stored one pair per line, tab separated; neither may
+// contain a tab or newline.  The schemes used by the callers ('t:', 's:'
+// and 'secroot:' keys over names and paths) guarantee that.
+#define RCL_BRINGUP_CACHE_MAGIC "rcl-bringup-cache"
+#define RCL_BRINGUP_CACHE_LINE_MAX 4096
+
+// FNV-1a over the command line, so each distinct invocation gets its own
+// cache file and a changed command line never serves stale state.
+static uint64_t
+__bringup_cache_hash_args(int64_t argc, const char * const * argv)
+{
+  uint64_t hash = 0xcbf29ce484222325ull;
+  int64_t i = 0;
+  for (i = 0; i < argc; ++i) {
+    const char * arg = argv[i];
+    for (; '\0' != *arg; ++arg) {
+      hash = (hash ^ (uint64_t)(unsigned char)*arg) * 0x100000001b3ull;
+    }
+    // separate the arguments so "a b" and "ab" hash differently
+    hash = (hash ^ 0x1full) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
+// Append one owned pair to the cache, growing the entry array as needed.
+static bool
+__bringup_cache_append(rcl_bringup_cache_t * cache, char * key, char * value)
+{
+  if (cache->num_entries == cache->capacity) {
+    size_t new_capacity = (0 == cache->capacity) ? 16 : 2 * cache->capacity;
+    rcl_bringup_cache_entry_t * grown =
+      (rcl_bringup_cache_entry_t *)cache->allocator.reallocate(
+      cache->entries, new_capacity * sizeof(rcl_bringup_cache_entry_t),
+      cache->allocator.state);
+    if (NULL == grown) {
+      return false;
+    }
+    cache->entries = grown;
+    cache->capacity = new_capacity;
+  }
+  cache->entries[cache->num_entries].key = key;
+  cache->entries[cache->num_entries].value = value;
+  ++cache->num_entries;
+  return true;
+}
+
+// Read the backing file into the cache; false discards the file's content,
+// e.g. on a version bump or a command line hash collision check failure.
+static bool
+__bringup_cache_read_file(rcl_bringup_cache_t * cache, uint64_t hash)
+{
+  FILE * file = fopen(cache->path, "r");
+  if (NULL == file) {
+    return true;  // no cache yet; start empty
+  }
+  char line[RCL_BRINGUP_CACHE_LINE_MAX];
+  bool ok = false;
+  if (NULL != fgets(line, sizeof(line), file)) {
+    unsigned int version = 0;
+    uint64_t stored_hash = 0;
+    if (2 == sscanf(
+        line, RCL_BRINGUP_CACHE_MAGIC " %u %" SCNx64, &version, &stored_hash) &&
+      RCL_BRINGUP_CACHE_VERSION == version && hash == stored_hash)
+    {
+      ok = true;
+    }
+  }
+  while (ok && NULL != fgets(line, sizeof(line), file)) {
+    char * separator = strchr(line, '\t');
+    char * newline = strrchr(line, '\n');
+    if (NULL == separator || NULL == newline) {
+      ok = false;  // truncated or damaged line, drop everything
+      break;
+    }
+    *separator = '\0';
+    *newline = '\0';
+    char * key = rcutils_strdup(line, cache->allocator);
+    char * value = rcutils_strdup(separator + 1, cache->allocator);
+    if (NULL == key || NULL == value || !__bringup_cache_append(cache, key, value)) {
+      cache->allocator.deallocate(key, cache->allocator.state);
+      cache->allocator.deallocate(value, cache->allocator.state);
+      ok = false;
+      break;
+    }
+  }
+  fclose(file);
+  return ok;
+}
+
+// Free the entry storage, leaving path and bookkeeping alone.
+static void
+__bringup_cache_clear_entries(rcl_bringup_cache_t * cache)
+{
+  size_t i = 0;
+  for (i = 0; i < cache->num_entries; ++i) {
+    cache->allocator.deallocate(cache->entries[i].key, cache->allocator.state);
+    cache->allocator.deallocate(cache->entries[i].value, cache->allocator.state);
+  }
+  cache->allocator.deallocate(cache->entries, cache->allocator.state);
+  cache->entries = NULL;
+  cache->num_entries = 0;
+  cache->capacity = 0;
+}
+
+void
+rcl_bringup_cache_load(
+  rcl_context_t * context,
+  int64_t argc,
+  const char * const * argv)
+{
+  if (NULL == context || NULL == context->impl) {
+    return;
+  }
+  const char * cache_dir = NULL;
+  if (NULL != rcutils_get_env(RCL_BRINGUP_CACHE_DIR_ENV_VAR, &cache_dir)) {
+    return;
+  }
+  if (NULL == cache_dir || '\0' == cache_dir[0]) {
+    return;  // cache not enabled
+  }
+  rcl_allocator_t * allocator = &context->impl->allocator;
+  rcl_bringup_cache_t * cache = (rcl_bringup_cache_t *)allocator->zero_allocate(
+    1, sizeof(rcl_bringup_cache_t), allocator->state);
+  if (NULL == cache) {
+    return;  // bringup goes on without the cache
+  }
+  cache->allocator = *allocator;
+  uint64_t hash = __bringup_cache_hash_args(argc, argv);
+  cache->path = rcutils_format_string(
+    *allocator, "%s/rcl_bringup_%016" PRIx64 ".cache", cache_dir, hash);
+  if (NULL == cache->path) {
+    allocator->deallocate(cache, allocator->state);
+    return;
+  }
+  if (!__bringup_cache_read_file(cache, hash)) {
+    RCUTILS_LOG_DEBUG_NAMED(
+      ROS_PACKAGE_NAME, "Discarding stale or damaged bringup cache '%s'", cache->path);
+    __bringup_cache_clear_entries(cache);
+    cache->dirty = true;  // rewrite the file even if nothing new gets added
+  }
+  context->impl->bringup_cache = cache;
+}
+
+const char *
+rcl_bringup_cache_lookup(rcl_context_t * context, const char * key)
+{
+  if (NULL == context || NULL == context->impl || NULL == context->impl->bringup_cache ||
+    NULL == key)
+  {
+    return NULL;
+  }
+  rcl_bringup_cache_t * cache = context->impl->bringup_cache;
+  size_t i = 0;
+  for (i = 0; i < cache->num_entries; ++i) {
+    if (0 == strcmp(cache->entries[i].key, key)) {
+      return cache->entries[i].value;
+    }
+  }
+  return NULL;
+}
+
+void
+rcl_bringup_cache_store(rcl_context_t * context, const char * key, const char * value)
+{
+  if (NULL == context || NULL == context->impl || NULL == context->impl->bringup_cache ||
+    NULL == key || NULL == value)
+  {
+    return;
+  }
+  rcl_bringup_cache_t * cache = context->impl->bringup_cache;
+  if (NULL != rcl_bringup_cache_lookup(context, key)) {
+    return;  // first writer wins; bringup derivations are deterministic
+  }
+  char * key_copy = rcutils_strdup(key, cache->allocator);
+  char * value_copy = rcutils_strdup(value, cache->allocator);
+  if (NULL == key_copy || NULL == value_copy ||
+    !__bringup_cache_append(cache, key_copy, value_copy))
+  {
+    cache->allocator.deallocate(key_copy, cache->allocator.state);
+    cache->allocator.deallocate(value_copy, cache->allocator.state);
+    return;
+  }
+  cache->dirty = true;
+}
+
+void
+rcl_bringup_cache_fini(rcl_context_t * context)
+{
+  if (NULL == context || NULL == context->impl || NULL == context->impl->bringup_cache) {
+    return;
+  }
+  rcl_bringup_cache_t * cache = context->impl->bringup_cache;
+  if (cache->dirty) {
+    FILE * file = fopen(cache->path, "w");
+    if (NULL != file) {
+      uint64_t hash = 0;
+      // recover the hash from the file name rather than keeping argv around
+      const char * name = strrchr(cache->path, '_');
+      if (NULL == name || 1 != sscanf(name + 1, "%16" SCNx64, &hash)) {
+        hash = 0;
+      }
+      fprintf(
+        file, RCL_BRINGUP_CACHE_MAGIC " %u %016" PRIx64 "\n",
+        (unsigned int)RCL_BRINGUP_CACHE_VERSION, hash);
+      size_t i = 0;
+      for (i = 0; i < cache->num_entries; ++i) {
+        fprintf(file, "%s\t%s\n", cache->entries[i].key, cache->entries[i].value);
+      }
+      fclose(file);
+    }
+  }
+  __bringup_cache_clear_entries(cache);
+  cache->allocator.deallocate(cache->path, cache->allocator.state);
+  cache->allocator.deallocate(cache, cache->allocator.state);
+  context->impl->bringup_cache = NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
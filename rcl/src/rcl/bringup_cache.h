@@ -0,0 +1,110 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__BRINGUP_CACHE_H_
+#define RCL__BRINGUP_CACHE_H_
+
+#include "rcl/context.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Environment variable naming the directory the cache files live in.
+/**
+ * The cache is disabled while the variable is unset or empty.
+ */
+#define RCL_BRINGUP_CACHE_DIR_ENV_VAR "RCL_BRINGUP_CACHE_DIR"
+
+/// On-disk format version, bumped whenever the layout or key scheme changes.
+#define RCL_BRINGUP_CACHE_VERSION 1
+
+/// \internal One cached key/value pair.
+typedef struct rcl_bringup_cache_entry_t
+{
+  char * key;
+  char * value;
+} rcl_bringup_cache_entry_t;
+
+/// \internal Persistent cache of derived bringup state.
+/**
+ * Snapshot of string-valued state that is expensive to derive during
+ * bringup — resolved entity names after expand and remap, validated
+ * security root paths — keyed by the process command line, so an identical
+ * restart is served from disk instead of recomputing identical results.
+ *
+ * The cache file lives in RCL_BRINGUP_CACHE_DIR_ENV_VAR and is named after
+ * a hash of the command line; a version or hash mismatch discards the file
+ * and the cache is rebuilt.  New entries are appended in memory and the
+ * file is rewritten during context cleanup when anything changed.
+ *
+ * Like the rest of init-time state the cache is written and read from the
+ * thread driving init and fini; lookups from entity init calls follow the
+ * same single-threaded expectation as node initialization.
+ */
+typedef struct rcl_bringup_cache_t
+{
+  rcl_bringup_cache_entry_t * entries;
+  size_t num_entries;
+  size_t capacity;
+  /// Full path of the backing file.
+  char * path;
+  /// True once an entry was added since load; triggers the rewrite.
+  bool dirty;
+  rcl_allocator_t allocator;
+} rcl_bringup_cache_t;
+
+/// \internal Load the cache for this command line, creating an empty one.
+/**
+ * A no-op leaving the context without a cache when the environment
+ * variable is unset; never fails bringup, a damaged or mismatching file is
+ * discarded and rebuilt.
+ */
+RCL_LOCAL
+void
+rcl_bringup_cache_load(
+  rcl_context_t * context,
+  int64_t argc,
+  const char * const * argv);
+
+/// \internal Look up a cached value; NULL on miss or while disabled.
+/**
+ * The returned string is owned by the cache and valid until the context is
+ * cleaned up.
+ */
+RCL_LOCAL
+const char *
+rcl_bringup_cache_lookup(rcl_context_t * context, const char * key);
+
+/// \internal Record a derived value; a no-op while the cache is disabled.
+/**
+ * Failures are swallowed: the value is simply not cached.
+ */
+RCL_LOCAL
+void
+rcl_bringup_cache_store(rcl_context_t * context, const char * key, const char * value);
+
+/// \internal Flush the cache to disk if dirty and release it.
+RCL_LOCAL
+void
+rcl_bringup_cache_fini(rcl_context_t * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__BRINGUP_CACHE_H_
@@ -23,21 +23,44 @@ extern "C"
 #include <string.h>
 
 #include "rcl/error_handling.h"
-#include "rcl/expand_topic_name.h"
-#include "rcl/remap.h"
+#include "rcl/tracepoint.h"
 #include "rcutils/logging_macros.h"
 #include "rcutils/stdatomic_helper.h"
+#include "rcutils/time.h"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
 #include "rmw/validate_full_topic_name.h"
 
 #include "./common.h"
+#include "./node_impl.h"
+
+/// \internal One slot of the pending request table.
+/**
+ * A slot is claimed by moving `state` from FREE to CLAIMED with a compare
+ * and swap, filled in, and then published by storing IN_FLIGHT, so sending
+ * threads never take a lock and the draining thread never sees a torn slot.
+ */
+typedef struct rcl_client_pending_request_t
+{
+  // slot state; see the PENDING_SLOT defines below
+  atomic_int_least64_t state;
+  int64_t sequence_number;
+  const void * user_cookie;
+  // steady clock deadline in nanoseconds, 0 for no deadline
+  rcutils_time_point_value_t deadline;
+} rcl_client_pending_request_t;
+
+#define PENDING_SLOT_FREE (0)
+#define PENDING_SLOT_CLAIMED (1)
+#define PENDING_SLOT_IN_FLIGHT (2)
 
 typedef struct rcl_client_impl_t
 {
   rcl_client_options_t options;
   rmw_client_t * rmw_handle;
   atomic_int_least64_t sequence_number;
+  // pending request table for pipelined sends, NULL when not enabled
+  rcl_client_pending_request_t * pending_requests;
 } rcl_client_impl_t;
 
 rcl_client_t
@@ -73,75 +96,20 @@ rcl_client_init(
     RCL_SET_ERROR_MSG("client already initialized, or memory was unintialized");
     return RCL_RET_ALREADY_INIT;
   }
-  // Expand the given service name.
-  rcutils_allocator_t rcutils_allocator = *allocator;  // implicit conversion to rcutils version
-  rcutils_string_map_t substitutions_map = rcutils_get_zero_initialized_string_map();
-  rcutils_ret_t rcutils_ret = rcutils_string_map_init(&substitutions_map, 0, rcutils_allocator);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    if (rcutils_ret == RCUTILS_RET_BAD_ALLOC) {
-      return RCL_RET_BAD_ALLOC;
-    }
-    return RCL_RET_ERROR;
-  }
-  rcl_ret_t ret = rcl_get_default_topic_name_substitutions(&substitutions_map);
-  if (ret != RCL_RET_OK) {
-    rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-    if (rcutils_ret != RCUTILS_RET_OK) {
-      RCUTILS_LOG_ERROR_NAMED(
-        ROS_PACKAGE_NAME,
-        "failed to fini string_map (%d) during error handling: %s\n",
-        rcutils_ret,
-        rcutils_get_error_string().str);
-    }
-    if (ret == RCL_RET_BAD_ALLOC) {
-      return ret;
-    }
-    return RCL_RET_ERROR;
-  }
-  char * expanded_service_name = NULL;
+  // Expand and remap the given service name.
   char * remapped_service_name = NULL;
-  ret = rcl_expand_topic_name(
-    service_name,
-    rcl_node_get_name(node),
-    rcl_node_get_namespace(node),
-    &substitutions_map,
-    *allocator,
-    &expanded_service_name);
-  rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    allocator->deallocate(expanded_service_name, allocator->state);
-    return RCL_RET_ERROR;
-  }
-  if (ret != RCL_RET_OK) {
-    if (ret == RCL_RET_TOPIC_NAME_INVALID || ret == RCL_RET_UNKNOWN_SUBSTITUTION) {
+  rcl_ret_t ret = rcl_node_resolve_name(
+    node, service_name, *allocator, true, &remapped_service_name);
+  if (RCL_RET_OK != ret) {
+    if (RCL_RET_TOPIC_NAME_INVALID == ret || RCL_RET_UNKNOWN_SUBSTITUTION == ret) {
       ret = RCL_RET_SERVICE_NAME_INVALID;
-    } else {
+    } else if (RCL_RET_BAD_ALLOC != ret) {
       ret = RCL_RET_ERROR;
     }
     goto cleanup;
   }
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Expanded service name '%s'", expanded_service_name);
-
-  const rcl_node_options_t * node_options = rcl_node_get_options(node);
-  if (NULL == node_options) {
-    ret = RCL_RET_ERROR;
-    goto cleanup;
-  }
-  rcl_arguments_t * global_args = NULL;
-  if (node_options->use_global_arguments) {
-    global_args = &(node->context->global_arguments);
-  }
-  ret = rcl_remap_service_name(
-    &(node_options->arguments), global_args, expanded_service_name,
-    rcl_node_get_name(node), rcl_node_get_namespace(node), *allocator, &remapped_service_name);
-  if (RCL_RET_OK != ret) {
-    goto fail;
-  } else if (NULL == remapped_service_name) {
-    remapped_service_name = expanded_service_name;
-    expanded_service_name = NULL;
-  }
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Expanded and remapped service name '%s'", remapped_service_name);
 
   // Validate the expanded service name.
   int validation_result;
@@ -176,6 +144,30 @@ rcl_client_init(
   // options
   client->impl->options = *options;
   atomic_init(&client->impl->sequence_number, 0);
+  // pending request table, only when pipelining was asked for
+  client->impl->pending_requests = NULL;
+  if (options->max_pending_requests > 0) {
+    client->impl->pending_requests = (rcl_client_pending_request_t *)allocator->zero_allocate(
+      options->max_pending_requests, sizeof(rcl_client_pending_request_t), allocator->state);
+    if (NULL == client->impl->pending_requests) {
+      RCL_SET_ERROR_MSG("allocating memory for the pending request table failed");
+      rmw_ret = rmw_destroy_client(rcl_node_get_rmw_handle(node), client->impl->rmw_handle);
+      if (RMW_RET_OK != rmw_ret) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME,
+          "failed to destroy rmw client while handling a failed init: %s",
+          rmw_get_error_string().str);
+        rmw_reset_error();
+      }
+      fail_ret = RCL_RET_BAD_ALLOC;
+      goto fail;
+    }
+    size_t i;
+    for (i = 0; i < options->max_pending_requests; ++i) {
+      atomic_init(&client->impl->pending_requests[i].state, PENDING_SLOT_FREE);
+    }
+  }
+  ++(node->impl->num_clients);
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Client initialized");
   ret = RCL_RET_OK;
   goto cleanup;
@@ -186,9 +178,6 @@ fail:
   ret = fail_ret;
   // Fall through to cleanup
 cleanup:
-  if (NULL != expanded_service_name) {
-    allocator->deallocate(expanded_service_name, allocator->state);
-  }
   if (NULL != remapped_service_name) {
     allocator->deallocate(remapped_service_name, allocator->state);
   }
@@ -215,7 +204,13 @@ rcl_client_fini(rcl_client_t * client, rcl_node_t * node)
       RCL_SET_ERROR_MSG(rmw_get_error_string().str);
       result = RCL_RET_ERROR;
     }
+    if (NULL != client->impl->pending_requests) {
+      allocator.deallocate(client->impl->pending_requests, allocator.state);
+    }
     allocator.deallocate(client->impl, allocator.state);
+    if (node->impl->num_clients > 0) {
+      --(node->impl->num_clients);
+    }
   }
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Client finalized");
   return result;
@@ -229,6 +224,7 @@ rcl_client_get_default_options()
   // Must set the allocator and qos after because they are not a compile time constant.
   default_options.qos = rmw_qos_profile_services_default;
   default_options.allocator = rcl_get_default_allocator();
+  default_options.max_pending_requests = 0;
   return default_options;
 }
 
@@ -261,11 +257,13 @@ rcl_client_get_rmw_handle(const rcl_client_t * client)
   return client->impl->rmw_handle;
 }
 
-rcl_ret_t
-rcl_send_request(const rcl_client_t * client, const void * ros_request, int64_t * sequence_number)
+// Implementation only
+static rcl_ret_t
+_rcl_send_request_impl(
+  const rcl_client_t * client, const void * ros_request, int64_t * sequence_number)
 {
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Client sending service request");
-  if (!rcl_client_is_valid(client)) {
+  if (!RCL_RUNTIME_CHECK(rcl_client_is_valid(client))) {
     return RCL_RET_CLIENT_INVALID;  // error already set
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(ros_request, RCL_RET_INVALID_ARGUMENT);
@@ -282,13 +280,83 @@ rcl_send_request(const rcl_client_t * client, const void * ros_request, int64_t
 }
 
 rcl_ret_t
-rcl_take_response(
+rcl_send_request(const rcl_client_t * client, const void * ros_request, int64_t * sequence_number)
+{
+  RCL_TRACEPOINT(rcl_send_request_entry, client);
+  rcl_ret_t ret = _rcl_send_request_impl(client, ros_request, sequence_number);
+  RCL_TRACEPOINT(rcl_send_request_exit, client);
+  return ret;
+}
+
+rcl_ret_t
+rcl_borrow_loaned_request(
+  const rcl_client_t * client,
+  const rosidl_service_type_support_t * type_support,
+  void ** ros_request)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(type_support, RCL_RET_INVALID_ARGUMENT);
+
+  rmw_ret_t ret = rmw_borrow_loaned_request(
+    client->impl->rmw_handle, type_support, ros_request);
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(ret);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_return_loaned_request_from_client(
+  const rcl_client_t * client,
+  void * loaned_request)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(loaned_request, RCL_RET_INVALID_ARGUMENT);
+
+  rmw_ret_t ret = rmw_return_loaned_request_from_client(
+    client->impl->rmw_handle, loaned_request);
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(ret);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_send_loaned_request(
+  const rcl_client_t * client,
+  void * ros_request,
+  int64_t * sequence_number)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_request, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(sequence_number, RCL_RET_INVALID_ARGUMENT);
+
+  rmw_ret_t ret = rmw_send_loaned_request(
+    client->impl->rmw_handle, ros_request, sequence_number);
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(ret);
+  }
+  return RCL_RET_OK;
+}
+
+// Implementation only
+static rcl_ret_t
+_rcl_take_response_impl(
   const rcl_client_t * client,
   rmw_request_id_t * request_header,
   void * ros_response)
 {
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Client taking service response");
-  if (!rcl_client_is_valid(client)) {
+  if (!RCL_RUNTIME_CHECK(rcl_client_is_valid(client))) {
     return RCL_RET_CLIENT_INVALID;  // error already set
   }
 
@@ -310,6 +378,151 @@ rcl_take_response(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_take_response(
+  const rcl_client_t * client,
+  rmw_request_id_t * request_header,
+  void * ros_response)
+{
+  RCL_TRACEPOINT(rcl_take_response_entry, client);
+  rcl_ret_t ret = _rcl_take_response_impl(client, request_header, ros_response);
+  RCL_TRACEPOINT(rcl_take_response_exit, client);
+  return ret;
+}
+
+rcl_ret_t
+rcl_send_request_pipelined(
+  const rcl_client_t * client,
+  const void * ros_request,
+  const void * user_cookie,
+  int64_t timeout,
+  int64_t * sequence_number)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_request, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(sequence_number, RCL_RET_INVALID_ARGUMENT);
+  rcl_client_impl_t * impl = client->impl;
+  if (NULL == impl->pending_requests) {
+    RCL_SET_ERROR_MSG("client was not initialized with max_pending_requests > 0");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // Claim a slot before sending, so a full table is reported before a
+  // request nothing will correlate with goes out.
+  rcl_client_pending_request_t * slot = NULL;
+  size_t i;
+  for (i = 0; i < impl->options.max_pending_requests; ++i) {
+    int64_t expected = PENDING_SLOT_FREE;
+    bool exchanged = false;
+    rcutils_atomic_compare_exchange_strong(
+      &impl->pending_requests[i].state, exchanged, &expected, PENDING_SLOT_CLAIMED);
+    if (exchanged) {
+      slot = &impl->pending_requests[i];
+      break;
+    }
+  }
+  if (NULL == slot) {
+    RCL_SET_ERROR_MSG("all pending request slots are in flight");
+    return RCL_RET_ERROR;
+  }
+  rcutils_time_point_value_t deadline = 0;
+  if (timeout > 0) {
+    rcutils_time_point_value_t now = 0;
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+      rcutils_atomic_store(&slot->state, (int64_t)PENDING_SLOT_FREE);
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    deadline = now + timeout;
+  }
+  rcl_ret_t ret = rcl_send_request(client, ros_request, sequence_number);
+  if (RCL_RET_OK != ret) {
+    rcutils_atomic_store(&slot->state, (int64_t)PENDING_SLOT_FREE);
+    return ret;  // error already set
+  }
+  slot->sequence_number = *sequence_number;
+  slot->user_cookie = user_cookie;
+  slot->deadline = deadline;
+  rcutils_atomic_store(&slot->state, (int64_t)PENDING_SLOT_IN_FLIGHT);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_client_take_ready_responses(
+  const rcl_client_t * client,
+  size_t capacity,
+  void ** ros_responses,
+  rcl_client_response_info_t * response_infos,
+  size_t * count)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_responses, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(response_infos, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(count, RCL_RET_INVALID_ARGUMENT);
+  *count = 0;
+  rcl_client_impl_t * impl = client->impl;
+  if (NULL == impl->pending_requests) {
+    RCL_SET_ERROR_MSG("client was not initialized with max_pending_requests > 0");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  size_t num_slots = impl->options.max_pending_requests;
+  // Drain every response the middleware has ready, correlating as we go.
+  while (*count < capacity) {
+    rmw_request_id_t request_header;
+    bool taken = false;
+    if (rmw_take_response(
+        impl->rmw_handle, &request_header, ros_responses[*count], &taken) != RMW_RET_OK)
+    {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    if (!taken) {
+      break;
+    }
+    const void * user_cookie = NULL;
+    size_t i;
+    for (i = 0; i < num_slots; ++i) {
+      rcl_client_pending_request_t * slot = &impl->pending_requests[i];
+      int64_t state;
+      rcutils_atomic_load(&slot->state, state);
+      if (PENDING_SLOT_IN_FLIGHT == state &&
+        slot->sequence_number == request_header.sequence_number)
+      {
+        user_cookie = slot->user_cookie;
+        rcutils_atomic_store(&slot->state, (int64_t)PENDING_SLOT_FREE);
+        break;
+      }
+    }
+    response_infos[*count].sequence_number = request_header.sequence_number;
+    response_infos[*count].user_cookie = user_cookie;
+    response_infos[*count].timed_out = false;
+    ++(*count);
+  }
+  // Report pending requests whose deadline has passed, freeing their slots.
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    return RCL_RET_ERROR;
+  }
+  size_t i;
+  for (i = 0; i < num_slots && *count < capacity; ++i) {
+    rcl_client_pending_request_t * slot = &impl->pending_requests[i];
+    int64_t state;
+    rcutils_atomic_load(&slot->state, state);
+    if (PENDING_SLOT_IN_FLIGHT == state && 0 != slot->deadline && now >= slot->deadline) {
+      response_infos[*count].sequence_number = slot->sequence_number;
+      response_infos[*count].user_cookie = slot->user_cookie;
+      response_infos[*count].timed_out = true;
+      rcutils_atomic_store(&slot->state, (int64_t)PENDING_SLOT_FREE);
+      ++(*count);
+    }
+  }
+  return RCL_RET_OK;
+}
+
 bool
 rcl_client_is_valid(const rcl_client_t * client)
 {
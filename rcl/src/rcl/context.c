@@ -21,7 +21,15 @@ extern "C"
 
 #include <stdbool.h>
 
+#include "./bringup_cache.h"
 #include "./context_impl.h"
+#include "./env_snapshot.h"
+#include "./intra_context.h"
+#include "./graph_cache.h"
+#include "./graph_guard.h"
+#include "./reclamation_impl.h"
+#include "./string_intern.h"
+#include "./timer_wheel.h"
 #include "rcutils/stdatomic_helper.h"
 
 rcl_context_t
@@ -92,6 +100,49 @@ rcl_context_get_rmw_context(rcl_context_t * context)
   return &(context->impl->rmw_context);
 }
 
+rcl_ret_t
+rcl_context_set_counters_enabled(rcl_context_t * context, bool enabled)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl, "context is zero-initialized", return RCL_RET_INVALID_ARGUMENT);
+  context->impl->counters_enabled = enabled;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_context_get_counters(rcl_context_t * context, rcl_context_counters_t * counters)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(counters, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl, "context is zero-initialized", return RCL_RET_INVALID_ARGUMENT);
+  atomic_uint_least64_t * storage = context->impl->counters;
+  counters->messages_published =
+    rcutils_atomic_load_uint64_t(&storage[RCL_CONTEXT_COUNTER_MESSAGES_PUBLISHED]);
+  counters->messages_taken =
+    rcutils_atomic_load_uint64_t(&storage[RCL_CONTEXT_COUNTER_MESSAGES_TAKEN]);
+  counters->wait_cycles =
+    rcutils_atomic_load_uint64_t(&storage[RCL_CONTEXT_COUNTER_WAIT_CYCLES]);
+  counters->timer_calls =
+    rcutils_atomic_load_uint64_t(&storage[RCL_CONTEXT_COUNTER_TIMER_CALLS]);
+  counters->serialized_bytes =
+    rcutils_atomic_load_uint64_t(&storage[RCL_CONTEXT_COUNTER_SERIALIZED_BYTES]);
+  return RCL_RET_OK;
+}
+
+void
+rcl_context_counter_add(
+  rcl_context_t * context,
+  rcl_context_counter_kind_t kind,
+  uint64_t amount)
+{
+  if (NULL == context || NULL == context->impl || !context->impl->counters_enabled) {
+    return;
+  }
+  (void)rcutils_atomic_fetch_add_uint64_t(&context->impl->counters[kind], amount);
+}
+
 void
 __cleanup_context(rcl_context_t * context)
 {
@@ -134,6 +185,10 @@ __cleanup_context(rcl_context_t * context)
       }
     }
 
+    // drain and free the reclamation domain while the middleware is still
+    // alive, in case a finalizer reaches into rmw
+    rcl_reclamation_fini(context);
+
     // clean up rmw_context
     if (NULL != context->impl->rmw_context.implementation_identifier) {
       rmw_ret_t rmw_ret = rmw_context_fini(&(context->impl->rmw_context));
@@ -147,6 +202,18 @@ __cleanup_context(rcl_context_t * context)
       }
     }
 
+    // clean up the intra-context registry if it was created
+    rcl_intra_context_registry_fini(context);
+
+    // clean up the timer wheel if it was created
+    rcl_timer_wheel_fini(context);
+    rcl_graph_cache_fini(context);
+    rcl_graph_guard_fini(context);
+    rcl_string_intern_fini(context);
+    rcl_env_snapshot_fini(context);
+    // flushes the cache to disk when new entries were derived this run
+    rcl_bringup_cache_fini(context);
+
     // clean up copy of argv if valid
     if (NULL != context->impl->argv) {
       int64_t i;
@@ -17,6 +17,7 @@
 
 #include "rcl/context.h"
 #include "rcl/error_handling.h"
+#include "rcutils/stdatomic_helper.h"
 
 #include "./init_options_impl.h"
 
@@ -25,6 +26,17 @@ extern "C"
 {
 #endif
 
+/// Identifies one of the context event counters. \internal
+typedef enum rcl_context_counter_kind_t
+{
+  RCL_CONTEXT_COUNTER_MESSAGES_PUBLISHED = 0,
+  RCL_CONTEXT_COUNTER_MESSAGES_TAKEN,
+  RCL_CONTEXT_COUNTER_WAIT_CYCLES,
+  RCL_CONTEXT_COUNTER_TIMER_CALLS,
+  RCL_CONTEXT_COUNTER_SERIALIZED_BYTES,
+  RCL_CONTEXT_COUNTER_KIND_COUNT
+} rcl_context_counter_kind_t;
+
 /// \internal
 typedef struct rcl_context_impl_t
 {
@@ -38,8 +50,45 @@ typedef struct rcl_context_impl_t
   char ** argv;
   /// rmw context.
   rmw_context_t rmw_context;
+  /// Registry of intra-context subscriptions, lazily created (may be `NULL`).
+  struct rcl_intra_context_registry_t * intra_context_registry;
+  /// Timer wheel shared by the context's timers, lazily created (may be `NULL`).
+  struct rcl_timer_wheel_t * timer_wheel;
+  /// Cache of graph query results, lazily created (may be `NULL`).
+  struct rcl_graph_cache_t * graph_cache;
+  /// Registry backing the graph guard condition shared by the context's
+  /// nodes, lazily created (may be `NULL`).
+  struct rcl_graph_guard_registry_t * graph_guard_registry;
+  /// Table of interned name strings, lazily created (may be `NULL`).
+  struct rcl_string_intern_table_t * string_intern_table;
+  /// Snapshot of the rcl-relevant environment taken during init (may be
+  /// `NULL` if taking it failed).
+  struct rcl_env_snapshot_t * env_snapshot;
+  /// Epoch based reclamation domain, lazily created (may be `NULL`), see
+  /// rcl/reclamation.h.
+  struct rcl_reclamation_domain_t * reclamation_domain;
+  /// Persistent cache of derived bringup state (may be `NULL` when disabled),
+  /// see ./bringup_cache.h.
+  struct rcl_bringup_cache_t * bringup_cache;
+  /// Whether the event counters below are maintained, see
+  /// rcl_context_set_counters_enabled().
+  bool counters_enabled;
+  /// Event counter storage, indexed by rcl_context_counter_kind_t.
+  atomic_uint_least64_t counters[RCL_CONTEXT_COUNTER_KIND_COUNT];
 } rcl_context_impl_t;
 
+/// Add to one of the context's event counters. \internal
+/**
+ * Does nothing when the counters are disabled, or when the context is `NULL`
+ * or not fully initialized, so hot paths can call it unconditionally.
+ */
+RCL_LOCAL
+void
+rcl_context_counter_add(
+  rcl_context_t * context,
+  rcl_context_counter_kind_t kind,
+  uint64_t amount);
+
 RCL_LOCAL
 void
 __cleanup_context(rcl_context_t * context);
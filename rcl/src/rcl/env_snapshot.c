@@ -0,0 +1,123 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./env_snapshot.h"
+
+#include <string.h>
+
+#include "rcl/error_handling.h"
+#include "rcutils/strdup.h"
+
+#include "./common.h"
+#include "./context_impl.h"
+
+// The variables captured at init time, i.e. every variable rcl itself reads
+// after rcl_init().  Parallel to rcl_env_snapshot_t.values.
+static const char * const __env_snapshot_var_names[RCL_ENV_SNAPSHOT_NUM_VARS] = {
+  "ROS_DOMAIN_ID",
+  "RMW_IMPLEMENTATION",
+  "RCL_ASSERT_RMW_ID_MATCHES",
+  "ROS_SECURITY_ENABLE",
+  "ROS_SECURITY_STRATEGY",
+  "ROS_SECURITY_NODE_DIRECTORY",
+  "ROS_SECURITY_ROOT_DIRECTORY",
+  "ROS_SECURITY_LOOKUP_TYPE",
+};
+
+rcl_ret_t
+rcl_env_snapshot_init(rcl_context_t * context)
+{
+  // Internal function; the caller (rcl_init) has validated the context.
+  rcl_allocator_t * allocator = &context->impl->allocator;
+  rcl_env_snapshot_t * snapshot = (rcl_env_snapshot_t *)allocator->zero_allocate(
+    1, sizeof(rcl_env_snapshot_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    snapshot, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  snapshot->allocator = *allocator;
+  for (size_t i = 0; i < RCL_ENV_SNAPSHOT_NUM_VARS; ++i) {
+    const char * env_value = NULL;
+    if (RCL_RET_OK != rcl_impl_getenv(__env_snapshot_var_names[i], &env_value)) {
+      context->impl->env_snapshot = snapshot;
+      rcl_env_snapshot_fini(context);
+      return RCL_RET_ERROR;  // error already set
+    }
+    if (NULL == env_value || 0 == strlen(env_value)) {
+      continue;
+    }
+    snapshot->values[i] = rcutils_strdup(env_value, *allocator);
+    if (NULL == snapshot->values[i]) {
+      context->impl->env_snapshot = snapshot;
+      rcl_env_snapshot_fini(context);
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+  context->impl->env_snapshot = snapshot;
+  return RCL_RET_OK;
+}
+
+void
+rcl_env_snapshot_fini(rcl_context_t * context)
+{
+  rcl_env_snapshot_t * snapshot = context->impl->env_snapshot;
+  if (NULL == snapshot) {
+    return;
+  }
+  for (size_t i = 0; i < RCL_ENV_SNAPSHOT_NUM_VARS; ++i) {
+    if (NULL != snapshot->values[i]) {
+      snapshot->allocator.deallocate(snapshot->values[i], snapshot->allocator.state);
+    }
+  }
+  snapshot->allocator.deallocate(snapshot, snapshot->allocator.state);
+  context->impl->env_snapshot = NULL;
+}
+
+rcl_ret_t
+rcl_context_getenv(
+  const rcl_context_t * context,
+  const char * env_name,
+  const char ** env_value)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(env_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(env_value, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != context && NULL != context->impl && NULL != context->impl->env_snapshot) {
+    const rcl_env_snapshot_t * snapshot = context->impl->env_snapshot;
+    for (size_t i = 0; i < RCL_ENV_SNAPSHOT_NUM_VARS; ++i) {
+      if (0 == strcmp(env_name, __env_snapshot_var_names[i])) {
+        *env_value = snapshot->values[i];
+        return RCL_RET_OK;
+      }
+    }
+  }
+  // Variable outside the snapshot, or no snapshot was taken; read the
+  // environment directly, normalizing empty values to NULL to match the
+  // snapshot convention.
+  rcl_ret_t ret = rcl_impl_getenv(env_name, env_value);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  if (NULL != *env_value && 0 == strlen(*env_value)) {
+    *env_value = NULL;
+  }
+  return RCL_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
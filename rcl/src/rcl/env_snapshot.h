@@ -0,0 +1,78 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__ENV_SNAPSHOT_H_
+#define RCL__ENV_SNAPSHOT_H_
+
+#include "rcl/context.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// \internal Number of environment variables captured in the snapshot.
+#define RCL_ENV_SNAPSHOT_NUM_VARS 8
+
+/// \internal One-shot snapshot of the rcl-relevant environment.
+/**
+ * Taken once during rcl_init() so later lookups are served from memory;
+ * rcl_node_init() otherwise reads the domain id and the security variables
+ * from the environment on every call.
+ *
+ * Variables which were unset (or empty) at init time are stored as `NULL`.
+ */
+typedef struct rcl_env_snapshot_t
+{
+  /// Values of the captured variables, parallel to the internal name table;
+  /// allocated copies or `NULL` for unset variables.
+  char * values[RCL_ENV_SNAPSHOT_NUM_VARS];
+  rcl_allocator_t allocator;
+} rcl_env_snapshot_t;
+
+/// \internal Capture the environment into the context, lazily allocating the
+/// snapshot.  Failure leaves the context without a snapshot, in which case
+/// rcl_context_getenv() falls back to reading the environment directly.
+RCL_LOCAL
+rcl_ret_t
+rcl_env_snapshot_init(rcl_context_t * context);
+
+/// \internal Release all snapshot memory; called while cleaning up the
+/// context.
+RCL_LOCAL
+void
+rcl_env_snapshot_fini(rcl_context_t * context);
+
+/// \internal Look up an environment variable, serving captured variables
+/// from the context's snapshot.
+/**
+ * Sets `env_value` to the value the variable had when the snapshot was
+ * taken, or to `NULL` if it was unset or empty.  Variables outside the
+ * snapshot, and every lookup on a context without a snapshot, read the
+ * environment directly with the same unset-to-`NULL` convention.
+ */
+RCL_LOCAL
+rcl_ret_t
+rcl_context_getenv(
+  const rcl_context_t * context,
+  const char * env_name,
+  const char ** env_value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__ENV_SNAPSHOT_H_
@@ -0,0 +1,423 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/error_handling.h"
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/* A deferred error records the format string pointer and its arguments when
+ * the error is set and only renders the message when the error state is
+ * actually read. Setting the error is then a scan of the (short) format
+ * string plus a few stores, instead of a full snprintf() into the
+ * thread-local error buffer.
+ *
+ * Arguments are captured by value; string arguments are copied into a bounded
+ * per-argument buffer so they may go out of scope after the error is set.
+ */
+
+#define RCL_DEFERRED_ERROR_MAX_ARGS 8
+#define RCL_DEFERRED_ERROR_STRING_ARG_LENGTH 256
+#define RCL_DEFERRED_ERROR_SPEC_LENGTH 16
+
+typedef enum rcl_deferred_arg_kind_t
+{
+  RCL_DEFERRED_ARG_SIGNED,
+  RCL_DEFERRED_ARG_UNSIGNED,
+  RCL_DEFERRED_ARG_DOUBLE,
+  RCL_DEFERRED_ARG_CHAR,
+  RCL_DEFERRED_ARG_STRING,
+  RCL_DEFERRED_ARG_POINTER,
+} rcl_deferred_arg_kind_t;
+
+typedef enum rcl_deferred_arg_length_t
+{
+  RCL_DEFERRED_LENGTH_NONE,
+  RCL_DEFERRED_LENGTH_SHORT,  // h and hh, promoted to int in varargs
+  RCL_DEFERRED_LENGTH_LONG,
+  RCL_DEFERRED_LENGTH_LONG_LONG,
+  RCL_DEFERRED_LENGTH_INTMAX,
+  RCL_DEFERRED_LENGTH_SIZE,
+  RCL_DEFERRED_LENGTH_PTRDIFF,
+} rcl_deferred_arg_length_t;
+
+typedef struct rcl_deferred_arg_t
+{
+  rcl_deferred_arg_kind_t kind;
+  rcl_deferred_arg_length_t length;
+  // replay conversion spec, with the length modifier canonicalized to 64 bit
+  char spec[RCL_DEFERRED_ERROR_SPEC_LENGTH];
+  // number of characters the conversion occupies in the format string
+  size_t source_length;
+  union {
+    int64_t i;
+    uint64_t u;
+    double d;
+    int c;
+    const void * p;
+  } value;
+  char string_value[RCL_DEFERRED_ERROR_STRING_ARG_LENGTH];
+} rcl_deferred_arg_t;
+
+typedef struct rcl_deferred_error_t
+{
+  // NULL when no deferred error is pending
+  const char * format;
+  const char * file;
+  uint64_t line;
+  size_t num_args;
+  rcl_deferred_arg_t args[RCL_DEFERRED_ERROR_MAX_ARGS];
+} rcl_deferred_error_t;
+
+static RCUTILS_THREAD_LOCAL rcl_deferred_error_t __deferred_error;
+
+/* Parses the conversion spec starting at the '%' that *fmt_inout points to,
+ * filling in the argument's kind, length, replay spec and source length.
+ * Returns false if the conversion cannot be captured (the caller then falls
+ * back to formatting immediately). '%%' is handled by the caller.
+ */
+// Implementation only
+static bool
+_rcl_error_parse_conversion(const char ** fmt_inout, rcl_deferred_arg_t * arg)
+{
+  const char * start = *fmt_inout;
+  const char * fmt = start + 1;
+  size_t spec_length = 0;
+  arg->spec[spec_length++] = '%';
+  // flags, field width and precision are kept verbatim in the replay spec
+  while (
+    '-' == *fmt || '+' == *fmt || ' ' == *fmt || '#' == *fmt || '.' == *fmt ||
+    ('0' <= *fmt && '9' >= *fmt))
+  {
+    // leave room for the canonical length modifier, conversion and terminator
+    if (spec_length + 5 >= RCL_DEFERRED_ERROR_SPEC_LENGTH) {
+      return false;
+    }
+    arg->spec[spec_length++] = *fmt++;
+  }
+  if ('*' == *fmt) {
+    // runtime field widths and precisions consume extra arguments
+    return false;
+  }
+  arg->length = RCL_DEFERRED_LENGTH_NONE;
+  if ('h' == *fmt) {
+    arg->length = RCL_DEFERRED_LENGTH_SHORT;
+    ++fmt;
+    if ('h' == *fmt) {
+      ++fmt;
+    }
+  } else if ('l' == *fmt) {
+    arg->length = RCL_DEFERRED_LENGTH_LONG;
+    ++fmt;
+    if ('l' == *fmt) {
+      arg->length = RCL_DEFERRED_LENGTH_LONG_LONG;
+      ++fmt;
+    }
+  } else if ('j' == *fmt) {
+    arg->length = RCL_DEFERRED_LENGTH_INTMAX;
+    ++fmt;
+  } else if ('z' == *fmt) {
+    arg->length = RCL_DEFERRED_LENGTH_SIZE;
+    ++fmt;
+  } else if ('t' == *fmt) {
+    arg->length = RCL_DEFERRED_LENGTH_PTRDIFF;
+    ++fmt;
+  } else if ('L' == *fmt) {
+    // long double is not captured
+    return false;
+  }
+  const char * suffix = NULL;
+  const char conversion = *fmt;
+  switch (conversion) {
+    case 'd':
+    case 'i':
+      arg->kind = RCL_DEFERRED_ARG_SIGNED;
+      suffix = PRId64;
+      break;
+    case 'u':
+      arg->kind = RCL_DEFERRED_ARG_UNSIGNED;
+      suffix = PRIu64;
+      break;
+    case 'o':
+      arg->kind = RCL_DEFERRED_ARG_UNSIGNED;
+      suffix = PRIo64;
+      break;
+    case 'x':
+      arg->kind = RCL_DEFERRED_ARG_UNSIGNED;
+      suffix = PRIx64;
+      break;
+    case 'X':
+      arg->kind = RCL_DEFERRED_ARG_UNSIGNED;
+      suffix = PRIX64;
+      break;
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      arg->kind = RCL_DEFERRED_ARG_DOUBLE;
+      break;
+    case 'c':
+      arg->kind = RCL_DEFERRED_ARG_CHAR;
+      break;
+    case 's':
+      arg->kind = RCL_DEFERRED_ARG_STRING;
+      break;
+    case 'p':
+      arg->kind = RCL_DEFERRED_ARG_POINTER;
+      break;
+    default:
+      return false;
+  }
+  ++fmt;
+  if (NULL != suffix) {
+    size_t suffix_length = strlen(suffix);
+    if (spec_length + suffix_length >= RCL_DEFERRED_ERROR_SPEC_LENGTH) {
+      return false;
+    }
+    memcpy(&arg->spec[spec_length], suffix, suffix_length);
+    spec_length += suffix_length;
+  } else {
+    arg->spec[spec_length++] = conversion;
+  }
+  arg->spec[spec_length] = '\0';
+  arg->source_length = (size_t)(fmt - start);
+  *fmt_inout = fmt;
+  return true;
+}
+
+// Implementation only
+static void
+_rcl_error_capture_arg(rcl_deferred_arg_t * arg, va_list * args)
+{
+  switch (arg->kind) {
+    case RCL_DEFERRED_ARG_SIGNED:
+      switch (arg->length) {
+        case RCL_DEFERRED_LENGTH_LONG:
+          arg->value.i = (int64_t)va_arg(*args, long);
+          break;
+        case RCL_DEFERRED_LENGTH_LONG_LONG:
+          arg->value.i = (int64_t)va_arg(*args, long long);
+          break;
+        case RCL_DEFERRED_LENGTH_INTMAX:
+          arg->value.i = (int64_t)va_arg(*args, intmax_t);
+          break;
+        case RCL_DEFERRED_LENGTH_SIZE:
+          arg->value.i = (int64_t)va_arg(*args, size_t);
+          break;
+        case RCL_DEFERRED_LENGTH_PTRDIFF:
+          arg->value.i = (int64_t)va_arg(*args, ptrdiff_t);
+          break;
+        default:  // char and short arguments are promoted to int
+          arg->value.i = (int64_t)va_arg(*args, int);
+          break;
+      }
+      break;
+    case RCL_DEFERRED_ARG_UNSIGNED:
+      switch (arg->length) {
+        case RCL_DEFERRED_LENGTH_LONG:
+          arg->value.u = (uint64_t)va_arg(*args, unsigned long);
+          break;
+        case RCL_DEFERRED_LENGTH_LONG_LONG:
+          arg->value.u = (uint64_t)va_arg(*args, unsigned long long);
+          break;
+        case RCL_DEFERRED_LENGTH_INTMAX:
+          arg->value.u = (uint64_t)va_arg(*args, uintmax_t);
+          break;
+        case RCL_DEFERRED_LENGTH_SIZE:
+          arg->value.u = (uint64_t)va_arg(*args, size_t);
+          break;
+        case RCL_DEFERRED_LENGTH_PTRDIFF:
+          arg->value.u = (uint64_t)va_arg(*args, ptrdiff_t);
+          break;
+        default:
+          arg->value.u = (uint64_t)va_arg(*args, unsigned int);
+          break;
+      }
+      break;
+    case RCL_DEFERRED_ARG_DOUBLE:
+      // float arguments are promoted to double
+      arg->value.d = va_arg(*args, double);
+      break;
+    case RCL_DEFERRED_ARG_CHAR:
+      arg->value.c = va_arg(*args, int);
+      break;
+    case RCL_DEFERRED_ARG_STRING:
+      {
+        const char * string = va_arg(*args, const char *);
+        if (NULL == string) {
+          string = "(null)";
+        }
+        size_t length = strlen(string);
+        if (length >= sizeof(arg->string_value)) {
+          length = sizeof(arg->string_value) - 1;
+        }
+        memcpy(arg->string_value, string, length);
+        arg->string_value[length] = '\0';
+      }
+      break;
+    case RCL_DEFERRED_ARG_POINTER:
+    default:
+      arg->value.p = va_arg(*args, void *);
+      break;
+  }
+}
+
+void
+rcl_set_error_state_deferred(
+  const char * file, uint64_t line, const char * format_string, ...)
+{
+  va_list args;
+  va_start(args, format_string);
+  rcl_deferred_error_t * error = &__deferred_error;
+
+  // plan the capture by scanning the format string; no arguments are consumed
+  bool supported = NULL != format_string;
+  size_t num_args = 0;
+  const char * fmt = format_string;
+  while (supported && '\0' != *fmt) {
+    if ('%' != *fmt) {
+      ++fmt;
+      continue;
+    }
+    if ('%' == fmt[1]) {
+      fmt += 2;
+      continue;
+    }
+    if (RCL_DEFERRED_ERROR_MAX_ARGS == num_args) {
+      supported = false;
+      break;
+    }
+    supported = _rcl_error_parse_conversion(&fmt, &error->args[num_args]);
+    ++num_args;
+  }
+
+  if (supported) {
+    // capture the arguments by value; the formatting happens on first read
+    for (size_t i = 0; i < num_args; ++i) {
+      _rcl_error_capture_arg(&error->args[i], &args);
+    }
+    error->format = format_string;
+    error->file = file;
+    error->line = line;
+    error->num_args = num_args;
+    // this error replaces any previously set one
+    rcutils_reset_error();
+  } else {
+    // fall back to formatting immediately
+    error->format = NULL;
+    char buffer[RCUTILS_ERROR_MESSAGE_MAX_LENGTH];
+    int written =
+      vsnprintf(buffer, sizeof(buffer), NULL != format_string ? format_string : "", args);
+    if (written < 0) {
+      buffer[0] = '\0';
+    }
+    rcutils_set_error_state(buffer, file, (size_t)line);
+  }
+  va_end(args);
+}
+
+void
+rcl_error_state_materialize(void)
+{
+  rcl_deferred_error_t * error = &__deferred_error;
+  if (NULL == error->format) {
+    return;
+  }
+  if (rcutils_error_is_set()) {
+    // an error was set eagerly after this one was recorded; keep the newer one
+    error->format = NULL;
+    return;
+  }
+  char buffer[RCUTILS_ERROR_MESSAGE_MAX_LENGTH];
+  size_t offset = 0;
+  size_t arg_index = 0;
+  const char * fmt = error->format;
+  while ('\0' != *fmt && offset + 1 < sizeof(buffer)) {
+    if ('%' != *fmt) {
+      buffer[offset++] = *fmt++;
+      continue;
+    }
+    if ('%' == fmt[1]) {
+      buffer[offset++] = '%';
+      fmt += 2;
+      continue;
+    }
+    if (arg_index >= error->num_args) {
+      break;  // unreachable for format strings the capture accepted
+    }
+    const rcl_deferred_arg_t * arg = &error->args[arg_index++];
+    const size_t remaining = sizeof(buffer) - offset;
+    int written = -1;
+    switch (arg->kind) {
+      case RCL_DEFERRED_ARG_SIGNED:
+        written = snprintf(&buffer[offset], remaining, arg->spec, arg->value.i);
+        break;
+      case RCL_DEFERRED_ARG_UNSIGNED:
+        written = snprintf(&buffer[offset], remaining, arg->spec, arg->value.u);
+        break;
+      case RCL_DEFERRED_ARG_DOUBLE:
+        written = snprintf(&buffer[offset], remaining, arg->spec, arg->value.d);
+        break;
+      case RCL_DEFERRED_ARG_CHAR:
+        written = snprintf(&buffer[offset], remaining, arg->spec, arg->value.c);
+        break;
+      case RCL_DEFERRED_ARG_STRING:
+        written = snprintf(&buffer[offset], remaining, arg->spec, arg->string_value);
+        break;
+      case RCL_DEFERRED_ARG_POINTER:
+        written = snprintf(&buffer[offset], remaining, arg->spec, arg->value.p);
+        break;
+    }
+    if (written < 0) {
+      break;
+    }
+    if ((size_t)written >= remaining) {
+      offset = sizeof(buffer) - 1;
+      break;
+    }
+    offset += (size_t)written;
+    fmt += arg->source_length;
+  }
+  buffer[offset] = '\0';
+  error->format = NULL;
+  rcutils_set_error_state(buffer, error->file, (size_t)error->line);
+}
+
+void
+rcl_error_state_clear_deferred(void)
+{
+  __deferred_error.format = NULL;
+}
+
+bool
+rcl_error_state_is_deferred(void)
+{
+  return NULL != __deferred_error.format;
+}
+
+#ifdef __cplusplus
+}
+#endif
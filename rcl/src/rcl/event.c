@@ -149,6 +149,40 @@ rcl_take_event(
   return rcl_convert_rmw_ret_to_rcl_ret(ret);
 }
 
+rcl_ret_t
+rcl_take_event_coalesced(
+  const rcl_event_t * event,
+  void * event_info,
+  size_t * events_taken)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(event, RCL_RET_EVENT_INVALID);
+  RCL_CHECK_ARGUMENT_FOR_NULL(event_info, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(events_taken, RCL_RET_INVALID_ARGUMENT);
+  *events_taken = 0;
+  // Overwrite event_info on every take; the status structs carry cumulative
+  // counts, so only the latest instance and the number drained matter.
+  bool taken = true;
+  while (taken) {
+    taken = false;
+    rmw_ret_t ret = rmw_take_event(&event->impl->rmw_handle, event_info, &taken);
+    if (RMW_RET_OK != ret) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      return rcl_convert_rmw_ret_to_rcl_ret(ret);
+    }
+    if (taken) {
+      ++(*events_taken);
+    }
+  }
+  if (0 == *events_taken) {
+    RCUTILS_LOG_DEBUG_NAMED(
+      ROS_PACKAGE_NAME, "take_event request complete, unable to take event");
+    return RCL_RET_EVENT_TAKE_FAILED;
+  }
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "take_event request success, coalesced %zu events", *events_taken);
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_event_fini(rcl_event_t * event)
 {
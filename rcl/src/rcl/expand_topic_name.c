@@ -27,8 +27,6 @@ extern "C"
 #include "rcl/types.h"
 #include "rcl/validate_topic_name.h"
 #include "rcutils/error_handling.h"
-#include "rcutils/format_string.h"
-#include "rcutils/repl_str.h"
 #include "rcutils/strdup.h"
 #include "rmw/error_handling.h"
 #include "rmw/types.h"
@@ -40,21 +38,54 @@ extern "C"
 #define SUBSTITUION_NAMESPACE "{ns}"
 #define SUBSTITUION_NAMESPACE2 "{namespace}"
 
-rcl_ret_t
-rcl_expand_topic_name(
-  const char * input_topic_name,
+/// Resolve one '{substitution}' to its replacement text. Implementation only.
+/**
+ * \param[in] substitution points at the opening brace
+ * \param[in] substitution_len length including both braces
+ * \return `RCL_RET_OK` with `*replacement` set, or
+ * \return `RCL_RET_UNKNOWN_SUBSTITUTION` with the error message set.
+ */
+static rcl_ret_t
+_rcl_expand_topic_name_resolve_substitution(
+  const char * substitution,
+  size_t substitution_len,
   const char * node_name,
   const char * node_namespace,
   const rcutils_string_map_t * substitutions,
-  rcl_allocator_t allocator,
-  char ** output_topic_name)
+  const char ** replacement)
+{
+  if (strncmp(SUBSTITUION_NODE_NAME, substitution, substitution_len) == 0) {
+    *replacement = node_name;
+    return RCL_RET_OK;
+  }
+  if (  // NOLINT
+    strncmp(SUBSTITUION_NAMESPACE, substitution, substitution_len) == 0 ||
+    strncmp(SUBSTITUION_NAMESPACE2, substitution, substitution_len) == 0)
+  {
+    *replacement = node_namespace;
+    return RCL_RET_OK;
+  }
+  *replacement = rcutils_string_map_getn(
+    substitutions,
+    // compare {substitution}
+    //          ^ until    ^
+    substitution + 1, substitution_len - 2);
+  if (*replacement) {
+    return RCL_RET_OK;
+  }
+  // in this case, it is neither node name nor ns nor in the substitutions map, so error
+  RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+    "unknown substitution: %.*s", (int)substitution_len, substitution);
+  return RCL_RET_UNKNOWN_SUBSTITUTION;
+}
+
+/// Validate the topic name, node name, and namespace. Implementation only.
+static rcl_ret_t
+_rcl_expand_topic_name_validate_input(
+  const char * input_topic_name,
+  const char * node_name,
+  const char * node_namespace)
 {
-  // check arguments that could be null
-  RCL_CHECK_ARGUMENT_FOR_NULL(input_topic_name, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(node_name, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(node_namespace, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(substitutions, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(output_topic_name, RCL_RET_INVALID_ARGUMENT);
   // validate the input topic
   int validation_result;
   rcl_ret_t ret = rcl_validate_topic_name(input_topic_name, &validation_result, NULL);
@@ -101,6 +132,126 @@ rcl_expand_topic_name(
     RCL_SET_ERROR_MSG("node namespace is invalid");
     return RCL_RET_NODE_INVALID_NAMESPACE;
   }
+  return RCL_RET_OK;
+}
+
+/// Size the expanded topic body and learn its first character. Implementation only.
+/**
+ * The first character of the body after substitution decides whether the
+ * expanded topic needs a namespace prefix, so it is reported along with the
+ * length.
+ */
+static rcl_ret_t
+_rcl_expand_topic_name_measure(
+  const char * body,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions,
+  size_t * body_len,
+  char * first_char)
+{
+  *body_len = 0;
+  *first_char = '\0';
+  const char * in = body;
+  while ('\0' != *in) {
+    if ('{' == *in) {
+      const char * next_closing_brace = strchr(in, '}');
+      size_t substitution_substr_len = (size_t)(next_closing_brace - in) + 1;
+      const char * replacement = NULL;
+      rcl_ret_t ret = _rcl_expand_topic_name_resolve_substitution(
+        in, substitution_substr_len, node_name, node_namespace, substitutions, &replacement);
+      if (ret != RCL_RET_OK) {
+        return ret;
+      }
+      size_t replacement_len = strlen(replacement);
+      if ('\0' == *first_char && replacement_len > 0) {
+        *first_char = replacement[0];
+      }
+      *body_len += replacement_len;
+      in = next_closing_brace + 1;
+    } else {
+      if ('\0' == *first_char) {
+        *first_char = *in;
+      }
+      (*body_len)++;
+      in++;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+/// Emit the prefix and expanded body into `out`. Implementation only.
+/**
+ * `out` must have room for the size computed by the measure pass, plus a
+ * terminating null byte, which is always written.
+ */
+static rcl_ret_t
+_rcl_expand_topic_name_emit(
+  char * out,
+  const char * body,
+  bool has_a_namespace_tilde,
+  size_t prefix_len,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions)
+{
+  if (0 != prefix_len) {
+    size_t node_namespace_len = strlen(node_namespace);
+    memcpy(out, node_namespace, node_namespace_len);
+    out += node_namespace_len;
+    if (1 != node_namespace_len) {
+      *out++ = '/';
+    }
+    if (has_a_namespace_tilde) {
+      size_t node_name_len = strlen(node_name);
+      memcpy(out, node_name, node_name_len);
+      out += node_name_len;
+    }
+  }
+  const char * in = body;
+  while ('\0' != *in) {
+    if ('{' == *in) {
+      const char * next_closing_brace = strchr(in, '}');
+      size_t substitution_substr_len = (size_t)(next_closing_brace - in) + 1;
+      const char * replacement = NULL;
+      // the measure pass already resolved this, so it cannot fail here
+      rcl_ret_t ret = _rcl_expand_topic_name_resolve_substitution(
+        in, substitution_substr_len, node_name, node_namespace, substitutions, &replacement);
+      if (ret != RCL_RET_OK) {
+        return ret;
+      }
+      size_t replacement_len = strlen(replacement);
+      memcpy(out, replacement, replacement_len);
+      out += replacement_len;
+      in = next_closing_brace + 1;
+    } else {
+      *out++ = *in++;
+    }
+  }
+  *out = '\0';
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_expand_topic_name(
+  const char * input_topic_name,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions,
+  rcl_allocator_t allocator,
+  char ** output_topic_name)
+{
+  // check arguments that could be null
+  RCL_CHECK_ARGUMENT_FOR_NULL(input_topic_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_namespace, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(substitutions, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(output_topic_name, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret =
+    _rcl_expand_topic_name_validate_input(input_topic_name, node_name, node_namespace);
+  if (ret != RCL_RET_OK) {
+    return ret;
+  }
   // check if the topic has substitutions to be made
   bool has_a_substitution = strchr(input_topic_name, '{') != NULL;
   bool has_a_namespace_tilde = input_topic_name[0] == '~';
@@ -116,124 +267,117 @@ rcl_expand_topic_name(
     }
     return RCL_RET_OK;
   }
-  char * local_output = NULL;
-  // if has_a_namespace_tilde, replace that first
-  if (has_a_namespace_tilde) {
-    // special case where node_namespace is just '/'
-    // then no additional separating '/' is needed
-    const char * fmt = (strlen(node_namespace) == 1) ? "%s%s%s" : "%s/%s%s";
-    local_output =
-      rcutils_format_string(allocator, fmt, node_namespace, node_name, input_topic_name + 1);
-    if (!local_output) {
-      *output_topic_name = NULL;
-      RCL_SET_ERROR_MSG("failed to allocate memory for output topic");
-      return RCL_RET_BAD_ALLOC;
-    }
+  // Everything below runs as two identical left-to-right passes over the
+  // topic: one to size the result (and learn its first character, which
+  // decides whether a namespace prefix is needed), one to emit it into a
+  // single allocation. No intermediate strings are created per substitution.
+  //
+  // Assumptions about any substitutions in the topic string:
+  //
+  // - All {} are matched and balanced
+  // - There is no nesting, i.e. {{}}
+  // - There are no empty substitution substr, i.e. '{}' versus '{something}'
+  //
+  // These assumptions are taken because this is checked in the validation function.
+  // the '~' is consumed here; the rest of the topic is the body
+  const char * body = has_a_namespace_tilde ? (input_topic_name + 1) : input_topic_name;
+  // measure pass
+  size_t body_len = 0;
+  char first_char = '\0';
+  ret = _rcl_expand_topic_name_measure(
+    body, node_name, node_namespace, substitutions, &body_len, &first_char);
+  if (ret != RCL_RET_OK) {
+    *output_topic_name = NULL;
+    return ret;
   }
-  // if it has any substitutions, replace those
-  if (has_a_substitution) {
-    // Assumptions entering this scope about the topic string:
-    //
-    // - All {} are matched and balanced
-    // - There is no nesting, i.e. {{}}
-    // - There are no empty substitution substr, i.e. '{}' versus '{something}'
-    //
-    // These assumptions are taken because this is checked in the validation function.
-    const char * current_output = (local_output) ? local_output : input_topic_name;
-    char * next_opening_brace = NULL;
-    // current_output may be replaced on each loop if a substitution is made
-    while ((next_opening_brace = strchr(current_output, '{')) != NULL) {
-      char * next_closing_brace = strchr(current_output, '}');
-      // conclusion based on above assumptions: next_closing_brace - next_opening_brace > 1
-      size_t substitution_substr_len = next_closing_brace - next_opening_brace + 1;
-      // figure out what the replacement is for this substitution
-      const char * replacement = NULL;
-      if (strncmp(SUBSTITUION_NODE_NAME, next_opening_brace, substitution_substr_len) == 0) {
-        replacement = node_name;
-      } else if (  // NOLINT
-        strncmp(SUBSTITUION_NAMESPACE, next_opening_brace, substitution_substr_len) == 0 ||
-        strncmp(SUBSTITUION_NAMESPACE2, next_opening_brace, substitution_substr_len) == 0)
-      {
-        replacement = node_namespace;
-      } else {
-        replacement = rcutils_string_map_getn(
-          substitutions,
-          // compare {substitution}
-          //          ^ until    ^
-          next_opening_brace + 1, substitution_substr_len - 2);
-        if (!replacement) {
-          // in this case, it is neither node name nor ns nor in the substitutions map, so error
-          *output_topic_name = NULL;
-          char * unmatched_substitution =
-            rcutils_strndup(next_opening_brace, substitution_substr_len, allocator);
-          if (unmatched_substitution) {
-            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-              "unknown substitution: %s", unmatched_substitution);
-          } else {
-            RCUTILS_SAFE_FWRITE_TO_STDERR("failed to allocate memory for unmatched substitution\n");
-          }
-          allocator.deallocate(unmatched_substitution, allocator.state);
-          allocator.deallocate(local_output, allocator.state);
-          return RCL_RET_UNKNOWN_SUBSTITUTION;
-        }
-      }
-      // at this point replacement will be set or an error would have returned out
-      // do the replacement
-      char * next_substitution =
-        rcutils_strndup(next_opening_brace, substitution_substr_len, allocator);
-      if (!next_substitution) {
-        *output_topic_name = NULL;
-        RCL_SET_ERROR_MSG("failed to allocate memory for substitution");
-        allocator.deallocate(local_output, allocator.state);
-        return RCL_RET_BAD_ALLOC;
-      }
-      char * original_local_output = local_output;
-      local_output = rcutils_repl_str(current_output, next_substitution, replacement, &allocator);
-      allocator.deallocate(next_substitution, allocator.state);  // free no matter what
-      allocator.deallocate(original_local_output, allocator.state);  // free no matter what
-      if (!local_output) {
-        *output_topic_name = NULL;
-        RCL_SET_ERROR_MSG("failed to allocate memory for expanded topic");
-        return RCL_RET_BAD_ALLOC;
-      }
-      current_output = local_output;
-      // loop until all substitutions are replaced
-    }  // while
-  }
-  // finally make the name absolute if it isn't already
-  if (
-    (local_output && local_output[0] != '/') ||
-    (!local_output && input_topic_name[0] != '/'))
-  {
-    char * original_local_output = local_output;
-    // special case where node_namespace is just '/'
-    // then no additional separating '/' is needed
-    const char * fmt = (strlen(node_namespace) == 1) ? "%s%s" : "%s/%s";
-    local_output = rcutils_format_string(
-      allocator, fmt, node_namespace, (local_output) ? local_output : input_topic_name);
-    if (original_local_output) {
-      allocator.deallocate(original_local_output, allocator.state);
-    }
-    if (!local_output) {
-      *output_topic_name = NULL;
-      RCL_SET_ERROR_MSG("failed to allocate memory for output topic");
-      return RCL_RET_BAD_ALLOC;
-    }
+  // a '~' topic expands under the node, everything else relative gains the
+  // namespace; special case where node_namespace is just '/', then no
+  // additional separating '/' is needed
+  const size_t node_namespace_len = strlen(node_namespace);
+  const bool namespace_is_root = (1 == node_namespace_len);
+  size_t prefix_len = 0;
+  if (has_a_namespace_tilde) {
+    prefix_len = node_namespace_len + (namespace_is_root ? 0 : 1) + strlen(node_name);
+  } else if ('/' != first_char) {
+    prefix_len = node_namespace_len + (namespace_is_root ? 0 : 1);
   }
-  // if the original input_topic_name has not yet be copied into new memory, strdup it now
+  char * local_output =
+    allocator.allocate(prefix_len + body_len + 1, allocator.state);
   if (!local_output) {
-    local_output = rcutils_strdup(input_topic_name, allocator);
-    if (!local_output) {
-      *output_topic_name = NULL;
-      RCL_SET_ERROR_MSG("failed to allocate memory for output topic");
-      return RCL_RET_BAD_ALLOC;
-    }
+    *output_topic_name = NULL;
+    RCL_SET_ERROR_MSG("failed to allocate memory for output topic");
+    return RCL_RET_BAD_ALLOC;
+  }
+  // emit pass
+  ret = _rcl_expand_topic_name_emit(
+    local_output, body, has_a_namespace_tilde, prefix_len,
+    node_name, node_namespace, substitutions);
+  if (ret != RCL_RET_OK) {
+    *output_topic_name = NULL;
+    allocator.deallocate(local_output, allocator.state);
+    return ret;
   }
   // finally store the result in the out pointer and return
   *output_topic_name = local_output;
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_expand_topic_name_with_buffer(
+  const char * input_topic_name,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions,
+  char * buffer,
+  size_t buffer_size,
+  size_t * required_size)
+{
+  // check arguments that could be null
+  RCL_CHECK_ARGUMENT_FOR_NULL(input_topic_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_namespace, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(substitutions, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(buffer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(required_size, RCL_RET_INVALID_ARGUMENT);
+  *required_size = 0;
+  rcl_ret_t ret =
+    _rcl_expand_topic_name_validate_input(input_topic_name, node_name, node_namespace);
+  if (ret != RCL_RET_OK) {
+    return ret;
+  }
+  // no allocating fast path here; the generic measure pass handles absolute
+  // names without substitutions just as well and stays allocation free
+  bool has_a_namespace_tilde = input_topic_name[0] == '~';
+  const char * body = has_a_namespace_tilde ? (input_topic_name + 1) : input_topic_name;
+  // measure pass
+  size_t body_len = 0;
+  char first_char = '\0';
+  ret = _rcl_expand_topic_name_measure(
+    body, node_name, node_namespace, substitutions, &body_len, &first_char);
+  if (ret != RCL_RET_OK) {
+    return ret;
+  }
+  const size_t node_namespace_len = strlen(node_namespace);
+  const bool namespace_is_root = (1 == node_namespace_len);
+  size_t prefix_len = 0;
+  if (has_a_namespace_tilde) {
+    prefix_len = node_namespace_len + (namespace_is_root ? 0 : 1) + strlen(node_name);
+  } else if ('/' != first_char) {
+    prefix_len = node_namespace_len + (namespace_is_root ? 0 : 1);
+  }
+  *required_size = prefix_len + body_len + 1;
+  if (buffer_size < *required_size) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "buffer of %zu bytes is too small for expanded topic name of %zu bytes",
+      buffer_size, *required_size);
+    return RCL_RET_ERROR;
+  }
+  // emit pass
+  return _rcl_expand_topic_name_emit(
+    buffer, body, has_a_namespace_tilde, prefix_len,
+    node_name, node_namespace, substitutions);
+}
+
 rcl_ret_t
 rcl_get_default_topic_name_substitutions(rcutils_string_map_t * string_map)
 {
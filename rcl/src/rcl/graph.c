@@ -19,8 +19,14 @@ extern "C"
 
 #include "rcl/graph.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "rcl/error_handling.h"
+#include "rcl/wait.h"
 #include "rcutils/allocator.h"
+#include "rcutils/strdup.h"
+#include "rcutils/time.h"
 #include "rcutils/types.h"
 #include "rmw/get_node_info_and_types.h"
 #include "rmw/get_service_names_and_types.h"
@@ -214,6 +220,162 @@ rcl_names_and_types_fini(rcl_names_and_types_t * topic_names_and_types)
   return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
 }
 
+// Compare two populated rcl_names_and_types_t structs for equal content.
+static bool
+__names_and_types_equal(
+  const rcl_names_and_types_t * lhs,
+  const rcl_names_and_types_t * rhs)
+{
+  if (lhs->names.size != rhs->names.size) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs->names.size; ++i) {
+    if (0 != strcmp(lhs->names.data[i], rhs->names.data[i])) {
+      return false;
+    }
+    if (lhs->types[i].size != rhs->types[i].size) {
+      return false;
+    }
+    for (size_t j = 0; j < lhs->types[i].size; ++j) {
+      if (0 != strcmp(lhs->types[i].data[j], rhs->types[i].data[j])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+rcl_ret_t
+rcl_names_and_types_copy(
+  const rcl_names_and_types_t * src,
+  rcl_names_and_types_t * dst,
+  rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(src, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(dst, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR(allocator, return RCL_RET_INVALID_ARGUMENT);
+  bool dst_is_populated = NULL != dst->names.data || NULL != dst->types;
+  if (dst_is_populated && __names_and_types_equal(src, dst)) {
+    // Steady state: the destination already holds this content, so its
+    // storage (and every pointer into it) is left untouched.
+    return RCL_RET_OK;
+  }
+  if (dst_is_populated) {
+    rcl_ret_t ret = rcl_names_and_types_fini(dst);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  rcl_ret_t ret = rcl_names_and_types_init(dst, src->names.size, allocator);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  for (size_t i = 0; i < src->names.size; ++i) {
+    dst->names.data[i] = rcutils_strdup(src->names.data[i], *allocator);
+    if (NULL == dst->names.data[i]) {
+      goto fail;
+    }
+    rcutils_ret_t rcutils_ret =
+      rcutils_string_array_init(&dst->types[i], src->types[i].size, allocator);
+    if (RCUTILS_RET_OK != rcutils_ret) {
+      goto fail;
+    }
+    for (size_t j = 0; j < src->types[i].size; ++j) {
+      dst->types[i].data[j] = rcutils_strdup(src->types[i].data[j], *allocator);
+      if (NULL == dst->types[i].data[j]) {
+        goto fail;
+      }
+    }
+  }
+  return RCL_RET_OK;
+fail:
+  RCL_SET_ERROR_MSG("allocating memory failed");
+  if (RCL_RET_OK != rcl_names_and_types_fini(dst)) {
+    rcl_reset_error();
+    RCL_SET_ERROR_MSG("allocating memory failed, failed also to fini the destination");
+  }
+  return RCL_RET_BAD_ALLOC;
+}
+
+// A name and its set of types, moved as one unit while sorting.
+typedef struct rcl_names_and_types_pair_t
+{
+  char * name;
+  rcutils_string_array_t types;
+} rcl_names_and_types_pair_t;
+
+// Implementation only
+static int
+__names_and_types_pair_cmp(const void * lhs, const void * rhs)
+{
+  return strcmp(
+    ((const rcl_names_and_types_pair_t *)lhs)->name,
+    ((const rcl_names_and_types_pair_t *)rhs)->name);
+}
+
+rcl_ret_t
+rcl_names_and_types_sort(rcl_names_and_types_t * names_and_types)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(names_and_types, RCL_RET_INVALID_ARGUMENT);
+  size_t size = names_and_types->names.size;
+  if (size < 2) {
+    return RCL_RET_OK;
+  }
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    names_and_types->names.data, "names_and_types is not populated",
+    return RCL_RET_INVALID_ARGUMENT);
+  // The names and the parallel types arrays have to move in tandem, so sort
+  // them as pairs through a scratch array rather than in place.
+  rcutils_allocator_t allocator = names_and_types->names.allocator;
+  rcl_names_and_types_pair_t * pairs = (rcl_names_and_types_pair_t *)allocator.allocate(
+    size * sizeof(rcl_names_and_types_pair_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    pairs, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  for (size_t i = 0; i < size; ++i) {
+    pairs[i].name = names_and_types->names.data[i];
+    pairs[i].types = names_and_types->types[i];
+  }
+  qsort(pairs, size, sizeof(rcl_names_and_types_pair_t), __names_and_types_pair_cmp);
+  for (size_t i = 0; i < size; ++i) {
+    names_and_types->names.data[i] = pairs[i].name;
+    names_and_types->types[i] = pairs[i].types;
+  }
+  allocator.deallocate(pairs, allocator.state);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_names_and_types_find(
+  const rcl_names_and_types_t * names_and_types,
+  const char * name,
+  bool * found,
+  size_t * index)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(names_and_types, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(found, RCL_RET_INVALID_ARGUMENT);
+  *found = false;
+  size_t low = 0;
+  size_t high = names_and_types->names.size;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    int cmp = strcmp(names_and_types->names.data[mid], name);
+    if (0 == cmp) {
+      *found = true;
+      if (NULL != index) {
+        *index = mid;
+      }
+      return RCL_RET_OK;
+    }
+    if (cmp < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_get_node_names(
   const rcl_node_t * node,
@@ -288,6 +450,42 @@ rcl_count_subscribers(
   return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
 }
 
+rcl_ret_t
+rcl_count_entities_batch(
+  const rcl_node_t * node,
+  const char * const * topic_names,
+  size_t topics_size,
+  size_t * publisher_counts,
+  size_t * subscriber_counts)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  const rcl_node_options_t * node_options = rcl_node_get_options(node);
+  if (!node_options) {
+    return RCL_RET_NODE_INVALID;  // shouldn't happen, but error is already set if so
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_names, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(publisher_counts, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscriber_counts, RCL_RET_INVALID_ARGUMENT);
+  rmw_node_t * rmw_node = rcl_node_get_rmw_handle(node);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    rmw_node, "failed to get the rmw handle of the node", return RCL_RET_ERROR);
+  for (size_t i = 0; i < topics_size; ++i) {
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      topic_names[i], "topic name in batch is null", return RCL_RET_INVALID_ARGUMENT);
+    rmw_ret_t rmw_ret = rmw_count_publishers(rmw_node, topic_names[i], &publisher_counts[i]);
+    if (RMW_RET_OK != rmw_ret) {
+      return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+    }
+    rmw_ret = rmw_count_subscribers(rmw_node, topic_names[i], &subscriber_counts[i]);
+    if (RMW_RET_OK != rmw_ret) {
+      return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+    }
+  }
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_service_server_is_available(
   const rcl_node_t * node,
@@ -311,6 +509,207 @@ rcl_service_server_is_available(
   return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
 }
 
+/// Check whether a graph condition holds; set by the predicate on each call.
+typedef rcl_ret_t (* rcl_graph_wait_predicate_t)(
+  const rcl_node_t * node,
+  const void * predicate_state,
+  bool * satisfied);
+
+// Shared wait loop behind rcl_client_wait_for_service() and the
+// wait-for-matched-endpoints helpers: check the predicate once up front, then
+// sleep on the graph guard condition and only re-check when the graph
+// actually changed, instead of the poll-and-sleep loops callers otherwise
+// write around the graph queries.
+static rcl_ret_t
+__rcl_wait_for_graph_predicate(
+  const rcl_node_t * node,
+  rcl_graph_wait_predicate_t predicate,
+  const void * predicate_state,
+  int64_t timeout)
+{
+  bool satisfied = false;
+  rcl_ret_t ret = predicate(node, predicate_state, &satisfied);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  if (satisfied) {
+    return RCL_RET_OK;
+  }
+  if (0 == timeout) {
+    return RCL_RET_TIMEOUT;
+  }
+  const rcl_guard_condition_t * graph_guard_condition =
+    rcl_node_get_graph_guard_condition(node);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    graph_guard_condition, "failed to get graph guard condition", return RCL_RET_ERROR);
+  rcutils_time_point_value_t deadline = 0;
+  if (timeout > 0) {
+    rcutils_ret_t rcutils_ret = rcutils_steady_time_now(&deadline);
+    if (RCUTILS_RET_OK != rcutils_ret) {
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    deadline += timeout;
+  }
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(
+    &wait_set, 0, 1, 0, 0, 0, 0, node->context, rcl_node_get_options(node)->allocator);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  while (true) {
+    ret = rcl_wait_set_clear(&wait_set);
+    if (RCL_RET_OK != ret) {
+      break;  // error already set
+    }
+    ret = rcl_wait_set_add_guard_condition(&wait_set, graph_guard_condition, NULL);
+    if (RCL_RET_OK != ret) {
+      break;  // error already set
+    }
+    int64_t wait_timeout = -1;
+    if (timeout > 0) {
+      rcutils_time_point_value_t now = 0;
+      rcutils_ret_t rcutils_ret = rcutils_steady_time_now(&now);
+      if (RCUTILS_RET_OK != rcutils_ret) {
+        RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+        ret = RCL_RET_ERROR;
+        break;
+      }
+      wait_timeout = deadline - now;
+      if (wait_timeout <= 0) {
+        ret = RCL_RET_TIMEOUT;
+        break;
+      }
+    }
+    ret = rcl_wait(&wait_set, wait_timeout);
+    if (RCL_RET_OK != ret) {
+      break;  // timed out, or error already set
+    }
+    // This wait observed the graph guard condition firing, so the cached
+    // graph snapshots of the context are stale; drop them before
+    // re-evaluating (see rcl_graph_cache_invalidate()).
+    ret = rcl_graph_cache_invalidate(node->context);
+    if (RCL_RET_OK != ret) {
+      break;  // error already set
+    }
+    // Only the caller's condition is re-checked; rmw scopes the query to one
+    // service or topic name, so unrelated graph changes cost one cheap check,
+    // not a full graph query.
+    ret = predicate(node, predicate_state, &satisfied);
+    if (RCL_RET_OK != ret) {
+      break;  // error already set
+    }
+    if (satisfied) {
+      break;
+    }
+  }
+  rcl_ret_t fini_ret = rcl_wait_set_fini(&wait_set);
+  if (RCL_RET_OK == ret && RCL_RET_OK != fini_ret) {
+    ret = fini_ret;  // error already set
+  }
+  return ret;
+}
+
+// Predicate for rcl_client_wait_for_service().
+static rcl_ret_t
+__rcl_server_is_available_predicate(
+  const rcl_node_t * node,
+  const void * predicate_state,
+  bool * satisfied)
+{
+  return rcl_service_server_is_available(
+    node, (const rcl_client_t *)predicate_state, satisfied);
+}
+
+rcl_ret_t
+rcl_client_wait_for_service(
+  const rcl_node_t * node,
+  const rcl_client_t * client,
+  int64_t timeout)
+{
+  return __rcl_wait_for_graph_predicate(
+    node, __rcl_server_is_available_predicate, client, timeout);
+}
+
+// State for the matched-endpoint-count predicates below.
+typedef struct rcl_graph_count_predicate_state_t
+{
+  const char * topic_name;
+  size_t count;
+} rcl_graph_count_predicate_state_t;
+
+// Predicate for rcl_publisher_wait_for_subscribers().
+static rcl_ret_t
+__rcl_subscriber_count_reached_predicate(
+  const rcl_node_t * node,
+  const void * predicate_state,
+  bool * satisfied)
+{
+  const rcl_graph_count_predicate_state_t * state = predicate_state;
+  size_t count = 0;
+  rcl_ret_t ret = rcl_count_subscribers(node, state->topic_name, &count);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  *satisfied = count >= state->count;
+  return RCL_RET_OK;
+}
+
+// Predicate for rcl_subscription_wait_for_publishers().
+static rcl_ret_t
+__rcl_publisher_count_reached_predicate(
+  const rcl_node_t * node,
+  const void * predicate_state,
+  bool * satisfied)
+{
+  const rcl_graph_count_predicate_state_t * state = predicate_state;
+  size_t count = 0;
+  rcl_ret_t ret = rcl_count_publishers(node, state->topic_name, &count);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  *satisfied = count >= state->count;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_publisher_wait_for_subscribers(
+  const rcl_node_t * node,
+  const rcl_publisher_t * publisher,
+  size_t count,
+  int64_t timeout)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  const char * topic_name = rcl_publisher_get_topic_name(publisher);
+  if (NULL == topic_name) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  rcl_graph_count_predicate_state_t state = {topic_name, count};
+  return __rcl_wait_for_graph_predicate(
+    node, __rcl_subscriber_count_reached_predicate, &state, timeout);
+}
+
+rcl_ret_t
+rcl_subscription_wait_for_publishers(
+  const rcl_node_t * node,
+  const rcl_subscription_t * subscription,
+  size_t count,
+  int64_t timeout)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  const char * topic_name = rcl_subscription_get_topic_name(subscription);
+  if (NULL == topic_name) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  rcl_graph_count_predicate_state_t state = {topic_name, count};
+  return __rcl_wait_for_graph_predicate(
+    node, __rcl_publisher_count_reached_predicate, &state, timeout);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,741 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./graph_cache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "rcl/error_handling.h"
+#include "rcl/node.h"
+#include "rcutils/logging_macros.h"
+#include "rcutils/strdup.h"
+#include "rmw/names_and_types.h"
+
+#include "./context_impl.h"
+
+// Get the cache of the node's context, lazily allocating it on first use.
+static rcl_ret_t
+__get_graph_cache(rcl_context_t * context, rcl_graph_cache_t ** graph_cache)
+{
+  if (NULL == context->impl->graph_cache) {
+    rcl_allocator_t * allocator = &context->impl->allocator;
+    rcl_graph_cache_t * new_cache = (rcl_graph_cache_t *)allocator->zero_allocate(
+      1, sizeof(rcl_graph_cache_t), allocator->state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      new_cache, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    new_cache->topic_names_and_types = rmw_get_zero_initialized_names_and_types();
+    new_cache->previous_topic_names_and_types = rmw_get_zero_initialized_names_and_types();
+    new_cache->node_names = rcutils_get_zero_initialized_string_array();
+    new_cache->node_namespaces = rcutils_get_zero_initialized_string_array();
+    new_cache->allocator = *allocator;
+    context->impl->graph_cache = new_cache;
+  }
+  *graph_cache = context->impl->graph_cache;
+  return RCL_RET_OK;
+}
+
+// One segment of a namespace trie.  Children are kept as a singly linked
+// list; namespaces are shallow and fan out at the robot level, so a list
+// walk per segment beats the bookkeeping of a child table.  `entries` are
+// indices into the snapshot the trie was built from, for the names whose
+// path ends exactly at this segment.
+struct rcl_graph_trie_node_t
+{
+  char * segment;
+  struct rcl_graph_trie_node_t * children;
+  struct rcl_graph_trie_node_t * next_sibling;
+  size_t * entries;
+  size_t entries_size;
+  size_t entries_capacity;
+  /// Entries here plus in all descendants; sizes query results up front.
+  size_t subtree_size;
+};
+
+static void
+__trie_fini(rcl_graph_trie_node_t * trie_node, rcl_allocator_t * allocator)
+{
+  if (NULL == trie_node) {
+    return;
+  }
+  rcl_graph_trie_node_t * child = trie_node->children;
+  while (NULL != child) {
+    rcl_graph_trie_node_t * next = child->next_sibling;
+    __trie_fini(child, allocator);
+    child = next;
+  }
+  allocator->deallocate(trie_node->segment, allocator->state);
+  allocator->deallocate(trie_node->entries, allocator->state);
+  allocator->deallocate(trie_node, allocator->state);
+}
+
+// Find the child of `parent` labeled with the `length` first characters of
+// `segment`, creating it if asked to.
+static rcl_ret_t
+__trie_child(
+  rcl_graph_trie_node_t * parent,
+  const char * segment, size_t length,
+  rcl_allocator_t * allocator,
+  bool create,
+  rcl_graph_trie_node_t ** child)
+{
+  *child = NULL;
+  rcl_graph_trie_node_t * candidate = parent->children;
+  while (NULL != candidate) {
+    if (0 == strncmp(candidate->segment, segment, length) &&
+      '\0' == candidate->segment[length])
+    {
+      *child = candidate;
+      return RCL_RET_OK;
+    }
+    candidate = candidate->next_sibling;
+  }
+  if (!create) {
+    return RCL_RET_OK;
+  }
+  rcl_graph_trie_node_t * new_child = (rcl_graph_trie_node_t *)allocator->zero_allocate(
+    1, sizeof(rcl_graph_trie_node_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(new_child, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  new_child->segment = (char *)allocator->allocate(length + 1, allocator->state);
+  if (NULL == new_child->segment) {
+    allocator->deallocate(new_child, allocator->state);
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  memcpy(new_child->segment, segment, length);
+  new_child->segment[length] = '\0';
+  new_child->next_sibling = parent->children;
+  parent->children = new_child;
+  *child = new_child;
+  return RCL_RET_OK;
+}
+
+// Insert snapshot entry `index` under the slash separated `path`.
+static rcl_ret_t
+__trie_insert(
+  rcl_graph_trie_node_t * root,
+  const char * path,
+  size_t index,
+  rcl_allocator_t * allocator)
+{
+  rcl_graph_trie_node_t * trie_node = root;
+  ++root->subtree_size;
+  const char * segment = path;
+  while ('\0' != *segment) {
+    while ('/' == *segment) {
+      ++segment;  // skip the separator; also tolerates repeated slashes
+    }
+    size_t length = 0;
+    while ('\0' != segment[length] && '/' != segment[length]) {
+      ++length;
+    }
+    if (0 == length) {
+      break;
+    }
+    rcl_ret_t ret = __trie_child(trie_node, segment, length, allocator, true, &trie_node);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    ++trie_node->subtree_size;
+    segment += length;
+  }
+  if (trie_node->entries_size == trie_node->entries_capacity) {
+    size_t new_capacity = 0 == trie_node->entries_capacity ?
+      4 : 2 * trie_node->entries_capacity;
+    size_t * new_entries = (size_t *)allocator->reallocate(
+      trie_node->entries, new_capacity * sizeof(size_t), allocator->state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      new_entries, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    trie_node->entries = new_entries;
+    trie_node->entries_capacity = new_capacity;
+  }
+  trie_node->entries[trie_node->entries_size++] = index;
+  return RCL_RET_OK;
+}
+
+// Walk the trie down the slash separated `path`; NULL if no name lives
+// under it.  Matching is per segment, so "/fleet/robot7" does not match
+// names under "/fleet/robot77".
+static rcl_graph_trie_node_t *
+__trie_find(rcl_graph_trie_node_t * root, const char * path)
+{
+  rcl_graph_trie_node_t * trie_node = root;
+  const char * segment = path;
+  while (NULL != trie_node && '\0' != *segment) {
+    while ('/' == *segment) {
+      ++segment;
+    }
+    size_t length = 0;
+    while ('\0' != segment[length] && '/' != segment[length]) {
+      ++length;
+    }
+    if (0 == length) {
+      break;
+    }
+    rcl_graph_trie_node_t * child = NULL;
+    if (RCL_RET_OK != __trie_child(trie_node, segment, length, NULL, false, &child)) {
+      return NULL;
+    }
+    trie_node = child;
+    segment += length;
+  }
+  return trie_node;
+}
+
+// Append every entry of the subtree to `out`, advancing `*next`.
+static void
+__trie_collect(const rcl_graph_trie_node_t * trie_node, size_t * out, size_t * next)
+{
+  for (size_t i = 0; i < trie_node->entries_size; ++i) {
+    out[(*next)++] = trie_node->entries[i];
+  }
+  const rcl_graph_trie_node_t * child = trie_node->children;
+  while (NULL != child) {
+    __trie_collect(child, out, next);
+    child = child->next_sibling;
+  }
+}
+
+// Build a trie over `paths`, inserting each index under its path.
+static rcl_ret_t
+__trie_build(
+  const rcutils_string_array_t * paths,
+  rcl_allocator_t * allocator,
+  rcl_graph_trie_node_t ** root)
+{
+  rcl_graph_trie_node_t * new_root = (rcl_graph_trie_node_t *)allocator->zero_allocate(
+    1, sizeof(rcl_graph_trie_node_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(new_root, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  for (size_t i = 0; i < paths->size; ++i) {
+    rcl_ret_t ret = __trie_insert(new_root, paths->data[i], i, allocator);
+    if (RCL_RET_OK != ret) {
+      __trie_fini(new_root, allocator);
+      return ret;  // error already set
+    }
+  }
+  *root = new_root;
+  return RCL_RET_OK;
+}
+
+// Drop the retired topic snapshot kept for diffing.
+static void
+__graph_cache_drop_previous_topics(rcl_graph_cache_t * graph_cache)
+{
+  if (graph_cache->previous_topics_valid) {
+    if (RCL_RET_OK != rcl_names_and_types_fini(&graph_cache->previous_topic_names_and_types)) {
+      RCUTILS_LOG_ERROR_NAMED(
+        ROS_PACKAGE_NAME, "Failed to fini retired topic names and types");
+      rcl_reset_error();
+    }
+    graph_cache->previous_topic_names_and_types = rmw_get_zero_initialized_names_and_types();
+    graph_cache->previous_topics_valid = false;
+  }
+}
+
+// Drop the tries; they index into the snapshots and go with them.
+static void
+__graph_cache_drop_node_trie(rcl_graph_cache_t * graph_cache)
+{
+  __trie_fini(graph_cache->node_trie, &graph_cache->allocator);
+  graph_cache->node_trie = NULL;
+}
+
+static void
+__graph_cache_drop_topic_trie(rcl_graph_cache_t * graph_cache)
+{
+  __trie_fini(graph_cache->topic_trie, &graph_cache->allocator);
+  graph_cache->topic_trie = NULL;
+}
+
+// Drop the cached snapshots; the next query repopulates them.
+static void
+__graph_cache_drop_snapshots(rcl_graph_cache_t * graph_cache)
+{
+  __graph_cache_drop_node_trie(graph_cache);
+  __graph_cache_drop_topic_trie(graph_cache);
+  if (graph_cache->topics_valid) {
+    if (RCL_RET_OK != rcl_names_and_types_fini(&graph_cache->topic_names_and_types)) {
+      RCUTILS_LOG_ERROR_NAMED(
+        ROS_PACKAGE_NAME, "Failed to fini cached topic names and types");
+      rcl_reset_error();
+    }
+    graph_cache->topic_names_and_types = rmw_get_zero_initialized_names_and_types();
+    graph_cache->topics_valid = false;
+  }
+  __graph_cache_drop_previous_topics(graph_cache);
+  if (graph_cache->node_names_valid) {
+    if (RCUTILS_RET_OK != rcutils_string_array_fini(&graph_cache->node_names)) {
+      RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to fini cached node names");
+    }
+    if (RCUTILS_RET_OK != rcutils_string_array_fini(&graph_cache->node_namespaces)) {
+      RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to fini cached node namespaces");
+    }
+    graph_cache->node_names = rcutils_get_zero_initialized_string_array();
+    graph_cache->node_namespaces = rcutils_get_zero_initialized_string_array();
+    graph_cache->node_names_valid = false;
+  }
+}
+
+rcl_ret_t
+rcl_graph_cache_get_topic_names_and_types(
+  const rcl_node_t * node,
+  const rcl_names_and_types_t ** topic_names_and_types)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_names_and_types, RCL_RET_INVALID_ARGUMENT);
+  rcl_graph_cache_t * graph_cache = NULL;
+  rcl_ret_t ret = __get_graph_cache(node->context, &graph_cache);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  if (!graph_cache->topics_valid) {
+    ret = rcl_get_topic_names_and_types(
+      node, &graph_cache->allocator, false, &graph_cache->topic_names_and_types);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    graph_cache->topics_valid = true;
+  }
+  *topic_names_and_types = &graph_cache->topic_names_and_types;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_graph_cache_get_node_names(
+  const rcl_node_t * node,
+  const rcutils_string_array_t ** node_names,
+  const rcutils_string_array_t ** node_namespaces)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_names, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_namespaces, RCL_RET_INVALID_ARGUMENT);
+  rcl_graph_cache_t * graph_cache = NULL;
+  rcl_ret_t ret = __get_graph_cache(node->context, &graph_cache);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  if (!graph_cache->node_names_valid) {
+    ret = rcl_get_node_names(
+      node, graph_cache->allocator, &graph_cache->node_names, &graph_cache->node_namespaces);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    graph_cache->node_names_valid = true;
+  }
+  *node_names = &graph_cache->node_names;
+  *node_namespaces = &graph_cache->node_namespaces;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_graph_cache_invalidate(rcl_context_t * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  rcl_graph_cache_t * graph_cache = context->impl->graph_cache;
+  if (NULL == graph_cache) {
+    return RCL_RET_OK;  // Nothing has been cached yet.
+  }
+  __graph_cache_drop_node_trie(graph_cache);
+  __graph_cache_drop_topic_trie(graph_cache);
+  if (graph_cache->topics_valid) {
+    // Retire the current topic snapshot rather than freeing it, so one
+    // generation of rcl_graph_get_changes_since() callers can still diff.
+    __graph_cache_drop_previous_topics(graph_cache);
+    graph_cache->previous_topic_names_and_types = graph_cache->topic_names_and_types;
+    graph_cache->previous_topics_valid = true;
+    graph_cache->previous_epoch = graph_cache->epoch;
+    graph_cache->topic_names_and_types = rmw_get_zero_initialized_names_and_types();
+    graph_cache->topics_valid = false;
+  }
+  if (graph_cache->node_names_valid) {
+    if (RCUTILS_RET_OK != rcutils_string_array_fini(&graph_cache->node_names)) {
+      RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to fini cached node names");
+    }
+    if (RCUTILS_RET_OK != rcutils_string_array_fini(&graph_cache->node_namespaces)) {
+      RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to fini cached node namespaces");
+    }
+    graph_cache->node_names = rcutils_get_zero_initialized_string_array();
+    graph_cache->node_namespaces = rcutils_get_zero_initialized_string_array();
+    graph_cache->node_names_valid = false;
+  }
+  ++graph_cache->epoch;
+  return RCL_RET_OK;
+}
+
+static int
+__compare_name_ptrs(const void * lhs, const void * rhs)
+{
+  return strcmp(*(const char * const *)lhs, *(const char * const *)rhs);
+}
+
+// Allocate a sorted array of the name pointers of `names`, or NULL if empty.
+static rcl_ret_t
+__sorted_name_ptrs(
+  const rcutils_string_array_t * names,
+  rcl_allocator_t * allocator,
+  const char *** sorted_ptrs)
+{
+  *sorted_ptrs = NULL;
+  if (0 == names->size) {
+    return RCL_RET_OK;
+  }
+  const char ** ptrs = (const char **)allocator->allocate(
+    names->size * sizeof(const char *), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(ptrs, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  for (size_t i = 0; i < names->size; ++i) {
+    ptrs[i] = names->data[i];
+  }
+  qsort(ptrs, names->size, sizeof(const char *), __compare_name_ptrs);
+  *sorted_ptrs = ptrs;
+  return RCL_RET_OK;
+}
+
+// Copy into `out` every name of sorted `from` that sorted `not_in` lacks.
+static rcl_ret_t
+__copy_missing_names(
+  const char ** from, size_t from_size,
+  const char ** not_in, size_t not_in_size,
+  rcl_allocator_t * allocator,
+  rcutils_string_array_t * out)
+{
+  // First pass counts so the output array is sized exactly.
+  size_t count = 0;
+  size_t j = 0;
+  for (size_t i = 0; i < from_size; ++i) {
+    while (j < not_in_size && strcmp(not_in[j], from[i]) < 0) {
+      ++j;
+    }
+    if (j >= not_in_size || 0 != strcmp(not_in[j], from[i])) {
+      ++count;
+    }
+  }
+  if (0 == count) {
+    return RCL_RET_OK;
+  }
+  rcutils_ret_t rcutils_ret = rcutils_string_array_init(out, count, allocator);
+  if (RCUTILS_RET_OK != rcutils_ret) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    return RCUTILS_RET_BAD_ALLOC == rcutils_ret ? RCL_RET_BAD_ALLOC : RCL_RET_ERROR;
+  }
+  size_t next = 0;
+  j = 0;
+  for (size_t i = 0; i < from_size; ++i) {
+    while (j < not_in_size && strcmp(not_in[j], from[i]) < 0) {
+      ++j;
+    }
+    if (j >= not_in_size || 0 != strcmp(not_in[j], from[i])) {
+      out->data[next] = rcutils_strdup(from[i], *allocator);
+      if (NULL == out->data[next]) {
+        RCL_SET_ERROR_MSG("allocating memory failed");
+        return RCL_RET_BAD_ALLOC;
+      }
+      ++next;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_graph_diff_t
+rcl_get_zero_initialized_graph_diff(void)
+{
+  rcl_graph_diff_t diff;
+  diff.added_topics = rcutils_get_zero_initialized_string_array();
+  diff.removed_topics = rcutils_get_zero_initialized_string_array();
+  diff.epoch = 0;
+  diff.is_resync = false;
+  return diff;
+}
+
+rcl_ret_t
+rcl_graph_diff_fini(rcl_graph_diff_t * diff)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(diff, RCL_RET_INVALID_ARGUMENT);
+  rcutils_ret_t rcutils_ret = rcutils_string_array_fini(&diff->added_topics);
+  if (RCUTILS_RET_OK != rcutils_ret) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    return RCL_RET_ERROR;
+  }
+  rcutils_ret = rcutils_string_array_fini(&diff->removed_topics);
+  if (RCUTILS_RET_OK != rcutils_ret) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    return RCL_RET_ERROR;
+  }
+  diff->epoch = 0;
+  diff->is_resync = false;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_graph_get_changes_since(
+  const rcl_node_t * node,
+  uint64_t epoch,
+  rcl_graph_diff_t * diff)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(diff, RCL_RET_INVALID_ARGUMENT);
+  // Make sure the current snapshot is populated; this also creates the cache.
+  const rcl_names_and_types_t * current = NULL;
+  rcl_ret_t ret = rcl_graph_cache_get_topic_names_and_types(node, &current);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  rcl_graph_cache_t * graph_cache = node->context->impl->graph_cache;
+  diff->added_topics = rcutils_get_zero_initialized_string_array();
+  diff->removed_topics = rcutils_get_zero_initialized_string_array();
+  diff->epoch = graph_cache->epoch;
+  diff->is_resync = false;
+  if (epoch == graph_cache->epoch) {
+    return RCL_RET_OK;  // The caller is already current.
+  }
+  rcl_allocator_t * allocator = &graph_cache->allocator;
+  if (!graph_cache->previous_topics_valid || epoch != graph_cache->previous_epoch) {
+    // No baseline for the caller's epoch; hand back the complete topic list.
+    diff->is_resync = true;
+    if (0 == current->names.size) {
+      return RCL_RET_OK;
+    }
+    rcutils_ret_t rcutils_ret = rcutils_string_array_init(
+      &diff->added_topics, current->names.size, allocator);
+    if (RCUTILS_RET_OK != rcutils_ret) {
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCUTILS_RET_BAD_ALLOC == rcutils_ret ? RCL_RET_BAD_ALLOC : RCL_RET_ERROR;
+    }
+    for (size_t i = 0; i < current->names.size; ++i) {
+      diff->added_topics.data[i] = rcutils_strdup(current->names.data[i], *allocator);
+      if (NULL == diff->added_topics.data[i]) {
+        RCL_SET_ERROR_MSG("allocating memory failed");
+        if (RCL_RET_OK != rcl_graph_diff_fini(diff)) {
+          rcl_reset_error();
+          RCL_SET_ERROR_MSG("allocating memory failed, failed also to fini the diff");
+        }
+        return RCL_RET_BAD_ALLOC;
+      }
+    }
+    return RCL_RET_OK;
+  }
+  const rcutils_string_array_t * previous_names =
+    &graph_cache->previous_topic_names_and_types.names;
+  const char ** sorted_current = NULL;
+  const char ** sorted_previous = NULL;
+  ret = __sorted_name_ptrs(&current->names, allocator, &sorted_current);
+  if (RCL_RET_OK == ret) {
+    ret = __sorted_name_ptrs(previous_names, allocator, &sorted_previous);
+  }
+  if (RCL_RET_OK == ret) {
+    ret = __copy_missing_names(
+      sorted_current, current->names.size,
+      sorted_previous, previous_names->size,
+      allocator, &diff->added_topics);
+  }
+  if (RCL_RET_OK == ret) {
+    ret = __copy_missing_names(
+      sorted_previous, previous_names->size,
+      sorted_current, current->names.size,
+      allocator, &diff->removed_topics);
+  }
+  if (NULL != sorted_current) {
+    allocator->deallocate((void *)sorted_current, allocator->state);
+  }
+  if (NULL != sorted_previous) {
+    allocator->deallocate((void *)sorted_previous, allocator->state);
+  }
+  if (RCL_RET_OK != ret) {
+    if (RCL_RET_OK != rcl_graph_diff_fini(diff)) {
+      rcl_reset_error();
+      RCL_SET_ERROR_MSG("computing the graph diff failed, failed also to fini the diff");
+    }
+    return ret;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_get_nodes_in_namespace(
+  const rcl_node_t * node,
+  const char * namespace_,
+  rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(namespace_, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_names, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_namespaces, RCL_RET_INVALID_ARGUMENT);
+  if ('/' != namespace_[0]) {
+    RCL_SET_ERROR_MSG("namespace is not absolute; it must start with a '/'");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // Make sure the snapshot the trie indexes into is populated; this also
+  // creates the cache.
+  const rcutils_string_array_t * cached_names = NULL;
+  const rcutils_string_array_t * cached_namespaces = NULL;
+  rcl_ret_t ret = rcl_graph_cache_get_node_names(node, &cached_names, &cached_namespaces);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  rcl_graph_cache_t * graph_cache = node->context->impl->graph_cache;
+  rcl_allocator_t * allocator = &graph_cache->allocator;
+  if (NULL == graph_cache->node_trie) {
+    ret = __trie_build(cached_namespaces, allocator, &graph_cache->node_trie);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  const rcl_graph_trie_node_t * subtree = __trie_find(graph_cache->node_trie, namespace_);
+  if (NULL == subtree || 0 == subtree->subtree_size) {
+    *node_names = rcutils_get_zero_initialized_string_array();
+    *node_namespaces = rcutils_get_zero_initialized_string_array();
+    return RCL_RET_OK;
+  }
+  size_t * indices = (size_t *)allocator->allocate(
+    subtree->subtree_size * sizeof(size_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(indices, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  size_t count = 0;
+  __trie_collect(subtree, indices, &count);
+  rcutils_ret_t rcutils_ret = rcutils_string_array_init(node_names, count, allocator);
+  if (RCUTILS_RET_OK == rcutils_ret) {
+    rcutils_ret = rcutils_string_array_init(node_namespaces, count, allocator);
+  }
+  if (RCUTILS_RET_OK != rcutils_ret) {
+    allocator->deallocate(indices, allocator->state);
+    if (RCUTILS_RET_OK != rcutils_string_array_fini(node_names)) {
+      RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to fini the node names output");
+    }
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    return RCUTILS_RET_BAD_ALLOC == rcutils_ret ? RCL_RET_BAD_ALLOC : RCL_RET_ERROR;
+  }
+  ret = RCL_RET_OK;
+  for (size_t i = 0; RCL_RET_OK == ret && i < count; ++i) {
+    node_names->data[i] = rcutils_strdup(cached_names->data[indices[i]], *allocator);
+    node_namespaces->data[i] = rcutils_strdup(cached_namespaces->data[indices[i]], *allocator);
+    if (NULL == node_names->data[i] || NULL == node_namespaces->data[i]) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      ret = RCL_RET_BAD_ALLOC;
+    }
+  }
+  allocator->deallocate(indices, allocator->state);
+  if (RCL_RET_OK != ret) {
+    if (RCUTILS_RET_OK != rcutils_string_array_fini(node_names) ||
+      RCUTILS_RET_OK != rcutils_string_array_fini(node_namespaces))
+    {
+      RCL_SET_ERROR_MSG("allocating memory failed, failed also to fini the outputs");
+    }
+  }
+  return ret;
+}
+
+rcl_ret_t
+rcl_get_topic_names_and_types_in_namespace(
+  const rcl_node_t * node,
+  const char * namespace_,
+  rcl_names_and_types_t * topic_names_and_types)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(namespace_, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_names_and_types, RCL_RET_INVALID_ARGUMENT);
+  if ('/' != namespace_[0]) {
+    RCL_SET_ERROR_MSG("namespace is not absolute; it must start with a '/'");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  const rcl_names_and_types_t * cached = NULL;
+  rcl_ret_t ret = rcl_graph_cache_get_topic_names_and_types(node, &cached);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  rcl_graph_cache_t * graph_cache = node->context->impl->graph_cache;
+  rcl_allocator_t * allocator = &graph_cache->allocator;
+  if (NULL == graph_cache->topic_trie) {
+    // A topic's path is its full name, the base name being the last segment,
+    // so a subtree query returns every topic under the namespace.
+    ret = __trie_build(&cached->names, allocator, &graph_cache->topic_trie);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  const rcl_graph_trie_node_t * subtree = __trie_find(graph_cache->topic_trie, namespace_);
+  if (NULL == subtree || 0 == subtree->subtree_size) {
+    return rcl_names_and_types_init(topic_names_and_types, 0, allocator);
+  }
+  size_t * indices = (size_t *)allocator->allocate(
+    subtree->subtree_size * sizeof(size_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(indices, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  size_t count = 0;
+  __trie_collect(subtree, indices, &count);
+  ret = rcl_names_and_types_init(topic_names_and_types, count, allocator);
+  if (RCL_RET_OK != ret) {
+    allocator->deallocate(indices, allocator->state);
+    return ret;  // error already set
+  }
+  for (size_t i = 0; RCL_RET_OK == ret && i < count; ++i) {
+    const size_t index = indices[i];
+    topic_names_and_types->names.data[i] = rcutils_strdup(cached->names.data[index], *allocator);
+    if (NULL == topic_names_and_types->names.data[i]) {
+      ret = RCL_RET_BAD_ALLOC;
+      break;
+    }
+    rcutils_ret_t rcutils_ret = rcutils_string_array_init(
+      &topic_names_and_types->types[i], cached->types[index].size, allocator);
+    if (RCUTILS_RET_OK != rcutils_ret) {
+      ret = RCL_RET_BAD_ALLOC;
+      break;
+    }
+    for (size_t j = 0; j < cached->types[index].size; ++j) {
+      topic_names_and_types->types[i].data[j] =
+        rcutils_strdup(cached->types[index].data[j], *allocator);
+      if (NULL == topic_names_and_types->types[i].data[j]) {
+        ret = RCL_RET_BAD_ALLOC;
+        break;
+      }
+    }
+  }
+  allocator->deallocate(indices, allocator->state);
+  if (RCL_RET_OK != ret) {
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    if (RCL_RET_OK != rcl_names_and_types_fini(topic_names_and_types)) {
+      rcl_reset_error();
+      RCL_SET_ERROR_MSG("allocating memory failed, failed also to fini the output");
+    }
+  }
+  return ret;
+}
+
+void
+rcl_graph_cache_fini(rcl_context_t * context)
+{
+  rcl_graph_cache_t * graph_cache = context->impl->graph_cache;
+  if (NULL == graph_cache) {
+    return;
+  }
+  __graph_cache_drop_snapshots(graph_cache);
+  graph_cache->allocator.deallocate(graph_cache, graph_cache->allocator.state);
+  context->impl->graph_cache = NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
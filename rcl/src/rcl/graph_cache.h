@@ -0,0 +1,80 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__GRAPH_CACHE_H_
+#define RCL__GRAPH_CACHE_H_
+
+#include <stdbool.h>
+
+#include "rcl/context.h"
+#include "rcl/graph.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+#include "rcutils/types/string_array.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// \internal One segment of the namespace tries; defined in graph_cache.c.
+typedef struct rcl_graph_trie_node_t rcl_graph_trie_node_t;
+
+/// \internal Per-context cache of graph query results.
+/**
+ * Snapshots are taken lazily on the first query after an invalidation and
+ * served from memory afterwards, so pollers do not round-trip into rmw
+ * discovery on every call.
+ * Invalidation is driven by the graph guard condition: whoever waits on
+ * rcl_node_get_graph_guard_condition() calls rcl_graph_cache_invalidate()
+ * when it fires.
+ *
+ * Like the graph query functions, the cache is not thread-safe.
+ */
+typedef struct rcl_graph_cache_t
+{
+  /// Cached result of the topic names and types query; valid if topics_valid.
+  rcl_names_and_types_t topic_names_and_types;
+  bool topics_valid;
+  /// Topic snapshot retired by the last invalidation; valid if
+  /// previous_topics_valid.  Kept so rcl_graph_get_changes_since() can diff
+  /// one generation back instead of forcing a full resync.
+  rcl_names_and_types_t previous_topic_names_and_types;
+  bool previous_topics_valid;
+  /// Epoch the previous topic snapshot belonged to.
+  uint64_t previous_epoch;
+  /// Cached result of the node names query; valid if node_names_valid.
+  rcutils_string_array_t node_names;
+  rcutils_string_array_t node_namespaces;
+  bool node_names_valid;
+  /// Namespace tries over the cached snapshots, built lazily on the first
+  /// hierarchical query; their entries index into the snapshot they were
+  /// built from, so each is dropped together with its snapshot.
+  rcl_graph_trie_node_t * node_trie;
+  rcl_graph_trie_node_t * topic_trie;
+  /// Incremented on every invalidation; identifies the current snapshot.
+  uint64_t epoch;
+  rcl_allocator_t allocator;
+} rcl_graph_cache_t;
+
+/// \internal Release all cache memory; called while cleaning up the context.
+RCL_LOCAL
+void
+rcl_graph_cache_fini(rcl_context_t * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__GRAPH_CACHE_H_
@@ -0,0 +1,143 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./graph_guard.h"
+
+#include "rcl/error_handling.h"
+#include "rcutils/logging_macros.h"
+
+#include "./context_impl.h"
+#include "./guard_condition_impl.h"
+
+rcl_ret_t
+rcl_graph_guard_acquire(
+  rcl_context_t * context,
+  const rmw_guard_condition_t * rmw_guard_condition,
+  rcl_guard_condition_t ** guard_condition)
+{
+  // Internal function; the caller (rcl_node_init) has validated the context.
+  rcl_allocator_t * allocator = &context->impl->allocator;
+  rcl_graph_guard_registry_t * registry = context->impl->graph_guard_registry;
+  if (NULL == registry) {
+    registry = (rcl_graph_guard_registry_t *)allocator->zero_allocate(
+      1, sizeof(rcl_graph_guard_registry_t), allocator->state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      registry, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    registry->guard_condition = rcl_get_zero_initialized_guard_condition();
+    registry->allocator = *allocator;
+    context->impl->graph_guard_registry = registry;
+  }
+  if (registry->num_donors == registry->donors_capacity) {
+    size_t new_capacity = (0 == registry->donors_capacity) ? 8 : 2 * registry->donors_capacity;
+    const rmw_guard_condition_t ** donors =
+      (const rmw_guard_condition_t **)registry->allocator.reallocate(
+      registry->donors, new_capacity * sizeof(const rmw_guard_condition_t *),
+      registry->allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      donors, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    registry->donors = donors;
+    registry->donors_capacity = new_capacity;
+  }
+  registry->donors[registry->num_donors++] = rmw_guard_condition;
+  if (NULL == registry->guard_condition.impl) {
+    // First node in the context; wrap its rmw condition as the shared one.
+    rcl_guard_condition_options_t options = rcl_guard_condition_get_default_options();
+    options.allocator = registry->allocator;
+    rcl_ret_t ret = rcl_guard_condition_init_from_rmw(
+      &registry->guard_condition, rmw_guard_condition, context, options);
+    if (RCL_RET_OK != ret) {
+      --registry->num_donors;
+      return ret;  // error already set
+    }
+  }
+  *guard_condition = &registry->guard_condition;
+  return RCL_RET_OK;
+}
+
+void
+rcl_graph_guard_release(
+  rcl_context_t * context,
+  const rmw_guard_condition_t * rmw_guard_condition)
+{
+  if (NULL == context || NULL == context->impl || NULL == rmw_guard_condition) {
+    return;
+  }
+  rcl_graph_guard_registry_t * registry = context->impl->graph_guard_registry;
+  if (NULL == registry) {
+    return;
+  }
+  size_t index = registry->num_donors;
+  for (size_t i = 0; i < registry->num_donors; ++i) {
+    if (registry->donors[i] == rmw_guard_condition) {
+      index = i;
+      break;
+    }
+  }
+  if (index == registry->num_donors) {
+    return;
+  }
+  registry->donors[index] = registry->donors[registry->num_donors - 1];
+  --(registry->num_donors);
+  if (NULL == registry->guard_condition.impl ||
+    registry->guard_condition.impl->rmw_handle != (rmw_guard_condition_t *)rmw_guard_condition)
+  {
+    return;
+  }
+  if (registry->num_donors > 0) {
+    // Re-home the shared condition onto a surviving node's rmw condition
+    // before the donor is destroyed along with its node.
+    registry->guard_condition.impl->rmw_handle =
+      (rmw_guard_condition_t *)registry->donors[0];
+  } else {
+    // Last node in the context; the shared condition goes with it.
+    if (RCL_RET_OK != rcl_guard_condition_fini(&registry->guard_condition)) {
+      RCUTILS_LOG_ERROR_NAMED(
+        ROS_PACKAGE_NAME, "Failed to fini shared graph guard condition");
+      rcl_reset_error();
+    }
+    registry->guard_condition = rcl_get_zero_initialized_guard_condition();
+  }
+}
+
+void
+rcl_graph_guard_fini(rcl_context_t * context)
+{
+  rcl_graph_guard_registry_t * registry = context->impl->graph_guard_registry;
+  if (NULL == registry) {
+    return;
+  }
+  if (NULL != registry->guard_condition.impl) {
+    // Normally the last node release finalizes the shared condition; this
+    // covers contexts cleaned up while nodes are still around.
+    if (RCL_RET_OK != rcl_guard_condition_fini(&registry->guard_condition)) {
+      RCUTILS_LOG_ERROR_NAMED(
+        ROS_PACKAGE_NAME, "Failed to fini shared graph guard condition");
+      rcl_reset_error();
+    }
+  }
+  if (NULL != registry->donors) {
+    registry->allocator.deallocate(registry->donors, registry->allocator.state);
+  }
+  registry->allocator.deallocate(registry, registry->allocator.state);
+  context->impl->graph_guard_registry = NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,88 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__GRAPH_GUARD_H_
+#define RCL__GRAPH_GUARD_H_
+
+#include "rcl/context.h"
+#include "rcl/guard_condition.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+#include "rmw/types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// \internal Per-context registry backing the shared graph guard condition.
+/**
+ * Every node in a context observes the same graph events, so
+ * rcl_node_get_graph_guard_condition() hands out one shared condition per
+ * context instead of wrapping each node's rmw graph guard condition
+ * separately; a wait set watching the graph through many nodes then holds
+ * one rmw condition rather than one per node.
+ *
+ * The shared condition wraps the rmw graph guard condition of one live node
+ * (the donor).  When the donor node is finalized the condition is re-homed
+ * onto another live node's rmw condition, and it is finalized with the last
+ * node.
+ *
+ * Like node initialization and finalization, the registry is not
+ * thread-safe.
+ */
+typedef struct rcl_graph_guard_registry_t
+{
+  /// The shared condition handed out to every node in the context; zero
+  /// initialized while no node is registered.
+  rcl_guard_condition_t guard_condition;
+  /// rmw graph guard conditions of the live nodes; one of them backs
+  /// guard_condition.
+  const rmw_guard_condition_t ** donors;
+  /// Number of entries in donors.
+  size_t num_donors;
+  /// Allocated capacity of donors.
+  size_t donors_capacity;
+  rcl_allocator_t allocator;
+} rcl_graph_guard_registry_t;
+
+/// \internal Register a node's rmw graph guard condition and get the shared
+/// condition, lazily creating the registry on first use.
+RCL_LOCAL
+rcl_ret_t
+rcl_graph_guard_acquire(
+  rcl_context_t * context,
+  const rmw_guard_condition_t * rmw_guard_condition,
+  rcl_guard_condition_t ** guard_condition);
+
+/// \internal Unregister a node's rmw graph guard condition, re-homing or
+/// finalizing the shared condition as needed.  Must be called before the
+/// node's rmw handle is destroyed.
+RCL_LOCAL
+void
+rcl_graph_guard_release(
+  rcl_context_t * context,
+  const rmw_guard_condition_t * rmw_guard_condition);
+
+/// \internal Release all registry memory; called while cleaning up the
+/// context.
+RCL_LOCAL
+void
+rcl_graph_guard_fini(rcl_context_t * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__GRAPH_GUARD_H_
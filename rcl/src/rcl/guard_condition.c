@@ -19,19 +19,16 @@ extern "C"
 
 #include "rcl/guard_condition.h"
 
+#include <string.h>
+
 #include "rcl/error_handling.h"
 #include "rcl/rcl.h"
+#include "rcutils/stdatomic_helper.h"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
 
 #include "./context_impl.h"
-
-typedef struct rcl_guard_condition_impl_t
-{
-  rmw_guard_condition_t * rmw_handle;
-  bool allocated_rmw_guard_condition;
-  rcl_guard_condition_options_t options;
-} rcl_guard_condition_impl_t;
+#include "./guard_condition_impl.h"
 
 rcl_guard_condition_t
 rcl_get_zero_initialized_guard_condition()
@@ -94,6 +91,8 @@ __rcl_guard_condition_init_from_rmw_impl(
   }
   // Copy options into impl.
   guard_condition->impl->options = options;
+  atomic_init(&guard_condition->impl->triggered, false);
+  atomic_init(&guard_condition->impl->payload, 0);
   return RCL_RET_OK;
 }
 
@@ -145,6 +144,7 @@ rcl_guard_condition_get_default_options()
   // !!! MAKE SURE THAT CHANGES TO THESE DEFAULTS ARE REFLECTED IN THE HEADER DOC STRING
   static rcl_guard_condition_options_t default_options;
   default_options.allocator = rcl_get_default_allocator();
+  default_options.edge_triggered = false;
   return default_options;
 }
 
@@ -155,6 +155,15 @@ rcl_trigger_guard_condition(rcl_guard_condition_t * guard_condition)
   if (!options) {
     return RCL_RET_INVALID_ARGUMENT;  // error already set
   }
+  if (options->edge_triggered) {
+    // Only the first trigger while disarmed rings the rmw doorbell; until the
+    // guard condition is re-armed further triggers are one atomic operation.
+    bool was_triggered = false;
+    rcutils_atomic_exchange(&guard_condition->impl->triggered, was_triggered, true);
+    if (was_triggered) {
+      return RCL_RET_OK;
+    }
+  }
   // Trigger the guard condition.
   if (rmw_trigger_guard_condition(guard_condition->impl->rmw_handle) != RMW_RET_OK) {
     RCL_SET_ERROR_MSG(rmw_get_error_string().str);
@@ -163,6 +172,48 @@ rcl_trigger_guard_condition(rcl_guard_condition_t * guard_condition)
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_trigger_guard_condition_with_payload(
+  rcl_guard_condition_t * guard_condition,
+  uint64_t payload)
+{
+  const rcl_guard_condition_options_t * options = rcl_guard_condition_get_options(guard_condition);
+  if (!options) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  // Publish the payload before ringing the doorbell, so a waiter woken by
+  // this trigger always observes it.
+  rcutils_atomic_store(&guard_condition->impl->payload, payload);
+  return rcl_trigger_guard_condition(guard_condition);
+}
+
+rcl_ret_t
+rcl_guard_condition_take_payload(
+  rcl_guard_condition_t * guard_condition,
+  uint64_t * payload)
+{
+  const rcl_guard_condition_options_t * options = rcl_guard_condition_get_options(guard_condition);
+  if (!options) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(payload, RCL_RET_INVALID_ARGUMENT);
+  rcutils_atomic_exchange(&guard_condition->impl->payload, *payload, 0);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_guard_condition_rearm(rcl_guard_condition_t * guard_condition)
+{
+  const rcl_guard_condition_options_t * options = rcl_guard_condition_get_options(guard_condition);
+  if (!options) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  if (options->edge_triggered) {
+    rcutils_atomic_store(&guard_condition->impl->triggered, false);
+  }
+  return RCL_RET_OK;
+}
+
 const rcl_guard_condition_options_t *
 rcl_guard_condition_get_options(const rcl_guard_condition_t * guard_condition)
 {
@@ -185,6 +236,161 @@ rcl_guard_condition_get_rmw_handle(const rcl_guard_condition_t * guard_condition
   return guard_condition->impl->rmw_handle;
 }
 
+typedef struct rcl_guard_condition_mux_impl_t
+{
+  // The shared guard condition backing all of the logical conditions.
+  rcl_guard_condition_t guard_condition;
+  // Number of logical conditions multiplexed onto the guard condition.
+  size_t number_of_conditions;
+  // One fired flag per logical condition, set by trigger and consumed by take.
+  atomic_bool * fired;
+  // True while a trigger of the backing guard condition is pending, used to
+  // avoid triggering the rmw guard condition more than once per wait cycle.
+  atomic_bool pending;
+  rcl_allocator_t allocator;
+} rcl_guard_condition_mux_impl_t;
+
+rcl_guard_condition_mux_t
+rcl_get_zero_initialized_guard_condition_mux()
+{
+  static rcl_guard_condition_mux_t null_guard_condition_mux = {
+    .impl = 0
+  };
+  return null_guard_condition_mux;
+}
+
+rcl_ret_t
+rcl_guard_condition_mux_init(
+  rcl_guard_condition_mux_t * guard_condition_mux,
+  rcl_context_t * context,
+  size_t number_of_conditions,
+  const rcl_guard_condition_options_t options)
+{
+  const rcl_allocator_t * allocator = &options.allocator;
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(guard_condition_mux, RCL_RET_INVALID_ARGUMENT);
+  if (guard_condition_mux->impl) {
+    RCL_SET_ERROR_MSG("guard_condition_mux already initialized, or memory was unintialized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  if (0 == number_of_conditions) {
+    RCL_SET_ERROR_MSG("number_of_conditions has to be non-zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_guard_condition_mux_impl_t * impl =
+    (rcl_guard_condition_mux_impl_t *)allocator->allocate(
+    sizeof(rcl_guard_condition_mux_impl_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  impl->fired = (atomic_bool *)allocator->allocate(
+    sizeof(atomic_bool) * number_of_conditions, allocator->state);
+  if (!impl->fired) {
+    allocator->deallocate(impl, allocator->state);
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  size_t i = 0;
+  for (i = 0; i < number_of_conditions; ++i) {
+    atomic_init(&impl->fired[i], false);
+  }
+  atomic_init(&impl->pending, false);
+  impl->number_of_conditions = number_of_conditions;
+  impl->allocator = *allocator;
+  impl->guard_condition = rcl_get_zero_initialized_guard_condition();
+  rcl_ret_t ret = rcl_guard_condition_init(&impl->guard_condition, context, options);
+  if (RCL_RET_OK != ret) {
+    allocator->deallocate(impl->fired, allocator->state);
+    allocator->deallocate(impl, allocator->state);
+    return ret;  // The rcl error state should already be set.
+  }
+  guard_condition_mux->impl = impl;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_guard_condition_mux_fini(rcl_guard_condition_mux_t * guard_condition_mux)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(guard_condition_mux, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t result = RCL_RET_OK;
+  if (guard_condition_mux->impl) {
+    rcl_allocator_t allocator = guard_condition_mux->impl->allocator;
+    result = rcl_guard_condition_fini(&guard_condition_mux->impl->guard_condition);
+    allocator.deallocate(guard_condition_mux->impl->fired, allocator.state);
+    allocator.deallocate(guard_condition_mux->impl, allocator.state);
+    guard_condition_mux->impl = NULL;
+  }
+  return result;
+}
+
+rcl_guard_condition_t *
+rcl_guard_condition_mux_get_guard_condition(
+  const rcl_guard_condition_mux_t * guard_condition_mux)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(guard_condition_mux, NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    guard_condition_mux->impl,
+    "guard condition mux implementation is invalid",
+    return NULL);
+  return &guard_condition_mux->impl->guard_condition;
+}
+
+rcl_ret_t
+rcl_guard_condition_mux_trigger(
+  rcl_guard_condition_mux_t * guard_condition_mux,
+  size_t index)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(guard_condition_mux, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    guard_condition_mux->impl,
+    "guard condition mux implementation is invalid",
+    return RCL_RET_INVALID_ARGUMENT);
+  rcl_guard_condition_mux_impl_t * impl = guard_condition_mux->impl;
+  if (index >= impl->number_of_conditions) {
+    RCL_SET_ERROR_MSG("logical condition index out of range");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcutils_atomic_store(&impl->fired[index], true);
+  // Only the first trigger per wait cycle has to ring the rmw doorbell.
+  bool was_pending = false;
+  rcutils_atomic_exchange(&impl->pending, was_pending, true);
+  if (!was_pending) {
+    return rcl_trigger_guard_condition(&impl->guard_condition);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_guard_condition_mux_take_fired(
+  rcl_guard_condition_mux_t * guard_condition_mux,
+  uint64_t * fired_bits,
+  size_t fired_bits_size)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(guard_condition_mux, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    guard_condition_mux->impl,
+    "guard condition mux implementation is invalid",
+    return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(fired_bits, RCL_RET_INVALID_ARGUMENT);
+  rcl_guard_condition_mux_impl_t * impl = guard_condition_mux->impl;
+  const size_t words_needed = (impl->number_of_conditions + 63u) / 64u;
+  if (fired_bits_size < words_needed) {
+    RCL_SET_ERROR_MSG("fired_bits array is too small");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // Re-arm the doorbell before consuming the flags so triggers racing with
+  // this call are not lost; at worst they cause one spurious wake up.
+  rcutils_atomic_store(&impl->pending, false);
+  memset(fired_bits, 0, sizeof(uint64_t) * words_needed);
+  size_t i = 0;
+  for (i = 0; i < impl->number_of_conditions; ++i) {
+    bool fired = false;
+    rcutils_atomic_exchange(&impl->fired[i], fired, false);
+    if (fired) {
+      fired_bits[i / 64u] |= (uint64_t)1u << (i % 64u);
+    }
+  }
+  return RCL_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
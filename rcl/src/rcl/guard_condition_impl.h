@@ -0,0 +1,43 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__GUARD_CONDITION_IMPL_H_
+#define RCL__GUARD_CONDITION_IMPL_H_
+
+#include "rcl/guard_condition.h"
+#include "rcutils/stdatomic_helper.h"
+#include "rmw/rmw.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct rcl_guard_condition_impl_t
+{
+  rmw_guard_condition_t * rmw_handle;
+  bool allocated_rmw_guard_condition;
+  // True while an edge-triggered wakeup is pending; cleared by re-arming.
+  atomic_bool triggered;
+  // Last-writer-wins payload slot, written at trigger time and consumed
+  // after wake up; zero while empty.
+  atomic_uint_least64_t payload;
+  rcl_guard_condition_options_t options;
+} rcl_guard_condition_impl_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__GUARD_CONDITION_IMPL_H_
@@ -19,9 +19,15 @@ extern "C"
 
 #include "rcl/init.h"
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 #include "./arguments_impl.h"
+#include "./bringup_cache.h"
 #include "./common.h"
 #include "./context_impl.h"
+#include "./env_snapshot.h"
 #include "./init_options_impl.h"
 #include "rcl/arguments.h"
 #include "rcl/error_handling.h"
@@ -32,6 +38,48 @@ extern "C"
 
 static atomic_uint_least64_t __rcl_next_unique_id = ATOMIC_VAR_INIT(1);
 
+/* Middleware initialization does not depend on argument parsing or logging
+ * configuration, so rcl_init() runs it concurrently with those stages and the
+ * wall-clock cost of initialization is the longer of the two rather than
+ * their sum. The task captures its result and error string so that the
+ * calling thread can report them; the rmw error state is thread local.
+ */
+typedef struct rcl_init_rmw_task_t
+{
+  rmw_init_options_t * rmw_init_options;
+  rmw_context_t * rmw_context;
+  rmw_ret_t ret;
+  rmw_error_string_t error_string;
+} rcl_init_rmw_task_t;
+
+// Implementation only
+static void *
+_rcl_init_rmw_task(void * arg)
+{
+  rcl_init_rmw_task_t * task = (rcl_init_rmw_task_t *)arg;
+  task->ret = rmw_init(task->rmw_init_options, task->rmw_context);
+  if (RMW_RET_OK != task->ret) {
+    task->error_string = rmw_get_error_string();
+    rmw_reset_error();
+  }
+  return NULL;
+}
+
+// Implementation only
+static rcl_ret_t
+_rcl_init_next_instance_id(uint64_t * next_instance_id)
+{
+  *next_instance_id = rcutils_atomic_fetch_add_uint64_t(&__rcl_next_unique_id, 1);
+  if (0 == *next_instance_id) {
+    // Roll over occurred, this is an extremely unlikely occurrence.
+    RCL_SET_ERROR_MSG("unique rcl instance ids exhausted");
+    // Roll back to try to avoid the next call succeeding, but there's a data race here.
+    rcutils_atomic_store(&__rcl_next_unique_id, -1);
+    return RCL_RET_ERROR;
+  }
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_init(
   int argc,
@@ -110,34 +158,191 @@ rcl_init(
     }
   }
 
+  // Set the instance id.
+  uint64_t next_instance_id;
+  ret = _rcl_init_next_instance_id(&next_instance_id);
+  if (RCL_RET_OK != ret) {
+    fail_ret = ret;  // error already set
+    goto fail;
+  }
+  rcutils_atomic_store((atomic_uint_least64_t *)(&context->instance_id_storage), next_instance_id);
+  context->impl->init_options.impl->rmw_init_options.instance_id = next_instance_id;
+
+  // Start initializing the middleware while the arguments are parsed and
+  // logging is configured; the stages are independent.
+  rcl_init_rmw_task_t rmw_task = {
+    .rmw_init_options = &(context->impl->init_options.impl->rmw_init_options),
+    .rmw_context = &(context->impl->rmw_context),
+    .ret = RMW_RET_ERROR,
+  };
+  bool rmw_task_started = false;
+#ifndef _WIN32
+  pthread_t rmw_thread;
+  rmw_task_started = (0 == pthread_create(&rmw_thread, NULL, _rcl_init_rmw_task, &rmw_task));
+#endif
+
   // Parse the ROS specific arguments.
-  ret = rcl_parse_arguments(argc, argv, allocator, &context->global_arguments);
+  rcl_ret_t args_ret = rcl_parse_arguments(argc, argv, allocator, &context->global_arguments);
+
+  rcl_ret_t logging_ret = RCL_RET_OK;
+  if (RCL_RET_OK == args_ret) {
+    logging_ret = rcl_logging_configure(&context->global_arguments, &allocator);
+  }
+
+  // Wait for the middleware; when no thread could be used the task runs here
+  if (rmw_task_started) {
+#ifndef _WIN32
+    pthread_join(rmw_thread, NULL);
+#endif
+  } else {
+    _rcl_init_rmw_task(&rmw_task);
+  }
+
+  ret = RCL_RET_OK;
+  if (RCL_RET_OK != args_ret) {
+    ret = args_ret;  // error already set
+    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to parse global arguments");
+  } else if (RCL_RET_OK != logging_ret) {
+    ret = logging_ret;  // error already set
+    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to configure logging. %i", logging_ret);
+  }
+  if (RMW_RET_OK != rmw_task.ret) {
+    if (RCL_RET_OK == ret) {
+      RCL_SET_ERROR_MSG(rmw_task.error_string.str);
+      ret = rcl_convert_rmw_ret_to_rcl_ret(rmw_task.ret);
+    }
+  } else if (RCL_RET_OK != ret) {
+    // the middleware came up but an earlier stage failed; shut it down again
+    rmw_ret_t rmw_ret = rmw_shutdown(&(context->impl->rmw_context));
+    if (RMW_RET_OK != rmw_ret) {
+      RCUTILS_SAFE_FWRITE_TO_STDERR(
+        "[rcl|init.c:" RCUTILS_STRINGIFY(__LINE__)
+        "] failed to shutdown rmw context while handling a failed init: ");
+      RCUTILS_SAFE_FWRITE_TO_STDERR(rmw_get_error_string().str);
+      RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
+      rmw_reset_error();
+    }
+  }
   if (RCL_RET_OK != ret) {
     fail_ret = ret;
-    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to parse global arguments");
     goto fail;
   }
 
-  ret = rcl_logging_configure(&context->global_arguments, &allocator);
+  // Store the allocator.
+  context->impl->allocator = allocator;
+
+  // Snapshot the environment once so later lookups (e.g. the domain id and
+  // security variables read by every rcl_node_init()) are served from
+  // memory.  Failure is not fatal; lookups then read the environment.
+  if (RCL_RET_OK != rcl_env_snapshot_init(context)) {
+    RCUTILS_LOG_WARN_NAMED(
+      ROS_PACKAGE_NAME, "Failed to snapshot environment variables: %s",
+      rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+
+  // Load the bringup cache for this command line, if one is enabled via the
+  // environment; derived state from a previous identical bringup (resolved
+  // names, security roots) is then served from disk.  Never fails bringup.
+  rcl_bringup_cache_load(context, argc, argv);
+
+  return RCL_RET_OK;
+fail:
+  __cleanup_context(context);
+  return fail_ret;
+}
+
+rcl_ret_t
+rcl_init_from_context(
+  rcl_context_t * src_context,
+  rcl_context_t * context)
+{
+  rcl_ret_t fail_ret = RCL_RET_ERROR;
+
+  RCL_CHECK_ARGUMENT_FOR_NULL(src_context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(src_context->impl, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_context_is_valid(src_context)) {
+    RCL_SET_ERROR_MSG("given source context is not valid");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (NULL != context->impl) {
+    RCL_SET_ERROR_MSG("rcl_init_from_context called on an already initialized context");
+    return RCL_RET_ALREADY_INIT;
+  }
+  rcl_allocator_t allocator = src_context->impl->allocator;
+  RCL_CHECK_ALLOCATOR(&allocator, return RCL_RET_INVALID_ARGUMENT);
+
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME,
+    "Initializing ROS client library from existing context at address: %p, "
+    "for context at address: %p", (void *) src_context, (void *) context);
+
+  // Zero initialize global arguments.
+  context->global_arguments = rcl_get_zero_initialized_arguments();
+
+  // Setup impl for context.
+  // use zero_allocate so the cleanup function will not try to clean up uninitialized parts later
+  context->impl = allocator.zero_allocate(1, sizeof(rcl_context_impl_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl, "failed to allocate memory for context impl", return RCL_RET_BAD_ALLOC);
+
+  // Zero initialize rmw context first so its validity can by checked in cleanup.
+  context->impl->rmw_context = rmw_get_zero_initialized_context();
+
+  // Copy the source context's init options; the copy is cheap since only the
+  // rmw init options need to be duplicated.
+  rcl_ret_t ret = rcl_init_options_copy(
+    &(src_context->impl->init_options), &(context->impl->init_options));
   if (RCL_RET_OK != ret) {
-    fail_ret = ret;
-    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to configure logging. %i", fail_ret);
+    fail_ret = ret;  // error message already set
     goto fail;
   }
 
+  // Copy the argc and argv from the source context.
+  context->impl->argc = src_context->impl->argc;
+  context->impl->argv = NULL;
+  if (0 != src_context->impl->argc && NULL != src_context->impl->argv) {
+    int64_t argc = src_context->impl->argc;
+    context->impl->argv =
+      (char **)allocator.zero_allocate(argc, sizeof(char *), allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      context->impl->argv,
+      "failed to allocate memory for argv",
+      fail_ret = RCL_RET_BAD_ALLOC; goto fail);
+    int64_t i;
+    for (i = 0; i < argc; ++i) {
+      size_t argv_i_length = strlen(src_context->impl->argv[i]);
+      context->impl->argv[i] = (char *)allocator.allocate(argv_i_length, allocator.state);
+      RCL_CHECK_FOR_NULL_WITH_MSG(
+        context->impl->argv[i],
+        "failed to allocate memory for string entry in argv",
+        fail_ret = RCL_RET_BAD_ALLOC; goto fail);
+      memcpy(context->impl->argv[i], src_context->impl->argv[i], argv_i_length);
+    }
+  }
+
   // Set the instance id.
-  uint64_t next_instance_id = rcutils_atomic_fetch_add_uint64_t(&__rcl_next_unique_id, 1);
-  if (0 == next_instance_id) {
-    // Roll over occurred, this is an extremely unlikely occurrence.
-    RCL_SET_ERROR_MSG("unique rcl instance ids exhausted");
-    // Roll back to try to avoid the next call succeeding, but there's a data race here.
-    rcutils_atomic_store(&__rcl_next_unique_id, -1);
+  uint64_t next_instance_id;
+  ret = _rcl_init_next_instance_id(&next_instance_id);
+  if (RCL_RET_OK != ret) {
+    fail_ret = ret;  // error already set
     goto fail;
   }
   rcutils_atomic_store((atomic_uint_least64_t *)(&context->instance_id_storage), next_instance_id);
   context->impl->init_options.impl->rmw_init_options.instance_id = next_instance_id;
 
-  // Initialize rmw_init.
+  // Share the already parsed arguments instead of parsing them again; parsed
+  // arguments are immutable and the copy shares the compiled rules with the
+  // source by reference. Logging was configured by the rcl_init() that
+  // created the source context and is process wide, so it is not redone here.
+  ret = rcl_arguments_copy(&(src_context->global_arguments), &(context->global_arguments));
+  if (RCL_RET_OK != ret) {
+    fail_ret = ret;  // error already set
+    goto fail;
+  }
+
+  // Only the middleware is initialized anew for the new context.
   rmw_ret_t rmw_ret = rmw_init(
     &(context->impl->init_options.impl->rmw_init_options),
     &(context->impl->rmw_context));
@@ -150,6 +355,16 @@ rcl_init(
   // Store the allocator.
   context->impl->allocator = allocator;
 
+  // Snapshot the environment once so later lookups (e.g. the domain id and
+  // security variables read by every rcl_node_init()) are served from
+  // memory.  Failure is not fatal; lookups then read the environment.
+  if (RCL_RET_OK != rcl_env_snapshot_init(context)) {
+    RCUTILS_LOG_WARN_NAMED(
+      ROS_PACKAGE_NAME, "Failed to snapshot environment variables: %s",
+      rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+
   return RCL_RET_OK;
 fail:
   __cleanup_context(context);
@@ -23,7 +23,6 @@ extern "C"
 #include "./init_options_impl.h"
 #include "rcl/error_handling.h"
 #include "rmw/error_handling.h"
-#include "rcutils/logging_macros.h"
 
 rcl_init_options_t
 rcl_get_zero_initialized_init_options(void)
@@ -69,46 +68,26 @@ rcl_init_options_copy(const rcl_init_options_t * src, rcl_init_options_t * dst)
     return RCL_RET_ALREADY_INIT;
   }
 
-  // initialize dst (since we know it's in a zero initialized state)
-  rcl_ret_t ret = rcl_init_options_init(dst, src->impl->allocator);
-  if (RCL_RET_OK != ret) {
-    return ret;  // error already set
-  }
+  rcl_allocator_t allocator = src->impl->allocator;
+  RCL_CHECK_ALLOCATOR(&allocator, return RCL_RET_INVALID_ARGUMENT);
 
-  // copy src information into dst
-  dst->impl->allocator = src->impl->allocator;
-  // first zero-initialize rmw init options
-  rmw_ret_t rmw_ret = rmw_init_options_fini(&(dst->impl->rmw_init_options));
-  if (RMW_RET_OK != rmw_ret) {
-    rmw_error_string_t error_string = rmw_get_error_string();
-    rmw_reset_error();
-    ret = rcl_init_options_fini(dst);
-    if (RCL_RET_OK != ret) {
-      RCUTILS_LOG_ERROR_NAMED(
-        "rcl",
-        "failed to finalize dst rcl_init_options while handling failure to "
-        "finalize rmw_init_options, original ret '%d' and error: %s", rmw_ret, error_string.str);
-      return ret;  // error already set
-    }
-    RCL_SET_ERROR_MSG(error_string.str);
-    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
-  }
-  // then copy
+  // Set up the dst impl directly and copy into zero initialized rmw init
+  // options, rather than going through rcl_init_options_init(), which would
+  // fully initialize the rmw init options only to finalize them again right
+  // before the copy.
+  dst->impl = allocator.allocate(sizeof(rcl_init_options_impl_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    dst->impl,
+    "failed to allocate memory for init options impl",
+    return RCL_RET_BAD_ALLOC);
+  dst->impl->allocator = allocator;
   dst->impl->rmw_init_options = rmw_get_zero_initialized_init_options();
-  rmw_ret =
+  rmw_ret_t rmw_ret =
     rmw_init_options_copy(&(src->impl->rmw_init_options), &(dst->impl->rmw_init_options));
   if (RMW_RET_OK != rmw_ret) {
-    rmw_error_string_t error_string = rmw_get_error_string();
-    rmw_reset_error();
-    ret = rcl_init_options_fini(dst);
-    if (RCL_RET_OK != ret) {
-      RCUTILS_LOG_ERROR_NAMED(
-        "rcl",
-        "failed to finalize dst rcl_init_options while handling failure to "
-        "copy rmw_init_options, original ret '%d' and error: %s", rmw_ret, error_string.str);
-      return ret;  // error already set
-    }
-    RCL_SET_ERROR_MSG(error_string.str);
+    allocator.deallocate(dst->impl, allocator.state);
+    dst->impl = NULL;
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
     return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
   }
 
@@ -0,0 +1,203 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/instrumented_allocator.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "rcl/error_handling.h"
+#include "rcutils/logging_macros.h"
+#include "rcutils/stdatomic_helper.h"
+
+/// \internal Header preceding every block handed out by the allocator.
+/**
+ * Records the requested size so that deallocate and reallocate can account
+ * for the bytes of a block they are only given a pointer to.
+ * Two size_t fields keep the user block aligned for any fundamental type.
+ */
+typedef struct rcl_instrumented_header_t
+{
+  size_t size;
+  size_t reserved_;
+} rcl_instrumented_header_t;
+
+// Implementation only
+static void
+_instrumented_count_allocation(rcl_allocator_stats_t * stats, size_t size)
+{
+  uint64_t unused;
+  rcutils_atomic_fetch_add((atomic_uint_least64_t *)(&stats->allocation_count), unused, 1);
+  rcutils_atomic_fetch_add(
+    (atomic_uint_least64_t *)(&stats->total_bytes_allocated), unused, (uint64_t)size);
+  uint64_t previous_in_use;
+  rcutils_atomic_fetch_add(
+    (atomic_uint_least64_t *)(&stats->bytes_in_use), previous_in_use, (uint64_t)size);
+  uint64_t in_use = previous_in_use + (uint64_t)size;
+  uint64_t peak;
+  rcutils_atomic_load((atomic_uint_least64_t *)(&stats->peak_bytes_in_use), peak);
+  while (in_use > peak) {
+    bool exchanged;
+    rcutils_atomic_compare_exchange_strong(
+      (atomic_uint_least64_t *)(&stats->peak_bytes_in_use), exchanged, &peak, in_use);
+    if (exchanged) {
+      break;
+    }
+    // peak was reloaded by the failed exchange; retry if still below in_use
+  }
+  (void)unused;
+}
+
+// Implementation only
+static void
+_instrumented_count_deallocation(rcl_allocator_stats_t * stats, size_t size)
+{
+  uint64_t unused;
+  rcutils_atomic_fetch_add((atomic_uint_least64_t *)(&stats->deallocation_count), unused, 1);
+  rcutils_atomic_fetch_add(
+    (atomic_uint_least64_t *)(&stats->bytes_in_use), unused,
+    (uint64_t)(-(int64_t)size));
+  (void)unused;
+}
+
+// Implementation only
+static void *
+_instrumented_allocate(size_t size, void * state)
+{
+  rcl_allocator_stats_t * stats = (rcl_allocator_stats_t *)state;
+  rcl_allocator_t * base = &stats->base_allocator;
+  rcl_instrumented_header_t * header = (rcl_instrumented_header_t *)base->allocate(
+    size + sizeof(rcl_instrumented_header_t), base->state);
+  if (NULL == header) {
+    return NULL;
+  }
+  header->size = size;
+  _instrumented_count_allocation(stats, size);
+  return (void *)(header + 1);
+}
+
+// Implementation only
+static void
+_instrumented_deallocate(void * pointer, void * state)
+{
+  if (NULL == pointer) {
+    return;
+  }
+  rcl_allocator_stats_t * stats = (rcl_allocator_stats_t *)state;
+  rcl_allocator_t * base = &stats->base_allocator;
+  rcl_instrumented_header_t * header = ((rcl_instrumented_header_t *)pointer) - 1;
+  _instrumented_count_deallocation(stats, header->size);
+  base->deallocate(header, base->state);
+}
+
+// Implementation only
+static void *
+_instrumented_reallocate(void * pointer, size_t size, void * state)
+{
+  if (NULL == pointer) {
+    return _instrumented_allocate(size, state);
+  }
+  rcl_allocator_stats_t * stats = (rcl_allocator_stats_t *)state;
+  rcl_allocator_t * base = &stats->base_allocator;
+  if (0 == size) {
+    _instrumented_deallocate(pointer, state);
+    return NULL;
+  }
+  rcl_instrumented_header_t * header = ((rcl_instrumented_header_t *)pointer) - 1;
+  size_t old_size = header->size;
+  header = (rcl_instrumented_header_t *)base->reallocate(
+    header, size + sizeof(rcl_instrumented_header_t), base->state);
+  if (NULL == header) {
+    return NULL;
+  }
+  header->size = size;
+  // count the reallocation as an allocation of the grown part, paired with a
+  // deallocation of the shrunk part, so bytes_in_use stays exact
+  _instrumented_count_allocation(stats, size > old_size ? size - old_size : 0);
+  _instrumented_count_deallocation(stats, old_size > size ? old_size - size : 0);
+  return (void *)(header + 1);
+}
+
+// Implementation only
+static void *
+_instrumented_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  size_t size = number_of_elements * size_of_element;
+  void * pointer = _instrumented_allocate(size, state);
+  if (NULL != pointer) {
+    memset(pointer, 0, size);
+  }
+  return pointer;
+}
+
+rcl_allocator_stats_t
+rcl_get_zero_initialized_allocator_stats(void)
+{
+  static rcl_allocator_stats_t zero_initialized_allocator_stats;
+  return zero_initialized_allocator_stats;
+}
+
+rcl_allocator_t
+rcl_get_instrumented_allocator(
+  const rcl_allocator_t * base_allocator,
+  rcl_allocator_stats_t * stats)
+{
+  static rcl_allocator_t zero_initialized_allocator;
+  RCL_CHECK_ARGUMENT_FOR_NULL(base_allocator, zero_initialized_allocator);
+  RCL_CHECK_ALLOCATOR(base_allocator, return zero_initialized_allocator);
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, zero_initialized_allocator);
+  stats->base_allocator = *base_allocator;
+  return (rcl_allocator_t) {
+           .allocate = _instrumented_allocate,
+           .deallocate = _instrumented_deallocate,
+           .reallocate = _instrumented_reallocate,
+           .zero_allocate = _instrumented_zero_allocate,
+           .state = stats,
+  };  // NOLINT(readability/braces): false positive
+}
+
+rcl_ret_t
+rcl_allocator_stats_report(const rcl_allocator_stats_t * stats)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  uint64_t allocation_count;
+  uint64_t deallocation_count;
+  uint64_t total_bytes_allocated;
+  uint64_t bytes_in_use;
+  uint64_t peak_bytes_in_use;
+  rcutils_atomic_load((atomic_uint_least64_t *)(&stats->allocation_count), allocation_count);
+  rcutils_atomic_load((atomic_uint_least64_t *)(&stats->deallocation_count), deallocation_count);
+  rcutils_atomic_load(
+    (atomic_uint_least64_t *)(&stats->total_bytes_allocated), total_bytes_allocated);
+  rcutils_atomic_load((atomic_uint_least64_t *)(&stats->bytes_in_use), bytes_in_use);
+  rcutils_atomic_load((atomic_uint_least64_t *)(&stats->peak_bytes_in_use), peak_bytes_in_use);
+  RCUTILS_LOG_INFO_NAMED(
+    ROS_PACKAGE_NAME,
+    "allocator stats for '%s': %" PRIu64 " allocations, %" PRIu64 " deallocations, "
+    "%" PRIu64 " bytes allocated in total, %" PRIu64 " bytes in use, "
+    "%" PRIu64 " bytes peak",
+    stats->tag ? stats->tag : "(untagged)",
+    allocation_count, deallocation_count, total_bytes_allocated,
+    bytes_in_use, peak_bytes_in_use);
+  return RCL_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
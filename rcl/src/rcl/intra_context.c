@@ -0,0 +1,223 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./intra_context.h"
+
+#include <string.h>
+
+#include "rcl/error_handling.h"
+#include "rcutils/logging_macros.h"
+#include "rcutils/strdup.h"
+
+#include "./context_impl.h"
+
+/// Default ring capacity used when the subscription does not specify one.
+#define RCL_INTRA_CONTEXT_DEFAULT_RING_CAPACITY 64
+
+// Round up to the next power of two so ring slots can be masked, not divided.
+static size_t
+__next_power_of_two(size_t value)
+{
+  size_t power = 1;
+  while (power < value) {
+    power <<= 1;
+  }
+  return power;
+}
+
+// Get the registry, lazily allocating it on first use.
+static rcl_ret_t
+__get_registry(rcl_context_t * context, rcl_intra_context_registry_t ** registry)
+{
+  if (NULL == context->impl->intra_context_registry) {
+    rcl_allocator_t * allocator = &context->impl->allocator;
+    rcl_intra_context_registry_t * new_registry =
+      (rcl_intra_context_registry_t *)allocator->zero_allocate(
+      1, sizeof(rcl_intra_context_registry_t), allocator->state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      new_registry, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    new_registry->allocator = *allocator;
+    context->impl->intra_context_registry = new_registry;
+  }
+  *registry = context->impl->intra_context_registry;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_intra_context_register_subscription(
+  rcl_context_t * context,
+  const char * topic_name,
+  size_t ring_capacity,
+  size_t * entry_index)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(entry_index, RCL_RET_INVALID_ARGUMENT);
+  rcl_intra_context_registry_t * registry = NULL;
+  rcl_ret_t ret = __get_registry(context, &registry);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  rcl_allocator_t * allocator = &registry->allocator;
+  // Grow the entry array if needed; delivery only reads entries[0..size).
+  if (registry->size == registry->capacity) {
+    size_t new_capacity = (0 == registry->capacity) ? 4 : 2 * registry->capacity;
+    rcl_intra_context_entry_t * new_entries =
+      (rcl_intra_context_entry_t *)allocator->reallocate(
+      registry->entries, new_capacity * sizeof(rcl_intra_context_entry_t), allocator->state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      new_entries, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    registry->entries = new_entries;
+    registry->capacity = new_capacity;
+  }
+  if (0 == ring_capacity) {
+    ring_capacity = RCL_INTRA_CONTEXT_DEFAULT_RING_CAPACITY;
+  }
+  ring_capacity = __next_power_of_two(ring_capacity);
+  rcl_intra_context_entry_t * entry = &registry->entries[registry->size];
+  entry->topic_name = rcutils_strdup(topic_name, *allocator);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    entry->topic_name, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  entry->ring.buffer = (void **)allocator->allocate(
+    ring_capacity * sizeof(void *), allocator->state);
+  if (NULL == entry->ring.buffer) {
+    allocator->deallocate(entry->topic_name, allocator->state);
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  entry->ring.capacity = ring_capacity;
+  atomic_init(&entry->ring.head, 0);
+  atomic_init(&entry->ring.tail, 0);
+  entry->active = true;
+  *entry_index = registry->size++;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_intra_context_unregister_subscription(
+  rcl_context_t * context,
+  size_t entry_index)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  rcl_intra_context_registry_t * registry = context->impl->intra_context_registry;
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    registry, "intra-context registry is not initialized", return RCL_RET_INVALID_ARGUMENT);
+  if (entry_index >= registry->size) {
+    RCL_SET_ERROR_MSG("intra-context entry index out of bounds");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_intra_context_entry_t * entry = &registry->entries[entry_index];
+  // Deactivate first so concurrent delivery stops matching this entry, then
+  // release the storage; the entry slot itself is kept so indices stay stable.
+  entry->active = false;
+  registry->allocator.deallocate(entry->topic_name, registry->allocator.state);
+  entry->topic_name = NULL;
+  registry->allocator.deallocate(entry->ring.buffer, registry->allocator.state);
+  entry->ring.buffer = NULL;
+  entry->ring.capacity = 0;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_intra_context_deliver(
+  rcl_context_t * context,
+  const char * topic_name,
+  const void * ros_message,
+  size_t * matched)
+{
+  *matched = 0;
+  rcl_intra_context_registry_t * registry = context->impl->intra_context_registry;
+  if (NULL == registry) {
+    return RCL_RET_OK;  // No subscriptions have registered yet.
+  }
+  for (size_t i = 0; i < registry->size; ++i) {
+    rcl_intra_context_entry_t * entry = &registry->entries[i];
+    if (!entry->active || 0 != strcmp(entry->topic_name, topic_name)) {
+      continue;
+    }
+    ++(*matched);
+    rcl_intra_context_ring_t * ring = &entry->ring;
+    uint64_t head = rcutils_atomic_load_uint64_t(&ring->head);
+    uint64_t tail = rcutils_atomic_load_uint64_t(&ring->tail);
+    if (tail - head >= ring->capacity) {
+      // Full ring; drop best-effort style rather than blocking the publisher.
+      RCUTILS_LOG_DEBUG_NAMED(
+        ROS_PACKAGE_NAME, "Dropping intra-context message for full ring on '%s'", topic_name);
+      continue;
+    }
+    ring->buffer[tail % ring->capacity] = (void *)ros_message;
+    // Publishing the new tail makes the slot visible to the consumer.
+    rcutils_atomic_store(&ring->tail, tail + 1);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_intra_context_take(
+  rcl_context_t * context,
+  size_t entry_index,
+  void ** ros_message,
+  bool * taken)
+{
+  *taken = false;
+  rcl_intra_context_registry_t * registry = context->impl->intra_context_registry;
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    registry, "intra-context registry is not initialized", return RCL_RET_INVALID_ARGUMENT);
+  if (entry_index >= registry->size) {
+    RCL_SET_ERROR_MSG("intra-context entry index out of bounds");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_intra_context_ring_t * ring = &registry->entries[entry_index].ring;
+  uint64_t head = rcutils_atomic_load_uint64_t(&ring->head);
+  uint64_t tail = rcutils_atomic_load_uint64_t(&ring->tail);
+  if (head == tail) {
+    return RCL_RET_OK;  // Empty; taken stays false.
+  }
+  *ros_message = ring->buffer[head % ring->capacity];
+  rcutils_atomic_store(&ring->head, head + 1);
+  *taken = true;
+  return RCL_RET_OK;
+}
+
+void
+rcl_intra_context_registry_fini(rcl_context_t * context)
+{
+  rcl_intra_context_registry_t * registry = context->impl->intra_context_registry;
+  if (NULL == registry) {
+    return;
+  }
+  rcl_allocator_t allocator = registry->allocator;
+  for (size_t i = 0; i < registry->size; ++i) {
+    if (NULL != registry->entries[i].topic_name) {
+      allocator.deallocate(registry->entries[i].topic_name, allocator.state);
+    }
+    if (NULL != registry->entries[i].ring.buffer) {
+      allocator.deallocate(registry->entries[i].ring.buffer, allocator.state);
+    }
+  }
+  if (NULL != registry->entries) {
+    allocator.deallocate(registry->entries, allocator.state);
+  }
+  allocator.deallocate(registry, allocator.state);
+  context->impl->intra_context_registry = NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,116 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__INTRA_CONTEXT_H_
+#define RCL__INTRA_CONTEXT_H_
+
+#include <stdbool.h>
+
+#include "rcl/context.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+#include "rcutils/stdatomic_helper.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// \internal Single-producer single-consumer ring of borrowed message pointers.
+typedef struct rcl_intra_context_ring_t
+{
+  /// Message pointer slots; capacity entries.
+  void ** buffer;
+  /// Number of slots, always a power of two.
+  size_t capacity;
+  /// Monotonic count of dequeued messages; slot is head % capacity.
+  atomic_uint_least64_t head;
+  /// Monotonic count of enqueued messages; slot is tail % capacity.
+  atomic_uint_least64_t tail;
+} rcl_intra_context_ring_t;
+
+/// \internal One registered intra-context subscription.
+typedef struct rcl_intra_context_entry_t
+{
+  /// Fully expanded and remapped topic name; owned by the registry.
+  char * topic_name;
+  rcl_intra_context_ring_t ring;
+  /// False once the owning subscription has been finalized.
+  bool active;
+} rcl_intra_context_entry_t;
+
+/// \internal Per-context registry of intra-context subscriptions.
+/**
+ * Entries are only appended (registration) or deactivated (unregistration),
+ * both of which happen from the non-thread-safe init/fini functions; the
+ * publish and take hot paths only read the entry array and use the lock-free
+ * rings.
+ */
+typedef struct rcl_intra_context_registry_t
+{
+  rcl_intra_context_entry_t * entries;
+  size_t size;
+  size_t capacity;
+  rcl_allocator_t allocator;
+} rcl_intra_context_registry_t;
+
+/// \internal Register a subscription's ring for a topic, creating the registry on first use.
+RCL_LOCAL
+rcl_ret_t
+rcl_intra_context_register_subscription(
+  rcl_context_t * context,
+  const char * topic_name,
+  size_t ring_capacity,
+  size_t * entry_index);
+
+/// \internal Deactivate a previously registered entry and release its ring.
+RCL_LOCAL
+rcl_ret_t
+rcl_intra_context_unregister_subscription(
+  rcl_context_t * context,
+  size_t entry_index);
+
+/// \internal Enqueue a message pointer into every active ring matching topic_name.
+/**
+ * Messages are dropped, best-effort style, for rings which are full.
+ * The number of active matching entries (not successful enqueues) is returned
+ * in matched, so the caller can decide whether rmw publication is needed.
+ */
+RCL_LOCAL
+rcl_ret_t
+rcl_intra_context_deliver(
+  rcl_context_t * context,
+  const char * topic_name,
+  const void * ros_message,
+  size_t * matched);
+
+/// \internal Dequeue the oldest message pointer from an entry's ring, if any.
+RCL_LOCAL
+rcl_ret_t
+rcl_intra_context_take(
+  rcl_context_t * context,
+  size_t entry_index,
+  void ** ros_message,
+  bool * taken);
+
+/// \internal Release all registry memory; called while cleaning up the context.
+RCL_LOCAL
+void
+rcl_intra_context_registry_fini(rcl_context_t * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__INTRA_CONTEXT_H_
@@ -12,8 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <limits.h>
+
 #include "rcl/error_handling.h"
 #include "rcl/lexer.h"
+#include "rcutils/stdatomic_helper.h"
 
 /* The lexer tries to find a lexeme in a string.
  * It looks at one character at a time, and uses that character's value to decide how to transition
@@ -575,6 +578,43 @@ static const rcl_lexeme_t g_terminals[LAST_TERMINAL + 1] = {
   RCL_LEXEME_NONE,
 };
 
+/// Flat transition table: one entry per state and input byte.
+/**
+ * Expanded from g_states on first use so the inner loop of
+ * rcl_lexer_analyze() is two array loads per character instead of walking
+ * each state's transition list.  The high bit marks entries reached via the
+ * state's '<else,M>' transition, which is the only case where the lexer
+ * moves by something other than one character forward.
+ */
+#define TOOK_ELSE_TRANSITION 0x80u
+
+static unsigned char g_transition_table[LAST_STATE + 1][UCHAR_MAX + 1];
+static unsigned char g_else_movements[LAST_STATE + 1];
+static atomic_bool g_transition_table_ready = ATOMIC_VAR_INIT(false);
+
+static void
+_rcl_lexer_expand_transition_table(void)
+{
+  for (size_t state_idx = 0u; state_idx <= LAST_STATE; ++state_idx) {
+    const rcl_lexer_state_t * state = &(g_states[state_idx]);
+    for (size_t chr = 0u; chr <= UCHAR_MAX; ++chr) {
+      g_transition_table[state_idx][chr] =
+        (unsigned char)(state->else_state | TOOK_ELSE_TRANSITION);
+    }
+    for (size_t transition_idx = 0u; 0u != state->transitions[transition_idx].to_state;
+      ++transition_idx)
+    {
+      const rcl_lexer_transition_t * transition = &(state->transitions[transition_idx]);
+      for (size_t chr = (unsigned char)transition->range_start;
+        chr <= (unsigned char)transition->range_end; ++chr)
+      {
+        g_transition_table[state_idx][chr] = transition->to_state;
+      }
+    }
+    g_else_movements[state_idx] = state->else_movement;
+  }
+}
+
 rcl_ret_t
 rcl_lexer_analyze(
   const char * text,
@@ -593,8 +633,15 @@ rcl_lexer_analyze(
     return RCL_RET_OK;
   }
 
-  const rcl_lexer_state_t * state;
-  char current_char;
+  // Expand the state machine into the flat table on first use.  Concurrent
+  // first calls may expand it simultaneously; the writes are identical, so
+  // whichever finishes first simply spares the others the next time.
+  if (!rcutils_atomic_load_bool(&g_transition_table_ready)) {
+    _rcl_lexer_expand_transition_table();
+    rcutils_atomic_store(&g_transition_table_ready, true);
+  }
+
+  unsigned char entry;
   size_t next_state = S0;
   size_t movement;
 
@@ -605,28 +652,12 @@ rcl_lexer_analyze(
       RCL_SET_ERROR_MSG("Internal lexer bug: next state does not exist");
       return RCL_RET_ERROR;
     }
-    state = &(g_states[next_state]);
-    current_char = text[*length];
-    next_state = 0u;
+    entry = g_transition_table[next_state][(unsigned char)text[*length]];
     movement = 0u;
-
-    // Look for a transition that contains this character in its range
-    size_t transition_idx = 0u;
-    const rcl_lexer_transition_t * transition;
-    do {
-      transition = &(state->transitions[transition_idx]);
-      if (transition->range_start <= current_char && transition->range_end >= current_char) {
-        next_state = transition->to_state;
-        break;
-      }
-      ++transition_idx;
-    } while (0u != transition->to_state);
-
-    // if no transition was found, take the else transition
-    if (0u == next_state) {
-      next_state = state->else_state;
-      movement = state->else_movement;
+    if (entry & TOOK_ELSE_TRANSITION) {
+      movement = g_else_movements[next_state];
     }
+    next_state = entry & (unsigned char)~TOOK_ELSE_TRANSITION;
 
     // Move the lexer to another character in the string
     if (0u == movement) {
@@ -15,29 +15,16 @@
 #include "rcl/error_handling.h"
 #include "rcl/lexer_lookahead.h"
 
-struct rcl_lexer_lookahead2_impl_t
-{
-  // Text that is being analyzed for lexemes
-  const char * text;
-  // Where in the text analysis is being performed
-  size_t text_idx;
-
-  // first character of lexeme
-  size_t start[2];
-  // One past last character of lexeme
-  size_t end[2];
-  // Type of lexeme
-  rcl_lexeme_t type[2];
-
-  // Allocator to use if an error occurrs
-  rcl_allocator_t allocator;
-};
-
 rcl_lexer_lookahead2_t
 rcl_get_zero_initialized_lexer_lookahead2()
 {
   static rcl_lexer_lookahead2_t zero_initialized = {
-    .impl = NULL,
+    .text = NULL,
+    .text_idx = 0u,
+    .start = {0u, 0u},
+    .end = {0u, 0u},
+    .type = {RCL_LEXEME_NONE, RCL_LEXEME_NONE},
+    .initialized = false,
   };
   return zero_initialized;
 }
@@ -51,24 +38,21 @@ rcl_lexer_lookahead2_init(
   RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(buffer, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(text, RCL_RET_INVALID_ARGUMENT);
-  if (NULL != buffer->impl) {
+  if (buffer->initialized) {
     RCL_SET_ERROR_MSG("buffer must be zero initialized");
     return RCL_RET_INVALID_ARGUMENT;
   }
 
-  buffer->impl = allocator.allocate(sizeof(struct rcl_lexer_lookahead2_impl_t), allocator.state);
-  RCL_CHECK_FOR_NULL_WITH_MSG(
-    buffer->impl, "Failed to allocate lookahead impl", return RCL_RET_BAD_ALLOC);
-
-  buffer->impl->text = text;
-  buffer->impl->text_idx = 0u;
-  buffer->impl->start[0] = 0u;
-  buffer->impl->start[1] = 0u;
-  buffer->impl->end[0] = 0u;
-  buffer->impl->end[1] = 0u;
-  buffer->impl->type[0] = RCL_LEXEME_NONE;
-  buffer->impl->type[1] = RCL_LEXEME_NONE;
-  buffer->impl->allocator = allocator;
+  buffer->text = text;
+  buffer->text_idx = 0u;
+  buffer->start[0] = 0u;
+  buffer->start[1] = 0u;
+  buffer->end[0] = 0u;
+  buffer->end[1] = 0u;
+  buffer->type[0] = RCL_LEXEME_NONE;
+  buffer->type[1] = RCL_LEXEME_NONE;
+  buffer->allocator = allocator;
+  buffer->initialized = true;
 
   return RCL_RET_OK;
 }
@@ -78,13 +62,13 @@ rcl_lexer_lookahead2_fini(
   rcl_lexer_lookahead2_t * buffer)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(buffer, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_FOR_NULL_WITH_MSG(
-    buffer->impl, "buffer finalized twice", return RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ALLOCATOR_WITH_MSG(
-    &(buffer->impl->allocator), "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  if (!buffer->initialized) {
+    RCL_SET_ERROR_MSG("buffer finalized twice");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
 
-  buffer->impl->allocator.deallocate(buffer->impl, buffer->impl->allocator.state);
-  buffer->impl = NULL;
+  // Nothing to release; the buffer only borrows the text.
+  *buffer = rcl_get_zero_initialized_lexer_lookahead2();
   return RCL_RET_OK;
 }
 
@@ -94,29 +78,31 @@ rcl_lexer_lookahead2_peek(
   rcl_lexeme_t * next_type)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(buffer, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_FOR_NULL_WITH_MSG(
-    buffer->impl, "buffer not initialized", return RCL_RET_INVALID_ARGUMENT);
+  if (!buffer->initialized) {
+    RCL_SET_ERROR_MSG("buffer not initialized");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
   RCL_CHECK_ARGUMENT_FOR_NULL(next_type, RCL_RET_INVALID_ARGUMENT);
 
   rcl_ret_t ret;
   size_t length;
 
-  if (buffer->impl->text_idx >= buffer->impl->end[0]) {
+  if (buffer->text_idx >= buffer->end[0]) {
     // No buffered lexeme; get one
     ret = rcl_lexer_analyze(
       rcl_lexer_lookahead2_get_text(buffer),
-      &(buffer->impl->type[0]),
+      &(buffer->type[0]),
       &length);
 
     if (RCL_RET_OK != ret) {
       return ret;
     }
 
-    buffer->impl->start[0] = buffer->impl->text_idx;
-    buffer->impl->end[0] = buffer->impl->start[0] + length;
+    buffer->start[0] = buffer->text_idx;
+    buffer->end[0] = buffer->start[0] + length;
   }
 
-  *next_type = buffer->impl->type[0];
+  *next_type = buffer->type[0];
   return RCL_RET_OK;
 }
 
@@ -136,22 +122,22 @@ rcl_lexer_lookahead2_peek2(
 
   size_t length;
 
-  if (buffer->impl->text_idx >= buffer->impl->end[1]) {
+  if (buffer->text_idx >= buffer->end[1]) {
     // No buffered lexeme; get one
     ret = rcl_lexer_analyze(
-      &(buffer->impl->text[buffer->impl->end[0]]),
-      &(buffer->impl->type[1]),
+      &(buffer->text[buffer->end[0]]),
+      &(buffer->type[1]),
       &length);
 
     if (RCL_RET_OK != ret) {
       return ret;
     }
 
-    buffer->impl->start[1] = buffer->impl->end[0];
-    buffer->impl->end[1] = buffer->impl->start[1] + length;
+    buffer->start[1] = buffer->end[0];
+    buffer->end[1] = buffer->start[1] + length;
   }
 
-  *next_type2 = buffer->impl->type[1];
+  *next_type2 = buffer->type[1];
   return RCL_RET_OK;
 }
 
@@ -162,8 +148,10 @@ rcl_lexer_lookahead2_accept(
   size_t * lexeme_text_length)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(buffer, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_FOR_NULL_WITH_MSG(
-    buffer->impl, "buffer not initialized", return RCL_RET_INVALID_ARGUMENT);
+  if (!buffer->initialized) {
+    RCL_SET_ERROR_MSG("buffer not initialized");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
   if (
     (NULL == lexeme_text && NULL != lexeme_text_length) ||
     (NULL != lexeme_text && NULL == lexeme_text_length))
@@ -172,7 +160,7 @@ rcl_lexer_lookahead2_accept(
     return RCL_RET_INVALID_ARGUMENT;
   }
 
-  if (RCL_LEXEME_EOF == buffer->impl->type[0]) {
+  if (RCL_LEXEME_EOF == buffer->type[0]) {
     // Reached EOF, nothing to accept
     if (NULL != lexeme_text && NULL != lexeme_text_length) {
       *lexeme_text = rcl_lexer_lookahead2_get_text(buffer);
@@ -181,23 +169,23 @@ rcl_lexer_lookahead2_accept(
     return RCL_RET_OK;
   }
 
-  if (buffer->impl->text_idx >= buffer->impl->end[0]) {
+  if (buffer->text_idx >= buffer->end[0]) {
     RCL_SET_ERROR_MSG("no lexeme to accept");
     return RCL_RET_ERROR;
   }
 
   if (NULL != lexeme_text && NULL != lexeme_text_length) {
-    *lexeme_text = &(buffer->impl->text[buffer->impl->start[0]]);
-    *lexeme_text_length = buffer->impl->end[0] - buffer->impl->start[0];
+    *lexeme_text = &(buffer->text[buffer->start[0]]);
+    *lexeme_text_length = buffer->end[0] - buffer->start[0];
   }
 
   // Advance lexer position
-  buffer->impl->text_idx = buffer->impl->end[0];
+  buffer->text_idx = buffer->end[0];
 
   // Move second lexeme in buffer to first position
-  buffer->impl->start[0] = buffer->impl->start[1];
-  buffer->impl->end[0] = buffer->impl->end[1];
-  buffer->impl->type[0] = buffer->impl->type[1];
+  buffer->start[0] = buffer->start[1];
+  buffer->end[0] = buffer->end[1];
+  buffer->type[0] = buffer->type[1];
 
   return RCL_RET_OK;
 }
@@ -220,12 +208,12 @@ rcl_lexer_lookahead2_expect(
     if (RCL_LEXEME_NONE == lexeme || RCL_LEXEME_EOF == lexeme) {
       RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
         "Expected lexeme type (%d) not found, search ended at index %lu",
-        type, buffer->impl->text_idx);
+        type, buffer->text_idx);
       return RCL_RET_WRONG_LEXEME;
     }
     RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
       "Expected lexeme type %d, got %d at index %lu", type, lexeme,
-      buffer->impl->text_idx);
+      buffer->text_idx);
     return RCL_RET_WRONG_LEXEME;
   }
   return rcl_lexer_lookahead2_accept(buffer, lexeme_text, lexeme_text_length);
@@ -235,5 +223,8 @@ const char *
 rcl_lexer_lookahead2_get_text(
   const rcl_lexer_lookahead2_t * buffer)
 {
-  return &(buffer->impl->text[buffer->impl->text_idx]);
+  if (NULL == buffer || !buffer->initialized) {
+    return NULL;
+  }
+  return &(buffer->text[buffer->text_idx]);
 }
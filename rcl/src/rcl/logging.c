@@ -20,6 +20,7 @@ extern "C"
 #include <ctype.h>
 #include <inttypes.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 
 #include "./arguments_impl.h"
@@ -30,6 +31,8 @@ extern "C"
 #include "rcl/logging_rosout.h"
 #include "rcl/macros.h"
 #include "rcutils/logging.h"
+#include "rcutils/macros.h"
+#include "rcutils/stdatomic_helper.h"
 #include "rcutils/time.h"
 
 #define RCL_LOGGING_MAX_OUTPUT_FUNCS (4)
@@ -42,6 +45,36 @@ static rcl_allocator_t g_logging_allocator;
 static bool g_rcl_logging_stdout_enabled = false;
 static bool g_rcl_logging_rosout_enabled = false;
 static bool g_rcl_logging_ext_lib_enabled = false;
+static bool g_rcl_logging_ext_lib_structured = false;
+
+/* When output buffering is enabled, each logging thread collects its records
+ * in a thread local buffer and dispatches them to the handler chain in one
+ * batch, amortizing the handler call overhead and any locking the handlers do.
+ * Records of severity ERROR and above flush the buffer immediately.
+ */
+#define RCL_LOGGING_BUFFER_CAPACITY (16)
+
+typedef struct rcl_logging_buffered_record_t
+{
+  rcutils_log_location_t location;
+  int severity;
+  rcutils_time_point_value_t timestamp;
+  char name[256];
+  char msg[1024];
+} rcl_logging_buffered_record_t;
+
+static bool g_rcl_logging_buffering_enabled = false;
+
+/* Bumped whenever rcl applies new logger severities; logger handles compare
+ * the epoch they resolved their threshold at against it to decide when the
+ * threshold must be re-resolved, see rcl_logger_handle_is_enabled_for().
+ * Starts at 1 so a zero initialized handle is always stale.
+ */
+static atomic_uint_least64_t g_rcl_logging_severity_epoch = ATOMIC_VAR_INIT(1);
+// thread local so that logging threads never contend on the buffer
+static RCUTILS_THREAD_LOCAL
+rcl_logging_buffered_record_t g_rcl_logging_buffer[RCL_LOGGING_BUFFER_CAPACITY];
+static RCUTILS_THREAD_LOCAL size_t g_rcl_logging_buffer_size = 0;
 
 /**
  * An output function that sends to multiple output appenders.
@@ -80,6 +113,7 @@ rcl_logging_configure(const rcl_arguments_t * global_args, const rcl_allocator_t
 
   if (default_level >= 0) {
     rcutils_logging_set_default_logger_level(default_level);
+    rcl_logging_severity_changed();
   }
   if (g_rcl_logging_stdout_enabled) {
     g_rcl_logging_out_handlers[g_rcl_logging_num_out_handlers++] =
@@ -96,6 +130,7 @@ rcl_logging_configure(const rcl_arguments_t * global_args, const rcl_allocator_t
     status = rcl_logging_external_initialize(config_file, g_logging_allocator);
     if (RCL_RET_OK == status) {
       rcl_logging_external_set_logger_level(NULL, default_level);
+      g_rcl_logging_ext_lib_structured = rcl_logging_external_supports_structured_log();
       g_rcl_logging_out_handlers[g_rcl_logging_num_out_handlers++] =
         rcl_logging_ext_lib_output_handler;
     }
@@ -104,9 +139,93 @@ rcl_logging_configure(const rcl_arguments_t * global_args, const rcl_allocator_t
   return status;
 }
 
+/**
+ * Dispatches one record to every registered handler, rebuilding the va_list
+ * for each handler since a handler may consume it.
+ */
+static
+void
+rcl_logging_dispatch_record(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, ...)
+{
+  for (uint8_t i = 0;
+    i < g_rcl_logging_num_out_handlers && NULL != g_rcl_logging_out_handlers[i]; ++i)
+  {
+    va_list args;
+    va_start(args, format);
+    g_rcl_logging_out_handlers[i](location, severity, name, timestamp, format, &args);
+    va_end(args);
+  }
+}
+
+/**
+ * Dispatches the calling thread's buffered records to the handler chain.
+ */
+static
+void
+rcl_logging_flush_buffer(void)
+{
+  for (size_t i = 0; i < g_rcl_logging_buffer_size; ++i) {
+    rcl_logging_buffered_record_t * record = &g_rcl_logging_buffer[i];
+    rcl_logging_dispatch_record(
+      &record->location, record->severity, record->name, record->timestamp, "%s", record->msg);
+  }
+  g_rcl_logging_buffer_size = 0;
+}
+
+rcl_ret_t rcl_logging_set_output_buffering(bool enabled)
+{
+  if (!enabled) {
+    // dispatch what the calling thread has collected; other threads flush
+    // their remainders on their next log call
+    rcl_logging_flush_buffer();
+  }
+  g_rcl_logging_buffering_enabled = enabled;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t rcl_logging_flush_output()
+{
+  rcl_logging_flush_buffer();
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_logger_handle_init(rcl_logger_handle_t * handle, const char * name)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(handle, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(name, RCL_RET_INVALID_ARGUMENT);
+  handle->name = name;
+  handle->threshold = rcutils_logging_get_logger_effective_level(name);
+  handle->epoch = rcutils_atomic_load_uint64_t(&g_rcl_logging_severity_epoch);
+  return RCL_RET_OK;
+}
+
+bool
+rcl_logger_handle_is_enabled_for(rcl_logger_handle_t * handle, int severity)
+{
+  const uint64_t epoch = rcutils_atomic_load_uint64_t(&g_rcl_logging_severity_epoch);
+  if (RCL_UNLIKELY(epoch != handle->epoch)) {
+    // The severity map changed since the threshold was resolved; re-resolve
+    // once and go back to the load-and-compare fast path.
+    handle->threshold = rcutils_logging_get_logger_effective_level(handle->name);
+    handle->epoch = epoch;
+  }
+  return severity >= handle->threshold;
+}
+
+void
+rcl_logging_severity_changed(void)
+{
+  rcutils_atomic_fetch_add_uint64_t(&g_rcl_logging_severity_epoch, 1);
+}
+
 rcl_ret_t rcl_logging_fini()
 {
   rcl_ret_t status = RCL_RET_OK;
+  rcl_logging_flush_buffer();
   rcutils_logging_set_output_handler(rcutils_logging_console_output_handler);
 
   if (g_rcl_logging_rosout_enabled) {
@@ -126,6 +245,38 @@ rcl_logging_multiple_output_handler(
   int severity, const char * name, rcutils_time_point_value_t timestamp,
   const char * format, va_list * args)
 {
+  if (g_rcl_logging_buffering_enabled) {
+    rcl_logging_buffered_record_t * record = &g_rcl_logging_buffer[g_rcl_logging_buffer_size];
+    if (NULL != location) {
+      record->location = *location;
+    } else {
+      memset(&record->location, 0, sizeof(record->location));
+    }
+    record->severity = severity;
+    record->timestamp = timestamp;
+    record->name[0] = '\0';
+    if (NULL != name) {
+      snprintf(record->name, sizeof(record->name), "%s", name);
+    }
+    va_list args_clone;
+    va_copy(args_clone, *args);
+    int written = vsnprintf(record->msg, sizeof(record->msg), format, args_clone);
+    va_end(args_clone);
+    if (written < 0) {
+      record->msg[0] = '\0';
+    }
+    ++g_rcl_logging_buffer_size;
+    if (RCL_LOGGING_BUFFER_CAPACITY == g_rcl_logging_buffer_size ||
+      severity >= RCUTILS_LOG_SEVERITY_ERROR)
+    {
+      rcl_logging_flush_buffer();
+    }
+    return;
+  }
+  if (g_rcl_logging_buffer_size > 0) {
+    // records buffered before buffering was disabled on another thread
+    rcl_logging_flush_buffer();
+  }
   for (uint8_t i = 0;
     i < g_rcl_logging_num_out_handlers && NULL != g_rcl_logging_out_handlers[i]; ++i)
   {
@@ -141,6 +292,25 @@ rcl_logging_ext_lib_output_handler(
   const char * format, va_list * args)
 {
   rcl_ret_t status;
+
+  if (g_rcl_logging_ext_lib_structured) {
+    // hand the raw record to the library and let it format (or not) off the
+    // hot path
+    va_list args_clone;
+    va_copy(args_clone, *args);
+    rcl_logging_external_log_record_t record = {
+      .location = location,
+      .severity = severity,
+      .name = name,
+      .timestamp = timestamp,
+      .format = format,
+      .args = &args_clone
+    };
+    rcl_logging_external_log_structured(&record);
+    va_end(args_clone);
+    return;
+  }
+
   char msg_buf[1024] = "";
   rcutils_char_array_t msg_array = {
     .buffer = msg_buf,
@@ -12,6 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
 #include "rcl/allocator.h"
 #include "rcl/error_handling.h"
 #include "rcl/node.h"
@@ -23,6 +27,7 @@
 #include "rcutils/allocator.h"
 #include "rcutils/logging_macros.h"
 #include "rcutils/macros.h"
+#include "rcutils/stdatomic_helper.h"
 #include "rcutils/types/hash_map.h"
 #include "rcutils/types/rcutils_ret.h"
 #include "rosidl_generator_c/string_functions.h"
@@ -73,15 +78,443 @@ extern "C"
     } \
   }
 
+/* Per-logger throttling state. The hash map stores entries by value, so the
+ * state is allocated separately and shared by every copy of the entry.
+ */
+typedef struct rosout_suppression_state_t
+{
+  // messages still admitted from the current token bucket
+  size_t tokens;
+  // time the bucket was last refilled
+  rcutils_time_point_value_t last_refill;
+  // text of the last admitted message, empty when duplicate suppression is off
+  char last_msg[1024];
+  // number of duplicates collapsed since last_msg was admitted
+  uint64_t repeat_count;
+} rosout_suppression_state_t;
+
 typedef struct rosout_map_entry_t
 {
   rcl_node_t * node;
   rcl_publisher_t publisher;
+  // The publisher (and the state below) is created lazily by the first
+  // record published for this logger, so nodes which never log at a
+  // rosout-enabled severity do not put a publisher into discovery.
+  bool publisher_created;
+  rosout_suppression_state_t * suppression;
+  // Log message pooled per logger so that the string storage is reused across
+  // records instead of being allocated and freed for every published record.
+  // The name field is assigned once, when the publisher is created.
+  rcl_interfaces__msg__Log * log_message;
 } rosout_map_entry_t;
 
 static rcutils_hash_map_t __logger_map;
 static bool __is_initialized = false;
 static rcl_allocator_t __rosout_allocator;
+/* Small pools keeping the suppression state and pooled Log message of
+ * unregistered loggers for reuse, so repeated register/unregister cycles
+ * (e.g. short-lived nodes) are allocation-free once the pools warm up.
+ */
+#define RCL_LOGGING_ROSOUT_POOL_SIZE 8
+static rosout_suppression_state_t * __suppression_pool[RCL_LOGGING_ROSOUT_POOL_SIZE];
+static size_t __suppression_pool_size = 0;
+static rcl_interfaces__msg__Log * __log_message_pool[RCL_LOGGING_ROSOUT_POOL_SIZE];
+static size_t __log_message_pool_size = 0;
+// maximum messages per second admitted per logger, 0 disables the limit
+static size_t __rate_limit = 0;
+static bool __suppress_duplicates = false;
+/* In shared mode every logger publishes through one process-wide publisher
+ * instead of one publisher per node, shrinking the per-process endpoint count
+ * in discovery by the node count; records stay attributable because each one
+ * carries its logger name. The publisher is created lazily on the first node
+ * that publishes a record and re-homed onto a surviving node when its owner
+ * goes away. See rcl_logging_rosout_set_shared_publisher().
+ */
+static bool __use_shared_publisher = false;
+static rcl_publisher_t __shared_publisher;
+static rcl_node_t * __shared_publisher_node = NULL;
+
+/* In asynchronous mode the output handler does not publish; it copies the
+ * preformatted message into a bounded lock-free multi-producer single-consumer
+ * ring and returns, and rcl_logging_rosout_drain() publishes the queued
+ * messages from whichever single thread the application chooses.
+ * When the ring is full messages are dropped and counted instead of blocking
+ * the logging call.
+ */
+#define RCL_LOGGING_ROSOUT_RING_CAPACITY 64  // must be a power of two
+#define RCL_LOGGING_ROSOUT_RING_STR_SIZE 256
+#define RCL_LOGGING_ROSOUT_RING_MSG_SIZE 1024
+
+typedef struct rosout_ring_entry_t
+{
+  // Slot state for the lock-free ring: a producer may claim the slot when
+  // sequence equals its position, and the consumer may read it when sequence
+  // equals position + 1.
+  atomic_size_t sequence;
+  int severity;
+  rcutils_time_point_value_t timestamp;
+  size_t line_number;
+  char name[RCL_LOGGING_ROSOUT_RING_STR_SIZE];
+  char file[RCL_LOGGING_ROSOUT_RING_STR_SIZE];
+  char function[RCL_LOGGING_ROSOUT_RING_STR_SIZE];
+  char msg[RCL_LOGGING_ROSOUT_RING_MSG_SIZE];
+} rosout_ring_entry_t;
+
+static rosout_ring_entry_t __ring[RCL_LOGGING_ROSOUT_RING_CAPACITY];
+static atomic_size_t __ring_enqueue_pos;
+static size_t __ring_dequeue_pos = 0;  // only touched by the draining thread
+static atomic_uint_least64_t __ring_dropped;
+static bool __is_async = false;
+
+// Implementation only
+static void
+_rosout_copy_string(char * dst, size_t dst_size, const char * src)
+{
+  if (NULL == src) {
+    dst[0] = '\0';
+    return;
+  }
+  size_t length = strlen(src);
+  if (length >= dst_size) {
+    length = dst_size - 1;
+  }
+  memcpy(dst, src, length);
+  dst[length] = '\0';
+}
+
+/* Decides whether a log message may be published for a logger. Returns false
+ * when the message is rate limited or is a duplicate of the previous one; in
+ * the duplicate case the message is counted so that a
+ * "last message repeated N times" summary can be published later. When a run
+ * of duplicates ends, *repeated is set to the number of collapsed messages.
+ */
+// Implementation only
+static bool
+_rosout_admit_message(
+  rosout_suppression_state_t * state,
+  const char * msg, rcutils_time_point_value_t timestamp,
+  uint64_t * repeated)
+{
+  *repeated = 0;
+  if (NULL == state) {
+    return true;
+  }
+  if (__suppress_duplicates) {
+    if ('\0' != state->last_msg[0] && 0 == strcmp(state->last_msg, msg)) {
+      ++state->repeat_count;
+      return false;
+    }
+    if (state->repeat_count > 0) {
+      *repeated = state->repeat_count;
+      state->repeat_count = 0;
+    }
+    _rosout_copy_string(state->last_msg, sizeof(state->last_msg), msg);
+  } else if ('\0' != state->last_msg[0]) {
+    // suppression was turned off; flush any pending repeat count
+    if (state->repeat_count > 0) {
+      *repeated = state->repeat_count;
+      state->repeat_count = 0;
+    }
+    state->last_msg[0] = '\0';
+  }
+  if (__rate_limit > 0) {
+    // token bucket with a burst capacity of one second worth of messages
+    if (timestamp - state->last_refill >= (rcutils_time_point_value_t)RCL_S_TO_NS(1)) {
+      state->tokens = __rate_limit;
+      state->last_refill = timestamp;
+    } else if (timestamp > state->last_refill) {
+      uint64_t refill =
+        (uint64_t)(timestamp - state->last_refill) * __rate_limit / RCL_S_TO_NS(1);
+      if (refill > 0) {
+        state->tokens += (size_t)refill;
+        if (state->tokens > __rate_limit) {
+          state->tokens = __rate_limit;
+        }
+        state->last_refill += (rcutils_time_point_value_t)(refill * RCL_S_TO_NS(1) / __rate_limit);
+      }
+    }
+    if (0 == state->tokens) {
+      return false;
+    }
+    --state->tokens;
+  }
+  return true;
+}
+
+/* Like rosidl_generator_c__String__assign() but only reallocates when the
+ * existing capacity is too small, so a pooled message reuses its string
+ * storage across records.
+ */
+// Implementation only
+static void
+_rosout_assign_string(rosidl_generator_c__String * str, const char * value)
+{
+  if (NULL == value) {
+    value = "";
+  }
+  size_t length = strlen(value);
+  if (str->capacity > length) {
+    memcpy(str->data, value, length + 1);
+    str->size = length;
+  } else {
+    rosidl_generator_c__String__assignn(str, value, length);
+  }
+}
+
+// Implementation only
+static rosout_suppression_state_t *
+_rosout_take_suppression_state(void)
+{
+  if (__suppression_pool_size > 0) {
+    rosout_suppression_state_t * state = __suppression_pool[--__suppression_pool_size];
+    memset(state, 0, sizeof(*state));
+    return state;
+  }
+  return __rosout_allocator.zero_allocate(
+    1, sizeof(rosout_suppression_state_t), __rosout_allocator.state);
+}
+
+// Implementation only
+static rcl_interfaces__msg__Log *
+_rosout_take_log_message(void)
+{
+  if (__log_message_pool_size > 0) {
+    return __log_message_pool[--__log_message_pool_size];
+  }
+  return rcl_interfaces__msg__Log__create();
+}
+
+/* Returns an entry's suppression state and Log message to the pools (or frees
+ * them when the pools are full) and resets the entry fields to NULL.
+ */
+// Implementation only
+static void
+_rosout_return_entry_storage(rosout_map_entry_t * entry)
+{
+  if (NULL != entry->suppression) {
+    if (__suppression_pool_size < RCL_LOGGING_ROSOUT_POOL_SIZE) {
+      __suppression_pool[__suppression_pool_size++] = entry->suppression;
+    } else {
+      __rosout_allocator.deallocate(entry->suppression, __rosout_allocator.state);
+    }
+    entry->suppression = NULL;
+  }
+  if (NULL != entry->log_message) {
+    if (__log_message_pool_size < RCL_LOGGING_ROSOUT_POOL_SIZE) {
+      __log_message_pool[__log_message_pool_size++] = entry->log_message;
+    } else {
+      rcl_interfaces__msg__Log__destroy(entry->log_message);
+    }
+    entry->log_message = NULL;
+  }
+}
+
+/* Creates the process-shared publisher on the given node if it does not
+ * exist yet; in shared mode every logger's records go out through it.
+ */
+// Implementation only
+static rcl_ret_t
+_rosout_ensure_shared_publisher(rcl_node_t * node)
+{
+  if (NULL != __shared_publisher.impl) {
+    return RCL_RET_OK;
+  }
+  const rosidl_message_type_support_t * type_support =
+    rosidl_typesupport_c__get_message_type_support_handle__rcl_interfaces__msg__Log();
+  rcl_publisher_options_t options = rcl_publisher_get_default_options();
+  __shared_publisher = rcl_get_zero_initialized_publisher();
+  rcl_ret_t status =
+    rcl_publisher_init(&__shared_publisher, node, type_support, ROSOUT_TOPIC_NAME, &options);
+  if (RCL_RET_OK == status) {
+    __shared_publisher_node = node;
+  }
+  return status;
+}
+
+/* Creates the publisher, suppression state, and pooled Log message for a
+ * registered logger. Called from the publish paths the first time a record
+ * for the logger is actually published; the updated entry is written back to
+ * the map so later lookups find the created publisher.
+ * In shared mode the per-node publisher is skipped and the process-shared
+ * publisher is created instead, on this entry's node if necessary.
+ */
+// Implementation only
+static rcl_ret_t
+_rosout_ensure_publisher(rosout_map_entry_t * entry)
+{
+  rcl_ret_t status = RCL_RET_OK;
+  if (__use_shared_publisher) {
+    status = _rosout_ensure_shared_publisher(entry->node);
+    if (RCL_RET_OK != status) {
+      return status;
+    }
+  }
+  if (entry->publisher_created) {
+    if (__use_shared_publisher || NULL != entry->publisher.impl) {
+      return RCL_RET_OK;
+    }
+    // shared mode was turned off after this entry was created; fall through
+    // to create the per-node publisher it never had
+  }
+  const char * logger_name = rcl_node_get_logger_name(entry->node);
+  if (NULL == logger_name) {
+    RCL_SET_ERROR_MSG("Logger name was null.");
+    return RCL_RET_ERROR;
+  }
+
+  // Create the Log message publisher on the node
+  if (!__use_shared_publisher) {
+    const rosidl_message_type_support_t * type_support =
+      rosidl_typesupport_c__get_message_type_support_handle__rcl_interfaces__msg__Log();
+    rcl_publisher_options_t options = rcl_publisher_get_default_options();
+    status = rcl_publisher_init(
+      &entry->publisher, entry->node, type_support, ROSOUT_TOPIC_NAME, &options);
+  }
+
+  // Take the throttling state shared by all copies of the entry
+  if (RCL_RET_OK == status && NULL == entry->suppression) {
+    entry->suppression = _rosout_take_suppression_state();
+    if (NULL == entry->suppression) {
+      RCL_SET_ERROR_MSG("Failed to allocate rosout suppression state.");
+      status = RCL_RET_BAD_ALLOC;
+    }
+  }
+
+  // Take the Log message pooled for this logger
+  if (RCL_RET_OK == status && NULL == entry->log_message) {
+    entry->log_message = _rosout_take_log_message();
+    if (NULL == entry->log_message) {
+      RCL_SET_ERROR_MSG("Failed to allocate rosout Log message.");
+      status = RCL_RET_BAD_ALLOC;
+    } else {
+      // the entry is keyed by the logger name, so the field never changes
+      _rosout_assign_string(&entry->log_message->name, logger_name);
+    }
+  }
+
+  // Store the created publisher back into the map
+  if (RCL_RET_OK == status) {
+    entry->publisher_created = true;
+    RCL_RET_FROM_RCUTIL_RET(status, rcutils_hash_map_set(&__logger_map, &logger_name, entry));
+    if (RCL_RET_OK != status) {
+      RCL_SET_ERROR_MSG("Failed to update publisher entry in map.");
+    }
+  }
+
+  if (RCL_RET_OK != status) {
+    // roll the entry back to its lazy state so a later record can retry
+    _rosout_return_entry_storage(entry);
+    if (NULL != entry->publisher.impl) {
+      rcl_ret_t fini_status = rcl_publisher_fini(&entry->publisher, entry->node);
+      // ignore the return status in favor of the original failure
+      RCL_UNUSED(fini_status);
+    }
+    entry->publisher = rcl_get_zero_initialized_publisher();
+    entry->publisher_created = false;
+  }
+  return status;
+}
+
+// Implementation only
+static void
+_rosout_publish_log(
+  const rosout_map_entry_t * entry,
+  int severity, rcutils_time_point_value_t timestamp, size_t line_number,
+  const char * msg, const char * file, const char * function)
+{
+  rcl_interfaces__msg__Log * log_message = entry->log_message;
+  if (NULL == log_message) {
+    return;
+  }
+  log_message->stamp.sec = (int32_t) RCL_NS_TO_S(timestamp);
+  log_message->stamp.nanosec = (timestamp % RCL_S_TO_NS(1));
+  log_message->level = severity;
+  log_message->line = (int32_t) line_number;
+  // the name field was assigned when the publisher was registered
+  _rosout_assign_string(&log_message->msg, msg);
+  _rosout_assign_string(&log_message->file, file);
+  _rosout_assign_string(&log_message->function, function);
+  // in shared mode the entry has no publisher of its own
+  const rcl_publisher_t * publisher =
+    (__use_shared_publisher && NULL != __shared_publisher.impl) ?
+    &__shared_publisher : &entry->publisher;
+  if (NULL == publisher->impl) {
+    // the mode changed under this entry; the next record re-creates a publisher
+    return;
+  }
+  rcl_ret_t status = rcl_publish(publisher, log_message, NULL);
+  if (RCL_RET_OK != status) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to publish log message to rosout: ");
+    RCUTILS_SAFE_FWRITE_TO_STDERR(rcl_get_error_string().str);
+    rcl_reset_error();
+    RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
+  }
+}
+
+// Implementation only
+static void
+_rosout_publish_repeat_summary(
+  const rosout_map_entry_t * entry,
+  int severity, rcutils_time_point_value_t timestamp, uint64_t repeated)
+{
+  char summary[64];
+  int written = snprintf(
+    summary, sizeof(summary), "last message repeated %" PRIu64 " times", repeated);
+  if (written < 0) {
+    return;
+  }
+  _rosout_publish_log(entry, severity, timestamp, 0u, summary, "", "");
+}
+
+// Implementation only
+static void
+_rosout_ring_enqueue(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args)
+{
+  size_t pos;
+  rcutils_atomic_load(&__ring_enqueue_pos, pos);
+  for (;;) {
+    rosout_ring_entry_t * entry = &__ring[pos & (RCL_LOGGING_ROSOUT_RING_CAPACITY - 1)];
+    size_t seq;
+    rcutils_atomic_load(&entry->sequence, seq);
+    intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+    if (0 == dif) {
+      bool exchanged;
+      rcutils_atomic_compare_exchange_strong(&__ring_enqueue_pos, exchanged, &pos, pos + 1);
+      if (exchanged) {
+        // slot claimed; fill it, then hand it to the consumer
+        entry->severity = severity;
+        entry->timestamp = timestamp;
+        entry->line_number = location ? location->line_number : 0u;
+        _rosout_copy_string(entry->name, sizeof(entry->name), name);
+        _rosout_copy_string(
+          entry->file, sizeof(entry->file), location ? location->file_name : NULL);
+        _rosout_copy_string(
+          entry->function, sizeof(entry->function), location ? location->function_name : NULL);
+        va_list args_clone;
+        va_copy(args_clone, *args);
+        int written = vsnprintf(entry->msg, sizeof(entry->msg), format, args_clone);
+        va_end(args_clone);
+        if (written < 0) {
+          entry->msg[0] = '\0';
+        }
+        rcutils_atomic_store(&entry->sequence, pos + 1);
+        return;
+      }
+      // lost the race for this slot; pos was reloaded by the exchange
+    } else if (dif < 0) {
+      // the ring is full; drop the message and count it rather than block
+      uint64_t prev_dropped;
+      rcutils_atomic_fetch_add(&__ring_dropped, prev_dropped, 1);
+      (void)prev_dropped;
+      return;
+    } else {
+      rcutils_atomic_load(&__ring_enqueue_pos, pos);
+    }
+  }
+}
 
 rcl_ret_t rcl_logging_rosout_init(
   const rcl_allocator_t * allocator)
@@ -109,14 +542,30 @@ rcl_ret_t rcl_logging_rosout_fini()
   char * key = NULL;
   rosout_map_entry_t entry;
 
+  // Teardown the process-shared publisher, if one was ever created
+  if (NULL != __shared_publisher.impl) {
+    status = rcl_publisher_fini(&__shared_publisher, __shared_publisher_node);
+    __shared_publisher = rcl_get_zero_initialized_publisher();
+    __shared_publisher_node = NULL;
+    if (RCL_RET_OK != status) {
+      return status;
+    }
+  }
+
   // fini all the outstanding publishers
   rcutils_ret_t hashmap_ret = rcutils_hash_map_get_next_key_and_data(&__logger_map, NULL, &key,
       &entry);
   while (RCL_RET_OK == status && RCUTILS_RET_OK == hashmap_ret) {
-    // Teardown publisher
-    status = rcl_publisher_fini(&entry.publisher, entry.node);
+    // Teardown publisher, if a record was ever published for this logger
+    if (entry.publisher_created) {
+      status = rcl_publisher_fini(&entry.publisher, entry.node);
+    }
 
     if (RCL_RET_OK == status) {
+      __rosout_allocator.deallocate(entry.suppression, __rosout_allocator.state);
+      if (NULL != entry.log_message) {
+        rcl_interfaces__msg__Log__destroy(entry.log_message);
+      }
       RCL_RET_FROM_RCUTIL_RET(status, rcutils_hash_map_unset(&__logger_map, &key));
     }
 
@@ -133,6 +582,14 @@ rcl_ret_t rcl_logging_rosout_fini()
   }
 
   if (RCL_RET_OK == status) {
+    // release the storage pooled for logger reuse
+    while (__suppression_pool_size > 0) {
+      __rosout_allocator.deallocate(
+        __suppression_pool[--__suppression_pool_size], __rosout_allocator.state);
+    }
+    while (__log_message_pool_size > 0) {
+      rcl_interfaces__msg__Log__destroy(__log_message_pool[--__log_message_pool_size]);
+    }
     __is_initialized = false;
   }
   return status;
@@ -165,25 +622,17 @@ rcl_ret_t rcl_logging_rosout_init_publisher_for_node(
     return RCL_RET_OK;
   }
 
-  // Create a new Log message publisher on the node
-  const rosidl_message_type_support_t * type_support =
-    rosidl_typesupport_c__get_message_type_support_handle__rcl_interfaces__msg__Log();
-  rcl_publisher_options_t options = rcl_publisher_get_default_options();
+  // Register the logger with a lazy entry; the publisher, suppression state,
+  // and pooled Log message are created by _rosout_ensure_publisher() when the
+  // first record for this logger is actually published.
+  new_entry.node = node;
   new_entry.publisher = rcl_get_zero_initialized_publisher();
-  status =
-    rcl_publisher_init(&new_entry.publisher, node, type_support, ROSOUT_TOPIC_NAME, &options);
-
-  // Add the new publisher to the map
-  if (RCL_RET_OK == status) {
-    new_entry.node = node;
-    RCL_RET_FROM_RCUTIL_RET(status, rcutils_hash_map_set(&__logger_map, &logger_name, &new_entry));
-    if (RCL_RET_OK != status) {
-      RCL_SET_ERROR_MSG("Failed to add publisher to map.");
-      // We failed to add to the map so destroy the publisher that we created
-      rcl_ret_t fini_status = rcl_publisher_fini(&new_entry.publisher, new_entry.node);
-      // ignore the return status in favor of the failure from set
-      RCL_UNUSED(fini_status);
-    }
+  new_entry.publisher_created = false;
+  new_entry.suppression = NULL;
+  new_entry.log_message = NULL;
+  RCL_RET_FROM_RCUTIL_RET(status, rcutils_hash_map_set(&__logger_map, &logger_name, &new_entry));
+  if (RCL_RET_OK != status) {
+    RCL_SET_ERROR_MSG("Failed to add publisher entry to map.");
   }
 
   return status;
@@ -199,6 +648,16 @@ rcl_ret_t rcl_logging_rosout_fini_publisher_for_node(
 
   // Verify input and make sure it's initialized
   RCL_CHECK_ARGUMENT_FOR_NULL(node, RCL_RET_NODE_INVALID);
+  // The departing node may carry the process-shared publisher; tear it down
+  // so the next published record re-creates it on a surviving node.
+  if (NULL != __shared_publisher.impl && node == __shared_publisher_node) {
+    status = rcl_publisher_fini(&__shared_publisher, __shared_publisher_node);
+    __shared_publisher = rcl_get_zero_initialized_publisher();
+    __shared_publisher_node = NULL;
+    if (RCL_RET_OK != status) {
+      return status;
+    }
+  }
   logger_name = rcl_node_get_logger_name(node);
   if (NULL == logger_name) {
     return RCL_RET_ERROR;
@@ -207,18 +666,64 @@ rcl_ret_t rcl_logging_rosout_fini_publisher_for_node(
     return RCL_RET_OK;
   }
 
-  // fini the publisher and remove the entry from the map
+  // fini the publisher (if one was ever created) and remove the entry from the map
   RCL_RET_FROM_RCUTIL_RET(status, rcutils_hash_map_get(&__logger_map, &logger_name, &entry));
-  if (RCL_RET_OK == status) {
+  if (RCL_RET_OK == status && entry.publisher_created) {
     status = rcl_publisher_fini(&entry.publisher, entry.node);
   }
   if (RCL_RET_OK == status) {
     RCL_RET_FROM_RCUTIL_RET(status, rcutils_hash_map_unset(&__logger_map, &logger_name));
   }
+  if (RCL_RET_OK == status) {
+    // keep the storage for the next logger registration instead of freeing it
+    _rosout_return_entry_storage(&entry);
+  }
 
   return status;
 }
 
+rcl_ret_t rcl_logging_rosout_get_footprint_for_node(
+  const rcl_node_t * node,
+  bool * publisher_created,
+  size_t * bookkeeping_bytes)
+{
+  rosout_map_entry_t entry;
+  const char * logger_name = NULL;
+
+  RCL_CHECK_ARGUMENT_FOR_NULL(node, RCL_RET_NODE_INVALID);
+  RCL_CHECK_ARGUMENT_FOR_NULL(publisher_created, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(bookkeeping_bytes, RCL_RET_INVALID_ARGUMENT);
+  *publisher_created = false;
+  *bookkeeping_bytes = 0;
+  if (!__is_initialized) {
+    return RCL_RET_OK;
+  }
+  logger_name = rcl_node_get_logger_name(node);
+  if (NULL == logger_name) {
+    return RCL_RET_ERROR;
+  }
+  if (RCUTILS_RET_OK != rcutils_hash_map_get(&__logger_map, &logger_name, &entry)) {
+    // the node's logger was never registered with rosout
+    return RCL_RET_OK;
+  }
+  *publisher_created = entry.publisher_created;
+  // the entry is stored by value in the map; suppression state and the pooled
+  // Log message are only allocated once the publisher has been created
+  size_t bytes = sizeof(rosout_map_entry_t);
+  if (NULL != entry.suppression) {
+    bytes += sizeof(rosout_suppression_state_t);
+  }
+  if (NULL != entry.log_message) {
+    bytes += sizeof(*entry.log_message) +
+      entry.log_message->name.capacity +
+      entry.log_message->msg.capacity +
+      entry.log_message->file.capacity +
+      entry.log_message->function.capacity;
+  }
+  *bookkeeping_bytes = bytes;
+  return RCL_RET_OK;
+}
+
 void rcl_logging_rosout_output_handler(
   const rcutils_log_location_t * location,
   int severity, const char * name, rcutils_time_point_value_t timestamp,
@@ -229,8 +734,21 @@ void rcl_logging_rosout_output_handler(
   if (!__is_initialized) {
     return;
   }
+  if (__is_async) {
+    // defer the publish to rcl_logging_rosout_drain(); the publisher lookup
+    // happens there too, so the logging call stays lock-free
+    _rosout_ring_enqueue(location, severity, name, timestamp, format, args);
+    return;
+  }
   rcutils_ret_t rcutils_ret = rcutils_hash_map_get(&__logger_map, &name, &entry);
   if (RCUTILS_RET_OK == rcutils_ret) {
+    if (RCL_RET_OK != _rosout_ensure_publisher(&entry)) {
+      RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to create rosout publisher: ");
+      RCUTILS_SAFE_FWRITE_TO_STDERR(rcl_get_error_string().str);
+      rcl_reset_error();
+      RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
+      return;
+    }
     char msg_buf[1024] = "";
     rcutils_char_array_t msg_array = {
       .buffer = msg_buf,
@@ -250,25 +768,14 @@ void rcl_logging_rosout_output_handler(
       rcl_reset_error();
       RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
     } else {
-      rcl_interfaces__msg__Log * log_message = rcl_interfaces__msg__Log__create();
-      if (NULL != log_message) {
-        log_message->stamp.sec = (int32_t) RCL_NS_TO_S(timestamp);
-        log_message->stamp.nanosec = (timestamp % RCL_S_TO_NS(1));
-        log_message->level = severity;
-        log_message->line = (int32_t) location->line_number;
-        rosidl_generator_c__String__assign(&log_message->name, name);
-        rosidl_generator_c__String__assign(&log_message->msg, msg_array.buffer);
-        rosidl_generator_c__String__assign(&log_message->file, location->file_name);
-        rosidl_generator_c__String__assign(&log_message->function, location->function_name);
-        status = rcl_publish(&entry.publisher, log_message, NULL);
-        if (RCL_RET_OK != status) {
-          RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to publish log message to rosout: ");
-          RCUTILS_SAFE_FWRITE_TO_STDERR(rcl_get_error_string().str);
-          rcl_reset_error();
-          RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
+      uint64_t repeated = 0;
+      if (_rosout_admit_message(entry.suppression, msg_array.buffer, timestamp, &repeated)) {
+        if (repeated > 0) {
+          _rosout_publish_repeat_summary(&entry, severity, timestamp, repeated);
         }
-
-        rcl_interfaces__msg__Log__destroy(log_message);
+        _rosout_publish_log(
+          &entry, severity, timestamp, location->line_number, msg_array.buffer,
+          location->file_name, location->function_name);
       }
     }
 
@@ -282,6 +789,114 @@ void rcl_logging_rosout_output_handler(
   }
 }
 
+rcl_ret_t rcl_logging_rosout_set_async(bool enabled)
+{
+  if (enabled && !__is_async) {
+    // reset the ring; each slot is claimable at its own index
+    for (size_t i = 0; i < RCL_LOGGING_ROSOUT_RING_CAPACITY; ++i) {
+      rcutils_atomic_store(&__ring[i].sequence, i);
+    }
+    rcutils_atomic_store(&__ring_enqueue_pos, (size_t)0);
+    __ring_dequeue_pos = 0;
+    __is_async = true;
+  } else if (!enabled && __is_async) {
+    // publish whatever is still queued before going back to synchronous mode
+    __is_async = false;
+    if (__is_initialized) {
+      return rcl_logging_rosout_drain();
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t rcl_logging_rosout_drain(void)
+{
+  RCL_LOGGING_ROSOUT_VERIFY_INITIALIZED
+  rcl_ret_t status = RCL_RET_OK;
+
+  for (;;) {
+    rosout_ring_entry_t * entry =
+      &__ring[__ring_dequeue_pos & (RCL_LOGGING_ROSOUT_RING_CAPACITY - 1)];
+    size_t seq;
+    rcutils_atomic_load(&entry->sequence, seq);
+    if (seq != __ring_dequeue_pos + 1) {
+      break;  // no more completed entries
+    }
+
+    // loggers without a registered publisher are skipped, matching the
+    // synchronous path
+    rosout_map_entry_t map_entry;
+    const char * logger_name = entry->name;
+    if (RCUTILS_RET_OK == rcutils_hash_map_get(&__logger_map, &logger_name, &map_entry)) {
+      if (RCL_RET_OK != _rosout_ensure_publisher(&map_entry)) {
+        RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to create rosout publisher: ");
+        RCUTILS_SAFE_FWRITE_TO_STDERR(rcl_get_error_string().str);
+        rcl_reset_error();
+        RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
+        // return the slot and keep draining later entries
+        rcutils_atomic_store(
+          &entry->sequence, __ring_dequeue_pos + RCL_LOGGING_ROSOUT_RING_CAPACITY);
+        ++__ring_dequeue_pos;
+        continue;
+      }
+      uint64_t repeated = 0;
+      if (_rosout_admit_message(
+          map_entry.suppression, entry->msg, entry->timestamp, &repeated))
+      {
+        if (repeated > 0) {
+          _rosout_publish_repeat_summary(
+            &map_entry, entry->severity, entry->timestamp, repeated);
+        }
+        _rosout_publish_log(
+          &map_entry, entry->severity, entry->timestamp, entry->line_number,
+          entry->msg, entry->file, entry->function);
+      }
+    }
+
+    // return the slot to the producers
+    rcutils_atomic_store(
+      &entry->sequence, __ring_dequeue_pos + RCL_LOGGING_ROSOUT_RING_CAPACITY);
+    ++__ring_dequeue_pos;
+  }
+
+  return status;
+}
+
+rcl_ret_t rcl_logging_rosout_set_rate_limit(size_t max_messages_per_second)
+{
+  __rate_limit = max_messages_per_second;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t rcl_logging_rosout_set_duplicate_suppression(bool enabled)
+{
+  __suppress_duplicates = enabled;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t rcl_logging_rosout_set_shared_publisher(bool enabled)
+{
+  if (!enabled && __use_shared_publisher && NULL != __shared_publisher.impl) {
+    // teardown eagerly; per-node publishers are re-created lazily as loggers
+    // publish their next record
+    rcl_ret_t status = rcl_publisher_fini(&__shared_publisher, __shared_publisher_node);
+    __shared_publisher = rcl_get_zero_initialized_publisher();
+    __shared_publisher_node = NULL;
+    if (RCL_RET_OK != status) {
+      return status;
+    }
+  }
+  __use_shared_publisher = enabled;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t rcl_logging_rosout_get_num_dropped_messages(uint64_t * count)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(count, RCL_RET_INVALID_ARGUMENT);
+  rcutils_atomic_load(&__ring_dropped, *count);
+  return RCL_RET_OK;
+}
+
 
 #ifdef __cplusplus
 }
@@ -24,8 +24,13 @@ extern "C"
 #include <stdlib.h>
 #include <string.h>
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 #include "rcl/arguments.h"
 #include "rcl/error_handling.h"
+#include "rcl/expand_topic_name.h"
 #include "rcl/logging_rosout.h"
 #include "rcl/rcl.h"
 #include "rcl/remap.h"
@@ -45,22 +50,20 @@ extern "C"
 #include "rmw/validate_namespace.h"
 #include "rmw/validate_node_name.h"
 
+#include "./arena.h"
+#include "./bringup_cache.h"
 #include "./common.h"
 #include "./context_impl.h"
+#include "./env_snapshot.h"
+#include "./graph_guard.h"
+#include "./node_impl.h"
+#include "./string_intern.h"
 
 #define ROS_SECURITY_STRATEGY_VAR_NAME "ROS_SECURITY_STRATEGY"
 #define ROS_SECURITY_ENABLE_VAR_NAME "ROS_SECURITY_ENABLE"
 
-typedef struct rcl_node_impl_t
-{
-  rcl_node_options_t options;
-  size_t actual_domain_id;
-  rmw_node_t * rmw_node_handle;
-  rcl_guard_condition_t * graph_guard_condition;
-  const char * logger_name;
-  const char * fq_name;
-} rcl_node_impl_t;
-
+// Number of worker threads rcl_nodes_fini() spreads middleware teardown over.
+#define RCL_NODES_FINI_MAX_THREADS 4
 
 /// Return the logger name associated with a node given the validated node name and namespace.
 /**
@@ -100,6 +103,148 @@ const char * rcl_create_node_logger_name(
   return node_logger_name;
 }
 
+/// Release the node's resolved name cache.
+static void
+_rcl_node_free_resolved_names(
+  rcl_node_impl_t * impl, rcl_context_t * context, const rcl_allocator_t * allocator)
+{
+  if (NULL == impl->resolved_names) {
+    return;
+  }
+  for (size_t i = 0; i < impl->num_resolved_names; ++i) {
+    rcl_string_intern_release(context, impl->resolved_names[i].input_name);
+    rcl_string_intern_release(context, impl->resolved_names[i].resolved_name);
+  }
+  allocator->deallocate(impl->resolved_names, allocator->state);
+  impl->resolved_names = NULL;
+  impl->num_resolved_names = 0;
+  impl->resolved_names_capacity = 0;
+}
+
+/// Remember a resolved name; failure to grow the cache only costs the caching.
+static void
+_rcl_node_cache_resolved_name(
+  const rcl_node_t * node,
+  const char * input_name,
+  const char * resolved_name,
+  bool is_service)
+{
+  rcl_node_impl_t * impl = node->impl;
+  rcl_allocator_t allocator = impl->options.allocator;
+  if (impl->num_resolved_names == impl->resolved_names_capacity) {
+    size_t new_capacity =
+      impl->resolved_names_capacity ? 2 * impl->resolved_names_capacity : 8;
+    rcl_resolved_name_t * grown = allocator.reallocate(
+      impl->resolved_names, new_capacity * sizeof(rcl_resolved_name_t), allocator.state);
+    if (NULL == grown) {
+      return;
+    }
+    impl->resolved_names = grown;
+    impl->resolved_names_capacity = new_capacity;
+  }
+  rcl_resolved_name_t * entry = &(impl->resolved_names[impl->num_resolved_names]);
+  entry->input_name = rcl_string_intern(node->context, input_name);
+  if (NULL == entry->input_name) {
+    return;
+  }
+  entry->resolved_name = rcl_string_intern(node->context, resolved_name);
+  if (NULL == entry->resolved_name) {
+    rcl_string_intern_release(node->context, entry->input_name);
+    return;
+  }
+  entry->is_service = is_service;
+  ++(impl->num_resolved_names);
+}
+
+rcl_ret_t
+rcl_node_resolve_name(
+  const rcl_node_t * node,
+  const char * input_name,
+  rcl_allocator_t allocator,
+  bool is_service,
+  char ** output_name)
+{
+  if (!rcl_node_is_valid_except_context(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(input_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(output_name, RCL_RET_INVALID_ARGUMENT);
+  rcl_node_impl_t * impl = node->impl;
+  // Serve repeat resolutions of the same name from the cache.
+  for (size_t i = 0; i < impl->num_resolved_names; ++i) {
+    const rcl_resolved_name_t * entry = &(impl->resolved_names[i]);
+    if (entry->is_service == is_service && 0 == strcmp(entry->input_name, input_name)) {
+      *output_name = rcutils_strdup(entry->resolved_name, allocator);
+      RCL_CHECK_FOR_NULL_WITH_MSG(
+        *output_name, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+      return RCL_RET_OK;
+    }
+  }
+  // Consult the bringup cache next; a warm restart with an identical command
+  // line then skips the expand and remap chain entirely.  The key spells out
+  // everything the resolution depends on besides the (cached) arguments.
+  char * bringup_key = rcutils_format_string(
+    allocator, "%c:%s:%s:%s", is_service ? 's' : 't',
+    rcl_node_get_name(node), rcl_node_get_namespace(node), input_name);
+  if (NULL != bringup_key) {
+    const char * cached = rcl_bringup_cache_lookup(node->context, bringup_key);
+    if (NULL != cached) {
+      *output_name = rcutils_strdup(cached, allocator);
+      if (NULL != *output_name) {
+        _rcl_node_cache_resolved_name(node, input_name, *output_name, is_service);
+        allocator.deallocate(bringup_key, allocator.state);
+        return RCL_RET_OK;
+      }
+    }
+  }
+  // Cache miss: run the expand and remap chain once, borrowing the
+  // substitutions map built at node init.
+  if (!impl->substitutions_map_valid) {
+    allocator.deallocate(bringup_key, allocator.state);
+    RCL_SET_ERROR_MSG("substitutions map not initialized");
+    return RCL_RET_ERROR;
+  }
+  char * expanded_name = NULL;
+  char * remapped_name = NULL;
+  rcl_ret_t ret = rcl_expand_topic_name(
+    input_name, rcl_node_get_name(node), rcl_node_get_namespace(node),
+    &(impl->substitutions_map), allocator, &expanded_name);
+  if (RCL_RET_OK != ret) {
+    allocator.deallocate(bringup_key, allocator.state);
+    return ret;  // error already set
+  }
+  rcl_arguments_t * global_args = NULL;
+  if (impl->options.use_global_arguments) {
+    global_args = &(node->context->global_arguments);
+  }
+  if (is_service) {
+    ret = rcl_remap_service_name(
+      &(impl->options.arguments), global_args, expanded_name,
+      rcl_node_get_name(node), rcl_node_get_namespace(node), allocator, &remapped_name);
+  } else {
+    ret = rcl_remap_topic_name(
+      &(impl->options.arguments), global_args, expanded_name,
+      rcl_node_get_name(node), rcl_node_get_namespace(node), allocator, &remapped_name);
+  }
+  if (RCL_RET_OK != ret) {
+    allocator.deallocate(bringup_key, allocator.state);
+    allocator.deallocate(expanded_name, allocator.state);
+    return ret;  // error already set
+  }
+  if (NULL == remapped_name) {
+    remapped_name = expanded_name;
+  } else {
+    allocator.deallocate(expanded_name, allocator.state);
+  }
+  _rcl_node_cache_resolved_name(node, input_name, remapped_name, is_service);
+  if (NULL != bringup_key) {
+    rcl_bringup_cache_store(node->context, bringup_key, remapped_name);
+    allocator.deallocate(bringup_key, allocator.state);
+  }
+  *output_name = remapped_name;
+  return RCL_RET_OK;
+}
+
 rcl_node_t
 rcl_get_zero_initialized_node()
 {
@@ -121,12 +266,11 @@ rcl_node_init(
   size_t domain_id = 0;
   const char * ros_domain_id;
   const rmw_guard_condition_t * rmw_graph_guard_condition = NULL;
-  rcl_guard_condition_options_t graph_guard_condition_options =
-    rcl_guard_condition_get_default_options();
   rcl_ret_t ret;
   rcl_ret_t fail_ret = RCL_RET_ERROR;
   char * remapped_node_name = NULL;
   char * node_secure_root = NULL;
+  rcl_arena_t * arena = NULL;
 
   // Check options and allocator first, so allocator can be used for errors.
   RCL_CHECK_ARGUMENT_FOR_NULL(options, RCL_RET_INVALID_ARGUMENT);
@@ -164,10 +308,20 @@ rcl_node_init(
     return RCL_RET_NODE_INVALID_NAME;
   }
 
+  // One arena backs the impl struct and the strings derived from the node
+  // name and namespace; everything it hands out is released as a single
+  // block in rcl_node_fini(). Sized so that a typical init never falls back
+  // to the backing allocator.
+  size_t arena_capacity = sizeof(rcl_node_impl_t) +
+    8 * (strlen(name) + strlen(namespace_)) + 512;
+  arena = rcl_arena_create(arena_capacity, allocator);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    arena, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  rcl_allocator_t arena_allocator = rcl_arena_get_allocator(arena);
+
   // Process the namespace.
   size_t namespace_length = strlen(namespace_);
   const char * local_namespace_ = namespace_;
-  bool should_free_local_namespace_ = false;
   // If the namespace is just an empty string, replace with "/"
   if (namespace_length == 0) {
     // Have this special case to avoid a memory allocation when "" is passed.
@@ -176,12 +330,11 @@ rcl_node_init(
 
   // If the namespace does not start with a /, add one.
   if (namespace_length > 0 && namespace_[0] != '/') {
-    local_namespace_ = rcutils_format_string(*allocator, "/%s", namespace_);
+    local_namespace_ = rcutils_format_string(arena_allocator, "/%s", namespace_);
     RCL_CHECK_FOR_NULL_WITH_MSG(
       local_namespace_,
       "failed to format node namespace string",
       ret = RCL_RET_BAD_ALLOC; goto cleanup);
-    should_free_local_namespace_ = true;
   }
   // Make sure the node namespace is valid.
   validation_result = 0;
@@ -199,13 +352,27 @@ rcl_node_init(
   }
 
   // Allocate space for the implementation struct.
-  node->impl = (rcl_node_impl_t *)allocator->allocate(sizeof(rcl_node_impl_t), allocator->state);
+  node->impl = (rcl_node_impl_t *)arena_allocator.allocate(
+    sizeof(rcl_node_impl_t), arena_allocator.state);
   RCL_CHECK_FOR_NULL_WITH_MSG(
     node->impl, "allocating memory failed", ret = RCL_RET_BAD_ALLOC; goto cleanup);
+  node->impl->arena = arena;
   node->impl->rmw_node_handle = NULL;
   node->impl->graph_guard_condition = NULL;
   node->impl->logger_name = NULL;
   node->impl->fq_name = NULL;
+  node->impl->resolved_names = NULL;
+  node->impl->num_resolved_names = 0;
+  node->impl->resolved_names_capacity = 0;
+  node->impl->substitutions_map = rcutils_get_zero_initialized_string_map();
+  node->impl->substitutions_map_valid = false;
+  node->impl->manual_liveliness_publishers = NULL;
+  node->impl->num_manual_liveliness_publishers = 0;
+  node->impl->manual_liveliness_publishers_capacity = 0;
+  node->impl->num_publishers = 0;
+  node->impl->num_subscriptions = 0;
+  node->impl->num_clients = 0;
+  node->impl->num_services = 0;
   node->impl->options = rcl_node_get_default_options();
   node->context = context;
   // Initialize node impl.
@@ -220,7 +387,7 @@ rcl_node_init(
     global_args = &(node->context->global_arguments);
   }
   ret = rcl_remap_node_name(
-    &(node->impl->options.arguments), global_args, name, *allocator,
+    &(node->impl->options.arguments), global_args, name, arena_allocator,
     &remapped_node_name);
   if (RCL_RET_OK != ret) {
     goto fail;
@@ -230,33 +397,30 @@ rcl_node_init(
   char * remapped_namespace = NULL;
   ret = rcl_remap_node_namespace(
     &(node->impl->options.arguments), global_args, name,
-    *allocator, &remapped_namespace);
+    arena_allocator, &remapped_namespace);
   if (RCL_RET_OK != ret) {
     goto fail;
   } else if (NULL != remapped_namespace) {
-    if (should_free_local_namespace_) {
-      allocator->deallocate((char *)local_namespace_, allocator->state);
-    }
-    should_free_local_namespace_ = true;
     local_namespace_ = remapped_namespace;
   }
 
   // compute fully qualfied name of the node.
   if ('/' == local_namespace_[strlen(local_namespace_) - 1]) {
-    node->impl->fq_name = rcutils_format_string(*allocator, "%s%s", local_namespace_, name);
+    node->impl->fq_name = rcutils_format_string(arena_allocator, "%s%s", local_namespace_, name);
   } else {
-    node->impl->fq_name = rcutils_format_string(*allocator, "%s/%s", local_namespace_, name);
+    node->impl->fq_name = rcutils_format_string(arena_allocator, "%s/%s", local_namespace_, name);
   }
 
   // node logger name
-  node->impl->logger_name = rcl_create_node_logger_name(name, local_namespace_, allocator);
+  node->impl->logger_name = rcl_create_node_logger_name(name, local_namespace_, &arena_allocator);
   RCL_CHECK_FOR_NULL_WITH_MSG(
     node->impl->logger_name, "creating logger name failed", goto fail);
 
   // node rmw_node_handle
   if (node->impl->options.domain_id == RCL_NODE_OPTIONS_DEFAULT_DOMAIN_ID) {
-    // Find the domain ID set by the environment.
-    ret = rcl_impl_getenv("ROS_DOMAIN_ID", &ros_domain_id);
+    // Find the domain ID set by the environment, served from the snapshot
+    // taken at init so every node init does not re-read the environment.
+    ret = rcl_context_getenv(context, "ROS_DOMAIN_ID", &ros_domain_id);
     if (ret != RCL_RET_OK) {
       goto fail;
     }
@@ -278,7 +442,9 @@ rcl_node_init(
   const char * ros_security_enable = NULL;
   const char * ros_enforce_security = NULL;
 
-  if (rcutils_get_env(ROS_SECURITY_ENABLE_VAR_NAME, &ros_security_enable)) {
+  if (RCL_RET_OK != rcl_context_getenv(
+      context, ROS_SECURITY_ENABLE_VAR_NAME, &ros_security_enable))
+  {
     RCL_SET_ERROR_MSG(
       "Environment variable " RCUTILS_STRINGIFY(ROS_SECURITY_ENABLE_VAR_NAME)
       " could not be read");
@@ -286,11 +452,14 @@ rcl_node_init(
     goto fail;
   }
 
-  bool use_security = (0 == strcmp(ros_security_enable, "true"));
+  bool use_security =
+    (NULL != ros_security_enable && 0 == strcmp(ros_security_enable, "true"));
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME, "Using security: %s", use_security ? "true" : "false");
 
-  if (rcutils_get_env(ROS_SECURITY_STRATEGY_VAR_NAME, &ros_enforce_security)) {
+  if (RCL_RET_OK != rcl_context_getenv(
+      context, ROS_SECURITY_STRATEGY_VAR_NAME, &ros_enforce_security))
+  {
     RCL_SET_ERROR_MSG(
       "Environment variable " RCUTILS_STRINGIFY(ROS_SECURITY_STRATEGY_VAR_NAME)
       " could not be read");
@@ -300,21 +469,39 @@ rcl_node_init(
 
   rmw_node_security_options_t node_security_options =
     rmw_get_zero_initialized_node_security_options();
-  node_security_options.enforce_security = (0 == strcmp(ros_enforce_security, "Enforce")) ?
+  node_security_options.enforce_security =
+    (NULL != ros_enforce_security && 0 == strcmp(ros_enforce_security, "Enforce")) ?
     RMW_SECURITY_ENFORCEMENT_ENFORCE : RMW_SECURITY_ENFORCEMENT_PERMISSIVE;
 
   if (!use_security) {
     node_security_options.enforce_security = RMW_SECURITY_ENFORCEMENT_PERMISSIVE;
   } else {  // if use_security
-    // File discovery magic here
-    node_secure_root = rcl_get_secure_root(name, local_namespace_, allocator);
+    // Serve the secure root from the bringup cache when possible; cached
+    // roots are re-validated as directories so a moved keystore falls back
+    // to the full lookup below.
+    char * secroot_key = rcutils_format_string(
+      *allocator, "secroot:%s:%s", name, local_namespace_);
+    if (NULL != secroot_key) {
+      const char * cached_root = rcl_bringup_cache_lookup(context, secroot_key);
+      if (NULL != cached_root && rcutils_is_directory(cached_root)) {
+        node_secure_root = rcutils_strdup(cached_root, *allocator);
+      }
+    }
+    if (NULL == node_secure_root) {
+      // File discovery magic here
+      node_secure_root = rcl_get_secure_root(name, local_namespace_, allocator);
+      if (NULL != node_secure_root && NULL != secroot_key) {
+        rcl_bringup_cache_store(context, secroot_key, node_secure_root);
+      }
+    }
+    allocator->deallocate(secroot_key, allocator->state);
     if (node_secure_root) {
       RCUTILS_LOG_INFO_NAMED(ROS_PACKAGE_NAME, "Found security directory: %s", node_secure_root);
       node_security_options.security_root_path = node_secure_root;
     } else {
       if (RMW_SECURITY_ENFORCEMENT_ENFORCE == node_security_options.enforce_security) {
         ret = RCL_RET_ERROR;
-        goto cleanup;
+        goto fail;
       }
     }
   }
@@ -329,23 +516,28 @@ rcl_node_init(
   RCL_CHECK_FOR_NULL_WITH_MSG(
     rmw_graph_guard_condition, rmw_get_error_string().str, goto fail);
 
-  node->impl->graph_guard_condition = (rcl_guard_condition_t *)allocator->allocate(
-    sizeof(rcl_guard_condition_t), allocator->state);
-  RCL_CHECK_FOR_NULL_WITH_MSG(
-    node->impl->graph_guard_condition,
-    "allocating memory failed",
-    goto fail);
-  *node->impl->graph_guard_condition = rcl_get_zero_initialized_guard_condition();
-  graph_guard_condition_options.allocator = *allocator;
-  ret = rcl_guard_condition_init_from_rmw(
-    node->impl->graph_guard_condition,
-    rmw_graph_guard_condition,
-    context,
-    graph_guard_condition_options);
+  // All nodes in a context observe the same graph events, so the context
+  // keeps one shared condition instead of contributing one rmw condition
+  // per node to every wait set that watches the graph.
+  ret = rcl_graph_guard_acquire(
+    context, rmw_graph_guard_condition, &node->impl->graph_guard_condition);
   if (ret != RCL_RET_OK) {
     // error message already set
     goto fail;
   }
+  // Build the substitutions map once; name expansions borrow it from here on
+  rcutils_ret_t rcutils_ret =
+    rcutils_string_map_init(&(node->impl->substitutions_map), 0, *allocator);
+  if (RCUTILS_RET_OK != rcutils_ret) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    ret = RCUTILS_RET_BAD_ALLOC == rcutils_ret ? RCL_RET_BAD_ALLOC : RCL_RET_ERROR;
+    goto fail;
+  }
+  node->impl->substitutions_map_valid = true;
+  ret = rcl_get_default_topic_name_substitutions(&(node->impl->substitutions_map));
+  if (RCL_RET_OK != ret) {
+    goto fail;
+  }
   // The initialization for the rosout publisher requires the node to be in initialized to a point
   // that it can create new topic publishers
   ret = rcl_logging_rosout_init_publisher_for_node(node);
@@ -362,10 +554,23 @@ fail:
       ret = rcl_logging_rosout_fini_publisher_for_node(node);
       RCUTILS_LOG_ERROR_EXPRESSION_NAMED((ret != RCL_RET_OK && ret != RCL_RET_NOT_INIT),
         ROS_PACKAGE_NAME, "Failed to fini publisher for node: %i", ret);
-      allocator->deallocate((char *)node->impl->logger_name, allocator->state);
     }
-    if (node->impl->fq_name) {
-      allocator->deallocate((char *)node->impl->fq_name, allocator->state);
+    _rcl_node_free_resolved_names(node->impl, node->context, allocator);
+    if (node->impl->manual_liveliness_publishers) {
+      allocator->deallocate(node->impl->manual_liveliness_publishers, allocator->state);
+      node->impl->manual_liveliness_publishers = NULL;
+    }
+    if (node->impl->substitutions_map_valid) {
+      if (RCUTILS_RET_OK != rcutils_string_map_fini(&(node->impl->substitutions_map))) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to fini substitutions map in error recovery");
+      }
+      node->impl->substitutions_map_valid = false;
+    }
+    if (node->impl->graph_guard_condition && node->impl->rmw_node_handle) {
+      // Must happen before the rmw node (and with it the donor rmw graph
+      // guard condition) is destroyed.
+      rcl_graph_guard_release(node->context, rmw_graph_guard_condition);
     }
     if (node->impl->rmw_node_handle) {
       ret = rmw_destroy_node(node->impl->rmw_node_handle);
@@ -376,16 +581,6 @@ fail:
         );
       }
     }
-    if (node->impl->graph_guard_condition) {
-      ret = rcl_guard_condition_fini(node->impl->graph_guard_condition);
-      if (ret != RCL_RET_OK) {
-        RCUTILS_LOG_ERROR_NAMED(
-          ROS_PACKAGE_NAME,
-          "failed to fini guard condition in error recovery: %s", rcl_get_error_string().str
-        );
-      }
-      allocator->deallocate(node->impl->graph_guard_condition, allocator->state);
-    }
     if (NULL != node->impl->options.arguments.impl) {
       ret = rcl_arguments_fini(&(node->impl->options.arguments));
       if (ret != RCL_RET_OK) {
@@ -395,66 +590,232 @@ fail:
         );
       }
     }
-    allocator->deallocate(node->impl, allocator->state);
   }
   *node = rcl_get_zero_initialized_node();
 
   ret = fail_ret;
   // fall through from fail -> cleanup
 cleanup:
-  if (should_free_local_namespace_) {
-    allocator->deallocate((char *)local_namespace_, allocator->state);
-    local_namespace_ = NULL;
-  }
-  if (NULL != remapped_node_name) {
-    allocator->deallocate(remapped_node_name, allocator->state);
+  if (NULL == node->impl) {
+    // init failed before the node took ownership of the arena; this also
+    // releases the impl struct and any namespace or remapped name strings
+    rcl_arena_destroy(arena);
   }
   allocator->deallocate(node_secure_root, allocator->state);
   return ret;
 }
 
-rcl_ret_t
-rcl_node_fini(rcl_node_t * node)
+// Implementation only: the rcl side teardown which has to happen while the
+// node's rmw handle is still alive (rosout publisher, shared graph guard).
+static rcl_ret_t
+_rcl_node_fini_prepare(rcl_node_t * node)
 {
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Finalizing node");
-  RCL_CHECK_ARGUMENT_FOR_NULL(node, RCL_RET_NODE_INVALID);
-  if (!node->impl) {
-    // Repeat calls to fini or calling fini on a zero initialized node is ok.
-    return RCL_RET_OK;
-  }
-  rcl_allocator_t allocator = node->impl->options.allocator;
   rcl_ret_t result = RCL_RET_OK;
   rcl_ret_t rcl_ret = rcl_logging_rosout_fini_publisher_for_node(node);
   if (rcl_ret != RCL_RET_OK && rcl_ret != RCL_RET_NOT_INIT) {
     RCL_SET_ERROR_MSG("Unable to fini publisher for node.");
     result = RCL_RET_ERROR;
   }
-  rmw_ret_t rmw_ret = rmw_destroy_node(node->impl->rmw_node_handle);
-  if (rmw_ret != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    result = RCL_RET_ERROR;
+  // Drop this node from the shared graph guard condition before the rmw node
+  // (and with it this node's rmw graph guard condition) is destroyed.
+  rcl_graph_guard_release(
+    node->context, rmw_node_get_graph_guard_condition(node->impl->rmw_node_handle));
+  return result;
+}
+
+// Implementation only: release the rcl side memory after the rmw handle is
+// gone.
+static rcl_ret_t
+_rcl_node_fini_release(rcl_node_t * node)
+{
+  rcl_allocator_t allocator = node->impl->options.allocator;
+  rcl_ret_t result = RCL_RET_OK;
+  // the logger name and fully qualified name live in the node's arena and
+  // are released with it below
+  _rcl_node_free_resolved_names(node->impl, node->context, &allocator);
+  if (node->impl->manual_liveliness_publishers) {
+    allocator.deallocate(node->impl->manual_liveliness_publishers, allocator.state);
+    node->impl->manual_liveliness_publishers = NULL;
   }
-  rcl_ret = rcl_guard_condition_fini(node->impl->graph_guard_condition);
-  if (rcl_ret != RCL_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    result = RCL_RET_ERROR;
+  if (node->impl->substitutions_map_valid) {
+    if (RCUTILS_RET_OK != rcutils_string_map_fini(&(node->impl->substitutions_map))) {
+      RCL_SET_ERROR_MSG("failed to fini substitutions map");
+      result = RCL_RET_ERROR;
+    }
+    node->impl->substitutions_map_valid = false;
   }
-  allocator.deallocate(node->impl->graph_guard_condition, allocator.state);
-  // assuming that allocate and deallocate are ok since they are checked in init
-  allocator.deallocate((char *)node->impl->logger_name, allocator.state);
-  allocator.deallocate((char *)node->impl->fq_name, allocator.state);
   if (NULL != node->impl->options.arguments.impl) {
     rcl_ret_t ret = rcl_arguments_fini(&(node->impl->options.arguments));
     if (ret != RCL_RET_OK) {
       return ret;
     }
   }
-  allocator.deallocate(node->impl, allocator.state);
+  // release the impl struct and everything else allocated from the arena
+  rcl_arena_destroy(node->impl->arena);
   node->impl = NULL;
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Node finalized");
   return result;
 }
 
+rcl_ret_t
+rcl_node_fini(rcl_node_t * node)
+{
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Finalizing node");
+  RCL_CHECK_ARGUMENT_FOR_NULL(node, RCL_RET_NODE_INVALID);
+  if (!node->impl) {
+    // Repeat calls to fini or calling fini on a zero initialized node is ok.
+    return RCL_RET_OK;
+  }
+  rcl_ret_t result = _rcl_node_fini_prepare(node);
+  rmw_ret_t rmw_ret = rmw_destroy_node(node->impl->rmw_node_handle);
+  if (rmw_ret != RMW_RET_OK) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    result = RCL_RET_ERROR;
+  }
+  rcl_ret_t release_ret = _rcl_node_fini_release(node);
+  if (RCL_RET_OK != release_ret) {
+    result = release_ret;
+  }
+  return result;
+}
+
+#ifndef _WIN32
+// Implementation only: worker destroying a slice of rmw node handles.
+typedef struct rcl_nodes_fini_task_t
+{
+  rmw_node_t ** rmw_node_handles;
+  size_t number_of_handles;
+  rmw_ret_t ret;
+} rcl_nodes_fini_task_t;
+
+// Implementation only
+static void *
+_rcl_nodes_fini_task(void * arg)
+{
+  rcl_nodes_fini_task_t * task = (rcl_nodes_fini_task_t *)arg;
+  for (size_t i = 0; i < task->number_of_handles; ++i) {
+    rmw_ret_t ret = rmw_destroy_node(task->rmw_node_handles[i]);
+    if (RMW_RET_OK != ret) {
+      task->ret = ret;
+      rmw_reset_error();
+    }
+  }
+  return NULL;
+}
+#endif  // _WIN32
+
+rcl_ret_t
+rcl_nodes_fini(rcl_node_t ** nodes, size_t number_of_nodes)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(nodes, RCL_RET_INVALID_ARGUMENT);
+  for (size_t i = 0; i < number_of_nodes; ++i) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(nodes[i], RCL_RET_NODE_INVALID);
+  }
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Finalizing %zu nodes", number_of_nodes);
+  rcl_ret_t result = RCL_RET_OK;
+  // Phase one, serial: detach every node from the shared context state while
+  // the rmw handles are all still alive.
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  size_t number_of_handles = 0;
+  for (size_t i = 0; i < number_of_nodes; ++i) {
+    if (!nodes[i]->impl) {
+      // As with rcl_node_fini, already finalized nodes are ok.
+      continue;
+    }
+    allocator = nodes[i]->impl->options.allocator;
+    rcl_ret_t ret = _rcl_node_fini_prepare(nodes[i]);
+    if (RCL_RET_OK != ret) {
+      result = ret;
+    }
+    ++number_of_handles;
+  }
+  if (0 == number_of_handles) {
+    return result;
+  }
+  // Phase two: destroy the rmw nodes, several at a time.  Middleware
+  // teardown waits on per-node network unadvertisement, so overlapping the
+  // waits brings the total down to roughly the slowest node.
+  rmw_node_t ** handles = (rmw_node_t **)allocator.allocate(
+    number_of_handles * sizeof(rmw_node_t *), allocator.state);
+  if (NULL == handles) {
+    // Not enough memory to stage the batch; fall back to destroying the
+    // handles one by one.
+    for (size_t i = 0; i < number_of_nodes; ++i) {
+      if (nodes[i]->impl && RMW_RET_OK != rmw_destroy_node(nodes[i]->impl->rmw_node_handle)) {
+        RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+        result = RCL_RET_ERROR;
+      }
+    }
+  } else {
+    size_t handle_index = 0;
+    for (size_t i = 0; i < number_of_nodes; ++i) {
+      if (nodes[i]->impl) {
+        handles[handle_index++] = nodes[i]->impl->rmw_node_handle;
+      }
+    }
+    bool any_rmw_failure = false;
+#ifndef _WIN32
+    rcl_nodes_fini_task_t tasks[RCL_NODES_FINI_MAX_THREADS];
+    pthread_t threads[RCL_NODES_FINI_MAX_THREADS];
+    bool thread_started[RCL_NODES_FINI_MAX_THREADS];
+    size_t number_of_tasks = number_of_handles < RCL_NODES_FINI_MAX_THREADS ?
+      number_of_handles : RCL_NODES_FINI_MAX_THREADS;
+    size_t slice_start = 0;
+    for (size_t t = 0; t < number_of_tasks; ++t) {
+      // Contiguous slices, the first tasks taking the remainder.
+      size_t slice_size = number_of_handles / number_of_tasks +
+        ((t < number_of_handles % number_of_tasks) ? 1 : 0);
+      tasks[t].rmw_node_handles = handles + slice_start;
+      tasks[t].number_of_handles = slice_size;
+      tasks[t].ret = RMW_RET_OK;
+      slice_start += slice_size;
+      // The first slice runs on this thread below.
+      thread_started[t] = (0 != t) &&
+        (0 == pthread_create(&threads[t], NULL, _rcl_nodes_fini_task, &tasks[t]));
+    }
+    for (size_t t = 0; t < number_of_tasks; ++t) {
+      if (0 == t || !thread_started[t]) {
+        _rcl_nodes_fini_task(&tasks[t]);
+      }
+    }
+    for (size_t t = 1; t < number_of_tasks; ++t) {
+      if (thread_started[t]) {
+        pthread_join(threads[t], NULL);
+      }
+    }
+    for (size_t t = 0; t < number_of_tasks; ++t) {
+      if (RMW_RET_OK != tasks[t].ret) {
+        any_rmw_failure = true;
+      }
+    }
+#else
+    for (size_t i = 0; i < number_of_handles; ++i) {
+      if (RMW_RET_OK != rmw_destroy_node(handles[i])) {
+        any_rmw_failure = true;
+        rmw_reset_error();
+      }
+    }
+#endif  // _WIN32
+    if (any_rmw_failure) {
+      RCL_SET_ERROR_MSG("failed to destroy one or more rmw nodes");
+      result = RCL_RET_ERROR;
+    }
+    allocator.deallocate(handles, allocator.state);
+  }
+  // Phase three, serial: release the rcl side memory of every node.
+  for (size_t i = 0; i < number_of_nodes; ++i) {
+    if (!nodes[i]->impl) {
+      continue;
+    }
+    rcl_ret_t ret = _rcl_node_fini_release(nodes[i]);
+    if (RCL_RET_OK != ret) {
+      result = ret;
+    }
+  }
+  return result;
+}
+
 bool
 rcl_node_is_valid_except_context(const rcl_node_t * node)
 {
@@ -540,6 +901,69 @@ rcl_node_assert_liveliness(const rcl_node_t * node)
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_node_register_manual_liveliness_publisher(
+  const rcl_node_t * node,
+  rmw_publisher_t * rmw_publisher)
+{
+  rcl_node_impl_t * impl = node->impl;
+  rcl_allocator_t allocator = impl->options.allocator;
+  if (impl->num_manual_liveliness_publishers == impl->manual_liveliness_publishers_capacity) {
+    size_t new_capacity = impl->manual_liveliness_publishers_capacity ?
+      2 * impl->manual_liveliness_publishers_capacity : 8;
+    rmw_publisher_t ** grown = allocator.reallocate(
+      impl->manual_liveliness_publishers,
+      new_capacity * sizeof(rmw_publisher_t *), allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      grown, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    impl->manual_liveliness_publishers = grown;
+    impl->manual_liveliness_publishers_capacity = new_capacity;
+  }
+  impl->manual_liveliness_publishers[impl->num_manual_liveliness_publishers++] = rmw_publisher;
+  return RCL_RET_OK;
+}
+
+void
+rcl_node_unregister_manual_liveliness_publisher(
+  const rcl_node_t * node,
+  const rmw_publisher_t * rmw_publisher)
+{
+  rcl_node_impl_t * impl = node->impl;
+  for (size_t i = 0; i < impl->num_manual_liveliness_publishers; ++i) {
+    if (impl->manual_liveliness_publishers[i] == rmw_publisher) {
+      // Order is irrelevant, so fill the hole with the last entry.
+      impl->manual_liveliness_publishers[i] =
+        impl->manual_liveliness_publishers[--impl->num_manual_liveliness_publishers];
+      return;
+    }
+  }
+}
+
+rcl_ret_t
+rcl_node_assert_liveliness_batch(const rcl_node_t * node)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  // One pass covers the node itself and every manual-by-topic publisher, so a
+  // keepalive timer makes one rcl call per period regardless of how many
+  // publishers the node has.
+  if (rmw_node_assert_liveliness(node->impl->rmw_node_handle) != RMW_RET_OK) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return RCL_RET_ERROR;
+  }
+  for (size_t i = 0; i < node->impl->num_manual_liveliness_publishers; ++i) {
+    if (
+      rmw_publisher_assert_liveliness(
+        node->impl->manual_liveliness_publishers[i]) != RMW_RET_OK)
+    {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+  }
+  return RCL_RET_OK;
+}
+
 rmw_node_t *
 rcl_node_get_rmw_handle(const rcl_node_t * node)
 {
@@ -576,6 +1000,28 @@ rcl_node_get_logger_name(const rcl_node_t * node)
   return node->impl->logger_name;
 }
 
+rcl_ret_t
+rcl_node_get_resource_stats(const rcl_node_t * node, rcl_node_resource_stats_t * stats)
+{
+  if (!rcl_node_is_valid_except_context(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  const rcl_node_impl_t * impl = node->impl;
+  stats->num_publishers = impl->num_publishers;
+  stats->num_subscriptions = impl->num_subscriptions;
+  stats->num_clients = impl->num_clients;
+  stats->num_services = impl->num_services;
+  stats->impl_bytes = rcl_arena_bytes_in_use(impl->arena);
+  // the registries grow with the backing allocator, not the arena, so their
+  // capacity is counted separately
+  stats->registry_bytes =
+    impl->resolved_names_capacity * sizeof(rcl_resolved_name_t) +
+    impl->manual_liveliness_publishers_capacity * sizeof(rmw_publisher_t *);
+  return rcl_logging_rosout_get_footprint_for_node(
+    node, &stats->rosout_publisher_created, &stats->rosout_bytes);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,159 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__NODE_IMPL_H_
+#define RCL__NODE_IMPL_H_
+
+#include <stdbool.h>
+
+#include "./arena.h"
+#include "rcl/guard_condition.h"
+#include "rcl/node.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+#include "rcutils/types/string_map.h"
+#include "rmw/types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// \internal A cached fully resolved (expanded and remapped) entity name.
+/**
+ * Both strings are interned in the node's context, so nodes sharing topics
+ * like "/rosout" or "/parameter_events" also share one copy of each name.
+ */
+typedef struct rcl_resolved_name_t
+{
+  /// The name as passed at entity creation; interned.
+  const char * input_name;
+  /// The fully qualified name after expansion and remapping; interned.
+  const char * resolved_name;
+  /// Whether the name was resolved with service or with topic remap rules.
+  bool is_service;
+} rcl_resolved_name_t;
+
+typedef struct rcl_node_impl_t
+{
+  /// Arena the impl struct and the name strings are allocated from;
+  /// released as one block in rcl_node_fini().
+  rcl_arena_t * arena;
+  rcl_node_options_t options;
+  size_t actual_domain_id;
+  rmw_node_t * rmw_node_handle;
+  /// The context's shared graph guard condition; owned by the context's
+  /// graph guard registry, not by the node.
+  rcl_guard_condition_t * graph_guard_condition;
+  const char * logger_name;
+  const char * fq_name;
+  /// Cache of resolved entity names, keyed by input name and entity kind.
+  /// The node's name, namespace and arguments are fixed after init, so a
+  /// given input name always resolves the same way for this node.
+  rcl_resolved_name_t * resolved_names;
+  /// Number of entries in resolved_names.
+  size_t num_resolved_names;
+  /// Allocated capacity of resolved_names.
+  size_t resolved_names_capacity;
+  /// Topic name substitutions map, built once at init and borrowed by every
+  /// name expansion; never invalidated since the node's name and namespace
+  /// are immutable.
+  rcutils_string_map_t substitutions_map;
+  /// Whether substitutions_map has been initialized.
+  bool substitutions_map_valid;
+  /// rmw handles of this node's publishers with MANUAL_BY_TOPIC liveliness,
+  /// registered by rcl_publisher_init() so that
+  /// rcl_node_assert_liveliness_batch() can assert them in one traversal.
+  rmw_publisher_t ** manual_liveliness_publishers;
+  /// Number of entries in manual_liveliness_publishers.
+  size_t num_manual_liveliness_publishers;
+  /// Allocated capacity of manual_liveliness_publishers.
+  size_t manual_liveliness_publishers_capacity;
+  /// Live entity counts, maintained by the entity init/fini functions and
+  /// reported by rcl_node_get_resource_stats().
+  size_t num_publishers;
+  size_t num_subscriptions;
+  size_t num_clients;
+  size_t num_services;
+} rcl_node_impl_t;
+
+/// \internal Resolve an entity name to its expanded and remapped form.
+/**
+ * Runs the rcl_expand_topic_name() plus rcl_remap_topic_name() /
+ * rcl_remap_service_name() chain for a name given at entity creation, and
+ * caches the result in the node so that recreating an entity with the same
+ * name skips the chain and its substitution map allocations entirely.
+ *
+ * The returned name is allocated with the given allocator and owned by the
+ * caller; it is not validated here, callers keep their own validation.
+ *
+ * \param[in] node the node the entity is being created on
+ * \param[in] input_name the topic or service name given at entity creation
+ * \param[in] allocator allocator used for the returned name
+ * \param[in] is_service true to apply service remap rules, false for topic rules
+ * \param[out] output_name the fully qualified expanded and remapped name
+ * \return `RCL_RET_OK` if the name was resolved, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_TOPIC_NAME_INVALID` if the name could not be expanded, or
+ * \return `RCL_RET_UNKNOWN_SUBSTITUTION` for unknown substitutions in the name, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_LOCAL
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_node_resolve_name(
+  const rcl_node_t * node,
+  const char * input_name,
+  rcl_allocator_t allocator,
+  bool is_service,
+  char ** output_name);
+
+/// \internal Register a manual-by-topic liveliness publisher with its node.
+/**
+ * Called by rcl_publisher_init() for publishers created with
+ * RMW_QOS_POLICY_LIVELINESS_MANUAL_BY_TOPIC, so that
+ * rcl_node_assert_liveliness_batch() can reach them without a graph query.
+ *
+ * \param[in] node the node the publisher was created on
+ * \param[in] rmw_publisher the publisher's rmw handle
+ * \return `RCL_RET_OK` if the publisher was registered, or
+ * \return `RCL_RET_BAD_ALLOC` if growing the registry failed.
+ */
+RCL_LOCAL
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_node_register_manual_liveliness_publisher(
+  const rcl_node_t * node,
+  rmw_publisher_t * rmw_publisher);
+
+/// \internal Remove a publisher from the node's manual liveliness registry.
+/**
+ * Called by rcl_publisher_fini(); unknown handles are silently ignored.
+ *
+ * \param[in] node the node the publisher was created on
+ * \param[in] rmw_publisher the publisher's rmw handle
+ */
+RCL_LOCAL
+void
+rcl_node_unregister_manual_liveliness_publisher(
+  const rcl_node_t * node,
+  const rmw_publisher_t * rmw_publisher);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__NODE_IMPL_H_
@@ -19,18 +19,22 @@ extern "C"
 
 #include "rcl/publisher.h"
 
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "rcl/allocator.h"
 #include "rcl/error_handling.h"
-#include "rcl/expand_topic_name.h"
-#include "rcl/remap.h"
+#include "rcl/time.h"
+#include "rcl/tracepoint.h"
 #include "rcutils/logging_macros.h"
 #include "rmw/error_handling.h"
 #include "rmw/validate_full_topic_name.h"
 
 #include "./common.h"
+#include "./context_impl.h"
+#include "./intra_context.h"
+#include "./node_impl.h"
 #include "./publisher_impl.h"
 
 rcl_publisher_t
@@ -70,75 +74,20 @@ rcl_publisher_init(
     ROS_PACKAGE_NAME, "Initializing publisher for topic name '%s'", topic_name);
 
 
-  // Expand the given topic name.
-  rcutils_allocator_t rcutils_allocator = *allocator;  // implicit conversion to rcutils version
-  rcutils_string_map_t substitutions_map = rcutils_get_zero_initialized_string_map();
-  rcutils_ret_t rcutils_ret = rcutils_string_map_init(&substitutions_map, 0, rcutils_allocator);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    if (rcutils_ret == RCUTILS_RET_BAD_ALLOC) {
-      return RCL_RET_BAD_ALLOC;
-    }
-    return RCL_RET_ERROR;
-  }
-  rcl_ret_t ret = rcl_get_default_topic_name_substitutions(&substitutions_map);
-  if (ret != RCL_RET_OK) {
-    rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-    if (rcutils_ret != RCUTILS_RET_OK) {
-      RCUTILS_LOG_ERROR_NAMED(
-        ROS_PACKAGE_NAME,
-        "failed to fini string_map (%d) during error handling: %s",
-        rcutils_ret,
-        rcutils_get_error_string().str);
-    }
-    if (ret == RCL_RET_BAD_ALLOC) {
-      return ret;
-    }
-    return RCL_RET_ERROR;
-  }
-  char * expanded_topic_name = NULL;
+  // Expand and remap the given topic name.
   char * remapped_topic_name = NULL;
-  ret = rcl_expand_topic_name(
-    topic_name,
-    rcl_node_get_name(node),
-    rcl_node_get_namespace(node),
-    &substitutions_map,
-    *allocator,
-    &expanded_topic_name);
-  rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    ret = RCL_RET_ERROR;
-    goto cleanup;
-  }
-  if (ret != RCL_RET_OK) {
-    if (ret == RCL_RET_TOPIC_NAME_INVALID || ret == RCL_RET_UNKNOWN_SUBSTITUTION) {
+  rcl_ret_t ret = rcl_node_resolve_name(
+    node, topic_name, *allocator, false, &remapped_topic_name);
+  if (RCL_RET_OK != ret) {
+    if (RCL_RET_TOPIC_NAME_INVALID == ret || RCL_RET_UNKNOWN_SUBSTITUTION == ret) {
       ret = RCL_RET_TOPIC_NAME_INVALID;
-    } else {
+    } else if (RCL_RET_BAD_ALLOC != ret) {
       ret = RCL_RET_ERROR;
     }
     goto cleanup;
   }
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Expanded topic name '%s'", expanded_topic_name);
-
-  const rcl_node_options_t * node_options = rcl_node_get_options(node);
-  if (NULL == node_options) {
-    ret = RCL_RET_ERROR;
-    goto cleanup;
-  }
-  rcl_arguments_t * global_args = NULL;
-  if (node_options->use_global_arguments) {
-    global_args = &(node->context->global_arguments);
-  }
-  ret = rcl_remap_topic_name(
-    &(node_options->arguments), global_args, expanded_topic_name,
-    rcl_node_get_name(node), rcl_node_get_namespace(node), *allocator, &remapped_topic_name);
-  if (RCL_RET_OK != ret) {
-    goto fail;
-  } else if (NULL == remapped_topic_name) {
-    remapped_topic_name = expanded_topic_name;
-    expanded_topic_name = NULL;
-  }
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Expanded and remapped topic name '%s'", remapped_topic_name);
 
   // Validate the expanded topic name.
   int validation_result;
@@ -182,22 +131,104 @@ rcl_publisher_init(
     options->qos.avoid_ros_namespace_conventions;
   // options
   publisher->impl->options = *options;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Publisher initialized");
   // context
   publisher->impl->context = node->context;
+  // Accumulation buffer for batched publication, if enabled.
+  publisher->impl->batch_buffer = NULL;
+  publisher->impl->batch_count = 0;
+  if (options->batch_size > 0) {
+    publisher->impl->batch_buffer = (const void **)allocator->allocate(
+      options->batch_size * sizeof(const void *), allocator->state);
+    if (NULL == publisher->impl->batch_buffer) {
+      rmw_ret_t rmw_fail_ret = rmw_destroy_publisher(
+        rcl_node_get_rmw_handle(node), publisher->impl->rmw_handle);
+      if (RMW_RET_OK != rmw_fail_ret) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME,
+          "failed to destroy rmw publisher during error handling: %s",
+          rmw_get_error_string().str);
+      }
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      ret = RCL_RET_BAD_ALLOC;
+      goto fail;
+    }
+  }
+  // Preallocated message pool, if enabled; after this point the publisher
+  // serves rcl_publisher_alloc_message() without touching the allocator.
+  publisher->impl->message_pool_arena = NULL;
+  publisher->impl->message_pool_free = NULL;
+  publisher->impl->message_pool_free_count = 0;
+  publisher->impl->gather_buffer = NULL;
+  publisher->impl->gather_buffer_capacity = 0;
+  if (options->message_pool_message_size > 0 && options->message_pool_depth > 0) {
+    // Round each slot up so consecutive slots stay suitably aligned.
+    const size_t alignment = sizeof(max_align_t);
+    const size_t slot_size =
+      (options->message_pool_message_size + alignment - 1) / alignment * alignment;
+    publisher->impl->message_pool_arena = (uint8_t *)allocator->allocate(
+      slot_size * options->message_pool_depth, allocator->state);
+    publisher->impl->message_pool_free = (size_t *)allocator->allocate(
+      options->message_pool_depth * sizeof(size_t), allocator->state);
+    if (
+      NULL == publisher->impl->message_pool_arena ||
+      NULL == publisher->impl->message_pool_free)
+    {
+      rmw_ret_t rmw_fail_ret = rmw_destroy_publisher(
+        rcl_node_get_rmw_handle(node), publisher->impl->rmw_handle);
+      if (RMW_RET_OK != rmw_fail_ret) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME,
+          "failed to destroy rmw publisher during error handling: %s",
+          rmw_get_error_string().str);
+      }
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      ret = RCL_RET_BAD_ALLOC;
+      goto fail;
+    }
+    publisher->impl->message_pool_slot_size = slot_size;
+    for (size_t i = 0; i < options->message_pool_depth; ++i) {
+      publisher->impl->message_pool_free[i] = i;
+    }
+    publisher->impl->message_pool_free_count = options->message_pool_depth;
+  }
+  // Manual-by-topic liveliness publishers are registered with the node so
+  // rcl_node_assert_liveliness_batch() can assert them all in one traversal.
+  if (RMW_QOS_POLICY_LIVELINESS_MANUAL_BY_TOPIC == options->qos.liveliness) {
+    ret = rcl_node_register_manual_liveliness_publisher(node, publisher->impl->rmw_handle);
+    if (RCL_RET_OK != ret) {
+      rmw_ret_t rmw_fail_ret = rmw_destroy_publisher(
+        rcl_node_get_rmw_handle(node), publisher->impl->rmw_handle);
+      if (RMW_RET_OK != rmw_fail_ret) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME,
+          "failed to destroy rmw publisher during error handling: %s",
+          rmw_get_error_string().str);
+      }
+      fail_ret = ret;
+      goto fail;
+    }
+  }
+  ++(node->impl->num_publishers);
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Publisher initialized");
 
   goto cleanup;
 fail:
   if (publisher->impl) {
+    if (publisher->impl->batch_buffer) {
+      allocator->deallocate(publisher->impl->batch_buffer, allocator->state);
+    }
+    if (publisher->impl->message_pool_arena) {
+      allocator->deallocate(publisher->impl->message_pool_arena, allocator->state);
+    }
+    if (publisher->impl->message_pool_free) {
+      allocator->deallocate(publisher->impl->message_pool_free, allocator->state);
+    }
     allocator->deallocate(publisher->impl, allocator->state);
   }
 
   ret = fail_ret;
   // Fall through to cleanup
 cleanup:
-  if (NULL != expanded_topic_name) {
-    allocator->deallocate(expanded_topic_name, allocator->state);
-  }
   if (NULL != remapped_topic_name) {
     allocator->deallocate(remapped_topic_name, allocator->state);
   }
@@ -220,13 +251,45 @@ rcl_publisher_fini(rcl_publisher_t * publisher, rcl_node_t * node)
     if (!rmw_node) {
       return RCL_RET_INVALID_ARGUMENT;
     }
+    if (publisher->impl->batch_count > 0) {
+      // Best effort; messages still staged at fini would otherwise be lost.
+      rcl_ret_t flush_ret = rcl_publisher_flush(publisher);
+      if (RCL_RET_OK != flush_ret) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME,
+          "failed to flush staged messages while finalizing publisher: %s",
+          rcl_get_error_string().str);
+        rcl_reset_error();
+      }
+    }
+    if (
+      RMW_QOS_POLICY_LIVELINESS_MANUAL_BY_TOPIC ==
+      publisher->impl->options.qos.liveliness)
+    {
+      rcl_node_unregister_manual_liveliness_publisher(node, publisher->impl->rmw_handle);
+    }
     rmw_ret_t ret =
       rmw_destroy_publisher(rmw_node, publisher->impl->rmw_handle);
     if (ret != RMW_RET_OK) {
       RCL_SET_ERROR_MSG(rmw_get_error_string().str);
       result = RCL_RET_ERROR;
     }
+    if (publisher->impl->batch_buffer) {
+      allocator.deallocate(publisher->impl->batch_buffer, allocator.state);
+    }
+    if (publisher->impl->message_pool_arena) {
+      allocator.deallocate(publisher->impl->message_pool_arena, allocator.state);
+    }
+    if (publisher->impl->message_pool_free) {
+      allocator.deallocate(publisher->impl->message_pool_free, allocator.state);
+    }
+    if (publisher->impl->gather_buffer) {
+      allocator.deallocate(publisher->impl->gather_buffer, allocator.state);
+    }
     allocator.deallocate(publisher->impl, allocator.state);
+    if (node->impl->num_publishers > 0) {
+      --(node->impl->num_publishers);
+    }
   }
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Publisher finalized");
   return result;
@@ -243,20 +306,192 @@ rcl_publisher_get_default_options()
   return default_options;
 }
 
+rcl_ret_t
+rcl_borrow_loaned_message(
+  const rcl_publisher_t * publisher,
+  const rosidl_message_type_support_t * type_support,
+  void ** ros_message)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(type_support, RCL_RET_INVALID_ARGUMENT);
+
+  rmw_ret_t ret = rmw_borrow_loaned_message(
+    publisher->impl->rmw_handle, type_support, ros_message);
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(ret);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_return_loaned_message_from_publisher(
+  const rcl_publisher_t * publisher,
+  void * loaned_message)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(loaned_message, RCL_RET_INVALID_ARGUMENT);
+
+  rmw_ret_t ret = rmw_return_loaned_message_from_publisher(
+    publisher->impl->rmw_handle, loaned_message);
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(ret);
+  }
+  return RCL_RET_OK;
+}
+
+// Record the rmw error state; out of line to keep the publish hot path small.
+static RCL_COLD rcl_ret_t
+_rcl_publish_rmw_failed(void)
+{
+  RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+  return RCL_RET_ERROR;
+}
+
+// Record the rcutils clock error; out of line, as above.
+static RCL_COLD rcl_ret_t
+_rcl_publish_clock_failed(void)
+{
+  RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+  return RCL_RET_ERROR;
+}
+
+// Publish with validation already done, shared by the checked and unchecked
+// entry points.
+static rcl_ret_t
+_rcl_publish_validated(
+  const rcl_publisher_t * publisher,
+  const void * ros_message,
+  rmw_publisher_allocation_t * allocation)
+{
+  if (publisher->impl->options.enable_intra_context_delivery) {
+    size_t matched = 0;
+    rcl_ret_t ret = rcl_intra_context_deliver(
+      publisher->impl->context,
+      publisher->impl->rmw_handle->topic_name,
+      ros_message,
+      &matched);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    if (matched > 0) {
+      // At least one same-context subscription took delivery; skip rmw.
+      return RCL_RET_OK;
+    }
+  }
+  if (NULL != publisher->impl->batch_buffer) {
+    rcl_publisher_impl_t * impl = publisher->impl;
+    if (0 == impl->batch_count) {
+      if (RCL_UNLIKELY(RCUTILS_RET_OK != rcutils_steady_time_now(&impl->batch_start_time))) {
+        return _rcl_publish_clock_failed();
+      }
+    }
+    impl->batch_buffer[impl->batch_count++] = ros_message;
+    bool flush_needed = impl->batch_count >= impl->options.batch_size;
+    if (!flush_needed && impl->options.batch_timeout > 0) {
+      rcutils_time_point_value_t now = 0;
+      if (RCL_UNLIKELY(RCUTILS_RET_OK != rcutils_steady_time_now(&now))) {
+        return _rcl_publish_clock_failed();
+      }
+      flush_needed = now - impl->batch_start_time >= impl->options.batch_timeout;
+    }
+    if (flush_needed) {
+      return rcl_publisher_flush(publisher);
+    }
+    return RCL_RET_OK;
+  }
+  if (RCL_UNLIKELY(rmw_publish(publisher->impl->rmw_handle, ros_message, allocation) !=
+    RMW_RET_OK))
+  {
+    return _rcl_publish_rmw_failed();
+  }
+  return RCL_RET_OK;
+}
+
+// Implementation only
+static rcl_ret_t
+_rcl_publish_impl(
+  const rcl_publisher_t * publisher,
+  const void * ros_message,
+  rmw_publisher_allocation_t * allocation)
+{
+  if (RCL_UNLIKELY(!RCL_RUNTIME_CHECK(rcl_publisher_is_valid(publisher)))) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  return _rcl_publish_validated(publisher, ros_message, allocation);
+}
+
 rcl_ret_t
 rcl_publish(
   const rcl_publisher_t * publisher,
   const void * ros_message,
   rmw_publisher_allocation_t * allocation)
+{
+  RCL_TRACEPOINT(rcl_publish_entry, publisher);
+  rcl_ret_t ret = _rcl_publish_impl(publisher, ros_message, allocation);
+  if (RCL_RET_OK == ret) {
+    rcl_context_counter_add(
+      publisher->impl->context, RCL_CONTEXT_COUNTER_MESSAGES_PUBLISHED, 1);
+  }
+  RCL_TRACEPOINT(rcl_publish_exit, publisher);
+  return ret;
+}
+
+rcl_ret_t
+rcl_publisher_get_validation_token(
+  const rcl_publisher_t * publisher,
+  rcl_publisher_validation_token_t * token)
 {
   if (!rcl_publisher_is_valid(publisher)) {
     return RCL_RET_PUBLISHER_INVALID;  // error already set
   }
-  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
-  if (rmw_publish(publisher->impl->rmw_handle, ros_message, allocation) != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    return RCL_RET_ERROR;
+  RCL_CHECK_ARGUMENT_FOR_NULL(token, RCL_RET_INVALID_ARGUMENT);
+  token->publisher = publisher;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_publish_unchecked(
+  const rcl_publisher_validation_token_t * token,
+  const void * ros_message,
+  rmw_publisher_allocation_t * allocation)
+{
+  const rcl_publisher_t * publisher = token->publisher;
+  RCL_TRACEPOINT(rcl_publish_entry, publisher);
+  rcl_ret_t ret = _rcl_publish_validated(publisher, ros_message, allocation);
+  if (RCL_RET_OK == ret) {
+    rcl_context_counter_add(
+      publisher->impl->context, RCL_CONTEXT_COUNTER_MESSAGES_PUBLISHED, 1);
+  }
+  RCL_TRACEPOINT(rcl_publish_exit, publisher);
+  return ret;
+}
+
+rcl_ret_t
+rcl_publisher_flush(const rcl_publisher_t * publisher)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  rcl_publisher_impl_t * impl = publisher->impl;
+  for (size_t i = 0; i < impl->batch_count; ++i) {
+    if (rmw_publish(impl->rmw_handle, impl->batch_buffer[i], NULL) != RMW_RET_OK) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      // Keep the unpublished tail staged so a retry does not drop messages.
+      size_t remaining = impl->batch_count - i;
+      memmove(
+        impl->batch_buffer, &impl->batch_buffer[i], remaining * sizeof(const void *));
+      impl->batch_count = remaining;
+      return RCL_RET_ERROR;
+    }
   }
+  impl->batch_count = 0;
   return RCL_RET_OK;
 }
 
@@ -266,7 +501,7 @@ rcl_publish_serialized_message(
   const rcl_serialized_message_t * serialized_message,
   rmw_publisher_allocation_t * allocation)
 {
-  if (!rcl_publisher_is_valid(publisher)) {
+  if (!RCL_RUNTIME_CHECK(rcl_publisher_is_valid(publisher))) {
     return RCL_RET_PUBLISHER_INVALID;  // error already set
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(serialized_message, RCL_RET_INVALID_ARGUMENT);
@@ -279,6 +514,218 @@ rcl_publish_serialized_message(
     }
     return RMW_RET_ERROR;
   }
+  rcl_context_counter_add(
+    publisher->impl->context, RCL_CONTEXT_COUNTER_MESSAGES_PUBLISHED, 1);
+  rcl_context_counter_add(
+    publisher->impl->context, RCL_CONTEXT_COUNTER_SERIALIZED_BYTES,
+    serialized_message->buffer_length);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_publish_serialized_segments(
+  const rcl_publisher_t * publisher,
+  const rcl_serialized_segment_t * segments,
+  size_t count,
+  rmw_publisher_allocation_t * allocation)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(segments, RCL_RET_INVALID_ARGUMENT);
+  if (0 == count) {
+    RCL_SET_ERROR_MSG("segment count is zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  size_t total_length = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (NULL == segments[i].data && segments[i].length > 0) {
+      RCL_SET_ERROR_MSG("segment with non-zero length has null data");
+      return RCL_RET_INVALID_ARGUMENT;
+    }
+    total_length += segments[i].length;
+  }
+  rcl_publisher_impl_t * impl = publisher->impl;
+  rcl_allocator_t * allocator = &impl->options.allocator;
+  // The middleware takes one contiguous buffer, so gather into a staging
+  // buffer kept on the publisher; it is grown once and reused afterwards, so
+  // steady-state publishes do not touch the allocator.
+  if (total_length > impl->gather_buffer_capacity) {
+    uint8_t * new_buffer = (uint8_t *)allocator->reallocate(
+      impl->gather_buffer, total_length, allocator->state);
+    if (NULL == new_buffer) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      return RCL_RET_BAD_ALLOC;
+    }
+    impl->gather_buffer = new_buffer;
+    impl->gather_buffer_capacity = total_length;
+  }
+  size_t offset = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (segments[i].length > 0) {
+      memcpy(impl->gather_buffer + offset, segments[i].data, segments[i].length);
+      offset += segments[i].length;
+    }
+  }
+  rcl_serialized_message_t serialized_message = {
+    .buffer = impl->gather_buffer,
+    .buffer_length = total_length,
+    .buffer_capacity = impl->gather_buffer_capacity,
+    .allocator = impl->options.allocator
+  };
+  rmw_ret_t ret = rmw_publish_serialized_message(impl->rmw_handle, &serialized_message,
+      allocation);
+  if (ret != RMW_RET_OK) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    if (ret == RMW_RET_BAD_ALLOC) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    return RMW_RET_ERROR;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_publish_loaned_message(
+  const rcl_publisher_t * publisher,
+  void * ros_message,
+  rmw_publisher_allocation_t * allocation)
+{
+  if (!RCL_RUNTIME_CHECK(rcl_publisher_is_valid(publisher))) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+
+  rmw_ret_t ret = rmw_publish_loaned_message(
+    publisher->impl->rmw_handle, ros_message, allocation);
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(ret);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_publisher_wait_for_acks(
+  const rcl_publisher_t * publisher,
+  int64_t timeout)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  rmw_time_t temporary_timeout_storage;
+  rmw_time_t * timeout_argument = NULL;  // NULL means block indefinitely
+  if (timeout >= 0) {
+    temporary_timeout_storage.sec = RCL_NS_TO_S(timeout);
+    temporary_timeout_storage.nsec = timeout % 1000000000;
+    timeout_argument = &temporary_timeout_storage;
+  }
+  // The middleware parks the caller on its acknowledgment condition, so no
+  // polling happens at this layer either.
+  rmw_ret_t ret = rmw_publisher_wait_for_all_acked(
+    publisher->impl->rmw_handle, timeout_argument);
+  if (RMW_RET_TIMEOUT == ret) {
+    return RCL_RET_TIMEOUT;
+  }
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(ret);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_publisher_get_queue_depth(
+  const rcl_publisher_t * publisher,
+  size_t * queue_depth)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(queue_depth, RCL_RET_INVALID_ARGUMENT);
+  *queue_depth = publisher->impl->batch_count;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_publish_if_writable(
+  const rcl_publisher_t * publisher,
+  const void * ros_message)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  rcl_publisher_impl_t * impl = publisher->impl;
+  if (NULL == impl->batch_buffer) {
+    RCL_SET_ERROR_MSG(
+      "publisher has no accumulation buffer; writability cannot be guaranteed");
+    return RCL_RET_UNSUPPORTED;
+  }
+  if (impl->batch_count >= impl->options.batch_size) {
+    // Full; flushing here could block inside the middleware, so do not.
+    return RCL_RET_TIMEOUT;
+  }
+  if (0 == impl->batch_count) {
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&impl->batch_start_time)) {
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+  }
+  impl->batch_buffer[impl->batch_count++] = ros_message;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_publisher_alloc_message(
+  const rcl_publisher_t * publisher,
+  void ** ros_message)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  rcl_publisher_impl_t * impl = publisher->impl;
+  if (NULL == impl->message_pool_arena) {
+    RCL_SET_ERROR_MSG("publisher was not initialized with a message pool");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (0 == impl->message_pool_free_count) {
+    RCL_SET_ERROR_MSG("publisher message pool is exhausted");
+    return RCL_RET_BAD_ALLOC;
+  }
+  const size_t slot = impl->message_pool_free[--impl->message_pool_free_count];
+  *ros_message = impl->message_pool_arena + slot * impl->message_pool_slot_size;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_publisher_free_message(
+  const rcl_publisher_t * publisher,
+  void * ros_message)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  rcl_publisher_impl_t * impl = publisher->impl;
+  if (NULL == impl->message_pool_arena) {
+    RCL_SET_ERROR_MSG("publisher was not initialized with a message pool");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  const uint8_t * slot_ptr = (const uint8_t *)ros_message;
+  if (
+    slot_ptr < impl->message_pool_arena ||
+    slot_ptr >=
+    impl->message_pool_arena +
+    impl->options.message_pool_depth * impl->message_pool_slot_size ||
+    0 != (size_t)(slot_ptr - impl->message_pool_arena) % impl->message_pool_slot_size)
+  {
+    RCL_SET_ERROR_MSG("message does not belong to the publisher's message pool");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  impl->message_pool_free[impl->message_pool_free_count++] =
+    (size_t)(slot_ptr - impl->message_pool_arena) / impl->message_pool_slot_size;
   return RCL_RET_OK;
 }
 
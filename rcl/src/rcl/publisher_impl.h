@@ -15,6 +15,7 @@
 #ifndef RCL__PUBLISHER_IMPL_H_
 #define RCL__PUBLISHER_IMPL_H_
 
+#include "rcutils/time.h"
 #include "rmw/rmw.h"
 
 #include "rcl/publisher.h"
@@ -25,6 +26,24 @@ typedef struct rcl_publisher_impl_t
   rmw_qos_profile_t actual_qos;
   rcl_context_t * context;
   rmw_publisher_t * rmw_handle;
+  /// Messages staged for batched publication; NULL when batching is disabled.
+  const void ** batch_buffer;
+  /// Number of staged messages.
+  size_t batch_count;
+  /// Steady time at which the oldest staged message was published.
+  rcutils_time_point_value_t batch_start_time;
+  /// Preallocated message arena; NULL when the pool is disabled.
+  uint8_t * message_pool_arena;
+  /// Stack of free slot indices into the arena.
+  size_t * message_pool_free;
+  size_t message_pool_free_count;
+  /// Size of one arena slot, message size rounded up for alignment.
+  size_t message_pool_slot_size;
+  /// Reusable staging buffer for rcl_publish_serialized_segments(); grown on
+  /// demand and kept for the life of the publisher, NULL until first use.
+  uint8_t * gather_buffer;
+  /// Current capacity of the gather buffer in bytes.
+  size_t gather_buffer_capacity;
 } rcl_publisher_impl_t;
 
 #endif  // RCL__PUBLISHER_IMPL_H_
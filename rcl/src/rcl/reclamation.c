@@ -0,0 +1,312 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/reclamation.h"
+
+#include <stdint.h>
+
+#include "rcl/error_handling.h"
+#include "rcutils/stdatomic_helper.h"
+
+#include "./context_impl.h"
+#include "./reclamation_impl.h"
+
+// One retired object waiting for every registered thread to pass a
+// quiescent point, linked into the domain's lock-free retired stack.
+typedef struct rcl_reclamation_retired_t
+{
+  void * object;
+  void * finalize_context;
+  rcl_reclamation_finalize_t finalize;
+  /// The object is safe to finalize once every registered thread's epoch
+  /// reached this value.
+  uint64_t retire_epoch;
+  struct rcl_reclamation_retired_t * next;
+} rcl_reclamation_retired_t;
+
+// Quiescent-state based reclamation domain of one context.
+//
+// The global epoch only moves forward when something is retired; each
+// registered thread copies it at its quiescent points. A retired object is
+// reclaimable when the minimum of the registered thread epochs has reached
+// the epoch its retirement bumped the counter to, which means every thread
+// passed a quiescent point - and therefore dropped any entity references it
+// held - after the retirement became visible.
+typedef struct rcl_reclamation_domain_t
+{
+  rcl_allocator_t allocator;
+  atomic_uint_least64_t global_epoch;
+  /// Epoch last observed by each registered thread, indexed by slot.
+  atomic_uint_least64_t thread_epochs[RCL_RECLAMATION_MAX_THREADS];
+  /// Which slots are registered.
+  atomic_bool slots_used[RCL_RECLAMATION_MAX_THREADS];
+  /// Head of the retired stack, pushed with compare-and-swap.
+  atomic_uintptr_t retired_head;
+  /// Held by whichever thread is currently scanning the retired stack, so
+  /// a finalizer can never run twice.
+  atomic_bool reclaim_in_progress;
+} rcl_reclamation_domain_t;
+
+// Return the context's domain, creating it when asked to. The first
+// creating call must not race with other reclamation calls on the context.
+static rcl_ret_t
+__rcl_reclamation_get_domain(
+  rcl_context_t * context,
+  bool create,
+  rcl_reclamation_domain_t ** domain)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl, "context is not initialized", return RCL_RET_INVALID_ARGUMENT);
+  if (NULL == context->impl->reclamation_domain) {
+    if (!create) {
+      RCL_SET_ERROR_MSG("context has no reclamation domain");
+      return RCL_RET_INVALID_ARGUMENT;
+    }
+    rcl_allocator_t * allocator = &context->impl->allocator;
+    rcl_reclamation_domain_t * new_domain =
+      (rcl_reclamation_domain_t *)allocator->zero_allocate(
+      1, sizeof(rcl_reclamation_domain_t), allocator->state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      new_domain, "allocating reclamation domain failed", return RCL_RET_BAD_ALLOC);
+    new_domain->allocator = *allocator;
+    atomic_init(&new_domain->global_epoch, 1);
+    size_t i = 0;
+    for (i = 0; i < RCL_RECLAMATION_MAX_THREADS; ++i) {
+      atomic_init(&new_domain->thread_epochs[i], 0);
+      atomic_init(&new_domain->slots_used[i], false);
+    }
+    atomic_init(&new_domain->retired_head, (uintptr_t)NULL);
+    atomic_init(&new_domain->reclaim_in_progress, false);
+    context->impl->reclamation_domain = new_domain;
+  }
+  *domain = context->impl->reclamation_domain;
+  return RCL_RET_OK;
+}
+
+// The smallest epoch any registered thread has observed; UINT64_MAX with no
+// registrations, so everything retired is immediately reclaimable.
+static uint64_t
+__rcl_reclamation_min_epoch(rcl_reclamation_domain_t * domain)
+{
+  uint64_t min_epoch = UINT64_MAX;
+  size_t i = 0;
+  for (i = 0; i < RCL_RECLAMATION_MAX_THREADS; ++i) {
+    if (rcutils_atomic_load_bool(&domain->slots_used[i])) {
+      uint64_t epoch = rcutils_atomic_load_uint64_t(&domain->thread_epochs[i]);
+      if (epoch < min_epoch) {
+        min_epoch = epoch;
+      }
+    }
+  }
+  return min_epoch;
+}
+
+// Push one entry onto the retired stack.
+static void
+__rcl_reclamation_push(rcl_reclamation_domain_t * domain, rcl_reclamation_retired_t * entry)
+{
+  uintptr_t head = rcutils_atomic_load_uintptr_t(&domain->retired_head);
+  bool exchanged = false;
+  do {
+    entry->next = (rcl_reclamation_retired_t *)head;
+    rcutils_atomic_compare_exchange_strong(
+      &domain->retired_head, exchanged, &head, (uintptr_t)entry);
+  } while (!exchanged);
+}
+
+// Finalize every popped entry whose retirement the epochs have cleared and
+// push the rest back. Runs under the reclaim_in_progress flag.
+static rcl_ret_t
+__rcl_reclamation_scan(rcl_reclamation_domain_t * domain, uint64_t min_epoch)
+{
+  uintptr_t popped = (uintptr_t)NULL;
+  rcutils_atomic_exchange(&domain->retired_head, popped, (uintptr_t)NULL);
+  rcl_reclamation_retired_t * entry = (rcl_reclamation_retired_t *)popped;
+  rcl_ret_t ret = RCL_RET_OK;
+  while (NULL != entry) {
+    rcl_reclamation_retired_t * next = entry->next;
+    if (entry->retire_epoch <= min_epoch) {
+      rcl_ret_t finalize_ret = entry->finalize(entry->object, entry->finalize_context);
+      if (RCL_RET_OK != finalize_ret) {
+        ret = finalize_ret;  // error already set, keep reclaiming
+      }
+      domain->allocator.deallocate(entry, domain->allocator.state);
+    } else {
+      __rcl_reclamation_push(domain, entry);
+    }
+    entry = next;
+  }
+  return ret;
+}
+
+rcl_ret_t
+rcl_reclamation_register_thread(rcl_context_t * context, size_t * slot)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(slot, RCL_RET_INVALID_ARGUMENT);
+  rcl_reclamation_domain_t * domain = NULL;
+  rcl_ret_t ret = __rcl_reclamation_get_domain(context, true, &domain);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  size_t i = 0;
+  for (i = 0; i < RCL_RECLAMATION_MAX_THREADS; ++i) {
+    bool expected = false;
+    bool exchanged = false;
+    rcutils_atomic_compare_exchange_strong(
+      &domain->slots_used[i], exchanged, &expected, true);
+    if (exchanged) {
+      rcutils_atomic_store(
+        &domain->thread_epochs[i],
+        rcutils_atomic_load_uint64_t(&domain->global_epoch));
+      *slot = i;
+      return RCL_RET_OK;
+    }
+  }
+  RCL_SET_ERROR_MSG("all reclamation registration slots are taken");
+  return RCL_RET_ERROR;
+}
+
+rcl_ret_t
+rcl_reclamation_unregister_thread(rcl_context_t * context, size_t slot)
+{
+  rcl_reclamation_domain_t * domain = NULL;
+  rcl_ret_t ret = __rcl_reclamation_get_domain(context, false, &domain);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  if (slot >= RCL_RECLAMATION_MAX_THREADS ||
+    !rcutils_atomic_load_bool(&domain->slots_used[slot]))
+  {
+    RCL_SET_ERROR_MSG("slot is not a registered reclamation slot");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcutils_atomic_store(&domain->slots_used[slot], false);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_reclamation_quiescent(rcl_context_t * context, size_t slot)
+{
+  rcl_reclamation_domain_t * domain = NULL;
+  rcl_ret_t ret = __rcl_reclamation_get_domain(context, false, &domain);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  if (slot >= RCL_RECLAMATION_MAX_THREADS ||
+    !rcutils_atomic_load_bool(&domain->slots_used[slot]))
+  {
+    RCL_SET_ERROR_MSG("slot is not a registered reclamation slot");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcutils_atomic_store(
+    &domain->thread_epochs[slot],
+    rcutils_atomic_load_uint64_t(&domain->global_epoch));
+  if ((uintptr_t)NULL == rcutils_atomic_load_uintptr_t(&domain->retired_head)) {
+    return RCL_RET_OK;  // nothing retired, the common case
+  }
+  bool was_reclaiming = false;
+  rcutils_atomic_exchange(&domain->reclaim_in_progress, was_reclaiming, true);
+  if (was_reclaiming) {
+    return RCL_RET_OK;  // another thread is already scanning
+  }
+  ret = __rcl_reclamation_scan(domain, __rcl_reclamation_min_epoch(domain));
+  rcutils_atomic_store(&domain->reclaim_in_progress, false);
+  return ret;
+}
+
+rcl_ret_t
+rcl_reclamation_retire(
+  rcl_context_t * context,
+  void * object,
+  void * finalize_context,
+  rcl_reclamation_finalize_t finalize)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(object, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(finalize, RCL_RET_INVALID_ARGUMENT);
+  rcl_reclamation_domain_t * domain = NULL;
+  rcl_ret_t ret = __rcl_reclamation_get_domain(context, true, &domain);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  rcl_reclamation_retired_t * entry =
+    (rcl_reclamation_retired_t *)domain->allocator.allocate(
+    sizeof(rcl_reclamation_retired_t), domain->allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    entry, "allocating retired entry failed", return RCL_RET_BAD_ALLOC);
+  entry->object = object;
+  entry->finalize_context = finalize_context;
+  entry->finalize = finalize;
+  // Threads whose epoch reaches the bumped value passed a quiescent point
+  // after this retirement, so they no longer reference the object.
+  entry->retire_epoch =
+    rcutils_atomic_fetch_add_uint64_t(&domain->global_epoch, 1) + 1;
+  __rcl_reclamation_push(domain, entry);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_reclamation_drain(rcl_context_t * context)
+{
+  rcl_reclamation_domain_t * domain = NULL;
+  rcl_ret_t ret = __rcl_reclamation_get_domain(context, false, &domain);
+  if (RCL_RET_OK != ret) {
+    if (NULL != context && NULL != context->impl) {
+      // Never retiring anything is not an error for a drain.
+      rcl_reset_error();
+      return RCL_RET_OK;
+    }
+    return ret;  // error already set
+  }
+  bool was_reclaiming = false;
+  rcutils_atomic_exchange(&domain->reclaim_in_progress, was_reclaiming, true);
+  if (was_reclaiming) {
+    RCL_SET_ERROR_MSG("another thread is reclaiming, drain would race");
+    return RCL_RET_ERROR;
+  }
+  ret = __rcl_reclamation_scan(domain, UINT64_MAX);
+  rcutils_atomic_store(&domain->reclaim_in_progress, false);
+  return ret;
+}
+
+void
+rcl_reclamation_fini(rcl_context_t * context)
+{
+  if (NULL == context || NULL == context->impl ||
+    NULL == context->impl->reclamation_domain)
+  {
+    return;
+  }
+  rcl_reclamation_domain_t * domain = context->impl->reclamation_domain;
+  rcl_ret_t ret = __rcl_reclamation_scan(domain, UINT64_MAX);
+  if (RCL_RET_OK != ret) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR(
+      "[rcl|reclamation.c:" RCUTILS_STRINGIFY(__LINE__)
+      "] a finalizer failed while draining the reclamation domain: ");
+    RCUTILS_SAFE_FWRITE_TO_STDERR(rcl_get_error_string().str);
+    RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
+    rcl_reset_error();
+  }
+  domain->allocator.deallocate(domain, domain->allocator.state);
+  context->impl->reclamation_domain = NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
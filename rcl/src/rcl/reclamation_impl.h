@@ -0,0 +1,39 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__RECLAMATION_IMPL_H_
+#define RCL__RECLAMATION_IMPL_H_
+
+#include "rcl/context.h"
+#include "rcl/visibility_control.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// \internal Drain and free the context's reclamation domain, if created.
+/**
+ * Called during context cleanup, after which no reclamation calls on the
+ * context are valid. Safe to call when no domain was ever created.
+ */
+RCL_LOCAL
+void
+rcl_reclamation_fini(rcl_context_t * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__RECLAMATION_IMPL_H_
@@ -14,6 +14,8 @@
 
 #include "rcl/remap.h"
 
+#include <string.h>
+
 #include "./arguments_impl.h"
 #include "./remap_impl.h"
 #include "rcl/error_handling.h"
@@ -36,60 +38,133 @@ rcl_get_zero_initialized_remap(void)
   return default_rule;
 }
 
-rcl_ret_t
-rcl_remap_copy(
-  const rcl_remap_t * rule,
-  rcl_remap_t * rule_out)
+/// Return true if a rule can live in the exact-match index.
+/**
+ * A topic or service rule whose match side is already a fully qualified
+ * literal expands to itself for every node, so it can be compiled once and
+ * probed with a plain string comparison at remap time.
+ */
+static bool
+_rcl_remap_rule_is_static(const rcl_remap_impl_t * impl)
 {
-  RCL_CHECK_ARGUMENT_FOR_NULL(rule, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(rule_out, RCL_RET_INVALID_ARGUMENT);
-
-  if (NULL != rule_out->impl) {
-    RCL_SET_ERROR_MSG("rule_out must be zero initialized");
-    return RCL_RET_INVALID_ARGUMENT;
+  if (!(impl->type & (RCL_TOPIC_REMAP | RCL_SERVICE_REMAP))) {
+    return false;
   }
+  const char * match = impl->match;
+  if (NULL == match || '/' != match[0]) {
+    return false;
+  }
+  for (size_t i = 0; '\0' != match[i]; ++i) {
+    if ('{' == match[i] || '}' == match[i] || '~' == match[i]) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  rcl_allocator_t allocator = rule->impl->allocator;
-
-  rule_out->impl = allocator.allocate(sizeof(rcl_remap_impl_t), allocator.state);
-  if (NULL == rule_out->impl) {
+rcl_ret_t
+rcl_remap_build_index(rcl_arguments_impl_t * args_impl)
+{
+  rcl_allocator_t allocator = args_impl->allocator;
+  args_impl->static_remap_indices = NULL;
+  args_impl->num_static_remap_indices = 0;
+  args_impl->dynamic_remap_indices = NULL;
+  args_impl->num_dynamic_remap_indices = 0;
+  if (0 == args_impl->num_remap_rules) {
+    return RCL_RET_OK;
+  }
+  int num_rules = args_impl->num_remap_rules;
+  int * static_indices = allocator.allocate(sizeof(int) * num_rules, allocator.state);
+  if (NULL == static_indices) {
     return RCL_RET_BAD_ALLOC;
   }
+  int * dynamic_indices = allocator.allocate(sizeof(int) * num_rules, allocator.state);
+  if (NULL == dynamic_indices) {
+    allocator.deallocate(static_indices, allocator.state);
+    return RCL_RET_BAD_ALLOC;
+  }
+  int num_static = 0;
+  int num_dynamic = 0;
+  for (int i = 0; i < num_rules; ++i) {
+    if (_rcl_remap_rule_is_static(args_impl->remap_rules[i].impl)) {
+      // Insertion sort by match string; stable, so equal keys keep rule order.
+      int pos = num_static;
+      const char * match = args_impl->remap_rules[i].impl->match;
+      while (pos > 0) {
+        const char * other = args_impl->remap_rules[static_indices[pos - 1]].impl->match;
+        if (strcmp(other, match) <= 0) {
+          break;
+        }
+        static_indices[pos] = static_indices[pos - 1];
+        --pos;
+      }
+      static_indices[pos] = i;
+      ++num_static;
+    } else {
+      dynamic_indices[num_dynamic] = i;
+      ++num_dynamic;
+    }
+  }
+  args_impl->static_remap_indices = static_indices;
+  args_impl->num_static_remap_indices = num_static;
+  args_impl->dynamic_remap_indices = dynamic_indices;
+  args_impl->num_dynamic_remap_indices = num_dynamic;
+  return RCL_RET_OK;
+}
 
-  rule_out->impl->allocator = allocator;
-
-  // Zero so it's safe to call rcl_remap_fini() if an error occurs while copying.
-  rule_out->impl->type = RCL_UNKNOWN_REMAP;
-  rule_out->impl->node_name = NULL;
-  rule_out->impl->match = NULL;
-  rule_out->impl->replacement = NULL;
+void
+rcl_remap_free_index(rcl_arguments_impl_t * args_impl)
+{
+  rcl_allocator_t allocator = args_impl->allocator;
+  if (NULL != args_impl->static_remap_indices) {
+    allocator.deallocate(args_impl->static_remap_indices, allocator.state);
+    args_impl->static_remap_indices = NULL;
+  }
+  args_impl->num_static_remap_indices = 0;
+  if (NULL != args_impl->dynamic_remap_indices) {
+    allocator.deallocate(args_impl->dynamic_remap_indices, allocator.state);
+    args_impl->dynamic_remap_indices = NULL;
+  }
+  args_impl->num_dynamic_remap_indices = 0;
+}
 
-  rule_out->impl->type = rule->impl->type;
-  if (NULL != rule->impl->node_name) {
-    rule_out->impl->node_name = rcutils_strdup(rule->impl->node_name, allocator);
-    if (NULL == rule_out->impl->node_name) {
-      goto fail;
+/// Find the lowest-index static rule matching `name` with a binary probe.
+/// \return the rule index, or -1 if no static rule matches
+static int
+_rcl_remap_probe_static_index(
+  const rcl_arguments_impl_t * args_impl,
+  rcl_remap_type_t type_bitmask,
+  const char * name,
+  const char * node_name)
+{
+  int low = 0;
+  int high = args_impl->num_static_remap_indices;
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+    const char * match =
+      args_impl->remap_rules[args_impl->static_remap_indices[mid]].impl->match;
+    if (strcmp(match, name) < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
     }
   }
-  if (NULL != rule->impl->match) {
-    rule_out->impl->match = rcutils_strdup(rule->impl->match, allocator);
-    if (NULL == rule_out->impl->match) {
-      goto fail;
+  // Scan the run of equal keys, which is in original rule order, for the
+  // first rule that also passes the type and node name prefix checks.
+  for (int i = low; i < args_impl->num_static_remap_indices; ++i) {
+    rcl_remap_t * rule = &(args_impl->remap_rules[args_impl->static_remap_indices[i]]);
+    if (0 != strcmp(rule->impl->match, name)) {
+      break;
     }
-  }
-  if (NULL != rule->impl->replacement) {
-    rule_out->impl->replacement = rcutils_strdup(
-      rule->impl->replacement, allocator);
-    if (NULL == rule_out->impl->replacement) {
-      goto fail;
+    if (!(rule->impl->type & type_bitmask)) {
+      continue;
     }
+    if (rule->impl->node_name != NULL && 0 != strcmp(rule->impl->node_name, node_name)) {
+      continue;
+    }
+    return args_impl->static_remap_indices[i];
   }
-  return RCL_RET_OK;
-fail:
-  if (RCL_RET_OK != rcl_remap_fini(rule_out)) {
-    RCL_SET_ERROR_MSG("Error while finalizing remap rule due to another error");
-  }
-  return RCL_RET_BAD_ALLOC;
+  return -1;
 }
 
 /// Get the first matching rule in a chain.
@@ -97,8 +172,7 @@ fail:
 RCL_LOCAL
 rcl_ret_t
 _rcl_remap_first_match(
-  rcl_remap_t * remap_rules,
-  int num_rules,
+  const rcl_arguments_impl_t * args_impl,
   rcl_remap_type_t type_bitmask,
   const char * name,
   const char * node_name,
@@ -108,8 +182,20 @@ _rcl_remap_first_match(
   rcl_remap_t ** output_rule)
 {
   *output_rule = NULL;
-  for (int i = 0; i < num_rules; ++i) {
-    rcl_remap_t * rule = &(remap_rules[i]);
+  // One exact probe answers all static rules; only rules needing per-node
+  // expansion are walked below, and only up to the static candidate so that
+  // first-match-wins ordering is preserved.
+  int static_match = -1;
+  if (NULL != name && args_impl->num_static_remap_indices > 0) {
+    static_match = _rcl_remap_probe_static_index(args_impl, type_bitmask, name, node_name);
+  }
+  for (int i = 0; i < args_impl->num_dynamic_remap_indices; ++i) {
+    int rule_index = args_impl->dynamic_remap_indices[i];
+    if (-1 != static_match && rule_index > static_match) {
+      // The static candidate precedes every remaining dynamic rule.
+      break;
+    }
+    rcl_remap_t * rule = &(args_impl->remap_rules[rule_index]);
     if (!(rule->impl->type & type_bitmask)) {
       // Not the type of remap rule we're looking fore
       continue;
@@ -145,9 +231,12 @@ _rcl_remap_first_match(
     }
     if (matched) {
       *output_rule = rule;
-      break;
+      return RCL_RET_OK;
     }
   }
+  if (-1 != static_match) {
+    *output_rule = &(args_impl->remap_rules[static_match]);
+  }
   return RCL_RET_OK;
 }
 
@@ -184,7 +273,7 @@ _rcl_remap_name(
   // Look at local rules first
   if (NULL != local_arguments) {
     rcl_ret_t ret = _rcl_remap_first_match(
-      local_arguments->impl->remap_rules, local_arguments->impl->num_remap_rules, type_bitmask,
+      local_arguments->impl, type_bitmask,
       name, node_name, node_namespace, substitutions, allocator, &rule);
     if (ret != RCL_RET_OK) {
       return ret;
@@ -193,7 +282,7 @@ _rcl_remap_name(
   // Check global rules if no local rule matched
   if (NULL == rule && NULL != global_arguments) {
     rcl_ret_t ret = _rcl_remap_first_match(
-      global_arguments->impl->remap_rules, global_arguments->impl->num_remap_rules, type_bitmask,
+      global_arguments->impl, type_bitmask,
       name, node_name, node_namespace, substitutions, allocator, &rule);
     if (ret != RCL_RET_OK) {
       return ret;
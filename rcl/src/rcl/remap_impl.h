@@ -51,34 +51,34 @@ typedef struct rcl_remap_impl_t
   rcl_allocator_t allocator;
 } rcl_remap_impl_t;
 
+struct rcl_arguments_impl_t;
+
 /// Get an rcl_remap_t structure initialized with NULL.
 rcl_remap_t
 rcl_remap_get_zero_initialized();
 
-/// Copy one remap structure into another.
+/// Compile the parsed remap rules into the lookup index used at remap time.
 /**
- * <hr>
- * Attribute          | Adherence
- * ------------------ | -------------
- * Allocates Memory   | Yes
- * Thread-Safe        | No
- * Uses Atomics       | No
- * Lock-Free          | Yes
+ * Partitions the rules into an exact-match table of topic and service rules
+ * whose match side is a literal fully qualified name, sorted for binary
+ * probing, and a list of the remaining rules that need per-node expansion.
+ * Must be called whenever the remap_rules array of `args_impl` is (re)built;
+ * first-match-wins ordering between the two partitions is preserved by the
+ * original rule indices.
  *
- * \param[in] rule The structure to be copied.
- *  Its allocator is used to copy memory into the new structure.
- * \param[out] rule_out A zero-initialized rcl_remap_t structure to be copied into.
- * \return `RCL_RET_OK` if the structure was copied successfully, or
- * \return `RCL_RET_INVALID_ARGUMENT` if any function arguments are invalid, or
- * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
- * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ * \param[inout] args_impl parsed arguments whose rules should be indexed
+ * \return `RCL_RET_OK` if the index was built, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
  */
-RCL_PUBLIC
+RCL_LOCAL
 RCL_WARN_UNUSED
 rcl_ret_t
-rcl_remap_copy(
-  const rcl_remap_t * rule,
-  rcl_remap_t * rule_out);
+rcl_remap_build_index(struct rcl_arguments_impl_t * args_impl);
+
+/// Free the compiled lookup index, leaving the rules themselves alone.
+RCL_LOCAL
+void
+rcl_remap_free_index(struct rcl_arguments_impl_t * args_impl);
 
 /// Reclaim resources used in an rcl_remap_t structure.
 /**
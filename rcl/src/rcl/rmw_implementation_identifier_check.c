@@ -17,13 +17,16 @@ extern "C"
 {
 #endif
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "rcl/allocator.h"
 #include "rcl/error_handling.h"
+#include "rcl/rmw_implementation_identifier_check.h"
 #include "rcutils/logging_macros.h"
+#include "rcutils/stdatomic_helper.h"
 #include "rcutils/strdup.h"
 #include "rmw/rmw.h"
 
@@ -52,7 +55,13 @@ extern "C"
   static void f(void)
 #endif
 
-INITIALIZER(initialize) {
+// result of the check, resolved once; UINT64_MAX means "not yet resolved"
+static atomic_uint_least64_t __rmw_id_check_status = ATOMIC_VAR_INIT(UINT64_MAX);
+
+// Implementation only
+static rcl_ret_t
+_perform_rmw_implementation_identifier_check(void)
+{
   // If the environment variable RMW_IMPLEMENTATION is set, or
   // the environment variable RCL_ASSERT_RMW_ID_MATCHES is set,
   // check that the result of `rmw_get_implementation_identifier` matches.
@@ -66,14 +75,14 @@ INITIALIZER(initialize) {
       "Error getting environment variable 'RMW_IMPLEMENTATION': %s",
       rcl_get_error_string().str
     );
-    exit(ret);
+    return ret;
   }
   if (strlen(expected_rmw_impl_env) > 0) {
     // Copy the environment variable so it doesn't get over-written by the next getenv call.
     expected_rmw_impl = rcutils_strdup(expected_rmw_impl_env, allocator);
     if (!expected_rmw_impl) {
       RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "allocation failed");
-      exit(RCL_RET_BAD_ALLOC);
+      return RCL_RET_BAD_ALLOC;
     }
   }
 
@@ -86,14 +95,16 @@ INITIALIZER(initialize) {
       "Error getting environment variable 'RCL_ASSERT_RMW_ID_MATCHES': %s",
       rcl_get_error_string().str
     );
-    exit(ret);
+    allocator.deallocate(expected_rmw_impl, allocator.state);
+    return ret;
   }
   if (strlen(asserted_rmw_impl_env) > 0) {
     // Copy the environment variable so it doesn't get over-written by the next getenv call.
     asserted_rmw_impl = rcutils_strdup(asserted_rmw_impl_env, allocator);
     if (!asserted_rmw_impl) {
       RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "allocation failed");
-      exit(RCL_RET_BAD_ALLOC);
+      allocator.deallocate(expected_rmw_impl, allocator.state);
+      return RCL_RET_BAD_ALLOC;
     }
   }
 
@@ -105,7 +116,9 @@ INITIALIZER(initialize) {
       "variables do not match, exiting with %d.",
       expected_rmw_impl, asserted_rmw_impl, RCL_RET_ERROR
     );
-    exit(RCL_RET_ERROR);
+    allocator.deallocate(expected_rmw_impl, allocator.state);
+    allocator.deallocate(asserted_rmw_impl, allocator.state);
+    return RCL_RET_ERROR;
   }
 
   // Collapse the expected_rmw_impl and asserted_rmw_impl variables so only expected_rmw_impl needs
@@ -135,7 +148,8 @@ INITIALIZER(initialize) {
         RCL_RET_ERROR
       );
       rcl_reset_error();
-      exit(RCL_RET_ERROR);
+      allocator.deallocate(expected_rmw_impl, allocator.state);
+      return RCL_RET_ERROR;
     }
     if (strcmp(actual_rmw_impl_id, expected_rmw_impl) != 0) {
       RCUTILS_LOG_ERROR_NAMED(
@@ -145,11 +159,34 @@ INITIALIZER(initialize) {
         actual_rmw_impl_id,
         RCL_RET_MISMATCHED_RMW_ID
       );
-      exit(RCL_RET_MISMATCHED_RMW_ID);
+      allocator.deallocate(expected_rmw_impl, allocator.state);
+      return RCL_RET_MISMATCHED_RMW_ID;
     }
     // Free the memory now that all checking has passed.
     allocator.deallocate((char *)expected_rmw_impl, allocator.state);
   }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_rmw_implementation_identifier_check(void)
+{
+  uint64_t status;
+  rcutils_atomic_load(&__rmw_id_check_status, status);
+  if (UINT64_MAX != status) {
+    // already resolved; hot-path callers only pay for the load above
+    return (rcl_ret_t)status;
+  }
+  rcl_ret_t ret = _perform_rmw_implementation_identifier_check();
+  rcutils_atomic_store(&__rmw_id_check_status, (uint64_t)ret);
+  return ret;
+}
+
+INITIALIZER(initialize) {
+  rcl_ret_t ret = rcl_rmw_implementation_identifier_check();
+  if (RCL_RET_OK != ret) {
+    exit(ret);
+  }
 }
 
 #ifdef __cplusplus
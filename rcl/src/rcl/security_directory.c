@@ -18,6 +18,7 @@
 #include "rcutils/filesystem.h"
 #include "rcutils/get_env.h"
 #include "rcutils/format_string.h"
+#include "rcutils/strdup.h"
 
 #ifdef __clang__
 # pragma clang diagnostic push
@@ -73,6 +74,178 @@ char * g_security_lookup_type_strings[] = {
   "MATCH_PREFIX"
 };
 
+/* Resolving a secure root walks the keystore on disk, and containers starting
+ * many nodes resolve against the same keystore over and over. Validated
+ * results are therefore cached for the lifetime of the process. The key
+ * includes the root directory and the lookup strategy in effect, so a changed
+ * environment simply misses the cache. Entries are kept with the default
+ * allocator and intentionally retained until process exit.
+ */
+#define RCL_SECURITY_ROOT_CACHE_CAPACITY 64
+
+typedef struct security_root_cache_entry_t
+{
+  char * node_name;
+  char * node_namespace;
+  char * root_env;
+  const char * lookup_strategy;  // points into g_security_lookup_type_strings, not owned
+  char * secure_root;
+} security_root_cache_entry_t;
+
+static security_root_cache_entry_t g_security_root_cache[RCL_SECURITY_ROOT_CACHE_CAPACITY];
+static size_t g_security_root_cache_size = 0;
+
+// Implementation only
+static char * _security_root_cache_get(
+  const char * node_name,
+  const char * node_namespace,
+  const char * root_env,
+  const char * lookup_strategy,
+  const rcl_allocator_t * allocator)
+{
+  for (size_t i = 0; i < g_security_root_cache_size; ++i) {
+    const security_root_cache_entry_t * entry = &g_security_root_cache[i];
+    if (entry->lookup_strategy == lookup_strategy &&
+      0 == strcmp(entry->node_name, node_name) &&
+      0 == strcmp(entry->node_namespace, node_namespace) &&
+      0 == strcmp(entry->root_env, root_env))
+    {
+      return rcutils_strdup(entry->secure_root, *allocator);
+    }
+  }
+  return NULL;
+}
+
+// Implementation only
+static void _security_root_cache_put(
+  const char * node_name,
+  const char * node_namespace,
+  const char * root_env,
+  const char * lookup_strategy,
+  const char * secure_root)
+{
+  if (RCL_SECURITY_ROOT_CACHE_CAPACITY == g_security_root_cache_size) {
+    return;  // full; later lookups just pay the walk again
+  }
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  security_root_cache_entry_t * entry = &g_security_root_cache[g_security_root_cache_size];
+  entry->node_name = rcutils_strdup(node_name, allocator);
+  entry->node_namespace = rcutils_strdup(node_namespace, allocator);
+  entry->root_env = rcutils_strdup(root_env, allocator);
+  entry->secure_root = rcutils_strdup(secure_root, allocator);
+  if (NULL == entry->node_name || NULL == entry->node_namespace ||
+    NULL == entry->root_env || NULL == entry->secure_root)
+  {
+    // failing to cache only costs the caching
+    allocator.deallocate(entry->node_name, allocator.state);
+    allocator.deallocate(entry->node_namespace, allocator.state);
+    allocator.deallocate(entry->root_env, allocator.state);
+    allocator.deallocate(entry->secure_root, allocator.state);
+    return;
+  }
+  entry->lookup_strategy = lookup_strategy;
+  ++g_security_root_cache_size;
+}
+
+/* Prefix matching has to consider every subdirectory of the keystore, and
+ * large multi-tenant keystores make that walk expensive to repeat per node.
+ * The subdirectory names of each base directory are therefore read once and
+ * kept as an in-process manifest, so later prefix lookups are a string scan
+ * instead of a directory iteration. Like the secure root cache above, the
+ * manifests use the default allocator and are retained until process exit.
+ */
+#define RCL_SECURITY_DIR_MANIFEST_CACHE_CAPACITY 16
+
+typedef struct security_dir_manifest_t
+{
+  char * base_dir;
+  char ** names;  // names of the subdirectories of base_dir
+  size_t num_names;
+} security_dir_manifest_t;
+
+static security_dir_manifest_t
+  g_security_dir_manifests[RCL_SECURITY_DIR_MANIFEST_CACHE_CAPACITY];
+static size_t g_security_dir_manifest_count = 0;
+
+// Implementation only
+static void _security_dir_manifest_free_names(
+  char ** names, size_t num_names, rcutils_allocator_t allocator)
+{
+  for (size_t i = 0; i < num_names; ++i) {
+    allocator.deallocate(names[i], allocator.state);
+  }
+  allocator.deallocate(names, allocator.state);
+}
+
+/// Return the cached subdirectory manifest of base_dir, scanning it on first use.
+/**
+ * \return the manifest, or NULL if the directory could not be read or the
+ * manifest could not be built; callers should fall back to walking the
+ * directory themselves in that case.
+ */
+static const security_dir_manifest_t * _security_dir_manifest_get_or_scan(const char * base_dir)
+{
+  for (size_t i = 0; i < g_security_dir_manifest_count; ++i) {
+    if (0 == strcmp(g_security_dir_manifests[i].base_dir, base_dir)) {
+      return &g_security_dir_manifests[i];
+    }
+  }
+  if (RCL_SECURITY_DIR_MANIFEST_CACHE_CAPACITY == g_security_dir_manifest_count) {
+    return NULL;  // full; later lookups just pay the walk again
+  }
+  tinydir_dir dir;
+  if (-1 == tinydir_open(&dir, base_dir)) {
+    return NULL;
+  }
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char ** names = NULL;
+  size_t num_names = 0;
+  size_t capacity = 0;
+  bool scan_ok = true;
+  while (dir.has_next) {
+    tinydir_file file;
+    if (-1 == tinydir_readfile(&dir, &file)) {
+      scan_ok = false;
+      break;
+    }
+    if (file.is_dir) {
+      if (num_names == capacity) {
+        size_t new_capacity = capacity ? (2 * capacity) : 32;
+        char ** new_names = allocator.reallocate(
+          names, new_capacity * sizeof(char *), allocator.state);
+        if (NULL == new_names) {
+          scan_ok = false;
+          break;
+        }
+        names = new_names;
+        capacity = new_capacity;
+      }
+      names[num_names] = rcutils_strdup(file.name, allocator);
+      if (NULL == names[num_names]) {
+        scan_ok = false;
+        break;
+      }
+      ++num_names;
+    }
+    if (-1 == tinydir_next(&dir)) {
+      scan_ok = false;
+      break;
+    }
+  }
+  tinydir_close(&dir);
+  security_dir_manifest_t * manifest = &g_security_dir_manifests[g_security_dir_manifest_count];
+  manifest->base_dir = scan_ok ? rcutils_strdup(base_dir, allocator) : NULL;
+  if (NULL == manifest->base_dir) {
+    // failing to build the manifest only costs the caching
+    _security_dir_manifest_free_names(names, num_names, allocator);
+    return NULL;
+  }
+  manifest->names = names;
+  manifest->num_names = num_names;
+  ++g_security_dir_manifest_count;
+  return manifest;
+}
+
 /// Return the directory whose name most closely matches node_name (longest-prefix match),
 /// scanning under base_dir.
 /**
@@ -94,6 +267,22 @@ static bool get_best_matching_directory(
   if (NULL == base_dir || NULL == node_name || NULL == matched_name) {
     return false;
   }
+  // serve the subdirectory names from the manifest when one is available
+  const security_dir_manifest_t * manifest = _security_dir_manifest_get_or_scan(base_dir);
+  if (NULL != manifest) {
+    for (size_t i = 0; i < manifest->num_names; ++i) {
+      size_t matched_name_length = strnlen(manifest->names[i], _TINYDIR_FILENAME_MAX - 1);
+      if (0 ==
+        strncmp(manifest->names[i], node_name,
+        matched_name_length) && matched_name_length > max_match_length)
+      {
+        max_match_length = matched_name_length;
+        memcpy(matched_name, manifest->names[i], max_match_length);
+      }
+    }
+    return max_match_length > 0;
+  }
+  // the manifest could not be built, fall back to walking the directory
   if (-1 == tinydir_open(&dir, base_dir)) {
     return false;
   }
@@ -230,17 +419,23 @@ char * rcl_get_secure_root(
       allocator->deallocate(ros_secure_root_env, allocator->state);
       return NULL;
     }
+    ros_security_lookup_type_t lookup_type = ROS_SECURITY_LOOKUP_MATCH_EXACT;
     if (0 == strcmp(ros_security_lookup_type,
       g_security_lookup_type_strings[ROS_SECURITY_LOOKUP_MATCH_PREFIX]))
     {
-      node_secure_root = g_security_lookup_fns[ROS_SECURITY_LOOKUP_MATCH_PREFIX]
-          (node_name, node_namespace, ros_secure_root_env, allocator);
-      lookup_strategy = g_security_lookup_type_strings[ROS_SECURITY_LOOKUP_MATCH_PREFIX];
-    } else { /* Default is MATCH_EXACT */
-      node_secure_root = g_security_lookup_fns[ROS_SECURITY_LOOKUP_MATCH_EXACT]
-          (node_name, node_namespace, ros_secure_root_env, allocator);
-      lookup_strategy = g_security_lookup_type_strings[ROS_SECURITY_LOOKUP_MATCH_EXACT];
+      lookup_type = ROS_SECURITY_LOOKUP_MATCH_PREFIX;
+    }
+    lookup_strategy = g_security_lookup_type_strings[lookup_type];
+    // serve repeated resolutions from the cache, skipping the keystore walk
+    node_secure_root = _security_root_cache_get(
+      node_name, node_namespace, ros_secure_root_env, lookup_strategy, allocator);
+    if (NULL != node_secure_root) {
+      // cached roots were validated as directories when they were inserted
+      allocator->deallocate(ros_secure_root_env, allocator->state);
+      return node_secure_root;
     }
+    node_secure_root = g_security_lookup_fns[lookup_type]
+        (node_name, node_namespace, ros_secure_root_env, allocator);
   }
 
   if (NULL == node_secure_root || !rcutils_is_directory(node_secure_root)) {
@@ -259,6 +454,12 @@ char * rcl_get_secure_root(
     allocator->deallocate(node_secure_root, allocator->state);
     return NULL;
   }
+  if (!ros_secure_node_override) {
+    // remember the validated root; the override path is a plain copy and
+    // not worth caching
+    _security_root_cache_put(
+      node_name, node_namespace, ros_secure_root_env, lookup_strategy, node_secure_root);
+  }
   allocator->deallocate(ros_secure_root_env, allocator->state);
   return node_secure_root;
 }
@@ -23,19 +23,115 @@ extern "C"
 #include <string.h>
 
 #include "rcl/error_handling.h"
-#include "rcl/expand_topic_name.h"
-#include "rcl/remap.h"
 #include "rcutils/logging_macros.h"
+#include "rcutils/time.h"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
 #include "rmw/validate_full_topic_name.h"
 
+#include "./common.h"
+#include "./node_impl.h"
+
+// One taken-but-unanswered request, tracked while stats are enabled so the
+// response can be correlated back to the take, see rcl_service_enable_stats().
+typedef struct rcl_service_pending_request_t
+{
+  rmw_request_id_t request_id;
+  rcutils_time_point_value_t take_time;
+} rcl_service_pending_request_t;
+
+// Capacity of the in-flight table; takes beyond this are counted as dropped
+// correlations rather than growing the table on the hot path.
+#define RCL_SERVICE_STATS_PENDING_CAPACITY 64
+
 typedef struct rcl_service_impl_t
 {
   rcl_service_options_t options;
   rmw_service_t * rmw_handle;
+  // opt-in latency statistics, see rcl_service_enable_stats()
+  bool stats_enabled;
+  rcl_service_stats_t stats;
+  // in-flight table, NULL until stats are enabled
+  rcl_service_pending_request_t * pending_requests;
+  size_t pending_request_count;
 } rcl_service_impl_t;
 
+// Record a successful take in the in-flight table.
+static void
+_rcl_service_stats_record_take(rcl_service_impl_t * impl, const rmw_request_id_t * request_header)
+{
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    rcutils_reset_error();
+    ++impl->stats.dropped_correlations;
+    return;
+  }
+  if (RCL_SERVICE_STATS_PENDING_CAPACITY == impl->pending_request_count) {
+    ++impl->stats.dropped_correlations;
+    return;
+  }
+  rcl_service_pending_request_t * pending =
+    &impl->pending_requests[impl->pending_request_count++];
+  pending->request_id = *request_header;
+  pending->take_time = now;
+  impl->stats.current_inflight = impl->pending_request_count;
+  if (impl->pending_request_count > impl->stats.max_inflight) {
+    impl->stats.max_inflight = impl->pending_request_count;
+  }
+}
+
+// Correlate a response with its take and fold the latency into the stats.
+static void
+_rcl_service_stats_record_response(
+  rcl_service_impl_t * impl, const rmw_request_id_t * request_header)
+{
+  size_t i = 0;
+  for (i = 0; i < impl->pending_request_count; ++i) {
+    const rmw_request_id_t * pending_id = &impl->pending_requests[i].request_id;
+    if (pending_id->sequence_number == request_header->sequence_number &&
+      0 == memcmp(
+        pending_id->writer_guid, request_header->writer_guid,
+        sizeof(pending_id->writer_guid)))
+    {
+      break;
+    }
+  }
+  if (i == impl->pending_request_count) {
+    ++impl->stats.uncorrelated_responses;
+    return;
+  }
+  rcutils_time_point_value_t now = 0;
+  rcutils_time_point_value_t take_time = impl->pending_requests[i].take_time;
+  // compact the table before any early return below
+  impl->pending_requests[i] = impl->pending_requests[--impl->pending_request_count];
+  impl->stats.current_inflight = impl->pending_request_count;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now) || now < take_time) {
+    rcutils_reset_error();
+    ++impl->stats.uncorrelated_responses;
+    return;
+  }
+  uint64_t latency = (uint64_t)(now - take_time);
+  rcl_service_stats_t * stats = &impl->stats;
+  stats->last_latency = latency;
+  stats->total_latency += latency;
+  if (0 == stats->request_count || latency < stats->min_latency) {
+    stats->min_latency = latency;
+  }
+  if (latency > stats->max_latency) {
+    stats->max_latency = latency;
+  }
+  ++stats->request_count;
+  // log2 bucket index: position of the highest set bit, 0 for latencies
+  // under 2 ns, saturating in the last bucket
+  size_t bucket = 0;
+  uint64_t remaining = latency >> 1;
+  while (remaining != 0 && bucket < RCL_SERVICE_STATS_LATENCY_BUCKETS - 1) {
+    remaining >>= 1;
+    ++bucket;
+  }
+  ++stats->latency_histogram[bucket];
+}
+
 rcl_service_t
 rcl_get_zero_initialized_service()
 {
@@ -70,76 +166,20 @@ rcl_service_init(
     RCL_SET_ERROR_MSG("service already initialized, or memory was unintialized");
     return RCL_RET_ALREADY_INIT;
   }
-  // Expand the given service name.
-  rcutils_allocator_t rcutils_allocator = *allocator;  // implicit conversion to rcutils version
-  rcutils_string_map_t substitutions_map = rcutils_get_zero_initialized_string_map();
-  rcutils_ret_t rcutils_ret = rcutils_string_map_init(&substitutions_map, 0, rcutils_allocator);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    if (RCUTILS_RET_BAD_ALLOC == rcutils_ret) {
-      return RCL_RET_BAD_ALLOC;
-    }
-    return RCL_RET_ERROR;
-  }
-  rcl_ret_t ret = rcl_get_default_topic_name_substitutions(&substitutions_map);
-  if (ret != RCL_RET_OK) {
-    rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-    if (rcutils_ret != RCUTILS_RET_OK) {
-      RCUTILS_LOG_ERROR_NAMED(
-        ROS_PACKAGE_NAME,
-        "failed to fini string_map (%d) during error handling: %s",
-        rcutils_ret,
-        rcutils_get_error_string().str);
-    }
-    if (RCL_RET_BAD_ALLOC == ret) {
-      return ret;
-    }
-    return RCL_RET_ERROR;
-  }
-  char * expanded_service_name = NULL;
+  // Expand and remap the given service name.
   char * remapped_service_name = NULL;
-  ret = rcl_expand_topic_name(
-    service_name,
-    rcl_node_get_name(node),
-    rcl_node_get_namespace(node),
-    &substitutions_map,
-    *allocator,
-    &expanded_service_name);
-  rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    ret = RCL_RET_ERROR;
-    goto cleanup;
-    return RCL_RET_ERROR;
-  }
-  if (ret != RCL_RET_OK) {
-    if (ret == RCL_RET_TOPIC_NAME_INVALID || ret == RCL_RET_UNKNOWN_SUBSTITUTION) {
+  rcl_ret_t ret = rcl_node_resolve_name(
+    node, service_name, *allocator, true, &remapped_service_name);
+  if (RCL_RET_OK != ret) {
+    if (RCL_RET_TOPIC_NAME_INVALID == ret || RCL_RET_UNKNOWN_SUBSTITUTION == ret) {
       ret = RCL_RET_SERVICE_NAME_INVALID;
-    } else {
+    } else if (RCL_RET_BAD_ALLOC != ret) {
       ret = RCL_RET_ERROR;
     }
     goto cleanup;
   }
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Expanded service name '%s'", expanded_service_name);
-
-  const rcl_node_options_t * node_options = rcl_node_get_options(node);
-  if (NULL == node_options) {
-    ret = RCL_RET_ERROR;
-    goto cleanup;
-  }
-  rcl_arguments_t * global_args = NULL;
-  if (node_options->use_global_arguments) {
-    global_args = &(node->context->global_arguments);
-  }
-  ret = rcl_remap_service_name(
-    &(node_options->arguments), global_args, expanded_service_name,
-    rcl_node_get_name(node), rcl_node_get_namespace(node), *allocator, &remapped_service_name);
-  if (RCL_RET_OK != ret) {
-    goto fail;
-  } else if (NULL == remapped_service_name) {
-    remapped_service_name = expanded_service_name;
-    expanded_service_name = NULL;
-  }
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Expanded and remapped service name '%s'", remapped_service_name);
 
   // Validate the expanded service name.
   int validation_result;
@@ -180,6 +220,11 @@ rcl_service_init(
   }
   // options
   service->impl->options = *options;
+  service->impl->stats_enabled = false;
+  memset(&service->impl->stats, 0, sizeof(rcl_service_stats_t));
+  service->impl->pending_requests = NULL;
+  service->impl->pending_request_count = 0;
+  ++(node->impl->num_services);
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Service initialized");
   ret = RCL_RET_OK;
   goto cleanup;
@@ -190,9 +235,6 @@ fail:
   ret = fail_ret;
   // Fall through to clean up
 cleanup:
-  if (NULL != expanded_service_name) {
-    allocator->deallocate(expanded_service_name, allocator->state);
-  }
   if (NULL != remapped_service_name) {
     allocator->deallocate(remapped_service_name, allocator->state);
   }
@@ -220,7 +262,13 @@ rcl_service_fini(rcl_service_t * service, rcl_node_t * node)
       RCL_SET_ERROR_MSG(rmw_get_error_string().str);
       result = RCL_RET_ERROR;
     }
+    if (NULL != service->impl->pending_requests) {
+      allocator.deallocate(service->impl->pending_requests, allocator.state);
+    }
     allocator.deallocate(service->impl, allocator.state);
+    if (node->impl->num_services > 0) {
+      --(node->impl->num_services);
+    }
   }
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Service finalized");
   return result;
@@ -275,7 +323,7 @@ rcl_take_request(
   void * ros_request)
 {
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Service server taking service request");
-  if (!rcl_service_is_valid(service)) {
+  if (!RCL_RUNTIME_CHECK(rcl_service_is_valid(service))) {
     return RCL_RET_SERVICE_INVALID;  // error already set
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(request_header, RCL_RET_INVALID_ARGUMENT);
@@ -298,6 +346,9 @@ rcl_take_request(
   if (!taken) {
     return RCL_RET_SERVICE_TAKE_FAILED;
   }
+  if (service->impl->stats_enabled) {
+    _rcl_service_stats_record_take(service->impl, request_header);
+  }
   return RCL_RET_OK;
 }
 
@@ -308,7 +359,7 @@ rcl_send_response(
   void * ros_response)
 {
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Sending service response");
-  if (!rcl_service_is_valid(service)) {
+  if (!RCL_RUNTIME_CHECK(rcl_service_is_valid(service))) {
     return RCL_RET_SERVICE_INVALID;  // error already set
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(request_header, RCL_RET_INVALID_ARGUMENT);
@@ -322,6 +373,192 @@ rcl_send_response(
     RCL_SET_ERROR_MSG(rmw_get_error_string().str);
     return RCL_RET_ERROR;
   }
+  if (service->impl->stats_enabled) {
+    _rcl_service_stats_record_response(service->impl, request_header);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_take_requests(
+  const rcl_service_t * service,
+  size_t count,
+  rmw_request_id_t * request_headers,
+  void ** ros_requests,
+  size_t * taken)
+{
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Service server taking up to %zu requests", count);
+  if (!RCL_RUNTIME_CHECK(rcl_service_is_valid(service))) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_headers, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_requests, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(taken, RCL_RET_INVALID_ARGUMENT);
+  *taken = 0;
+
+  // Validate once, then drain the queue without re-checking per request.
+  while (*taken < count) {
+    bool one_taken = false;
+    rmw_ret_t ret = rmw_take_request(
+      service->impl->rmw_handle, &request_headers[*taken], ros_requests[*taken], &one_taken);
+    if (RMW_RET_OK != ret) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      if (RMW_RET_BAD_ALLOC == ret) {
+        return RCL_RET_BAD_ALLOC;
+      }
+      return RCL_RET_ERROR;
+    }
+    if (!one_taken) {
+      break;  // The queue is empty.
+    }
+    if (service->impl->stats_enabled) {
+      _rcl_service_stats_record_take(service->impl, &request_headers[*taken]);
+    }
+    ++(*taken);
+  }
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Service took %zu of %zu requests", *taken, count);
+  if (0 == *taken) {
+    return RCL_RET_SERVICE_TAKE_FAILED;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_send_responses(
+  const rcl_service_t * service,
+  size_t count,
+  rmw_request_id_t * request_headers,
+  void ** ros_responses,
+  size_t * sent)
+{
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Sending %zu service responses", count);
+  if (!RCL_RUNTIME_CHECK(rcl_service_is_valid(service))) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_headers, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_responses, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(sent, RCL_RET_INVALID_ARGUMENT);
+  *sent = 0;
+
+  while (*sent < count) {
+    if (rmw_send_response(
+        service->impl->rmw_handle, &request_headers[*sent], ros_responses[*sent]) != RMW_RET_OK)
+    {
+      // *sent tells the caller where to resume.
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    if (service->impl->stats_enabled) {
+      _rcl_service_stats_record_response(service->impl, &request_headers[*sent]);
+    }
+    ++(*sent);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_borrow_loaned_response(
+  const rcl_service_t * service,
+  const rosidl_service_type_support_t * type_support,
+  void ** ros_response)
+{
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(type_support, RCL_RET_INVALID_ARGUMENT);
+
+  rmw_ret_t ret = rmw_borrow_loaned_response(
+    service->impl->rmw_handle, type_support, ros_response);
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(ret);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_return_loaned_response_from_service(
+  const rcl_service_t * service,
+  void * loaned_response)
+{
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(loaned_response, RCL_RET_INVALID_ARGUMENT);
+
+  rmw_ret_t ret = rmw_return_loaned_response_from_service(
+    service->impl->rmw_handle, loaned_response);
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(ret);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_send_loaned_response(
+  const rcl_service_t * service,
+  rmw_request_id_t * request_header,
+  void * ros_response)
+{
+  if (!RCL_RUNTIME_CHECK(rcl_service_is_valid(service))) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_header, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_response, RCL_RET_INVALID_ARGUMENT);
+
+  rmw_ret_t ret = rmw_send_loaned_response(
+    service->impl->rmw_handle, request_header, ros_response);
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(ret);
+  }
+  if (service->impl->stats_enabled) {
+    _rcl_service_stats_record_response(service->impl, request_header);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_service_enable_stats(const rcl_service_t * service, bool enable)
+{
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  rcl_service_impl_t * impl = service->impl;
+  rcl_allocator_t * allocator = &impl->options.allocator;
+  if (enable && !impl->stats_enabled) {
+    impl->pending_requests = (rcl_service_pending_request_t *)allocator->allocate(
+      RCL_SERVICE_STATS_PENDING_CAPACITY * sizeof(rcl_service_pending_request_t),
+      allocator->state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      impl->pending_requests, "allocating in-flight table failed", return RCL_RET_BAD_ALLOC);
+    impl->pending_request_count = 0;
+    memset(&impl->stats, 0, sizeof(rcl_service_stats_t));
+  }
+  if (!enable && impl->stats_enabled) {
+    allocator->deallocate(impl->pending_requests, allocator->state);
+    impl->pending_requests = NULL;
+    impl->pending_request_count = 0;
+  }
+  impl->stats_enabled = enable;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_service_get_stats(const rcl_service_t * service, rcl_service_stats_t * stats)
+{
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  if (!service->impl->stats_enabled) {
+    RCL_SET_ERROR_MSG("service stats are not enabled");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  *stats = service->impl->stats;
   return RCL_RET_OK;
 }
 
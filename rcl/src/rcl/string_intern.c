@@ -0,0 +1,146 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./string_intern.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "rcutils/strdup.h"
+
+#include "./context_impl.h"
+
+// Get the table of the context, lazily allocating it on first use.
+static rcl_string_intern_table_t *
+__get_intern_table(rcl_context_t * context)
+{
+  if (NULL == context->impl->string_intern_table) {
+    rcl_allocator_t * allocator = &context->impl->allocator;
+    rcl_string_intern_table_t * new_table =
+      (rcl_string_intern_table_t *)allocator->zero_allocate(
+      1, sizeof(rcl_string_intern_table_t), allocator->state);
+    if (NULL == new_table) {
+      return NULL;
+    }
+    new_table->allocator = *allocator;
+    context->impl->string_intern_table = new_table;
+  }
+  return context->impl->string_intern_table;
+}
+
+// Find the index of str, or the index it should be inserted at.
+static size_t
+__intern_table_lower_bound(
+  const rcl_string_intern_table_t * table, const char * str, bool * found)
+{
+  size_t low = 0;
+  size_t high = table->size;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (strcmp(table->entries[mid].str, str) < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  *found = low < table->size && 0 == strcmp(table->entries[low].str, str);
+  return low;
+}
+
+const char *
+rcl_string_intern(rcl_context_t * context, const char * str)
+{
+  rcl_string_intern_table_t * table = __get_intern_table(context);
+  if (NULL == table) {
+    return NULL;
+  }
+  bool found = false;
+  size_t index = __intern_table_lower_bound(table, str, &found);
+  if (found) {
+    ++(table->entries[index].refcount);
+    return table->entries[index].str;
+  }
+  rcl_allocator_t * allocator = &table->allocator;
+  if (table->size == table->capacity) {
+    size_t new_capacity = 0 == table->capacity ? 16 : 2 * table->capacity;
+    rcl_string_intern_entry_t * new_entries =
+      (rcl_string_intern_entry_t *)allocator->reallocate(
+      table->entries, new_capacity * sizeof(rcl_string_intern_entry_t), allocator->state);
+    if (NULL == new_entries) {
+      return NULL;
+    }
+    table->entries = new_entries;
+    table->capacity = new_capacity;
+  }
+  char * copy = rcutils_strdup(str, *allocator);
+  if (NULL == copy) {
+    return NULL;
+  }
+  memmove(
+    &table->entries[index + 1], &table->entries[index],
+    (table->size - index) * sizeof(rcl_string_intern_entry_t));
+  table->entries[index].str = copy;
+  table->entries[index].refcount = 1;
+  ++table->size;
+  return copy;
+}
+
+void
+rcl_string_intern_release(rcl_context_t * context, const char * str)
+{
+  if (NULL == context->impl || NULL == context->impl->string_intern_table || NULL == str) {
+    return;
+  }
+  rcl_string_intern_table_t * table = context->impl->string_intern_table;
+  bool found = false;
+  size_t index = __intern_table_lower_bound(table, str, &found);
+  if (!found || 0 == table->entries[index].refcount) {
+    return;
+  }
+  if (0 == --(table->entries[index].refcount)) {
+    rcl_allocator_t * allocator = &table->allocator;
+    allocator->deallocate(table->entries[index].str, allocator->state);
+    memmove(
+      &table->entries[index], &table->entries[index + 1],
+      (table->size - index - 1) * sizeof(rcl_string_intern_entry_t));
+    --table->size;
+  }
+}
+
+void
+rcl_string_intern_fini(rcl_context_t * context)
+{
+  rcl_string_intern_table_t * table = context->impl->string_intern_table;
+  if (NULL == table) {
+    return;
+  }
+  rcl_allocator_t allocator = table->allocator;
+  // Strings still referenced here belong to holders which outlived the
+  // context; free them anyway rather than leak on cleanup.
+  for (size_t i = 0; i < table->size; ++i) {
+    allocator.deallocate(table->entries[i].str, allocator.state);
+  }
+  allocator.deallocate(table->entries, allocator.state);
+  allocator.deallocate(table, allocator.state);
+  context->impl->string_intern_table = NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
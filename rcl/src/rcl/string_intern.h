@@ -0,0 +1,92 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__STRING_INTERN_H_
+#define RCL__STRING_INTERN_H_
+
+#include "rcl/allocator.h"
+#include "rcl/context.h"
+#include "rcl/visibility_control.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// \internal An interned string and the number of holders referencing it.
+typedef struct rcl_string_intern_entry_t
+{
+  char * str;
+  size_t refcount;
+} rcl_string_intern_entry_t;
+
+/// \internal Per-context table of interned immutable strings.
+/**
+ * Topic, service and node names repeat across entities within a context
+ * (every node resolves "/rosout" and "/parameter_events", sensor topics
+ * fan out to many subscribers), and each holder keeping its own copy adds
+ * up to megabytes in large containers.  The table hands out one shared
+ * refcounted copy per distinct string instead.
+ *
+ * Entries are kept sorted for binary search.  Like the other per-context
+ * singletons, the table is not thread-safe; callers already serialize on
+ * entity creation and destruction.
+ */
+typedef struct rcl_string_intern_table_t
+{
+  /// Entries sorted by strcmp() over str.
+  rcl_string_intern_entry_t * entries;
+  /// Number of entries in use.
+  size_t size;
+  /// Allocated capacity of entries.
+  size_t capacity;
+  rcl_allocator_t allocator;
+} rcl_string_intern_table_t;
+
+/// \internal Get the shared immutable copy of a string, adding a reference.
+/**
+ * The returned pointer stays valid until the matching
+ * rcl_string_intern_release() call, and compares pointer-equal for equal
+ * strings interned in the same context.
+ *
+ * Returns `NULL` if allocating memory failed; no error message is set so
+ * callers can fall back to a private copy.
+ *
+ * \param[in] context the context whose table to intern into
+ * \param[in] str the string to intern
+ * \return the shared copy, or `NULL` if allocating memory failed.
+ */
+RCL_LOCAL
+const char *
+rcl_string_intern(rcl_context_t * context, const char * str);
+
+/// \internal Drop a reference to an interned string, freeing it at zero.
+/**
+ * Does nothing if the context's table has already been cleaned up or the
+ * string is not interned.
+ */
+RCL_LOCAL
+void
+rcl_string_intern_release(rcl_context_t * context, const char * str);
+
+/// \internal Release the table itself; called while cleaning up the context.
+RCL_LOCAL
+void
+rcl_string_intern_fini(rcl_context_t * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__STRING_INTERN_H_
@@ -20,15 +20,20 @@ extern "C"
 #include "rcl/subscription.h"
 
 #include <stdio.h>
+#include <string.h>
 
 #include "rcl/error_handling.h"
-#include "rcl/expand_topic_name.h"
-#include "rcl/remap.h"
+#include "rcl/reclamation.h"
+#include "rcl/time.h"
+#include "rcl/tracepoint.h"
 #include "rcutils/logging_macros.h"
 #include "rmw/error_handling.h"
 #include "rmw/validate_full_topic_name.h"
 
 #include "./common.h"
+#include "./context_impl.h"
+#include "./intra_context.h"
+#include "./node_impl.h"
 #include "./subscription_impl.h"
 
 
@@ -66,75 +71,20 @@ rcl_subscription_init(
     RCL_SET_ERROR_MSG("subscription already initialized, or memory was uninitialized");
     return RCL_RET_ALREADY_INIT;
   }
-  // Expand the given topic name.
-  rcutils_allocator_t rcutils_allocator = *allocator;  // implicit conversion to rcutils version
-  rcutils_string_map_t substitutions_map = rcutils_get_zero_initialized_string_map();
-  rcutils_ret_t rcutils_ret = rcutils_string_map_init(&substitutions_map, 0, rcutils_allocator);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    if (RCUTILS_RET_BAD_ALLOC == rcutils_ret) {
-      return RCL_RET_BAD_ALLOC;
-    }
-    return RCL_RET_ERROR;
-  }
-  rcl_ret_t ret = rcl_get_default_topic_name_substitutions(&substitutions_map);
-  if (ret != RCL_RET_OK) {
-    rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-    if (rcutils_ret != RCUTILS_RET_OK) {
-      RCUTILS_LOG_ERROR_NAMED(
-        ROS_PACKAGE_NAME,
-        "failed to fini string_map (%d) during error handling: %s",
-        rcutils_ret,
-        rcutils_get_error_string().str);
-    }
-    if (RCL_RET_BAD_ALLOC == ret) {
-      return ret;
-    }
-    return RCL_RET_ERROR;
-  }
-  char * expanded_topic_name = NULL;
+  // Expand and remap the given topic name.
   char * remapped_topic_name = NULL;
-  ret = rcl_expand_topic_name(
-    topic_name,
-    rcl_node_get_name(node),
-    rcl_node_get_namespace(node),
-    &substitutions_map,
-    *allocator,
-    &expanded_topic_name);
-  rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    ret = RCL_RET_ERROR;
-    goto cleanup;
-  }
-  if (ret != RCL_RET_OK) {
-    if (ret == RCL_RET_TOPIC_NAME_INVALID || ret == RCL_RET_UNKNOWN_SUBSTITUTION) {
+  rcl_ret_t ret = rcl_node_resolve_name(
+    node, topic_name, *allocator, false, &remapped_topic_name);
+  if (RCL_RET_OK != ret) {
+    if (RCL_RET_TOPIC_NAME_INVALID == ret || RCL_RET_UNKNOWN_SUBSTITUTION == ret) {
       ret = RCL_RET_TOPIC_NAME_INVALID;
-    } else {
+    } else if (RCL_RET_BAD_ALLOC != ret) {
       ret = RCL_RET_ERROR;
     }
     goto cleanup;
   }
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Expanded topic name '%s'", expanded_topic_name);
-
-  const rcl_node_options_t * node_options = rcl_node_get_options(node);
-  if (NULL == node_options) {
-    ret = RCL_RET_ERROR;
-    goto cleanup;
-  }
-  rcl_arguments_t * global_args = NULL;
-  if (node_options->use_global_arguments) {
-    global_args = &(node->context->global_arguments);
-  }
-  ret = rcl_remap_topic_name(
-    &(node_options->arguments), global_args, expanded_topic_name,
-    rcl_node_get_name(node), rcl_node_get_namespace(node), *allocator, &remapped_topic_name);
-  if (RCL_RET_OK != ret) {
-    goto fail;
-  } else if (NULL == remapped_topic_name) {
-    remapped_topic_name = expanded_topic_name;
-    expanded_topic_name = NULL;
-  }
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Expanded and remapped topic name '%s'", remapped_topic_name);
 
   // Validate the expanded topic name.
   int validation_result;
@@ -154,6 +104,19 @@ rcl_subscription_init(
     sizeof(rcl_subscription_impl_t), allocator->state);
   RCL_CHECK_FOR_NULL_WITH_MSG(
     subscription->impl, "allocating memory failed", ret = RCL_RET_BAD_ALLOC; goto cleanup);
+  // Allocate the serialized buffer pool storage, if enabled.
+  memset(
+    &subscription->impl->serialized_buffer_pool, 0, sizeof(rcl_serialized_buffer_pool_t));
+  if (options->serialized_buffer_pool_depth > 0) {
+    subscription->impl->serialized_buffer_pool.buffers = (uint8_t **)allocator->allocate(
+      sizeof(uint8_t *) * RCL_SERIALIZED_BUFFER_POOL_NUM_BUCKETS *
+      options->serialized_buffer_pool_depth,
+      allocator->state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      subscription->impl->serialized_buffer_pool.buffers,
+      "allocating memory failed", ret = RCL_RET_BAD_ALLOC; goto fail);
+    subscription->impl->serialized_buffer_pool.depth = options->serialized_buffer_pool_depth;
+  }
   // Fill out the implemenation struct.
   // rmw_handle
   // TODO(wjwwood): pass allocator once supported in rmw api.
@@ -169,19 +132,53 @@ rcl_subscription_init(
   }
   // options
   subscription->impl->options = *options;
+  // type support, kept for deserializing content-filtered takes
+  subscription->impl->type_support = type_support;
+  // context
+  subscription->impl->context = node->context;
+  subscription->impl->intra_context_registered = false;
+  subscription->impl->blocking_wait_set = NULL;
+  memset(
+    &subscription->impl->pending_serialized, 0, sizeof(rcl_serialized_message_t));
+  subscription->impl->stats_received_count = 0;
+  subscription->impl->stats_last_arrival = 0;
+  subscription->impl->stats_period_mean = 0.0;
+  subscription->impl->stats_period_m2 = 0.0;
+  // Register for direct deliveries from same-context publishers, if requested.
+  if (options->enable_intra_context_delivery) {
+    ret = rcl_intra_context_register_subscription(
+      node->context,
+      subscription->impl->rmw_handle->topic_name,
+      options->intra_context_ring_capacity,
+      &subscription->impl->intra_context_entry);
+    if (RCL_RET_OK != ret) {
+      rmw_ret_t rmw_fail_ret = rmw_destroy_subscription(
+        rcl_node_get_rmw_handle(node), subscription->impl->rmw_handle);
+      if (RMW_RET_OK != rmw_fail_ret) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME,
+          "failed to destroy rmw subscription during error handling: %s",
+          rmw_get_error_string().str);
+      }
+      goto fail;
+    }
+    subscription->impl->intra_context_registered = true;
+  }
+  ++(node->impl->num_subscriptions);
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Subscription initialized");
   ret = RCL_RET_OK;
   goto cleanup;
 fail:
   if (subscription->impl) {
+    if (subscription->impl->serialized_buffer_pool.buffers) {
+      allocator->deallocate(
+        subscription->impl->serialized_buffer_pool.buffers, allocator->state);
+    }
     allocator->deallocate(subscription->impl, allocator->state);
   }
   ret = fail_ret;
   // Fall through to cleanup
 cleanup:
-  if (NULL != expanded_topic_name) {
-    allocator->deallocate(expanded_topic_name, allocator->state);
-  }
   if (NULL != remapped_topic_name) {
     allocator->deallocate(remapped_topic_name, allocator->state);
   }
@@ -203,24 +200,113 @@ rcl_subscription_fini(rcl_subscription_t * subscription, rcl_node_t * node)
     if (!rmw_node) {
       return RCL_RET_INVALID_ARGUMENT;
     }
+    // The registry is gone already if the context was cleaned up first.
+    if (
+      subscription->impl->intra_context_registered &&
+      NULL != subscription->impl->context->impl &&
+      NULL != subscription->impl->context->impl->intra_context_registry)
+    {
+      rcl_ret_t intra_ret = rcl_intra_context_unregister_subscription(
+        subscription->impl->context, subscription->impl->intra_context_entry);
+      if (RCL_RET_OK != intra_ret) {
+        result = RCL_RET_ERROR;
+      }
+    }
+    if (NULL != subscription->impl->blocking_wait_set) {
+      rmw_ret_t wait_set_ret = rmw_destroy_wait_set(subscription->impl->blocking_wait_set);
+      if (wait_set_ret != RMW_RET_OK) {
+        RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+        result = RCL_RET_ERROR;
+      }
+    }
     rmw_ret_t ret =
       rmw_destroy_subscription(rmw_node, subscription->impl->rmw_handle);
     if (ret != RMW_RET_OK) {
       RCL_SET_ERROR_MSG(rmw_get_error_string().str);
       result = RCL_RET_ERROR;
     }
+    if (NULL != subscription->impl->pending_serialized.buffer) {
+      allocator.deallocate(subscription->impl->pending_serialized.buffer, allocator.state);
+    }
+    rcl_serialized_buffer_pool_t * pool = &subscription->impl->serialized_buffer_pool;
+    if (NULL != pool->buffers) {
+      for (size_t bucket = 0; bucket < RCL_SERIALIZED_BUFFER_POOL_NUM_BUCKETS; ++bucket) {
+        for (size_t i = 0; i < pool->counts[bucket]; ++i) {
+          allocator.deallocate(pool->buffers[bucket * pool->depth + i], allocator.state);
+        }
+      }
+      allocator.deallocate(pool->buffers, allocator.state);
+    }
     allocator.deallocate(subscription->impl, allocator.state);
+    if (node->impl->num_subscriptions > 0) {
+      --(node->impl->num_subscriptions);
+    }
   }
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Subscription finalized");
   return result;
 }
 
+// State retained for a deferred fini until reclamation runs it, see
+// rcl_subscription_fini_deferred().
+typedef struct rcl_subscription_deferred_fini_t
+{
+  rcl_subscription_t subscription;
+  rcl_node_t * node;
+  rcl_allocator_t allocator;
+} rcl_subscription_deferred_fini_t;
+
+// Reclamation finalizer: the real fini, run once no thread references the
+// subscription anymore.
+static rcl_ret_t
+_rcl_subscription_deferred_finalize(void * object, void * finalize_context)
+{
+  (void)finalize_context;
+  rcl_subscription_deferred_fini_t * deferred = (rcl_subscription_deferred_fini_t *)object;
+  rcl_ret_t ret = rcl_subscription_fini(&deferred->subscription, deferred->node);
+  rcl_allocator_t allocator = deferred->allocator;
+  allocator.deallocate(deferred, allocator.state);
+  return ret;
+}
+
+rcl_ret_t
+rcl_subscription_fini_deferred(rcl_subscription_t * subscription, rcl_node_t * node)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_SUBSCRIPTION_INVALID);
+  if (!rcl_node_is_valid_except_context(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  if (NULL == subscription->impl) {
+    return RCL_RET_OK;  // nothing to retire, like rcl_subscription_fini()
+  }
+  rcl_context_t * context = subscription->impl->context;
+  rcl_allocator_t allocator = subscription->impl->options.allocator;
+  rcl_subscription_deferred_fini_t * deferred =
+    (rcl_subscription_deferred_fini_t *)allocator.allocate(
+    sizeof(rcl_subscription_deferred_fini_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    deferred, "allocating deferred fini state failed", return RCL_RET_BAD_ALLOC);
+  deferred->subscription = *subscription;
+  deferred->node = node;
+  deferred->allocator = allocator;
+  rcl_ret_t ret = rcl_reclamation_retire(
+    context, deferred, NULL, _rcl_subscription_deferred_finalize);
+  if (RCL_RET_OK != ret) {
+    allocator.deallocate(deferred, allocator.state);
+    return ret;  // error already set
+  }
+  // The caller's handle is dead from here on; the retained copy above keeps
+  // the impl alive for threads still inside a wait or take.
+  subscription->impl = NULL;
+  return RCL_RET_OK;
+}
+
 rcl_subscription_options_t
 rcl_subscription_get_default_options()
 {
   // !!! MAKE SURE THAT CHANGES TO THESE DEFAULTS ARE REFLECTED IN THE HEADER DOC STRING
   static rcl_subscription_options_t default_options = {
     .ignore_local_publications = false,
+    .serialized_buffer_pool_depth = 0,
   };
   // Must set the allocator and qos after because they are not a compile time constant.
   default_options.qos = rmw_qos_profile_default;
@@ -228,8 +314,96 @@ rcl_subscription_get_default_options()
   return default_options;
 }
 
-rcl_ret_t
-rcl_take(
+// Take samples in serialized form, dropping those the subscription's content
+// filter rejects, and deserialize the first match into ros_message.
+static rcl_ret_t
+__take_filtered(
+  const rcl_subscription_t * subscription,
+  void * ros_message,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation)
+{
+  rcl_subscription_impl_t * impl = subscription->impl;
+  rcl_serialized_message_t serialized_message = rmw_get_zero_initialized_serialized_message();
+  rcl_ret_t ret = rcl_subscription_acquire_serialized_message(
+    subscription, 0, &serialized_message);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  while (true) {
+    bool taken = false;
+    rmw_ret_t rmw_ret = rmw_take_serialized_message_with_info(
+      impl->rmw_handle, &serialized_message, &taken, message_info, allocation);
+    if (RMW_RET_OK != rmw_ret) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      ret = (RMW_RET_BAD_ALLOC == rmw_ret) ? RCL_RET_BAD_ALLOC : RCL_RET_ERROR;
+      break;
+    }
+    if (!taken) {
+      ret = RCL_RET_SUBSCRIPTION_TAKE_FAILED;
+      break;
+    }
+    if (!impl->options.content_filter(
+        &serialized_message, impl->options.content_filter_user_data))
+    {
+      continue;  // Dropped before deserialization.
+    }
+    rmw_ret = rmw_deserialize(&serialized_message, impl->type_support, ros_message);
+    if (RMW_RET_OK != rmw_ret) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      ret = RCL_RET_ERROR;
+    } else {
+      ret = RCL_RET_OK;
+    }
+    break;
+  }
+  rcl_ret_t release_ret =
+    rcl_subscription_release_serialized_message(subscription, &serialized_message);
+  if (RCL_RET_OK != release_ret && RCL_RET_OK == ret) {
+    ret = release_ret;  // error already set
+  }
+  return ret;
+}
+
+// Fold one successful take into the running inter-arrival period statistics
+// (Welford's method), see rcl_subscription_get_stats().
+static void
+_rcl_subscription_stats_record_arrival(rcl_subscription_impl_t * impl)
+{
+  rcutils_time_point_value_t now;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    // Best effort: drop the sample rather than failing the take.
+    rcutils_reset_error();
+    return;
+  }
+  if (impl->stats_received_count > 0) {
+    // The nth period, counting the interval to the first recorded take as
+    // none; standard Welford update of the mean and M2.
+    double period = (double)(now - impl->stats_last_arrival);
+    double delta = period - impl->stats_period_mean;
+    impl->stats_period_mean += delta / (double)impl->stats_received_count;
+    impl->stats_period_m2 += delta * (period - impl->stats_period_mean);
+  }
+  impl->stats_last_arrival = now;
+  ++impl->stats_received_count;
+}
+
+// Map a failed rmw take to an rcl return code; out of line to keep the take
+// hot path small.
+static RCL_COLD rcl_ret_t
+_rcl_take_rmw_failed(rmw_ret_t ret)
+{
+  RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+  if (RMW_RET_BAD_ALLOC == ret) {
+    return RCL_RET_BAD_ALLOC;
+  }
+  return RCL_RET_ERROR;
+}
+
+// Take with validation already done, shared by the checked and unchecked
+// entry points.
+static rcl_ret_t
+_rcl_take_validated(
   const rcl_subscription_t * subscription,
   void * ros_message,
   rmw_message_info_t * message_info,
@@ -237,31 +411,270 @@ rcl_take(
 )
 {
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Subscription taking message");
-  if (!rcl_subscription_is_valid(subscription)) {
-    return RCL_RET_SUBSCRIPTION_INVALID;  // error message already set
-  }
-  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
-
   // If message_info is NULL, use a place holder which can be discarded.
   rmw_message_info_t dummy_message_info;
   rmw_message_info_t * message_info_local = message_info ? message_info : &dummy_message_info;
+  if (NULL != subscription->impl->options.content_filter) {
+    rcl_ret_t filtered_ret =
+      __take_filtered(subscription, ros_message, message_info_local, allocation);
+    if (RCL_RET_OK == filtered_ret && subscription->impl->options.enable_stats) {
+      _rcl_subscription_stats_record_arrival(subscription->impl);
+    }
+    return filtered_ret;
+  }
   // Call rmw_take_with_info.
   bool taken = false;
   rmw_ret_t ret =
     rmw_take_with_info(subscription->impl->rmw_handle, ros_message, &taken,
       message_info_local, allocation);
-  if (ret != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    if (RMW_RET_BAD_ALLOC == ret) {
-      return RCL_RET_BAD_ALLOC;
-    }
-    return RCL_RET_ERROR;
+  if (RCL_UNLIKELY(ret != RMW_RET_OK)) {
+    return _rcl_take_rmw_failed(ret);
   }
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME, "Subscription take succeeded: %s", taken ? "true" : "false");
   if (!taken) {
     return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
   }
+  if (subscription->impl->options.enable_stats) {
+    _rcl_subscription_stats_record_arrival(subscription->impl);
+  }
+  return RCL_RET_OK;
+}
+
+// Implementation only
+static rcl_ret_t
+_rcl_take_impl(
+  const rcl_subscription_t * subscription,
+  void * ros_message,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation
+)
+{
+  if (RCL_UNLIKELY(!RCL_RUNTIME_CHECK(rcl_subscription_is_valid(subscription)))) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error message already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  return _rcl_take_validated(subscription, ros_message, message_info, allocation);
+}
+
+rcl_ret_t
+rcl_take(
+  const rcl_subscription_t * subscription,
+  void * ros_message,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation
+)
+{
+  RCL_TRACEPOINT(rcl_take_entry, subscription);
+  rcl_ret_t ret = _rcl_take_impl(subscription, ros_message, message_info, allocation);
+  if (RCL_RET_OK == ret) {
+    rcl_context_counter_add(
+      subscription->impl->context, RCL_CONTEXT_COUNTER_MESSAGES_TAKEN, 1);
+  }
+  RCL_TRACEPOINT(rcl_take_exit, subscription);
+  return ret;
+}
+
+rcl_ret_t
+rcl_subscription_get_validation_token(
+  const rcl_subscription_t * subscription,
+  rcl_subscription_validation_token_t * token)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error message already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(token, RCL_RET_INVALID_ARGUMENT);
+  token->subscription = subscription;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_take_unchecked(
+  const rcl_subscription_validation_token_t * token,
+  void * ros_message,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation)
+{
+  const rcl_subscription_t * subscription = token->subscription;
+  RCL_TRACEPOINT(rcl_take_entry, subscription);
+  rcl_ret_t ret = _rcl_take_validated(subscription, ros_message, message_info, allocation);
+  if (RCL_RET_OK == ret) {
+    rcl_context_counter_add(
+      subscription->impl->context, RCL_CONTEXT_COUNTER_MESSAGES_TAKEN, 1);
+  }
+  RCL_TRACEPOINT(rcl_take_exit, subscription);
+  return ret;
+}
+
+rcl_ret_t
+rcl_take_blocking(
+  const rcl_subscription_t * subscription,
+  int64_t timeout,
+  void * ros_message,
+  rmw_message_info_t * message_info)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error message already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  rcl_subscription_impl_t * impl = subscription->impl;
+  // Lazily create the dedicated wait set, sized for this one subscription.
+  if (NULL == impl->blocking_wait_set) {
+    if (NULL == impl->context || NULL == impl->context->impl) {
+      RCL_SET_ERROR_MSG("subscription's context is invalid");
+      return RCL_RET_ERROR;
+    }
+    impl->blocking_wait_set = rmw_create_wait_set(&(impl->context->impl->rmw_context), 1);
+    if (NULL == impl->blocking_wait_set) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+  }
+  // Park directly on the middleware condition for this one entity; there is
+  // nothing to add, clear, or scan.
+  void * subscriber_handles[1] = {impl->rmw_handle->data};
+  rmw_subscriptions_t subscriptions;
+  subscriptions.subscribers = subscriber_handles;
+  subscriptions.subscriber_count = 1;
+  rmw_time_t temporary_timeout_storage;
+  rmw_time_t * timeout_argument = NULL;  // NULL means block indefinitely
+  if (timeout >= 0) {
+    temporary_timeout_storage.sec = RCL_NS_TO_S(timeout);
+    temporary_timeout_storage.nsec = timeout % 1000000000;
+    timeout_argument = &temporary_timeout_storage;
+  }
+  rmw_ret_t ret = rmw_wait(
+    &subscriptions, NULL, NULL, NULL, NULL, impl->blocking_wait_set, timeout_argument);
+  if (RMW_RET_TIMEOUT == ret) {
+    return RCL_RET_TIMEOUT;
+  }
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return RCL_RET_ERROR;
+  }
+  if (NULL == subscriber_handles[0]) {
+    // Not ready despite the wakeup; treat it like a timeout.
+    return RCL_RET_TIMEOUT;
+  }
+  return rcl_take(subscription, ros_message, message_info, NULL);
+}
+
+rcl_ret_t
+rcl_take_sequence(
+  const rcl_subscription_t * subscription,
+  size_t count,
+  void ** ros_messages,
+  rmw_message_info_t * message_infos,
+  size_t * taken,
+  rmw_subscription_allocation_t * allocation
+)
+{
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Subscription taking up to %zu messages", count);
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error message already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_messages, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(taken, RCL_RET_INVALID_ARGUMENT);
+  *taken = 0;
+
+  // Validate once, then drain the queue without re-checking per message.
+  rmw_message_info_t dummy_message_info;
+  while (*taken < count) {
+    rmw_message_info_t * message_info_local =
+      message_infos ? &message_infos[*taken] : &dummy_message_info;
+    bool one_taken = false;
+    rmw_ret_t ret = rmw_take_with_info(
+      subscription->impl->rmw_handle, ros_messages[*taken], &one_taken,
+      message_info_local, allocation);
+    if (ret != RMW_RET_OK) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      if (RMW_RET_BAD_ALLOC == ret) {
+        return RCL_RET_BAD_ALLOC;
+      }
+      return RCL_RET_ERROR;
+    }
+    if (!one_taken) {
+      break;  // The queue is empty.
+    }
+    ++(*taken);
+  }
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Subscription took %zu of %zu messages", *taken, count);
+  if (0 == *taken) {
+    return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_take_timestamped(
+  const rcl_subscription_t * subscription,
+  void * ros_message,
+  rcl_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation
+)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(message_info, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = rcl_take(
+    subscription, ros_message, &message_info->rmw_message_info, allocation);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  if (RCUTILS_RET_OK != rcutils_system_time_now(&message_info->received_timestamp)) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    return RCL_RET_ERROR;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_take_sequence_timestamped(
+  const rcl_subscription_t * subscription,
+  size_t count,
+  void ** ros_messages,
+  rcl_message_info_t * message_infos,
+  size_t * taken,
+  rmw_subscription_allocation_t * allocation
+)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error message already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_messages, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(message_infos, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(taken, RCL_RET_INVALID_ARGUMENT);
+  *taken = 0;
+
+  while (*taken < count) {
+    bool one_taken = false;
+    rmw_ret_t ret = rmw_take_with_info(
+      subscription->impl->rmw_handle, ros_messages[*taken], &one_taken,
+      &message_infos[*taken].rmw_message_info, allocation);
+    if (ret != RMW_RET_OK) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      if (RMW_RET_BAD_ALLOC == ret) {
+        return RCL_RET_BAD_ALLOC;
+      }
+      return RCL_RET_ERROR;
+    }
+    if (!one_taken) {
+      break;  // The queue is empty.
+    }
+    ++(*taken);
+  }
+  if (0 == *taken) {
+    return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
+  }
+  // One clock read amortized across the whole batch.
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_system_time_now(&now)) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    return RCL_RET_ERROR;
+  }
+  for (size_t i = 0; i < *taken; ++i) {
+    message_infos[i].received_timestamp = now;
+  }
   return RCL_RET_OK;
 }
 
@@ -274,7 +687,7 @@ rcl_take_serialized_message(
 )
 {
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Subscription taking serialized message");
-  if (!rcl_subscription_is_valid(subscription)) {
+  if (!RCL_RUNTIME_CHECK(rcl_subscription_is_valid(subscription))) {
     return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(serialized_message, RCL_RET_INVALID_ARGUMENT);
@@ -297,6 +710,304 @@ rcl_take_serialized_message(
   if (!taken) {
     return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
   }
+  rcl_context_counter_add(
+    subscription->impl->context, RCL_CONTEXT_COUNTER_MESSAGES_TAKEN, 1);
+  rcl_context_counter_add(
+    subscription->impl->context, RCL_CONTEXT_COUNTER_SERIALIZED_BYTES,
+    serialized_message->buffer_length);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_take_serialized_sequence(
+  const rcl_subscription_t * subscription,
+  size_t max_n,
+  rcl_serialized_message_t * slab,
+  size_t * offsets_out,
+  size_t * taken)
+{
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Subscription taking up to %zu serialized messages", max_n);
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(slab, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(slab->buffer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(offsets_out, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(taken, RCL_RET_INVALID_ARGUMENT);
+  *taken = 0;
+  slab->buffer_length = 0;
+  rcl_subscription_impl_t * impl = subscription->impl;
+  // Copy out the message carried over from the previous call first.
+  if (NULL != impl->pending_serialized.buffer) {
+    const size_t pending_length = impl->pending_serialized.buffer_length;
+    if (pending_length > slab->buffer_capacity) {
+      RCL_SET_ERROR_MSG("slab is smaller than the pending serialized message");
+      return RCL_RET_INVALID_ARGUMENT;
+    }
+    memcpy(slab->buffer, impl->pending_serialized.buffer, pending_length);
+    offsets_out[0] = 0;
+    slab->buffer_length = pending_length;
+    *taken = 1;
+    rcl_ret_t release_ret = rcl_subscription_release_serialized_message(
+      subscription, &impl->pending_serialized);
+    if (RCL_RET_OK != release_ret) {
+      return release_ret;  // error already set
+    }
+  }
+  // The middleware may need to grow the take buffer, which is only safe on a
+  // buffer it owns outright, so each message is staged in a pooled buffer and
+  // copied into the slab; a message which does not fit the remaining slab is
+  // kept staged for the next call rather than dropped.
+  rmw_message_info_t dummy_message_info;
+  while (*taken < max_n) {
+    const size_t remaining = slab->buffer_capacity - slab->buffer_length;
+    if (0 == remaining) {
+      break;  // The slab is full.
+    }
+    rcl_serialized_message_t staged;
+    rcl_ret_t acquire_ret = rcl_subscription_acquire_serialized_message(
+      subscription, remaining, &staged);
+    if (RCL_RET_OK != acquire_ret) {
+      return acquire_ret;  // error already set
+    }
+    bool one_taken = false;
+    rmw_ret_t ret = rmw_take_serialized_message_with_info(
+      impl->rmw_handle, &staged, &one_taken, &dummy_message_info, NULL);
+    if (RMW_RET_OK != ret) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      rcl_ret_t fail_ret = RCL_RET_ERROR;
+      if (RMW_RET_BAD_ALLOC == ret) {
+        fail_ret = RCL_RET_BAD_ALLOC;
+      }
+      if (RCL_RET_OK != rcl_subscription_release_serialized_message(subscription, &staged)) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME,
+          "failed to release staged serialized message during error handling");
+      }
+      return fail_ret;
+    }
+    if (!one_taken) {
+      rcl_ret_t release_ret =
+        rcl_subscription_release_serialized_message(subscription, &staged);
+      if (RCL_RET_OK != release_ret) {
+        return release_ret;  // error already set
+      }
+      break;  // The queue is empty.
+    }
+    if (staged.buffer_length > remaining) {
+      // Carry the message over so it is not lost; the next call copies it out.
+      impl->pending_serialized = staged;
+      break;
+    }
+    memcpy(slab->buffer + slab->buffer_length, staged.buffer, staged.buffer_length);
+    offsets_out[*taken] = slab->buffer_length;
+    slab->buffer_length += staged.buffer_length;
+    ++(*taken);
+    rcl_ret_t release_ret =
+      rcl_subscription_release_serialized_message(subscription, &staged);
+    if (RCL_RET_OK != release_ret) {
+      return release_ret;  // error already set
+    }
+  }
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Subscription took %zu of %zu serialized messages", *taken, max_n);
+  if (0 == *taken) {
+    return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_take_intra_context(
+  const rcl_subscription_t * subscription,
+  void ** ros_message
+)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  if (!subscription->impl->intra_context_registered) {
+    RCL_SET_ERROR_MSG("subscription was not initialized for intra-context delivery");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  bool taken = false;
+  rcl_ret_t ret = rcl_intra_context_take(
+    subscription->impl->context,
+    subscription->impl->intra_context_entry,
+    ros_message,
+    &taken);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  if (!taken) {
+    return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_take_loaned_message(
+  const rcl_subscription_t * subscription,
+  void ** loaned_message,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation
+)
+{
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Subscription taking loaned message");
+  if (!RCL_RUNTIME_CHECK(rcl_subscription_is_valid(subscription))) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(loaned_message, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != *loaned_message) {
+    RCL_SET_ERROR_MSG("loaned message is already initialized");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // If message_info is NULL, use a place holder which can be discarded.
+  rmw_message_info_t dummy_message_info;
+  rmw_message_info_t * message_info_local = message_info ? message_info : &dummy_message_info;
+  bool taken = false;
+  rmw_ret_t ret = rmw_take_loaned_message_with_info(
+    subscription->impl->rmw_handle, loaned_message, &taken, message_info_local, allocation);
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(ret);
+  }
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Subscription loaned take succeeded: %s", taken ? "true" : "false");
+  if (!taken) {
+    return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_return_loaned_message_from_subscription(
+  const rcl_subscription_t * subscription,
+  void * loaned_message
+)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(loaned_message, RCL_RET_INVALID_ARGUMENT);
+  rmw_ret_t ret = rmw_return_loaned_message_from_subscription(
+    subscription->impl->rmw_handle, loaned_message);
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(ret);
+  }
+  return RCL_RET_OK;
+}
+
+// Return the index of the smallest pool size class which holds capacity, or
+// RCL_SERIALIZED_BUFFER_POOL_NUM_BUCKETS if the capacity exceeds all classes.
+static size_t
+__serialized_buffer_pool_bucket(size_t capacity)
+{
+  size_t bucket = 0;
+  size_t class_size = (size_t)1 << RCL_SERIALIZED_BUFFER_POOL_MIN_SHIFT;
+  while (bucket < RCL_SERIALIZED_BUFFER_POOL_NUM_BUCKETS && class_size < capacity) {
+    class_size <<= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+rcl_ret_t
+rcl_subscription_acquire_serialized_message(
+  const rcl_subscription_t * subscription,
+  size_t capacity,
+  rcl_serialized_message_t * serialized_message
+)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(serialized_message, RCL_RET_INVALID_ARGUMENT);
+  rcl_allocator_t * allocator = &subscription->impl->options.allocator;
+  rcl_serialized_buffer_pool_t * pool = &subscription->impl->serialized_buffer_pool;
+  const size_t bucket = __serialized_buffer_pool_bucket(capacity);
+  // Round up to the size class so the buffer can be recycled on release.
+  size_t class_size = capacity;
+  if (bucket < RCL_SERIALIZED_BUFFER_POOL_NUM_BUCKETS) {
+    class_size = (size_t)1 << (RCL_SERIALIZED_BUFFER_POOL_MIN_SHIFT + bucket);
+  }
+  uint8_t * buffer = NULL;
+  if (
+    NULL != pool->buffers &&
+    bucket < RCL_SERIALIZED_BUFFER_POOL_NUM_BUCKETS &&
+    pool->counts[bucket] > 0)
+  {
+    buffer = pool->buffers[bucket * pool->depth + --pool->counts[bucket]];
+  } else {
+    buffer = (uint8_t *)allocator->allocate(class_size, allocator->state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      buffer, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  }
+  serialized_message->buffer = buffer;
+  serialized_message->buffer_length = 0;
+  serialized_message->buffer_capacity = class_size;
+  serialized_message->allocator = *allocator;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_subscription_release_serialized_message(
+  const rcl_subscription_t * subscription,
+  rcl_serialized_message_t * serialized_message
+)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(serialized_message, RCL_RET_INVALID_ARGUMENT);
+  rcl_serialized_buffer_pool_t * pool = &subscription->impl->serialized_buffer_pool;
+  uint8_t * buffer = serialized_message->buffer;
+  if (NULL != buffer) {
+    const size_t capacity = serialized_message->buffer_capacity;
+    const size_t bucket = __serialized_buffer_pool_bucket(capacity);
+    // Only buffers sized exactly to a pool class can be recycled.
+    const bool is_pool_class =
+      bucket < RCL_SERIALIZED_BUFFER_POOL_NUM_BUCKETS &&
+      capacity == ((size_t)1 << (RCL_SERIALIZED_BUFFER_POOL_MIN_SHIFT + bucket));
+    if (NULL != pool->buffers && is_pool_class && pool->counts[bucket] < pool->depth) {
+      pool->buffers[bucket * pool->depth + pool->counts[bucket]++] = buffer;
+    } else {
+      serialized_message->allocator.deallocate(
+        buffer, serialized_message->allocator.state);
+    }
+  }
+  serialized_message->buffer = NULL;
+  serialized_message->buffer_length = 0;
+  serialized_message->buffer_capacity = 0;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_subscription_set_history_depth(
+  const rcl_subscription_t * subscription,
+  size_t depth)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  if (0 == depth) {
+    RCL_SET_ERROR_MSG("history depth must be non-zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (RMW_QOS_POLICY_HISTORY_KEEP_LAST != subscription->impl->options.qos.history) {
+    RCL_SET_ERROR_MSG("history depth can only be changed for KEEP_LAST history");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rmw_ret_t ret = rmw_subscription_set_history_depth(
+    subscription->impl->rmw_handle, depth);
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(ret);
+  }
+  subscription->impl->options.qos.depth = depth;
   return RCL_RET_OK;
 }
 
@@ -359,6 +1070,30 @@ rcl_subscription_get_publisher_count(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_subscription_get_stats(
+  const rcl_subscription_t * subscription,
+  rcl_subscription_stats_t * stats)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  const rcl_subscription_impl_t * impl = subscription->impl;
+  if (!impl->options.enable_stats) {
+    RCL_SET_ERROR_MSG("subscription stats are not enabled");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  stats->received_count = impl->stats_received_count;
+  // received_count takes yield received_count - 1 periods.
+  uint64_t periods =
+    impl->stats_received_count > 0 ? impl->stats_received_count - 1 : 0;
+  stats->period_mean = periods > 0 ? impl->stats_period_mean : 0.0;
+  stats->period_variance =
+    periods > 1 ? impl->stats_period_m2 / (double)(periods - 1) : 0.0;
+  return RCL_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
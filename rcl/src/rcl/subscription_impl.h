@@ -15,14 +15,54 @@
 #ifndef RCL__SUBSCRIPTION_IMPL_H_
 #define RCL__SUBSCRIPTION_IMPL_H_
 
+#include "rcutils/time.h"
 #include "rmw/rmw.h"
 
 #include "rcl/subscription.h"
 
+/// Smallest serialized buffer pool size class, as a power-of-two exponent.
+#define RCL_SERIALIZED_BUFFER_POOL_MIN_SHIFT 6
+/// Number of power-of-two size classes, covering 64 B through 512 MiB.
+#define RCL_SERIALIZED_BUFFER_POOL_NUM_BUCKETS 24
+
+typedef struct rcl_serialized_buffer_pool_t
+{
+  /// Cached buffers, indexed as buffers[bucket * depth + i]; NULL if disabled.
+  uint8_t ** buffers;
+  /// Number of cached buffers currently held in each bucket.
+  size_t counts[RCL_SERIALIZED_BUFFER_POOL_NUM_BUCKETS];
+  /// Maximum cached buffers per bucket; 0 if the pool is disabled.
+  size_t depth;
+} rcl_serialized_buffer_pool_t;
+
 typedef struct rcl_subscription_impl_t
 {
   rcl_subscription_options_t options;
   rmw_subscription_t * rmw_handle;
+  /// Type support the subscription was created with; needed to deserialize
+  /// samples taken in serialized form for content filtering.
+  const rosidl_message_type_support_t * type_support;
+  rcl_serialized_buffer_pool_t serialized_buffer_pool;
+  /// Context the subscription was created in.
+  rcl_context_t * context;
+  /// Index into the context's intra-context registry, if registered.
+  size_t intra_context_entry;
+  bool intra_context_registered;
+  /// Dedicated single-entity rmw wait set for rcl_take_blocking(), created
+  /// lazily on first use; NULL until then.
+  rmw_wait_set_t * blocking_wait_set;
+  /// Message staged by rcl_take_serialized_sequence() which did not fit the
+  /// caller's slab; copied out first on the next call. The buffer is NULL
+  /// when nothing is carried over.
+  rcl_serialized_message_t pending_serialized;
+  /// Arrival statistics accumulators, maintained while options.enable_stats
+  /// is true; the variance is derived from the mean and M2 on demand in
+  /// rcl_subscription_get_stats().
+  uint64_t stats_received_count;
+  /// Steady time of the most recent recorded take.
+  rcutils_time_point_value_t stats_last_arrival;
+  double stats_period_mean;
+  double stats_period_m2;
 } rcl_subscription_impl_t;
 
 #endif  // RCL__SUBSCRIPTION_IMPL_H_
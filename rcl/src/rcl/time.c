@@ -27,7 +27,14 @@
 typedef struct rcl_ros_clock_storage_t
 {
   atomic_uint_least64_t current_time;
-  bool active;
+  // Incremented whenever the override changes, so readers can detect
+  // overrides lock-free instead of being visited by the writer.
+  atomic_uint_least64_t override_epoch;
+  // Seqlock sequence guarding the {active, current_time} pair; odd while a
+  // writer is mid update.  Readers retry instead of taking a lock, so the
+  // hot read path is two loads and a sequence check.
+  atomic_uint_least64_t state_sequence;
+  atomic_bool active;
 } rcl_ros_clock_storage_t;
 
 // Implementation only
@@ -53,6 +60,11 @@ rcl_init_generic_clock(rcl_clock_t * clock)
   clock->type = RCL_CLOCK_UNINITIALIZED;
   clock->jump_callbacks = NULL;
   clock->num_jump_callbacks = 0u;
+  clock->jump_callbacks_capacity = 0u;
+  clock->jump_callbacks_forward_order = NULL;
+  clock->jump_callbacks_backward_order = NULL;
+  // 0 is a special value meaning the cache has not been filled
+  clock->cached_now = 0;
   clock->get_now = NULL;
   clock->data = NULL;
 }
@@ -63,10 +75,25 @@ rcl_ret_t
 rcl_get_ros_time(void * data, rcl_time_point_value_t * current_time)
 {
   rcl_ros_clock_storage_t * t = (rcl_ros_clock_storage_t *)data;
-  if (!t->active) {
+  // Seqlock read side: retry if a writer toggled the active flag or moved the
+  // override between the loads, so the pair is always observed consistently.
+  uint64_t sequence = 0;
+  bool active = false;
+  uint64_t override_value = 0;
+  do {
+    sequence = rcutils_atomic_load_uint64_t(&(t->state_sequence));
+    if (sequence & 1u) {
+      // A writer is mid update; retry.
+      continue;
+    }
+    active = rcutils_atomic_load_bool(&(t->active));
+    override_value = rcutils_atomic_load_uint64_t(&(t->current_time));
+  } while ((sequence & 1u) ||
+    sequence != rcutils_atomic_load_uint64_t(&(t->state_sequence)));
+  if (!active) {
     return rcl_get_system_time(data, current_time);
   }
-  *current_time = rcutils_atomic_load_uint64_t(&(t->current_time));
+  *current_time = override_value;
   return RCL_RET_OK;
 }
 
@@ -109,11 +136,22 @@ _rcl_clock_generic_fini(
   rcl_clock_t * clock)
 {
   // Internal function; assume caller has already checked that clock is valid.
-  if (clock->num_jump_callbacks > 0) {
-    clock->num_jump_callbacks = 0;
+  // Capacity is retained after removals, so free based on the pointers rather
+  // than the callback count.
+  if (NULL != clock->jump_callbacks) {
     clock->allocator.deallocate(clock->jump_callbacks, clock->allocator.state);
     clock->jump_callbacks = NULL;
   }
+  if (NULL != clock->jump_callbacks_forward_order) {
+    clock->allocator.deallocate(clock->jump_callbacks_forward_order, clock->allocator.state);
+    clock->jump_callbacks_forward_order = NULL;
+  }
+  if (NULL != clock->jump_callbacks_backward_order) {
+    clock->allocator.deallocate(clock->jump_callbacks_backward_order, clock->allocator.state);
+    clock->jump_callbacks_backward_order = NULL;
+  }
+  clock->num_jump_callbacks = 0;
+  clock->jump_callbacks_capacity = 0;
 }
 
 rcl_ret_t
@@ -149,7 +187,9 @@ rcl_ros_clock_init(
   rcl_ros_clock_storage_t * storage = (rcl_ros_clock_storage_t *)clock->data;
   // 0 is a special value meaning time has not been set
   atomic_init(&(storage->current_time), 0);
-  storage->active = false;
+  atomic_init(&(storage->override_epoch), 0);
+  atomic_init(&(storage->state_sequence), 0);
+  atomic_init(&(storage->active), false);
   clock->get_now = rcl_get_ros_time;
   clock->type = RCL_ROS_TIME;
   clock->allocator = *allocator;
@@ -250,6 +290,15 @@ rcl_clock_get_now(rcl_clock_t * clock, rcl_time_point_value_t * time_point_value
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(clock, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(time_point_value, RCL_RET_INVALID_ARGUMENT);
+  // Reach the time functions directly for the common clock types; this skips
+  // the indirect call and lets the compiler see the (vDSO backed) rcutils
+  // call at the call site.
+  if (RCL_STEADY_TIME == clock->type) {
+    return rcutils_steady_time_now(time_point_value);
+  }
+  if (RCL_SYSTEM_TIME == clock->type) {
+    return rcutils_system_time_now(time_point_value);
+  }
   if (clock->type && clock->get_now) {
     return clock->get_now(clock->data, time_point_value);
   }
@@ -257,6 +306,35 @@ rcl_clock_get_now(rcl_clock_t * clock, rcl_time_point_value_t * time_point_value
   return RCL_RET_ERROR;
 }
 
+rcl_ret_t
+rcl_clock_cache_now(rcl_clock_t * clock)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(clock, RCL_RET_INVALID_ARGUMENT);
+  rcl_time_point_value_t now;
+  rcl_ret_t ret = rcl_clock_get_now(clock, &now);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  clock->cached_now = now;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_clock_get_now_coarse(rcl_clock_t * clock, rcl_time_point_value_t * time_point_value)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(clock, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(time_point_value, RCL_RET_INVALID_ARGUMENT);
+  if (0 == clock->cached_now) {
+    // Never cached; query the clock once to prime the cache.
+    rcl_ret_t ret = rcl_clock_cache_now(clock);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  *time_point_value = clock->cached_now;
+  return RCL_RET_OK;
+}
+
 void
 _rcl_clock_call_callbacks(
   rcl_clock_t * clock, const rcl_time_jump_t * time_jump, bool before_jump)
@@ -264,15 +342,35 @@ _rcl_clock_call_callbacks(
   // Internal function; assume parameters are valid.
   bool is_clock_change = time_jump->clock_change == RCL_ROS_TIME_ACTIVATED ||
     time_jump->clock_change == RCL_ROS_TIME_DEACTIVATED;
-  for (size_t cb_idx = 0; cb_idx < clock->num_jump_callbacks; ++cb_idx) {
-    rcl_jump_callback_info_t * info = &(clock->jump_callbacks[cb_idx]);
-    if (
-      (is_clock_change && info->threshold.on_clock_change) ||
-      (time_jump->delta.nanoseconds < 0 &&
-      time_jump->delta.nanoseconds <= info->threshold.min_backward.nanoseconds) ||
-      (time_jump->delta.nanoseconds > 0 &&
-      time_jump->delta.nanoseconds >= info->threshold.min_forward.nanoseconds))
-    {
+  if (is_clock_change) {
+    // Clock source changes are rare; visit every callback that opted in.
+    for (size_t cb_idx = 0; cb_idx < clock->num_jump_callbacks; ++cb_idx) {
+      rcl_jump_callback_info_t * info = &(clock->jump_callbacks[cb_idx]);
+      if (info->threshold.on_clock_change) {
+        info->callback(time_jump, before_jump, info->user_data);
+      }
+    }
+    return;
+  }
+  // For plain jumps the dispatch orders are sorted by threshold, so iteration
+  // can stop at the first callback whose threshold is not crossed instead of
+  // testing every registered callback on every time update.
+  if (time_jump->delta.nanoseconds > 0) {
+    for (size_t i = 0; i < clock->num_jump_callbacks; ++i) {
+      rcl_jump_callback_info_t * info =
+        &(clock->jump_callbacks[clock->jump_callbacks_forward_order[i]]);
+      if (time_jump->delta.nanoseconds < info->threshold.min_forward.nanoseconds) {
+        break;
+      }
+      info->callback(time_jump, before_jump, info->user_data);
+    }
+  } else if (time_jump->delta.nanoseconds < 0) {
+    for (size_t i = 0; i < clock->num_jump_callbacks; ++i) {
+      rcl_jump_callback_info_t * info =
+        &(clock->jump_callbacks[clock->jump_callbacks_backward_order[i]]);
+      if (time_jump->delta.nanoseconds > info->threshold.min_backward.nanoseconds) {
+        break;
+      }
       info->callback(time_jump, before_jump, info->user_data);
     }
   }
@@ -291,12 +389,17 @@ rcl_enable_ros_time_override(rcl_clock_t * clock)
     RCL_SET_ERROR_MSG("Clock storage is not initialized, cannot enable override.");
     return RCL_RET_ERROR;
   }
-  if (!storage->active) {
+  if (!rcutils_atomic_load_bool(&(storage->active))) {
     rcl_time_jump_t time_jump;
     time_jump.delta.nanoseconds = 0;
     time_jump.clock_change = RCL_ROS_TIME_ACTIVATED;
     _rcl_clock_call_callbacks(clock, &time_jump, true);
-    storage->active = true;
+    // Seqlock write section; kept free of callbacks since a reader retries
+    // for as long as the sequence is odd.
+    rcutils_atomic_fetch_add_uint64_t(&(storage->state_sequence), 1);
+    rcutils_atomic_store(&(storage->active), true);
+    rcutils_atomic_fetch_add_uint64_t(&(storage->state_sequence), 1);
+    rcutils_atomic_fetch_add_uint64_t(&(storage->override_epoch), 1);
     _rcl_clock_call_callbacks(clock, &time_jump, false);
   }
   return RCL_RET_OK;
@@ -316,12 +419,16 @@ rcl_disable_ros_time_override(rcl_clock_t * clock)
     RCL_SET_ERROR_MSG("Clock storage is not initialized, cannot disable override.");
     return RCL_RET_ERROR;
   }
-  if (storage->active) {
+  if (rcutils_atomic_load_bool(&(storage->active))) {
     rcl_time_jump_t time_jump;
     time_jump.delta.nanoseconds = 0;
     time_jump.clock_change = RCL_ROS_TIME_DEACTIVATED;
     _rcl_clock_call_callbacks(clock, &time_jump, true);
-    storage->active = false;
+    // Seqlock write section, see rcl_enable_ros_time_override().
+    rcutils_atomic_fetch_add_uint64_t(&(storage->state_sequence), 1);
+    rcutils_atomic_store(&(storage->active), false);
+    rcutils_atomic_fetch_add_uint64_t(&(storage->state_sequence), 1);
+    rcutils_atomic_fetch_add_uint64_t(&(storage->override_epoch), 1);
     _rcl_clock_call_callbacks(clock, &time_jump, false);
   }
   return RCL_RET_OK;
@@ -344,7 +451,7 @@ rcl_is_enabled_ros_time_override(
     RCL_SET_ERROR_MSG("Clock storage is not initialized, cannot query override state.");
     return RCL_RET_ERROR;
   }
-  *is_enabled = storage->active;
+  *is_enabled = rcutils_atomic_load_bool(&(storage->active));
   return RCL_RET_OK;
 }
 
@@ -360,7 +467,8 @@ rcl_set_ros_time_override(
   }
   rcl_time_jump_t time_jump;
   rcl_ros_clock_storage_t * storage = (rcl_ros_clock_storage_t *)clock->data;
-  if (storage->active) {
+  const bool active = rcutils_atomic_load_bool(&(storage->active));
+  if (active) {
     time_jump.clock_change = RCL_ROS_TIME_NO_CHANGE;
     rcl_time_point_value_t current_time;
     rcl_ret_t ret = rcl_get_ros_time(storage, &current_time);
@@ -370,13 +478,73 @@ rcl_set_ros_time_override(
     time_jump.delta.nanoseconds = time_value - current_time;
     _rcl_clock_call_callbacks(clock, &time_jump, true);
   }
+  // Seqlock write section, see rcl_enable_ros_time_override().
+  rcutils_atomic_fetch_add_uint64_t(&(storage->state_sequence), 1);
   rcutils_atomic_store(&(storage->current_time), time_value);
-  if (storage->active) {
+  rcutils_atomic_fetch_add_uint64_t(&(storage->state_sequence), 1);
+  // Bump the epoch after the value so an epoch observer reads the new time.
+  rcutils_atomic_fetch_add_uint64_t(&(storage->override_epoch), 1);
+  if (active) {
     _rcl_clock_call_callbacks(clock, &time_jump, false);
   }
   return RCL_RET_OK;
 }
 
+// Rebuild the threshold-sorted dispatch orders after the callback set changed.
+// Insertion sort; the callback list is expected to stay small and mutation is
+// far off the dispatch hot path.
+static void
+_rcl_clock_sort_jump_callbacks(rcl_clock_t * clock)
+{
+  size_t * forward = clock->jump_callbacks_forward_order;
+  size_t * backward = clock->jump_callbacks_backward_order;
+  for (size_t i = 0; i < clock->num_jump_callbacks; ++i) {
+    forward[i] = i;
+    backward[i] = i;
+  }
+  for (size_t i = 1; i < clock->num_jump_callbacks; ++i) {
+    size_t index = forward[i];
+    int64_t threshold = clock->jump_callbacks[index].threshold.min_forward.nanoseconds;
+    size_t pos = i;
+    while (pos > 0 &&
+      clock->jump_callbacks[forward[pos - 1]].threshold.min_forward.nanoseconds > threshold)
+    {
+      forward[pos] = forward[pos - 1];
+      --pos;
+    }
+    forward[pos] = index;
+    index = backward[i];
+    threshold = clock->jump_callbacks[index].threshold.min_backward.nanoseconds;
+    pos = i;
+    while (pos > 0 &&
+      clock->jump_callbacks[backward[pos - 1]].threshold.min_backward.nanoseconds < threshold)
+    {
+      backward[pos] = backward[pos - 1];
+      --pos;
+    }
+    backward[pos] = index;
+  }
+}
+
+rcl_ret_t
+rcl_clock_get_override_epoch(rcl_clock_t * clock, uint64_t * epoch)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(clock, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(epoch, RCL_RET_INVALID_ARGUMENT);
+  if (clock->type != RCL_ROS_TIME) {
+    // Only ROS time clocks can be overridden; the epoch never moves.
+    *epoch = 0;
+    return RCL_RET_OK;
+  }
+  rcl_ros_clock_storage_t * storage = (rcl_ros_clock_storage_t *)clock->data;
+  if (!storage) {
+    RCL_SET_ERROR_MSG("Clock storage is not initialized, cannot query override epoch.");
+    return RCL_RET_ERROR;
+  }
+  *epoch = rcutils_atomic_load_uint64_t(&(storage->override_epoch));
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_clock_add_jump_callback(
   rcl_clock_t * clock, rcl_jump_threshold_t threshold, rcl_jump_callback_t callback,
@@ -405,19 +573,42 @@ rcl_clock_add_jump_callback(
     }
   }
 
-  // Add the new callback, increasing the size of the callback list
-  rcl_jump_callback_info_t * callbacks = clock->allocator.reallocate(
-    clock->jump_callbacks, sizeof(rcl_jump_callback_info_t) * (clock->num_jump_callbacks + 1),
-    clock->allocator.state);
-  if (NULL == callbacks) {
-    RCL_SET_ERROR_MSG("Failed to realloc jump callbacks");
-    return RCL_RET_BAD_ALLOC;
+  // Grow the callback storage geometrically so repeated registration does not
+  // reallocate every time; removed slots are reused before growing again.
+  if (clock->num_jump_callbacks == clock->jump_callbacks_capacity) {
+    size_t new_capacity =
+      (0 == clock->jump_callbacks_capacity) ? 4 : 2 * clock->jump_callbacks_capacity;
+    rcl_jump_callback_info_t * callbacks = clock->allocator.reallocate(
+      clock->jump_callbacks, sizeof(rcl_jump_callback_info_t) * new_capacity,
+      clock->allocator.state);
+    if (NULL == callbacks) {
+      RCL_SET_ERROR_MSG("Failed to realloc jump callbacks");
+      return RCL_RET_BAD_ALLOC;
+    }
+    clock->jump_callbacks = callbacks;
+    size_t * forward_order = clock->allocator.reallocate(
+      clock->jump_callbacks_forward_order, sizeof(size_t) * new_capacity,
+      clock->allocator.state);
+    if (NULL == forward_order) {
+      RCL_SET_ERROR_MSG("Failed to realloc jump callbacks");
+      return RCL_RET_BAD_ALLOC;
+    }
+    clock->jump_callbacks_forward_order = forward_order;
+    size_t * backward_order = clock->allocator.reallocate(
+      clock->jump_callbacks_backward_order, sizeof(size_t) * new_capacity,
+      clock->allocator.state);
+    if (NULL == backward_order) {
+      RCL_SET_ERROR_MSG("Failed to realloc jump callbacks");
+      return RCL_RET_BAD_ALLOC;
+    }
+    clock->jump_callbacks_backward_order = backward_order;
+    clock->jump_callbacks_capacity = new_capacity;
   }
-  clock->jump_callbacks = callbacks;
   clock->jump_callbacks[clock->num_jump_callbacks].callback = callback;
   clock->jump_callbacks[clock->num_jump_callbacks].threshold = threshold;
   clock->jump_callbacks[clock->num_jump_callbacks].user_data = user_data;
   ++(clock->num_jump_callbacks);
+  _rcl_clock_sort_jump_callbacks(clock);
   return RCL_RET_OK;
 }
 
@@ -446,20 +637,9 @@ rcl_clock_remove_jump_callback(
     return RCL_RET_ERROR;
   }
 
-  // Shrink size of the callback array
-  if (clock->num_jump_callbacks == 1) {
-    clock->allocator.deallocate(clock->jump_callbacks, clock->allocator.state);
-    clock->jump_callbacks = NULL;
-  } else {
-    rcl_jump_callback_info_t * callbacks = clock->allocator.reallocate(
-      clock->jump_callbacks, sizeof(rcl_jump_callback_info_t) * (clock->num_jump_callbacks - 1),
-      clock->allocator.state);
-    if (NULL == callbacks) {
-      RCL_SET_ERROR_MSG("Failed to shrink jump callbacks");
-      return RCL_RET_BAD_ALLOC;
-    }
-    clock->jump_callbacks = callbacks;
-  }
+  // The capacity is kept so the freed slot can be reused by a later
+  // registration without reallocating.
   --(clock->num_jump_callbacks);
+  _rcl_clock_sort_jump_callbacks(clock);
   return RCL_RET_OK;
 }
@@ -22,10 +22,14 @@ extern "C"
 #include <inttypes.h>
 
 #include "rcl/error_handling.h"
+#include "rcl/tracepoint.h"
 #include "rcutils/logging_macros.h"
 #include "rcutils/stdatomic_helper.h"
 #include "rcutils/time.h"
 
+#include "./context_impl.h"
+#include "./timer_wheel.h"
+
 typedef struct rcl_timer_impl_t
 {
   // The clock providing time.
@@ -36,6 +40,8 @@ typedef struct rcl_timer_impl_t
   rcl_guard_condition_t guard_condition;
   // The user supplied callback.
   atomic_uintptr_t callback;
+  // An opaque pointer for the callback's use, not interpreted by rcl.
+  atomic_uintptr_t user_data;
   // This is a duration in nanoseconds.
   atomic_uint_least64_t period;
   // This is a time in nanoseconds since an unspecified time.
@@ -46,6 +52,17 @@ typedef struct rcl_timer_impl_t
   atomic_int_least64_t time_credit;
   // A flag which indicates if the timer is canceled.
   atomic_bool canceled;
+  // Tolerable wakeup lateness in nanoseconds; immutable after init.
+  int64_t slack;
+  // True if the timer fires once and then cancels itself; immutable after init.
+  bool oneshot;
+  // True while the wait layer should spin the final approach to this timer's
+  // deadline, see rcl_timer_set_precision().
+  atomic_bool precision;
+  // Clock override epoch last reconciled with; see _rcl_timer_observe_override_epoch().
+  atomic_uint_least64_t observed_override_epoch;
+  // The timer's node in the context's timer wheel, or NULL.
+  rcl_timer_wheel_node_t * wheel_node;
   // The user supplied allocator.
   rcl_allocator_t allocator;
 } rcl_timer_impl_t;
@@ -88,7 +105,6 @@ void _rcl_timer_time_jump(
       RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to get current time in jump callback");
       return;
     }
-    const int64_t last_call_time = rcutils_atomic_load_int64_t(&timer->impl->last_call_time);
     const int64_t next_call_time = rcutils_atomic_load_int64_t(&timer->impl->next_call_time);
     const int64_t period = rcutils_atomic_load_uint64_t(&timer->impl->period);
     if (RCL_ROS_TIME_ACTIVATED == time_jump->clock_change ||
@@ -111,13 +127,41 @@ void _rcl_timer_time_jump(
         RCUTILS_LOG_ERROR_NAMED(
           ROS_PACKAGE_NAME, "Failed to get trigger guard condition in jump callback");
       }
-    } else if (now < last_call_time) {
-      // Post backwards time jump that went further back than 1 period
-      // next callback should happen after 1 period
-      rcutils_atomic_store(&timer->impl->next_call_time, now + period);
-      rcutils_atomic_store(&timer->impl->last_call_time, now);
-      return;
     }
+    // Backwards jumps are reconciled lazily by the readers via the clock's
+    // override epoch, see _rcl_timer_observe_override_epoch(), so the
+    // override writer does not visit every timer.
+  }
+}
+
+// Reconcile the timer with time overrides that happened since it was last
+// read, detected by comparing the clock's override epoch lock-free.
+// Called with a freshly read `now` by the functions which compare it against
+// the timer state.
+static void
+_rcl_timer_observe_override_epoch(const rcl_timer_t * timer, rcl_time_point_value_t now)
+{
+  uint64_t epoch = 0;
+  if (RCL_RET_OK != rcl_clock_get_override_epoch(timer->impl->clock, &epoch)) {
+    rcl_reset_error();
+    return;
+  }
+  if (epoch == rcutils_atomic_load_uint64_t(&timer->impl->observed_override_epoch)) {
+    return;
+  }
+  // The exchange lets exactly one concurrent reader apply the fix-up.
+  uint64_t previous =
+    rcutils_atomic_exchange_uint64_t(&timer->impl->observed_override_epoch, epoch);
+  if (previous == epoch) {
+    return;
+  }
+  const int64_t last_call_time = rcutils_atomic_load_int64_t(&timer->impl->last_call_time);
+  if (now < last_call_time) {
+    // Time jumped back past the last call; the next callback should happen
+    // one period from the new now.
+    const int64_t period = rcutils_atomic_load_uint64_t(&timer->impl->period);
+    rcutils_atomic_store(&timer->impl->next_call_time, now + period);
+    rcutils_atomic_store(&timer->impl->last_call_time, now);
   }
 }
 
@@ -127,6 +171,7 @@ rcl_timer_init(
   rcl_clock_t * clock,
   rcl_context_t * context,
   int64_t period,
+  int64_t slack,
   const rcl_timer_callback_t callback,
   rcl_allocator_t allocator)
 {
@@ -137,6 +182,10 @@ rcl_timer_init(
     RCL_SET_ERROR_MSG("timer period must be non-negative");
     return RCL_RET_INVALID_ARGUMENT;
   }
+  if (slack < 0) {
+    RCL_SET_ERROR_MSG("timer slack must be non-negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME, "Initializing timer with period: %" PRIu64 "ns", period);
   if (timer->impl) {
@@ -161,7 +210,9 @@ rcl_timer_init(
     rcl_jump_threshold_t threshold;
     threshold.on_clock_change = true;
     threshold.min_forward.nanoseconds = 1;
-    threshold.min_backward.nanoseconds = -1;
+    // Backward jumps are handled lazily through the override epoch, so the
+    // callback effectively never needs to be visited for them.
+    threshold.min_backward.nanoseconds = INT64_MIN;
     ret = rcl_clock_add_jump_callback(clock, threshold, _rcl_timer_time_jump, timer);
     if (RCL_RET_OK != ret) {
       if (RCL_RET_OK != rcl_guard_condition_fini(&(impl.guard_condition))) {
@@ -173,11 +224,18 @@ rcl_timer_init(
     }
   }
   atomic_init(&impl.callback, (uintptr_t)callback);
+  atomic_init(&impl.user_data, (uintptr_t)NULL);
   atomic_init(&impl.period, period);
   atomic_init(&impl.time_credit, 0);
   atomic_init(&impl.last_call_time, now);
   atomic_init(&impl.next_call_time, now + period);
   atomic_init(&impl.canceled, false);
+  atomic_init(&impl.precision, false);
+  uint64_t override_epoch = 0;
+  if (RCL_RET_OK != rcl_clock_get_override_epoch(clock, &override_epoch)) {
+    rcl_reset_error();
+  }
+  atomic_init(&impl.observed_override_epoch, override_epoch);
   impl.allocator = allocator;
   timer->impl = (rcl_timer_impl_t *)allocator.allocate(sizeof(rcl_timer_impl_t), allocator.state);
   if (NULL == timer->impl) {
@@ -193,7 +251,48 @@ rcl_timer_init(
     RCL_SET_ERROR_MSG("allocating memory failed");
     return RCL_RET_BAD_ALLOC;
   }
+  impl.slack = slack;
+  impl.oneshot = false;
+  impl.wheel_node = NULL;
   *timer->impl = impl;
+  // Register with the context's timer wheel so expiry is O(expired), not O(n).
+  if (NULL != context) {
+    rcl_ret_t wheel_ret = rcl_timer_wheel_register(
+      context, timer, &timer->impl->wheel_node);
+    if (RCL_RET_OK != wheel_ret) {
+      rcl_ret_t fini_ret = rcl_timer_fini(timer);
+      if (RCL_RET_OK != fini_ret) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "Failed to fini timer after failing to register with timer wheel");
+      }
+      return wheel_ret;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_timer_init_oneshot_at(
+  rcl_timer_t * timer,
+  rcl_clock_t * clock,
+  rcl_context_t * context,
+  rcl_time_point_value_t deadline,
+  const rcl_timer_callback_t callback,
+  rcl_allocator_t allocator)
+{
+  if (deadline < 0) {
+    RCL_SET_ERROR_MSG("timer deadline must be non-negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // A zero period timer is always ready once its next call time has passed,
+  // which matches the one-shot semantics; the init sets next_call_time to
+  // now, so overwrite it with the absolute deadline afterwards.
+  rcl_ret_t ret = rcl_timer_init(timer, clock, context, 0, 0, callback, allocator);
+  if (RCL_RET_OK != ret) {
+    return ret;  // rcl error state should already be set.
+  }
+  timer->impl->oneshot = true;
+  rcutils_atomic_store(&timer->impl->next_call_time, deadline);
   return RCL_RET_OK;
 }
 
@@ -205,6 +304,7 @@ rcl_timer_fini(rcl_timer_t * timer)
   }
   // Will return either RCL_RET_OK or RCL_RET_ERROR since the timer is valid.
   rcl_ret_t result = rcl_timer_cancel(timer);
+  rcl_timer_wheel_unregister(timer->impl->wheel_node);
   rcl_allocator_t allocator = timer->impl->allocator;
   rcl_ret_t fail_ret = rcl_guard_condition_fini(&(timer->impl->guard_condition));
   if (RCL_RET_OK != fail_ret) {
@@ -233,49 +333,56 @@ rcl_timer_clock(rcl_timer_t * timer, rcl_clock_t ** clock)
   return RCL_RET_OK;
 }
 
-rcl_ret_t
-rcl_timer_call(rcl_timer_t * timer)
+// Implementation only
+static rcl_ret_t
+_rcl_timer_call_impl(rcl_timer_t * timer)
 {
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Calling timer");
   RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
-  if (rcutils_atomic_load_bool(&timer->impl->canceled)) {
+  if (RCL_UNLIKELY(rcutils_atomic_load_bool(&timer->impl->canceled))) {
     RCL_SET_ERROR_MSG("timer is canceled");
     return RCL_RET_TIMER_CANCELED;
   }
   rcl_time_point_value_t now;
   rcl_ret_t now_ret = rcl_clock_get_now(timer->impl->clock, &now);
-  if (now_ret != RCL_RET_OK) {
+  if (RCL_UNLIKELY(now_ret != RCL_RET_OK)) {
     return now_ret;  // rcl error state should already be set.
   }
-  if (now < 0) {
+  if (RCL_UNLIKELY(now < 0)) {
     RCL_SET_ERROR_MSG("clock now returned negative time point value");
     return RCL_RET_ERROR;
   }
+  _rcl_timer_observe_override_epoch(timer, now);
   rcl_time_point_value_t previous_ns =
     rcutils_atomic_exchange_int64_t(&timer->impl->last_call_time, now);
   rcl_timer_callback_t typed_callback =
     (rcl_timer_callback_t)rcutils_atomic_load_uintptr_t(&timer->impl->callback);
 
-  int64_t next_call_time = rcutils_atomic_load_int64_t(&timer->impl->next_call_time);
-  int64_t period = rcutils_atomic_load_uint64_t(&timer->impl->period);
-  // always move the next call time by exactly period forward
-  // don't use now as the base to avoid extending each cycle by the time
-  // between the timer being ready and the callback being triggered
-  next_call_time += period;
-  // in case the timer has missed at least once cycle
-  if (next_call_time < now) {
-    if (0 == period) {
-      // a timer with a period of zero is considered always ready
-      next_call_time = now;
-    } else {
-      // move the next call time forward by as many periods as necessary
-      int64_t now_ahead = now - next_call_time;
-      // rounding up without overflow
-      int64_t periods_ahead = 1 + (now_ahead - 1) / period;
-      next_call_time += periods_ahead * period;
+  if (timer->impl->oneshot) {
+    // A one-shot timer fires exactly once, then behaves as canceled until reset.
+    rcutils_atomic_store(&timer->impl->canceled, true);
+  } else {
+    int64_t next_call_time = rcutils_atomic_load_int64_t(&timer->impl->next_call_time);
+    int64_t period = rcutils_atomic_load_uint64_t(&timer->impl->period);
+    // always move the next call time by exactly period forward
+    // don't use now as the base to avoid extending each cycle by the time
+    // between the timer being ready and the callback being triggered
+    next_call_time += period;
+    // in case the timer has missed at least once cycle
+    if (next_call_time < now) {
+      if (0 == period) {
+        // a timer with a period of zero is considered always ready
+        next_call_time = now;
+      } else {
+        // move the next call time forward by as many periods as necessary
+        int64_t now_ahead = now - next_call_time;
+        // rounding up without overflow
+        int64_t periods_ahead = 1 + (now_ahead - 1) / period;
+        next_call_time += periods_ahead * period;
+      }
     }
+    rcutils_atomic_store(&timer->impl->next_call_time, next_call_time);
   }
-  rcutils_atomic_store(&timer->impl->next_call_time, next_call_time);
 
   if (typed_callback != NULL) {
     int64_t since_last_call = now - previous_ns;
@@ -284,6 +391,116 @@ rcl_timer_call(rcl_timer_t * timer)
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_timer_call(rcl_timer_t * timer)
+{
+  RCL_TRACEPOINT(rcl_timer_call_entry, timer);
+  rcl_ret_t ret = _rcl_timer_call_impl(timer);
+  if (RCL_RET_OK == ret) {
+    rcl_context_counter_add(
+      timer->impl->context, RCL_CONTEXT_COUNTER_TIMER_CALLS, 1);
+  }
+  RCL_TRACEPOINT(rcl_timer_call_exit, timer);
+  return ret;
+}
+
+// Fire one timer with a caller-provided now, sparing the per-timer clock read.
+static void
+__timer_call_with_now(rcl_timer_t * timer, rcl_time_point_value_t now)
+{
+  rcl_time_point_value_t previous_ns =
+    rcutils_atomic_exchange_int64_t(&timer->impl->last_call_time, now);
+  rcl_timer_callback_t typed_callback =
+    (rcl_timer_callback_t)rcutils_atomic_load_uintptr_t(&timer->impl->callback);
+
+  if (timer->impl->oneshot) {
+    // Same one-shot rule as rcl_timer_call(): fire once, then cancel.
+    rcutils_atomic_store(&timer->impl->canceled, true);
+  } else {
+    int64_t next_call_time = rcutils_atomic_load_int64_t(&timer->impl->next_call_time);
+    int64_t period = rcutils_atomic_load_uint64_t(&timer->impl->period);
+    // Same advancement rules as rcl_timer_call().
+    next_call_time += period;
+    if (next_call_time < now) {
+      if (0 == period) {
+        next_call_time = now;
+      } else {
+        int64_t now_ahead = now - next_call_time;
+        int64_t periods_ahead = 1 + (now_ahead - 1) / period;
+        next_call_time += periods_ahead * period;
+      }
+    }
+    rcutils_atomic_store(&timer->impl->next_call_time, next_call_time);
+  }
+
+  if (typed_callback != NULL) {
+    int64_t since_last_call = now - previous_ns;
+    typed_callback(timer, since_last_call);
+  }
+}
+
+rcl_ret_t
+rcl_timers_call_expired(
+  rcl_timer_t ** timers,
+  size_t number_of_timers,
+  rcl_time_point_value_t now,
+  size_t * number_called)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timers, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(number_called, RCL_RET_INVALID_ARGUMENT);
+  *number_called = 0;
+  if (0 == number_of_timers) {
+    return RCL_RET_OK;
+  }
+  for (size_t i = 0; i < number_of_timers; ++i) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(timers[i], RCL_RET_INVALID_ARGUMENT);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      timers[i]->impl, "timer is invalid", return RCL_RET_TIMER_INVALID);
+  }
+  // One clock read for the whole batch.
+  if (0 == now) {
+    rcl_ret_t now_ret = rcl_clock_get_now(timers[0]->impl->clock, &now);
+    if (now_ret != RCL_RET_OK) {
+      return now_ret;  // rcl error state should already be set.
+    }
+  }
+  if (now < 0) {
+    RCL_SET_ERROR_MSG("clock now returned negative time point value");
+    return RCL_RET_ERROR;
+  }
+  // Select the expired timers, keeping them ordered by deadline so the most
+  // overdue timer fires first.
+  for (size_t i = 0; i < number_of_timers; ++i) {
+    rcl_timer_t * timer = timers[i];
+    if (rcutils_atomic_load_bool(&timer->impl->canceled)) {
+      continue;
+    }
+    const int64_t next_call_time = rcutils_atomic_load_int64_t(&timer->impl->next_call_time);
+    if (next_call_time > now) {
+      continue;
+    }
+    // Swap into the selected prefix, then insertion sort it by deadline; the
+    // array is permuted, never losing the entries which did not fire.
+    timers[i] = timers[*number_called];
+    size_t j = *number_called;
+    while (
+      j > 0 &&
+      rcutils_atomic_load_int64_t(&timers[j - 1]->impl->next_call_time) > next_call_time)
+    {
+      timers[j] = timers[j - 1];
+      --j;
+    }
+    timers[j] = timer;
+    ++(*number_called);
+  }
+  for (size_t i = 0; i < *number_called; ++i) {
+    __timer_call_with_now(timers[i], now);
+    rcl_context_counter_add(
+      timers[i]->impl->context, RCL_CONTEXT_COUNTER_TIMER_CALLS, 1);
+  }
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_timer_is_ready(const rcl_timer_t * timer, bool * is_ready)
 {
@@ -308,6 +525,7 @@ rcl_timer_get_time_until_next_call(const rcl_timer_t * timer, int64_t * time_unt
   if (ret != RCL_RET_OK) {
     return ret;  // rcl error state should already be set.
   }
+  _rcl_timer_observe_override_epoch(timer, now);
   *time_until_next_call =
     rcutils_atomic_load_int64_t(&timer->impl->next_call_time) - now;
   return RCL_RET_OK;
@@ -339,6 +557,35 @@ rcl_timer_get_period(const rcl_timer_t * timer, int64_t * period)
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_timer_get_slack(const rcl_timer_t * timer, int64_t * slack)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(timer->impl, "timer is invalid", return RCL_RET_TIMER_INVALID);
+  RCL_CHECK_ARGUMENT_FOR_NULL(slack, RCL_RET_INVALID_ARGUMENT);
+  *slack = timer->impl->slack;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_timer_set_precision(const rcl_timer_t * timer, bool enabled)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(timer->impl, "timer is invalid", return RCL_RET_TIMER_INVALID);
+  rcutils_atomic_store(&timer->impl->precision, enabled);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_timer_get_precision(const rcl_timer_t * timer, bool * enabled)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(timer->impl, "timer is invalid", return RCL_RET_TIMER_INVALID);
+  RCL_CHECK_ARGUMENT_FOR_NULL(enabled, RCL_RET_INVALID_ARGUMENT);
+  *enabled = rcutils_atomic_load_bool(&timer->impl->precision);
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_timer_exchange_period(const rcl_timer_t * timer, int64_t new_period, int64_t * old_period)
 {
@@ -369,6 +616,23 @@ rcl_timer_exchange_callback(rcl_timer_t * timer, const rcl_timer_callback_t new_
     &timer->impl->callback, (uintptr_t)new_callback);
 }
 
+void *
+rcl_timer_get_user_data(const rcl_timer_t * timer)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(timer->impl, "timer is invalid", return NULL);
+  return (void *)rcutils_atomic_load_uintptr_t(&timer->impl->user_data);
+}
+
+rcl_ret_t
+rcl_timer_set_user_data(rcl_timer_t * timer, void * user_data)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(timer->impl, "timer is invalid", return RCL_RET_TIMER_INVALID);
+  rcutils_atomic_store(&timer->impl->user_data, (uintptr_t)user_data);
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_timer_cancel(rcl_timer_t * timer)
 {
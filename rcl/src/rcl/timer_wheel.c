@@ -0,0 +1,309 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./timer_wheel.h"
+
+#include <stdint.h>
+
+#include "rcl/error_handling.h"
+#include "rcl/time.h"
+
+#include "./context_impl.h"
+
+// Get the wheel, lazily allocating it on first use.
+static rcl_ret_t
+__get_wheel(rcl_context_t * context, rcl_timer_wheel_t ** wheel)
+{
+  if (NULL == context->impl->timer_wheel) {
+    rcl_allocator_t * allocator = &context->impl->allocator;
+    rcl_timer_wheel_t * new_wheel = (rcl_timer_wheel_t *)allocator->zero_allocate(
+      1, sizeof(rcl_timer_wheel_t), allocator->state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      new_wheel, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    new_wheel->allocator = *allocator;
+    rcutils_time_point_value_t now = 0;
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+      allocator->deallocate(new_wheel, allocator->state);
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    new_wheel->current_tick = now / RCL_TIMER_WHEEL_RESOLUTION_NS;
+    context->impl->timer_wheel = new_wheel;
+  }
+  *wheel = context->impl->timer_wheel;
+  return RCL_RET_OK;
+}
+
+// Link a node into the slot its deadline falls into, relative to current_tick.
+static void
+__wheel_insert(rcl_timer_wheel_t * wheel, rcl_timer_wheel_node_t * node)
+{
+  int64_t deadline_tick = node->deadline / RCL_TIMER_WHEEL_RESOLUTION_NS;
+  if (deadline_tick <= wheel->current_tick) {
+    deadline_tick = wheel->current_tick + 1;  // Already due; expire next advance.
+  }
+  int64_t delta = deadline_tick - wheel->current_tick;
+  size_t level = 0;
+  int64_t level_span = RCL_TIMER_WHEEL_SLOTS;
+  while (level + 1 < RCL_TIMER_WHEEL_LEVELS && delta >= level_span) {
+    level_span *= RCL_TIMER_WHEEL_SLOTS;
+    ++level;
+  }
+  const int64_t slot_span = level_span / RCL_TIMER_WHEEL_SLOTS;
+  const size_t slot = (size_t)((deadline_tick / slot_span) % RCL_TIMER_WHEEL_SLOTS);
+  node->next = wheel->slots[level][slot];
+  wheel->slots[level][slot] = node;
+}
+
+// Re-distribute a higher-level slot's nodes into the levels below.
+static void
+__wheel_cascade(rcl_timer_wheel_t * wheel, size_t level, size_t slot)
+{
+  rcl_timer_wheel_node_t * node = wheel->slots[level][slot];
+  wheel->slots[level][slot] = NULL;
+  while (NULL != node) {
+    rcl_timer_wheel_node_t * next = node->next;
+    if (node->active) {
+      __wheel_insert(wheel, node);
+    } else {
+      node->next = wheel->free_nodes;
+      wheel->free_nodes = node;
+    }
+    node = next;
+  }
+}
+
+// Pop every node whose slot has been passed, advancing the wheel to now.
+static rcl_timer_wheel_node_t *
+__wheel_advance(rcl_timer_wheel_t * wheel, int64_t now)
+{
+  rcl_timer_wheel_node_t * expired = NULL;
+  const int64_t target_tick = now / RCL_TIMER_WHEEL_RESOLUTION_NS;
+  while (wheel->current_tick < target_tick) {
+    ++wheel->current_tick;
+    int64_t tick = wheel->current_tick;
+    size_t level = 0;
+    // A tick which wraps a level's span pulls the next level's slot down.
+    while (level < RCL_TIMER_WHEEL_LEVELS && 0 == tick % RCL_TIMER_WHEEL_SLOTS) {
+      tick /= RCL_TIMER_WHEEL_SLOTS;
+      ++level;
+      if (level < RCL_TIMER_WHEEL_LEVELS) {
+        __wheel_cascade(wheel, level, (size_t)(tick % RCL_TIMER_WHEEL_SLOTS));
+      }
+    }
+    const size_t slot = (size_t)(wheel->current_tick % RCL_TIMER_WHEEL_SLOTS);
+    rcl_timer_wheel_node_t * node = wheel->slots[0][slot];
+    wheel->slots[0][slot] = NULL;
+    while (NULL != node) {
+      rcl_timer_wheel_node_t * next = node->next;
+      node->next = expired;
+      expired = node;
+      node = next;
+    }
+  }
+  return expired;
+}
+
+rcl_ret_t
+rcl_timer_wheel_register(
+  rcl_context_t * context,
+  const rcl_timer_t * timer,
+  rcl_timer_wheel_node_t ** node)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node, RCL_RET_INVALID_ARGUMENT);
+  rcl_timer_wheel_t * wheel = NULL;
+  rcl_ret_t ret = __get_wheel(context, &wheel);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  rcl_timer_wheel_node_t * new_node = wheel->free_nodes;
+  if (NULL != new_node) {
+    wheel->free_nodes = new_node->next;
+  } else {
+    new_node = (rcl_timer_wheel_node_t *)wheel->allocator.allocate(
+      sizeof(rcl_timer_wheel_node_t), wheel->allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      new_node, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  }
+  int64_t time_until_next_call = 0;
+  ret = rcl_timer_get_time_until_next_call(timer, &time_until_next_call);
+  if (RCL_RET_OK != ret) {
+    new_node->next = wheel->free_nodes;
+    wheel->free_nodes = new_node;
+    return ret;  // error already set
+  }
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    new_node->next = wheel->free_nodes;
+    wheel->free_nodes = new_node;
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    return RCL_RET_ERROR;
+  }
+  new_node->timer = timer;
+  new_node->deadline =
+    (time_until_next_call > 0) ? now + time_until_next_call : now;
+  new_node->active = true;
+  __wheel_insert(wheel, new_node);
+  *node = new_node;
+  return RCL_RET_OK;
+}
+
+void
+rcl_timer_wheel_unregister(rcl_timer_wheel_node_t * node)
+{
+  if (NULL != node) {
+    // The node stays linked; expiry processing recycles inactive nodes.
+    node->active = false;
+  }
+}
+
+rcl_ret_t
+rcl_timer_wheel_next_deadline(rcl_context_t * context, int64_t * deadline)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl, "context is zero-initialized", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(deadline, RCL_RET_INVALID_ARGUMENT);
+  *deadline = INT64_MAX;
+  rcl_timer_wheel_t * wheel = context->impl->timer_wheel;
+  if (NULL == wheel) {
+    return RCL_RET_OK;  // No timers have registered yet.
+  }
+  for (size_t level = 0; level < RCL_TIMER_WHEEL_LEVELS; ++level) {
+    for (size_t slot = 0; slot < RCL_TIMER_WHEEL_SLOTS; ++slot) {
+      for (
+        rcl_timer_wheel_node_t * node = wheel->slots[level][slot];
+        NULL != node; node = node->next)
+      {
+        if (node->active && node->deadline < *deadline) {
+          *deadline = node->deadline;
+        }
+      }
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_timer_wheel_take_expired(
+  rcl_context_t * context,
+  const rcl_timer_t ** timers,
+  size_t batch_size,
+  size_t * taken)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl, "context is zero-initialized", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(timers, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(taken, RCL_RET_INVALID_ARGUMENT);
+  *taken = 0;
+  rcl_timer_wheel_t * wheel = context->impl->timer_wheel;
+  if (NULL == wheel) {
+    return RCL_RET_OK;  // No timers have registered yet.
+  }
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    return RCL_RET_ERROR;
+  }
+  rcl_timer_wheel_node_t * node = __wheel_advance(wheel, now);
+  while (NULL != node) {
+    rcl_timer_wheel_node_t * next = node->next;
+    if (!node->active) {
+      node->next = wheel->free_nodes;
+      wheel->free_nodes = node;
+      node = next;
+      continue;
+    }
+    // Deadlines are approximations; verify against the timer's real state.
+    bool is_ready = false;
+    bool is_canceled = false;
+    rcl_ret_t ret = rcl_timer_is_ready(node->timer, &is_ready);
+    if (RCL_RET_OK == ret) {
+      ret = rcl_timer_is_canceled(node->timer, &is_canceled);
+    }
+    if (RCL_RET_OK != ret) {
+      // Treat an unqueryable timer like an unregistered one.
+      node->next = wheel->free_nodes;
+      wheel->free_nodes = node;
+      node = next;
+      continue;
+    }
+    if (is_ready && *taken < batch_size) {
+      timers[(*taken)++] = node->timer;
+      // Re-arm one period out; verified again when that slot expires.
+      int64_t period = 0;
+      if (RCL_RET_OK == rcl_timer_get_period(node->timer, &period)) {
+        node->deadline = now + period;
+      } else {
+        node->deadline = now + RCL_TIMER_WHEEL_RECHECK_NS;
+      }
+    } else if (is_canceled) {
+      // Parked; re-checked periodically in case the timer is reset.
+      node->deadline = now + RCL_TIMER_WHEEL_RECHECK_NS;
+    } else {
+      // Stale deadline (ready but batch full, or rescheduled); use the real one.
+      int64_t time_until_next_call = 0;
+      if (RCL_RET_OK == rcl_timer_get_time_until_next_call(
+          node->timer, &time_until_next_call) && time_until_next_call > 0)
+      {
+        node->deadline = now + time_until_next_call;
+      } else {
+        node->deadline = now;  // Due again on the next advance.
+      }
+    }
+    __wheel_insert(wheel, node);
+    node = next;
+  }
+  return RCL_RET_OK;
+}
+
+void
+rcl_timer_wheel_fini(rcl_context_t * context)
+{
+  rcl_timer_wheel_t * wheel = context->impl->timer_wheel;
+  if (NULL == wheel) {
+    return;
+  }
+  rcl_allocator_t allocator = wheel->allocator;
+  for (size_t level = 0; level < RCL_TIMER_WHEEL_LEVELS; ++level) {
+    for (size_t slot = 0; slot < RCL_TIMER_WHEEL_SLOTS; ++slot) {
+      rcl_timer_wheel_node_t * node = wheel->slots[level][slot];
+      while (NULL != node) {
+        rcl_timer_wheel_node_t * next = node->next;
+        allocator.deallocate(node, allocator.state);
+        node = next;
+      }
+    }
+  }
+  rcl_timer_wheel_node_t * node = wheel->free_nodes;
+  while (NULL != node) {
+    rcl_timer_wheel_node_t * next = node->next;
+    allocator.deallocate(node, allocator.state);
+    node = next;
+  }
+  allocator.deallocate(wheel, allocator.state);
+  context->impl->timer_wheel = NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,92 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__TIMER_WHEEL_H_
+#define RCL__TIMER_WHEEL_H_
+
+#include <stdbool.h>
+
+#include "rcl/context.h"
+#include "rcl/timer.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Tick resolution of the wheel, in nanoseconds.
+#define RCL_TIMER_WHEEL_RESOLUTION_NS 1000000
+/// Number of wheel levels; each level covers 64x the span of the one below.
+#define RCL_TIMER_WHEEL_LEVELS 4
+/// Number of slots per level.
+#define RCL_TIMER_WHEEL_SLOTS 64
+/// How long a canceled timer is parked before its state is re-checked, in ns.
+#define RCL_TIMER_WHEEL_RECHECK_NS 1000000000ll
+
+/// \internal A single registered timer, linked into a wheel slot.
+typedef struct rcl_timer_wheel_node_t
+{
+  const rcl_timer_t * timer;
+  /// Deadline normalized to steady time; verified against the timer on expiry.
+  int64_t deadline;
+  /// False once the timer has been finalized; the node is then recycled.
+  bool active;
+  struct rcl_timer_wheel_node_t * next;
+} rcl_timer_wheel_node_t;
+
+/// \internal Hierarchical timer wheel shared by all timers of a context.
+/**
+ * Deadlines are stored as steady-time approximations, computed from each
+ * timer's own clock delta at insertion time; expiring nodes are verified
+ * against the timer's real state and re-inserted when stale, so clock
+ * overrides and resets are handled lazily instead of eagerly rebalancing.
+ *
+ * The wheel is not thread-safe; like wait sets, it is expected to be driven
+ * from a single executor thread.
+ */
+typedef struct rcl_timer_wheel_t
+{
+  rcl_timer_wheel_node_t * slots[RCL_TIMER_WHEEL_LEVELS][RCL_TIMER_WHEEL_SLOTS];
+  /// Recycled nodes, reused before allocating new ones.
+  rcl_timer_wheel_node_t * free_nodes;
+  /// Steady time divided by the resolution, advanced by expiry processing.
+  int64_t current_tick;
+  rcl_allocator_t allocator;
+} rcl_timer_wheel_t;
+
+/// \internal Register a timer, creating the context's wheel on first use.
+RCL_LOCAL
+rcl_ret_t
+rcl_timer_wheel_register(
+  rcl_context_t * context,
+  const rcl_timer_t * timer,
+  rcl_timer_wheel_node_t ** node);
+
+/// \internal Mark a timer's node inactive so expiry processing recycles it.
+RCL_LOCAL
+void
+rcl_timer_wheel_unregister(rcl_timer_wheel_node_t * node);
+
+/// \internal Release all wheel memory; called while cleaning up the context.
+RCL_LOCAL
+void
+rcl_timer_wheel_fini(rcl_context_t * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__TIMER_WHEEL_H_
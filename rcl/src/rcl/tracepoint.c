@@ -0,0 +1,66 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/tracepoint.h"
+
+#include <stdint.h>
+
+#include "rcutils/error_handling.h"
+#include "rcutils/stdatomic_helper.h"
+
+// Registered callback, stored as a uintptr_t so it can be swapped atomically.
+static atomic_uintptr_t __tracepoint_callback = ATOMIC_VAR_INIT(0);
+
+rcl_ret_t
+rcl_tracepoint_set_callback(rcl_tracepoint_callback_t callback)
+{
+  rcutils_atomic_store(&__tracepoint_callback, (uintptr_t)callback);
+  return RCL_RET_OK;
+}
+
+bool
+rcl_tracepoint_is_compiled_in(void)
+{
+#ifdef RCL_ENABLE_TRACEPOINTS
+  return true;
+#else
+  return false;
+#endif
+}
+
+void
+rcl_tracepoint_fire(const char * name, const void * entity)
+{
+  uintptr_t callback_as_int;
+  rcutils_atomic_load(&__tracepoint_callback, callback_as_int);
+  if (0 == callback_as_int) {
+    return;
+  }
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    // still fire the tracepoint, with a zero timestamp
+    rcutils_reset_error();
+    now = 0;
+  }
+  ((rcl_tracepoint_callback_t)callback_as_int)(name, entity, now);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -24,15 +24,29 @@ extern "C"
 #include <stdbool.h>
 #include <string.h>
 
+#ifndef _WIN32
+#include <errno.h>
+#include <poll.h>
+#endif
+
 #include "rcl/error_handling.h"
 #include "rcl/time.h"
+#include "rcl/tracepoint.h"
 #include "rcutils/logging_macros.h"
+#include "rcutils/stdatomic_helper.h"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
 #include "rmw/event.h"
 
 #include "./context_impl.h"
 
+// Seed and bounds for the precision-timer spin delta, in nanoseconds; the
+// delta trails the wake latency the blocking wait actually exhibits,
+// see rcl_timer_set_precision().
+#define RCL_WAIT_PRECISION_SPIN_DELTA_INITIAL (250 * 1000)
+#define RCL_WAIT_PRECISION_SPIN_DELTA_MIN (1 * 1000)
+#define RCL_WAIT_PRECISION_SPIN_DELTA_MAX (2 * 1000 * 1000)
+
 typedef struct rcl_wait_set_impl_t
 {
   // number of subscriptions that have been added to the wait set
@@ -58,8 +72,353 @@ typedef struct rcl_wait_set_impl_t
   rcl_context_t * context;
   // allocator used in the wait set
   rcl_allocator_t allocator;
+
+  // true if entities stay attached across calls to rcl_wait_set_clear(),
+  // see rcl_wait_set_set_persistent()
+  bool persistent;
+  // single allocation backing the shadow arrays below, NULL when not persistent
+  void ** shadow_block;
+  // shadow copies of the entity arrays, used to re-arm a persistent wait set
+  const void ** subscription_shadow;
+  const void ** guard_condition_shadow;
+  const void ** timer_shadow;
+  const void ** client_shadow;
+  const void ** service_shadow;
+  const void ** event_shadow;
+  void ** rmw_subscription_shadow;
+  // covers both the guard condition slots and the trailing timer slots
+  void ** rmw_guard_condition_shadow;
+  void ** rmw_client_shadow;
+  void ** rmw_service_shadow;
+  void ** rmw_event_shadow;
+
+  // single allocation backing all of the entity arrays, the rmw storage
+  // arrays, and the timer heap, carved up by rcl_wait_set_resize()
+  void * entity_block;
+  // binary min-heap of timer indices ordered by deadline, so the effective
+  // rmw_wait timeout can be computed without scanning every timer
+  size_t * timer_heap;
+  size_t timer_heap_size;
+  // deadline per timer slot, in steady time nanoseconds, captured when the
+  // timer was added and refreshed lazily when it reaches the heap top
+  int64_t * timer_deadlines;
+
+  // compact lists of the indices found ready by the last rcl_wait(), so
+  // dispatch can scale with the number of ready entities instead of the
+  // set capacity, see rcl_wait_set_get_ready_entities()
+  size_t * ready_indices[RCL_WAIT_SET_ENTITY_TYPES];
+  size_t ready_counts[RCL_WAIT_SET_ENTITY_TYPES];
+  // priority class per entity slot, see rcl_wait_set_set_entity_priority();
+  // the ready lists above are reordered so higher classes come first
+  uint8_t * priorities[RCL_WAIT_SET_ENTITY_TYPES];
+  // true while any slot of the type holds a non-default priority, so the
+  // common all-default case skips the reorder entirely
+  bool has_priorities[RCL_WAIT_SET_ENTITY_TYPES];
+
+  // optional callback invoked by rcl_wait() for each ready entity, see
+  // rcl_wait_set_set_on_ready_callback()
+  rcl_wait_set_on_ready_callback_t on_ready_callback;
+  void * on_ready_user_data;
+
+  // opt-in per-cycle statistics, see rcl_wait_set_enable_stats()
+  bool stats_enabled;
+  rcl_wait_set_stats_t stats;
+
+  // how long rcl_wait() probes readiness without blocking before falling
+  // into the blocking rmw wait, 0 disables the spin phase,
+  // see rcl_wait_set_set_spin_duration()
+  int64_t spin_duration;
+
+  // calibrated gap between the shortened blocking wait and a precision
+  // timer's deadline, in nanoseconds, see rcl_timer_set_precision()
+  int64_t precision_spin_delta;
+
+  // file descriptors attached with rcl_wait_set_add_fd(), polled alongside
+  // the middleware wait; the storage grows on demand
+  rcl_wait_set_fd_t * fds;
+  size_t fd_index;
+  size_t fd_capacity;
+  // upper bound on one blocking rmw_wait while fds are attached, so fd
+  // readiness is noticed without middleware support for fd conditions
+  int64_t fd_poll_period;
+#ifndef _WIN32
+  // scratch poll() structures, grown together with the fd storage
+  struct pollfd * fd_scratch;
+#endif
 } rcl_wait_set_impl_t;
 
+static void
+__timer_heap_sift_up(rcl_wait_set_impl_t * impl, size_t hole)
+{
+  const size_t timer_index = impl->timer_heap[hole];
+  const int64_t deadline = impl->timer_deadlines[timer_index];
+  while (hole > 0) {
+    const size_t parent = (hole - 1) / 2;
+    if (impl->timer_deadlines[impl->timer_heap[parent]] <= deadline) {
+      break;
+    }
+    impl->timer_heap[hole] = impl->timer_heap[parent];
+    hole = parent;
+  }
+  impl->timer_heap[hole] = timer_index;
+}
+
+static void
+__timer_heap_sift_down(rcl_wait_set_impl_t * impl, size_t hole)
+{
+  const size_t timer_index = impl->timer_heap[hole];
+  const int64_t deadline = impl->timer_deadlines[timer_index];
+  while (true) {
+    size_t child = (2 * hole) + 1;
+    if (child >= impl->timer_heap_size) {
+      break;
+    }
+    if (
+      child + 1 < impl->timer_heap_size &&
+      impl->timer_deadlines[impl->timer_heap[child + 1]] <
+      impl->timer_deadlines[impl->timer_heap[child]])
+    {
+      ++child;
+    }
+    if (deadline <= impl->timer_deadlines[impl->timer_heap[child]]) {
+      break;
+    }
+    impl->timer_heap[hole] = impl->timer_heap[child];
+    hole = child;
+  }
+  impl->timer_heap[hole] = timer_index;
+}
+
+static void
+__timer_heap_push(rcl_wait_set_impl_t * impl, size_t timer_index, int64_t deadline)
+{
+  impl->timer_deadlines[timer_index] = deadline;
+  impl->timer_heap[impl->timer_heap_size++] = timer_index;
+  __timer_heap_sift_up(impl, impl->timer_heap_size - 1);
+}
+
+static void
+__timer_heap_pop(rcl_wait_set_impl_t * impl)
+{
+  impl->timer_heap[0] = impl->timer_heap[--impl->timer_heap_size];
+  if (impl->timer_heap_size > 0) {
+    __timer_heap_sift_down(impl, 0);
+  }
+}
+
+// Reorder a ready list so higher priority classes dispatch first.  The
+// insertion sort is stable, so the existing order — slot order, or most
+// overdue first for timers — is kept within a class.
+static void
+__wait_set_sort_ready_by_priority(rcl_wait_set_impl_t * impl, size_t type)
+{
+  const uint8_t * priorities = impl->priorities[type];
+  size_t * ready_indices = impl->ready_indices[type];
+  const size_t count = impl->ready_counts[type];
+  size_t i;
+  for (i = 1; i < count; ++i) {
+    const size_t index = ready_indices[i];
+    const uint8_t priority = priorities[index];
+    size_t pos = i;
+    while (pos > 0 && priorities[ready_indices[pos - 1]] < priority) {
+      ready_indices[pos] = ready_indices[pos - 1];
+      --pos;
+    }
+    ready_indices[pos] = index;
+  }
+}
+
+// Capture the timer's deadline and push it onto the heap used by rcl_wait()
+// to compute the effective timeout.
+static rcl_ret_t
+__wait_set_push_timer_deadline(
+  rcl_wait_set_t * wait_set, const rcl_timer_t * timer, size_t current_index)
+{
+  int64_t time_until_next_call = INT64_MAX;
+  rcl_ret_t ret = rcl_timer_get_time_until_next_call(timer, &time_until_next_call);
+  if (RCL_RET_OK != ret) {
+    return ret;  // The rcl error state should already be set.
+  }
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    return RCL_RET_ERROR;
+  }
+  const int64_t deadline =
+    time_until_next_call > INT64_MAX - now ? INT64_MAX : now + time_until_next_call;
+  __timer_heap_push(wait_set->impl, current_index, deadline);
+  return RCL_RET_OK;
+}
+
+static void
+__wait_set_free_shadow(rcl_wait_set_t * wait_set)
+{
+  rcl_wait_set_impl_t * impl = wait_set->impl;
+  if (impl->shadow_block) {
+    impl->allocator.deallocate(impl->shadow_block, impl->allocator.state);
+  }
+  impl->shadow_block = NULL;
+  impl->subscription_shadow = NULL;
+  impl->guard_condition_shadow = NULL;
+  impl->timer_shadow = NULL;
+  impl->client_shadow = NULL;
+  impl->service_shadow = NULL;
+  impl->event_shadow = NULL;
+  impl->rmw_subscription_shadow = NULL;
+  impl->rmw_guard_condition_shadow = NULL;
+  impl->rmw_client_shadow = NULL;
+  impl->rmw_service_shadow = NULL;
+  impl->rmw_event_shadow = NULL;
+}
+
+static rcl_ret_t
+__wait_set_allocate_shadow(rcl_wait_set_t * wait_set)
+{
+  rcl_wait_set_impl_t * impl = wait_set->impl;
+  const size_t rcl_slots =
+    wait_set->size_of_subscriptions + wait_set->size_of_guard_conditions +
+    wait_set->size_of_timers + wait_set->size_of_clients +
+    wait_set->size_of_services + wait_set->size_of_events;
+  // The rmw side has no timer array, but its guard condition array holds one
+  // extra slot per timer, so the totals match.
+  const size_t rmw_slots = rcl_slots;
+  if (0 == rcl_slots) {
+    return RCL_RET_OK;
+  }
+  void ** block = (void **)impl->allocator.allocate(
+    sizeof(void *) * (rcl_slots + rmw_slots), impl->allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(block, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  memset(block, 0, sizeof(void *) * (rcl_slots + rmw_slots));
+  impl->shadow_block = block;
+  impl->subscription_shadow = (const void **)block;
+  block += wait_set->size_of_subscriptions;
+  impl->guard_condition_shadow = (const void **)block;
+  block += wait_set->size_of_guard_conditions;
+  impl->timer_shadow = (const void **)block;
+  block += wait_set->size_of_timers;
+  impl->client_shadow = (const void **)block;
+  block += wait_set->size_of_clients;
+  impl->service_shadow = (const void **)block;
+  block += wait_set->size_of_services;
+  impl->event_shadow = (const void **)block;
+  block += wait_set->size_of_events;
+  impl->rmw_subscription_shadow = block;
+  block += wait_set->size_of_subscriptions;
+  impl->rmw_guard_condition_shadow = block;
+  block += wait_set->size_of_guard_conditions + wait_set->size_of_timers;
+  impl->rmw_client_shadow = block;
+  block += wait_set->size_of_clients;
+  impl->rmw_service_shadow = block;
+  block += wait_set->size_of_services;
+  impl->rmw_event_shadow = block;
+  return RCL_RET_OK;
+}
+
+#define SHADOW_COPY(Dest, Source, Size) \
+  if (NULL != (Source) && NULL != (Dest)) { \
+    memcpy((void *)(Dest), (const void *)(Source), sizeof(void *) * (Size)); \
+  }
+
+// Copy the currently attached entities into the shadow arrays.
+static void
+__wait_set_snapshot_shadow(rcl_wait_set_t * wait_set)
+{
+  rcl_wait_set_impl_t * impl = wait_set->impl;
+  if (NULL == impl->shadow_block) {
+    return;
+  }
+  SHADOW_COPY(
+    impl->subscription_shadow, wait_set->subscriptions,
+    wait_set->size_of_subscriptions)
+  SHADOW_COPY(
+    impl->guard_condition_shadow, wait_set->guard_conditions,
+    wait_set->size_of_guard_conditions)
+  SHADOW_COPY(
+    impl->timer_shadow, wait_set->timers, wait_set->size_of_timers)
+  SHADOW_COPY(
+    impl->client_shadow, wait_set->clients, wait_set->size_of_clients)
+  SHADOW_COPY(
+    impl->service_shadow, wait_set->services, wait_set->size_of_services)
+  SHADOW_COPY(
+    impl->event_shadow, wait_set->events, wait_set->size_of_events)
+  SHADOW_COPY(
+    impl->rmw_subscription_shadow, impl->rmw_subscriptions.subscribers,
+    wait_set->size_of_subscriptions)
+  SHADOW_COPY(
+    impl->rmw_guard_condition_shadow,
+    impl->rmw_guard_conditions.guard_conditions,
+    wait_set->size_of_guard_conditions + wait_set->size_of_timers)
+  SHADOW_COPY(
+    impl->rmw_client_shadow, impl->rmw_clients.clients, wait_set->size_of_clients)
+  SHADOW_COPY(
+    impl->rmw_service_shadow, impl->rmw_services.services, wait_set->size_of_services)
+  SHADOW_COPY(
+    impl->rmw_event_shadow, impl->rmw_events.events, wait_set->size_of_events)
+}
+
+// Restore the shadow arrays into the live arrays and reset the rmw counts,
+// undoing the pruning done by rcl_wait() without touching the attachments.
+static rcl_ret_t
+__wait_set_rearm(rcl_wait_set_t * wait_set)
+{
+  rcl_wait_set_impl_t * impl = wait_set->impl;
+  if (NULL == impl->shadow_block) {
+    return RCL_RET_OK;
+  }
+  SHADOW_COPY(
+    wait_set->subscriptions, impl->subscription_shadow,
+    wait_set->size_of_subscriptions)
+  SHADOW_COPY(
+    wait_set->guard_conditions, impl->guard_condition_shadow,
+    wait_set->size_of_guard_conditions)
+  SHADOW_COPY(
+    wait_set->timers, impl->timer_shadow, wait_set->size_of_timers)
+  SHADOW_COPY(
+    wait_set->clients, impl->client_shadow, wait_set->size_of_clients)
+  SHADOW_COPY(
+    wait_set->services, impl->service_shadow, wait_set->size_of_services)
+  SHADOW_COPY(
+    wait_set->events, impl->event_shadow, wait_set->size_of_events)
+  SHADOW_COPY(
+    impl->rmw_subscriptions.subscribers, impl->rmw_subscription_shadow,
+    wait_set->size_of_subscriptions)
+  SHADOW_COPY(
+    impl->rmw_guard_conditions.guard_conditions,
+    impl->rmw_guard_condition_shadow,
+    wait_set->size_of_guard_conditions + wait_set->size_of_timers)
+  SHADOW_COPY(
+    impl->rmw_clients.clients, impl->rmw_client_shadow, wait_set->size_of_clients)
+  SHADOW_COPY(
+    impl->rmw_services.services, impl->rmw_service_shadow, wait_set->size_of_services)
+  SHADOW_COPY(
+    impl->rmw_events.events, impl->rmw_event_shadow, wait_set->size_of_events)
+  impl->rmw_subscriptions.subscriber_count = impl->subscription_index;
+  impl->rmw_guard_conditions.guard_condition_count = impl->guard_condition_index;
+  impl->rmw_clients.client_count = impl->client_index;
+  impl->rmw_services.service_count = impl->service_index;
+  impl->rmw_events.event_count = impl->event_index;
+  if (impl->timer_heap_size != impl->timer_index) {
+    // rcl_wait() pops the heap entries of canceled timers; with the timer
+    // pointers restored the heap has to cover every timer again, or one that
+    // is canceled and later reset would never drive the timeout.  The keys
+    // never overshoot: next_call_time is monotone under reset, so a captured
+    // deadline can only be stale-early, which the lazy refresh in rcl_wait()
+    // corrects once the entry reaches the top.
+    impl->timer_heap_size = 0;
+    size_t i;
+    for (i = 0; i < impl->timer_index; ++i) {
+      if (NULL == wait_set->timers[i]) {
+        continue;
+      }
+      rcl_ret_t ret = __wait_set_push_timer_deadline(wait_set, wait_set->timers[i], i);
+      if (RCL_RET_OK != ret) {
+        return ret;  // error already set
+      }
+    }
+  }
+  return RCL_RET_OK;
+}
+
 rcl_wait_set_t
 rcl_get_zero_initialized_wait_set()
 {
@@ -92,6 +451,14 @@ __wait_set_clean_up(rcl_wait_set_t * wait_set, rcl_allocator_t allocator)
   (void)ret;  // NO LINT
   assert(RCL_RET_OK == ret);  // Defensive, shouldn't fail with size 0.
   if (wait_set->impl) {
+    if (wait_set->impl->fds) {
+      allocator.deallocate(wait_set->impl->fds, allocator.state);
+    }
+#ifndef _WIN32
+    if (wait_set->impl->fd_scratch) {
+      allocator.deallocate(wait_set->impl->fd_scratch, allocator.state);
+    }
+#endif
     allocator.deallocate(wait_set->impl, allocator.state);
     wait_set->impl = NULL;
   }
@@ -136,6 +503,8 @@ rcl_wait_set_init(
   RCL_CHECK_FOR_NULL_WITH_MSG(
     wait_set->impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
   memset(wait_set->impl, 0, sizeof(rcl_wait_set_impl_t));
+  wait_set->impl->fd_poll_period = RCL_MS_TO_NS(1);
+  wait_set->impl->precision_spin_delta = RCL_WAIT_PRECISION_SPIN_DELTA_INITIAL;
   wait_set->impl->rmw_subscriptions.subscribers = NULL;
   wait_set->impl->rmw_subscriptions.subscriber_count = 0;
   wait_set->impl->rmw_guard_conditions.guard_conditions = NULL;
@@ -226,6 +595,10 @@ rcl_wait_set_get_allocator(const rcl_wait_set_t * wait_set, rcl_allocator_t * al
   } \
   size_t current_index = wait_set->impl->Type ## _index++; \
   wait_set->Type ## s[current_index] = Type; \
+  /* Keep the persistent registration, if any, in sync. */ \
+  if (NULL != wait_set->impl->Type ## _shadow) { \
+    wait_set->impl->Type ## _shadow[current_index] = (const void *)Type; \
+  } \
   /* Set optional output argument */ \
   if (NULL != index) { \
     *index = current_index; \
@@ -237,15 +610,23 @@ rcl_wait_set_get_allocator(const rcl_wait_set_t * wait_set, rcl_allocator_t * al
   RCL_CHECK_FOR_NULL_WITH_MSG( \
     rmw_handle, rcl_get_error_string().str, return RCL_RET_ERROR); \
   wait_set->impl->RMWStorage[current_index] = rmw_handle->data; \
+  if (NULL != wait_set->impl->rmw_ ## Type ## _shadow) { \
+    wait_set->impl->rmw_ ## Type ## _shadow[current_index] = rmw_handle->data; \
+  } \
   wait_set->impl->RMWCount++;
 
+/* Only the occupied prefix has to be cleared: slots at or past the add index
+ * were set to null by the previous clear (or by the initial resize) and are
+ * never written in between, so the full-capacity memset would just rewrite
+ * nulls and evict useful cache lines on large, sparsely used sets.
+ */
 #define SET_CLEAR(Type) \
   do { \
     if (NULL != wait_set->Type ## s) { \
       memset( \
         (void *)wait_set->Type ## s, \
         0, \
-        sizeof(rcl_ ## Type ## _t *) * wait_set->size_of_ ## Type ## s); \
+        sizeof(rcl_ ## Type ## _t *) * wait_set->impl->Type ## _index); \
       wait_set->impl->Type ## _index = 0; \
     } \
   } while (false)
@@ -262,50 +643,6 @@ rcl_wait_set_get_allocator(const rcl_wait_set_t * wait_set, rcl_allocator_t * al
     } \
   } while (false)
 
-#define SET_RESIZE(Type, ExtraDealloc, ExtraRealloc) \
-  do { \
-    rcl_allocator_t allocator = wait_set->impl->allocator; \
-    wait_set->size_of_ ## Type ## s = 0; \
-    wait_set->impl->Type ## _index = 0; \
-    if (0 == Type ## s_size) { \
-      if (wait_set->Type ## s) { \
-        allocator.deallocate((void *)wait_set->Type ## s, allocator.state); \
-        wait_set->Type ## s = NULL; \
-      } \
-      ExtraDealloc \
-    } else { \
-      wait_set->Type ## s = (const rcl_ ## Type ## _t **)allocator.reallocate( \
-        (void *)wait_set->Type ## s, sizeof(rcl_ ## Type ## _t *) * Type ## s_size, \
-        allocator.state); \
-      RCL_CHECK_FOR_NULL_WITH_MSG( \
-        wait_set->Type ## s, "allocating memory failed", return RCL_RET_BAD_ALLOC); \
-      memset((void *)wait_set->Type ## s, 0, sizeof(rcl_ ## Type ## _t *) * Type ## s_size); \
-      wait_set->size_of_ ## Type ## s = Type ## s_size; \
-      ExtraRealloc \
-    } \
-  } while (false)
-
-#define SET_RESIZE_RMW_DEALLOC(RMWStorage, RMWCount) \
-  /* Also deallocate the rmw storage. */ \
-  if (wait_set->impl->RMWStorage) { \
-    allocator.deallocate((void *)wait_set->impl->RMWStorage, allocator.state); \
-    wait_set->impl->RMWStorage = NULL; \
-    wait_set->impl->RMWCount = 0; \
-  }
-
-#define SET_RESIZE_RMW_REALLOC(Type, RMWStorage, RMWCount) \
-  /* Also resize the rmw storage. */ \
-  wait_set->impl->RMWCount = 0; \
-  wait_set->impl->RMWStorage = (void **)allocator.reallocate( \
-    wait_set->impl->RMWStorage, sizeof(void *) * Type ## s_size, allocator.state); \
-  if (!wait_set->impl->RMWStorage) { \
-    allocator.deallocate((void *)wait_set->Type ## s, allocator.state); \
-    wait_set->size_of_ ## Type ## s = 0; \
-    RCL_SET_ERROR_MSG("allocating memory failed"); \
-    return RCL_RET_BAD_ALLOC; \
-  } \
-  memset(wait_set->impl->RMWStorage, 0, sizeof(void *) * Type ## s_size);
-
 /* Implementation-specific notes:
  *
  * Add the rmw representation to the underlying rmw array and increment
@@ -333,12 +670,45 @@ rcl_wait_set_clear(rcl_wait_set_t * wait_set)
   RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(wait_set->impl, RCL_RET_WAIT_SET_INVALID);
 
+  {
+    // The ready lists describe the previous wait, reset them.
+    size_t type = 0;
+    for (type = 0; type < RCL_WAIT_SET_ENTITY_TYPES; ++type) {
+      wait_set->impl->ready_counts[type] = 0;
+    }
+  }
+
+  if (wait_set->impl->persistent) {
+    // Entities stay attached; just restore what rcl_wait() pruned.
+    return __wait_set_rearm(wait_set);
+  }
+
+  // Priorities belong to the attachments, forget them along with the
+  // entities; like SET_CLEAR only the occupied prefix has to be cleared.
+  {
+    rcl_wait_set_impl_t * impl = wait_set->impl;
+    const size_t used[RCL_WAIT_SET_ENTITY_TYPES] = {
+      impl->subscription_index, impl->guard_condition_index, impl->timer_index,
+      impl->client_index, impl->service_index, impl->event_index};
+    size_t type = 0;
+    for (type = 0; type < RCL_WAIT_SET_ENTITY_TYPES; ++type) {
+      if (NULL != impl->priorities[type] && 0 != used[type]) {
+        memset(impl->priorities[type], 0, used[type]);
+      }
+      impl->has_priorities[type] = false;
+    }
+  }
+
   SET_CLEAR(subscription);
   SET_CLEAR(guard_condition);
   SET_CLEAR(client);
   SET_CLEAR(service);
   SET_CLEAR(event);
   SET_CLEAR(timer);
+  wait_set->impl->timer_heap_size = 0;
+  // Attached file descriptors are dropped like the entities; the storage is
+  // kept for reuse.
+  wait_set->impl->fd_index = 0;
 
   SET_CLEAR_RMW(
     subscription,
@@ -366,8 +736,10 @@ rcl_wait_set_clear(rcl_wait_set_t * wait_set)
 
 /* Implementation-specific notes:
  *
- * Similarly, the underlying rmw representation is reallocated and reset:
- * all entries are set to null and the count is set to zero.
+ * All of the entity arrays, the underlying rmw storage arrays, and the timer
+ * heap are carved out of one contiguous allocation sized from the totals.
+ * Everything is reset: all entries are set to null and the counts are set to
+ * zero.
  */
 rcl_ret_t
 rcl_wait_set_resize(
@@ -381,66 +753,491 @@ rcl_wait_set_resize(
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(wait_set->impl, RCL_RET_WAIT_SET_INVALID);
-  SET_RESIZE(
-    subscription,
-    SET_RESIZE_RMW_DEALLOC(
-      rmw_subscriptions.subscribers, rmw_subscriptions.subscriber_count),
-    SET_RESIZE_RMW_REALLOC(
-      subscription, rmw_subscriptions.subscribers, rmw_subscriptions.subscriber_count)
-  );
-  // Guard condition RCL size is the resize amount given
-  SET_RESIZE(guard_condition,;,;);  // NOLINT
-
-  // Guard condition RMW size needs to be guard conditions + timers
-  rmw_guard_conditions_t * rmw_gcs = &(wait_set->impl->rmw_guard_conditions);
-  const size_t num_rmw_gc = guard_conditions_size + timers_size;
-  // Clear added guard conditions
-  rmw_gcs->guard_condition_count = 0u;
-  if (0u == num_rmw_gc) {
-    if (rmw_gcs->guard_conditions) {
-      wait_set->impl->allocator.deallocate(
-        (void *)rmw_gcs->guard_conditions, wait_set->impl->allocator.state);
-      rmw_gcs->guard_conditions = NULL;
+  // Resizing invalidates any persistent registration; entities have to be
+  // re-added by the caller afterwards.
+  __wait_set_free_shadow(wait_set);
+
+  rcl_wait_set_impl_t * impl = wait_set->impl;
+  rcl_allocator_t allocator = impl->allocator;
+
+  const size_t num_rcl_slots =
+    subscriptions_size + guard_conditions_size + timers_size +
+    clients_size + services_size + events_size;
+  // The rmw side has no timer array, but its guard condition array holds one
+  // extra slot per timer, so the totals match.
+  const size_t num_rmw_slots = num_rcl_slots;
+  // Deadline and heap storage for the timers, plus one ready-index slot and
+  // one priority byte per entity, see rcl_wait().
+  const size_t block_size =
+    sizeof(int64_t) * timers_size +
+    sizeof(void *) * (num_rcl_slots + num_rmw_slots) +
+    sizeof(size_t) * (timers_size + num_rcl_slots) +
+    sizeof(uint8_t) * num_rcl_slots;
+
+  // Reset all of the sets and counts; the arrays are carved out below.
+  wait_set->subscriptions = NULL;
+  wait_set->size_of_subscriptions = 0;
+  wait_set->guard_conditions = NULL;
+  wait_set->size_of_guard_conditions = 0;
+  wait_set->timers = NULL;
+  wait_set->size_of_timers = 0;
+  wait_set->clients = NULL;
+  wait_set->size_of_clients = 0;
+  wait_set->services = NULL;
+  wait_set->size_of_services = 0;
+  wait_set->events = NULL;
+  wait_set->size_of_events = 0;
+  impl->subscription_index = 0;
+  impl->guard_condition_index = 0;
+  impl->timer_index = 0;
+  impl->client_index = 0;
+  impl->service_index = 0;
+  impl->event_index = 0;
+  impl->rmw_subscriptions.subscribers = NULL;
+  impl->rmw_subscriptions.subscriber_count = 0;
+  impl->rmw_guard_conditions.guard_conditions = NULL;
+  impl->rmw_guard_conditions.guard_condition_count = 0;
+  impl->rmw_clients.clients = NULL;
+  impl->rmw_clients.client_count = 0;
+  impl->rmw_services.services = NULL;
+  impl->rmw_services.service_count = 0;
+  impl->rmw_events.events = NULL;
+  impl->rmw_events.event_count = 0;
+  impl->timer_deadlines = NULL;
+  impl->timer_heap = NULL;
+  impl->timer_heap_size = 0;
+  {
+    size_t type = 0;
+    for (type = 0; type < RCL_WAIT_SET_ENTITY_TYPES; ++type) {
+      impl->ready_indices[type] = NULL;
+      impl->ready_counts[type] = 0;
+      impl->priorities[type] = NULL;
+      impl->has_priorities[type] = false;
+    }
+  }
+
+  if (0 == block_size) {
+    if (impl->entity_block) {
+      allocator.deallocate(impl->entity_block, allocator.state);
+      impl->entity_block = NULL;
+    }
+    return RCL_RET_OK;
+  }
+
+  // Carve every array out of one contiguous block, improving cache locality
+  // when rcl_wait() scans them and issuing a single allocator call instead of
+  // one per entity type.
+  uint8_t * block = (uint8_t *)allocator.reallocate(
+    impl->entity_block, block_size, allocator.state);
+  // On failure the old block stays owned by entity_block and is released by
+  // the next successful resize or by rcl_wait_set_fini().
+  RCL_CHECK_FOR_NULL_WITH_MSG(block, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  impl->entity_block = block;
+  memset(block, 0, block_size);
+
+#define WAIT_SET_CARVE(Dest, CastType, Count) \
+  Dest = (0 != (Count)) ? (CastType)(void *)block : NULL; \
+  block += sizeof(void *) * (Count);
+
+  // The timer deadlines come first since int64_t has the strictest alignment.
+  impl->timer_deadlines = (0 != timers_size) ? (int64_t *)(void *)block : NULL;
+  block += sizeof(int64_t) * timers_size;
+  WAIT_SET_CARVE(wait_set->subscriptions, const rcl_subscription_t **, subscriptions_size)
+  WAIT_SET_CARVE(wait_set->guard_conditions, const rcl_guard_condition_t **, guard_conditions_size)
+  WAIT_SET_CARVE(wait_set->timers, const rcl_timer_t **, timers_size)
+  WAIT_SET_CARVE(wait_set->clients, const rcl_client_t **, clients_size)
+  WAIT_SET_CARVE(wait_set->services, const rcl_service_t **, services_size)
+  WAIT_SET_CARVE(wait_set->events, const rcl_event_t **, events_size)
+  WAIT_SET_CARVE(impl->rmw_subscriptions.subscribers, void **, subscriptions_size)
+  // Guard condition RMW size needs to be guard conditions + timers.
+  WAIT_SET_CARVE(
+    impl->rmw_guard_conditions.guard_conditions, void **,
+    guard_conditions_size + timers_size)
+  WAIT_SET_CARVE(impl->rmw_clients.clients, void **, clients_size)
+  WAIT_SET_CARVE(impl->rmw_services.services, void **, services_size)
+  WAIT_SET_CARVE(impl->rmw_events.events, void **, events_size)
+  impl->timer_heap = (0 != timers_size) ? (size_t *)(void *)block : NULL;
+  block += sizeof(size_t) * timers_size;
+  {
+    const size_t ready_sizes[RCL_WAIT_SET_ENTITY_TYPES] = {
+      subscriptions_size, guard_conditions_size, timers_size,
+      clients_size, services_size, events_size};
+    size_t type = 0;
+    for (type = 0; type < RCL_WAIT_SET_ENTITY_TYPES; ++type) {
+      impl->ready_indices[type] =
+        (0 != ready_sizes[type]) ? (size_t *)(void *)block : NULL;
+      block += sizeof(size_t) * ready_sizes[type];
+    }
+    // The priority bytes come last since they have no alignment requirement.
+    for (type = 0; type < RCL_WAIT_SET_ENTITY_TYPES; ++type) {
+      impl->priorities[type] = (0 != ready_sizes[type]) ? (uint8_t *)block : NULL;
+      block += sizeof(uint8_t) * ready_sizes[type];
     }
+  }
+
+#undef WAIT_SET_CARVE
+
+  wait_set->size_of_subscriptions = subscriptions_size;
+  wait_set->size_of_guard_conditions = guard_conditions_size;
+  wait_set->size_of_timers = timers_size;
+  wait_set->size_of_clients = clients_size;
+  wait_set->size_of_services = services_size;
+  wait_set->size_of_events = events_size;
+
+  if (wait_set->impl->persistent) {
+    // Re-establish (empty) shadow storage sized for the new capacities.
+    rcl_ret_t shadow_ret = __wait_set_allocate_shadow(wait_set);
+    if (RCL_RET_OK != shadow_ret) {
+      return shadow_ret;
+    }
+  }
+
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_set_persistent(rcl_wait_set_t * wait_set, bool persistent)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (!__wait_set_is_valid(wait_set)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+  if (persistent == wait_set->impl->persistent) {
+    return RCL_RET_OK;
+  }
+  if (persistent) {
+    rcl_ret_t ret = __wait_set_allocate_shadow(wait_set);
+    if (RCL_RET_OK != ret) {
+      return ret;
+    }
+    __wait_set_snapshot_shadow(wait_set);
   } else {
-    rmw_gcs->guard_conditions = (void **)wait_set->impl->allocator.reallocate(
-      rmw_gcs->guard_conditions, sizeof(void *) * num_rmw_gc, wait_set->impl->allocator.state);
-    if (!rmw_gcs->guard_conditions) {
-      // Deallocate rcl arrays to match unallocated rmw guard conditions
-      wait_set->impl->allocator.deallocate(
-        (void *)wait_set->guard_conditions, wait_set->impl->allocator.state);
-      wait_set->size_of_guard_conditions = 0u;
-      wait_set->guard_conditions = NULL;
-      wait_set->impl->allocator.deallocate(
-        (void *)wait_set->timers, wait_set->impl->allocator.state);
-      wait_set->size_of_timers = 0u;
-      wait_set->timers = NULL;
-      RCL_SET_ERROR_MSG("allocating memory failed");
-      return RCL_RET_BAD_ALLOC;
-    }
-    memset(rmw_gcs->guard_conditions, 0, sizeof(void *) * num_rmw_gc);
-  }
-
-  SET_RESIZE(timer,;,;);  // NOLINT
-  SET_RESIZE(client,
-    SET_RESIZE_RMW_DEALLOC(
-      rmw_clients.clients, rmw_clients.client_count),
-    SET_RESIZE_RMW_REALLOC(
-      client, rmw_clients.clients, rmw_clients.client_count)
-  );
-  SET_RESIZE(service,
-    SET_RESIZE_RMW_DEALLOC(
-      rmw_services.services, rmw_services.service_count),
-    SET_RESIZE_RMW_REALLOC(
-      service, rmw_services.services, rmw_services.service_count)
-  );
-  SET_RESIZE(event,
-    SET_RESIZE_RMW_DEALLOC(
-      rmw_events.events, rmw_events.event_count),
-    SET_RESIZE_RMW_REALLOC(
-      event, rmw_events.events, rmw_events.event_count)
-  );
+    __wait_set_free_shadow(wait_set);
+  }
+  wait_set->impl->persistent = persistent;
+  return RCL_RET_OK;
+}
 
+rcl_ret_t
+rcl_wait_set_get_ready_entities(
+  const rcl_wait_set_t * wait_set,
+  rcl_wait_set_entity_type_t type,
+  const size_t ** indices,
+  size_t * count)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (!__wait_set_is_valid(wait_set)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+  if (type >= RCL_WAIT_SET_ENTITY_TYPES) {
+    RCL_SET_ERROR_MSG("invalid wait set entity type");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(indices, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(count, RCL_RET_INVALID_ARGUMENT);
+  *indices = wait_set->impl->ready_indices[type];
+  *count = wait_set->impl->ready_counts[type];
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_set_entity_priority(
+  rcl_wait_set_t * wait_set,
+  rcl_wait_set_entity_type_t type,
+  size_t index,
+  uint8_t priority)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (!__wait_set_is_valid(wait_set)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+  if (type >= RCL_WAIT_SET_ENTITY_TYPES) {
+    RCL_SET_ERROR_MSG("invalid wait set entity type");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  const size_t sizes[RCL_WAIT_SET_ENTITY_TYPES] = {
+    wait_set->size_of_subscriptions, wait_set->size_of_guard_conditions,
+    wait_set->size_of_timers, wait_set->size_of_clients,
+    wait_set->size_of_services, wait_set->size_of_events};
+  if (index >= sizes[type]) {
+    RCL_SET_ERROR_MSG("entity index is out of range");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  wait_set->impl->priorities[type][index] = priority;
+  if (0 != priority) {
+    wait_set->impl->has_priorities[type] = true;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_set_on_ready_callback(
+  rcl_wait_set_t * wait_set,
+  rcl_wait_set_on_ready_callback_t callback,
+  void * user_data)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (!__wait_set_is_valid(wait_set)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+  wait_set->impl->on_ready_callback = callback;
+  wait_set->impl->on_ready_user_data = user_data;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_enable_stats(rcl_wait_set_t * wait_set, bool enable)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (!__wait_set_is_valid(wait_set)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+  if (enable && !wait_set->impl->stats_enabled) {
+    memset(&wait_set->impl->stats, 0, sizeof(rcl_wait_set_stats_t));
+  }
+  wait_set->impl->stats_enabled = enable;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_get_stats(const rcl_wait_set_t * wait_set, rcl_wait_set_stats_t * stats)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (!__wait_set_is_valid(wait_set)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  if (!wait_set->impl->stats_enabled) {
+    RCL_SET_ERROR_MSG("wait set stats are not enabled");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  *stats = wait_set->impl->stats;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_set_spin_duration(rcl_wait_set_t * wait_set, int64_t spin_duration)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (!__wait_set_is_valid(wait_set)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+  if (spin_duration < 0) {
+    RCL_SET_ERROR_MSG("spin duration has to be non-negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  wait_set->impl->spin_duration = spin_duration;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_entity_token_init(
+  rcl_wait_set_entity_token_t * token,
+  rcl_wait_set_entity_type_t type,
+  const void * entity)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(token, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(entity, RCL_RET_INVALID_ARGUMENT);
+  void * rmw_data = NULL;
+  switch (type) {
+    case RCL_WAIT_SET_SUBSCRIPTION:
+      {
+        rmw_subscription_t * rmw_handle =
+          rcl_subscription_get_rmw_handle((const rcl_subscription_t *)entity);
+        RCL_CHECK_FOR_NULL_WITH_MSG(
+          rmw_handle, rcl_get_error_string().str, return RCL_RET_ERROR);
+        rmw_data = rmw_handle->data;
+        break;
+      }
+    case RCL_WAIT_SET_GUARD_CONDITION:
+      {
+        rmw_guard_condition_t * rmw_handle =
+          rcl_guard_condition_get_rmw_handle((const rcl_guard_condition_t *)entity);
+        RCL_CHECK_FOR_NULL_WITH_MSG(
+          rmw_handle, rcl_get_error_string().str, return RCL_RET_ERROR);
+        rmw_data = rmw_handle->data;
+        break;
+      }
+    case RCL_WAIT_SET_TIMER:
+      {
+        // Validate the timer and cache its guard condition, if any.
+        bool is_canceled = false;
+        rcl_ret_t ret = rcl_timer_is_canceled((const rcl_timer_t *)entity, &is_canceled);
+        if (RCL_RET_OK != ret) {
+          return ret;  // The rcl error state should already be set.
+        }
+        rcl_guard_condition_t * guard_condition =
+          rcl_timer_get_guard_condition((const rcl_timer_t *)entity);
+        if (NULL != guard_condition) {
+          rmw_guard_condition_t * rmw_handle =
+            rcl_guard_condition_get_rmw_handle(guard_condition);
+          RCL_CHECK_FOR_NULL_WITH_MSG(
+            rmw_handle, rcl_get_error_string().str, return RCL_RET_ERROR);
+          rmw_data = rmw_handle->data;
+        }
+        break;
+      }
+    case RCL_WAIT_SET_CLIENT:
+      {
+        rmw_client_t * rmw_handle = rcl_client_get_rmw_handle((const rcl_client_t *)entity);
+        RCL_CHECK_FOR_NULL_WITH_MSG(
+          rmw_handle, rcl_get_error_string().str, return RCL_RET_ERROR);
+        rmw_data = rmw_handle->data;
+        break;
+      }
+    case RCL_WAIT_SET_SERVICE:
+      {
+        rmw_service_t * rmw_handle = rcl_service_get_rmw_handle((const rcl_service_t *)entity);
+        RCL_CHECK_FOR_NULL_WITH_MSG(
+          rmw_handle, rcl_get_error_string().str, return RCL_RET_ERROR);
+        rmw_data = rmw_handle->data;
+        break;
+      }
+    case RCL_WAIT_SET_EVENT:
+      {
+        // Events store the rmw event itself, not its data pointer.
+        rmw_event_t * rmw_handle = rcl_event_get_rmw_handle((const rcl_event_t *)entity);
+        RCL_CHECK_FOR_NULL_WITH_MSG(
+          rmw_handle, rcl_get_error_string().str, return RCL_RET_ERROR);
+        rmw_data = rmw_handle;
+        break;
+      }
+    default:
+      RCL_SET_ERROR_MSG("invalid wait set entity type");
+      return RCL_RET_INVALID_ARGUMENT;
+  }
+  token->type = type;
+  token->entity = entity;
+  token->rmw_data = rmw_data;
+  return RCL_RET_OK;
+}
+
+/* Implementation-specific notes:
+ *
+ * No argument or validity checking happens here by design; it was done when
+ * the token was created. Only the capacity check remains on the hot path.
+ */
+rcl_ret_t
+rcl_wait_set_add_token(
+  rcl_wait_set_t * wait_set,
+  const rcl_wait_set_entity_token_t * token,
+  size_t * index)
+{
+  rcl_wait_set_impl_t * impl = wait_set->impl;
+  size_t current_index = 0;
+  switch (token->type) {
+    case RCL_WAIT_SET_SUBSCRIPTION:
+      if (!(impl->subscription_index < wait_set->size_of_subscriptions)) {
+        RCL_SET_ERROR_MSG("subscriptions set is full");
+        return RCL_RET_WAIT_SET_FULL;
+      }
+      current_index = impl->subscription_index++;
+      wait_set->subscriptions[current_index] = (const rcl_subscription_t *)token->entity;
+      impl->rmw_subscriptions.subscribers[current_index] = token->rmw_data;
+      impl->rmw_subscriptions.subscriber_count++;
+      if (NULL != impl->subscription_shadow) {
+        impl->subscription_shadow[current_index] = token->entity;
+        impl->rmw_subscription_shadow[current_index] = token->rmw_data;
+      }
+      break;
+    case RCL_WAIT_SET_GUARD_CONDITION:
+      if (!(impl->guard_condition_index < wait_set->size_of_guard_conditions)) {
+        RCL_SET_ERROR_MSG("guard_conditions set is full");
+        return RCL_RET_WAIT_SET_FULL;
+      }
+      current_index = impl->guard_condition_index++;
+      wait_set->guard_conditions[current_index] =
+        (const rcl_guard_condition_t *)token->entity;
+      impl->rmw_guard_conditions.guard_conditions[current_index] = token->rmw_data;
+      impl->rmw_guard_conditions.guard_condition_count++;
+      if (NULL != impl->guard_condition_shadow) {
+        impl->guard_condition_shadow[current_index] = token->entity;
+        impl->rmw_guard_condition_shadow[current_index] = token->rmw_data;
+      }
+      break;
+    case RCL_WAIT_SET_TIMER:
+      {
+        if (!(impl->timer_index < wait_set->size_of_timers)) {
+          RCL_SET_ERROR_MSG("timers set is full");
+          return RCL_RET_WAIT_SET_FULL;
+        }
+        current_index = impl->timer_index++;
+        wait_set->timers[current_index] = (const rcl_timer_t *)token->entity;
+        if (NULL != impl->timer_shadow) {
+          impl->timer_shadow[current_index] = token->entity;
+        }
+        rcl_ret_t ret = __wait_set_push_timer_deadline(
+          wait_set, (const rcl_timer_t *)token->entity, current_index);
+        if (RCL_RET_OK != ret) {
+          return ret;  // The rcl error state should already be set.
+        }
+        if (NULL != token->rmw_data) {
+          // rcl_wait() moves the guard condition backwards, as for typed adds.
+          const size_t gc_index =
+            wait_set->size_of_guard_conditions + current_index;
+          impl->rmw_guard_conditions.guard_conditions[gc_index] = token->rmw_data;
+          if (NULL != impl->rmw_guard_condition_shadow) {
+            impl->rmw_guard_condition_shadow[gc_index] = token->rmw_data;
+          }
+        }
+        break;
+      }
+    case RCL_WAIT_SET_CLIENT:
+      if (!(impl->client_index < wait_set->size_of_clients)) {
+        RCL_SET_ERROR_MSG("clients set is full");
+        return RCL_RET_WAIT_SET_FULL;
+      }
+      current_index = impl->client_index++;
+      wait_set->clients[current_index] = (const rcl_client_t *)token->entity;
+      impl->rmw_clients.clients[current_index] = token->rmw_data;
+      impl->rmw_clients.client_count++;
+      if (NULL != impl->client_shadow) {
+        impl->client_shadow[current_index] = token->entity;
+        impl->rmw_client_shadow[current_index] = token->rmw_data;
+      }
+      break;
+    case RCL_WAIT_SET_SERVICE:
+      if (!(impl->service_index < wait_set->size_of_services)) {
+        RCL_SET_ERROR_MSG("services set is full");
+        return RCL_RET_WAIT_SET_FULL;
+      }
+      current_index = impl->service_index++;
+      wait_set->services[current_index] = (const rcl_service_t *)token->entity;
+      impl->rmw_services.services[current_index] = token->rmw_data;
+      impl->rmw_services.service_count++;
+      if (NULL != impl->service_shadow) {
+        impl->service_shadow[current_index] = token->entity;
+        impl->rmw_service_shadow[current_index] = token->rmw_data;
+      }
+      break;
+    case RCL_WAIT_SET_EVENT:
+      if (!(impl->event_index < wait_set->size_of_events)) {
+        RCL_SET_ERROR_MSG("events set is full");
+        return RCL_RET_WAIT_SET_FULL;
+      }
+      current_index = impl->event_index++;
+      wait_set->events[current_index] = (const rcl_event_t *)token->entity;
+      impl->rmw_events.events[current_index] = token->rmw_data;
+      impl->rmw_events.event_count++;
+      if (NULL != impl->event_shadow) {
+        impl->event_shadow[current_index] = token->entity;
+        impl->rmw_event_shadow[current_index] = token->rmw_data;
+      }
+      break;
+    default:
+      RCL_SET_ERROR_MSG("invalid wait set entity type");
+      return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (NULL != index) {
+    *index = current_index;
+  }
   return RCL_RET_OK;
 }
 
@@ -464,6 +1261,11 @@ rcl_wait_set_add_timer(
   size_t * index)
 {
   SET_ADD(timer)
+  // Record the timer's deadline in the heap used to compute the wait timeout.
+  rcl_ret_t heap_ret = __wait_set_push_timer_deadline(wait_set, timer, current_index);
+  if (RCL_RET_OK != heap_ret) {
+    return heap_ret;  // The rcl error state should already be set.
+  }
   // Add timer guard conditions to end of rmw guard condtion set.
   rcl_guard_condition_t * guard_condition = rcl_timer_get_guard_condition(timer);
   if (NULL != guard_condition) {
@@ -473,6 +1275,9 @@ rcl_wait_set_add_timer(
     RCL_CHECK_FOR_NULL_WITH_MSG(
       rmw_handle, rcl_get_error_string().str, return RCL_RET_ERROR);
     wait_set->impl->rmw_guard_conditions.guard_conditions[index] = rmw_handle->data;
+    if (NULL != wait_set->impl->rmw_guard_condition_shadow) {
+      wait_set->impl->rmw_guard_condition_shadow[index] = rmw_handle->data;
+    }
   }
   return RCL_RET_OK;
 }
@@ -508,28 +1313,206 @@ rcl_wait_set_add_event(
   SET_ADD(event)
   SET_ADD_RMW(event, rmw_events.events, rmw_events.event_count)
   wait_set->impl->rmw_events.events[current_index] = rmw_handle;
+  if (NULL != wait_set->impl->rmw_event_shadow) {
+    wait_set->impl->rmw_event_shadow[current_index] = rmw_handle;
+  }
   return RCL_RET_OK;
 }
 
 rcl_ret_t
-rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
+rcl_wait_set_add_fd(
+  rcl_wait_set_t * wait_set,
+  int fd,
+  uint32_t events,
+  size_t * index)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (!__wait_set_is_valid(wait_set)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+#ifdef _WIN32
+  (void)fd;
+  (void)events;
+  (void)index;
+  RCL_SET_ERROR_MSG("waiting on file descriptors is not supported on this platform");
+  return RCL_RET_UNSUPPORTED;
+#else
+  if (fd < 0) {
+    RCL_SET_ERROR_MSG("fd is negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (0 == (events & (RCL_WAIT_SET_FD_READABLE | RCL_WAIT_SET_FD_WRITABLE))) {
+    RCL_SET_ERROR_MSG("events has to include at least one of readable or writable");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_wait_set_impl_t * impl = wait_set->impl;
+  if (impl->fd_index == impl->fd_capacity) {
+    rcl_allocator_t allocator = impl->allocator;
+    const size_t new_capacity = (0u == impl->fd_capacity) ? 8u : (2u * impl->fd_capacity);
+    void * tmp_ptr = allocator.reallocate(
+      impl->fds, new_capacity * sizeof(rcl_wait_set_fd_t), allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(tmp_ptr, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    impl->fds = (rcl_wait_set_fd_t *)tmp_ptr;
+    tmp_ptr = allocator.reallocate(
+      impl->fd_scratch, new_capacity * sizeof(struct pollfd), allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(tmp_ptr, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    impl->fd_scratch = (struct pollfd *)tmp_ptr;
+    impl->fd_capacity = new_capacity;
+  }
+  const size_t current_index = impl->fd_index++;
+  impl->fds[current_index].fd = fd;
+  impl->fds[current_index].events = events;
+  impl->fds[current_index].revents = 0u;
+  if (NULL != index) {
+    *index = current_index;
+  }
+  return RCL_RET_OK;
+#endif
+}
+
+rcl_ret_t
+rcl_wait_set_set_fd_poll_period(rcl_wait_set_t * wait_set, int64_t period)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
   if (!__wait_set_is_valid(wait_set)) {
     RCL_SET_ERROR_MSG("wait set is invalid");
     return RCL_RET_WAIT_SET_INVALID;
   }
+  if (period <= 0) {
+    RCL_SET_ERROR_MSG("period has to be positive");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  wait_set->impl->fd_poll_period = period;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_get_fds(
+  const rcl_wait_set_t * wait_set,
+  const rcl_wait_set_fd_t ** fds,
+  size_t * count)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (!__wait_set_is_valid(wait_set)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(fds, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(count, RCL_RET_INVALID_ARGUMENT);
+  *fds = wait_set->impl->fds;
+  *count = wait_set->impl->fd_index;
+  return RCL_RET_OK;
+}
+
+#ifndef _WIN32
+// Poll the attached file descriptors without blocking and record their
+// readiness in the revents members.
+static rcl_ret_t
+__wait_set_poll_fds(rcl_wait_set_impl_t * impl, bool * any_ready)
+{
+  *any_ready = false;
+  if (0 == impl->fd_index) {
+    return RCL_RET_OK;
+  }
+  size_t i = 0;
+  for (i = 0; i < impl->fd_index; ++i) {
+    impl->fd_scratch[i].fd = impl->fds[i].fd;
+    short poll_events = 0;  // NOLINT(runtime/int) dictated by poll()
+    if (impl->fds[i].events & RCL_WAIT_SET_FD_READABLE) {
+      poll_events |= POLLIN;
+    }
+    if (impl->fds[i].events & RCL_WAIT_SET_FD_WRITABLE) {
+      poll_events |= POLLOUT;
+    }
+    impl->fd_scratch[i].events = poll_events;
+    impl->fd_scratch[i].revents = 0;
+    impl->fds[i].revents = 0u;
+  }
+  int rc = poll(impl->fd_scratch, (nfds_t)impl->fd_index, 0);
+  if (rc < 0) {
+    if (EINTR == errno) {
+      return RCL_RET_OK;  // Interrupted, nothing observed this round.
+    }
+    RCL_SET_ERROR_MSG("polling the attached file descriptors failed");
+    return RCL_RET_ERROR;
+  }
+  if (0 == rc) {
+    return RCL_RET_OK;
+  }
+  for (i = 0; i < impl->fd_index; ++i) {
+    uint32_t revents = 0u;
+    if (impl->fd_scratch[i].revents & POLLIN) {
+      revents |= RCL_WAIT_SET_FD_READABLE;
+    }
+    if (impl->fd_scratch[i].revents & POLLOUT) {
+      revents |= RCL_WAIT_SET_FD_WRITABLE;
+    }
+    if (impl->fd_scratch[i].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+      revents |= RCL_WAIT_SET_FD_ERROR;
+    }
+    impl->fds[i].revents = revents;
+    if (0u != revents) {
+      *any_ready = true;
+    }
+  }
+  return RCL_RET_OK;
+}
+#endif
+
+// Record the rcutils clock error; out of line to keep the wait hot path small.
+static RCL_COLD rcl_ret_t
+_rcl_wait_clock_failed(void)
+{
+  RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+  return RCL_RET_ERROR;
+}
+
+// Record the rmw error state; out of line, as above.
+static RCL_COLD rcl_ret_t
+_rcl_wait_rmw_failed(void)
+{
+  RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+  return RCL_RET_ERROR;
+}
+
+// Implementation only
+static rcl_ret_t
+_rcl_wait_impl(rcl_wait_set_t * wait_set, int64_t timeout)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (RCL_UNLIKELY(!__wait_set_is_valid(wait_set))) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
   if (
     wait_set->size_of_subscriptions == 0 &&
     wait_set->size_of_guard_conditions == 0 &&
     wait_set->size_of_timers == 0 &&
     wait_set->size_of_clients == 0 &&
     wait_set->size_of_services == 0 &&
-    wait_set->size_of_events == 0)
+    wait_set->size_of_events == 0 &&
+    wait_set->impl->fd_index == 0)
   {
     RCL_SET_ERROR_MSG("wait set is empty");
     return RCL_RET_WAIT_SET_EMPTY;
   }
+  {
+    // The ready lists describe the previous wait, reset them.
+    size_t type = 0;
+    for (type = 0; type < RCL_WAIT_SET_ENTITY_TYPES; ++type) {
+      wait_set->impl->ready_counts[type] = 0;
+    }
+  }
+  // Timestamps bracketing the rmw_wait call, only taken when stats are on.
+  rcutils_time_point_value_t stats_entry_time = 0;
+  rcutils_time_point_value_t stats_before_rmw_time = 0;
+  rcutils_time_point_value_t stats_after_rmw_time = 0;
+  if (wait_set->impl->stats_enabled) {
+    if (RCL_UNLIKELY(RCUTILS_RET_OK != rcutils_steady_time_now(&stats_entry_time))) {
+      return _rcl_wait_clock_failed();
+    }
+  }
   // Calculate the timeout argument.
   // By default, set the timer to block indefinitely if none of the below conditions are met.
   rmw_time_t * timeout_argument = NULL;
@@ -537,40 +1520,141 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
 
   bool is_timer_timeout = false;
   int64_t min_timeout = timeout > 0 ? timeout : INT64_MAX;
+  // Deadline of a precision timer driving the wake, in steady time; the
+  // blocking wait stops short of it and the rest of the stretch is spun,
+  // see rcl_timer_set_precision().
+  bool precision_wait = false;
+  int64_t precision_deadline = 0;
   {  // scope to prevent i from colliding below
+    // Move the guard conditions of the added timers to make a legal wait set.
+    rmw_guard_conditions_t * rmw_gcs = &(wait_set->impl->rmw_guard_conditions);
     uint64_t i = 0;
     for (i = 0; i < wait_set->impl->timer_index; ++i) {
       if (!wait_set->timers[i]) {
         continue;  // Skip NULL timers.
       }
+      size_t gc_idx = wait_set->size_of_guard_conditions + i;
+      if (NULL != rmw_gcs->guard_conditions[gc_idx]) {
+        rmw_gcs->guard_conditions[rmw_gcs->guard_condition_count] =
+          rmw_gcs->guard_conditions[gc_idx];
+        ++(rmw_gcs->guard_condition_count);
+      }
+    }
+  }
+  // Compute the timer contribution to the timeout from the heap top instead
+  // of scanning every timer, lazily refreshing entries whose deadline moved
+  // since they were pushed (e.g. because the timer was called or reset).
+  {
+    rcl_wait_set_impl_t * impl = wait_set->impl;
+    rcutils_time_point_value_t now = 0;
+    if (impl->timer_heap_size > 0) {
+      if (RCL_UNLIKELY(RCUTILS_RET_OK != rcutils_steady_time_now(&now))) {
+        return _rcl_wait_clock_failed();
+      }
+    }
+    size_t refresh_budget = impl->timer_heap_size;
+    while (impl->timer_heap_size > 0) {
+      const size_t top = impl->timer_heap[0];
+      if (!wait_set->timers[top]) {
+        __timer_heap_pop(impl);
+        continue;
+      }
       bool is_canceled = false;
-      rcl_ret_t ret = rcl_timer_is_canceled(wait_set->timers[i], &is_canceled);
+      rcl_ret_t ret = rcl_timer_is_canceled(wait_set->timers[top], &is_canceled);
       if (ret != RCL_RET_OK) {
         return ret;  // The rcl error state should already be set.
       }
       if (is_canceled) {
-        wait_set->timers[i] = NULL;
+        // Canceled timers elsewhere in the heap are pruned after the wait by
+        // the rcl_timer_is_ready() check below.
+        wait_set->timers[top] = NULL;
+        __timer_heap_pop(impl);
         continue;
       }
-      rmw_guard_conditions_t * rmw_gcs = &(wait_set->impl->rmw_guard_conditions);
-      size_t gc_idx = wait_set->size_of_guard_conditions + i;
-      if (NULL != rmw_gcs->guard_conditions[gc_idx]) {
-        // This timer has a guard condition, so move it to make a legal wait set.
-        rmw_gcs->guard_conditions[rmw_gcs->guard_condition_count] =
-          rmw_gcs->guard_conditions[gc_idx];
-        ++(rmw_gcs->guard_condition_count);
-      }
       // use timer time to to set the rmw_wait timeout
       // TODO(sloretz) fix spurious wake-ups on ROS_TIME timers with ROS_TIME enabled
       int64_t timer_timeout = INT64_MAX;
-      ret = rcl_timer_get_time_until_next_call(wait_set->timers[i], &timer_timeout);
+      ret = rcl_timer_get_time_until_next_call(wait_set->timers[top], &timer_timeout);
       if (ret != RCL_RET_OK) {
         return ret;  // The rcl error state should already be set.
       }
-      if (timer_timeout < min_timeout) {
+      const int64_t fresh_deadline =
+        timer_timeout > INT64_MAX - now ? INT64_MAX : now + timer_timeout;
+      if (fresh_deadline > impl->timer_deadlines[top] && refresh_budget > 0) {
+        // The stored deadline is stale; push the entry back down with the
+        // fresh one and re-examine the new top.
+        --refresh_budget;
+        impl->timer_deadlines[top] = fresh_deadline;
+        __timer_heap_sift_down(impl, 0);
+        if (impl->timer_heap[0] != top) {
+          continue;
+        }
+      }
+      bool precision = false;
+      ret = rcl_timer_get_precision(wait_set->timers[top], &precision);
+      if (ret != RCL_RET_OK) {
+        return ret;  // The rcl error state should already be set.
+      }
+      int64_t slack = 0;
+      ret = rcl_timer_get_slack(wait_set->timers[top], &slack);
+      if (ret != RCL_RET_OK) {
+        return ret;  // The rcl error state should already be set.
+      }
+      if (!precision && slack > 0 && impl->timer_heap_size > 1) {
+        // Coalesce nearby wakeups: wake once at the latest deadline inside
+        // the earliest timer's slack window that every timer in the window
+        // can still tolerate, instead of once per timer as they drift
+        // against each other.
+        int64_t window_end =
+          slack > INT64_MAX - fresh_deadline ? INT64_MAX : fresh_deadline + slack;
+        for (size_t h = 1; h < impl->timer_heap_size; ++h) {
+          const size_t idx = impl->timer_heap[h];
+          if (!wait_set->timers[idx] || impl->timer_deadlines[idx] > window_end) {
+            continue;
+          }
+          int64_t other_slack = 0;
+          ret = rcl_timer_get_slack(wait_set->timers[idx], &other_slack);
+          if (ret != RCL_RET_OK) {
+            return ret;  // The rcl error state should already be set.
+          }
+          // Stored deadlines may be stale, but stale means "too early", which
+          // only tightens the window; the coalesced wakeup is never late.
+          const int64_t other_limit =
+            other_slack > INT64_MAX - impl->timer_deadlines[idx] ?
+            INT64_MAX : impl->timer_deadlines[idx] + other_slack;
+          if (other_limit < window_end) {
+            window_end = other_limit;
+          }
+        }
+        int64_t wake = fresh_deadline;
+        for (size_t h = 1; h < impl->timer_heap_size; ++h) {
+          const size_t idx = impl->timer_heap[h];
+          if (wait_set->timers[idx] &&
+            impl->timer_deadlines[idx] <= window_end &&
+            impl->timer_deadlines[idx] > wake)
+          {
+            wake = impl->timer_deadlines[idx];
+          }
+        }
+        timer_timeout = wake - now;
+      }
+      if (precision) {
+        // Stop the blocking wait one spin delta short of the deadline; the
+        // gap is spun after the wait below.
+        const int64_t spin_delta = impl->precision_spin_delta;
+        const int64_t shortened =
+          timer_timeout > spin_delta ? timer_timeout - spin_delta : 0;
+        if (shortened < min_timeout) {
+          is_timer_timeout = true;
+          min_timeout = shortened;
+          precision_wait = true;
+          precision_deadline = fresh_deadline;
+        }
+      } else if (timer_timeout < min_timeout) {
         is_timer_timeout = true;
         min_timeout = timer_timeout;
       }
+      break;
     }
   }
 
@@ -588,6 +1672,33 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
     temporary_timeout_storage.nsec = min_timeout % 1000000000;
     timeout_argument = &temporary_timeout_storage;
   }
+
+  // Readiness of the attached file descriptors, observed by the poll that
+  // brackets the rmw wait below.
+  bool any_fd_ready = false;
+#ifndef _WIN32
+  if (wait_set->impl->fd_index > 0) {
+    rcl_ret_t fd_ret = __wait_set_poll_fds(wait_set->impl, &any_fd_ready);
+    if (RCL_RET_OK != fd_ret) {
+      return fd_ret;  // The rcl error state should already be set.
+    }
+    if (any_fd_ready) {
+      // Something is already ready; check the middleware without blocking.
+      temporary_timeout_storage.sec = 0;
+      temporary_timeout_storage.nsec = 0;
+      timeout_argument = &temporary_timeout_storage;
+    } else if (0 != timeout &&
+      (NULL == timeout_argument || min_timeout > wait_set->impl->fd_poll_period))
+    {
+      // The middleware cannot block on file descriptors, so bound the block
+      // to the poll period; the fds are re-examined right after the wait.
+      const int64_t fd_period = wait_set->impl->fd_poll_period;
+      temporary_timeout_storage.sec = RCL_NS_TO_S(fd_period);
+      temporary_timeout_storage.nsec = fd_period % 1000000000;
+      timeout_argument = &temporary_timeout_storage;
+    }
+  }
+#endif
   RCUTILS_LOG_DEBUG_EXPRESSION_NAMED(
     !timeout_argument, ROS_PACKAGE_NAME, "Waiting without timeout");
   RCUTILS_LOG_DEBUG_EXPRESSION_NAMED(
@@ -598,19 +1709,234 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
     ROS_PACKAGE_NAME, "Timeout calculated based on next scheduled timer: %s",
     is_timer_timeout ? "true" : "false");
 
-  // Wait.
-  rmw_ret_t ret = rmw_wait(
-    &wait_set->impl->rmw_subscriptions,
-    &wait_set->impl->rmw_guard_conditions,
-    &wait_set->impl->rmw_services,
-    &wait_set->impl->rmw_clients,
-    &wait_set->impl->rmw_events,
-    wait_set->impl->rmw_wait_set,
-    timeout_argument);
+  // Optional spin-before-block phase: probe readiness with zero-timeout rmw
+  // waits for up to the configured duration before paying for the blocking
+  // wait, see rcl_wait_set_set_spin_duration(). Each fruitless probe prunes
+  // the rmw arrays, so the persistent shadow storage re-arms them in between.
+  bool spin_ready = false;
+  if (wait_set->impl->spin_duration > 0 && wait_set->impl->persistent &&
+    NULL != wait_set->impl->shadow_block && 0 != timeout && !any_fd_ready)
+  {
+    rcl_wait_set_impl_t * impl = wait_set->impl;
+    rcutils_time_point_value_t spin_start = 0;
+    if (RCL_UNLIKELY(RCUTILS_RET_OK != rcutils_steady_time_now(&spin_start))) {
+      return _rcl_wait_clock_failed();
+    }
+    int64_t spin_budget = impl->spin_duration;
+    if (NULL != timeout_argument) {
+      // Never spin past the effective blocking timeout.
+      const int64_t block_ns =
+        (int64_t)(temporary_timeout_storage.sec * 1000000000LL) +
+        (int64_t)temporary_timeout_storage.nsec;
+      if (block_ns < spin_budget) {
+        spin_budget = block_ns;
+      }
+    }
+    rmw_time_t spin_timeout = {0, 0};
+    rcutils_time_point_value_t spin_now = spin_start;
+    while (spin_now - spin_start < spin_budget) {
+      rmw_ret_t spin_ret = rmw_wait(
+        &impl->rmw_subscriptions,
+        &impl->rmw_guard_conditions,
+        &impl->rmw_services,
+        &impl->rmw_clients,
+        &impl->rmw_events,
+        impl->rmw_wait_set,
+        &spin_timeout);
+      if (RCL_UNLIKELY(RMW_RET_OK != spin_ret && RMW_RET_TIMEOUT != spin_ret)) {
+        return _rcl_wait_rmw_failed();
+      }
+      bool something_ready = false;
+      size_t j = 0;
+      for (j = 0; j < impl->rmw_subscriptions.subscriber_count && !something_ready; ++j) {
+        something_ready = NULL != impl->rmw_subscriptions.subscribers[j];
+      }
+      for (j = 0; j < impl->rmw_guard_conditions.guard_condition_count && !something_ready; ++j) {
+        something_ready = NULL != impl->rmw_guard_conditions.guard_conditions[j];
+      }
+      for (j = 0; j < impl->rmw_clients.client_count && !something_ready; ++j) {
+        something_ready = NULL != impl->rmw_clients.clients[j];
+      }
+      for (j = 0; j < impl->rmw_services.service_count && !something_ready; ++j) {
+        something_ready = NULL != impl->rmw_services.services[j];
+      }
+      for (j = 0; j < impl->rmw_events.event_count && !something_ready; ++j) {
+        something_ready = NULL != impl->rmw_events.events[j];
+      }
+      if (something_ready) {
+        // The probe already produced the pruned arrays; the blocking wait
+        // below is skipped so a consumed guard condition is not lost.
+        spin_ready = true;
+        break;
+      }
+      // Nothing ready; restore the pruned arrays and try again.
+      rcl_ret_t rearm_ret = __wait_set_rearm(wait_set);
+      if (RCL_RET_OK != rearm_ret) {
+        return rearm_ret;  // The rcl error state should already be set.
+      }
+      {
+        // Re-arming reset the guard condition count, so the timer guard
+        // conditions have to be moved back in, as at the top of the wait.
+        rmw_guard_conditions_t * rmw_gcs = &impl->rmw_guard_conditions;
+        for (j = 0; j < impl->timer_index; ++j) {
+          if (!wait_set->timers[j]) {
+            continue;  // Skip NULL timers.
+          }
+          const size_t gc_idx = wait_set->size_of_guard_conditions + j;
+          if (NULL != rmw_gcs->guard_conditions[gc_idx]) {
+            rmw_gcs->guard_conditions[rmw_gcs->guard_condition_count] =
+              rmw_gcs->guard_conditions[gc_idx];
+            ++(rmw_gcs->guard_condition_count);
+          }
+        }
+      }
+#ifndef _WIN32
+      if (impl->fd_index > 0) {
+        rcl_ret_t fd_ret = __wait_set_poll_fds(impl, &any_fd_ready);
+        if (RCL_RET_OK != fd_ret) {
+          return fd_ret;  // The rcl error state should already be set.
+        }
+        if (any_fd_ready) {
+          break;
+        }
+      }
+#endif
+      if (RCL_UNLIKELY(RCUTILS_RET_OK != rcutils_steady_time_now(&spin_now))) {
+        return _rcl_wait_clock_failed();
+      }
+    }
+    if (any_fd_ready) {
+      // A file descriptor became ready during the spin; check the
+      // middleware once more without blocking.
+      temporary_timeout_storage.sec = 0;
+      temporary_timeout_storage.nsec = 0;
+      timeout_argument = &temporary_timeout_storage;
+    } else if (!spin_ready && NULL != timeout_argument) {
+      // Shrink the blocking timeout by the time spent spinning.
+      int64_t block_ns =
+        (int64_t)(temporary_timeout_storage.sec * 1000000000LL) +
+        (int64_t)temporary_timeout_storage.nsec;
+      block_ns -= spin_now - spin_start;
+      if (block_ns < 0) {
+        block_ns = 0;
+      }
+      temporary_timeout_storage.sec = RCL_NS_TO_S(block_ns);
+      temporary_timeout_storage.nsec = block_ns % 1000000000;
+    }
+  }
+
+  if (wait_set->impl->stats_enabled) {
+    if (RCL_UNLIKELY(RCUTILS_RET_OK != rcutils_steady_time_now(&stats_before_rmw_time))) {
+      return _rcl_wait_clock_failed();
+    }
+  }
+  // Time the blocking wait when a precision timer drives the wake, so its
+  // actual wake latency can recalibrate the spin delta afterwards.
+  rcutils_time_point_value_t precision_block_start = 0;
+  if (precision_wait && !spin_ready) {
+    if (RCL_UNLIKELY(RCUTILS_RET_OK != rcutils_steady_time_now(&precision_block_start))) {
+      return _rcl_wait_clock_failed();
+    }
+  }
+  // Wait, unless the spin phase already came back with ready entities.
+  rmw_ret_t ret = RMW_RET_OK;
+  if (!spin_ready) {
+    ret = rmw_wait(
+      &wait_set->impl->rmw_subscriptions,
+      &wait_set->impl->rmw_guard_conditions,
+      &wait_set->impl->rmw_services,
+      &wait_set->impl->rmw_clients,
+      &wait_set->impl->rmw_events,
+      wait_set->impl->rmw_wait_set,
+      timeout_argument);
+  }
+
+  if (wait_set->impl->stats_enabled) {
+    if (RCL_UNLIKELY(RCUTILS_RET_OK != rcutils_steady_time_now(&stats_after_rmw_time))) {
+      return _rcl_wait_clock_failed();
+    }
+  }
+
+  // Final approach for a precision timer: the blocking wait deliberately
+  // stopped short of the deadline, so spin the remainder until the timer
+  // readiness check below observes the deadline as passed.  A wake for any
+  // other reason returns immediately instead of delaying the ready entities.
+  if (precision_wait && !spin_ready && 0 != timeout && RMW_RET_TIMEOUT == ret) {
+    rcutils_time_point_value_t spin_now = 0;
+    if (RCL_UNLIKELY(RCUTILS_RET_OK != rcutils_steady_time_now(&spin_now))) {
+      return _rcl_wait_clock_failed();
+    }
+    rcl_wait_set_impl_t * impl = wait_set->impl;
+    const int64_t requested_ns =
+      (int64_t)(temporary_timeout_storage.sec * 1000000000LL) +
+      (int64_t)temporary_timeout_storage.nsec;
+    const int64_t wake_latency = spin_now - (precision_block_start + requested_ns);
+    if (wake_latency >= 0) {
+      // Trail the delta after the observed latency exponentially, clamped so
+      // one scheduling hiccup cannot grow the spin unboundedly.
+      int64_t delta = impl->precision_spin_delta;
+      delta += (wake_latency + RCL_WAIT_PRECISION_SPIN_DELTA_MIN - delta) / 8;
+      if (delta < RCL_WAIT_PRECISION_SPIN_DELTA_MIN) {
+        delta = RCL_WAIT_PRECISION_SPIN_DELTA_MIN;
+      } else if (delta > RCL_WAIT_PRECISION_SPIN_DELTA_MAX) {
+        delta = RCL_WAIT_PRECISION_SPIN_DELTA_MAX;
+      }
+      impl->precision_spin_delta = delta;
+    }
+    // Never spin more than the delta bound, e.g. when the block was cut
+    // short by the fd poll period rather than by the timer deadline.
+    if (precision_deadline - spin_now <= RCL_WAIT_PRECISION_SPIN_DELTA_MAX) {
+      while (spin_now < precision_deadline) {
+        if (RCL_UNLIKELY(RCUTILS_RET_OK != rcutils_steady_time_now(&spin_now))) {
+          return _rcl_wait_clock_failed();
+        }
+      }
+    }
+  }
+
+#ifndef _WIN32
+  // Re-examine the file descriptors, picking up readiness that arrived while
+  // blocked in the middleware wait.
+  if (wait_set->impl->fd_index > 0) {
+    rcl_ret_t fd_ret = __wait_set_poll_fds(wait_set->impl, &any_fd_ready);
+    if (RCL_RET_OK != fd_ret) {
+      return fd_ret;  // The rcl error state should already be set.
+    }
+  }
+#endif
 
   // Items that are not ready will have been set to NULL by rmw_wait.
   // We now update our handles accordingly.
 
+  // Refresh the cached time of each distinct timer clock once per wakeup, so
+  // rcl_clock_get_now_coarse() readers see a value no staler than this wait.
+  for (size_t timer_idx = 0; timer_idx < wait_set->impl->timer_index; ++timer_idx) {
+    if (!wait_set->timers[timer_idx]) {
+      continue;
+    }
+    rcl_clock_t * clock = NULL;
+    rcl_ret_t clock_ret = rcl_timer_clock((rcl_timer_t *)wait_set->timers[timer_idx], &clock);
+    if (clock_ret != RCL_RET_OK) {
+      return clock_ret;  // The rcl error state should already be set.
+    }
+    // Skip clocks already refreshed through an earlier timer in the set.
+    bool already_cached = false;
+    for (size_t j = 0; j < timer_idx && !already_cached; ++j) {
+      rcl_clock_t * other_clock = NULL;
+      if (wait_set->timers[j] &&
+        RCL_RET_OK == rcl_timer_clock((rcl_timer_t *)wait_set->timers[j], &other_clock))
+      {
+        already_cached = other_clock == clock;
+      }
+    }
+    if (!already_cached) {
+      clock_ret = rcl_clock_cache_now(clock);
+      if (clock_ret != RCL_RET_OK) {
+        return clock_ret;  // The rcl error state should already be set.
+      }
+    }
+  }
+
   // Check for ready timers
   // and set not ready timers (which includes canceled timers) to NULL.
   size_t i;
@@ -618,20 +1944,44 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
     if (!wait_set->timers[i]) {
       continue;
     }
-    bool is_ready = false;
-    rcl_ret_t ret = rcl_timer_is_ready(wait_set->timers[i], &is_ready);
+    // Readiness is derived from time_until_next_call so the value can double
+    // as the sort key below; this matches rcl_timer_is_ready().
+    int64_t time_until_next_call = 0;
+    rcl_ret_t ret = rcl_timer_get_time_until_next_call(
+      wait_set->timers[i], &time_until_next_call);
     if (ret != RCL_RET_OK) {
       return ret;  // The rcl error state should already be set.
     }
+    bool is_canceled = false;
+    ret = rcl_timer_is_canceled(wait_set->timers[i], &is_canceled);
+    if (ret != RCL_RET_OK) {
+      return ret;  // The rcl error state should already be set.
+    }
+    const bool is_ready = time_until_next_call <= 0 && !is_canceled;
     RCUTILS_LOG_DEBUG_EXPRESSION_NAMED(is_ready, ROS_PACKAGE_NAME, "Timer in wait set is ready");
     if (!is_ready) {
       wait_set->timers[i] = NULL;
+    } else {
+      // Keep the ready list ordered most-overdue first, so executors that
+      // honor the list fire starved timers before less urgent ones.  The
+      // deadline storage is reused as the sort key; entries are repopulated
+      // when timers are added for the next wait.
+      rcl_wait_set_impl_t * impl = wait_set->impl;
+      size_t * ready_indices = impl->ready_indices[RCL_WAIT_SET_TIMER];
+      impl->timer_deadlines[i] = time_until_next_call;
+      size_t pos = impl->ready_counts[RCL_WAIT_SET_TIMER]++;
+      while (pos > 0 &&
+        impl->timer_deadlines[ready_indices[pos - 1]] > time_until_next_call)
+      {
+        ready_indices[pos] = ready_indices[pos - 1];
+        --pos;
+      }
+      ready_indices[pos] = i;
     }
   }
   // Check for timeout, return RCL_RET_TIMEOUT only if it wasn't a timer.
-  if (ret != RMW_RET_OK && ret != RMW_RET_TIMEOUT) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    return RCL_RET_ERROR;
+  if (RCL_UNLIKELY(ret != RMW_RET_OK && ret != RMW_RET_TIMEOUT)) {
+    return _rcl_wait_rmw_failed();
   }
   // Set corresponding rcl subscription handles NULL.
   for (i = 0; i < wait_set->size_of_subscriptions; ++i) {
@@ -640,6 +1990,9 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
       is_ready, ROS_PACKAGE_NAME, "Subscription in wait set is ready");
     if (!is_ready) {
       wait_set->subscriptions[i] = NULL;
+    } else {
+      wait_set->impl->ready_indices[RCL_WAIT_SET_SUBSCRIPTION][
+        wait_set->impl->ready_counts[RCL_WAIT_SET_SUBSCRIPTION]++] = i;
     }
   }
   // Set corresponding rcl guard_condition handles NULL.
@@ -649,6 +2002,16 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
       is_ready, ROS_PACKAGE_NAME, "Guard condition in wait set is ready");
     if (!is_ready) {
       wait_set->guard_conditions[i] = NULL;
+    } else {
+      wait_set->impl->ready_indices[RCL_WAIT_SET_GUARD_CONDITION][
+        wait_set->impl->ready_counts[RCL_WAIT_SET_GUARD_CONDITION]++] = i;
+      // The pending wakeup has been consumed; let the next trigger of an
+      // edge-triggered guard condition reach rmw again.
+      rcl_ret_t rearm_ret =
+        rcl_guard_condition_rearm((rcl_guard_condition_t *)wait_set->guard_conditions[i]);
+      if (rearm_ret != RCL_RET_OK) {
+        return rearm_ret;  // The rcl error state should already be set.
+      }
     }
   }
   // Set corresponding rcl client handles NULL.
@@ -657,6 +2020,9 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
     RCUTILS_LOG_DEBUG_EXPRESSION_NAMED(is_ready, ROS_PACKAGE_NAME, "Client in wait set is ready");
     if (!is_ready) {
       wait_set->clients[i] = NULL;
+    } else {
+      wait_set->impl->ready_indices[RCL_WAIT_SET_CLIENT][
+        wait_set->impl->ready_counts[RCL_WAIT_SET_CLIENT]++] = i;
     }
   }
   // Set corresponding rcl service handles NULL.
@@ -665,6 +2031,9 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
     RCUTILS_LOG_DEBUG_EXPRESSION_NAMED(is_ready, ROS_PACKAGE_NAME, "Service in wait set is ready");
     if (!is_ready) {
       wait_set->services[i] = NULL;
+    } else {
+      wait_set->impl->ready_indices[RCL_WAIT_SET_SERVICE][
+        wait_set->impl->ready_counts[RCL_WAIT_SET_SERVICE]++] = i;
     }
   }
   // Set corresponding rcl event handles NULL.
@@ -673,15 +2042,315 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
     RCUTILS_LOG_DEBUG_EXPRESSION_NAMED(is_ready, ROS_PACKAGE_NAME, "Event in wait set is ready");
     if (!is_ready) {
       wait_set->events[i] = NULL;
+    } else {
+      wait_set->impl->ready_indices[RCL_WAIT_SET_EVENT][
+        wait_set->impl->ready_counts[RCL_WAIT_SET_EVENT]++] = i;
     }
   }
 
-  if (RMW_RET_TIMEOUT == ret && !is_timer_timeout) {
+  {
+    // Reorder the ready lists by priority class so dispatch order follows
+    // urgency; a no-op while every entity is in the default class.
+    size_t type = 0;
+    for (type = 0; type < RCL_WAIT_SET_ENTITY_TYPES; ++type) {
+      if (wait_set->impl->has_priorities[type] && wait_set->impl->ready_counts[type] > 1) {
+        __wait_set_sort_ready_by_priority(wait_set->impl, type);
+      }
+    }
+  }
+
+  if (wait_set->impl->stats_enabled) {
+    rcutils_time_point_value_t exit_time = 0;
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&exit_time)) {
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    rcl_wait_set_stats_t * stats = &wait_set->impl->stats;
+    const uint64_t blocked =
+      (uint64_t)(stats_after_rmw_time - stats_before_rmw_time);
+    const uint64_t overhead =
+      (uint64_t)(stats_before_rmw_time - stats_entry_time) +
+      (uint64_t)(exit_time - stats_after_rmw_time);
+    size_t ready = 0;
+    size_t type = 0;
+    for (type = 0; type < RCL_WAIT_SET_ENTITY_TYPES; ++type) {
+      ready += wait_set->impl->ready_counts[type];
+    }
+    ++stats->cycle_count;
+    stats->last_rmw_wait_time = blocked;
+    stats->total_rmw_wait_time += blocked;
+    if (blocked < stats->min_rmw_wait_time || 1 == stats->cycle_count) {
+      stats->min_rmw_wait_time = blocked;
+    }
+    if (blocked > stats->max_rmw_wait_time) {
+      stats->max_rmw_wait_time = blocked;
+    }
+    stats->last_overhead_time = overhead;
+    stats->total_overhead_time += overhead;
+    stats->last_ready_entities = (uint64_t)ready;
+    stats->total_ready_entities += (uint64_t)ready;
+  }
+  if (RMW_RET_TIMEOUT == ret && !is_timer_timeout && !any_fd_ready) {
     return RCL_RET_TIMEOUT;
   }
+  if (NULL != wait_set->impl->on_ready_callback) {
+    // Dispatch the ready entities directly, saving the caller the
+    // wake -> scan -> dispatch round trip.
+    size_t type = 0;
+    for (type = 0; type < RCL_WAIT_SET_ENTITY_TYPES; ++type) {
+      size_t r = 0;
+      for (r = 0; r < wait_set->impl->ready_counts[type]; ++r) {
+        wait_set->impl->on_ready_callback(
+          wait_set, (rcl_wait_set_entity_type_t)type,
+          wait_set->impl->ready_indices[type][r],
+          wait_set->impl->on_ready_user_data);
+      }
+    }
+  }
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
+{
+  RCL_TRACEPOINT(rcl_wait_entry, wait_set);
+  rcl_ret_t ret = _rcl_wait_impl(wait_set, timeout);
+  if (RCL_RET_OK == ret || RCL_RET_TIMEOUT == ret) {
+    rcl_context_counter_add(
+      wait_set->impl->context, RCL_CONTEXT_COUNTER_WAIT_CYCLES, 1);
+  }
+  RCL_TRACEPOINT(rcl_wait_exit, wait_set);
+  return ret;
+}
+
+rcl_ret_t
+rcl_wait_multiple(
+  rcl_wait_set_t ** wait_sets,
+  size_t number_of_wait_sets,
+  int64_t timeout,
+  int64_t rotation_period)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_sets, RCL_RET_INVALID_ARGUMENT);
+  if (0 == number_of_wait_sets) {
+    RCL_SET_ERROR_MSG("number_of_wait_sets has to be non-zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  size_t i = 0;
+  for (i = 0; i < number_of_wait_sets; ++i) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(wait_sets[i], RCL_RET_INVALID_ARGUMENT);
+    if (!__wait_set_is_valid(wait_sets[i])) {
+      RCL_SET_ERROR_MSG("wait set is invalid");
+      return RCL_RET_WAIT_SET_INVALID;
+    }
+  }
+  if (1 == number_of_wait_sets) {
+    return rcl_wait(wait_sets[0], timeout);
+  }
+  // Re-arming between rounds relies on the persistent shadow storage; a
+  // non-persistent set would lose its attachments after the first round.
+  for (i = 0; i < number_of_wait_sets; ++i) {
+    if (!wait_sets[i]->impl->persistent) {
+      RCL_SET_ERROR_MSG(
+        "every wait set has to be persistent, see rcl_wait_set_set_persistent()");
+      return RCL_RET_INVALID_ARGUMENT;
+    }
+  }
+  if (rotation_period <= 0) {
+    rotation_period = RCL_MS_TO_NS(1);
+  }
+  int64_t deadline = 0;
+  if (timeout >= 0) {
+    rcutils_time_point_value_t now = 0;
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    deadline = timeout > INT64_MAX - now ? INT64_MAX : now + timeout;
+  }
+  // rmw can only block on one wait set at a time, so rotate: each round one
+  // set gets a bounded blocking wait while the others are polled, and the
+  // blocking slot moves on so every set is blocked on in turn.
+  size_t rotate = 0;
+  bool last_round = 0 == timeout;
+  while (true) {
+    int64_t blocking_slice = 0;
+    if (timeout < 0) {
+      blocking_slice = rotation_period;
+    } else if (timeout > 0) {
+      rcutils_time_point_value_t now = 0;
+      if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+        RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+        return RCL_RET_ERROR;
+      }
+      const int64_t remaining = deadline - now;
+      if (remaining <= 0) {
+        // Out of time; sweep every set once more without blocking so a late
+        // arrival is still reported, then time out.
+        last_round = true;
+      } else {
+        blocking_slice = remaining < rotation_period ? remaining : rotation_period;
+      }
+    }
+    bool any_ready = false;
+    for (i = 0; i < number_of_wait_sets; ++i) {
+      const size_t index = (rotate + i) % number_of_wait_sets;
+      rcl_ret_t ret = rcl_wait_set_clear(wait_sets[index]);
+      if (RCL_RET_OK != ret) {
+        return ret;  // The rcl error state should already be set.
+      }
+      ret = rcl_wait(wait_sets[index], (0 == i) ? blocking_slice : 0);
+      if (RCL_RET_OK == ret) {
+        any_ready = true;
+      } else if (RCL_RET_TIMEOUT != ret) {
+        return ret;  // The rcl error state should already be set.
+      }
+    }
+    if (any_ready) {
+      return RCL_RET_OK;
+    }
+    if (last_round) {
+      return RCL_RET_TIMEOUT;
+    }
+    ++rotate;
+  }
+}
+
+rcl_wait_set_group_t
+rcl_get_zero_initialized_wait_set_group()
+{
+  static rcl_wait_set_group_t null_wait_set_group = {
+    .wait_sets = NULL,
+    .size_of_wait_sets = 0,
+    .impl = NULL,
+  };
+  return null_wait_set_group;
+}
+
+typedef struct rcl_wait_set_group_impl_t
+{
+  // round-robin cursor used to spread entity attachment across the shards
+  atomic_uint_least64_t next_wait_set;
+  // allocator used for the group storage
+  rcl_allocator_t allocator;
+} rcl_wait_set_group_impl_t;
+
+rcl_ret_t
+rcl_wait_set_group_init(
+  rcl_wait_set_group_t * wait_set_group,
+  size_t number_of_wait_sets,
+  size_t number_of_subscriptions,
+  size_t number_of_guard_conditions,
+  size_t number_of_timers,
+  size_t number_of_clients,
+  size_t number_of_services,
+  size_t number_of_events,
+  rcl_context_t * context,
+  rcl_allocator_t allocator)
+{
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set_group, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != wait_set_group->impl) {
+    RCL_SET_ERROR_MSG("wait_set_group already initialized, or memory was uninitialized.");
+    return RCL_RET_ALREADY_INIT;
+  }
+  if (0 == number_of_wait_sets) {
+    RCL_SET_ERROR_MSG("number_of_wait_sets has to be non-zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  wait_set_group->impl = (rcl_wait_set_group_impl_t *)allocator.allocate(
+    sizeof(rcl_wait_set_group_impl_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    wait_set_group->impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  atomic_init(&wait_set_group->impl->next_wait_set, 0);
+  wait_set_group->impl->allocator = allocator;
+  wait_set_group->wait_sets = (rcl_wait_set_t *)allocator.allocate(
+    sizeof(rcl_wait_set_t) * number_of_wait_sets, allocator.state);
+  if (NULL == wait_set_group->wait_sets) {
+    allocator.deallocate(wait_set_group->impl, allocator.state);
+    wait_set_group->impl = NULL;
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  // Divide each capacity across the shards, rounding up so the totals fit.
+  const size_t shards = number_of_wait_sets;
+  size_t i = 0;
+  for (i = 0; i < number_of_wait_sets; ++i) {
+    wait_set_group->wait_sets[i] = rcl_get_zero_initialized_wait_set();
+    rcl_ret_t ret = rcl_wait_set_init(
+      &wait_set_group->wait_sets[i],
+      (number_of_subscriptions + shards - 1) / shards,
+      (number_of_guard_conditions + shards - 1) / shards,
+      (number_of_timers + shards - 1) / shards,
+      (number_of_clients + shards - 1) / shards,
+      (number_of_services + shards - 1) / shards,
+      (number_of_events + shards - 1) / shards,
+      context, allocator);
+    if (RCL_RET_OK != ret) {
+      while (i > 0) {
+        --i;
+        rcl_ret_t fini_ret = rcl_wait_set_fini(&wait_set_group->wait_sets[i]);
+        (void)fini_ret;  // The init error is the one worth reporting.
+      }
+      allocator.deallocate(wait_set_group->wait_sets, allocator.state);
+      wait_set_group->wait_sets = NULL;
+      allocator.deallocate(wait_set_group->impl, allocator.state);
+      wait_set_group->impl = NULL;
+      return ret;  // The rcl error state should already be set.
+    }
+  }
+  wait_set_group->size_of_wait_sets = number_of_wait_sets;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_group_fini(rcl_wait_set_group_t * wait_set_group)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set_group, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t result = RCL_RET_OK;
+  if (NULL != wait_set_group->impl) {
+    rcl_allocator_t allocator = wait_set_group->impl->allocator;
+    size_t i = 0;
+    for (i = 0; i < wait_set_group->size_of_wait_sets; ++i) {
+      rcl_ret_t ret = rcl_wait_set_fini(&wait_set_group->wait_sets[i]);
+      if (RCL_RET_OK != ret) {
+        result = ret;
+      }
+    }
+    allocator.deallocate(wait_set_group->wait_sets, allocator.state);
+    wait_set_group->wait_sets = NULL;
+    wait_set_group->size_of_wait_sets = 0;
+    allocator.deallocate(wait_set_group->impl, allocator.state);
+    wait_set_group->impl = NULL;
+  }
+  return result;
+}
+
+rcl_wait_set_t *
+rcl_wait_set_group_get_wait_set(
+  const rcl_wait_set_group_t * wait_set_group,
+  size_t index)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set_group, NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    wait_set_group->impl, "wait set group is invalid", return NULL);
+  if (index >= wait_set_group->size_of_wait_sets) {
+    RCL_SET_ERROR_MSG("wait set index out of range");
+    return NULL;
+  }
+  return &wait_set_group->wait_sets[index];
+}
+
+rcl_wait_set_t *
+rcl_wait_set_group_next_wait_set(rcl_wait_set_group_t * wait_set_group)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set_group, NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    wait_set_group->impl, "wait set group is invalid", return NULL);
+  const uint64_t cursor =
+    rcutils_atomic_fetch_add_uint64_t(&wait_set_group->impl->next_wait_set, 1);
+  return &wait_set_group->wait_sets[cursor % wait_set_group->size_of_wait_sets];
+}
+
 #ifdef __cplusplus
 }
 #endif
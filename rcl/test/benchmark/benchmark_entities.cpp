@@ -0,0 +1,406 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Microbenchmarks for the rcl entity hot paths: publish, take, the
+// rcl_wait() cycle at several entity counts, timer calls, wait set
+// resizing and graph queries against a synthetic topology of up to
+// thousands of topics.  The numbers depend on the rmw implementation selected via
+// RMW_IMPLEMENTATION, so the harness is useful both for comparing rmw
+// vendors and for catching regressions in rcl itself.
+//
+// Each benchmark runs a warmup, then reports the mean wall time per
+// iteration measured with the steady clock, in the spirit of a Google
+// Benchmark console reporter but without the extra dependency.
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "rcl/graph.h"
+#include "rcl/rcl.h"
+#include "rcl/error_handling.h"
+#include "rcutils/types/string_array.h"
+
+#include "rosidl_generator_c/message_type_support_struct.h"
+#include "rosidl_generator_c/service_type_support_struct.h"
+#include "test_msgs/msg/basic_types.h"
+#include "test_msgs/srv/basic_types.h"
+
+namespace
+{
+
+constexpr int kWarmupIterations = 100;
+constexpr int kBenchmarkIterations = 10000;
+
+// Time `iterations` calls of `op` and print the mean time per call.
+void run_benchmark(
+  const std::string & name, int iterations, const std::function<bool()> & op)
+{
+  for (int i = 0; i < kWarmupIterations; ++i) {
+    if (!op()) {
+      fprintf(stderr, "%-40s failed during warmup: %s\n", name.c_str(), rcl_get_error_string().str);
+      rcl_reset_error();
+      return;
+    }
+  }
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    if (!op()) {
+      fprintf(
+        stderr, "%-40s failed during measurement: %s\n", name.c_str(),
+        rcl_get_error_string().str);
+      rcl_reset_error();
+      return;
+    }
+  }
+  const auto end = std::chrono::steady_clock::now();
+  const int64_t total_ns =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+  printf(
+    "%-40s %10d iterations %12" PRId64 " ns/op\n",
+    name.c_str(), iterations, total_ns / iterations);
+}
+
+bool benchmark_publish_take(rcl_context_t * context, rcl_node_t * node)
+{
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const char * topic = "benchmark_publish_take";
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  rcl_ret_t ret = rcl_publisher_init(&publisher, node, ts, topic, &publisher_options);
+  if (RCL_RET_OK != ret) {
+    return false;
+  }
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  ret = rcl_subscription_init(&subscription, node, ts, topic, &subscription_options);
+  if (RCL_RET_OK != ret) {
+    (void)rcl_publisher_fini(&publisher, node);
+    return false;
+  }
+  (void)context;
+
+  test_msgs__msg__BasicTypes message;
+  test_msgs__msg__BasicTypes__init(&message);
+  message.int64_value = 42;
+
+  run_benchmark(
+    "publish/BasicTypes", kBenchmarkIterations,
+    [&publisher, &message]() {
+      return RCL_RET_OK == rcl_publish(&publisher, &message);
+    });
+
+  test_msgs__msg__BasicTypes taken_message;
+  test_msgs__msg__BasicTypes__init(&taken_message);
+  run_benchmark(
+    "publish_then_take/BasicTypes", kBenchmarkIterations,
+    [&publisher, &subscription, &message, &taken_message]() {
+      if (RCL_RET_OK != rcl_publish(&publisher, &message)) {
+        return false;
+      }
+      // Takes can outrun delivery; an empty queue is not an rcl regression.
+      rcl_ret_t take_ret = rcl_take(&subscription, &taken_message, nullptr, nullptr);
+      if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == take_ret) {
+        rcl_reset_error();
+        return true;
+      }
+      return RCL_RET_OK == take_ret;
+    });
+
+  test_msgs__msg__BasicTypes__fini(&taken_message);
+  test_msgs__msg__BasicTypes__fini(&message);
+  bool ok = RCL_RET_OK == rcl_subscription_fini(&subscription, node);
+  ok = (RCL_RET_OK == rcl_publisher_fini(&publisher, node)) && ok;
+  return ok;
+}
+
+bool benchmark_wait_cycle(rcl_context_t * context, rcl_node_t * node)
+{
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  constexpr size_t kEntityCounts[] = {1, 10, 50};
+  for (size_t count : kEntityCounts) {
+    std::vector<rcl_subscription_t> subscriptions(
+      count, rcl_get_zero_initialized_subscription());
+    rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+    bool ok = true;
+    for (size_t i = 0; i < count; ++i) {
+      const std::string topic = "benchmark_wait_" + std::to_string(i);
+      if (RCL_RET_OK != rcl_subscription_init(
+          &subscriptions[i], node, ts, topic.c_str(), &subscription_options))
+      {
+        ok = false;
+        break;
+      }
+    }
+    if (ok) {
+      rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+      if (RCL_RET_OK != rcl_wait_set_init(
+          &wait_set, count, 0, 0, 0, 0, 0, context, rcl_get_default_allocator()))
+      {
+        ok = false;
+      } else {
+        run_benchmark(
+          "wait_cycle/subscriptions:" + std::to_string(count), kBenchmarkIterations,
+          [&wait_set, &subscriptions, count]() {
+            if (RCL_RET_OK != rcl_wait_set_clear(&wait_set)) {
+              return false;
+            }
+            for (size_t i = 0; i < count; ++i) {
+              if (RCL_RET_OK != rcl_wait_set_add_subscription(
+                  &wait_set, &subscriptions[i], nullptr))
+              {
+                return false;
+              }
+            }
+            // Nothing is ready, so a zero timeout measures pure cycle cost.
+            rcl_ret_t wait_ret = rcl_wait(&wait_set, 0);
+            if (RCL_RET_TIMEOUT == wait_ret) {
+              rcl_reset_error();
+              return true;
+            }
+            return RCL_RET_OK == wait_ret;
+          });
+        ok = RCL_RET_OK == rcl_wait_set_fini(&wait_set);
+      }
+    }
+    for (auto & subscription : subscriptions) {
+      if (nullptr != subscription.impl) {
+        ok = (RCL_RET_OK == rcl_subscription_fini(&subscription, node)) && ok;
+      }
+    }
+    if (!ok) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool benchmark_timer_call(rcl_context_t * context)
+{
+  rcl_clock_t clock;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  if (RCL_RET_OK != rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator)) {
+    return false;
+  }
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  // Zero period so every call is due, measuring call overhead not waiting.
+  rcl_ret_t ret = rcl_timer_init(
+    &timer, &clock, context, 0, 0, nullptr, rcl_get_default_allocator());
+  if (RCL_RET_OK != ret) {
+    (void)rcl_clock_fini(&clock);
+    return false;
+  }
+  run_benchmark(
+    "timer_call/period:0", kBenchmarkIterations,
+    [&timer]() {
+      return RCL_RET_OK == rcl_timer_call(&timer);
+    });
+  bool ok = RCL_RET_OK == rcl_timer_fini(&timer);
+  ok = (RCL_RET_OK == rcl_clock_fini(&clock)) && ok;
+  return ok;
+}
+
+bool benchmark_wait_set_resize(rcl_context_t * context)
+{
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret = rcl_wait_set_init(
+    &wait_set, 1, 1, 1, 1, 1, 1, context, rcl_get_default_allocator());
+  if (RCL_RET_OK != ret) {
+    return false;
+  }
+  size_t size = 1;
+  run_benchmark(
+    "wait_set_resize/alternating:1,64", kBenchmarkIterations,
+    [&wait_set, &size]() {
+      size = (1 == size) ? 64 : 1;
+      return RCL_RET_OK == rcl_wait_set_resize(&wait_set, size, size, size, size, size, size);
+    });
+  return RCL_RET_OK == rcl_wait_set_fini(&wait_set);
+}
+
+// Populates the graph with a growing number of synthetic topics and measures
+// the graph query latency at each size.  Discovery of one process's own
+// entities is immediate with every rmw implementation, so no settling time is
+// needed; with a remote process in the graph the numbers also include
+// whatever the middleware pays to merge remote discovery data.
+bool benchmark_graph_queries(rcl_context_t * context, rcl_node_t * node)
+{
+  (void)context;
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const rosidl_service_type_support_t * srv_ts =
+    ROSIDL_GET_SRV_TYPE_SUPPORT(test_msgs, srv, BasicTypes);
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+
+  // A matched service and client, so that the availability check below finds
+  // its server among however many topics the graph holds.
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  rcl_ret_t ret = rcl_service_init(
+    &service, node, srv_ts, "benchmark_graph_service", &service_options);
+  if (RCL_RET_OK != ret) {
+    return false;
+  }
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  ret = rcl_client_init(&client, node, srv_ts, "benchmark_graph_service", &client_options);
+  if (RCL_RET_OK != ret) {
+    (void)rcl_service_fini(&service, node);
+    return false;
+  }
+
+  constexpr size_t kGraphSizes[] = {10, 100, 1000};
+  // The listing queries copy the whole graph per call; fewer iterations keep
+  // the largest size affordable.
+  constexpr int kListIterations = kBenchmarkIterations / 100;
+  constexpr int kCountIterations = kBenchmarkIterations / 10;
+
+  std::vector<rcl_publisher_t> publishers;
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  bool ok = true;
+  for (size_t target : kGraphSizes) {
+    size_t created = publishers.size();
+    publishers.resize(target, rcl_get_zero_initialized_publisher());
+    for (; ok && created < target; ++created) {
+      const std::string topic = "benchmark_graph_topic_" + std::to_string(created);
+      ok = RCL_RET_OK == rcl_publisher_init(
+        &publishers[created], node, ts, topic.c_str(), &publisher_options);
+    }
+    if (!ok) {
+      fprintf(stderr, "failed to populate graph: %s\n", rcl_get_error_string().str);
+      break;
+    }
+    const std::string suffix = "/topics:" + std::to_string(target);
+
+    run_benchmark(
+      "get_topic_names_and_types" + suffix, kListIterations,
+      [node, &allocator]() {
+        rcl_names_and_types_t tnat = rcl_get_zero_initialized_names_and_types();
+        if (RCL_RET_OK != rcl_get_topic_names_and_types(node, &allocator, false, &tnat)) {
+          return false;
+        }
+        return RCL_RET_OK == rcl_names_and_types_fini(&tnat);
+      });
+
+    run_benchmark(
+      "get_node_names" + suffix, kListIterations,
+      [node, &allocator]() {
+        rcutils_string_array_t names = rcutils_get_zero_initialized_string_array();
+        rcutils_string_array_t namespaces = rcutils_get_zero_initialized_string_array();
+        if (RCL_RET_OK != rcl_get_node_names(node, allocator, &names, &namespaces)) {
+          return false;
+        }
+        bool fini_ok = RCUTILS_RET_OK == rcutils_string_array_fini(&names);
+        return (RCUTILS_RET_OK == rcutils_string_array_fini(&namespaces)) && fini_ok;
+      });
+
+    run_benchmark(
+      "count_publishers" + suffix, kCountIterations,
+      [node]() {
+        size_t count = 0;
+        if (RCL_RET_OK != rcl_count_publishers(node, "benchmark_graph_topic_0", &count)) {
+          return false;
+        }
+        return 1u == count;
+      });
+
+    run_benchmark(
+      "service_server_is_available" + suffix, kCountIterations,
+      [node, &client]() {
+        bool is_available = false;
+        if (RCL_RET_OK != rcl_service_server_is_available(node, &client, &is_available)) {
+          return false;
+        }
+        return is_available;
+      });
+  }
+
+  for (auto & publisher : publishers) {
+    if (nullptr != publisher.impl) {
+      ok = (RCL_RET_OK == rcl_publisher_fini(&publisher, node)) && ok;
+    }
+  }
+  ok = (RCL_RET_OK == rcl_client_fini(&client, node)) && ok;
+  ok = (RCL_RET_OK == rcl_service_fini(&service, node)) && ok;
+  return ok;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  rcl_ret_t ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  if (RCL_RET_OK != ret) {
+    fprintf(stderr, "failed to init options: %s\n", rcl_get_error_string().str);
+    return 1;
+  }
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  ret = rcl_init(argc, argv, &init_options, &context);
+  if (RCL_RET_OK != ret) {
+    fprintf(stderr, "failed to init rcl: %s\n", rcl_get_error_string().str);
+    return 1;
+  }
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rcl_node_options_t node_options = rcl_node_get_default_options();
+  ret = rcl_node_init(&node, "rcl_benchmarks", "", &context, &node_options);
+  if (RCL_RET_OK != ret) {
+    fprintf(stderr, "failed to init node: %s\n", rcl_get_error_string().str);
+    return 1;
+  }
+
+  int result = 0;
+  if (!benchmark_publish_take(&context, &node)) {
+    result = 1;
+  }
+  if (!benchmark_wait_cycle(&context, &node)) {
+    result = 1;
+  }
+  if (!benchmark_timer_call(&context)) {
+    result = 1;
+  }
+  if (!benchmark_wait_set_resize(&context)) {
+    result = 1;
+  }
+  if (!benchmark_graph_queries(&context, &node)) {
+    result = 1;
+  }
+  if (0 != result) {
+    fprintf(stderr, "benchmark failure: %s\n", rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+
+  ret = rcl_node_fini(&node);
+  if (RCL_RET_OK != ret) {
+    result = 1;
+  }
+  ret = rcl_shutdown(&context);
+  if (RCL_RET_OK != ret) {
+    result = 1;
+  }
+  ret = rcl_context_fini(&context);
+  if (RCL_RET_OK != ret) {
+    result = 1;
+  }
+  ret = rcl_init_options_fini(&init_options);
+  if (RCL_RET_OK != ret) {
+    result = 1;
+  }
+  return result;
+}
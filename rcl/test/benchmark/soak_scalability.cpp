@@ -0,0 +1,396 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Process-scale soak harness: spins up many nodes in one process, each with
+// a configurable number of entities, and reports node-creation throughput,
+// discovery convergence, steady-state wait cycle cost and resident set size
+// over a configurable run time.  Scaling cliffs (quadratic graph queries,
+// wait set rebuild costs, registry reallocation storms) show up here long
+// before they show up as microbenchmark regressions.
+//
+// Not registered with ctest; run manually, e.g.:
+//   rcl_soak_scalability --nodes 1000 --subscriptions-per-node 2 \
+//     --duration-seconds 3600 --report-interval-seconds 60
+// The defaults are sized so that a plain run finishes in seconds and can be
+// used as a smoke test.
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "rcl/graph.h"
+#include "rcl/rcl.h"
+#include "rcl/error_handling.h"
+
+#include "rosidl_generator_c/message_type_support_struct.h"
+#include "test_msgs/msg/basic_types.h"
+
+namespace
+{
+
+struct soak_options_t
+{
+  size_t nodes = 50;
+  size_t publishers_per_node = 1;
+  size_t subscriptions_per_node = 1;
+  // 0 runs a single wait cycle measurement pass instead of a timed soak.
+  int64_t duration_seconds = 0;
+  int64_t report_interval_seconds = 10;
+};
+
+struct soak_node_t
+{
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  std::vector<rcl_publisher_t> publishers;
+  std::vector<rcl_subscription_t> subscriptions;
+};
+
+int64_t elapsed_ms(const std::chrono::steady_clock::time_point & since)
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - since).count();
+}
+
+// Resident set size in kilobytes, or 0 where /proc is not available.
+size_t current_rss_kb()
+{
+#ifdef __linux__
+  FILE * statm = fopen("/proc/self/statm", "r");
+  if (nullptr == statm) {
+    return 0;
+  }
+  unsigned long size_pages = 0;  // NOLINT(runtime/int) matches statm's format
+  unsigned long rss_pages = 0;  // NOLINT(runtime/int)
+  int matched = fscanf(statm, "%lu %lu", &size_pages, &rss_pages);
+  fclose(statm);
+  if (2 != matched) {
+    return 0;
+  }
+  return rss_pages * 4;  // pages are 4 KiB on every platform this runs on
+#else
+  return 0;
+#endif
+}
+
+bool parse_size_arg(const char * value, size_t * out)
+{
+  char * end = nullptr;
+  int64_t parsed = strtoll(value, &end, 10);
+  if (nullptr == end || '\0' != *end || parsed < 0) {
+    return false;
+  }
+  *out = static_cast<size_t>(parsed);
+  return true;
+}
+
+bool parse_options(int argc, char ** argv, soak_options_t * options)
+{
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const char * arg = argv[i];
+    size_t parsed = 0;
+    if (!parse_size_arg(argv[i + 1], &parsed)) {
+      fprintf(stderr, "malformed value for %s: %s\n", arg, argv[i + 1]);
+      return false;
+    }
+    if (0 == strcmp(arg, "--nodes")) {
+      options->nodes = parsed;
+    } else if (0 == strcmp(arg, "--publishers-per-node")) {
+      options->publishers_per_node = parsed;
+    } else if (0 == strcmp(arg, "--subscriptions-per-node")) {
+      options->subscriptions_per_node = parsed;
+    } else if (0 == strcmp(arg, "--duration-seconds")) {
+      options->duration_seconds = static_cast<int64_t>(parsed);
+    } else if (0 == strcmp(arg, "--report-interval-seconds")) {
+      options->report_interval_seconds = static_cast<int64_t>(parsed);
+    } else {
+      fprintf(stderr, "unknown argument: %s\n", arg);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Creates all nodes and their entities, reporting creation throughput.
+// Every node subscribes to one shared topic so that discovery convergence
+// can be measured with a single graph count afterwards.
+bool create_nodes(
+  rcl_context_t * context, const soak_options_t & options, std::vector<soak_node_t> * nodes)
+{
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rcl_node_options_t node_options = rcl_node_get_default_options();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+
+  nodes->resize(options.nodes);
+  const auto node_start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < options.nodes; ++i) {
+    const std::string name = "soak_node_" + std::to_string(i);
+    rcl_ret_t ret = rcl_node_init(
+      &(*nodes)[i].node, name.c_str(), "/soak", context, &node_options);
+    if (RCL_RET_OK != ret) {
+      fprintf(stderr, "failed to init node %zu: %s\n", i, rcl_get_error_string().str);
+      return false;
+    }
+  }
+  const int64_t node_ms = elapsed_ms(node_start);
+  printf(
+    "node_creation          %10zu nodes %12" PRId64 " ms  %10.1f nodes/s\n",
+    options.nodes, node_ms,
+    node_ms > 0 ? 1000.0 * static_cast<double>(options.nodes) / static_cast<double>(node_ms) :
+    static_cast<double>(options.nodes));
+
+  const auto entity_start = std::chrono::steady_clock::now();
+  size_t entities = 0;
+  for (size_t i = 0; i < options.nodes; ++i) {
+    soak_node_t & entry = (*nodes)[i];
+    entry.publishers.resize(options.publishers_per_node, rcl_get_zero_initialized_publisher());
+    for (size_t p = 0; p < options.publishers_per_node; ++p) {
+      const std::string topic = "node_" + std::to_string(i) + "_topic_" + std::to_string(p);
+      rcl_ret_t ret = rcl_publisher_init(
+        &entry.publishers[p], &entry.node, ts, topic.c_str(), &publisher_options);
+      if (RCL_RET_OK != ret) {
+        fprintf(stderr, "failed to init publisher: %s\n", rcl_get_error_string().str);
+        return false;
+      }
+      ++entities;
+    }
+    // the first subscription of every node goes to the shared topic
+    entry.subscriptions.resize(
+      options.subscriptions_per_node, rcl_get_zero_initialized_subscription());
+    for (size_t s = 0; s < options.subscriptions_per_node; ++s) {
+      std::string topic = "soak_shared";
+      if (s > 0) {
+        // the remaining subscriptions match this node's own publishers, if any
+        topic = "node_" + std::to_string(i) + "_topic_" +
+          std::to_string(options.publishers_per_node ? s % options.publishers_per_node : s);
+      }
+      rcl_ret_t ret = rcl_subscription_init(
+        &entry.subscriptions[s], &entry.node, ts, topic.c_str(), &subscription_options);
+      if (RCL_RET_OK != ret) {
+        fprintf(stderr, "failed to init subscription: %s\n", rcl_get_error_string().str);
+        return false;
+      }
+      ++entities;
+    }
+  }
+  const int64_t entity_ms = elapsed_ms(entity_start);
+  printf(
+    "entity_creation        %10zu entities %9" PRId64 " ms  %10.1f entities/s\n",
+    entities, entity_ms,
+    entity_ms > 0 ? 1000.0 * static_cast<double>(entities) / static_cast<double>(entity_ms) :
+    static_cast<double>(entities));
+  printf("rss_after_creation     %10zu KiB\n", current_rss_kb());
+  return true;
+}
+
+// Polls the graph from the first node until every node's shared subscription
+// is visible, reporting how long discovery took to converge in-process.
+bool measure_discovery_convergence(
+  const soak_options_t & options, std::vector<soak_node_t> * nodes)
+{
+  if (0 == options.nodes || 0 == options.subscriptions_per_node) {
+    return true;
+  }
+  const rcl_node_t * observer = &(*nodes)[0].node;
+  const auto start = std::chrono::steady_clock::now();
+  const int64_t timeout_ms = 60 * 1000;
+  size_t count = 0;
+  while (count < options.nodes) {
+    rcl_ret_t ret = rcl_count_subscribers(observer, "/soak/soak_shared", &count);
+    if (RCL_RET_OK != ret) {
+      fprintf(stderr, "failed to count subscribers: %s\n", rcl_get_error_string().str);
+      return false;
+    }
+    if (elapsed_ms(start) > timeout_ms) {
+      fprintf(
+        stderr, "discovery did not converge: %zu of %zu subscriptions visible\n",
+        count, options.nodes);
+      return false;
+    }
+  }
+  printf(
+    "discovery_convergence  %10zu subscriptions %6" PRId64 " ms\n",
+    options.nodes, elapsed_ms(start));
+  return true;
+}
+
+// Runs wait cycles over every subscription until the soak duration elapses,
+// reporting the cycle cost and resident set size at each interval.  Memory
+// growth between intervals at steady state is a leak or an unbounded cache.
+bool run_soak(
+  rcl_context_t * context, const soak_options_t & options, std::vector<soak_node_t> * nodes)
+{
+  size_t total_subscriptions = options.nodes * options.subscriptions_per_node;
+  if (0 == total_subscriptions) {
+    // an empty wait set cannot be waited on
+    return true;
+  }
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret = rcl_wait_set_init(
+    &wait_set, total_subscriptions, 0, 0, 0, 0, 0, context, rcl_get_default_allocator());
+  if (RCL_RET_OK != ret) {
+    fprintf(stderr, "failed to init wait set: %s\n", rcl_get_error_string().str);
+    return false;
+  }
+
+  const auto soak_start = std::chrono::steady_clock::now();
+  const int64_t duration_ms = options.duration_seconds * 1000;
+  const int64_t interval_ms = options.report_interval_seconds * 1000;
+  int64_t next_report_ms = interval_ms;
+  int64_t interval_cycles = 0;
+  auto interval_start = std::chrono::steady_clock::now();
+  bool ok = true;
+  do {
+    if (RCL_RET_OK != rcl_wait_set_clear(&wait_set)) {
+      ok = false;
+      break;
+    }
+    for (auto & entry : *nodes) {
+      for (auto & subscription : entry.subscriptions) {
+        if (RCL_RET_OK != rcl_wait_set_add_subscription(&wait_set, &subscription, nullptr)) {
+          ok = false;
+          break;
+        }
+      }
+    }
+    if (!ok) {
+      break;
+    }
+    // nothing is ready, so a zero timeout measures pure cycle cost
+    rcl_ret_t wait_ret = rcl_wait(&wait_set, 0);
+    if (RCL_RET_OK != wait_ret && RCL_RET_TIMEOUT != wait_ret) {
+      ok = false;
+      break;
+    }
+    rcl_reset_error();
+    ++interval_cycles;
+    const int64_t now_ms = elapsed_ms(soak_start);
+    if (now_ms >= next_report_ms || (0 == duration_ms && interval_cycles >= 100)) {
+      const int64_t interval_elapsed_ms = elapsed_ms(interval_start);
+      printf(
+        "wait_cycle             %10" PRId64 " cycles %11" PRId64 " us/cycle  rss %zu KiB\n",
+        interval_cycles,
+        interval_cycles > 0 ? (interval_elapsed_ms * 1000) / interval_cycles : 0,
+        current_rss_kb());
+      fflush(stdout);
+      next_report_ms += interval_ms;
+      interval_cycles = 0;
+      interval_start = std::chrono::steady_clock::now();
+      if (0 == duration_ms) {
+        break;
+      }
+    }
+  } while (elapsed_ms(soak_start) < duration_ms);
+  if (!ok) {
+    fprintf(stderr, "wait cycle failed: %s\n", rcl_get_error_string().str);
+  }
+  ok = (RCL_RET_OK == rcl_wait_set_fini(&wait_set)) && ok;
+  return ok;
+}
+
+bool destroy_nodes(std::vector<soak_node_t> * nodes)
+{
+  bool ok = true;
+  const auto start = std::chrono::steady_clock::now();
+  for (auto & entry : *nodes) {
+    for (auto & subscription : entry.subscriptions) {
+      if (nullptr != subscription.impl) {
+        ok = (RCL_RET_OK == rcl_subscription_fini(&subscription, &entry.node)) && ok;
+      }
+    }
+    for (auto & publisher : entry.publishers) {
+      if (nullptr != publisher.impl) {
+        ok = (RCL_RET_OK == rcl_publisher_fini(&publisher, &entry.node)) && ok;
+      }
+    }
+    if (nullptr != entry.node.impl) {
+      ok = (RCL_RET_OK == rcl_node_fini(&entry.node)) && ok;
+    }
+  }
+  printf(
+    "teardown               %10zu nodes %12" PRId64 " ms  rss %zu KiB\n",
+    nodes->size(), elapsed_ms(start), current_rss_kb());
+  return ok;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  soak_options_t options;
+  if (!parse_options(argc, argv, &options)) {
+    fprintf(
+      stderr,
+      "usage: %s [--nodes N] [--publishers-per-node N] [--subscriptions-per-node N]\n"
+      "          [--duration-seconds N] [--report-interval-seconds N]\n", argv[0]);
+    return 1;
+  }
+
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  rcl_ret_t ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  if (RCL_RET_OK != ret) {
+    fprintf(stderr, "failed to init options: %s\n", rcl_get_error_string().str);
+    return 1;
+  }
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  ret = rcl_init(argc, argv, &init_options, &context);
+  if (RCL_RET_OK != ret) {
+    fprintf(stderr, "failed to init rcl: %s\n", rcl_get_error_string().str);
+    return 1;
+  }
+
+  printf(
+    "soak: %zu nodes, %zu publishers/node, %zu subscriptions/node, %" PRId64 " s\n",
+    options.nodes, options.publishers_per_node, options.subscriptions_per_node,
+    options.duration_seconds);
+  printf("rss_at_start           %10zu KiB\n", current_rss_kb());
+
+  int result = 0;
+  std::vector<soak_node_t> nodes;
+  if (!create_nodes(&context, options, &nodes)) {
+    result = 1;
+  }
+  if (0 == result && !measure_discovery_convergence(options, &nodes)) {
+    result = 1;
+  }
+  if (0 == result && !run_soak(&context, options, &nodes)) {
+    result = 1;
+  }
+  if (!destroy_nodes(&nodes)) {
+    result = 1;
+  }
+  if (0 != result) {
+    fprintf(stderr, "soak failure: %s\n", rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+
+  ret = rcl_shutdown(&context);
+  if (RCL_RET_OK != ret) {
+    result = 1;
+  }
+  ret = rcl_context_fini(&context);
+  if (RCL_RET_OK != ret) {
+    result = 1;
+  }
+  ret = rcl_init_options_fini(&init_options);
+  if (RCL_RET_OK != ret) {
+    result = 1;
+  }
+  return result;
+}
@@ -323,6 +323,30 @@ TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_remove_ros_args
   }
 }
 
+TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_unparsed_view) {
+  const char * argv[] =
+  {"process_name", "-d", "__ns:=/foo/bar", "--foo=bar"};
+  int argc = sizeof(argv) / sizeof(const char *);
+
+  rcl_allocator_t alloc = rcl_get_default_allocator();
+  rcl_arguments_t parsed_args = rcl_get_zero_initialized_arguments();
+  rcl_ret_t ret;
+  ret = rcl_parse_arguments(argc, argv, alloc, &parsed_args);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  int unparsed_count = rcl_arguments_get_count_unparsed(&parsed_args);
+  ASSERT_EQ(3, unparsed_count);
+  const int * unparsed_indices = NULL;
+  ret = rcl_arguments_get_unparsed_view(&parsed_args, &unparsed_indices);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_TRUE(NULL != unparsed_indices);
+  EXPECT_EQ(0, unparsed_indices[0]);
+  EXPECT_EQ(1, unparsed_indices[1]);
+  EXPECT_EQ(3, unparsed_indices[2]);
+  // nothing was copied, so nothing is deallocated here
+  EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&parsed_args));
+}
+
 TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_remove_ros_args_zero) {
   const char * argv[] = {""};
   rcl_ret_t ret;
@@ -390,6 +414,28 @@ TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_param_argument_
   EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&parsed_args));
 }
 
+TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_param_argument_view) {
+  const char * argv[] = {
+    "process_name", "__ns:=/namespace", "random:=arg", "__params:=parameter_filepath"
+  };
+  int argc = sizeof(argv) / sizeof(const char *);
+  rcl_ret_t ret;
+
+  rcl_allocator_t alloc = rcl_get_default_allocator();
+  rcl_arguments_t parsed_args = rcl_get_zero_initialized_arguments();
+
+  ret = rcl_parse_arguments(argc, argv, alloc, &parsed_args);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  const char * const * parameter_files = NULL;
+  ret = rcl_arguments_get_param_files_view(&parsed_args, &parameter_files);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_TRUE(NULL != parameter_files);
+  EXPECT_STREQ("parameter_filepath", parameter_files[0]);
+  // nothing was copied, so nothing is deallocated here
+  EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&parsed_args));
+}
+
 TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_param_argument_multiple) {
   const char * argv[] = {
     "process_name", "__params:=parameter_filepath1", "__ns:=/namespace",
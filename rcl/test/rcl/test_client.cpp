@@ -100,6 +100,55 @@ TEST_F(TestClientFixture, test_client_nominal) {
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
 }
 
+/* Basic test of the pipelined request functions.
+ */
+TEST_F(TestClientFixture, test_client_pipelined) {
+  rcl_ret_t ret;
+  rcl_client_t client = rcl_get_zero_initialized_client();
+
+  const char * topic_name = "add_two_ints";
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  client_options.max_pending_requests = 4;
+
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, BasicTypes);
+  ret = rcl_client_init(&client, this->node_ptr, ts, topic_name, &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_client_fini(&client, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  test_msgs__srv__BasicTypes_Request req;
+  test_msgs__srv__BasicTypes_Request__init(&req);
+  req.uint8_value = 1;
+
+  // A pipelined send with a cookie and no deadline should succeed.
+  int cookie = 0;
+  int64_t sequence_number = 0;
+  ret = rcl_send_request_pipelined(&client, &req, &cookie, 0, &sequence_number);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(sequence_number, 1);
+
+  // A request with an already expired deadline is reported as timed out.
+  ret = rcl_send_request_pipelined(&client, &req, &cookie, 1, &sequence_number);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  test_msgs__srv__BasicTypes_Response res;
+  test_msgs__srv__BasicTypes_Response__init(&res);
+  void * responses[4] = {&res, &res, &res, &res};
+  rcl_client_response_info_t infos[4];
+  size_t count = 0;
+  ret = rcl_client_take_ready_responses(&client, 4, responses, infos, &count);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // No service is running, so the only entry is the expired request.
+  ASSERT_EQ(1u, count);
+  EXPECT_EQ(sequence_number, infos[0].sequence_number);
+  EXPECT_EQ(&cookie, infos[0].user_cookie);
+  EXPECT_TRUE(infos[0].timed_out);
+}
+
 
 /* Testing the client init and fini functions.
  */
@@ -19,6 +19,7 @@
 #include "rcl/context.h"
 #include "rcl/error_handling.h"
 #include "rcl/init.h"
+#include "rcl/reclamation.h"
 
 #ifdef RMW_IMPLEMENTATION
 # define CLASSNAME_(NAME, SUFFIX) NAME ## __ ## SUFFIX
@@ -115,3 +116,138 @@ TEST_F(CLASSNAME(TestContextFixture, RMW_IMPLEMENTATION), nominal) {
   ret = rcl_init_options_fini(&init_options);
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
 }
+
+// Test the context event counters API.
+TEST_F(CLASSNAME(TestContextFixture, RMW_IMPLEMENTATION), counters) {
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  rcl_context_counters_t counters;
+
+  // invalid arguments
+  rcl_ret_t ret = rcl_context_set_counters_enabled(nullptr, true);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+  ret = rcl_context_set_counters_enabled(&context, true);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);  // zero-initialized
+  rcl_reset_error();
+  ret = rcl_context_get_counters(&context, &counters);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);  // zero-initialized
+  rcl_reset_error();
+
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  ASSERT_EQ(ret, RCL_RET_OK);
+  ret = rcl_init(0, nullptr, &init_options, &context);
+  ASSERT_EQ(ret, RCL_RET_OK);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ret = rcl_shutdown(&context);
+    EXPECT_EQ(ret, RCL_RET_OK);
+    ret = rcl_context_fini(&context);
+    EXPECT_EQ(ret, RCL_RET_OK);
+  });
+
+  ret = rcl_context_get_counters(&context, nullptr);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+
+  // counters read as zero before being enabled
+  ret = rcl_context_get_counters(&context, &counters);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_EQ(counters.messages_published, 0UL);
+  EXPECT_EQ(counters.messages_taken, 0UL);
+  EXPECT_EQ(counters.wait_cycles, 0UL);
+  EXPECT_EQ(counters.timer_calls, 0UL);
+  EXPECT_EQ(counters.serialized_bytes, 0UL);
+
+  ret = rcl_context_set_counters_enabled(&context, true);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_context_set_counters_enabled(&context, false);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  ret = rcl_init_options_fini(&init_options);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
+
+static rcl_ret_t
+counting_finalizer(void * object, void * finalize_context)
+{
+  (void)object;
+  ++(*static_cast<int *>(finalize_context));
+  return RCL_RET_OK;
+}
+
+// Test the epoch based reclamation API.
+TEST_F(CLASSNAME(TestContextFixture, RMW_IMPLEMENTATION), reclamation) {
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  size_t slot_a = 0;
+
+  // invalid arguments
+  rcl_ret_t ret = rcl_reclamation_register_thread(nullptr, &slot_a);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+  ret = rcl_reclamation_register_thread(&context, &slot_a);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);  // zero-initialized
+  rcl_reset_error();
+
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  ASSERT_EQ(ret, RCL_RET_OK);
+  ret = rcl_init(0, nullptr, &init_options, &context);
+  ASSERT_EQ(ret, RCL_RET_OK);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ret = rcl_shutdown(&context);
+    EXPECT_EQ(ret, RCL_RET_OK);
+    ret = rcl_context_fini(&context);
+    EXPECT_EQ(ret, RCL_RET_OK);
+  });
+
+  // quiescent before any registration fails, the domain does not exist yet
+  ret = rcl_reclamation_quiescent(&context, 0u);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+
+  size_t slot_b = 0;
+  ret = rcl_reclamation_register_thread(&context, &slot_a);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_reclamation_register_thread(&context, &slot_b);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_NE(slot_a, slot_b);
+
+  int finalized = 0;
+  int dummy_object = 0;
+  ret = rcl_reclamation_retire(&context, &dummy_object, &finalized, counting_finalizer);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  // One thread passing its quiescent point is not enough...
+  ret = rcl_reclamation_quiescent(&context, slot_a);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_EQ(0, finalized);
+  // ...both passing it is.
+  ret = rcl_reclamation_quiescent(&context, slot_b);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_EQ(1, finalized);
+
+  // An unregistered slot neither blocks reclamation nor stays usable.
+  ret = rcl_reclamation_unregister_thread(&context, slot_b);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_reclamation_quiescent(&context, slot_b);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+  ret = rcl_reclamation_retire(&context, &dummy_object, &finalized, counting_finalizer);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_reclamation_quiescent(&context, slot_a);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_EQ(2, finalized);
+
+  // Drain reclaims unconditionally, for shutdown paths.
+  ret = rcl_reclamation_retire(&context, &dummy_object, &finalized, counting_finalizer);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_EQ(2, finalized);
+  ret = rcl_reclamation_drain(&context);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_EQ(3, finalized);
+
+  ret = rcl_reclamation_unregister_thread(&context, slot_a);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_init_options_fini(&init_options);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
@@ -0,0 +1,89 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+#include "rcl/error_handling.h"
+
+#ifdef RMW_IMPLEMENTATION
+# define CLASSNAME_(NAME, SUFFIX) NAME ## __ ## SUFFIX
+# define CLASSNAME(NAME, SUFFIX) CLASSNAME_(NAME, SUFFIX)
+#else
+# define CLASSNAME(NAME, SUFFIX) NAME
+#endif
+
+TEST(CLASSNAME(TestErrorHandling, RMW_IMPLEMENTATION), test_deferred_formatting) {
+  rcl_reset_error();
+  RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("code %d for '%s' at index %zu", 42, "foo", (size_t)7);
+  // the message is captured but not formatted yet
+  EXPECT_TRUE(rcl_error_state_is_deferred());
+  EXPECT_TRUE(rcl_error_is_set());
+  std::string msg = rcl_get_error_string().str;
+  EXPECT_EQ("code 42 for 'foo' at index 7", msg);
+  // reading the error materialized it
+  EXPECT_FALSE(rcl_error_state_is_deferred());
+  EXPECT_TRUE(rcl_error_is_set());
+  rcl_reset_error();
+}
+
+TEST(CLASSNAME(TestErrorHandling, RMW_IMPLEMENTATION), test_deferred_string_copied) {
+  rcl_reset_error();
+  char scratch[32];
+  snprintf(scratch, sizeof(scratch), "transient");
+  RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("value was '%s'", scratch);
+  // string arguments are captured by copy, so clobbering the source is fine
+  snprintf(scratch, sizeof(scratch), "clobbered");
+  EXPECT_EQ("value was 'transient'", std::string(rcl_get_error_string().str));
+  rcl_reset_error();
+}
+
+TEST(CLASSNAME(TestErrorHandling, RMW_IMPLEMENTATION), test_deferred_reset_without_read) {
+  rcl_reset_error();
+  RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("never read, code %d", 1);
+  EXPECT_TRUE(rcl_error_is_set());
+  rcl_reset_error();
+  EXPECT_FALSE(rcl_error_is_set());
+  EXPECT_FALSE(rcl_error_state_is_deferred());
+}
+
+TEST(CLASSNAME(TestErrorHandling, RMW_IMPLEMENTATION), test_deferred_replaced_by_eager) {
+  rcl_reset_error();
+  RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("older, code %d", 1);
+  // an error set eagerly afterwards wins over the pending deferred one
+  RCL_SET_ERROR_MSG("newer");
+  EXPECT_EQ("newer", std::string(rcl_get_error_string().str));
+  EXPECT_FALSE(rcl_error_state_is_deferred());
+  rcl_reset_error();
+}
+
+TEST(CLASSNAME(TestErrorHandling, RMW_IMPLEMENTATION), test_unsupported_formats_eagerly) {
+  rcl_reset_error();
+  // runtime field widths cannot be captured, so this formats immediately
+  RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("%*d", 5, 42);
+  EXPECT_FALSE(rcl_error_state_is_deferred());
+  EXPECT_TRUE(rcl_error_is_set());
+  EXPECT_EQ("   42", std::string(rcl_get_error_string().str));
+  rcl_reset_error();
+}
+
+TEST(CLASSNAME(TestErrorHandling, RMW_IMPLEMENTATION), test_deferred_conversions) {
+  rcl_reset_error();
+  RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+    "100%% sure: %x %03ld %c %.1f", 255u, 7l, 'y', 0.5);
+  EXPECT_EQ("100% sure: ff 007 y 0.5", std::string(rcl_get_error_string().str));
+  rcl_reset_error();
+}
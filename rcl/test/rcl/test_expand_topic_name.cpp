@@ -198,6 +198,71 @@ TEST(test_expand_topic_name, unknown_substitution) {
   }
 }
 
+TEST(test_expand_topic_name, with_buffer) {
+  rcl_ret_t ret;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcutils_string_map_t subs = rcutils_get_zero_initialized_string_map();
+  rcutils_ret_t rcu_ret = rcutils_string_map_init(&subs, 0, allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, rcu_ret);
+  ret = rcl_get_default_topic_name_substitutions(&subs);
+  ASSERT_EQ(RCL_RET_OK, ret);
+
+  const char * topic = "{node}/chatter";
+  const char * ns = "/my_ns";
+  const char * node = "my_node";
+  std::string expected = std::string(ns) + "/" + node + "/chatter";
+
+  // large enough buffer
+  {
+    char buffer[256];
+    size_t required_size = 0;
+    ret = rcl_expand_topic_name_with_buffer(
+      topic, node, ns, &subs, buffer, sizeof(buffer), &required_size);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_STREQ(expected.c_str(), buffer);
+    EXPECT_EQ(expected.size() + 1, required_size);
+  }
+
+  // too small buffer, reports the required size without writing
+  {
+    char buffer[4];
+    size_t required_size = 0;
+    ret = rcl_expand_topic_name_with_buffer(
+      topic, node, ns, &subs, buffer, sizeof(buffer), &required_size);
+    EXPECT_EQ(RCL_RET_ERROR, ret);
+    rcl_reset_error();
+    EXPECT_EQ(expected.size() + 1, required_size);
+  }
+
+  // exactly fitting buffer
+  {
+    char buffer[256];
+    size_t required_size = 0;
+    ret = rcl_expand_topic_name_with_buffer(
+      topic, node, ns, &subs, buffer, expected.size() + 1, &required_size);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_STREQ(expected.c_str(), buffer);
+  }
+
+  // pass null for buffer
+  {
+    size_t required_size = 0;
+    ret = rcl_expand_topic_name_with_buffer(
+      topic, node, ns, &subs, NULL, 0, &required_size);
+    EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+    rcl_reset_error();
+  }
+
+  // pass null for required_size
+  {
+    char buffer[256];
+    ret = rcl_expand_topic_name_with_buffer(
+      topic, node, ns, &subs, buffer, sizeof(buffer), NULL);
+    EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+    rcl_reset_error();
+  }
+}
+
 TEST(test_expand_topic_name, custom_substitution) {
   rcl_ret_t ret;
   rcl_allocator_t allocator = rcl_get_default_allocator();
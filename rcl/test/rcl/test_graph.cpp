@@ -34,6 +34,8 @@
 
 #include "rcutils/logging_macros.h"
 #include "rcutils/logging.h"
+#include "rcutils/strdup.h"
+#include "rcutils/types/string_array.h"
 
 #include "test_msgs/msg/basic_types.h"
 #include "test_msgs/srv/basic_types.h"
@@ -175,6 +177,114 @@ TEST_F(
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
 }
 
+/* Test the rcl_names_and_types_copy function.
+ */
+TEST_F(
+  CLASSNAME(TestGraphFixture, RMW_IMPLEMENTATION),
+  test_rcl_names_and_types_copy
+) {
+  rcl_ret_t ret;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_names_and_types_t src {};
+  rcl_names_and_types_t dst {};
+  // invalid arguments
+  ret = rcl_names_and_types_copy(nullptr, &dst, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_names_and_types_copy(&src, nullptr, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_names_and_types_copy(&src, &dst, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  // populate a source and copy it
+  ret = rcl_get_topic_names_and_types(this->node_ptr, &allocator, false, &src);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_names_and_types_copy(&src, &dst, &allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(src.names.size, dst.names.size);
+  for (size_t i = 0; i < src.names.size; ++i) {
+    EXPECT_STREQ(src.names.data[i], dst.names.data[i]);
+  }
+  // an equal re-copy must leave the destination's storage untouched
+  char ** previous_data = dst.names.data;
+  ret = rcl_names_and_types_copy(&src, &dst, &allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(previous_data, dst.names.data);
+  ret = rcl_names_and_types_fini(&src);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_names_and_types_fini(&dst);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
+
+/* Test the rcl_names_and_types_sort and rcl_names_and_types_find functions.
+ */
+TEST_F(
+  CLASSNAME(TestGraphFixture, RMW_IMPLEMENTATION),
+  test_rcl_names_and_types_sort_and_find
+) {
+  rcl_ret_t ret;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_names_and_types_t nat {};
+  bool found = false;
+  size_t index = 0;
+  // invalid arguments
+  ret = rcl_names_and_types_sort(nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_names_and_types_find(nullptr, "/a", &found, &index);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_names_and_types_find(&nat, nullptr, &found, &index);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_names_and_types_find(&nat, "/a", nullptr, &index);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  // empty struct: sorting is a no-op and nothing is found
+  ret = rcl_names_and_types_sort(&nat);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_names_and_types_find(&nat, "/a", &found, &index);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_FALSE(found);
+  // build a struct in reverse order and sort it
+  const char * unsorted_names[] = {"/c", "/a", "/b"};
+  ret = rcl_names_and_types_init(&nat, 3, &allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  for (size_t i = 0; i < 3; ++i) {
+    nat.names.data[i] = rcutils_strdup(unsorted_names[i], allocator);
+    ASSERT_NE(nullptr, nat.names.data[i]);
+    ASSERT_EQ(
+      RCUTILS_RET_OK, rcutils_string_array_init(&nat.types[i], 1, &allocator));
+    nat.types[i].data[0] = rcutils_strdup(unsorted_names[i], allocator);
+    ASSERT_NE(nullptr, nat.types[i].data[0]);
+  }
+  ret = rcl_names_and_types_sort(&nat);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_STREQ("/a", nat.names.data[0]);
+  EXPECT_STREQ("/b", nat.names.data[1]);
+  EXPECT_STREQ("/c", nat.names.data[2]);
+  // the types moved together with their names
+  EXPECT_STREQ("/a", nat.types[0].data[0]);
+  EXPECT_STREQ("/c", nat.types[2].data[0]);
+  // every name is found at its position, absent names are not
+  for (size_t i = 0; i < 3; ++i) {
+    ret = rcl_names_and_types_find(&nat, nat.names.data[i], &found, &index);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_TRUE(found);
+    EXPECT_EQ(i, index);
+  }
+  ret = rcl_names_and_types_find(&nat, "/missing", &found, &index);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_FALSE(found);
+  // a null index is allowed for pure membership tests
+  ret = rcl_names_and_types_find(&nat, "/b", &found, nullptr);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_TRUE(found);
+  ret = rcl_names_and_types_fini(&nat);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
+
 /* Test the rcl_get_service_names_and_types function.
  *
  * This does not test content of the rcl_names_and_types_t structure.
@@ -1211,3 +1321,157 @@ TEST_F(CLASSNAME(TestGraphFixture, RMW_IMPLEMENTATION), test_rcl_service_server_
   wait_for_service_state_to_change(false, is_available);
   ASSERT_FALSE(is_available);
 }
+
+/* Test the wait-for-matched-endpoints helpers.
+ */
+TEST_F(
+  CLASSNAME(TestGraphFixture, RMW_IMPLEMENTATION),
+  test_rcl_wait_for_matched_endpoints) {
+  rcl_ret_t ret;
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const char * topic_name = "/topic_test_rcl_wait_for_matched_endpoints";
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic_name, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // Invalid node and entity handles are rejected.
+  ret = rcl_publisher_wait_for_subscribers(nullptr, &publisher, 1u, 0);
+  EXPECT_EQ(RCL_RET_NODE_INVALID, ret);
+  rcl_reset_error();
+  ret = rcl_publisher_wait_for_subscribers(this->node_ptr, nullptr, 1u, 0);
+  EXPECT_EQ(RCL_RET_PUBLISHER_INVALID, ret);
+  rcl_reset_error();
+  ret = rcl_subscription_wait_for_publishers(this->node_ptr, nullptr, 1u, 0);
+  EXPECT_EQ(RCL_RET_SUBSCRIPTION_INVALID, ret);
+  rcl_reset_error();
+
+  // An already satisfied count returns without waiting.
+  ret = rcl_publisher_wait_for_subscribers(this->node_ptr, &publisher, 0u, 0);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // With no subscriber a zero timeout is a non-blocking check.
+  ret = rcl_publisher_wait_for_subscribers(this->node_ptr, &publisher, 1u, 0);
+  EXPECT_EQ(RCL_RET_TIMEOUT, ret);
+  rcl_reset_error();
+
+  {
+    rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+    rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+    ret = rcl_subscription_init(
+      &subscription, this->node_ptr, ts, topic_name, &subscription_options);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+      rcl_ret_t ret = rcl_subscription_fini(&subscription, this->node_ptr);
+      EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    });
+    // Both sides see the match once the graph settles.
+    ret = rcl_publisher_wait_for_subscribers(
+      this->node_ptr, &publisher, 1u, RCL_S_TO_NS(10));
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_subscription_wait_for_publishers(
+      this->node_ptr, &subscription, 1u, RCL_S_TO_NS(10));
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+}
+
+/* Test the namespace subtree queries served from the graph cache.
+ */
+TEST_F(
+  CLASSNAME(TestGraphFixture, RMW_IMPLEMENTATION),
+  test_rcl_namespace_subtree_queries) {
+  rcl_ret_t ret;
+  rcutils_string_array_t node_names = rcutils_get_zero_initialized_string_array();
+  rcutils_string_array_t node_namespaces = rcutils_get_zero_initialized_string_array();
+
+  // Invalid arguments are rejected.
+  ret = rcl_get_nodes_in_namespace(nullptr, "/", &node_names, &node_namespaces);
+  EXPECT_EQ(RCL_RET_NODE_INVALID, ret);
+  rcl_reset_error();
+  ret = rcl_get_nodes_in_namespace(this->node_ptr, nullptr, &node_names, &node_namespaces);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_get_nodes_in_namespace(this->node_ptr, "/", nullptr, &node_namespaces);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  // A relative namespace is rejected.
+  ret = rcl_get_nodes_in_namespace(this->node_ptr, "relative", &node_names, &node_namespaces);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // The root subtree contains this fixture's node.
+  ret = rcl_get_nodes_in_namespace(this->node_ptr, "/", &node_names, &node_namespaces);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(node_names.size, node_namespaces.size);
+  bool found = false;
+  for (size_t i = 0; i < node_names.size; ++i) {
+    if (0 == strcmp(node_names.data[i], this->test_graph_node_name)) {
+      found = true;
+    }
+  }
+  EXPECT_TRUE(found);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&node_names));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&node_namespaces));
+
+  // A subtree nothing lives under is empty, not an error.
+  node_names = rcutils_get_zero_initialized_string_array();
+  node_namespaces = rcutils_get_zero_initialized_string_array();
+  ret = rcl_get_nodes_in_namespace(
+    this->node_ptr, "/test_rcl_namespace_subtree_queries", &node_names, &node_namespaces);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, node_names.size);
+  EXPECT_EQ(0u, node_namespaces.size);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&node_names));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&node_namespaces));
+
+  // Topic side: a publisher deep in a namespace is found under its subtree
+  // but not under a sibling namespace sharing the prefix string.
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const char * topic_name = "/fleet_subtree_test/robot7/chatter";
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic_name, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  std::string topic_name_string(topic_name);
+  check_graph_state(
+    this->node_ptr,
+    this->wait_set_ptr,
+    rcl_node_get_graph_guard_condition(this->node_ptr),
+    topic_name_string,
+    1,    // expected publishers on topic
+    0,    // expected subscribers on topic
+    true,    // topic expected in graph
+    9);    // number of retries
+  // The snapshot may predate the publisher; drop it like the graph guard
+  // condition handler would.
+  ret = rcl_graph_cache_invalidate(this->context_ptr);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_names_and_types_t tnat = rcl_get_zero_initialized_names_and_types();
+  ret = rcl_get_topic_names_and_types_in_namespace(
+    this->node_ptr, "/fleet_subtree_test/robot7", &tnat);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(1u, tnat.names.size);
+  EXPECT_STREQ(topic_name, tnat.names.data[0]);
+  EXPECT_LT(0u, tnat.types[0].size);
+  ret = rcl_names_and_types_fini(&tnat);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  tnat = rcl_get_zero_initialized_names_and_types();
+  ret = rcl_get_topic_names_and_types_in_namespace(
+    this->node_ptr, "/fleet_subtree_test/robot77", &tnat);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, tnat.names.size);
+  ret = rcl_names_and_types_fini(&tnat);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
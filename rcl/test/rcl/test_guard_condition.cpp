@@ -208,3 +208,131 @@ TEST_F(
   EXPECT_EQ(RCL_RET_OK, ret);
   rcl_reset_error();
 }
+
+/* Tests the multiplexed guard condition trigger and take round trip.
+ */
+TEST_F(
+  CLASSNAME(TestGuardConditionFixture, RMW_IMPLEMENTATION), test_rcl_guard_condition_mux) {
+  rcl_ret_t ret;
+
+  // Initialize rcl with rcl_init().
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+  });
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  ret = rcl_init(0, nullptr, &init_options, &context);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ASSERT_EQ(RCL_RET_OK, rcl_shutdown(&context)) << rcl_get_error_string().str;
+    ASSERT_EQ(RCL_RET_OK, rcl_context_fini(&context)) << rcl_get_error_string().str;
+  });
+
+  rcl_guard_condition_mux_t mux = rcl_get_zero_initialized_guard_condition_mux();
+  ret = rcl_guard_condition_mux_init(
+    &mux, &context, 100, rcl_guard_condition_get_default_options());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_mux_fini(&mux)) << rcl_get_error_string().str;
+  });
+
+  EXPECT_NE(nullptr, rcl_guard_condition_mux_get_guard_condition(&mux));
+
+  // Out of range index is rejected.
+  ret = rcl_guard_condition_mux_trigger(&mux, 100);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_guard_condition_mux_trigger(&mux, 3);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_guard_condition_mux_trigger(&mux, 64);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  uint64_t fired_bits[2] = {0, 0};
+  // Too small an output array is rejected.
+  ret = rcl_guard_condition_mux_take_fired(&mux, fired_bits, 1);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_guard_condition_mux_take_fired(&mux, fired_bits, 2);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(uint64_t(1) << 3, fired_bits[0]);
+  EXPECT_EQ(uint64_t(1), fired_bits[1]);
+
+  // The take consumed the fired state.
+  ret = rcl_guard_condition_mux_take_fired(&mux, fired_bits, 2);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(uint64_t(0), fired_bits[0]);
+  EXPECT_EQ(uint64_t(0), fired_bits[1]);
+}
+
+/* Tests the payload-carrying trigger and take round trip.
+ */
+TEST_F(
+  CLASSNAME(TestGuardConditionFixture, RMW_IMPLEMENTATION),
+  test_rcl_guard_condition_payload) {
+  rcl_ret_t ret;
+
+  // Initialize rcl with rcl_init().
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+  });
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  ret = rcl_init(0, nullptr, &init_options, &context);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ASSERT_EQ(RCL_RET_OK, rcl_shutdown(&context)) << rcl_get_error_string().str;
+    ASSERT_EQ(RCL_RET_OK, rcl_context_fini(&context)) << rcl_get_error_string().str;
+  });
+
+  uint64_t payload = 0;
+  // Invalid guard condition arguments are rejected.
+  ret = rcl_trigger_guard_condition_with_payload(nullptr, 42);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_guard_condition_take_payload(nullptr, &payload);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_condition, &context, rcl_guard_condition_get_default_options());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&guard_condition)) <<
+      rcl_get_error_string().str;
+  });
+
+  ret = rcl_guard_condition_take_payload(&guard_condition, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // The slot starts out empty.
+  ret = rcl_guard_condition_take_payload(&guard_condition, &payload);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(uint64_t(0), payload);
+
+  // A payload-carrying trigger deposits the value; the take consumes it.
+  ret = rcl_trigger_guard_condition_with_payload(&guard_condition, 42);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_guard_condition_take_payload(&guard_condition, &payload);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(uint64_t(42), payload);
+  ret = rcl_guard_condition_take_payload(&guard_condition, &payload);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(uint64_t(0), payload);
+
+  // The slot is last-writer-wins when triggers outpace takes.
+  ret = rcl_trigger_guard_condition_with_payload(&guard_condition, 1);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_trigger_guard_condition_with_payload(&guard_condition, 2);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_guard_condition_take_payload(&guard_condition, &payload);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(uint64_t(2), payload);
+}
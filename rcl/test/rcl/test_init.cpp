@@ -206,6 +206,53 @@ TEST_F(CLASSNAME(TestRCLFixture, RMW_IMPLEMENTATION), test_rcl_init_and_ok_and_s
   });
 }
 
+/* Tests the rcl_init_from_context() function.
+ */
+TEST_F(CLASSNAME(TestRCLFixture, RMW_IMPLEMENTATION), test_rcl_init_from_context) {
+  rcl_ret_t ret;
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+  });
+  rcl_context_t src_context = rcl_get_zero_initialized_context();
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  // Cloning from a zero initialized source context should be an invalid argument.
+  ret = rcl_init_from_context(&src_context, &context);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ASSERT_FALSE(rcl_context_is_valid(&context));
+  {
+    FakeTestArgv test_args;
+    ret = rcl_init(test_args.argc, test_args.argv, &init_options, &src_context);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ASSERT_TRUE(rcl_context_is_valid(&src_context));
+  }
+  // Cloning from a valid source context should succeed and give a new instance id.
+  ret = rcl_init_from_context(&src_context, &context);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_TRUE(rcl_context_is_valid(&context));
+  EXPECT_NE(rcl_context_get_instance_id(&src_context), rcl_context_get_instance_id(&context));
+  // Cloning into an already initialized context should fail.
+  ret = rcl_init_from_context(&src_context, &context);
+  EXPECT_EQ(RCL_RET_ALREADY_INIT, ret);
+  rcl_reset_error();
+  ASSERT_TRUE(rcl_context_is_valid(&context));
+  // Both contexts shut down independently.
+  ret = rcl_shutdown(&src_context);
+  EXPECT_EQ(RCL_RET_OK, ret);
+  ASSERT_FALSE(rcl_context_is_valid(&src_context));
+  ASSERT_TRUE(rcl_context_is_valid(&context));
+  ret = rcl_context_fini(&src_context);
+  EXPECT_EQ(RCL_RET_OK, ret);
+  ret = rcl_shutdown(&context);
+  EXPECT_EQ(RCL_RET_OK, ret);
+  ASSERT_FALSE(rcl_context_is_valid(&context));
+  ret = rcl_context_fini(&context);
+  EXPECT_EQ(RCL_RET_OK, ret);
+}
+
 /* Tests the rcl_get_instance_id() and rcl_ok() functions.
  */
 TEST_F(CLASSNAME(TestRCLFixture, RMW_IMPLEMENTATION), test_rcl_get_instance_id_and_ok) {
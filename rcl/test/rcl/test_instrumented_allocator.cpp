@@ -0,0 +1,82 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "rcl/instrumented_allocator.h"
+
+#include "rcl/error_handling.h"
+
+#ifdef RMW_IMPLEMENTATION
+# define CLASSNAME_(NAME, SUFFIX) NAME ## __ ## SUFFIX
+# define CLASSNAME(NAME, SUFFIX) CLASSNAME_(NAME, SUFFIX)
+#else
+# define CLASSNAME(NAME, SUFFIX) NAME
+#endif
+
+/* Tests that the instrumented allocator counts calls and bytes per tag.
+ */
+TEST(CLASSNAME(TestInstrumentedAllocator, RMW_IMPLEMENTATION), test_counting) {
+  rcl_allocator_t base_allocator = rcl_get_default_allocator();
+  rcl_allocator_stats_t stats = rcl_get_zero_initialized_allocator_stats();
+  stats.tag = "test";
+  rcl_allocator_t allocator = rcl_get_instrumented_allocator(&base_allocator, &stats);
+  ASSERT_NE(nullptr, allocator.allocate);
+
+  void * first = allocator.allocate(100, allocator.state);
+  ASSERT_NE(nullptr, first);
+  EXPECT_EQ(1u, stats.allocation_count);
+  EXPECT_EQ(100u, stats.total_bytes_allocated);
+  EXPECT_EQ(100u, stats.bytes_in_use);
+  EXPECT_EQ(100u, stats.peak_bytes_in_use);
+
+  void * second = allocator.zero_allocate(10, 5, allocator.state);
+  ASSERT_NE(nullptr, second);
+  for (size_t i = 0; i < 50; ++i) {
+    EXPECT_EQ(0, reinterpret_cast<unsigned char *>(second)[i]);
+  }
+  EXPECT_EQ(2u, stats.allocation_count);
+  EXPECT_EQ(150u, stats.total_bytes_allocated);
+  EXPECT_EQ(150u, stats.bytes_in_use);
+  EXPECT_EQ(150u, stats.peak_bytes_in_use);
+
+  // Growing keeps the byte accounting exact.
+  first = allocator.reallocate(first, 200, allocator.state);
+  ASSERT_NE(nullptr, first);
+  EXPECT_EQ(250u, stats.total_bytes_allocated);
+  EXPECT_EQ(250u, stats.bytes_in_use);
+  EXPECT_EQ(250u, stats.peak_bytes_in_use);
+
+  // Shrinking lowers bytes in use but not the peak.
+  first = allocator.reallocate(first, 50, allocator.state);
+  ASSERT_NE(nullptr, first);
+  EXPECT_EQ(100u, stats.bytes_in_use);
+  EXPECT_EQ(250u, stats.peak_bytes_in_use);
+
+  allocator.deallocate(first, allocator.state);
+  allocator.deallocate(second, allocator.state);
+  EXPECT_EQ(2u, stats.deallocation_count);
+  EXPECT_EQ(0u, stats.bytes_in_use);
+  EXPECT_EQ(250u, stats.peak_bytes_in_use);
+
+  // Deallocating a null pointer is not counted.
+  allocator.deallocate(nullptr, allocator.state);
+  EXPECT_EQ(2u, stats.deallocation_count);
+
+  EXPECT_EQ(RCL_RET_OK, rcl_allocator_stats_report(&stats));
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_allocator_stats_report(nullptr));
+  rcl_reset_error();
+}
@@ -68,9 +68,8 @@ TEST_F(CLASSNAME(TestLexerLookaheadFixture, RMW_IMPLEMENTATION), test_init_fini_
 
 TEST_F(CLASSNAME(TestLexerLookaheadFixture, RMW_IMPLEMENTATION), test_init_not_zero_initialized)
 {
-  rcl_lexer_lookahead2_t buffer;
-  int not_zero = 1;
-  buffer.impl = reinterpret_cast<rcl_lexer_lookahead2_impl_t *>(&not_zero);
+  rcl_lexer_lookahead2_t buffer = rcl_get_zero_initialized_lexer_lookahead2();
+  buffer.initialized = true;
   rcl_ret_t ret = rcl_lexer_lookahead2_init(&buffer, "foobar", rcl_get_default_allocator());
   EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
   rcl_reset_error();
@@ -726,3 +726,149 @@ TEST_F(CLASSNAME(TestNodeFixture, RMW_IMPLEMENTATION), test_rcl_node_names) {
     EXPECT_EQ(RCL_RET_OK, ret);
   }
 }
+
+/* Tests that nodes in one context share a single graph guard condition.
+ */
+TEST_F(CLASSNAME(TestNodeFixture, RMW_IMPLEMENTATION), test_rcl_node_shared_graph_guard_condition) {
+  rcl_ret_t ret;
+
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+  });
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  ret = rcl_init(0, nullptr, &init_options, &context);
+  ASSERT_EQ(RCL_RET_OK, ret);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ASSERT_EQ(RCL_RET_OK, rcl_shutdown(&context));
+    ASSERT_EQ(RCL_RET_OK, rcl_context_fini(&context));
+  });
+
+  rcl_node_options_t default_options = rcl_node_get_default_options();
+  rcl_node_t node1 = rcl_get_zero_initialized_node();
+  ret = rcl_node_init(&node1, "node1", "/ns", &context, &default_options);
+  ASSERT_EQ(RCL_RET_OK, ret);
+  rcl_node_t node2 = rcl_get_zero_initialized_node();
+  ret = rcl_node_init(&node2, "node2", "/ns", &context, &default_options);
+  ASSERT_EQ(RCL_RET_OK, ret);
+
+  const rcl_guard_condition_t * graph_guard_condition1 =
+    rcl_node_get_graph_guard_condition(&node1);
+  const rcl_guard_condition_t * graph_guard_condition2 =
+    rcl_node_get_graph_guard_condition(&node2);
+  ASSERT_NE(nullptr, graph_guard_condition1);
+  // Both nodes observe the same graph, so they share one condition.
+  EXPECT_EQ(graph_guard_condition1, graph_guard_condition2);
+
+  // The shared condition survives finalizing one of the nodes.
+  ret = rcl_node_fini(&node1);
+  EXPECT_EQ(RCL_RET_OK, ret);
+  graph_guard_condition2 = rcl_node_get_graph_guard_condition(&node2);
+  EXPECT_EQ(graph_guard_condition1, graph_guard_condition2);
+
+  ret = rcl_node_fini(&node2);
+  EXPECT_EQ(RCL_RET_OK, ret);
+}
+
+/* Tests finalizing several nodes at once with rcl_nodes_fini().
+ */
+TEST_F(CLASSNAME(TestNodeFixture, RMW_IMPLEMENTATION), test_rcl_nodes_fini) {
+  rcl_ret_t ret;
+
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+  });
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  ret = rcl_init(0, nullptr, &init_options, &context);
+  ASSERT_EQ(RCL_RET_OK, ret);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ASSERT_EQ(RCL_RET_OK, rcl_shutdown(&context));
+    ASSERT_EQ(RCL_RET_OK, rcl_context_fini(&context));
+  });
+
+  ret = rcl_nodes_fini(nullptr, 0);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  rcl_node_options_t default_options = rcl_node_get_default_options();
+  rcl_node_t node1 = rcl_get_zero_initialized_node();
+  ret = rcl_node_init(&node1, "node1", "/ns", &context, &default_options);
+  ASSERT_EQ(RCL_RET_OK, ret);
+  rcl_node_t node2 = rcl_get_zero_initialized_node();
+  ret = rcl_node_init(&node2, "node2", "/ns", &context, &default_options);
+  ASSERT_EQ(RCL_RET_OK, ret);
+  // A zero initialized entry is ignored, as with rcl_node_fini().
+  rcl_node_t node3 = rcl_get_zero_initialized_node();
+
+  rcl_node_t * nodes[] = {&node1, &node2, &node3};
+  ret = rcl_nodes_fini(nodes, 3);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_FALSE(rcl_node_is_valid_except_context(&node1));
+  rcl_reset_error();
+  EXPECT_FALSE(rcl_node_is_valid_except_context(&node2));
+  rcl_reset_error();
+
+  // Finalizing again is ok.
+  ret = rcl_nodes_fini(nodes, 3);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
+
+/* Tests the rcl_node_get_resource_stats() accessor.
+ */
+TEST_F(CLASSNAME(TestNodeFixture, RMW_IMPLEMENTATION), test_rcl_node_resource_stats) {
+  rcl_ret_t ret;
+
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+  });
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  ret = rcl_init(0, nullptr, &init_options, &context);
+  ASSERT_EQ(RCL_RET_OK, ret);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ASSERT_EQ(RCL_RET_OK, rcl_shutdown(&context));
+    ASSERT_EQ(RCL_RET_OK, rcl_context_fini(&context));
+  });
+
+  rcl_node_resource_stats_t stats;
+
+  // invalid arguments
+  ret = rcl_node_get_resource_stats(nullptr, &stats);
+  EXPECT_EQ(RCL_RET_NODE_INVALID, ret);
+  rcl_reset_error();
+  rcl_node_t invalid_node = rcl_get_zero_initialized_node();
+  ret = rcl_node_get_resource_stats(&invalid_node, &stats);
+  EXPECT_EQ(RCL_RET_NODE_INVALID, ret);
+  rcl_reset_error();
+
+  rcl_node_options_t default_options = rcl_node_get_default_options();
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  ret = rcl_node_init(&node, "node", "/ns", &context, &default_options);
+  ASSERT_EQ(RCL_RET_OK, ret);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_node_fini(&node)) << rcl_get_error_string().str;
+  });
+
+  ret = rcl_node_get_resource_stats(&node, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_node_get_resource_stats(&node, &stats);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // no entities have been created on the node
+  EXPECT_EQ(0u, stats.num_publishers);
+  EXPECT_EQ(0u, stats.num_subscriptions);
+  EXPECT_EQ(0u, stats.num_clients);
+  EXPECT_EQ(0u, stats.num_services);
+  // the arena at least holds the impl struct and the name strings
+  EXPECT_GT(stats.impl_bytes, sizeof(void *));
+  // nothing has been published, so the rosout publisher is still lazy
+  EXPECT_FALSE(stats.rosout_publisher_created);
+}
@@ -173,6 +173,20 @@ TEST_F(CLASSNAME(TestRemapFixture, RMW_IMPLEMENTATION), relative_topic_name_rema
   rcl_get_default_allocator().deallocate(output, rcl_get_default_allocator().state);
 }
 
+TEST_F(CLASSNAME(TestRemapFixture, RMW_IMPLEMENTATION), earlier_relative_rule_before_fqn_rule) {
+  rcl_ret_t ret;
+  rcl_arguments_t global_arguments;
+  // Both rules match /ns/foo once expanded; the earlier (relative) rule wins.
+  SCOPE_ARGS(global_arguments, "process_name", "foo:=/first", "/ns/foo:=/second");
+
+  char * output = NULL;
+  ret = rcl_remap_topic_name(
+    NULL, &global_arguments, "/ns/foo", "NodeName", "/ns", rcl_get_default_allocator(), &output);
+  EXPECT_EQ(RCL_RET_OK, ret);
+  ASSERT_STREQ("/first", output);
+  rcl_get_default_allocator().deallocate(output, rcl_get_default_allocator().state);
+}
+
 TEST_F(CLASSNAME(TestRemapFixture, RMW_IMPLEMENTATION), nodename_prefix_topic_remap) {
   rcl_ret_t ret;
   rcl_arguments_t global_arguments;
@@ -150,6 +150,21 @@ TEST_F(TestGetSecureRoot, successScenarios_local_prefixMatch) {
   ASSERT_STREQ(root_path, secure_root);
 }
 
+TEST_F(TestGetSecureRoot, successScenarios_local_prefixMatch_repeated) {
+  putenv_wrapper(ROS_SECURITY_ROOT_DIRECTORY_VAR_NAME "=" TEST_RESOURCES_DIRECTORY);
+  putenv_wrapper(ROS_SECURITY_LOOKUP_TYPE_VAR_NAME "=MATCH_PREFIX");
+  secure_root = rcl_get_secure_root(TEST_NODE_NAME, TEST_NODE_NAMESPACE, &allocator);
+
+  /* Distinct node names under the same namespace; the second lookup is served
+   * from the directory manifest built by the first one. */
+  root_path = rcl_get_secure_root(TEST_NODE_NAME "_first_suffix",
+      TEST_NODE_NAMESPACE, &allocator);
+  ASSERT_STREQ(root_path, secure_root);
+  root_path = rcl_get_secure_root(TEST_NODE_NAME "_second_suffix",
+      TEST_NODE_NAMESPACE, &allocator);
+  ASSERT_STREQ(root_path, secure_root);
+}
+
 TEST_F(TestGetSecureRoot, successScenarios_root_exactMatch) {
   putenv_wrapper(ROS_SECURITY_ROOT_DIRECTORY_VAR_NAME "=" TEST_RESOURCES_DIRECTORY);
   putenv_wrapper(ROS_SECURITY_LOOKUP_TYPE_VAR_NAME "=MATCH_PREFIX");
@@ -221,3 +221,201 @@ TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_service_nominal)
   EXPECT_EQ(client_response.uint64_value, 3ULL);
   EXPECT_EQ(header.sequence_number, 1);
 }
+
+/* Testing the batched request take and response send.
+ */
+TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_service_batched) {
+  rcl_ret_t ret;
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, BasicTypes);
+  const char * topic = "primitives_batched";
+
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_service_fini(&service, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  ret = rcl_client_init(&client, this->node_ptr, ts, topic, &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_client_fini(&client, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+
+  // Send a burst of requests before the service looks at its queue.
+  const size_t burst = 2;
+  for (size_t i = 0; i < burst; ++i) {
+    test_msgs__srv__BasicTypes_Request client_request;
+    test_msgs__srv__BasicTypes_Request__init(&client_request);
+    client_request.bool_value = false;
+    client_request.uint8_value = 1;
+    client_request.uint32_value = static_cast<uint32_t>(i);
+    int64_t sequence_number;
+    ret = rcl_send_request(&client, &client_request, &sequence_number);
+    test_msgs__srv__BasicTypes_Request__fini(&client_request);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+
+  // Drain the burst, waiting until every request has arrived.
+  test_msgs__srv__BasicTypes_Request service_requests[burst];
+  rmw_request_id_t headers[burst];
+  void * request_ptrs[burst];
+  for (size_t i = 0; i < burst; ++i) {
+    test_msgs__srv__BasicTypes_Request__init(&service_requests[i]);
+    request_ptrs[i] = &service_requests[i];
+  }
+  size_t total_taken = 0;
+  while (total_taken < burst) {
+    bool success;
+    wait_for_service_to_be_ready(&service, context_ptr, 10, 100, success);
+    ASSERT_TRUE(success);
+    size_t taken = 0;
+    ret = rcl_take_requests(
+      &service, burst - total_taken, &headers[total_taken], &request_ptrs[total_taken], &taken);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    total_taken += taken;
+  }
+  EXPECT_EQ(burst, total_taken);
+
+  // Reply to the whole burst in one call.
+  test_msgs__srv__BasicTypes_Response service_responses[burst];
+  void * response_ptrs[burst];
+  for (size_t i = 0; i < burst; ++i) {
+    test_msgs__srv__BasicTypes_Response__init(&service_responses[i]);
+    service_responses[i].uint64_value =
+      service_requests[i].uint8_value + service_requests[i].uint32_value;
+    response_ptrs[i] = &service_responses[i];
+  }
+  size_t sent = 0;
+  ret = rcl_send_responses(&service, burst, headers, response_ptrs, &sent);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(burst, sent);
+  for (size_t i = 0; i < burst; ++i) {
+    test_msgs__srv__BasicTypes_Request__fini(&service_requests[i]);
+    test_msgs__srv__BasicTypes_Response__fini(&service_responses[i]);
+  }
+
+  // The client gets one response per request.
+  for (size_t i = 0; i < burst; ++i) {
+    test_msgs__srv__BasicTypes_Response client_response;
+    test_msgs__srv__BasicTypes_Response__init(&client_response);
+    rmw_request_id_t header;
+    ret = RCL_RET_CLIENT_TAKE_FAILED;
+    for (int attempt = 0; RCL_RET_CLIENT_TAKE_FAILED == ret && attempt < 10; ++attempt) {
+      rcl_reset_error();
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      ret = rcl_take_response(&client, &header, &client_response);
+    }
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    test_msgs__srv__BasicTypes_Response__fini(&client_response);
+  }
+}
+
+/* Testing the opt-in take-to-response latency statistics.
+ */
+TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_service_stats) {
+  rcl_ret_t ret;
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, BasicTypes);
+  const char * topic = "primitives_stats";
+
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_service_fini(&service, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  ret = rcl_client_init(&client, this->node_ptr, ts, topic, &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_client_fini(&client, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // The getter fails while stats are not enabled.
+  rcl_service_stats_t stats;
+  ret = rcl_service_get_stats(&service, &stats);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_service_enable_stats(&service, true);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_service_get_stats(&service, &stats);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, stats.request_count);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+
+  test_msgs__srv__BasicTypes_Request client_request;
+  test_msgs__srv__BasicTypes_Request__init(&client_request);
+  client_request.bool_value = false;
+  client_request.uint8_value = 1;
+  client_request.uint32_value = 2;
+  int64_t sequence_number;
+  ret = rcl_send_request(&client, &client_request, &sequence_number);
+  test_msgs__srv__BasicTypes_Request__fini(&client_request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  bool success;
+  wait_for_service_to_be_ready(&service, context_ptr, 10, 100, success);
+  ASSERT_TRUE(success);
+  {
+    test_msgs__srv__BasicTypes_Response service_response;
+    test_msgs__srv__BasicTypes_Response__init(&service_response);
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+      test_msgs__srv__BasicTypes_Response__fini(&service_response);
+    });
+    test_msgs__srv__BasicTypes_Request service_request;
+    test_msgs__srv__BasicTypes_Request__init(&service_request);
+    rmw_request_id_t header;
+    ret = rcl_take_request(&service, &header, &service_request);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+    // The taken request is in flight until the response goes out.
+    ret = rcl_service_get_stats(&service, &stats);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(1u, stats.current_inflight);
+    EXPECT_EQ(1u, stats.max_inflight);
+    EXPECT_EQ(0u, stats.request_count);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ret = rcl_send_response(&service, &header, &service_response);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+
+  ret = rcl_service_get_stats(&service, &stats);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(1u, stats.request_count);
+  EXPECT_EQ(0u, stats.current_inflight);
+  EXPECT_EQ(0u, stats.uncorrelated_responses);
+  EXPECT_EQ(0u, stats.dropped_correlations);
+  // The handler slept 10 ms, so the latency must be at least that.
+  EXPECT_GE(stats.last_latency, RCL_MS_TO_NS(10ull));
+  EXPECT_EQ(stats.last_latency, stats.min_latency);
+  EXPECT_EQ(stats.last_latency, stats.max_latency);
+  EXPECT_EQ(stats.last_latency, stats.total_latency);
+  uint64_t histogram_total = 0;
+  for (size_t i = 0; i < RCL_SERVICE_STATS_LATENCY_BUCKETS; ++i) {
+    histogram_total += stats.latency_histogram[i];
+  }
+  EXPECT_EQ(1u, histogram_total);
+
+  // Disabling frees the in-flight table and invalidates the getter again.
+  ret = rcl_service_enable_stats(&service, false);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_service_get_stats(&service, &stats);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+}
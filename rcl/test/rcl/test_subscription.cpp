@@ -18,6 +18,7 @@
 #include <string>
 #include <thread>
 
+#include "rcl/reclamation.h"
 #include "rcl/subscription.h"
 
 #include "rcl/rcl.h"
@@ -183,6 +184,65 @@ TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription
   }
 }
 
+/* Basic test of the wait-set-free blocking take.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription_take_blocking) {
+  rcl_ret_t ret;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const char * topic = "rcl_test_take_blocking";
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  ret = rcl_subscription_init(&subscription, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+
+  // With nothing published a short timeout should expire.
+  {
+    test_msgs__msg__BasicTypes msg;
+    test_msgs__msg__BasicTypes__init(&msg);
+    ret = rcl_take_blocking(&subscription, RCL_MS_TO_NS(100), &msg, nullptr);
+    test_msgs__msg__BasicTypes__fini(&msg);
+    EXPECT_EQ(RCL_RET_TIMEOUT, ret);
+    rcl_reset_error();
+  }
+  {
+    test_msgs__msg__BasicTypes msg;
+    test_msgs__msg__BasicTypes__init(&msg);
+    msg.int64_value = 42;
+    ret = rcl_publish(&publisher, &msg, nullptr);
+    test_msgs__msg__BasicTypes__fini(&msg);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+  // The blocking take wakes up for the published message and takes it.
+  {
+    test_msgs__msg__BasicTypes msg;
+    test_msgs__msg__BasicTypes__init(&msg);
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+      test_msgs__msg__BasicTypes__fini(&msg);
+    });
+    ret = RCL_RET_SUBSCRIPTION_TAKE_FAILED;
+    for (int attempt = 0; RCL_RET_OK != ret && attempt < 10; ++attempt) {
+      rcl_reset_error();
+      ret = rcl_take_blocking(&subscription, RCL_S_TO_NS(1), &msg, nullptr);
+    }
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ASSERT_EQ(42, msg.int64_value);
+  }
+}
+
 /* Basic nominal test of a publisher with a string.
  */
 TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription_nominal_string) {
@@ -233,3 +293,330 @@ TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription
     ASSERT_EQ(std::string(test_string), std::string(msg.string_value.data, msg.string_value.size));
   }
 }
+
+/* Basic test of the serialized buffer pool acquire/release cycle.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_serialized_buffer_pool) {
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Strings);
+  const char * topic = "rcl_test_serialized_buffer_pool";
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  subscription_options.serialized_buffer_pool_depth = 2;
+  rcl_ret_t ret =
+    rcl_subscription_init(&subscription, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  rcl_serialized_message_t serialized_message = rmw_get_zero_initialized_serialized_message();
+  ret = rcl_subscription_acquire_serialized_message(&subscription, 100, &serialized_message);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // Capacity is rounded up to the next power-of-two size class.
+  EXPECT_EQ(128u, serialized_message.buffer_capacity);
+  uint8_t * first_buffer = serialized_message.buffer;
+  ASSERT_NE(nullptr, first_buffer);
+  ret = rcl_subscription_release_serialized_message(&subscription, &serialized_message);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(nullptr, serialized_message.buffer);
+  // A same-class acquire must recycle the released buffer without allocating.
+  ret = rcl_subscription_acquire_serialized_message(&subscription, 90, &serialized_message);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(first_buffer, serialized_message.buffer);
+  ret = rcl_subscription_release_serialized_message(&subscription, &serialized_message);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
+
+/* Basic test of draining serialized messages into one contiguous slab.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_take_serialized_sequence) {
+  rcl_ret_t ret;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const char * topic = "rcl_test_take_serialized_sequence";
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  subscription_options.serialized_buffer_pool_depth = 2;
+  ret = rcl_subscription_init(&subscription, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  for (int64_t value = 0; value < 2; ++value) {
+    test_msgs__msg__BasicTypes msg;
+    test_msgs__msg__BasicTypes__init(&msg);
+    msg.int64_value = value;
+    ret = rcl_publish(&publisher, &msg, nullptr);
+    test_msgs__msg__BasicTypes__fini(&msg);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+  bool success;
+  wait_for_subscription_to_be_ready(&subscription, context_ptr, 10, 100, success);
+  ASSERT_TRUE(success);
+  uint8_t slab_storage[1024];
+  rcl_serialized_message_t slab = rmw_get_zero_initialized_serialized_message();
+  slab.buffer = slab_storage;
+  slab.buffer_capacity = sizeof(slab_storage);
+  size_t offsets[4];
+  size_t total_taken = 0;
+  for (int attempt = 0; total_taken < 2 && attempt < 10; ++attempt) {
+    size_t taken = 0;
+    ret = rcl_take_serialized_sequence(
+      &subscription, 4 - total_taken, &slab, offsets, &taken);
+    if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
+      rcl_reset_error();
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      continue;
+    }
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(0u, offsets[0]);
+    EXPECT_GT(slab.buffer_length, 0u);
+    EXPECT_LE(slab.buffer_length, slab.buffer_capacity);
+    if (taken > 1) {
+      EXPECT_GT(offsets[1], offsets[0]);
+    }
+    total_taken += taken;
+  }
+  EXPECT_EQ(2u, total_taken);
+}
+
+/* Test direct intra-context delivery between a publisher and subscription.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_intra_context_delivery) {
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const char * topic = "rcl_test_intra_context_delivery";
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  subscription_options.enable_intra_context_delivery = true;
+  rcl_ret_t ret =
+    rcl_subscription_init(&subscription, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  publisher_options.enable_intra_context_delivery = true;
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  // Nothing published yet, so the ring must be empty.
+  void * taken_message = nullptr;
+  ret = rcl_take_intra_context(&subscription, &taken_message);
+  EXPECT_EQ(RCL_RET_SUBSCRIPTION_TAKE_FAILED, ret);
+  rcl_reset_error();
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    test_msgs__msg__BasicTypes__fini(&msg);
+  });
+  msg.int64_value = 42;
+  ret = rcl_publish(&publisher, &msg, nullptr);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // The very same message instance must come back out, no copy involved.
+  ret = rcl_take_intra_context(&subscription, &taken_message);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(static_cast<void *>(&msg), taken_message);
+  ret = rcl_take_intra_context(&subscription, &taken_message);
+  EXPECT_EQ(RCL_RET_SUBSCRIPTION_TAKE_FAILED, ret);
+  rcl_reset_error();
+}
+
+/* Test the unchecked publish/take fast path using validation tokens.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_unchecked_fast_path) {
+  rcl_ret_t ret;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const char * topic = "unchecked_chatter";
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  ret = rcl_subscription_init(&subscription, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // Tokens are only handed out for valid entities.
+  rcl_publisher_validation_token_t publisher_token;
+  ret = rcl_publisher_get_validation_token(nullptr, &publisher_token);
+  EXPECT_EQ(RCL_RET_PUBLISHER_INVALID, ret);
+  rcl_reset_error();
+  rcl_subscription_validation_token_t subscription_token;
+  ret = rcl_subscription_get_validation_token(nullptr, &subscription_token);
+  EXPECT_EQ(RCL_RET_SUBSCRIPTION_INVALID, ret);
+  rcl_reset_error();
+  ret = rcl_publisher_get_validation_token(&publisher, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_publisher_get_validation_token(&publisher, &publisher_token);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(&publisher, publisher_token.publisher);
+  ret = rcl_subscription_get_validation_token(&subscription, &subscription_token);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(&subscription, subscription_token.subscription);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  {
+    test_msgs__msg__BasicTypes msg;
+    test_msgs__msg__BasicTypes__init(&msg);
+    msg.int64_value = 42;
+    ret = rcl_publish_unchecked(&publisher_token, &msg, nullptr);
+    test_msgs__msg__BasicTypes__fini(&msg);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+  bool success;
+  wait_for_subscription_to_be_ready(&subscription, context_ptr, 10, 100, success);
+  ASSERT_TRUE(success);
+  {
+    test_msgs__msg__BasicTypes msg;
+    test_msgs__msg__BasicTypes__init(&msg);
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+      test_msgs__msg__BasicTypes__fini(&msg);
+    });
+    ret = rcl_take_unchecked(&subscription_token, &msg, nullptr, nullptr);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ASSERT_EQ(42, msg.int64_value);
+    // A second take finds the queue empty, like rcl_take().
+    ret = rcl_take_unchecked(&subscription_token, &msg, nullptr, nullptr);
+    EXPECT_EQ(RCL_RET_SUBSCRIPTION_TAKE_FAILED, ret);
+    rcl_reset_error();
+  }
+}
+
+/* Test that a deferred fini retires the subscription and reclaims it later.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription_fini_deferred) {
+  rcl_ret_t ret;
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  ret = rcl_subscription_init(
+    &subscription, this->node_ptr, ts, "deferred_chatter", &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // The handle dies immediately, the storage lives on in the domain.
+  ret = rcl_subscription_fini_deferred(&subscription, this->node_ptr);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(nullptr, subscription.impl);
+  EXPECT_FALSE(rcl_subscription_is_valid(&subscription));
+  rcl_reset_error();
+  // Retiring an already retired handle is a no-op, like rcl_subscription_fini().
+  ret = rcl_subscription_fini_deferred(&subscription, this->node_ptr);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // No threads are registered, so a drain runs the real fini.
+  ret = rcl_reclamation_drain(this->context_ptr);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
+
+/* Test opt-in arrival statistics collected inside rcl_take.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription_stats) {
+  rcl_ret_t ret;
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const char * topic = "stats_chatter";
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  subscription_options.enable_stats = true;
+  ret = rcl_subscription_init(&subscription, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_subscription_stats_t stats;
+  EXPECT_EQ(RCL_RET_SUBSCRIPTION_INVALID, rcl_subscription_get_stats(nullptr, &stats));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_subscription_get_stats(&subscription, nullptr));
+  rcl_reset_error();
+
+  // Nothing recorded yet.
+  ret = rcl_subscription_get_stats(&subscription, &stats);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, stats.received_count);
+  EXPECT_EQ(0.0, stats.period_mean);
+  EXPECT_EQ(0.0, stats.period_variance);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  for (int i = 0; i < 3; ++i) {
+    {
+      test_msgs__msg__BasicTypes msg;
+      test_msgs__msg__BasicTypes__init(&msg);
+      msg.int64_value = i;
+      ret = rcl_publish(&publisher, &msg, nullptr);
+      test_msgs__msg__BasicTypes__fini(&msg);
+      ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    }
+    bool success;
+    wait_for_subscription_to_be_ready(&subscription, context_ptr, 10, 100, success);
+    ASSERT_TRUE(success);
+    {
+      test_msgs__msg__BasicTypes msg;
+      test_msgs__msg__BasicTypes__init(&msg);
+      OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+        test_msgs__msg__BasicTypes__fini(&msg);
+      });
+      ret = rcl_take(&subscription, &msg, nullptr, nullptr);
+      ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    }
+    // Make the periods between takes non-zero.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+
+  ret = rcl_subscription_get_stats(&subscription, &stats);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(3u, stats.received_count);
+  EXPECT_GT(stats.period_mean, 0.0);
+  EXPECT_GE(stats.period_variance, 0.0);
+
+  // The getter refuses subscriptions created without the option.
+  rcl_subscription_t plain_subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t plain_options = rcl_subscription_get_default_options();
+  ret = rcl_subscription_init(
+    &plain_subscription, this->node_ptr, ts, "plain_stats_chatter", &plain_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&plain_subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_subscription_get_stats(&plain_subscription, &stats));
+  rcl_reset_error();
+}
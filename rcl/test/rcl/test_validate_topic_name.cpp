@@ -107,6 +107,8 @@ TEST(test_validate_topic_name, various_valid_topics) {
     "{foo1}",
     "{foo_bar}",
     "{_bar}",
+    // long enough to exercise the blockwise all-legal scan
+    "/a_namespace_long_enough_to_span_several_blocks/of_the_fast_scan/topic_name_0123456789",
   };
   for (const auto & topic : topics_that_should_pass) {
     int validation_result;
@@ -154,6 +156,10 @@ TEST(test_validate_topic_name, various_invalid_topics) {
     {"{{bar}_baz}", RCL_TOPIC_NAME_INVALID_SUBSTITUTION_CONTAINS_UNALLOWED_CHARACTERS, 1},
     {"foo/{bar/baz}", RCL_TOPIC_NAME_INVALID_SUBSTITUTION_CONTAINS_UNALLOWED_CHARACTERS, 8},
     {"{1foo}", RCL_TOPIC_NAME_INVALID_SUBSTITUTION_STARTS_WITH_NUMBER, 1},
+    // invalid characters on either side of a fast scan block boundary
+    {"abcdefg bar", RCL_TOPIC_NAME_INVALID_CONTAINS_UNALLOWED_CHARACTERS, 7},
+    {"abcdefgh bar", RCL_TOPIC_NAME_INVALID_CONTAINS_UNALLOWED_CHARACTERS, 8},
+    {"abcdefghi bar", RCL_TOPIC_NAME_INVALID_CONTAINS_UNALLOWED_CHARACTERS, 9},
   };
   for (const auto & case_tuple : topic_cases_that_should_fail) {
     std::string topic = case_tuple.topic;
@@ -12,6 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#ifndef _WIN32
+#include <unistd.h>  // for pipe, read, write, close
+#endif
+
 #include <algorithm>  // for std::max
 #include <atomic>
 #include <chrono>
@@ -139,7 +143,7 @@ TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), negative_timeout) {
 
   rcl_timer_t timer = rcl_get_zero_initialized_timer();
   ret = rcl_timer_init(
-    &timer, &clock, this->context_ptr, RCL_MS_TO_NS(10), nullptr, rcl_get_default_allocator());
+    &timer, &clock, this->context_ptr, RCL_MS_TO_NS(10), 0, nullptr, rcl_get_default_allocator());
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
   OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
     ret = rcl_timer_fini(&timer);
@@ -228,6 +232,259 @@ TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), zero_timeout_triggered
   EXPECT_LE(diff, TOLERANCE);
 }
 
+// Check that a persistent wait set keeps its entities across clears
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), persistent_registration) {
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret =
+    rcl_wait_set_init(&wait_set, 0, 1, 0, 0, 0, 0, context_ptr, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ret = rcl_wait_set_fini(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_guard_condition_t guard_cond = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_cond, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ret = rcl_guard_condition_fini(&guard_cond);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_cond, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_set_persistent(&wait_set, true);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // Spin a couple of cycles without re-adding the guard condition.
+  for (int cycle = 0; cycle < 2; ++cycle) {
+    ret = rcl_trigger_guard_condition(&guard_cond);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_wait(&wait_set, RCL_MS_TO_NS(100));
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(&guard_cond, wait_set.guard_conditions[0]);
+    // Clear restores the registration instead of emptying the set.
+    ret = rcl_wait_set_clear(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(&guard_cond, wait_set.guard_conditions[0]);
+  }
+
+  // Disabling persistent mode restores the clear-and-rebuild behavior.
+  ret = rcl_wait_set_set_persistent(&wait_set, false);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_clear(&wait_set);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(nullptr, wait_set.guard_conditions[0]);
+}
+
+// Check that one call can wait across several wait sets at once
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), wait_multiple) {
+  rcl_wait_set_t wait_set1 = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret =
+    rcl_wait_set_init(&wait_set1, 0, 1, 0, 0, 0, 0, context_ptr, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_wait_set_t wait_set2 = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(&wait_set2, 0, 1, 0, 0, 0, 0, context_ptr, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set1)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set2)) << rcl_get_error_string().str;
+  });
+
+  rcl_guard_condition_t gc1 = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &gc1, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_guard_condition_t gc2 = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &gc2, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&gc1)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&gc2)) << rcl_get_error_string().str;
+  });
+  ret = rcl_wait_set_add_guard_condition(&wait_set1, &gc1, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_guard_condition(&wait_set2, &gc2, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_wait_set_t * wait_sets[] = {&wait_set1, &wait_set2};
+
+  // Non-persistent wait sets are rejected.
+  ret = rcl_wait_multiple(wait_sets, 2, 0, -1);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_wait_set_set_persistent(&wait_set1, true);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_set_persistent(&wait_set2, true);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // Nothing triggered yet, so a bounded wait times out.
+  ret = rcl_wait_multiple(wait_sets, 2, RCL_MS_TO_NS(20), RCL_MS_TO_NS(5));
+  EXPECT_EQ(RCL_RET_TIMEOUT, ret) << rcl_get_error_string().str;
+
+  // An event in the second set is seen even while the first set holds the
+  // blocking slot.
+  ret = rcl_trigger_guard_condition(&gc2);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_multiple(wait_sets, 2, RCL_MS_TO_NS(1000), RCL_MS_TO_NS(5));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(nullptr, wait_set1.guard_conditions[0]);
+  EXPECT_EQ(&gc2, wait_set2.guard_conditions[0]);
+}
+
+// Check that the spin-before-block phase picks up ready entities
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), spin_before_block) {
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret =
+    rcl_wait_set_init(&wait_set, 0, 1, 0, 0, 0, 0, context_ptr, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ret = rcl_wait_set_fini(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_guard_condition_t guard_cond = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_cond, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ret = rcl_guard_condition_fini(&guard_cond);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_cond, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_set_persistent(&wait_set, true);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // A negative duration is rejected.
+  ret = rcl_wait_set_set_spin_duration(&wait_set, -1);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_wait_set_set_spin_duration(&wait_set, RCL_MS_TO_NS(5));
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // Already-triggered condition is found by the spin phase.
+  ret = rcl_trigger_guard_condition(&guard_cond);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(1000));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(&guard_cond, wait_set.guard_conditions[0]);
+
+  // With nothing ready the spin phase falls through to the blocking wait
+  // and the overall timeout is still honored.
+  ret = rcl_wait_set_clear(&wait_set);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(20));
+  EXPECT_EQ(RCL_RET_TIMEOUT, ret);
+}
+
+#ifndef _WIN32
+// Check that a raw file descriptor can be waited on alongside the entities
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), fd_in_wait_set) {
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret =
+    rcl_wait_set_init(&wait_set, 0, 0, 0, 0, 0, 0, context_ptr, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ret = rcl_wait_set_fini(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  int pipe_fds[2];
+  ASSERT_EQ(0, pipe(pipe_fds));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+  });
+
+  // At least one of readable or writable has to be requested.
+  size_t index = 42;
+  ret = rcl_wait_set_add_fd(&wait_set, pipe_fds[0], 0, &index);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_wait_set_add_fd(&wait_set, pipe_fds[0], RCL_WAIT_SET_FD_READABLE, &index);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, index);
+
+  // Nothing written yet, so the wait times out.
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(10));
+  EXPECT_EQ(RCL_RET_TIMEOUT, ret);
+
+  // After writing, the read end becomes ready.
+  ASSERT_EQ(1, write(pipe_fds[1], "x", 1));
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(1000));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  const rcl_wait_set_fd_t * fds = nullptr;
+  size_t count = 0;
+  ret = rcl_wait_set_get_fds(&wait_set, &fds, &count);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(1u, count);
+  ASSERT_NE(nullptr, fds);
+  EXPECT_EQ(pipe_fds[0], fds[0].fd);
+  EXPECT_TRUE(fds[0].revents & RCL_WAIT_SET_FD_READABLE);
+}
+#endif  // _WIN32
+
+// Check that the ready-entity lists reflect the outcome of the last wait
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), ready_entity_extraction) {
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret =
+    rcl_wait_set_init(&wait_set, 0, 2, 0, 0, 0, 0, context_ptr, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ret = rcl_wait_set_fini(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_guard_condition_t gc1 = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &gc1, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_guard_condition_t gc2 = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &gc2, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&gc1)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&gc2)) << rcl_get_error_string().str;
+  });
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &gc1, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &gc2, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  const size_t * indices = nullptr;
+  size_t count = 42;
+  // Before the first wait the ready lists are empty.
+  ret = rcl_wait_set_get_ready_entities(
+    &wait_set, RCL_WAIT_SET_GUARD_CONDITION, &indices, &count);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, count);
+
+  // Only the second guard condition is triggered.
+  ret = rcl_trigger_guard_condition(&gc2);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(100));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  ret = rcl_wait_set_get_ready_entities(
+    &wait_set, RCL_WAIT_SET_GUARD_CONDITION, &indices, &count);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(1u, count);
+  ASSERT_NE(nullptr, indices);
+  EXPECT_EQ(1u, indices[0]);
+  EXPECT_EQ(&gc2, wait_set.guard_conditions[indices[0]]);
+
+  ret = rcl_wait_set_get_ready_entities(&wait_set, RCL_WAIT_SET_TIMER, &indices, &count);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, count);
+}
+
 // Check that a canceled timer doesn't wake up rcl_wait
 TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), canceled_timer) {
   rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
@@ -263,7 +520,7 @@ TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), canceled_timer) {
   rcl_timer_t canceled_timer = rcl_get_zero_initialized_timer();
   ret = rcl_timer_init(
     &canceled_timer, &clock, this->context_ptr,
-    RCL_MS_TO_NS(1), nullptr, rcl_get_default_allocator());
+    RCL_MS_TO_NS(1), 0, nullptr, rcl_get_default_allocator());
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
   OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
     ret = rcl_timer_fini(&canceled_timer);
@@ -285,6 +542,63 @@ TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), canceled_timer) {
   EXPECT_LE(diff, RCL_MS_TO_NS(10) + TOLERANCE);
 }
 
+// Check that a timer canceled and later reset still drives the timeout of a
+// persistent wait set, whose timer heap is rebuilt when re-arming.
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), persistent_canceled_timer_reset) {
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret =
+    rcl_wait_set_init(&wait_set, 0, 0, 1, 0, 0, 0, context_ptr, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ret = rcl_wait_set_fini(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_clock_t clock;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  ret = rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ret = rcl_clock_fini(&clock);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  ret = rcl_timer_init(
+    &timer, &clock, this->context_ptr,
+    RCL_MS_TO_NS(10), 0, nullptr, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ret = rcl_timer_fini(&timer);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  ret = rcl_timer_cancel(&timer);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_timer(&wait_set, &timer, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_set_persistent(&wait_set, true);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // The canceled timer does not drive the timeout; its heap entry is pruned.
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(20));
+  EXPECT_EQ(RCL_RET_TIMEOUT, ret);
+  rcl_reset_error();
+
+  // After a clear and a reset the timer has to wake the wait again, well
+  // before the generous timeout.
+  ret = rcl_wait_set_clear(&wait_set);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_timer_reset(&timer);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  std::chrono::steady_clock::time_point before_sc = std::chrono::steady_clock::now();
+  ret = rcl_wait(&wait_set, RCL_S_TO_NS(1));
+  std::chrono::steady_clock::time_point after_sc = std::chrono::steady_clock::now();
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(&timer, wait_set.timers[0]);
+  int64_t diff = std::chrono::duration_cast<std::chrono::nanoseconds>(after_sc - before_sc).count();
+  EXPECT_LE(diff, RCL_MS_TO_NS(10) + TOLERANCE);
+}
+
 // Test rcl_wait_set_t with excess capacity works.
 TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), excess_capacity) {
   rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
@@ -514,3 +828,68 @@ TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), add_with_index) {
     EXPECT_EQ(&guard_conditions[i], wait_set.guard_conditions[i]);
   }
 }
+
+// Check that priority classes reorder the ready lists, highest class first
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), priority_ordered_ready_list) {
+  const size_t kNumEntities = 3u;
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret = rcl_wait_set_init(
+    &wait_set, 0, kNumEntities, 0, 0, 0, 0, context_ptr, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ret = rcl_wait_set_fini(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_guard_condition_t guard_conditions[kNumEntities];
+  for (size_t i = 0u; i < kNumEntities; ++i) {
+    guard_conditions[i] = rcl_get_zero_initialized_guard_condition();
+    ret = rcl_guard_condition_init(
+      &guard_conditions[i], this->context_ptr, rcl_guard_condition_get_default_options());
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+      ret = rcl_guard_condition_fini(&guard_conditions[i]);
+      EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    });
+    size_t index = 42u;
+    ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_conditions[i], &index);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(i, index);
+    ret = rcl_trigger_guard_condition(&guard_conditions[i]);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+
+  // Invalid arguments are rejected.
+  ret = rcl_wait_set_set_entity_priority(
+    nullptr, RCL_WAIT_SET_GUARD_CONDITION, 0u, 1u);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_wait_set_set_entity_priority(
+    &wait_set, RCL_WAIT_SET_ENTITY_TYPES, 0u, 1u);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_wait_set_set_entity_priority(
+    &wait_set, RCL_WAIT_SET_GUARD_CONDITION, kNumEntities, 1u);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // The last slot gets the highest class, the first stays in the default one.
+  ret = rcl_wait_set_set_entity_priority(&wait_set, RCL_WAIT_SET_GUARD_CONDITION, 2u, 2u);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_set_entity_priority(&wait_set, RCL_WAIT_SET_GUARD_CONDITION, 1u, 1u);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(100));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  const size_t * indices = nullptr;
+  size_t count = 0;
+  ret = rcl_wait_set_get_ready_entities(
+    &wait_set, RCL_WAIT_SET_GUARD_CONDITION, &indices, &count);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(kNumEntities, count);
+  ASSERT_NE(nullptr, indices);
+  EXPECT_EQ(2u, indices[0]);
+  EXPECT_EQ(1u, indices[1]);
+  EXPECT_EQ(0u, indices[2]);
+}
@@ -20,6 +20,7 @@ extern "C"
 {
 #endif
 
+#include "rcl_action/names.h"
 #include "rcl_action/types.h"
 #include "rcl_action/visibility_control.h"
 #include "rcl/macros.h"
@@ -387,6 +388,10 @@ rcl_action_take_goal_response(
  * If feedback is successfully taken, the feedback message is copied to into the
  * `ros_feedback` struct.
  *
+ * If goal UUIDs have been registered with rcl_action_add_feedback_uuid(),
+ * only feedback for those goals is delivered and feedback for other goals is
+ * drained and dropped.
+ *
  * If allocation is required when taking the feedback, e.g. if space needs to
  * be allocated for a dynamically sized array in the target message, then the
  * allocator given in the action client options is used.
@@ -417,6 +422,67 @@ rcl_action_take_feedback(
   const rcl_action_client_t * action_client,
   void * ros_feedback);
 
+/// Register a goal UUID whose feedback the client is interested in.
+/**
+ * With at least one UUID registered, rcl_action_take_feedback() delivers only
+ * feedback for registered goals and silently drains feedback for all others,
+ * so a client tracking a few of many active goals on the shared feedback
+ * topic no longer receives, and has to discard, feedback it does not want.
+ * With no UUIDs registered all feedback is delivered, as before.
+ *
+ * Registering a UUID that is already registered is a no-op.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only when the interest set needs to grow</i>
+ *
+ * \param[in] action_client handle to the client taking the feedback
+ * \param[in] goal_uuid pointer to the 16 byte UUID of the goal of interest
+ * \return `RCL_RET_OK` if the UUID was registered, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_add_feedback_uuid(
+  const rcl_action_client_t * action_client,
+  const uint8_t * goal_uuid);
+
+/// Remove a goal UUID from the client's feedback interest set.
+/**
+ * Typically called once the goal reaches a terminal state.
+ * When the last UUID is removed the filter is disabled and all feedback is
+ * delivered again.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_client handle to the client taking the feedback
+ * \param[in] goal_uuid pointer to the 16 byte UUID to remove
+ * \return `RCL_RET_OK` if the UUID was removed, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid or the
+ *   UUID is not registered, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_remove_feedback_uuid(
+  const rcl_action_client_t * action_client,
+  const uint8_t * goal_uuid);
+
 /// Take a ROS status message using a rcl_action_client_t.
 /**
  * The caller is responsible for ensuring that the type of `ros_status_array`
@@ -658,6 +724,206 @@ rcl_action_take_cancel_response(
   rmw_request_id_t * response_header,
   void * ros_cancel_response);
 
+/// Associate a caller cookie with a pending goal request.
+/**
+ * The cookie is an opaque pointer the caller can use to correlate a response
+ * with the request that triggered it, e.g. a pointer to per-goal bookkeeping.
+ * It is stored against the sequence number returned by
+ * rcl_action_send_goal_request() and returned once by
+ * rcl_action_take_goal_response_with_cookie() when the matching response is
+ * taken, which removes it from the table.
+ * Registering a sequence number a second time replaces its cookie.
+ *
+ * The cookie is only ever returned to the caller, never dereferenced, so any
+ * value including `NULL` is valid.
+ * Cookies still pending when the action client is finalized are discarded.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_client handle to the client that sent the goal request
+ * \param[in] sequence_number sequence number returned when the request was sent
+ * \param[in] cookie opaque pointer to associate with the request
+ * \return `RCL_RET_OK` if the cookie was registered successfully, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_register_goal_request_cookie(
+  const rcl_action_client_t * action_client,
+  int64_t sequence_number,
+  void * cookie);
+
+/// Take a response for a goal request and the cookie registered for it.
+/**
+ * This is equivalent to rcl_action_take_goal_response(), additionally
+ * returning the cookie registered with
+ * rcl_action_register_goal_request_cookie() for the sequence number of the
+ * taken response.
+ * The cookie is removed from the pending request table; if no cookie was
+ * registered for the sequence number, `NULL` is returned instead.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_client handle to the client that will take the goal response
+ * \param[out] response_header pointer to the goal response header
+ * \param[out] ros_goal_response pointer to the response of a goal request
+ * \param[out] cookie cookie registered for the request, or `NULL` if none was
+ * \return `RCL_RET_OK` if the response was taken successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_ACTION_CLIENT_TAKE_FAILED` if take failed but no error occurred
+ *         in the middleware, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_take_goal_response_with_cookie(
+  const rcl_action_client_t * action_client,
+  rmw_request_id_t * response_header,
+  void * ros_goal_response,
+  void ** cookie);
+
+/// Associate a caller cookie with a pending result request.
+/**
+ * Equivalent to rcl_action_register_goal_request_cookie() for sequence
+ * numbers returned by rcl_action_send_result_request().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_client handle to the client that sent the result request
+ * \param[in] sequence_number sequence number returned when the request was sent
+ * \param[in] cookie opaque pointer to associate with the request
+ * \return `RCL_RET_OK` if the cookie was registered successfully, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_register_result_request_cookie(
+  const rcl_action_client_t * action_client,
+  int64_t sequence_number,
+  void * cookie);
+
+/// Take a response for a result request and the cookie registered for it.
+/**
+ * Equivalent to rcl_action_take_result_response(), additionally returning the
+ * cookie registered with rcl_action_register_result_request_cookie() for the
+ * sequence number of the taken response, or `NULL` if none was registered.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_client handle to the client that will take the result response
+ * \param[out] response_header pointer to the result response header
+ * \param[out] ros_result_response pointer to the response of a result request
+ * \param[out] cookie cookie registered for the request, or `NULL` if none was
+ * \return `RCL_RET_OK` if the response was taken successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_ACTION_CLIENT_TAKE_FAILED` if take failed but no error occurred
+ *         in the middleware, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_take_result_response_with_cookie(
+  const rcl_action_client_t * action_client,
+  rmw_request_id_t * response_header,
+  void * ros_result_response,
+  void ** cookie);
+
+/// Associate a caller cookie with a pending cancel request.
+/**
+ * Equivalent to rcl_action_register_goal_request_cookie() for sequence
+ * numbers returned by rcl_action_send_cancel_request().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_client handle to the client that sent the cancel request
+ * \param[in] sequence_number sequence number returned when the request was sent
+ * \param[in] cookie opaque pointer to associate with the request
+ * \return `RCL_RET_OK` if the cookie was registered successfully, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_register_cancel_request_cookie(
+  const rcl_action_client_t * action_client,
+  int64_t sequence_number,
+  void * cookie);
+
+/// Take a cancel response and the cookie registered for it.
+/**
+ * Equivalent to rcl_action_take_cancel_response(), additionally returning the
+ * cookie registered with rcl_action_register_cancel_request_cookie() for the
+ * sequence number of the taken response, or `NULL` if none was registered.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_client handle to the client that will take the cancel response
+ * \param[out] response_header pointer to the cancel response header
+ * \param[out] ros_cancel_response a zero-initialized ROS cancel response message where
+ *   the cancel response is copied.
+ * \param[out] cookie cookie registered for the request, or `NULL` if none was
+ * \return `RCL_RET_OK` if the response was taken successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ACTION_CLIENT_TAKE_FAILED` if take failed but no error occurred
+ *         in the middleware, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_take_cancel_response_with_cookie(
+  const rcl_action_client_t * action_client,
+  rmw_request_id_t * response_header,
+  void * ros_cancel_response,
+  void ** cookie);
+
 /// Get the name of the action for a rcl_action_client_t.
 /**
  * This function returns the action client's name string.
@@ -685,6 +951,33 @@ RCL_WARN_UNUSED
 const char *
 rcl_action_client_get_action_name(const rcl_action_client_t * action_client);
 
+/// Return the derived topic and service names of an action client.
+/**
+ * Returns the names the action client derived from the action name during
+ * initialization, avoiding a per-call derivation for introspection.
+ * This function can fail, and therefore return `NULL`, if the:
+ *   - action client is `NULL`
+ *   - action client is invalid (never called init, called fini, or invalid)
+ *
+ * The returned struct is only valid as long as the action client is valid.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_client pointer to the action client
+ * \return derived names struct if successful, or
+ * \return `NULL` otherwise.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+const rcl_action_derived_names_t *
+rcl_action_client_get_derived_names(const rcl_action_client_t * action_client);
+
 /// Return the options for a rcl_action_client_t.
 /**
  * This function returns the action client's internal options struct.
@@ -21,6 +21,7 @@ extern "C"
 #endif
 
 #include "rcl_action/goal_handle.h"
+#include "rcl_action/names.h"
 #include "rcl_action/types.h"
 #include "rcl_action/visibility_control.h"
 #include "rcl/macros.h"
@@ -52,6 +53,16 @@ typedef struct rcl_action_server_options_t
   rcl_allocator_t allocator;
   /// Goal handles that have results longer than this time are deallocated.
   rcl_duration_t result_timeout;
+  /// Number of expired goal handles to keep pooled for reuse.
+  /**
+   * Accepting a goal allocates a goal handle and its implementation; with a
+   * non-zero pool size the action server recycles up to this many expired
+   * goal handles instead of returning their memory to the allocator.
+   * Pooled memory requires that goal handles are finalized before the action
+   * server is.
+   * For default behavior (no pooling), set to 0.
+   */
+  size_t goal_handle_pool_size;
 } rcl_action_server_options_t;
 
 /// Return a rcl_action_server_t struct with members set to `NULL`.
@@ -219,6 +230,7 @@ rcl_action_server_fini(rcl_action_server_t * action_server, rcl_node_t * node);
  * - status_topic_qos = rcl_action_qos_profile_status_default;
  * - allocator = rcl_get_default_allocator();
  * - result_timeout = RCUTILS_S_TO_NS(15 * 60);  // 15 minutes
+ * - goal_handle_pool_size = 0;  // goal handle pooling disabled
  */
 RCL_ACTION_PUBLIC
 RCL_WARN_UNUSED
@@ -434,6 +446,102 @@ rcl_action_publish_feedback(
   const rcl_action_server_t * action_server,
   void * ros_feedback);
 
+/// Borrow a loaned feedback message from an action server.
+/**
+ * The message is allocated by the middleware and the caller writes the goal
+ * feedback directly into it, enabling a zero-copy publish with
+ * rcl_action_publish_loaned_feedback() on middlewares which support message
+ * loaning.
+ * A borrowed message that is not published must be given back with
+ * rcl_action_return_loaned_feedback_message().
+ *
+ * \see rcl_borrow_loaned_message()
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] action_server handle to the action server that will publish the feedback
+ * \param[out] ros_feedback set to a middleware owned feedback message
+ * \return `RCL_RET_OK` if the message was borrowed successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support message loaning, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_borrow_loaned_feedback_message(
+  const rcl_action_server_t * action_server,
+  void ** ros_feedback);
+
+/// Publish a previously borrowed loaned feedback message.
+/**
+ * Ownership of the loaned message is transferred back to the middleware and
+ * the pointer must not be used afterwards.
+ *
+ * \see rcl_publish_loaned_message()
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] action_server handle to the action server that will publish the feedback
+ * \param[in] ros_feedback loaned message borrowed with
+ *   rcl_action_borrow_loaned_feedback_message()
+ * \return `RCL_RET_OK` if the message was published successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support message loaning, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_publish_loaned_feedback(
+  const rcl_action_server_t * action_server,
+  void * ros_feedback);
+
+/// Return an unpublished loaned feedback message to the middleware.
+/**
+ * \see rcl_return_loaned_message_from_publisher()
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] action_server handle to the action server the message was borrowed from
+ * \param[in] ros_feedback loaned message to return to the middleware
+ * \return `RCL_RET_OK` if the message was returned successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support message loaning, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_return_loaned_feedback_message(
+  const rcl_action_server_t * action_server,
+  void * ros_feedback);
+
 /// Get a status array message for accepted goals associated with an action server.
 /**
  * The provided `status_message` should be zero-initialized with
@@ -461,6 +569,43 @@ rcl_action_get_goal_status_array(
   const rcl_action_server_t * action_server,
   rcl_action_goal_status_array_t * status_message);
 
+/// Get a reference to a status array maintained by the action server.
+/**
+ * Unlike rcl_action_get_goal_status_array(), this function does not populate
+ * a newly allocated message per call; the action server keeps the status
+ * array between calls and reuses its storage, only refreshing the statuses
+ * of the tracked goals.
+ * The returned message can be published with rcl_action_publish_status().
+ *
+ * The returned pointer borrows storage owned by the action server and must
+ * not be finalized by the caller.
+ * It is only valid until the next call to this function, until a goal is
+ * accepted or expired, or until the action server is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only when the number of goals outgrows the reused storage</i>
+ *
+ * \param[in] action_server handle to the action server whose statuses are requested
+ * \param[out] status_message set to the action server's status array message
+ * \return `RCL_RET_OK` if the response was sent successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_get_goal_status_array_ref(
+  const rcl_action_server_t * action_server,
+  const rcl_action_goal_status_array_t ** status_message);
+
 /// Publish a status array message for accepted goals associated with an action server.
 /**
  * This function acts like a ROS publisher and is potentially a blocking call.
@@ -491,6 +636,98 @@ rcl_action_publish_status(
   const rcl_action_server_t * action_server,
   const void * status_message);
 
+/// Borrow a loaned status message from an action server.
+/**
+ * Equivalent to rcl_action_borrow_loaned_feedback_message() for the status
+ * topic; the borrowed action_msgs/StatusArray message is published with
+ * rcl_action_publish_loaned_status() or given back with
+ * rcl_action_return_loaned_status_message().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] action_server handle to the action server that will publish the status message
+ * \param[out] ros_status set to a middleware owned status array message
+ * \return `RCL_RET_OK` if the message was borrowed successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support message loaning, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_borrow_loaned_status_message(
+  const rcl_action_server_t * action_server,
+  void ** ros_status);
+
+/// Publish a previously borrowed loaned status message.
+/**
+ * Ownership of the loaned message is transferred back to the middleware and
+ * the pointer must not be used afterwards.
+ *
+ * \see rcl_publish_loaned_message()
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] action_server handle to the action server that will publish the status message
+ * \param[in] ros_status loaned message borrowed with
+ *   rcl_action_borrow_loaned_status_message()
+ * \return `RCL_RET_OK` if the message was published successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support message loaning, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_publish_loaned_status(
+  const rcl_action_server_t * action_server,
+  void * ros_status);
+
+/// Return an unpublished loaned status message to the middleware.
+/**
+ * \see rcl_return_loaned_message_from_publisher()
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] action_server handle to the action server the message was borrowed from
+ * \param[in] ros_status loaned message to return to the middleware
+ * \return `RCL_RET_OK` if the message was returned successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware does not support message loaning, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_return_loaned_status_message(
+  const rcl_action_server_t * action_server,
+  void * ros_status);
+
 /// Take a pending result request using an action server.
 /**
  * \todo TODO(jacobperron) blocking of take?
@@ -504,6 +741,11 @@ rcl_action_publish_status(
  * Passing a different type produces undefined behavior and cannot be checked
  * by this function and therefore no deliberate error will occur.
  *
+ * Requests for goals whose result response has been cached with
+ * rcl_action_server_cache_result_response() are answered directly by this
+ * function and do not surface to the caller; only requests the application
+ * has to compute a result for are returned.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
@@ -567,6 +809,71 @@ rcl_action_send_result_response(
   rmw_request_id_t * response_header,
   void * ros_result_response);
 
+/// Cache the result response for a terminal goal.
+/**
+ * Once cached, result requests for the goal are answered directly by
+ * rcl_action_take_result_request(), so when multiple clients request the
+ * result of the same goal the application computes and provides the response
+ * once instead of once per requester.
+ *
+ * The response message is not copied; the caller must keep it valid and
+ * unchanged until the goal expires (see the result_timeout option and
+ * rcl_action_expire_goals(), which drops the cache entry along with the
+ * goal) or the response is removed with
+ * rcl_action_server_uncache_result_response().
+ * Caching a response for a goal that already has one replaces it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only when the cache needs to grow</i>
+ *
+ * \param[in] action_server handle to the action server that took the result requests
+ * \param[in] goal_uuid pointer to the 16 byte UUID of the terminal goal
+ * \param[in] ros_result_response the ROS result response message to answer with
+ * \return `RCL_RET_OK` if the response was cached, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_server_cache_result_response(
+  const rcl_action_server_t * action_server,
+  const uint8_t * goal_uuid,
+  void * ros_result_response);
+
+/// Remove a cached result response before its goal expires.
+/**
+ * Call this if the cached response must be released early; removing a goal
+ * with no cached response is a no-op.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_server handle to the action server holding the cache
+ * \param[in] goal_uuid pointer to the 16 byte UUID whose response to drop
+ * \return `RCL_RET_OK` if the entry was removed or absent, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_server_uncache_result_response(
+  const rcl_action_server_t * action_server,
+  const uint8_t * goal_uuid);
+
 /// Expires goals associated with an action server.
 /**
  * A goal is 'expired' if it has been in a terminal state (has a result) for longer
@@ -620,6 +927,39 @@ rcl_action_expire_goals(
   size_t expired_goals_capacity,
   size_t * num_expired);
 
+/// Get the time at which the next tracked goal can expire.
+/**
+ * The action server keeps the expiry deadlines of its tracked goals in a
+ * min-heap, so this is a constant time lookup.
+ * The reported time is the earliest deadline of any tracked goal; the goal
+ * with that deadline only actually expires once it has also reached a
+ * terminal state.
+ * It can be used to bound the timeout of a wait so that
+ * rcl_action_expire_goals() runs as soon as a goal may have expired.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_server handle to the action server
+ * \param[out] expiry_time set to the earliest expiry deadline in nanoseconds,
+ *   or `INT64_MAX` if no goals are being tracked
+ * \return `RCL_RET_OK` if the expiry time was retrieved, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_server_get_next_goal_expiry(
+  const rcl_action_server_t * action_server,
+  rcl_time_point_value_t * expiry_time);
+
 /// Notifies action server that a goal handle reached a terminal state.
 /**
  * <hr>
@@ -786,6 +1126,33 @@ RCL_WARN_UNUSED
 const char *
 rcl_action_server_get_action_name(const rcl_action_server_t * action_server);
 
+/// Return the derived topic and service names of an action server.
+/**
+ * Returns the names the action server derived from the action name during
+ * initialization, avoiding a per-call derivation for introspection.
+ * This function can fail, and therefore return `NULL`, if the:
+ *   - action server is `NULL`
+ *   - action server is invalid (e.g. never called init or called fini)
+ *
+ * The returned struct is only valid as long as the action server is valid.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_server pointer to the action server
+ * \return derived names struct if successful, or
+ * \return `NULL` otherwise.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+const rcl_action_derived_names_t *
+rcl_action_server_get_derived_names(const rcl_action_server_t * action_server);
+
 /// Return the rcl_action_server_options_t for an action server.
 /**
  * This function returns the action server's internal options struct.
@@ -853,6 +1220,51 @@ rcl_action_server_get_goal_handles(
   rcl_action_goal_handle_t *** goal_handles,
   size_t * num_goals);
 
+/// Snapshot the ID and state of every goal tracked by an action server.
+/**
+ * Fills the caller provided arrays in one pass over the goal handle storage,
+ * replacing a rcl_action_goal_handle_get_status() call per goal: the server
+ * is validated once and the handles, which are valid for as long as the
+ * server is, are read without per-goal checks.
+ * The arrays hold one entry per goal in matching order, a consistent
+ * snapshot as long as no goal is accepted, transitioned or expired between
+ * the call and the use of the result.
+ *
+ * `num_goals` is always set to the number of tracked goals.  If `capacity`
+ * is smaller than that, nothing is copied and `RCL_RET_INVALID_ARGUMENT` is
+ * returned; the caller can resize using the reported count and retry.
+ * The number of tracked goals only changes when goals are accepted, expired
+ * or their results are delivered, so sizing with
+ * rcl_action_server_get_goal_handles() beforehand is reliable between those
+ * events.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_server handle to the action server
+ * \param[out] goal_uuids array of `capacity` goal IDs, filled with one entry per goal
+ * \param[out] goal_states array of `capacity` states, filled with one entry per goal
+ * \param[in] capacity the number of entries each array has room for
+ * \param[out] num_goals set to the number of tracked goals
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid or the arrays are too small.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_server_snapshot_goal_states(
+  const rcl_action_server_t * action_server,
+  uint8_t goal_uuids[][UUID_SIZE],
+  rcl_action_goal_state_t * goal_states,
+  size_t capacity,
+  size_t * num_goals);
+
 /// Check if a goal is already being tracked by an action server.
 /**
  * Checks whether or not a goal is being tracked in the internal goal array.
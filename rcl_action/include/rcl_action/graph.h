@@ -155,6 +155,101 @@ rcl_action_get_names_and_types(
   rcl_allocator_t * allocator,
   rcl_names_and_types_t * action_names_and_types);
 
+/// A cached, graph-change-tracked list of action names and their types.
+/**
+ * Updated with rcl_action_names_and_types_cache_update() and finalized with
+ * rcl_action_names_and_types_cache_fini().
+ * Between updates, `action_names_and_types` holds the filtered action list of
+ * the last update; treat the other members as opaque.
+ */
+typedef struct rcl_action_names_and_types_cache_t
+{
+  /// The cached list of action names and their types.
+  rcl_names_and_types_t action_names_and_types;
+  /// The graph cache epoch the list corresponds to.
+  uint64_t epoch;
+  /// True once the cache has been populated by an update.
+  bool valid;
+} rcl_action_names_and_types_cache_t;
+
+/// Return a rcl_action_names_and_types_cache_t with members set to zero values.
+RCL_ACTION_PUBLIC
+rcl_action_names_and_types_cache_t
+rcl_action_get_zero_initialized_names_and_types_cache(void);
+
+/// Bring a cached action list up to date with the ROS graph.
+/**
+ * Like rcl_action_get_names_and_types(), but keeps the filtered result
+ * between calls and only re-filters when the graph changed in a way that can
+ * affect it: the update asks the context's graph cache for the changes since
+ * the cache's last epoch (see rcl_graph_get_changes_since()) and re-filters
+ * from the cached topic list only if an action feedback topic was added or
+ * removed.
+ * A periodic discovery poll over an unchanged graph therefore does no
+ * filtering and no allocation at all.
+ *
+ * The context's graph cache has to be invalidated when the graph guard
+ * condition fires for the diffing to observe changes; see
+ * rcl_graph_cache_invalidate().
+ *
+ * The cache should be zero-initialized with
+ * rcl_action_get_zero_initialized_names_and_types_cache() before the first
+ * update and given to rcl_action_names_and_types_cache_fini() when no longer
+ * needed.
+ * After a successful update, `cache->action_names_and_types` is valid until
+ * the next update or until the cache is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [2]
+ * <i>[1] only when the action list is (re)filtered</i>
+ *
+ * <i>[2] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] allocator allocator for allocating space for strings
+ * \param[inout] cache the cache to bring up to date
+ * \return `RCL_RET_OK` if the cache is up to date, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_names_and_types_cache_update(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  rcl_action_names_and_types_cache_t * cache);
+
+/// Finalize a rcl_action_names_and_types_cache_t.
+/**
+ * Reclaims the memory held by the cached action list and zero-initializes
+ * the cache.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] cache the cache to be finalized
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_names_and_types_cache_fini(rcl_action_names_and_types_cache_t * cache);
+
 #ifdef __cplusplus
 }
 #endif
@@ -213,6 +213,100 @@ rcl_action_get_status_topic_name(
   rcl_allocator_t allocator,
   char ** status_topic_name);
 
+/// All topic and service names derived from one action name.
+/**
+ * Populated with rcl_action_derive_names() and finalized with
+ * rcl_action_derived_names_fini().
+ * The name members point into a single allocation owned by the struct; they
+ * are valid until the struct is finalized and must not be deallocated
+ * individually.
+ */
+typedef struct rcl_action_derived_names_t
+{
+  /// The derived goal service name.
+  const char * goal_service_name;
+  /// The derived cancel service name.
+  const char * cancel_service_name;
+  /// The derived result service name.
+  const char * result_service_name;
+  /// The derived feedback topic name.
+  const char * feedback_topic_name;
+  /// The derived status topic name.
+  const char * status_topic_name;
+  /// Single allocation backing all of the names.
+  char * storage;
+  /// Allocator used to allocate the storage.
+  rcl_allocator_t allocator;
+} rcl_action_derived_names_t;
+
+/// Return a rcl_action_derived_names_t struct with members set to `NULL`.
+RCL_ACTION_PUBLIC
+rcl_action_derived_names_t
+rcl_action_get_zero_initialized_derived_names(void);
+
+/// Derive all topic and service names of an action in one call.
+/**
+ * This function computes the same names as rcl_action_get_goal_service_name()
+ * and its siblings, but formats all five into a single allocation instead of
+ * allocating per name, so initializing an action client or server derives its
+ * names with one allocation instead of five.
+ *
+ * The given `derived_names` should be zero-initialized with
+ * rcl_action_get_zero_initialized_derived_names() before calling this
+ * function and given back with rcl_action_derived_names_fini() when the
+ * names are no longer needed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_name The name of the action whose names are being derived.
+ * \param[in] allocator A valid allocator to be used.
+ * \param[out] derived_names Struct to be populated with the derived names.
+ * \return `RCL_RET_OK` if the names were derived, or
+ * \return `RCL_RET_ACTION_NAME_INVALID` if the action name is not valid
+ *   (i.e. empty), or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the action name is `NULL`, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the allocator is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the derived names struct is `NULL`
+ *   or was not zero-initialized, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_derive_names(
+  const char * action_name,
+  rcl_allocator_t allocator,
+  rcl_action_derived_names_t * derived_names);
+
+/// Finalize a rcl_action_derived_names_t struct.
+/**
+ * Deallocates the storage backing the derived names and zero-initializes the
+ * struct.
+ * Calling this function on a zero-initialized struct is a no-op.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] derived_names Struct whose storage is to be released.
+ * \return `RCL_RET_OK` if the struct was finalized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the derived names struct is `NULL`.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_derived_names_fini(rcl_action_derived_names_t * derived_names);
+
 #ifdef __cplusplus
 }
 #endif
@@ -276,6 +276,262 @@ rcl_action_server_wait_set_get_entities_ready(
   bool * is_result_request_ready,
   bool * is_goal_expired);
 
+/// The goal response of an action client is ready to take.
+#define RCL_ACTION_CLIENT_GOAL_RESPONSE_READY (1u << 0)
+/// The cancel response of an action client is ready to take.
+#define RCL_ACTION_CLIENT_CANCEL_RESPONSE_READY (1u << 1)
+/// The result response of an action client is ready to take.
+#define RCL_ACTION_CLIENT_RESULT_RESPONSE_READY (1u << 2)
+/// A feedback message of an action client is ready to take.
+#define RCL_ACTION_CLIENT_FEEDBACK_READY (1u << 3)
+/// A status message of an action client is ready to take.
+#define RCL_ACTION_CLIENT_STATUS_READY (1u << 4)
+
+/// A goal request of an action server is ready to take.
+#define RCL_ACTION_SERVER_GOAL_REQUEST_READY (1u << 0)
+/// A cancel request of an action server is ready to take.
+#define RCL_ACTION_SERVER_CANCEL_REQUEST_READY (1u << 1)
+/// A result request of an action server is ready to take.
+#define RCL_ACTION_SERVER_RESULT_REQUEST_READY (1u << 2)
+/// A goal tracked by an action server has expired.
+#define RCL_ACTION_SERVER_GOAL_EXPIRED (1u << 3)
+
+/// Pre-validated wait set registration for all entities of an action client.
+/**
+ * Created with rcl_action_client_wait_set_token_init() and added to a wait
+ * set in one shot with rcl_action_wait_set_add_action_client_token().
+ * Treat the members as opaque.
+ */
+typedef struct rcl_action_client_wait_set_token_t
+{
+  /// Pre-validated tokens for the underlying clients and subscriptions.
+  rcl_wait_set_entity_token_t goal_client_token;
+  rcl_wait_set_entity_token_t cancel_client_token;
+  rcl_wait_set_entity_token_t result_client_token;
+  rcl_wait_set_entity_token_t feedback_subscription_token;
+  rcl_wait_set_entity_token_t status_subscription_token;
+  /// Wait set indices recorded by the last add.
+  size_t goal_client_index;
+  size_t cancel_client_index;
+  size_t result_client_index;
+  size_t feedback_subscription_index;
+  size_t status_subscription_index;
+} rcl_action_client_wait_set_token_t;
+
+/// Pre-validated wait set registration for all entities of an action server.
+/**
+ * Created with rcl_action_server_wait_set_token_init() and added to a wait
+ * set in one shot with rcl_action_wait_set_add_action_server_token().
+ * Treat the members as opaque.
+ */
+typedef struct rcl_action_server_wait_set_token_t
+{
+  /// Pre-validated tokens for the underlying services and the expiry timer.
+  rcl_wait_set_entity_token_t goal_service_token;
+  rcl_wait_set_entity_token_t cancel_service_token;
+  rcl_wait_set_entity_token_t result_service_token;
+  rcl_wait_set_entity_token_t expire_timer_token;
+  /// Wait set indices recorded by the last add.
+  size_t goal_service_index;
+  size_t cancel_service_index;
+  size_t result_service_index;
+  size_t expire_timer_index;
+} rcl_action_server_wait_set_token_t;
+
+/// Validate an action client once and produce a token for unchecked adds.
+/**
+ * The token caches pre-validated entity tokens for the five underlying wait
+ * set entities of the action client, so repeated wait cycles pay the
+ * argument and validity checking only once.
+ * The action client has to outlive the token and the token becomes invalid
+ * if the action client is finalized.
+ *
+ * \see rcl_wait_set_entity_token_init()
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[out] token the token to initialize
+ * \param[in] action_client the action client to validate
+ * \return `RCL_RET_OK` if the token was initialized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_client_wait_set_token_init(
+  rcl_action_client_wait_set_token_t * token,
+  const rcl_action_client_t * action_client);
+
+/// Validate an action server once and produce a token for unchecked adds.
+/**
+ * The token caches pre-validated entity tokens for the four underlying wait
+ * set entities of the action server, so repeated wait cycles pay the
+ * argument and validity checking only once.
+ * The action server has to outlive the token and the token becomes invalid
+ * if the action server is finalized.
+ *
+ * \see rcl_wait_set_entity_token_init()
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[out] token the token to initialize
+ * \param[in] action_server the action server to validate
+ * \return `RCL_RET_OK` if the token was initialized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_server_wait_set_token_init(
+  rcl_action_server_wait_set_token_t * token,
+  const rcl_action_server_t * action_server);
+
+/// Add all entities of a pre-validated action client to a wait set.
+/**
+ * Equivalent to rcl_action_wait_set_add_action_client(), but skips the
+ * per-call validity checks already done by
+ * rcl_action_client_wait_set_token_init() and records the wait set indices
+ * in the token for rcl_action_client_wait_set_get_ready_bitmask().
+ *
+ * \see rcl_wait_set_add_token()
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set struct where the action client entities are to be stored
+ * \param[inout] token pre-validated token for the action client to add
+ * \return `RCL_RET_OK` if added successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the token is `NULL`, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized, or
+ * \return `RCL_RET_WAIT_SET_FULL` if a corresponding set is full, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_wait_set_add_action_client_token(
+  rcl_wait_set_t * wait_set,
+  rcl_action_client_wait_set_token_t * token);
+
+/// Add all entities of a pre-validated action server to a wait set.
+/**
+ * Equivalent to rcl_action_wait_set_add_action_server(), but skips the
+ * per-call validity checks already done by
+ * rcl_action_server_wait_set_token_init() and records the wait set indices
+ * in the token for rcl_action_server_wait_set_get_ready_bitmask().
+ *
+ * \see rcl_wait_set_add_token()
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set struct where the action server entities are to be stored
+ * \param[inout] token pre-validated token for the action server to add
+ * \return `RCL_RET_OK` if added successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the token is `NULL`, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized, or
+ * \return `RCL_RET_WAIT_SET_FULL` if a corresponding set is full, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_wait_set_add_action_server_token(
+  rcl_wait_set_t * wait_set,
+  rcl_action_server_wait_set_token_t * token);
+
+/// Get the readiness of all action client entities as one bitmask.
+/**
+ * Combines the per-entity readiness checks of
+ * rcl_action_client_wait_set_get_entities_ready() into a single bitmask of
+ * `RCL_ACTION_CLIENT_*_READY` bits, using the wait set indices recorded by
+ * rcl_action_wait_set_add_action_client_token().
+ * Only the five recorded slots are inspected, so the cost per wait cycle is
+ * independent of the wait set size.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] wait_set the wait set which has been waited on
+ * \param[in] token token whose entities were added before the last rcl_wait()
+ * \param[out] ready_bitmask bitwise or of the `RCL_ACTION_CLIENT_*_READY`
+ *   bits of the ready entities
+ * \return `RCL_RET_OK` if call is successful, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_client_wait_set_get_ready_bitmask(
+  const rcl_wait_set_t * wait_set,
+  const rcl_action_client_wait_set_token_t * token,
+  uint32_t * ready_bitmask);
+
+/// Get the readiness of all action server entities as one bitmask.
+/**
+ * Combines the per-entity readiness checks of
+ * rcl_action_server_wait_set_get_entities_ready() into a single bitmask of
+ * `RCL_ACTION_SERVER_*` bits, using the wait set indices recorded by
+ * rcl_action_wait_set_add_action_server_token().
+ * Only the four recorded slots are inspected, so the cost per wait cycle is
+ * independent of the wait set size.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] wait_set the wait set which has been waited on
+ * \param[in] token token whose entities were added before the last rcl_wait()
+ * \param[out] ready_bitmask bitwise or of the `RCL_ACTION_SERVER_*` bits of
+ *   the ready entities
+ * \return `RCL_RET_OK` if call is successful, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_server_wait_set_get_ready_bitmask(
+  const rcl_wait_set_t * wait_set,
+  const rcl_action_server_wait_set_token_t * token,
+  uint32_t * ready_bitmask);
+
 #ifdef __cplusplus
 }
 #endif
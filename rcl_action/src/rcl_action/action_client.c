@@ -19,6 +19,8 @@ extern "C"
 
 #include "rcl_action/action_client.h"
 
+#include <string.h>
+
 #include "rcl_action/default_qos.h"
 #include "rcl_action/names.h"
 #include "rcl_action/types.h"
@@ -38,6 +40,136 @@ extern "C"
 #include "rmw/types.h"
 
 
+// Implementation only
+// Open-addressed hash table correlating in-flight request sequence numbers
+// with caller supplied cookies, one per service client.
+typedef struct pending_request_entry_t
+{
+  int64_t sequence_number;
+  void * cookie;
+  bool occupied;
+} pending_request_entry_t;
+
+typedef struct pending_request_table_t
+{
+  pending_request_entry_t * entries;
+  // Power of two, kept at least twice num_entries so probe chains stay short
+  size_t num_buckets;
+  size_t num_entries;
+} pending_request_table_t;
+
+// Implementation only
+static size_t
+_sequence_number_hash(const int64_t sequence_number)
+{
+  // Fibonacci hashing to spread consecutive sequence numbers over the buckets
+  return (size_t)((uint64_t)sequence_number * 0x9E3779B97F4A7C15ull);
+}
+
+// Implementation only
+// Insert without growing; the caller ensures a free bucket exists.
+static void
+_pending_request_table_insert(
+  pending_request_table_t * table, const int64_t sequence_number, void * cookie)
+{
+  const size_t mask = table->num_buckets - 1u;
+  size_t pos = _sequence_number_hash(sequence_number) & mask;
+  while (table->entries[pos].occupied) {
+    if (table->entries[pos].sequence_number == sequence_number) {
+      // Re-registering a sequence number replaces its cookie
+      table->entries[pos].cookie = cookie;
+      return;
+    }
+    pos = (pos + 1u) & mask;
+  }
+  table->entries[pos].sequence_number = sequence_number;
+  table->entries[pos].cookie = cookie;
+  table->entries[pos].occupied = true;
+  ++table->num_entries;
+}
+
+// Implementation only
+static rcl_ret_t
+_pending_request_table_put(
+  pending_request_table_t * table,
+  const rcl_allocator_t * allocator,
+  const int64_t sequence_number,
+  void * cookie)
+{
+  if ((2u * (table->num_entries + 1u)) > table->num_buckets) {
+    // Grow and rehash to keep the table at most half full
+    size_t new_num_buckets = (0u == table->num_buckets) ? 8u : (2u * table->num_buckets);
+    pending_request_entry_t * new_entries = (pending_request_entry_t *)allocator->zero_allocate(
+      new_num_buckets, sizeof(pending_request_entry_t), allocator->state);
+    if (!new_entries) {
+      RCL_SET_ERROR_MSG("memory allocation failed for pending request table");
+      return RCL_RET_BAD_ALLOC;
+    }
+    pending_request_entry_t * old_entries = table->entries;
+    const size_t old_num_buckets = table->num_buckets;
+    table->entries = new_entries;
+    table->num_buckets = new_num_buckets;
+    table->num_entries = 0u;
+    for (size_t i = 0u; i < old_num_buckets; ++i) {
+      if (old_entries[i].occupied) {
+        _pending_request_table_insert(table, old_entries[i].sequence_number, old_entries[i].cookie);
+      }
+    }
+    allocator->deallocate(old_entries, allocator->state);
+  }
+  _pending_request_table_insert(table, sequence_number, cookie);
+  return RCL_RET_OK;
+}
+
+// Implementation only
+// Remove the entry for the given sequence number and return its cookie.
+static bool
+_pending_request_table_take(
+  pending_request_table_t * table, const int64_t sequence_number, void ** cookie)
+{
+  if (0u == table->num_entries) {
+    return false;
+  }
+  const size_t mask = table->num_buckets - 1u;
+  size_t pos = _sequence_number_hash(sequence_number) & mask;
+  while (table->entries[pos].occupied) {
+    if (table->entries[pos].sequence_number == sequence_number) {
+      break;
+    }
+    pos = (pos + 1u) & mask;
+  }
+  if (!table->entries[pos].occupied) {
+    return false;
+  }
+  *cookie = table->entries[pos].cookie;
+  // Backward-shift deletion keeps probe chains intact without tombstones
+  size_t hole = pos;
+  size_t next = (hole + 1u) & mask;
+  while (table->entries[next].occupied) {
+    const size_t ideal = _sequence_number_hash(table->entries[next].sequence_number) & mask;
+    const bool in_chain = (hole <= next) ?
+      (ideal <= hole || ideal > next) : (ideal <= hole && ideal > next);
+    if (in_chain) {
+      table->entries[hole] = table->entries[next];
+      hole = next;
+    }
+    next = (next + 1u) & mask;
+  }
+  table->entries[hole].occupied = false;
+  --table->num_entries;
+  return true;
+}
+
+// Implementation only
+static void
+_pending_request_table_fini(pending_request_table_t * table, const rcl_allocator_t * allocator)
+{
+  allocator->deallocate(table->entries, allocator->state);
+  table->entries = NULL;
+  table->num_buckets = 0u;
+  table->num_entries = 0u;
+}
+
 typedef struct rcl_action_client_impl_t
 {
   rcl_client_t goal_client;
@@ -47,6 +179,17 @@ typedef struct rcl_action_client_impl_t
   rcl_subscription_t status_subscription;
   rcl_action_client_options_t options;
   char * action_name;
+  // Topic and service names derived from the action name, in one allocation
+  rcl_action_derived_names_t derived_names;
+  // Tables correlating in-flight request sequence numbers with caller cookies
+  pending_request_table_t goal_pending_requests;
+  pending_request_table_t cancel_pending_requests;
+  pending_request_table_t result_pending_requests;
+  // Goal UUIDs the client is interested in, 16 bytes each back to back;
+  // NULL (with zero count) means feedback for all goals is delivered
+  uint8_t * feedback_uuid_filter;
+  size_t num_feedback_uuid_filter;
+  size_t feedback_uuid_filter_capacity;
   // Wait set records
   size_t wait_set_goal_client_index;
   size_t wait_set_cancel_client_index;
@@ -64,17 +207,6 @@ rcl_action_get_zero_initialized_client(void)
 
 // \internal Initializes an action client specific service client.
 #define CLIENT_INIT(Type) \
-  char * Type ## _service_name = NULL; \
-  ret = rcl_action_get_ ## Type ## _service_name(action_name, allocator, &Type ## _service_name); \
-  if (RCL_RET_OK != ret) { \
-    RCL_SET_ERROR_MSG("failed to get " #Type " service name"); \
-    if (RCL_RET_BAD_ALLOC == ret) { \
-      ret = RCL_RET_BAD_ALLOC; \
-    } else { \
-      ret = RCL_RET_ERROR; \
-    } \
-    goto fail; \
-  } \
   rcl_client_options_t Type ## _service_client_options = { \
     .qos = options->Type ## _service_qos, .allocator = allocator \
   }; \
@@ -83,9 +215,8 @@ rcl_action_get_zero_initialized_client(void)
     &action_client->impl->Type ## _client, \
     node, \
     type_support->Type ## _service_type_support, \
-    Type ## _service_name, \
+    action_client->impl->derived_names.Type ## _service_name, \
     &Type ## _service_client_options); \
-  allocator.deallocate(Type ## _service_name, allocator.state); \
   if (RCL_RET_OK != ret) { \
     if (RCL_RET_BAD_ALLOC == ret) { \
       ret = RCL_RET_BAD_ALLOC; \
@@ -99,17 +230,6 @@ rcl_action_get_zero_initialized_client(void)
 
 // \internal Initializes an action client specific topic subscription.
 #define SUBSCRIPTION_INIT(Type) \
-  char * Type ## _topic_name = NULL; \
-  ret = rcl_action_get_ ## Type ## _topic_name(action_name, allocator, &Type ## _topic_name); \
-  if (RCL_RET_OK != ret) { \
-    RCL_SET_ERROR_MSG("failed to get " #Type " topic name"); \
-    if (RCL_RET_BAD_ALLOC == ret) { \
-      ret = RCL_RET_BAD_ALLOC; \
-    } else { \
-      ret = RCL_RET_ERROR; \
-    } \
-    goto fail; \
-  } \
   rcl_subscription_options_t Type ## _topic_subscription_options = { \
     .qos = options->Type ## _topic_qos, \
     .ignore_local_publications = false, \
@@ -120,9 +240,8 @@ rcl_action_get_zero_initialized_client(void)
     &action_client->impl->Type ## _subscription, \
     node, \
     type_support->Type ## _message_type_support, \
-    Type ## _topic_name, \
+    action_client->impl->derived_names.Type ## _topic_name, \
     &Type ## _topic_subscription_options); \
-  allocator.deallocate(Type ## _topic_name, allocator.state); \
   if (RCL_RET_OK != ret) { \
     if (RCL_RET_BAD_ALLOC == ret) { \
       ret = RCL_RET_BAD_ALLOC; \
@@ -165,6 +284,15 @@ rcl_action_client_init(
   RCL_CHECK_FOR_NULL_WITH_MSG(
     action_client->impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
 
+  // Zero initialize the pending request tables so the failure path is safe.
+  action_client->impl->goal_pending_requests = (pending_request_table_t) {0};
+  action_client->impl->cancel_pending_requests = (pending_request_table_t) {0};
+  action_client->impl->result_pending_requests = (pending_request_table_t) {0};
+  action_client->impl->derived_names = rcl_action_get_zero_initialized_derived_names();
+  action_client->impl->feedback_uuid_filter = NULL;
+  action_client->impl->num_feedback_uuid_filter = 0u;
+  action_client->impl->feedback_uuid_filter_capacity = 0u;
+
   // Copy action client name and options.
   action_client->impl->action_name = rcutils_strdup(action_name, allocator);
   if (NULL == action_client->impl->action_name) {
@@ -173,6 +301,12 @@ rcl_action_client_init(
   }
   action_client->impl->options = *options;
 
+  // Derive all topic and service names up front, in a single allocation.
+  ret = rcl_action_derive_names(action_name, allocator, &action_client->impl->derived_names);
+  if (RCL_RET_OK != ret) {
+    goto fail;  // error already set
+  }
+
   // Initialize action service clients.
   CLIENT_INIT(goal);
   CLIENT_INIT(cancel);
@@ -220,6 +354,11 @@ rcl_action_client_fini(rcl_action_client_t * action_client, rcl_node_t * node)
     ret = RCL_RET_ERROR;
   }
   rcl_allocator_t * allocator = &action_client->impl->options.allocator;
+  _pending_request_table_fini(&action_client->impl->goal_pending_requests, allocator);
+  _pending_request_table_fini(&action_client->impl->cancel_pending_requests, allocator);
+  _pending_request_table_fini(&action_client->impl->result_pending_requests, allocator);
+  (void)rcl_action_derived_names_fini(&action_client->impl->derived_names);
+  allocator->deallocate(action_client->impl->feedback_uuid_filter, allocator->state);
   allocator->deallocate(action_client->impl->action_name, allocator->state);
   allocator->deallocate(action_client->impl, allocator->state);
   action_client->impl = NULL;
@@ -381,6 +520,91 @@ rcl_action_take_cancel_response(
   TAKE_SERVICE_RESPONSE(cancel, response_header, ros_cancel_response);
 }
 
+// \internal Associates a caller cookie with a pending service request.
+#define REGISTER_REQUEST_COOKIE(Type) \
+  if (!rcl_action_client_is_valid(action_client)) { \
+    return RCL_RET_ACTION_CLIENT_INVALID;  /* error already set */ \
+  } \
+  return _pending_request_table_put( \
+    &action_client->impl->Type ## _pending_requests, \
+    &action_client->impl->options.allocator, \
+    sequence_number, \
+    cookie);
+
+// \internal Takes an action client specific service response and its cookie.
+#define TAKE_SERVICE_RESPONSE_WITH_COOKIE(Type, response_header, response, cookie) \
+  RCL_CHECK_ARGUMENT_FOR_NULL(cookie, RCL_RET_INVALID_ARGUMENT); \
+  rcl_ret_t take_ret = rcl_action_take_ ## Type ## _response( \
+    action_client, response_header, response); \
+  if (RCL_RET_OK != take_ret) { \
+    return take_ret;  /* error already set */ \
+  } \
+  if (!_pending_request_table_take( \
+      &action_client->impl->Type ## _pending_requests, \
+      response_header->sequence_number, \
+      cookie)) \
+  { \
+    *cookie = NULL; \
+  } \
+  return RCL_RET_OK;
+
+rcl_ret_t
+rcl_action_register_goal_request_cookie(
+  const rcl_action_client_t * action_client,
+  int64_t sequence_number,
+  void * cookie)
+{
+  REGISTER_REQUEST_COOKIE(goal);
+}
+
+rcl_ret_t
+rcl_action_take_goal_response_with_cookie(
+  const rcl_action_client_t * action_client,
+  rmw_request_id_t * response_header,
+  void * ros_goal_response,
+  void ** cookie)
+{
+  TAKE_SERVICE_RESPONSE_WITH_COOKIE(goal, response_header, ros_goal_response, cookie);
+}
+
+rcl_ret_t
+rcl_action_register_result_request_cookie(
+  const rcl_action_client_t * action_client,
+  int64_t sequence_number,
+  void * cookie)
+{
+  REGISTER_REQUEST_COOKIE(result);
+}
+
+rcl_ret_t
+rcl_action_take_result_response_with_cookie(
+  const rcl_action_client_t * action_client,
+  rmw_request_id_t * response_header,
+  void * ros_result_response,
+  void ** cookie)
+{
+  TAKE_SERVICE_RESPONSE_WITH_COOKIE(result, response_header, ros_result_response, cookie);
+}
+
+rcl_ret_t
+rcl_action_register_cancel_request_cookie(
+  const rcl_action_client_t * action_client,
+  int64_t sequence_number,
+  void * cookie)
+{
+  REGISTER_REQUEST_COOKIE(cancel);
+}
+
+rcl_ret_t
+rcl_action_take_cancel_response_with_cookie(
+  const rcl_action_client_t * action_client,
+  rmw_request_id_t * response_header,
+  void * ros_cancel_response,
+  void ** cookie)
+{
+  TAKE_SERVICE_RESPONSE_WITH_COOKIE(cancel, response_header, ros_cancel_response, cookie);
+}
+
 // \internal Takes an action client specific topic message.
 #define TAKE_MESSAGE(Type) \
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Taking action " #Type); \
@@ -403,12 +627,109 @@ rcl_action_take_cancel_response(
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Action " #Type " taken"); \
   return RCL_RET_OK;
 
+rcl_ret_t
+rcl_action_add_feedback_uuid(
+  const rcl_action_client_t * action_client,
+  const uint8_t * goal_uuid)
+{
+  if (!rcl_action_client_is_valid(action_client)) {
+    return RCL_RET_ACTION_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_uuid, RCL_RET_INVALID_ARGUMENT);
+  rcl_action_client_impl_t * impl = action_client->impl;
+  for (size_t i = 0; i < impl->num_feedback_uuid_filter; ++i) {
+    if (uuidcmp(&impl->feedback_uuid_filter[i * UUID_SIZE], goal_uuid)) {
+      return RCL_RET_OK;  // already registered
+    }
+  }
+  rcl_allocator_t allocator = impl->options.allocator;
+  if (impl->num_feedback_uuid_filter == impl->feedback_uuid_filter_capacity) {
+    size_t new_capacity = impl->feedback_uuid_filter_capacity ?
+      2 * impl->feedback_uuid_filter_capacity : 8;
+    uint8_t * grown = allocator.reallocate(
+      impl->feedback_uuid_filter, new_capacity * UUID_SIZE, allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      grown, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    impl->feedback_uuid_filter = grown;
+    impl->feedback_uuid_filter_capacity = new_capacity;
+  }
+  memcpy(
+    &impl->feedback_uuid_filter[impl->num_feedback_uuid_filter * UUID_SIZE],
+    goal_uuid, UUID_SIZE);
+  ++impl->num_feedback_uuid_filter;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_remove_feedback_uuid(
+  const rcl_action_client_t * action_client,
+  const uint8_t * goal_uuid)
+{
+  if (!rcl_action_client_is_valid(action_client)) {
+    return RCL_RET_ACTION_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_uuid, RCL_RET_INVALID_ARGUMENT);
+  rcl_action_client_impl_t * impl = action_client->impl;
+  for (size_t i = 0; i < impl->num_feedback_uuid_filter; ++i) {
+    if (uuidcmp(&impl->feedback_uuid_filter[i * UUID_SIZE], goal_uuid)) {
+      // Order is irrelevant, so fill the hole with the last entry.
+      --impl->num_feedback_uuid_filter;
+      memcpy(
+        &impl->feedback_uuid_filter[i * UUID_SIZE],
+        &impl->feedback_uuid_filter[impl->num_feedback_uuid_filter * UUID_SIZE],
+        UUID_SIZE);
+      return RCL_RET_OK;
+    }
+  }
+  RCL_SET_ERROR_MSG("goal uuid is not registered for feedback");
+  return RCL_RET_INVALID_ARGUMENT;
+}
+
 rcl_ret_t
 rcl_action_take_feedback(
   const rcl_action_client_t * action_client,
   void * ros_feedback)
 {
-  TAKE_MESSAGE(feedback);
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Taking action feedback");
+  if (!rcl_action_client_is_valid(action_client)) {
+    return RCL_RET_ACTION_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_feedback, RCL_RET_INVALID_ARGUMENT);
+  const rcl_action_client_impl_t * impl = action_client->impl;
+  rmw_message_info_t message_info;  // ignored
+  // With an interest set registered, messages for other goals are dropped
+  // here and the queue is drained until a match or it runs empty, so one
+  // call never reports a message the caller would discard.
+  for (;;) {
+    rcl_ret_t ret = rcl_take(
+      &impl->feedback_subscription, ros_feedback, &message_info, NULL);
+    if (RCL_RET_OK != ret) {
+      if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
+        return RCL_RET_ACTION_CLIENT_TAKE_FAILED;
+      }
+      if (RCL_RET_BAD_ALLOC == ret) {
+        return RCL_RET_BAD_ALLOC;
+      }
+      return RCL_RET_ERROR;
+    }
+    if (0 == impl->num_feedback_uuid_filter) {
+      break;  // no filter registered, deliver everything
+    }
+    // The generated FeedbackMessage struct leads with the goal UUID.
+    const uint8_t * uuid = (const uint8_t *)ros_feedback;
+    bool matched = false;
+    for (size_t i = 0; i < impl->num_feedback_uuid_filter; ++i) {
+      if (uuidcmp(&impl->feedback_uuid_filter[i * UUID_SIZE], uuid)) {
+        matched = true;
+        break;
+      }
+    }
+    if (matched) {
+      break;
+    }
+  }
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Action feedback taken");
+  return RCL_RET_OK;
 }
 
 rcl_ret_t
@@ -428,6 +749,15 @@ rcl_action_client_get_action_name(const rcl_action_client_t * action_client)
   return action_client->impl->action_name;
 }
 
+const rcl_action_derived_names_t *
+rcl_action_client_get_derived_names(const rcl_action_client_t * action_client)
+{
+  if (!rcl_action_client_is_valid(action_client)) {
+    return NULL;
+  }
+  return &action_client->impl->derived_names;
+}
+
 const rcl_action_client_options_t *
 rcl_action_client_get_options(const rcl_action_client_t * action_client)
 {
@@ -622,6 +952,128 @@ rcl_action_client_wait_set_get_entities_ready(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_action_client_wait_set_token_init(
+  rcl_action_client_wait_set_token_t * token,
+  const rcl_action_client_t * action_client)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(token, RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_action_client_is_valid(action_client)) {
+    return RCL_RET_ACTION_CLIENT_INVALID;  // error already set
+  }
+  const rcl_action_client_impl_t * impl = action_client->impl;
+  rcl_ret_t ret = rcl_wait_set_entity_token_init(
+    &token->goal_client_token, RCL_WAIT_SET_CLIENT, &impl->goal_client);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  ret = rcl_wait_set_entity_token_init(
+    &token->cancel_client_token, RCL_WAIT_SET_CLIENT, &impl->cancel_client);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  ret = rcl_wait_set_entity_token_init(
+    &token->result_client_token, RCL_WAIT_SET_CLIENT, &impl->result_client);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  ret = rcl_wait_set_entity_token_init(
+    &token->feedback_subscription_token, RCL_WAIT_SET_SUBSCRIPTION, &impl->feedback_subscription);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  ret = rcl_wait_set_entity_token_init(
+    &token->status_subscription_token, RCL_WAIT_SET_SUBSCRIPTION, &impl->status_subscription);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  token->goal_client_index = 0u;
+  token->cancel_client_index = 0u;
+  token->result_client_index = 0u;
+  token->feedback_subscription_index = 0u;
+  token->status_subscription_index = 0u;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_wait_set_add_action_client_token(
+  rcl_wait_set_t * wait_set,
+  rcl_action_client_wait_set_token_t * token)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_WAIT_SET_INVALID);
+  RCL_CHECK_ARGUMENT_FOR_NULL(token, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = rcl_wait_set_add_token(
+    wait_set, &token->goal_client_token, &token->goal_client_index);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  ret = rcl_wait_set_add_token(
+    wait_set, &token->cancel_client_token, &token->cancel_client_index);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  ret = rcl_wait_set_add_token(
+    wait_set, &token->result_client_token, &token->result_client_index);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  ret = rcl_wait_set_add_token(
+    wait_set, &token->feedback_subscription_token, &token->feedback_subscription_index);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  ret = rcl_wait_set_add_token(
+    wait_set, &token->status_subscription_token, &token->status_subscription_index);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_client_wait_set_get_ready_bitmask(
+  const rcl_wait_set_t * wait_set,
+  const rcl_action_client_wait_set_token_t * token,
+  uint32_t * ready_bitmask)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_WAIT_SET_INVALID);
+  RCL_CHECK_ARGUMENT_FOR_NULL(token, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ready_bitmask, RCL_RET_INVALID_ARGUMENT);
+  if (token->goal_client_index >= wait_set->size_of_clients ||
+    token->cancel_client_index >= wait_set->size_of_clients ||
+    token->result_client_index >= wait_set->size_of_clients ||
+    token->feedback_subscription_index >= wait_set->size_of_subscriptions ||
+    token->status_subscription_index >= wait_set->size_of_subscriptions)
+  {
+    RCL_SET_ERROR_MSG("wait set index recorded in the token is out of bounds");
+    return RCL_RET_ERROR;
+  }
+  uint32_t bitmask = 0u;
+  if (wait_set->clients[token->goal_client_index] == token->goal_client_token.entity) {
+    bitmask |= RCL_ACTION_CLIENT_GOAL_RESPONSE_READY;
+  }
+  if (wait_set->clients[token->cancel_client_index] == token->cancel_client_token.entity) {
+    bitmask |= RCL_ACTION_CLIENT_CANCEL_RESPONSE_READY;
+  }
+  if (wait_set->clients[token->result_client_index] == token->result_client_token.entity) {
+    bitmask |= RCL_ACTION_CLIENT_RESULT_RESPONSE_READY;
+  }
+  if (
+    wait_set->subscriptions[token->feedback_subscription_index] ==
+    token->feedback_subscription_token.entity)
+  {
+    bitmask |= RCL_ACTION_CLIENT_FEEDBACK_READY;
+  }
+  if (
+    wait_set->subscriptions[token->status_subscription_index] ==
+    token->status_subscription_token.entity)
+  {
+    bitmask |= RCL_ACTION_CLIENT_STATUS_READY;
+  }
+  *ready_bitmask = bitmask;
+  return RCL_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
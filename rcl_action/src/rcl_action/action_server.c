@@ -19,6 +19,9 @@ extern "C"
 
 #include "rcl_action/action_server.h"
 
+#include <stddef.h>
+#include <string.h>
+
 #include "rcl_action/default_qos.h"
 #include "rcl_action/goal_handle.h"
 #include "rcl_action/names.h"
@@ -34,6 +37,187 @@ extern "C"
 
 #include "rmw/rmw.h"
 
+#include "./goal_handle_impl.h"
+
+// Implementation only
+// Free list of blocks recycled between expired and newly accepted goal
+// handles. Blocks are handed out through an rcl_allocator_t facade so
+// rcl_action_goal_handle_init() and rcl_action_goal_handle_fini() return
+// their memory to the pool without knowing about it.
+typedef struct goal_handle_pool_t
+{
+  // Singly linked list threaded through the bodies of the free blocks
+  void * free_list;
+  size_t num_free_blocks;
+  // At most this many blocks are kept for reuse; zero disables pooling
+  size_t max_free_blocks;
+  rcl_allocator_t base_allocator;
+} goal_handle_pool_t;
+
+// Prefixed to every block so the pool knows the block size when it is
+// returned, while keeping the block body suitably aligned for any object
+typedef union goal_handle_pool_block_header_t
+{
+  size_t size;
+  max_align_t alignment;
+} goal_handle_pool_block_header_t;
+
+// Implementation only
+static void *
+_goal_handle_pool_allocate(size_t size, void * state)
+{
+  goal_handle_pool_t * pool = (goal_handle_pool_t *)state;
+  if (size < sizeof(void *)) {
+    // Block bodies must be able to hold a free list link
+    size = sizeof(void *);
+  }
+  // First fit from the free list; it holds at most max_free_blocks entries
+  void * prev = NULL;
+  void * block = pool->free_list;
+  while (NULL != block) {
+    goal_handle_pool_block_header_t * block_header =
+      ((goal_handle_pool_block_header_t *)block) - 1;
+    void * next = *(void **)block;
+    if (block_header->size >= size) {
+      if (NULL != prev) {
+        *(void **)prev = next;
+      } else {
+        pool->free_list = next;
+      }
+      --pool->num_free_blocks;
+      return block;
+    }
+    prev = block;
+    block = next;
+  }
+  goal_handle_pool_block_header_t * header =
+    (goal_handle_pool_block_header_t *)pool->base_allocator.allocate(
+    sizeof(goal_handle_pool_block_header_t) + size, pool->base_allocator.state);
+  if (!header) {
+    return NULL;
+  }
+  header->size = size;
+  return (void *)(header + 1);
+}
+
+// Implementation only
+static void
+_goal_handle_pool_deallocate(void * pointer, void * state)
+{
+  goal_handle_pool_t * pool = (goal_handle_pool_t *)state;
+  if (NULL == pointer) {
+    return;
+  }
+  goal_handle_pool_block_header_t * header =
+    ((goal_handle_pool_block_header_t *)pointer) - 1;
+  if (pool->num_free_blocks < pool->max_free_blocks) {
+    *(void **)pointer = pool->free_list;
+    pool->free_list = pointer;
+    ++pool->num_free_blocks;
+    return;
+  }
+  pool->base_allocator.deallocate(header, pool->base_allocator.state);
+}
+
+// Implementation only
+static void *
+_goal_handle_pool_reallocate(void * pointer, size_t size, void * state)
+{
+  if (NULL == pointer) {
+    return _goal_handle_pool_allocate(size, state);
+  }
+  goal_handle_pool_block_header_t * header =
+    ((goal_handle_pool_block_header_t *)pointer) - 1;
+  if (header->size >= size) {
+    return pointer;
+  }
+  void * new_block = _goal_handle_pool_allocate(size, state);
+  if (NULL != new_block) {
+    memcpy(new_block, pointer, header->size);
+    _goal_handle_pool_deallocate(pointer, state);
+  }
+  return new_block;
+}
+
+// Implementation only
+static void *
+_goal_handle_pool_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  const size_t size = number_of_elements * size_of_element;
+  void * block = _goal_handle_pool_allocate(size, state);
+  if (NULL != block) {
+    memset(block, 0, size);
+  }
+  return block;
+}
+
+// Implementation only
+static void
+_goal_handle_pool_init(
+  goal_handle_pool_t * pool, const size_t pool_size, const rcl_allocator_t base_allocator)
+{
+  pool->free_list = NULL;
+  pool->num_free_blocks = 0u;
+  // Each accepted goal uses two blocks: the goal handle and its impl
+  pool->max_free_blocks = 2u * pool_size;
+  pool->base_allocator = base_allocator;
+}
+
+// Implementation only
+static void
+_goal_handle_pool_fini(goal_handle_pool_t * pool)
+{
+  void * block = pool->free_list;
+  while (NULL != block) {
+    void * next = *(void **)block;
+    goal_handle_pool_block_header_t * header =
+      ((goal_handle_pool_block_header_t *)block) - 1;
+    pool->base_allocator.deallocate(header, pool->base_allocator.state);
+    block = next;
+  }
+  pool->free_list = NULL;
+  pool->num_free_blocks = 0u;
+}
+
+// Implementation only
+// Return an rcl allocator that serves goal handle allocations from the pool
+static rcl_allocator_t
+_goal_handle_pool_get_allocator(goal_handle_pool_t * pool)
+{
+  rcl_allocator_t allocator = pool->base_allocator;
+  allocator.allocate = _goal_handle_pool_allocate;
+  allocator.deallocate = _goal_handle_pool_deallocate;
+  allocator.reallocate = _goal_handle_pool_reallocate;
+  allocator.zero_allocate = _goal_handle_pool_zero_allocate;
+  allocator.state = pool;
+  return allocator;
+}
+
+// Implementation only
+// Entry in the min-heap of goal expiry deadlines
+typedef struct goal_expiry_entry_t
+{
+  int64_t deadline;
+  uint8_t uuid[UUID_SIZE];
+} goal_expiry_entry_t;
+
+// Implementation only
+// A caller-provided result response kept to answer repeat result requests
+// for a terminal goal without involving the application again.
+typedef struct cached_result_entry_t
+{
+  uint8_t uuid[UUID_SIZE];
+  void * ros_response;
+} cached_result_entry_t;
+
+// Implementation only
+// A goal acceptance stamp, kept in acceptance order for time-ranged cancels.
+typedef struct goal_stamp_entry_t
+{
+  int64_t stamp;
+  uint8_t uuid[UUID_SIZE];
+} goal_stamp_entry_t;
+
 /// Internal rcl_action implementation struct.
 typedef struct rcl_action_server_impl_t
 {
@@ -42,12 +226,48 @@ typedef struct rcl_action_server_impl_t
   rcl_service_t result_service;
   rcl_publisher_t feedback_publisher;
   rcl_publisher_t status_publisher;
+  // Message type supports kept so loaned messages can be borrowed after init
+  const rosidl_message_type_support_t * feedback_message_type_support;
+  const rosidl_message_type_support_t * status_message_type_support;
   rcl_timer_t expire_timer;
   char * action_name;
+  // Topic and service names derived from the action name, in one allocation
+  rcl_action_derived_names_t derived_names;
   rcl_action_server_options_t options;
   // Array of goal handles
   rcl_action_goal_handle_t ** goal_handles;
   size_t num_goal_handles;
+  // Allocated capacity of the goal handle array
+  size_t goal_handle_capacity;
+  // Open-addressed hash index of goal handle array positions keyed by goal UUID.
+  // Buckets store the array index plus one, with zero marking an empty bucket.
+  size_t * goal_index_buckets;
+  size_t num_goal_index_buckets;
+  // Pool of recycled goal handle allocations and the facade used to allocate from it
+  goal_handle_pool_t goal_handle_pool;
+  rcl_allocator_t goal_handle_allocator;
+  // Status array kept between calls so its storage can be reused
+  rcl_action_goal_status_array_t status_array;
+  // Min-heap of goal expiry deadlines, earliest at the root
+  goal_expiry_entry_t * expiry_heap;
+  size_t expiry_heap_size;
+  size_t expiry_heap_capacity;
+  // Result responses cached for terminal goals, dropped when the goal expires
+  cached_result_entry_t * cached_results;
+  size_t num_cached_results;
+  size_t cached_results_capacity;
+  // Goal acceptance stamps in ascending order; goals are re-stamped with the
+  // current time when accepted so appending keeps the array sorted. Entries
+  // for goals no longer tracked are dropped lazily during cancel processing.
+  goal_stamp_entry_t * stamp_index;
+  size_t stamp_index_size;
+  size_t stamp_index_capacity;
+  // False when the index could not be maintained; cancels fall back to a scan
+  bool stamp_index_valid;
+  // Scratch array reused by rcl_action_process_cancel_request() so a cancel
+  // does not allocate a temporary goal handle array per call
+  rcl_action_goal_handle_t ** cancel_scratch;
+  size_t cancel_scratch_capacity;
   // Clock
   rcl_clock_t clock;
   // Wait set records
@@ -65,18 +285,6 @@ rcl_action_get_zero_initialized_server(void)
 }
 
 #define SERVICE_INIT(Type) \
-  char * Type ## _service_name = NULL; \
-  ret = rcl_action_get_ ## Type ## _service_name(action_name, allocator, &Type ## _service_name); \
-  if (RCL_RET_OK != ret) { \
-    if (RCL_RET_BAD_ALLOC == ret) { \
-      ret = RCL_RET_BAD_ALLOC; \
-    } else if (RCL_RET_ACTION_NAME_INVALID == ret) { \
-      ret = RCL_RET_ACTION_NAME_INVALID; \
-    } else { \
-      ret = RCL_RET_ERROR; \
-    } \
-    goto fail; \
-  } \
   rcl_service_options_t Type ## _service_options = { \
     .qos = options->Type ## _service_qos, .allocator = allocator \
   }; \
@@ -84,9 +292,8 @@ rcl_action_get_zero_initialized_server(void)
     &action_server->impl->Type ## _service, \
     node, \
     type_support->Type ## _service_type_support, \
-    Type ## _service_name, \
+    action_server->impl->derived_names.Type ## _service_name, \
     &Type ## _service_options); \
-  allocator.deallocate(Type ## _service_name, allocator.state); \
   if (RCL_RET_OK != ret) { \
     if (RCL_RET_BAD_ALLOC == ret) { \
       ret = RCL_RET_BAD_ALLOC; \
@@ -99,18 +306,6 @@ rcl_action_get_zero_initialized_server(void)
   }
 
 #define PUBLISHER_INIT(Type) \
-  char * Type ## _topic_name = NULL; \
-  ret = rcl_action_get_ ## Type ## _topic_name(action_name, allocator, &Type ## _topic_name); \
-  if (RCL_RET_OK != ret) { \
-    if (RCL_RET_BAD_ALLOC == ret) { \
-      ret = RCL_RET_BAD_ALLOC; \
-    } else if (RCL_RET_ACTION_NAME_INVALID == ret) { \
-      ret = RCL_RET_ACTION_NAME_INVALID; \
-    } else { \
-      ret = RCL_RET_ERROR; \
-    } \
-    goto fail; \
-  } \
   rcl_publisher_options_t Type ## _publisher_options = { \
     .qos = options->Type ## _topic_qos, .allocator = allocator \
   }; \
@@ -118,9 +313,8 @@ rcl_action_get_zero_initialized_server(void)
     &action_server->impl->Type ## _publisher, \
     node, \
     type_support->Type ## _message_type_support, \
-    Type ## _topic_name, \
+    action_server->impl->derived_names.Type ## _topic_name, \
     &Type ## _publisher_options); \
-  allocator.deallocate(Type ## _topic_name, allocator.state); \
   if (RCL_RET_OK != ret) { \
     if (RCL_RET_BAD_ALLOC == ret) { \
       ret = RCL_RET_BAD_ALLOC; \
@@ -175,13 +369,43 @@ rcl_action_server_init(
   action_server->impl->expire_timer = rcl_get_zero_initialized_timer();
   action_server->impl->feedback_publisher = rcl_get_zero_initialized_publisher();
   action_server->impl->status_publisher = rcl_get_zero_initialized_publisher();
+  action_server->impl->feedback_message_type_support = NULL;
+  action_server->impl->status_message_type_support = NULL;
   action_server->impl->action_name = NULL;
+  action_server->impl->derived_names = rcl_action_get_zero_initialized_derived_names();
   action_server->impl->options = *options;  // copy options
   action_server->impl->goal_handles = NULL;
   action_server->impl->num_goal_handles = 0u;
+  action_server->impl->goal_handle_capacity = 0u;
+  action_server->impl->goal_index_buckets = NULL;
+  action_server->impl->num_goal_index_buckets = 0u;
+  _goal_handle_pool_init(
+    &action_server->impl->goal_handle_pool, options->goal_handle_pool_size, allocator);
+  action_server->impl->goal_handle_allocator =
+    _goal_handle_pool_get_allocator(&action_server->impl->goal_handle_pool);
+  action_server->impl->status_array = rcl_action_get_zero_initialized_goal_status_array();
+  action_server->impl->status_array.allocator = allocator;
+  action_server->impl->expiry_heap = NULL;
+  action_server->impl->expiry_heap_size = 0u;
+  action_server->impl->expiry_heap_capacity = 0u;
+  action_server->impl->cached_results = NULL;
+  action_server->impl->num_cached_results = 0u;
+  action_server->impl->cached_results_capacity = 0u;
+  action_server->impl->stamp_index = NULL;
+  action_server->impl->stamp_index_size = 0u;
+  action_server->impl->stamp_index_capacity = 0u;
+  action_server->impl->stamp_index_valid = true;
+  action_server->impl->cancel_scratch = NULL;
+  action_server->impl->cancel_scratch_capacity = 0u;
   action_server->impl->clock.type = RCL_CLOCK_UNINITIALIZED;
 
-  rcl_ret_t ret = RCL_RET_OK;
+  // Derive all topic and service names up front, in a single allocation
+  rcl_ret_t ret = rcl_action_derive_names(
+    action_name, allocator, &action_server->impl->derived_names);
+  if (RCL_RET_OK != ret) {
+    goto fail;  // error already set
+  }
+
   // Initialize services
   SERVICE_INIT(goal);
   SERVICE_INIT(cancel);
@@ -190,11 +414,13 @@ rcl_action_server_init(
   // Initialize publishers
   PUBLISHER_INIT(feedback);
   PUBLISHER_INIT(status);
+  action_server->impl->feedback_message_type_support = type_support->feedback_message_type_support;
+  action_server->impl->status_message_type_support = type_support->status_message_type_support;
 
   // Initialize Timer
   ret = rcl_timer_init(
     &action_server->impl->expire_timer, clock, node->context, options->result_timeout.nanoseconds,
-    NULL, allocator);
+    0, NULL, allocator);
   if (RCL_RET_OK != ret) {
     goto fail;
   }
@@ -262,12 +488,38 @@ rcl_action_server_fini(rcl_action_server_t * action_server, rcl_node_t * node)
       allocator.deallocate(action_server->impl->action_name, allocator.state);
       action_server->impl->action_name = NULL;
     }
+    // Deallocate derived names
+    (void)rcl_action_derived_names_fini(&action_server->impl->derived_names);
     // Deallocate goal handles storage, but don't fini them.
     for (size_t i = 0; i < action_server->impl->num_goal_handles; ++i) {
-      allocator.deallocate(action_server->impl->goal_handles[i], allocator.state);
+      action_server->impl->goal_handle_allocator.deallocate(
+        action_server->impl->goal_handles[i],
+        action_server->impl->goal_handle_allocator.state);
     }
     allocator.deallocate(action_server->impl->goal_handles, allocator.state);
     action_server->impl->goal_handles = NULL;
+    // Deallocate goal UUID index
+    allocator.deallocate(action_server->impl->goal_index_buckets, allocator.state);
+    action_server->impl->goal_index_buckets = NULL;
+    // Release any pooled goal handle blocks
+    _goal_handle_pool_fini(&action_server->impl->goal_handle_pool);
+    // Deallocate the cached status array
+    if (action_server->impl->status_array.msg.status_list.data) {
+      allocator.deallocate(
+        action_server->impl->status_array.msg.status_list.data, allocator.state);
+      action_server->impl->status_array.msg.status_list.data = NULL;
+    }
+    // Deallocate the expiry deadline heap
+    allocator.deallocate(action_server->impl->expiry_heap, allocator.state);
+    action_server->impl->expiry_heap = NULL;
+    // Deallocate the result response cache; the responses are caller-owned
+    allocator.deallocate(action_server->impl->cached_results, allocator.state);
+    action_server->impl->cached_results = NULL;
+    // Deallocate the acceptance stamp index and the cancel scratch array
+    allocator.deallocate(action_server->impl->stamp_index, allocator.state);
+    action_server->impl->stamp_index = NULL;
+    allocator.deallocate(action_server->impl->cancel_scratch, allocator.state);
+    action_server->impl->cancel_scratch = NULL;
     // Deallocate struct
     allocator.deallocate(action_server->impl, allocator.state);
     action_server->impl = NULL;
@@ -287,6 +539,7 @@ rcl_action_server_get_default_options(void)
   default_options.status_topic_qos = rcl_action_qos_profile_status_default;
   default_options.allocator = rcl_get_default_allocator();
   default_options.result_timeout.nanoseconds = RCUTILS_S_TO_NS(15 * 60);  // 15 minutes
+  default_options.goal_handle_pool_size = 0u;  // goal handle pooling disabled
   return default_options;
 }
 
@@ -358,6 +611,249 @@ _nanosec_to_goal_info_stamp(const int64_t * nanosec, rcl_action_goal_info_t * go
   goal_info->stamp.nanosec = *nanosec % RCUTILS_S_TO_NS(1);
 }
 
+// Implementation only
+static uint64_t
+_goal_uuid_hash(const uint8_t * uuid)
+{
+  // FNV-1a over the uuid bytes
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0u; i < UUID_SIZE; ++i) {
+    hash = (hash ^ (uint64_t)uuid[i]) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// Implementation only
+static void
+_goal_index_free(rcl_action_server_impl_t * impl)
+{
+  rcl_allocator_t allocator = impl->options.allocator;
+  if (impl->goal_index_buckets) {
+    allocator.deallocate(impl->goal_index_buckets, allocator.state);
+    impl->goal_index_buckets = NULL;
+  }
+  impl->num_goal_index_buckets = 0u;
+}
+
+// Implementation only
+// Insert the goal handle at the given array position into the UUID index.
+// The caller ensures the index exists and has a free bucket.
+static rcl_ret_t
+_goal_index_insert(rcl_action_server_impl_t * impl, const size_t handle_index)
+{
+  rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
+  rcl_ret_t ret = rcl_action_goal_handle_get_info(impl->goal_handles[handle_index], &goal_info);
+  if (RCL_RET_OK != ret) {
+    return RCL_RET_ERROR;  // error already set
+  }
+  const size_t mask = impl->num_goal_index_buckets - 1u;
+  size_t bucket = (size_t)(_goal_uuid_hash(goal_info.goal_id.uuid) & (uint64_t)mask);
+  while (0u != impl->goal_index_buckets[bucket]) {
+    bucket = (bucket + 1u) & mask;
+  }
+  impl->goal_index_buckets[bucket] = handle_index + 1u;
+  return RCL_RET_OK;
+}
+
+// Implementation only
+// Rebuild the UUID index over the current goal handle array, sized to stay at
+// most half full with min_num_goal_handles entries so probe chains stay short.
+// On failure the index is freed and lookups fall back to a linear scan.
+static rcl_ret_t
+_goal_index_rebuild(rcl_action_server_impl_t * impl, const size_t min_num_goal_handles)
+{
+  rcl_allocator_t allocator = impl->options.allocator;
+  _goal_index_free(impl);
+  size_t num_buckets = 2u;
+  while (num_buckets < (2u * min_num_goal_handles)) {
+    num_buckets *= 2u;
+  }
+  impl->goal_index_buckets = (size_t *)allocator.zero_allocate(
+    num_buckets, sizeof(size_t), allocator.state);
+  if (!impl->goal_index_buckets) {
+    RCL_SET_ERROR_MSG("memory allocation failed for goal UUID index");
+    return RCL_RET_BAD_ALLOC;
+  }
+  impl->num_goal_index_buckets = num_buckets;
+  for (size_t i = 0u; i < impl->num_goal_handles; ++i) {
+    if (RCL_RET_OK != _goal_index_insert(impl, i)) {
+      _goal_index_free(impl);
+      return RCL_RET_ERROR;  // error already set
+    }
+  }
+  return RCL_RET_OK;
+}
+
+// Implementation only
+// Look up the array position of the goal handle with the given UUID.
+// The caller ensures the index exists.
+static bool
+_goal_index_find(
+  const rcl_action_server_impl_t * impl, const uint8_t * uuid, size_t * handle_index)
+{
+  const size_t mask = impl->num_goal_index_buckets - 1u;
+  size_t bucket = (size_t)(_goal_uuid_hash(uuid) & (uint64_t)mask);
+  rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
+  while (0u != impl->goal_index_buckets[bucket]) {
+    const size_t candidate = impl->goal_index_buckets[bucket] - 1u;
+    // Slots can be cleared while goals are being expired
+    if (NULL != impl->goal_handles[candidate]) {
+      rcl_ret_t ret = rcl_action_goal_handle_get_info(impl->goal_handles[candidate], &goal_info);
+      if (RCL_RET_OK == ret && uuidcmp(uuid, goal_info.goal_id.uuid)) {
+        *handle_index = candidate;
+        return true;
+      }
+    }
+    bucket = (bucket + 1u) & mask;
+  }
+  return false;
+}
+
+// Implementation only
+// Push a goal's expiry deadline onto the min-heap.
+static rcl_ret_t
+_expiry_heap_push(rcl_action_server_impl_t * impl, const int64_t deadline, const uint8_t * uuid)
+{
+  rcl_allocator_t allocator = impl->options.allocator;
+  if (impl->expiry_heap_size == impl->expiry_heap_capacity) {
+    const size_t new_capacity =
+      (0u == impl->expiry_heap_capacity) ? 1u : (2u * impl->expiry_heap_capacity);
+    void * tmp_ptr = allocator.reallocate(
+      impl->expiry_heap, new_capacity * sizeof(goal_expiry_entry_t), allocator.state);
+    if (!tmp_ptr) {
+      RCL_SET_ERROR_MSG("memory allocation failed for goal expiry heap");
+      return RCL_RET_BAD_ALLOC;
+    }
+    impl->expiry_heap = (goal_expiry_entry_t *)tmp_ptr;
+    impl->expiry_heap_capacity = new_capacity;
+  }
+  // Sift the new entry up towards the root
+  size_t i = impl->expiry_heap_size++;
+  while (i > 0u) {
+    const size_t parent = (i - 1u) / 2u;
+    if (impl->expiry_heap[parent].deadline <= deadline) {
+      break;
+    }
+    impl->expiry_heap[i] = impl->expiry_heap[parent];
+    i = parent;
+  }
+  impl->expiry_heap[i].deadline = deadline;
+  memcpy(impl->expiry_heap[i].uuid, uuid, UUID_SIZE);
+  return RCL_RET_OK;
+}
+
+// Implementation only
+// Remove the earliest deadline from the min-heap.
+// The caller checks that the heap is not empty.
+static void
+_expiry_heap_pop(rcl_action_server_impl_t * impl, goal_expiry_entry_t * entry)
+{
+  *entry = impl->expiry_heap[0];
+  const goal_expiry_entry_t last = impl->expiry_heap[--impl->expiry_heap_size];
+  if (0u == impl->expiry_heap_size) {
+    return;
+  }
+  // Sift the displaced last entry down from the root
+  size_t i = 0u;
+  for (;;) {
+    const size_t left = (2u * i) + 1u;
+    const size_t right = left + 1u;
+    size_t smallest = i;
+    int64_t smallest_deadline = last.deadline;
+    if (left < impl->expiry_heap_size && impl->expiry_heap[left].deadline < smallest_deadline) {
+      smallest = left;
+      smallest_deadline = impl->expiry_heap[left].deadline;
+    }
+    if (right < impl->expiry_heap_size && impl->expiry_heap[right].deadline < smallest_deadline) {
+      smallest = right;
+    }
+    if (smallest == i) {
+      break;
+    }
+    impl->expiry_heap[i] = impl->expiry_heap[smallest];
+    i = smallest;
+  }
+  impl->expiry_heap[i] = last;
+}
+
+// Implementation only
+// Resolve a goal UUID to its position in the goal handle array, using the
+// hash index when it is available and a linear scan otherwise.
+static bool
+_find_goal_by_uuid(
+  const rcl_action_server_impl_t * impl, const uint8_t * uuid, size_t * handle_index)
+{
+  if (NULL != impl->goal_index_buckets) {
+    return _goal_index_find(impl, uuid, handle_index);
+  }
+  rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
+  for (size_t i = 0u; i < impl->num_goal_handles; ++i) {
+    if (NULL == impl->goal_handles[i]) {
+      continue;
+    }
+    if (RCL_RET_OK != rcl_action_goal_handle_get_info(impl->goal_handles[i], &goal_info)) {
+      continue;
+    }
+    if (uuidcmp(uuid, goal_info.goal_id.uuid)) {
+      *handle_index = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Implementation only
+// Append a goal's acceptance stamp to the ordered index.
+// On failure the index is disabled and time-ranged cancels fall back to
+// scanning the goal handle array; accepting the goal is not affected.
+static void
+_stamp_index_append(rcl_action_server_impl_t * impl, const int64_t stamp, const uint8_t * uuid)
+{
+  if (!impl->stamp_index_valid) {
+    return;
+  }
+  if (impl->stamp_index_size > 0u &&
+    impl->stamp_index[impl->stamp_index_size - 1u].stamp > stamp)
+  {
+    // A clock jump broke the ordering; disable rather than serve wrong ranges
+    impl->stamp_index_valid = false;
+    return;
+  }
+  rcl_allocator_t allocator = impl->options.allocator;
+  if (impl->stamp_index_size == impl->stamp_index_capacity) {
+    const size_t new_capacity =
+      (0u == impl->stamp_index_capacity) ? 8u : (2u * impl->stamp_index_capacity);
+    void * tmp_ptr = allocator.reallocate(
+      impl->stamp_index, new_capacity * sizeof(goal_stamp_entry_t), allocator.state);
+    if (!tmp_ptr) {
+      allocator.deallocate(impl->stamp_index, allocator.state);
+      impl->stamp_index = NULL;
+      impl->stamp_index_size = 0u;
+      impl->stamp_index_capacity = 0u;
+      impl->stamp_index_valid = false;
+      return;
+    }
+    impl->stamp_index = (goal_stamp_entry_t *)tmp_ptr;
+    impl->stamp_index_capacity = new_capacity;
+  }
+  impl->stamp_index[impl->stamp_index_size].stamp = stamp;
+  memcpy(impl->stamp_index[impl->stamp_index_size].uuid, uuid, UUID_SIZE);
+  ++impl->stamp_index_size;
+}
+
+// Implementation only
+// Drop the stamp index entry at the given position, keeping the order.
+static void
+_stamp_index_remove_at(rcl_action_server_impl_t * impl, const size_t index)
+{
+  --impl->stamp_index_size;
+  if (index < impl->stamp_index_size) {
+    memmove(
+      &impl->stamp_index[index], &impl->stamp_index[index + 1u],
+      (impl->stamp_index_size - index) * sizeof(goal_stamp_entry_t));
+  }
+}
+
 rcl_action_goal_handle_t *
 rcl_action_accept_new_goal(
   rcl_action_server_t * action_server,
@@ -374,23 +870,29 @@ rcl_action_accept_new_goal(
     return NULL;
   }
 
-  // Allocate space in the goal handle pointer array
+  // Grow the goal handle pointer array if needed, doubling the capacity so
+  // accepting a goal does not reallocate the whole array every time
   rcl_allocator_t allocator = action_server->impl->options.allocator;
   rcl_action_goal_handle_t ** goal_handles = action_server->impl->goal_handles;
   const size_t num_goal_handles = action_server->impl->num_goal_handles;
-  // TODO(jacobperron): Don't allocate for every accepted goal handle,
-  //                    instead double the memory allocated if needed.
   const size_t new_num_goal_handles = num_goal_handles + 1u;
-  void * tmp_ptr = allocator.reallocate(
-    goal_handles, new_num_goal_handles * sizeof(rcl_action_goal_handle_t *), allocator.state);
-  if (!tmp_ptr) {
-    RCL_SET_ERROR_MSG("memory allocation failed for goal handle pointer");
-    return NULL;
+  if (new_num_goal_handles > action_server->impl->goal_handle_capacity) {
+    const size_t old_capacity = action_server->impl->goal_handle_capacity;
+    const size_t new_capacity = (0u == old_capacity) ? 1u : (2u * old_capacity);
+    void * grown_ptr = allocator.reallocate(
+      goal_handles, new_capacity * sizeof(rcl_action_goal_handle_t *), allocator.state);
+    if (!grown_ptr) {
+      RCL_SET_ERROR_MSG("memory allocation failed for goal handle pointer");
+      return NULL;
+    }
+    goal_handles = (rcl_action_goal_handle_t **)grown_ptr;
+    action_server->impl->goal_handles = goal_handles;
+    action_server->impl->goal_handle_capacity = new_capacity;
   }
-  goal_handles = (rcl_action_goal_handle_t **)tmp_ptr;
 
-  // Allocate space for a new goal handle
-  tmp_ptr = allocator.allocate(sizeof(rcl_action_goal_handle_t), allocator.state);
+  // Allocate space for a new goal handle, reusing a pooled block if one is available
+  void * tmp_ptr = action_server->impl->goal_handle_allocator.allocate(
+    sizeof(rcl_action_goal_handle_t), action_server->impl->goal_handle_allocator.state);
   if (!tmp_ptr) {
     RCL_SET_ERROR_MSG("memory allocation failed for new goal handle");
     return NULL;
@@ -410,14 +912,42 @@ rcl_action_accept_new_goal(
   // Create a new goal handle
   *goal_handles[num_goal_handles] = rcl_action_get_zero_initialized_goal_handle();
   ret = rcl_action_goal_handle_init(
-    goal_handles[num_goal_handles], &goal_info_stamp_now, allocator);
+    goal_handles[num_goal_handles], &goal_info_stamp_now,
+    action_server->impl->goal_handle_allocator);
   if (RCL_RET_OK != ret) {
     RCL_SET_ERROR_MSG("failed to initialize goal handle");
     return NULL;
   }
 
-  action_server->impl->goal_handles = goal_handles;
+  // Track the goal's expiry deadline so expired goals can be found without scanning
+  const int64_t expiry_deadline =
+    now_time_point + (int64_t)action_server->impl->options.result_timeout.nanoseconds;
+  ret = _expiry_heap_push(
+    action_server->impl, expiry_deadline, goal_info_stamp_now.goal_id.uuid);
+  if (RCL_RET_OK != ret) {
+    rcl_ret_t ret_throwaway = rcl_action_goal_handle_fini(goal_handles[num_goal_handles]);
+    (void)ret_throwaway;
+    action_server->impl->goal_handle_allocator.deallocate(
+      goal_handles[num_goal_handles], action_server->impl->goal_handle_allocator.state);
+    return NULL;  // error already set
+  }
+
   action_server->impl->num_goal_handles = new_num_goal_handles;
+
+  // Goals are re-stamped with the current time just above, so appending here
+  // keeps the stamp index sorted by acceptance time
+  _stamp_index_append(action_server->impl, now_time_point, goal_info_stamp_now.goal_id.uuid);
+
+  // Keep the UUID index at most half full so probe chains stay short
+  if ((2u * new_num_goal_handles) > action_server->impl->num_goal_index_buckets) {
+    if (RCL_RET_OK != _goal_index_rebuild(action_server->impl, new_num_goal_handles)) {
+      // The goal was still accepted; lookups fall back to a linear scan
+      rcl_reset_error();
+    }
+  } else if (RCL_RET_OK != _goal_index_insert(action_server->impl, num_goal_handles)) {
+    _goal_index_free(action_server->impl);
+    rcl_reset_error();
+  }
   return goal_handles[num_goal_handles];
 }
 
@@ -498,6 +1028,57 @@ rcl_action_publish_feedback(
   return RCL_RET_OK;
 }
 
+// \internal Borrows a loaned message from an action server specific publisher.
+#define BORROW_LOANED_MESSAGE(Type, ros_message) \
+  if (!rcl_action_server_is_valid(action_server)) { \
+    return RCL_RET_ACTION_SERVER_INVALID;  /* error already set */ \
+  } \
+  return rcl_borrow_loaned_message( \
+    &action_server->impl->Type ## _publisher, \
+    action_server->impl->Type ## _message_type_support, \
+    ros_message);
+
+// \internal Publishes a loaned message using an action server specific publisher.
+#define PUBLISH_LOANED_MESSAGE(Type, ros_message) \
+  if (!rcl_action_server_is_valid(action_server)) { \
+    return RCL_RET_ACTION_SERVER_INVALID;  /* error already set */ \
+  } \
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT); \
+  return rcl_publish_loaned_message( \
+    &action_server->impl->Type ## _publisher, ros_message, NULL);
+
+// \internal Returns an unpublished loaned message to the middleware.
+#define RETURN_LOANED_MESSAGE(Type, ros_message) \
+  if (!rcl_action_server_is_valid(action_server)) { \
+    return RCL_RET_ACTION_SERVER_INVALID;  /* error already set */ \
+  } \
+  return rcl_return_loaned_message_from_publisher( \
+    &action_server->impl->Type ## _publisher, ros_message);
+
+rcl_ret_t
+rcl_action_borrow_loaned_feedback_message(
+  const rcl_action_server_t * action_server,
+  void ** ros_feedback)
+{
+  BORROW_LOANED_MESSAGE(feedback, ros_feedback);
+}
+
+rcl_ret_t
+rcl_action_publish_loaned_feedback(
+  const rcl_action_server_t * action_server,
+  void * ros_feedback)
+{
+  PUBLISH_LOANED_MESSAGE(feedback, ros_feedback);
+}
+
+rcl_ret_t
+rcl_action_return_loaned_feedback_message(
+  const rcl_action_server_t * action_server,
+  void * ros_feedback)
+{
+  RETURN_LOANED_MESSAGE(feedback, ros_feedback);
+}
+
 rcl_ret_t
 rcl_action_get_goal_status_array(
   const rcl_action_server_t * action_server,
@@ -549,6 +1130,72 @@ fail:
   }
 }
 
+// Implementation only
+// Refresh the cached status array in place, reusing its storage.
+// Goal info is immutable after acceptance, so entries that are already
+// populated only have their status byte updated; entries past the previously
+// populated range are filled in full.
+static rcl_ret_t
+_status_array_refresh(rcl_action_server_impl_t * impl)
+{
+  rcl_allocator_t allocator = impl->options.allocator;
+  action_msgs__msg__GoalStatusArray * msg = &impl->status_array.msg;
+  const size_t num_goals = impl->num_goal_handles;
+  if (num_goals > msg->status_list.capacity) {
+    size_t new_capacity = (0u == msg->status_list.capacity) ? 1u : msg->status_list.capacity;
+    while (new_capacity < num_goals) {
+      new_capacity *= 2u;
+    }
+    void * tmp_ptr = allocator.reallocate(
+      msg->status_list.data, new_capacity * sizeof(rcl_action_goal_status_t), allocator.state);
+    if (!tmp_ptr) {
+      RCL_SET_ERROR_MSG("memory allocation failed for cached status array");
+      return RCL_RET_BAD_ALLOC;
+    }
+    msg->status_list.data = (rcl_action_goal_status_t *)tmp_ptr;
+    msg->status_list.capacity = new_capacity;
+  }
+  const size_t num_populated =
+    (msg->status_list.size <= num_goals) ? msg->status_list.size : 0u;
+  rcl_ret_t ret;
+  for (size_t i = 0u; i < num_goals; ++i) {
+    if (i >= num_populated) {
+      ret = rcl_action_goal_handle_get_info(
+        impl->goal_handles[i], &msg->status_list.data[i].goal_info);
+      if (RCL_RET_OK != ret) {
+        msg->status_list.size = 0u;
+        return RCL_RET_ERROR;  // error already set
+      }
+    }
+    ret = rcl_action_goal_handle_get_status(
+      impl->goal_handles[i], &msg->status_list.data[i].status);
+    if (RCL_RET_OK != ret) {
+      msg->status_list.size = 0u;
+      return RCL_RET_ERROR;  // error already set
+    }
+  }
+  msg->status_list.size = num_goals;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_get_goal_status_array_ref(
+  const rcl_action_server_t * action_server,
+  const rcl_action_goal_status_array_t ** status_message)
+{
+  if (!rcl_action_server_is_valid(action_server)) {
+    return RCL_RET_ACTION_SERVER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(status_message, RCL_RET_INVALID_ARGUMENT);
+
+  rcl_ret_t ret = _status_array_refresh(action_server->impl);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  *status_message = &action_server->impl->status_array;
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_action_publish_status(
   const rcl_action_server_t * action_server,
@@ -566,13 +1213,141 @@ rcl_action_publish_status(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_action_borrow_loaned_status_message(
+  const rcl_action_server_t * action_server,
+  void ** ros_status)
+{
+  BORROW_LOANED_MESSAGE(status, ros_status);
+}
+
+rcl_ret_t
+rcl_action_publish_loaned_status(
+  const rcl_action_server_t * action_server,
+  void * ros_status)
+{
+  PUBLISH_LOANED_MESSAGE(status, ros_status);
+}
+
+rcl_ret_t
+rcl_action_return_loaned_status_message(
+  const rcl_action_server_t * action_server,
+  void * ros_status)
+{
+  RETURN_LOANED_MESSAGE(status, ros_status);
+}
+
+// Implementation only
+// Return the cache entry for a goal UUID, or NULL if none is cached.
+static cached_result_entry_t *
+_cached_result_find(const rcl_action_server_impl_t * impl, const uint8_t * uuid)
+{
+  for (size_t i = 0u; i < impl->num_cached_results; ++i) {
+    if (uuidcmp(impl->cached_results[i].uuid, uuid)) {
+      return &impl->cached_results[i];
+    }
+  }
+  return NULL;
+}
+
+// Implementation only
+// Drop the cache entry for a goal UUID, if any.
+static void
+_cached_result_remove(rcl_action_server_impl_t * impl, const uint8_t * uuid)
+{
+  cached_result_entry_t * entry = _cached_result_find(impl, uuid);
+  if (NULL != entry) {
+    // Order is irrelevant, so fill the hole with the last entry
+    *entry = impl->cached_results[--impl->num_cached_results];
+  }
+}
+
+rcl_ret_t
+rcl_action_server_cache_result_response(
+  const rcl_action_server_t * action_server,
+  const uint8_t * goal_uuid,
+  void * ros_result_response)
+{
+  if (!rcl_action_server_is_valid(action_server)) {
+    return RCL_RET_ACTION_SERVER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_uuid, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_result_response, RCL_RET_INVALID_ARGUMENT);
+  rcl_action_server_impl_t * impl = action_server->impl;
+  cached_result_entry_t * entry = _cached_result_find(impl, goal_uuid);
+  if (NULL == entry) {
+    rcl_allocator_t allocator = impl->options.allocator;
+    if (impl->num_cached_results == impl->cached_results_capacity) {
+      size_t new_capacity = impl->cached_results_capacity ?
+        2 * impl->cached_results_capacity : 8;
+      cached_result_entry_t * grown = allocator.reallocate(
+        impl->cached_results, new_capacity * sizeof(cached_result_entry_t), allocator.state);
+      RCL_CHECK_FOR_NULL_WITH_MSG(
+        grown, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+      impl->cached_results = grown;
+      impl->cached_results_capacity = new_capacity;
+    }
+    entry = &impl->cached_results[impl->num_cached_results++];
+    memcpy(entry->uuid, goal_uuid, UUID_SIZE);
+  }
+  entry->ros_response = ros_result_response;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_server_uncache_result_response(
+  const rcl_action_server_t * action_server,
+  const uint8_t * goal_uuid)
+{
+  if (!rcl_action_server_is_valid(action_server)) {
+    return RCL_RET_ACTION_SERVER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_uuid, RCL_RET_INVALID_ARGUMENT);
+  _cached_result_remove(action_server->impl, goal_uuid);
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_action_take_result_request(
   const rcl_action_server_t * action_server,
   rmw_request_id_t * request_header,
   void * ros_result_request)
 {
-  TAKE_SERVICE_REQUEST(result, request_header, ros_result_request);
+  if (!rcl_action_server_is_valid(action_server)) {
+    return RCL_RET_ACTION_SERVER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_header, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_result_request, RCL_RET_INVALID_ARGUMENT);
+  const rcl_action_server_impl_t * impl = action_server->impl;
+  // Requests for goals with a cached result response are answered here, so
+  // only requests the application has to compute a result for surface.
+  for (;;) {
+    rcl_ret_t ret = rcl_take_request(
+      &impl->result_service, request_header, ros_result_request);
+    if (RCL_RET_OK != ret) {
+      if (RCL_RET_BAD_ALLOC == ret) {
+        return RCL_RET_BAD_ALLOC;  // error already set
+      }
+      if (RCL_RET_SERVICE_TAKE_FAILED == ret) {
+        return RCL_RET_ACTION_SERVER_TAKE_FAILED;
+      }
+      return RCL_RET_ERROR;  // error already set
+    }
+    if (0u == impl->num_cached_results) {
+      return RCL_RET_OK;
+    }
+    // The generated GetResult request struct leads with the goal UUID
+    const cached_result_entry_t * entry =
+      _cached_result_find(impl, (const uint8_t *)ros_result_request);
+    if (NULL == entry) {
+      return RCL_RET_OK;
+    }
+    ret = rcl_send_response(
+      &impl->result_service, request_header, entry->ros_response);
+    if (RCL_RET_OK != ret) {
+      return RCL_RET_ERROR;  // error already set
+    }
+  }
 }
 
 rcl_ret_t
@@ -613,21 +1388,63 @@ rcl_action_expire_goals(
   // Used for shrinking goal handle array
   rcl_allocator_t allocator = action_server->impl->options.allocator;
 
+  rcl_action_server_impl_t * impl = action_server->impl;
   size_t num_goals_expired = 0u;
   rcl_ret_t ret_final = RCL_RET_OK;
-  const int64_t timeout = (int64_t)action_server->impl->options.result_timeout.nanoseconds;
-  rcl_action_goal_handle_t * goal_handle;
   rcl_action_goal_info_t goal_info;
-  int64_t goal_time;
-  size_t num_goal_handles = action_server->impl->num_goal_handles;
-  for (size_t i = 0u; i < num_goal_handles; ++i) {
-    if (output_expired && i >= expired_goals_capacity) {
+  // Entries popped for overdue goals that are still active; they are pushed
+  // back once the expired goals have been processed
+  goal_expiry_entry_t * requeue = NULL;
+  size_t num_requeue = 0u;
+  // Only deadlines at the root of the heap can have passed, so pop until the
+  // earliest remaining deadline is still in the future
+  while (impl->expiry_heap_size > 0u && impl->expiry_heap[0].deadline < current_time) {
+    if (output_expired && num_goals_expired >= expired_goals_capacity) {
       // no more space to output expired goals, so stop expiring them
       break;
     }
-    goal_handle = action_server->impl->goal_handles[i];
+    goal_expiry_entry_t entry;
+    _expiry_heap_pop(impl, &entry);
+    size_t handle_index = 0u;
+    bool found = false;
+    if (NULL != impl->goal_index_buckets) {
+      found = _goal_index_find(impl, entry.uuid, &handle_index);
+    } else {
+      for (size_t i = 0u; i < impl->num_goal_handles; ++i) {
+        if (NULL == impl->goal_handles[i]) {
+          continue;
+        }
+        ret = rcl_action_goal_handle_get_info(impl->goal_handles[i], &goal_info);
+        if (RCL_RET_OK != ret) {
+          ret_final = RCL_RET_ERROR;
+          continue;
+        }
+        if (uuidcmp(entry.uuid, goal_info.goal_id.uuid)) {
+          handle_index = i;
+          found = true;
+          break;
+        }
+      }
+    }
+    if (!found) {
+      // The goal is no longer tracked
+      continue;
+    }
+    rcl_action_goal_handle_t * goal_handle = impl->goal_handles[handle_index];
     // Expiration only applys to terminated goals
     if (rcl_action_goal_handle_is_active(goal_handle)) {
+      if (NULL == requeue) {
+        requeue = (goal_expiry_entry_t *)allocator.allocate(
+          (impl->expiry_heap_size + 1u) * sizeof(goal_expiry_entry_t), allocator.state);
+        if (!requeue) {
+          RCL_SET_ERROR_MSG("allocation failed for temporary goal expiry array");
+          ret_final = RCL_RET_BAD_ALLOC;
+          // Capacity for the push is guaranteed since the entry was just popped
+          (void)_expiry_heap_push(impl, entry.deadline, entry.uuid);
+          break;
+        }
+      }
+      requeue[num_requeue++] = entry;
       continue;
     }
     rcl_action_goal_info_t * info_ptr = &goal_info;
@@ -637,50 +1454,113 @@ rcl_action_expire_goals(
     ret = rcl_action_goal_handle_get_info(goal_handle, info_ptr);
     if (RCL_RET_OK != ret) {
       ret_final = RCL_RET_ERROR;
-      continue;
-    }
-    goal_time = _goal_info_stamp_to_nanosec(info_ptr);
-    if ((current_time - goal_time) > timeout) {
-      // Deallocate space used to store pointer to goal handle
-      allocator.deallocate(action_server->impl->goal_handles[i], allocator.state);
-      action_server->impl->goal_handles[i] = NULL;
-      // Move all pointers after backwards one to fill the gap
-      for (size_t post_i = i; (post_i + 1) < num_goal_handles; ++post_i) {
-        action_server->impl->goal_handles[post_i] = action_server->impl->goal_handles[post_i + 1];
-      }
-      // decrement i to check the same index again now that it has a new goal handle
-      --i;
-      --num_goal_handles;
-      ++num_goals_expired;
+      // Capacity for the push is guaranteed since the entry was just popped
+      (void)_expiry_heap_push(impl, entry.deadline, entry.uuid);
+      break;
     }
+    // Return the goal handle storage to the pool; the array is compacted below
+    impl->goal_handle_allocator.deallocate(goal_handle, impl->goal_handle_allocator.state);
+    impl->goal_handles[handle_index] = NULL;
+    // The goal is gone, so its cached result response is dropped with it
+    _cached_result_remove(impl, entry.uuid);
+    ++num_goals_expired;
+  }
+
+  // Push back entries for overdue goals that have not terminated yet
+  for (size_t i = 0u; i < num_requeue; ++i) {
+    // Capacity for the push is guaranteed since the entries were just popped
+    (void)_expiry_heap_push(impl, requeue[i].deadline, requeue[i].uuid);
+  }
+  if (NULL != requeue) {
+    allocator.deallocate(requeue, allocator.state);
   }
 
   if (num_goals_expired > 0u) {
+    // Compact the goal handle array over the cleared slots
+    size_t next_slot = 0u;
+    for (size_t i = 0u; i < impl->num_goal_handles; ++i) {
+      if (NULL != impl->goal_handles[i]) {
+        impl->goal_handles[next_slot++] = impl->goal_handles[i];
+      }
+    }
+    impl->num_goal_handles = next_slot;
     // Shrink goal handle array if some goals expired
-    if (0u == num_goal_handles) {
-      allocator.deallocate(action_server->impl->goal_handles, allocator.state);
-      action_server->impl->goal_handles = NULL;
-      action_server->impl->num_goal_handles = num_goal_handles;
+    if (0u == next_slot) {
+      allocator.deallocate(impl->goal_handles, allocator.state);
+      impl->goal_handles = NULL;
+      impl->goal_handle_capacity = 0u;
     } else {
       void * tmp_ptr = allocator.reallocate(
-        action_server->impl->goal_handles,
-        num_goal_handles * sizeof(rcl_action_goal_handle_t *),
-        allocator.state);
+        impl->goal_handles, next_slot * sizeof(rcl_action_goal_handle_t *), allocator.state);
       if (!tmp_ptr) {
         RCL_SET_ERROR_MSG("failed to shrink size of goal handle array");
         ret_final = RCL_RET_ERROR;
       } else {
-        action_server->impl->goal_handles = (rcl_action_goal_handle_t **)tmp_ptr;
-        action_server->impl->num_goal_handles = num_goal_handles;
+        impl->goal_handles = (rcl_action_goal_handle_t **)tmp_ptr;
+        impl->goal_handle_capacity = next_slot;
+      }
+    }
+    // Compaction moved the surviving goal handles, so the cached status array
+    // entries no longer line up with them; repopulate it on the next refresh
+    impl->status_array.msg.status_list.size = 0u;
+    // Rebuild the UUID index over the compacted array
+    if (0u == impl->num_goal_handles) {
+      _goal_index_free(impl);
+    } else if (RCL_RET_OK != _goal_index_rebuild(impl, impl->num_goal_handles)) {
+      // Lookups fall back to a linear scan without the index
+      rcl_reset_error();
+    }
+    // Drop the stamp index entries of the expired goals; the ranged cancel
+    // path only removes stale entries it happens to visit, so without this
+    // the index would grow with every goal ever accepted
+    if (impl->stamp_index_valid && NULL != impl->stamp_index) {
+      size_t kept = 0u;
+      for (size_t i = 0u; i < impl->stamp_index_size; ++i) {
+        size_t handle_index;
+        if (!_find_goal_by_uuid(impl, impl->stamp_index[i].uuid, &handle_index)) {
+          continue;
+        }
+        if (kept != i) {
+          impl->stamp_index[kept] = impl->stamp_index[i];
+        }
+        ++kept;
+      }
+      impl->stamp_index_size = kept;
+    }
+  }
+
+  // Arm the expire timer for the next deadline
+  if (num_requeue > 0u) {
+    // Overdue goals that are still active hide the next inactive deadline at
+    // the root of the heap, so fall back to scanning for it
+    ret_final = _recalculate_expire_timer(
+      &impl->expire_timer,
+      impl->options.result_timeout.nanoseconds,
+      impl->goal_handles,
+      impl->num_goal_handles,
+      &impl->clock);
+  } else if (0u == impl->expiry_heap_size) {
+    // No tracked goal left that could expire, so cancel timer
+    ret = rcl_timer_cancel(&impl->expire_timer);
+    if (RCL_RET_OK != ret) {
+      ret_final = ret;
+    }
+  } else {
+    int64_t period = impl->expiry_heap[0].deadline - current_time;
+    if (period < 0) {
+      period = 0;
+    }
+    ret = rcl_timer_reset(&impl->expire_timer);
+    if (RCL_RET_OK != ret) {
+      ret_final = ret;
+    } else {
+      int64_t old_period;
+      ret = rcl_timer_exchange_period(&impl->expire_timer, period, &old_period);
+      if (RCL_RET_OK != ret) {
+        ret_final = ret;
       }
     }
   }
-  ret_final = _recalculate_expire_timer(
-    &action_server->impl->expire_timer,
-    action_server->impl->options.result_timeout.nanoseconds,
-    action_server->impl->goal_handles,
-    action_server->impl->num_goal_handles,
-    &action_server->impl->clock);
 
   // If argument is not null, then set it
   if (NULL != num_expired) {
@@ -689,6 +1569,23 @@ rcl_action_expire_goals(
   return ret_final;
 }
 
+rcl_ret_t
+rcl_action_server_get_next_goal_expiry(
+  const rcl_action_server_t * action_server,
+  rcl_time_point_value_t * expiry_time)
+{
+  if (!rcl_action_server_is_valid(action_server)) {
+    return RCL_RET_ACTION_SERVER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(expiry_time, RCL_RET_INVALID_ARGUMENT);
+  if (0u == action_server->impl->expiry_heap_size) {
+    *expiry_time = INT64_MAX;
+  } else {
+    *expiry_time = action_server->impl->expiry_heap[0].deadline;
+  }
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_action_notify_goal_done(
   const rcl_action_server_t * action_server)
@@ -722,18 +1619,25 @@ rcl_action_process_cancel_request(
   RCL_CHECK_ARGUMENT_FOR_NULL(cancel_request, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(cancel_response, RCL_RET_INVALID_ARGUMENT);
 
-  rcl_allocator_t allocator = action_server->impl->options.allocator;
-  const size_t total_num_goals = action_server->impl->num_goal_handles;
-
-  // Storage for pointers to active goals handles that will be transitioned to canceling
-  // Note, we need heap allocation for MSVC support
-  rcl_action_goal_handle_t ** goal_handles_to_cancel =
-    (rcl_action_goal_handle_t **)allocator.allocate(
-    sizeof(rcl_action_goal_handle_t *) * total_num_goals, allocator.state);
-  if (!goal_handles_to_cancel) {
-    RCL_SET_ERROR_MSG("allocation failed for temporary goal handle array");
-    return RCL_RET_BAD_ALLOC;
+  rcl_action_server_impl_t * impl = action_server->impl;
+  rcl_allocator_t allocator = impl->options.allocator;
+  const size_t total_num_goals = impl->num_goal_handles;
+
+  // Storage for pointers to active goals handles that will be transitioned to canceling.
+  // The scratch array lives on the impl so repeated cancel requests do not
+  // allocate; it only grows when more goals are tracked than ever before.
+  if (impl->cancel_scratch_capacity < total_num_goals) {
+    void * tmp_ptr = allocator.reallocate(
+      impl->cancel_scratch,
+      total_num_goals * sizeof(rcl_action_goal_handle_t *), allocator.state);
+    if (!tmp_ptr) {
+      RCL_SET_ERROR_MSG("allocation failed for temporary goal handle array");
+      return RCL_RET_BAD_ALLOC;
+    }
+    impl->cancel_scratch = (rcl_action_goal_handle_t **)tmp_ptr;
+    impl->cancel_scratch_capacity = total_num_goals;
   }
+  rcl_action_goal_handle_t ** goal_handles_to_cancel = impl->cancel_scratch;
   size_t num_goals_to_cancel = 0u;
 
   // Request data
@@ -748,25 +1652,35 @@ rcl_action_process_cancel_request(
     rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
     // Assume the goal ID is invalid until we find it
     cancel_response->msg.return_code = action_msgs__srv__CancelGoal_Response__ERROR_UNKNOWN_GOAL_ID;
-    rcl_action_goal_handle_t * goal_handle;
-    for (size_t i = 0u; i < total_num_goals; ++i) {
-      goal_handle = action_server->impl->goal_handles[i];
-      rcl_ret_t ret = rcl_action_goal_handle_get_info(goal_handle, &goal_info);
-      if (RCL_RET_OK != ret) {
-        ret_final = RCL_RET_ERROR;
-        continue;
+    rcl_action_goal_handle_t * goal_handle = NULL;
+    if (NULL != action_server->impl->goal_index_buckets) {
+      size_t handle_index;
+      if (_goal_index_find(action_server->impl, request_uuid, &handle_index)) {
+        goal_handle = action_server->impl->goal_handles[handle_index];
       }
+    } else {
+      for (size_t i = 0u; i < total_num_goals; ++i) {
+        rcl_ret_t ret = rcl_action_goal_handle_get_info(
+          action_server->impl->goal_handles[i], &goal_info);
+        if (RCL_RET_OK != ret) {
+          ret_final = RCL_RET_ERROR;
+          continue;
+        }
 
-      if (uuidcmp(request_uuid, goal_info.goal_id.uuid)) {
-        if (rcl_action_goal_handle_is_cancelable(goal_handle)) {
-          goal_handles_to_cancel[num_goals_to_cancel++] = goal_handle;
-          cancel_response->msg.return_code = action_msgs__srv__CancelGoal_Response__ERROR_NONE;
-        } else {
-          // If the goal is not cancelable, it must be because it is in a terminal state
-          cancel_response->msg.return_code =
-            action_msgs__srv__CancelGoal_Response__ERROR_GOAL_TERMINATED;
+        if (uuidcmp(request_uuid, goal_info.goal_id.uuid)) {
+          goal_handle = action_server->impl->goal_handles[i];
+          break;
         }
-        break;
+      }
+    }
+    if (NULL != goal_handle) {
+      if (rcl_action_goal_handle_is_cancelable(goal_handle)) {
+        goal_handles_to_cancel[num_goals_to_cancel++] = goal_handle;
+        cancel_response->msg.return_code = action_msgs__srv__CancelGoal_Response__ERROR_NONE;
+      } else {
+        // If the goal is not cancelable, it must be because it is in a terminal state
+        cancel_response->msg.return_code =
+          action_msgs__srv__CancelGoal_Response__ERROR_GOAL_TERMINATED;
       }
     }
   } else {
@@ -782,19 +1696,65 @@ rcl_action_process_cancel_request(
     // Also cancel any goal matching the UUID in the cancel request
     rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
     rcl_action_goal_handle_t * goal_handle;
-    for (size_t i = 0u; i < total_num_goals; ++i) {
-      goal_handle = action_server->impl->goal_handles[i];
-      rcl_ret_t ret = rcl_action_goal_handle_get_info(goal_handle, &goal_info);
-      if (RCL_RET_OK != ret) {
-        ret_final = RCL_RET_ERROR;
-        continue;
+    if (impl->stamp_index_valid && NULL != impl->stamp_index) {
+      // The stamp index is sorted by acceptance time, so the goals at or
+      // before the request timestamp form a prefix found by binary search
+      size_t low = 0u;
+      size_t high = impl->stamp_index_size;
+      while (low < high) {
+        const size_t mid = low + ((high - low) / 2u);
+        if (impl->stamp_index[mid].stamp <= request_nanosec) {
+          low = mid + 1u;
+        } else {
+          high = mid;
+        }
+      }
+      size_t i = 0u;
+      while (i < low) {
+        size_t handle_index;
+        if (!_find_goal_by_uuid(impl, impl->stamp_index[i].uuid, &handle_index)) {
+          // The goal expired; drop its stale index entry and retry this slot
+          _stamp_index_remove_at(impl, i);
+          --low;
+          continue;
+        }
+        goal_handle = impl->goal_handles[handle_index];
+        if (rcl_action_goal_handle_is_cancelable(goal_handle)) {
+          goal_handles_to_cancel[num_goals_to_cancel++] = goal_handle;
+        }
+        ++i;
       }
+      // A goal matching the request UUID is canceled even if it was accepted
+      // after the request timestamp; the prefix already covers the rest
+      if (!uuidcmpzero(request_uuid)) {
+        size_t handle_index;
+        if (_find_goal_by_uuid(impl, request_uuid, &handle_index)) {
+          goal_handle = impl->goal_handles[handle_index];
+          rcl_ret_t ret = rcl_action_goal_handle_get_info(goal_handle, &goal_info);
+          if (RCL_RET_OK != ret) {
+            ret_final = RCL_RET_ERROR;
+          } else if (rcl_action_goal_handle_is_cancelable(goal_handle) &&
+            _goal_info_stamp_to_nanosec(&goal_info) > request_nanosec)
+          {
+            goal_handles_to_cancel[num_goals_to_cancel++] = goal_handle;
+          }
+        }
+      }
+    } else {
+      for (size_t i = 0u; i < total_num_goals; ++i) {
+        goal_handle = action_server->impl->goal_handles[i];
+        rcl_ret_t ret = rcl_action_goal_handle_get_info(goal_handle, &goal_info);
+        if (RCL_RET_OK != ret) {
+          ret_final = RCL_RET_ERROR;
+          continue;
+        }
 
-      const int64_t goal_nanosec = _goal_info_stamp_to_nanosec(&goal_info);
-      if (rcl_action_goal_handle_is_cancelable(goal_handle) &&
-        ((goal_nanosec <= request_nanosec) || uuidcmp(request_uuid, goal_info.goal_id.uuid)))
-      {
-        goal_handles_to_cancel[num_goals_to_cancel++] = goal_handle;
+        const int64_t goal_nanosec = _goal_info_stamp_to_nanosec(&goal_info);
+        if (rcl_action_goal_handle_is_cancelable(goal_handle) &&
+          ((goal_nanosec <= request_nanosec) || uuidcmp(request_uuid, goal_info.goal_id.uuid)))
+        {
+          goal_handles_to_cancel[num_goals_to_cancel++] = goal_handle;
+        }
       }
     }
   }
@@ -802,7 +1762,7 @@ rcl_action_process_cancel_request(
   if (0u == num_goals_to_cancel) {
     cancel_response->msg.goals_canceling.data = NULL;
     cancel_response->msg.goals_canceling.size = 0u;
-    goto cleanup;
+    return ret_final;
   }
 
   // Allocate space in response
@@ -810,10 +1770,9 @@ rcl_action_process_cancel_request(
     cancel_response, num_goals_to_cancel, allocator);
   if (RCL_RET_OK != ret) {
     if (RCL_RET_BAD_ALLOC == ret) {
-      ret_final = RCL_RET_BAD_ALLOC;  // error already set
+      return RCL_RET_BAD_ALLOC;  // error already set
     }
-    ret_final = RCL_RET_ERROR;  // error already set
-    goto cleanup;
+    return RCL_RET_ERROR;  // error already set
   }
 
   // Add goal info to output struct
@@ -826,8 +1785,6 @@ rcl_action_process_cancel_request(
       ret_final = RCL_RET_ERROR;  // error already set
     }
   }
-cleanup:
-  allocator.deallocate(goal_handles_to_cancel, allocator.state);
   return ret_final;
 }
 
@@ -849,6 +1806,15 @@ rcl_action_server_get_action_name(const rcl_action_server_t * action_server)
   return action_server->impl->action_name;
 }
 
+const rcl_action_derived_names_t *
+rcl_action_server_get_derived_names(const rcl_action_server_t * action_server)
+{
+  if (!rcl_action_server_is_valid(action_server)) {
+    return NULL;  // error already set
+  }
+  return &action_server->impl->derived_names;
+}
+
 const rcl_action_server_options_t *
 rcl_action_server_get_options(const rcl_action_server_t * action_server)
 {
@@ -874,6 +1840,37 @@ rcl_action_server_get_goal_handles(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_action_server_snapshot_goal_states(
+  const rcl_action_server_t * action_server,
+  uint8_t goal_uuids[][UUID_SIZE],
+  rcl_action_goal_state_t * goal_states,
+  size_t capacity,
+  size_t * num_goals)
+{
+  if (!rcl_action_server_is_valid(action_server)) {
+    return RCL_RET_ACTION_SERVER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_uuids, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_states, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(num_goals, RCL_RET_INVALID_ARGUMENT);
+  const size_t count = action_server->impl->num_goal_handles;
+  *num_goals = count;
+  if (count > capacity) {
+    RCL_SET_ERROR_MSG("goal state snapshot arrays are too small");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // Handles owned by a valid server are valid, so they are read directly
+  // rather than through the per-handle accessors and their per-call checks
+  rcl_action_goal_handle_t ** goal_handles = action_server->impl->goal_handles;
+  for (size_t i = 0u; i < count; ++i) {
+    const rcl_action_goal_handle_impl_t * handle_impl = goal_handles[i]->impl;
+    memcpy(goal_uuids[i], handle_impl->info.goal_id.uuid, UUID_SIZE);
+    goal_states[i] = handle_impl->state;
+  }
+  return RCL_RET_OK;
+}
+
 bool
 rcl_action_server_goal_exists(
   const rcl_action_server_t * action_server,
@@ -884,6 +1881,11 @@ rcl_action_server_goal_exists(
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(goal_info, false);
 
+  if (NULL != action_server->impl->goal_index_buckets) {
+    size_t handle_index;
+    return _goal_index_find(action_server->impl, goal_info->goal_id.uuid, &handle_index);
+  }
+
   rcl_action_goal_info_t gh_goal_info = rcl_action_get_zero_initialized_goal_info();
   rcl_ret_t ret;
   for (size_t i = 0u; i < action_server->impl->num_goal_handles; ++i) {
@@ -1065,6 +2067,107 @@ rcl_action_server_wait_set_get_entities_ready(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_action_server_wait_set_token_init(
+  rcl_action_server_wait_set_token_t * token,
+  const rcl_action_server_t * action_server)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(token, RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_action_server_is_valid_except_context(action_server)) {
+    return RCL_RET_ACTION_SERVER_INVALID;  // error already set
+  }
+  const rcl_action_server_impl_t * impl = action_server->impl;
+  rcl_ret_t ret = rcl_wait_set_entity_token_init(
+    &token->goal_service_token, RCL_WAIT_SET_SERVICE, &impl->goal_service);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  ret = rcl_wait_set_entity_token_init(
+    &token->cancel_service_token, RCL_WAIT_SET_SERVICE, &impl->cancel_service);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  ret = rcl_wait_set_entity_token_init(
+    &token->result_service_token, RCL_WAIT_SET_SERVICE, &impl->result_service);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  ret = rcl_wait_set_entity_token_init(
+    &token->expire_timer_token, RCL_WAIT_SET_TIMER, &impl->expire_timer);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  token->goal_service_index = 0u;
+  token->cancel_service_index = 0u;
+  token->result_service_index = 0u;
+  token->expire_timer_index = 0u;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_wait_set_add_action_server_token(
+  rcl_wait_set_t * wait_set,
+  rcl_action_server_wait_set_token_t * token)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_WAIT_SET_INVALID);
+  RCL_CHECK_ARGUMENT_FOR_NULL(token, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = rcl_wait_set_add_token(
+    wait_set, &token->goal_service_token, &token->goal_service_index);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  ret = rcl_wait_set_add_token(
+    wait_set, &token->cancel_service_token, &token->cancel_service_index);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  ret = rcl_wait_set_add_token(
+    wait_set, &token->result_service_token, &token->result_service_index);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  ret = rcl_wait_set_add_token(
+    wait_set, &token->expire_timer_token, &token->expire_timer_index);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_server_wait_set_get_ready_bitmask(
+  const rcl_wait_set_t * wait_set,
+  const rcl_action_server_wait_set_token_t * token,
+  uint32_t * ready_bitmask)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_WAIT_SET_INVALID);
+  RCL_CHECK_ARGUMENT_FOR_NULL(token, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ready_bitmask, RCL_RET_INVALID_ARGUMENT);
+  if (token->goal_service_index >= wait_set->size_of_services ||
+    token->cancel_service_index >= wait_set->size_of_services ||
+    token->result_service_index >= wait_set->size_of_services ||
+    token->expire_timer_index >= wait_set->size_of_timers)
+  {
+    RCL_SET_ERROR_MSG("wait set index recorded in the token is out of bounds");
+    return RCL_RET_ERROR;
+  }
+  uint32_t bitmask = 0u;
+  if (wait_set->services[token->goal_service_index] == token->goal_service_token.entity) {
+    bitmask |= RCL_ACTION_SERVER_GOAL_REQUEST_READY;
+  }
+  if (wait_set->services[token->cancel_service_index] == token->cancel_service_token.entity) {
+    bitmask |= RCL_ACTION_SERVER_CANCEL_REQUEST_READY;
+  }
+  if (wait_set->services[token->result_service_index] == token->result_service_token.entity) {
+    bitmask |= RCL_ACTION_SERVER_RESULT_REQUEST_READY;
+  }
+  if (wait_set->timers[token->expire_timer_index] == token->expire_timer_token.entity) {
+    bitmask |= RCL_ACTION_SERVER_GOAL_EXPIRED;
+  }
+  *ready_bitmask = bitmask;
+  return RCL_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
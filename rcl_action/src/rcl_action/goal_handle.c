@@ -22,12 +22,7 @@ extern "C"
 #include "rcl/rcl.h"
 #include "rcl/error_handling.h"
 
-typedef struct rcl_action_goal_handle_impl_t
-{
-  rcl_action_goal_info_t info;
-  rcl_action_goal_state_t state;
-  rcl_allocator_t allocator;
-} rcl_action_goal_handle_impl_t;
+#include "./goal_handle_impl.h"
 
 rcl_action_goal_handle_t
 rcl_action_get_zero_initialized_goal_handle(void)
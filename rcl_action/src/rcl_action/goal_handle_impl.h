@@ -0,0 +1,39 @@
+// Copyright 2018 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_ACTION__GOAL_HANDLE_IMPL_H_
+#define RCL_ACTION__GOAL_HANDLE_IMPL_H_
+
+#include "rcl_action/goal_handle.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// \internal Shared with action_server.c so the bulk goal state snapshot can
+/// read goal handles in one pass instead of going through the per-handle
+/// accessors and their per-call validity checks.
+typedef struct rcl_action_goal_handle_impl_t
+{
+  rcl_action_goal_info_t info;
+  rcl_action_goal_state_t state;
+  rcl_allocator_t allocator;
+} rcl_action_goal_handle_impl_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL_ACTION__GOAL_HANDLE_IMPL_H_
@@ -19,77 +19,25 @@ extern "C"
 
 #include "rcl_action/goal_state_machine.h"
 
-typedef rcl_action_goal_state_t
-(* rcl_action_goal_event_handler)(rcl_action_goal_state_t, rcl_action_goal_event_t);
-
-// Transition event handlers
-rcl_action_goal_state_t
-_execute_event_handler(rcl_action_goal_state_t state, rcl_action_goal_event_t event)
-{
-  if (GOAL_STATE_ACCEPTED != state || GOAL_EVENT_EXECUTE != event) {
-    return GOAL_STATE_UNKNOWN;
-  }
-  return GOAL_STATE_EXECUTING;
-}
-
-rcl_action_goal_state_t
-_cancel_goal_event_handler(rcl_action_goal_state_t state, rcl_action_goal_event_t event)
-{
-  if ((GOAL_STATE_ACCEPTED != state && GOAL_STATE_EXECUTING != state) ||
-    GOAL_EVENT_CANCEL_GOAL != event)
-  {
-    return GOAL_STATE_UNKNOWN;
-  }
-  return GOAL_STATE_CANCELING;
-}
-
-rcl_action_goal_state_t
-_succeed_event_handler(rcl_action_goal_state_t state, rcl_action_goal_event_t event)
-{
-  if ((GOAL_STATE_EXECUTING != state && GOAL_STATE_CANCELING != state) ||
-    GOAL_EVENT_SUCCEED != event)
-  {
-    return GOAL_STATE_UNKNOWN;
-  }
-  return GOAL_STATE_SUCCEEDED;
-}
-
-rcl_action_goal_state_t
-_abort_event_handler(rcl_action_goal_state_t state, rcl_action_goal_event_t event)
-{
-  if ((GOAL_STATE_EXECUTING != state && GOAL_STATE_CANCELING != state) ||
-    GOAL_EVENT_ABORT != event)
-  {
-    return GOAL_STATE_UNKNOWN;
-  }
-  return GOAL_STATE_ABORTED;
-}
-
-rcl_action_goal_state_t
-_canceled_event_handler(rcl_action_goal_state_t state, rcl_action_goal_event_t event)
-{
-  if (GOAL_STATE_CANCELING != state || GOAL_EVENT_CANCELED != event) {
-    return GOAL_STATE_UNKNOWN;
-  }
-  return GOAL_STATE_CANCELED;
-}
-
-// Transition map
-static rcl_action_goal_event_handler
+// Transition map resolving [state][event] to the resulting state with a
+// single indexed load.
+// Entries without an initializer are zero, which is GOAL_STATE_UNKNOWN
+// (action_msgs__msg__GoalStatus__STATUS_UNKNOWN), i.e. an invalid transition.
+static const rcl_action_goal_state_t
   _goal_state_transition_map[GOAL_STATE_NUM_STATES][GOAL_EVENT_NUM_EVENTS] = {
   [GOAL_STATE_ACCEPTED] = {
-    [GOAL_EVENT_EXECUTE] = _execute_event_handler,
-    [GOAL_EVENT_CANCEL_GOAL] = _cancel_goal_event_handler,
+    [GOAL_EVENT_EXECUTE] = GOAL_STATE_EXECUTING,
+    [GOAL_EVENT_CANCEL_GOAL] = GOAL_STATE_CANCELING,
   },
   [GOAL_STATE_EXECUTING] = {
-    [GOAL_EVENT_CANCEL_GOAL] = _cancel_goal_event_handler,
-    [GOAL_EVENT_SUCCEED] = _succeed_event_handler,
-    [GOAL_EVENT_ABORT] = _abort_event_handler,
+    [GOAL_EVENT_CANCEL_GOAL] = GOAL_STATE_CANCELING,
+    [GOAL_EVENT_SUCCEED] = GOAL_STATE_SUCCEEDED,
+    [GOAL_EVENT_ABORT] = GOAL_STATE_ABORTED,
   },
   [GOAL_STATE_CANCELING] = {
-    [GOAL_EVENT_SUCCEED] = _succeed_event_handler,
-    [GOAL_EVENT_ABORT] = _abort_event_handler,
-    [GOAL_EVENT_CANCELED] = _canceled_event_handler,
+    [GOAL_EVENT_SUCCEED] = GOAL_STATE_SUCCEEDED,
+    [GOAL_EVENT_ABORT] = GOAL_STATE_ABORTED,
+    [GOAL_EVENT_CANCELED] = GOAL_STATE_CANCELED,
   },
 };
 
@@ -105,11 +53,7 @@ rcl_action_transition_goal_state(
   {
     return GOAL_STATE_UNKNOWN;
   }
-  rcl_action_goal_event_handler handler = _goal_state_transition_map[state][event];
-  if (NULL == handler) {
-    return GOAL_STATE_UNKNOWN;
-  }
-  return handler(state, event);
+  return _goal_state_transition_map[state][event];
 }
 
 #ifdef __cplusplus
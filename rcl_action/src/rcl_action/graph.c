@@ -18,6 +18,8 @@ extern "C"
 #endif
 
 #include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "rcl/error_handling.h"
@@ -27,10 +29,21 @@ extern "C"
 
 #include "rcl_action/graph.h"
 
+// Assumption: actions provide a topic name with the suffix "/_action/feedback"
+static
+bool
+_is_action_feedback_topic(const char * topic_name)
+{
+  const char * action_name_identifier = "/_action/feedback";
+  const char * identifier_index = strstr(topic_name, action_name_identifier);
+  return NULL != identifier_index &&
+         strlen(identifier_index) == strlen(action_name_identifier);
+}
+
 static
 rcl_ret_t
 _filter_action_names(
-  rcl_names_and_types_t * topic_names_and_types,
+  const rcl_names_and_types_t * topic_names_and_types,
   rcl_allocator_t * allocator,
   rcl_names_and_types_t * action_names_and_types)
 {
@@ -45,13 +58,12 @@ _filter_action_names(
 
   rcl_ret_t ret;
   const size_t num_names = topic_names_and_types->names.size;
-  char ** names = topic_names_and_types->names.data;
+  char * const * names = topic_names_and_types->names.data;
 
   // Count number of actions to determine how much memory to allocate
   size_t num_actions = 0u;
   for (size_t i = 0u; i < num_names; ++i) {
-    const char * identifier_index = strstr(names[i], action_name_identifier);
-    if (identifier_index && strlen(identifier_index) == strlen(action_name_identifier)) {
+    if (_is_action_feedback_topic(names[i])) {
       ++num_actions;
     }
   }
@@ -216,6 +228,87 @@ rcl_action_get_names_and_types(
   return ret;
 }
 
+rcl_action_names_and_types_cache_t
+rcl_action_get_zero_initialized_names_and_types_cache(void)
+{
+  rcl_action_names_and_types_cache_t cache;
+  cache.action_names_and_types = rcl_get_zero_initialized_names_and_types();
+  cache.epoch = 0;
+  cache.valid = false;
+  return cache;
+}
+
+rcl_ret_t
+rcl_action_names_and_types_cache_update(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  rcl_action_names_and_types_cache_t * cache)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(allocator, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(cache, RCL_RET_INVALID_ARGUMENT);
+
+  // Ask the graph cache what changed since the epoch of the last update.
+  // An unpopulated cache passes UINT64_MAX, which forces a resync.
+  rcl_graph_diff_t diff = rcl_get_zero_initialized_graph_diff();
+  rcl_ret_t ret = rcl_graph_get_changes_since(
+    node, cache->valid ? cache->epoch : UINT64_MAX, &diff);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+
+  // Only re-filter if a topic that can affect the action list came or went
+  bool refilter = !cache->valid || diff.is_resync;
+  for (size_t i = 0u; !refilter && i < diff.added_topics.size; ++i) {
+    refilter = _is_action_feedback_topic(diff.added_topics.data[i]);
+  }
+  for (size_t i = 0u; !refilter && i < diff.removed_topics.size; ++i) {
+    refilter = _is_action_feedback_topic(diff.removed_topics.data[i]);
+  }
+  const uint64_t epoch = diff.epoch;
+  ret = rcl_graph_diff_fini(&diff);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  if (!refilter) {
+    cache->epoch = epoch;
+    return RCL_RET_OK;
+  }
+
+  const rcl_names_and_types_t * topic_names_and_types = NULL;
+  ret = rcl_graph_cache_get_topic_names_and_types(node, &topic_names_and_types);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+
+  ret = rcl_names_and_types_fini(&cache->action_names_and_types);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  cache->action_names_and_types = rcl_get_zero_initialized_names_and_types();
+  ret = _filter_action_names(
+    topic_names_and_types,
+    allocator,
+    &cache->action_names_and_types);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  cache->epoch = epoch;
+  cache->valid = true;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_names_and_types_cache_fini(rcl_action_names_and_types_cache_t * cache)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(cache, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = rcl_names_and_types_fini(&cache->action_names_and_types);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  *cache = rcl_action_get_zero_initialized_names_and_types_cache();
+  return RCL_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
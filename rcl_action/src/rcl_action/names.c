@@ -149,6 +149,82 @@ rcl_action_get_status_topic_name(
   return RCL_RET_OK;
 }
 
+rcl_action_derived_names_t
+rcl_action_get_zero_initialized_derived_names(void)
+{
+  static rcl_action_derived_names_t null_derived_names = {0};
+  return null_derived_names;
+}
+
+rcl_ret_t
+rcl_action_derive_names(
+  const char * action_name,
+  rcl_allocator_t allocator,
+  rcl_action_derived_names_t * derived_names)
+{
+  // Suffixes in the order the names appear in rcl_action_derived_names_t
+  static const char * const suffixes[5] = {
+    "/_action/send_goal",
+    "/_action/cancel_goal",
+    "/_action/get_result",
+    "/_action/feedback",
+    "/_action/status",
+  };
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "allocator is invalid", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(action_name, RCL_RET_INVALID_ARGUMENT);
+  if (0 == strlen(action_name)) {
+    RCL_SET_ERROR_MSG("invalid empty action name");
+    return RCL_RET_ACTION_NAME_INVALID;
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(derived_names, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != derived_names->storage) {
+    RCL_SET_ERROR_MSG("writing derived action names may leak memory");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  const size_t action_name_length = strlen(action_name);
+  size_t storage_size = 0u;
+  for (size_t i = 0u; i < 5u; ++i) {
+    storage_size += action_name_length + strlen(suffixes[i]) + 1u;
+  }
+  char * storage = (char *)allocator.allocate(storage_size, allocator.state);
+  if (NULL == storage) {
+    RCL_SET_ERROR_MSG("failed to allocate memory for derived action names");
+    return RCL_RET_BAD_ALLOC;
+  }
+
+  const char * names[5];
+  char * cursor = storage;
+  for (size_t i = 0u; i < 5u; ++i) {
+    names[i] = cursor;
+    memcpy(cursor, action_name, action_name_length);
+    cursor += action_name_length;
+    const size_t suffix_size = strlen(suffixes[i]) + 1u;  // include the terminator
+    memcpy(cursor, suffixes[i], suffix_size);
+    cursor += suffix_size;
+  }
+  derived_names->goal_service_name = names[0];
+  derived_names->cancel_service_name = names[1];
+  derived_names->result_service_name = names[2];
+  derived_names->feedback_topic_name = names[3];
+  derived_names->status_topic_name = names[4];
+  derived_names->storage = storage;
+  derived_names->allocator = allocator;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_derived_names_fini(rcl_action_derived_names_t * derived_names)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(derived_names, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != derived_names->storage) {
+    derived_names->allocator.deallocate(
+      derived_names->storage, derived_names->allocator.state);
+  }
+  *derived_names = rcl_action_get_zero_initialized_derived_names();
+  return RCL_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
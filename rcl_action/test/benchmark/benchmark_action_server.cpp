@@ -0,0 +1,261 @@
+// Copyright 2018 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Goal-throughput benchmark for the action server: drives batches of goals
+// through the accept -> execute -> succeed -> expire lifecycle while a
+// configurable number of other goals stay live, and reports the per-phase
+// cost and overall goals/s at each live goal count.  The phases map onto the
+// known scaling hazards: accept grows the goal handle array, the status
+// rebuild walks every tracked goal, and expiry removes from the middle of
+// the array, so a cost that climbs with the live goal count is a regression
+// to an O(n) behavior.
+//
+// Not registered with ctest; run the executable manually.
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "rcl_action/action_server.h"
+
+#include "rcl/error_handling.h"
+#include "rcl/rcl.h"
+
+#include "test_msgs/action/fibonacci.h"
+
+namespace
+{
+
+constexpr size_t kLiveGoalCounts[] = {0, 100, 1000, 10000};
+constexpr size_t kBatchGoals = 1000;
+constexpr int kStatusIterations = 100;
+
+// Every goal needs a distinct id; derive one from a running counter.
+void next_goal_uuid(uint64_t counter, uint8_t * uuid)
+{
+  memset(uuid, 0, 16);
+  memcpy(uuid, &counter, sizeof(counter));
+}
+
+int64_t elapsed_ns(const std::chrono::steady_clock::time_point & since)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - since).count();
+}
+
+// Accepts `count` goals and transitions them to EXECUTING.  The returned
+// handles stay owned by the action server.
+bool accept_goals(
+  rcl_action_server_t * action_server, size_t count, uint64_t * uuid_counter,
+  std::vector<rcl_action_goal_handle_t *> * handles)
+{
+  handles->clear();
+  handles->reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
+    next_goal_uuid(++(*uuid_counter), goal_info.goal_id.uuid);
+    rcl_action_goal_handle_t * handle =
+      rcl_action_accept_new_goal(action_server, &goal_info);
+    if (nullptr == handle) {
+      return false;
+    }
+    if (RCL_RET_OK != rcl_action_update_goal_state(handle, GOAL_EVENT_EXECUTE)) {
+      return false;
+    }
+    handles->push_back(handle);
+  }
+  return true;
+}
+
+// Runs one batch lifecycle with `live_goals` other goals tracked and prints
+// the per-phase cost and overall throughput.
+bool run_lifecycle(
+  rcl_node_t * node, rcl_clock_t * clock, size_t live_goals, uint64_t * uuid_counter)
+{
+  const rosidl_action_type_support_t * ts =
+    ROSIDL_GET_ACTION_TYPE_SUPPORT(test_msgs, Fibonacci);
+  rcl_action_server_options_t options = rcl_action_server_get_default_options();
+  // terminal goals should expire on the next expire call, not 15 minutes later
+  options.result_timeout.nanoseconds = 0;
+  rcl_action_server_t action_server = rcl_action_get_zero_initialized_server();
+  rcl_ret_t ret = rcl_action_server_init(
+    &action_server, node, clock, ts, "benchmark_action", &options);
+  if (RCL_RET_OK != ret) {
+    fprintf(stderr, "failed to init action server: %s\n", rcl_get_error_string().str);
+    return false;
+  }
+  bool ok = true;
+  std::vector<rcl_action_goal_handle_t *> background;
+  std::vector<rcl_action_goal_handle_t *> batch;
+  do {  // single pass; break on failure so the server is still finalized
+    // background goals stay in EXECUTING for the whole measurement
+    if (!accept_goals(&action_server, live_goals, uuid_counter, &background)) {
+      ok = false;
+      break;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (!accept_goals(&action_server, kBatchGoals, uuid_counter, &batch)) {
+      ok = false;
+      break;
+    }
+    const int64_t accept_ns = elapsed_ns(start);
+
+    // the reused status array, refreshed in place
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; ok && i < kStatusIterations; ++i) {
+      const rcl_action_goal_status_array_t * status_ref = nullptr;
+      ok = RCL_RET_OK == rcl_action_get_goal_status_array_ref(&action_server, &status_ref);
+      if (ok) {
+        ok = RCL_RET_OK == rcl_action_publish_status(&action_server, &status_ref->msg);
+      }
+    }
+    const int64_t status_ref_ns = elapsed_ns(start);
+    if (!ok) {
+      break;
+    }
+
+    // the allocating rebuild, for comparison; fewer iterations, it is the
+    // expensive variant by design
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; ok && i < kStatusIterations / 10; ++i) {
+      rcl_action_goal_status_array_t status_array =
+        rcl_action_get_zero_initialized_goal_status_array();
+      ok = RCL_RET_OK == rcl_action_get_goal_status_array(&action_server, &status_array);
+      if (ok) {
+        ok = RCL_RET_OK == rcl_action_goal_status_array_fini(&status_array);
+      }
+    }
+    const int64_t status_rebuild_ns = elapsed_ns(start);
+    if (!ok) {
+      break;
+    }
+
+    start = std::chrono::steady_clock::now();
+    for (rcl_action_goal_handle_t * handle : batch) {
+      if (RCL_RET_OK != rcl_action_update_goal_state(handle, GOAL_EVENT_SUCCEED)) {
+        ok = false;
+        break;
+      }
+      if (RCL_RET_OK != rcl_action_notify_goal_done(&action_server)) {
+        ok = false;
+        break;
+      }
+    }
+    const int64_t succeed_ns = elapsed_ns(start);
+    if (!ok) {
+      break;
+    }
+
+    std::vector<rcl_action_goal_info_t> expired(
+      kBatchGoals, rcl_action_get_zero_initialized_goal_info());
+    size_t num_expired = 0;
+    start = std::chrono::steady_clock::now();
+    ok = RCL_RET_OK == rcl_action_expire_goals(
+      &action_server, expired.data(), expired.size(), &num_expired);
+    const int64_t expire_ns = elapsed_ns(start);
+    if (!ok) {
+      break;
+    }
+    if (kBatchGoals != num_expired) {
+      fprintf(
+        stderr, "expected %zu expired goals, got %zu\n", kBatchGoals, num_expired);
+      ok = false;
+      break;
+    }
+
+    const int64_t lifecycle_ns = accept_ns + succeed_ns + expire_ns;
+    printf(
+      "live:%-6zu accept %6" PRId64 " ns/goal  status_ref %8" PRId64 " ns  "
+      "status_rebuild %8" PRId64 " ns  succeed %6" PRId64 " ns/goal  "
+      "expire %6" PRId64 " ns/goal  %10.0f goals/s\n",
+      live_goals,
+      accept_ns / static_cast<int64_t>(kBatchGoals),
+      status_ref_ns / kStatusIterations,
+      status_rebuild_ns / (kStatusIterations / 10),
+      succeed_ns / static_cast<int64_t>(kBatchGoals),
+      expire_ns / static_cast<int64_t>(kBatchGoals),
+      1e9 * static_cast<double>(kBatchGoals) / static_cast<double>(lifecycle_ns));
+  } while (false);
+  if (!ok) {
+    fprintf(stderr, "benchmark failed: %s\n", rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+  // the background goals (and on failure any remaining batch goals) are
+  // released by finalizing the server
+  if (RCL_RET_OK != rcl_action_server_fini(&action_server, node)) {
+    ok = false;
+  }
+  return ok;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  rcl_ret_t ret = rcl_init_options_init(&init_options, allocator);
+  if (RCL_RET_OK != ret) {
+    fprintf(stderr, "failed to init options: %s\n", rcl_get_error_string().str);
+    return 1;
+  }
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  ret = rcl_init(argc, argv, &init_options, &context);
+  if (RCL_RET_OK != ret) {
+    fprintf(stderr, "failed to init rcl: %s\n", rcl_get_error_string().str);
+    return 1;
+  }
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rcl_node_options_t node_options = rcl_node_get_default_options();
+  ret = rcl_node_init(&node, "benchmark_action_server", "", &context, &node_options);
+  if (RCL_RET_OK != ret) {
+    fprintf(stderr, "failed to init node: %s\n", rcl_get_error_string().str);
+    return 1;
+  }
+  rcl_clock_t clock;
+  ret = rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator);
+  if (RCL_RET_OK != ret) {
+    fprintf(stderr, "failed to init clock: %s\n", rcl_get_error_string().str);
+    return 1;
+  }
+
+  int result = 0;
+  uint64_t uuid_counter = 0;
+  for (size_t live_goals : kLiveGoalCounts) {
+    if (!run_lifecycle(&node, &clock, live_goals, &uuid_counter)) {
+      result = 1;
+      break;
+    }
+  }
+
+  if (RCL_RET_OK != rcl_clock_fini(&clock)) {
+    result = 1;
+  }
+  if (RCL_RET_OK != rcl_node_fini(&node)) {
+    result = 1;
+  }
+  if (RCL_RET_OK != rcl_shutdown(&context)) {
+    result = 1;
+  }
+  if (RCL_RET_OK != rcl_context_fini(&context)) {
+    result = 1;
+  }
+  if (RCL_RET_OK != rcl_init_options_fini(&init_options)) {
+    result = 1;
+  }
+  return result;
+}
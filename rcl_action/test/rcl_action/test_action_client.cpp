@@ -210,6 +210,66 @@ TEST_F(TestActionClientFixture, test_action_client_get_action_name) {
   EXPECT_STREQ(name, this->action_name);
 }
 
+TEST_F(TestActionClientFixture, test_action_client_register_request_cookie) {
+  int cookie_storage[3];
+  rcl_ret_t ret = rcl_action_register_goal_request_cookie(
+    nullptr, 0, &cookie_storage[0]);
+  EXPECT_EQ(ret, RCL_RET_ACTION_CLIENT_INVALID) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  ret = rcl_action_register_goal_request_cookie(
+    &this->invalid_action_client, 0, &cookie_storage[0]);
+  EXPECT_EQ(ret, RCL_RET_ACTION_CLIENT_INVALID) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  // Register enough cookies to force the pending request tables to grow
+  for (int64_t i = 0; i < 100; ++i) {
+    ret = rcl_action_register_goal_request_cookie(
+      &this->action_client, i, &cookie_storage[0]);
+    EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  }
+  // Re-registering a sequence number replaces its cookie
+  ret = rcl_action_register_goal_request_cookie(
+    &this->action_client, 0, &cookie_storage[1]);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_action_register_cancel_request_cookie(
+    &this->action_client, 0, &cookie_storage[2]);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_action_register_result_request_cookie(
+    &this->action_client, 0, nullptr);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  // Cookies still pending when the client is finalized are discarded in TearDown()
+}
+
+TEST_F(TestActionClientFixture, test_action_client_feedback_uuid_filter) {
+  uint8_t uuid_a[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  uint8_t uuid_b[16] = {16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+  rcl_ret_t ret = rcl_action_add_feedback_uuid(nullptr, uuid_a);
+  EXPECT_EQ(ret, RCL_RET_ACTION_CLIENT_INVALID) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  ret = rcl_action_add_feedback_uuid(&this->action_client, nullptr);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  ret = rcl_action_add_feedback_uuid(&this->action_client, uuid_a);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  // Re-adding a registered UUID is a no-op
+  ret = rcl_action_add_feedback_uuid(&this->action_client, uuid_a);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_action_add_feedback_uuid(&this->action_client, uuid_b);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  ret = rcl_action_remove_feedback_uuid(&this->action_client, uuid_a);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  // Removing a UUID that is not registered is an error
+  ret = rcl_action_remove_feedback_uuid(&this->action_client, uuid_a);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_action_remove_feedback_uuid(&this->action_client, uuid_b);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+}
+
 TEST_F(TestActionClientFixture, test_action_client_get_options) {
   const rcl_action_client_options_t * options =
     rcl_action_client_get_options(nullptr);
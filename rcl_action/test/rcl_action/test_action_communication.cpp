@@ -259,6 +259,79 @@ TEST_F(CLASSNAME(TestActionCommunication, RMW_IMPLEMENTATION), test_valid_goal_c
   test_msgs__action__Fibonacci_SendGoal_Response__fini(&outgoing_goal_response);
 }
 
+TEST_F(CLASSNAME(TestActionCommunication, RMW_IMPLEMENTATION), test_goal_comm_with_tokens)
+{
+  test_msgs__action__Fibonacci_SendGoal_Request outgoing_goal_request;
+  test_msgs__action__Fibonacci_SendGoal_Request incoming_goal_request;
+  test_msgs__action__Fibonacci_SendGoal_Response outgoing_goal_response;
+  test_msgs__action__Fibonacci_SendGoal_Response incoming_goal_response;
+  test_msgs__action__Fibonacci_SendGoal_Request__init(&outgoing_goal_request);
+  test_msgs__action__Fibonacci_SendGoal_Request__init(&incoming_goal_request);
+  test_msgs__action__Fibonacci_SendGoal_Response__init(&outgoing_goal_response);
+  test_msgs__action__Fibonacci_SendGoal_Response__init(&incoming_goal_response);
+
+  // Validate both ends once up front
+  rcl_action_server_wait_set_token_t server_token;
+  rcl_ret_t ret = rcl_action_server_wait_set_token_init(&server_token, &this->action_server);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  rcl_action_client_wait_set_token_t client_token;
+  ret = rcl_action_client_wait_set_token_init(&client_token, &this->action_client);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  // Initialize and send a goal request
+  init_test_uuid0(outgoing_goal_request.goal_id.uuid);
+  outgoing_goal_request.goal.order = 10;
+  int64_t sequence_number;
+  ret = rcl_action_send_goal_request(
+    &this->action_client, &outgoing_goal_request, &sequence_number);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  ret = rcl_action_wait_set_add_action_server_token(&this->wait_set, &server_token);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  ret = rcl_wait(&this->wait_set, RCL_S_TO_NS(10));
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  uint32_t ready_bitmask = 0u;
+  ret = rcl_action_server_wait_set_get_ready_bitmask(
+    &this->wait_set, &server_token, &ready_bitmask);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_EQ(ready_bitmask, RCL_ACTION_SERVER_GOAL_REQUEST_READY);
+
+  // Take the goal request and send a response
+  rmw_request_id_t request_header;
+  ret = rcl_action_take_goal_request(&this->action_server, &request_header, &incoming_goal_request);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  outgoing_goal_response.accepted = true;
+  ret = rcl_action_send_goal_response(
+    &this->action_server, &request_header, &outgoing_goal_response);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  ret = rcl_wait_set_clear(&this->wait_set);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  ret = rcl_action_wait_set_add_action_client_token(&this->wait_set, &client_token);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  ret = rcl_wait(&this->wait_set, RCL_S_TO_NS(10));
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  ret = rcl_action_client_wait_set_get_ready_bitmask(
+    &this->wait_set, &client_token, &ready_bitmask);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_EQ(ready_bitmask, RCL_ACTION_CLIENT_GOAL_RESPONSE_READY);
+
+  ret = rcl_action_take_goal_response(
+    &this->action_client, &request_header, &incoming_goal_response);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_EQ(outgoing_goal_response.accepted, incoming_goal_response.accepted);
+
+  test_msgs__action__Fibonacci_SendGoal_Request__fini(&outgoing_goal_request);
+  test_msgs__action__Fibonacci_SendGoal_Request__fini(&incoming_goal_request);
+  test_msgs__action__Fibonacci_SendGoal_Response__fini(&incoming_goal_response);
+  test_msgs__action__Fibonacci_SendGoal_Response__fini(&outgoing_goal_response);
+}
+
 
 TEST_F(CLASSNAME(TestActionCommunication, RMW_IMPLEMENTATION), test_valid_cancel_comm)
 {
@@ -454,6 +454,125 @@ TEST_F(TestActionServer, test_action_server_get_goal_status_array)
   }
 }
 
+TEST_F(TestActionServer, test_action_server_get_goal_status_array_ref)
+{
+  const rcl_action_goal_status_array_t * status_array_ref = nullptr;
+  // Get with null action server
+  rcl_ret_t ret = rcl_action_get_goal_status_array_ref(nullptr, &status_array_ref);
+  EXPECT_EQ(ret, RCL_RET_ACTION_SERVER_INVALID);
+  rcl_reset_error();
+
+  // Get with null status array
+  ret = rcl_action_get_goal_status_array_ref(&this->action_server, nullptr);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+
+  // Get with valid arguments (but no goals being tracked)
+  ret = rcl_action_get_goal_status_array_ref(&this->action_server, &status_array_ref);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ASSERT_NE(status_array_ref, nullptr);
+  EXPECT_EQ(status_array_ref->msg.status_list.size, 0u);
+
+  std::vector<rcl_action_goal_handle_t> handles;
+
+  // Add some goals and check that the reference tracks them
+  rcl_action_goal_info_t goal_info_in = rcl_action_get_zero_initialized_goal_info();
+  rcl_action_goal_handle_t * goal_handle;
+  for (int i = 0; i < 10; ++i) {
+    for (int j = 0; j < UUID_SIZE; ++j) {
+      goal_info_in.goal_id.uuid[j] = static_cast<uint8_t>(i + j);
+    }
+    goal_handle = rcl_action_accept_new_goal(&this->action_server, &goal_info_in);
+    ASSERT_NE(goal_handle, nullptr) << rcl_get_error_string().str;
+    handles.push_back(*goal_handle);
+  }
+  ret = rcl_action_get_goal_status_array_ref(&this->action_server, &status_array_ref);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ASSERT_EQ(status_array_ref->msg.status_list.size, 10u);
+  for (int i = 0; i < 10; ++i) {
+    const rcl_action_goal_info_t * goal_info_out =
+      &status_array_ref->msg.status_list.data[i].goal_info;
+    for (int j = 0; j < UUID_SIZE; ++j) {
+      EXPECT_EQ(goal_info_out->goal_id.uuid[j], i + j);
+    }
+  }
+
+  // A second call reuses the same storage
+  const rcl_action_goal_status_t * first_data = status_array_ref->msg.status_list.data;
+  ret = rcl_action_get_goal_status_array_ref(&this->action_server, &status_array_ref);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_EQ(status_array_ref->msg.status_list.data, first_data);
+  for (auto & handle : handles) {
+    EXPECT_EQ(RCL_RET_OK, rcl_action_goal_handle_fini(&handle));
+  }
+}
+
+TEST_F(TestActionServer, test_action_server_snapshot_goal_states)
+{
+  uint8_t uuids[2][UUID_SIZE];
+  rcl_action_goal_state_t states[2];
+  size_t num_goals = 42u;
+  // Snapshot with null action server
+  rcl_ret_t ret = rcl_action_server_snapshot_goal_states(nullptr, uuids, states, 2u, &num_goals);
+  EXPECT_EQ(ret, RCL_RET_ACTION_SERVER_INVALID);
+  rcl_reset_error();
+
+  // Snapshot with null output arguments
+  ret = rcl_action_server_snapshot_goal_states(
+    &this->action_server, nullptr, states, 2u, &num_goals);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+  ret = rcl_action_server_snapshot_goal_states(
+    &this->action_server, uuids, nullptr, 2u, &num_goals);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+  ret = rcl_action_server_snapshot_goal_states(&this->action_server, uuids, states, 2u, nullptr);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+
+  // Snapshot with no goals being tracked
+  ret = rcl_action_server_snapshot_goal_states(&this->action_server, uuids, states, 2u, &num_goals);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_EQ(num_goals, 0u);
+
+  std::vector<rcl_action_goal_handle_t> handles;
+
+  // Add two goals and move one to executing
+  rcl_action_goal_info_t goal_info_in = rcl_action_get_zero_initialized_goal_info();
+  init_test_uuid0(goal_info_in.goal_id.uuid);
+  rcl_action_goal_handle_t * goal_handle =
+    rcl_action_accept_new_goal(&this->action_server, &goal_info_in);
+  ASSERT_NE(goal_handle, nullptr) << rcl_get_error_string().str;
+  handles.push_back(*goal_handle);
+  ret = rcl_action_update_goal_state(goal_handle, GOAL_EVENT_EXECUTE);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  rcl_action_goal_info_t second_goal_info_in = rcl_action_get_zero_initialized_goal_info();
+  init_test_uuid1(second_goal_info_in.goal_id.uuid);
+  goal_handle = rcl_action_accept_new_goal(&this->action_server, &second_goal_info_in);
+  ASSERT_NE(goal_handle, nullptr) << rcl_get_error_string().str;
+  handles.push_back(*goal_handle);
+
+  // Too small arrays are rejected but still report the required size
+  num_goals = 0u;
+  ret = rcl_action_server_snapshot_goal_states(&this->action_server, uuids, states, 1u, &num_goals);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+  EXPECT_EQ(num_goals, 2u);
+
+  // Snapshot both goals in one call
+  ret = rcl_action_server_snapshot_goal_states(&this->action_server, uuids, states, 2u, &num_goals);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ASSERT_EQ(num_goals, 2u);
+  EXPECT_TRUE(uuidcmp(uuids[0], goal_info_in.goal_id.uuid));
+  EXPECT_EQ(states[0], GOAL_STATE_EXECUTING);
+  EXPECT_TRUE(uuidcmp(uuids[1], second_goal_info_in.goal_id.uuid));
+  EXPECT_EQ(states[1], GOAL_STATE_ACCEPTED);
+
+  for (auto & handle : handles) {
+    EXPECT_EQ(RCL_RET_OK, rcl_action_goal_handle_fini(&handle));
+  }
+}
+
 TEST_F(TestActionServer, test_action_server_get_action_name)
 {
   // Get action_name for a null action server
@@ -473,6 +592,42 @@ TEST_F(TestActionServer, test_action_server_get_action_name)
   EXPECT_STREQ(action_name, "test_action_server_name");
 }
 
+TEST_F(TestActionServer, test_action_server_cache_result_response)
+{
+  uint8_t uuid[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  int response_storage[2];
+
+  // Cache with a null action server
+  rcl_ret_t ret = rcl_action_server_cache_result_response(
+    nullptr, uuid, &response_storage[0]);
+  EXPECT_EQ(ret, RCL_RET_ACTION_SERVER_INVALID);
+  rcl_reset_error();
+
+  // Cache with invalid arguments
+  ret = rcl_action_server_cache_result_response(
+    &this->action_server, nullptr, &response_storage[0]);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+  ret = rcl_action_server_cache_result_response(
+    &this->action_server, uuid, nullptr);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+
+  // Cache a response, then replace it for the same goal
+  ret = rcl_action_server_cache_result_response(
+    &this->action_server, uuid, &response_storage[0]);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_action_server_cache_result_response(
+    &this->action_server, uuid, &response_storage[1]);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  // Removing the entry, and removing an absent entry, both succeed
+  ret = rcl_action_server_uncache_result_response(&this->action_server, uuid);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_action_server_uncache_result_response(&this->action_server, uuid);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+}
+
 TEST_F(TestActionServer, test_action_server_get_options)
 {
   // Get options for a null action server
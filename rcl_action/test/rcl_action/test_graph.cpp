@@ -249,6 +249,41 @@ TEST_F(
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
 }
 
+TEST_F(
+  CLASSNAME(TestActionGraphFixture, RMW_IMPLEMENTATION),
+  test_action_names_and_types_cache)
+{
+  rcl_ret_t ret;
+  rcl_action_names_and_types_cache_t cache =
+    rcl_action_get_zero_initialized_names_and_types_cache();
+
+  // Invalid arguments
+  ret = rcl_action_names_and_types_cache_update(&this->node, nullptr, &cache);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_action_names_and_types_cache_update(&this->node, &this->allocator, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_action_names_and_types_cache_fini(nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  // The first update populates the cache
+  ret = rcl_action_names_and_types_cache_update(&this->node, &this->allocator, &cache);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_TRUE(cache.valid);
+
+  // An update over an unchanged graph is a no-op
+  const uint64_t epoch = cache.epoch;
+  ret = rcl_action_names_and_types_cache_update(&this->node, &this->allocator, &cache);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(epoch, cache.epoch);
+
+  ret = rcl_action_names_and_types_cache_fini(&cache);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_FALSE(cache.valid);
+}
+
 /**
  * Type define a get actions function.
  */
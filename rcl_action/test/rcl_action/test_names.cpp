@@ -137,3 +137,43 @@ INSTANTIATE_TEST_CASE_P(
   TestActionServiceAndTopicNames, TestActionDerivedName,
   ::testing::ValuesIn(action_service_and_topic_subjects),
   ::testing::PrintToStringParamName());
+
+TEST(TestActionDeriveNames, derive_names)
+{
+  rcl_allocator_t default_allocator = rcl_get_default_allocator();
+
+  rcl_action_derived_names_t derived_names =
+    rcl_action_get_zero_initialized_derived_names();
+  rcl_ret_t ret = rcl_action_derive_names(NULL, default_allocator, &derived_names);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_action_derive_names("", default_allocator, &derived_names);
+  EXPECT_EQ(RCL_RET_ACTION_NAME_INVALID, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  ret = rcl_action_derive_names("test_it", default_allocator, NULL);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  ret = rcl_action_derive_names("test_it", default_allocator, &derived_names);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_STREQ("test_it/_action/send_goal", derived_names.goal_service_name);
+  EXPECT_STREQ("test_it/_action/cancel_goal", derived_names.cancel_service_name);
+  EXPECT_STREQ("test_it/_action/get_result", derived_names.result_service_name);
+  EXPECT_STREQ("test_it/_action/feedback", derived_names.feedback_topic_name);
+  EXPECT_STREQ("test_it/_action/status", derived_names.status_topic_name);
+
+  // Deriving into an already populated struct may leak memory
+  ret = rcl_action_derive_names("test_it", default_allocator, &derived_names);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  ret = rcl_action_derived_names_fini(&derived_names);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(nullptr, derived_names.goal_service_name);
+
+  // Finalizing a zero-initialized struct is a no-op
+  ret = rcl_action_derived_names_fini(&derived_names);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
@@ -15,6 +15,8 @@
 #ifndef RCL_LIFECYCLE__DATA_TYPES_H_
 #define RCL_LIFECYCLE__DATA_TYPES_H_
 
+#include <stdbool.h>
+
 #include "rcl/rcl.h"
 
 #include "rcl_lifecycle/visibility_control.h"
@@ -49,6 +51,9 @@ typedef struct rcl_lifecycle_transition_map_t
   unsigned int states_size;
   rcl_lifecycle_transition_t * transitions;
   unsigned int transitions_size;
+  // True when states and transitions point into shared static storage,
+  // which must be neither modified nor freed
+  bool is_static;
 } rcl_lifecycle_transition_map_t;
 
 typedef struct rcl_lifecycle_com_interface_t
@@ -60,8 +65,40 @@ typedef struct rcl_lifecycle_com_interface_t
   rcl_service_t srv_get_available_states;
   rcl_service_t srv_get_available_transitions;
   rcl_service_t srv_get_transition_graph;
+  // Type supports retained for the introspection services
+  // whose creation may be deferred
+  const rosidl_service_type_support_t * ts_srv_get_available_states;
+  const rosidl_service_type_support_t * ts_srv_get_available_transitions;
+  const rosidl_service_type_support_t * ts_srv_get_transition_graph;
+  // True while the introspection services have not been created yet
+  bool introspection_services_deferred;
 } rcl_lifecycle_com_interface_t;
 
+// Lazily built cache of the introspection service response payloads,
+// defined in introspection.c
+typedef struct rcl_lifecycle_introspection_cache_t rcl_lifecycle_introspection_cache_t;
+
+// Number of transitions retained per state machine for post-incident debugging
+#define RCL_LIFECYCLE_TRANSITION_HISTORY_DEPTH 32
+
+typedef struct rcl_lifecycle_transition_record_t
+{
+  unsigned int transition_id;
+  // System time of the transition, 0 if the clock could not be read
+  rcutils_time_point_value_t timestamp;
+  rcl_ret_t result;
+} rcl_lifecycle_transition_record_t;
+
+typedef struct rcl_lifecycle_transition_history_t
+{
+  // Ring of the most recent transitions, overwritten oldest first
+  rcl_lifecycle_transition_record_t records[RCL_LIFECYCLE_TRANSITION_HISTORY_DEPTH];
+  // Total number of records ever written; the next slot is this modulo the
+  // depth. Stored as a plain integer so this header stays free of C11
+  // atomics, accessed atomically in the implementation.
+  uint64_t write_count_storage;
+} rcl_lifecycle_transition_history_t;
+
 typedef struct rcl_lifecycle_state_machine_t
 {
   const rcl_lifecycle_state_t * current_state;
@@ -69,6 +106,10 @@ typedef struct rcl_lifecycle_state_machine_t
   rcl_lifecycle_transition_map_t transition_map;
   // Communication interface into a ROS world
   rcl_lifecycle_com_interface_t com_interface;
+  // Cached introspection response payloads, NULL until first queried
+  rcl_lifecycle_introspection_cache_t * introspection_cache;
+  // Ring of the most recent transitions, see rcl_lifecycle_get_transition_history()
+  rcl_lifecycle_transition_history_t transition_history;
 } rcl_lifecycle_state_machine_t;
 
 #ifdef __cplusplus
@@ -42,6 +42,26 @@ rcl_ret_t
 rcl_lifecycle_init_default_state_machine(
   rcl_lifecycle_state_machine_t * state_machine, const rcl_allocator_t * allocator);
 
+/// Return the default machine's state with the given id, or NULL.
+/**
+ * Constant time lookup into the shared default state machine, used by
+ * rcl_lifecycle_get_state() for statically initialized transition maps.
+ */
+RCL_LIFECYCLE_PUBLIC
+RCL_WARN_UNUSED
+rcl_lifecycle_state_t *
+rcl_lifecycle_default_state_by_id(unsigned int state_id);
+
+/// Return the default machine's transition with the given id, or NULL.
+/**
+ * Constant time lookup into the shared default state machine, used by
+ * rcl_lifecycle_get_transitions() for statically initialized transition maps.
+ */
+RCL_LIFECYCLE_PUBLIC
+RCL_WARN_UNUSED
+rcl_lifecycle_transition_t *
+rcl_lifecycle_default_transition_by_id(unsigned int transition_id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,113 @@
+// Copyright 2016 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_LIFECYCLE__INTROSPECTION_H_
+#define RCL_LIFECYCLE__INTROSPECTION_H_
+
+#include "lifecycle_msgs/srv/get_available_states.h"
+#include "lifecycle_msgs/srv/get_available_transitions.h"
+
+#include "rcl_lifecycle/data_types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Get the cached get_available_states response payload.
+/**
+ * The state machine is immutable after initialization, so the answer to the
+ * introspection queries never changes; the response payload is built once on
+ * the first call and the same message is returned on every subsequent call,
+ * making the steady-state query allocation free.
+ * The string fields borrow the labels owned by the state machine rather than
+ * copying them, so the returned message is only valid until the state machine
+ * is finalized and must not be modified or finalized by the caller.
+ *
+ * \param[in] state_machine machine to answer the query for
+ * \param[in] allocator used to build the cache on the first call; the same
+ *   allocator must be passed to rcl_lifecycle_state_machine_fini()
+ * \return pointer to the cached response, or NULL if an error occurred, in
+ *   which case an error message is set
+ */
+RCL_LIFECYCLE_PUBLIC
+RCL_WARN_UNUSED
+const lifecycle_msgs__srv__GetAvailableStates_Response *
+rcl_lifecycle_get_available_states_message(
+  rcl_lifecycle_state_machine_t * state_machine,
+  const rcl_allocator_t * allocator);
+
+/// Get the cached get_available_transitions response payload.
+/**
+ * The available transitions depend only on the current state, which takes one
+ * of a fixed set of values, so one response payload per registered state is
+ * cached and the one matching the current state is returned.  Each payload is
+ * built on its first use; repeated queries from the same state return the
+ * same message without touching the allocator.
+ * See rcl_lifecycle_get_available_states_message() for the lifetime and
+ * ownership rules of the returned message.
+ *
+ * \param[in] state_machine machine to answer the query for
+ * \param[in] allocator used to build the cache on the first call; the same
+ *   allocator must be passed to rcl_lifecycle_state_machine_fini()
+ * \return pointer to the cached response for the current state, or NULL if an
+ *   error occurred, in which case an error message is set
+ */
+RCL_LIFECYCLE_PUBLIC
+RCL_WARN_UNUSED
+const lifecycle_msgs__srv__GetAvailableTransitions_Response *
+rcl_lifecycle_get_available_transitions_message(
+  rcl_lifecycle_state_machine_t * state_machine,
+  const rcl_allocator_t * allocator);
+
+/// Get the cached get_transition_graph response payload.
+/**
+ * Covers every registered transition independent of the current state.
+ * See rcl_lifecycle_get_available_states_message() for the caching behavior
+ * and the lifetime and ownership rules of the returned message.
+ *
+ * \param[in] state_machine machine to answer the query for
+ * \param[in] allocator used to build the cache on the first call; the same
+ *   allocator must be passed to rcl_lifecycle_state_machine_fini()
+ * \return pointer to the cached response, or NULL if an error occurred, in
+ *   which case an error message is set
+ */
+RCL_LIFECYCLE_PUBLIC
+RCL_WARN_UNUSED
+const lifecycle_msgs__srv__GetAvailableTransitions_Response *
+rcl_lifecycle_get_transition_graph_message(
+  rcl_lifecycle_state_machine_t * state_machine,
+  const rcl_allocator_t * allocator);
+
+/// Free the cached introspection response payloads, if any were built.
+/**
+ * Called by rcl_lifecycle_state_machine_fini(); only needs to be called
+ * directly to release the cache early.
+ *
+ * \param[in] state_machine machine whose cache is freed
+ * \param[in] allocator the allocator the cache was built with
+ * \return `RCL_RET_OK` if successful, or `RCL_RET_ERROR` otherwise
+ */
+RCL_LIFECYCLE_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_lifecycle_introspection_cache_fini(
+  rcl_lifecycle_state_machine_t * state_machine,
+  const rcl_allocator_t * allocator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL_LIFECYCLE__INTROSPECTION_H_
@@ -94,6 +94,41 @@ rcl_lifecycle_state_machine_init(
   bool default_states,
   const rcl_allocator_t * allocator);
 
+/// Initialize a state machine, deferring creation of the introspection services.
+/**
+ * Like rcl_lifecycle_state_machine_init(), but only the transition event
+ * publisher and the change_state and get_state services are created eagerly.
+ * The get_available_states, get_available_transitions and
+ * get_transition_graph services are not created until
+ * rcl_lifecycle_state_machine_create_introspection_services() is called,
+ * which reduces the per-node entity count and discovery traffic for nodes
+ * that are never introspected.
+ */
+RCL_LIFECYCLE_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_lifecycle_state_machine_init_with_deferred_services(
+  rcl_lifecycle_state_machine_t * state_machine,
+  rcl_node_t * node_handle,
+  const rosidl_message_type_support_t * ts_pub_notify,
+  const rosidl_service_type_support_t * ts_srv_change_state,
+  const rosidl_service_type_support_t * ts_srv_get_state,
+  const rosidl_service_type_support_t * ts_srv_get_available_states,
+  const rosidl_service_type_support_t * ts_srv_get_available_transitions,
+  const rosidl_service_type_support_t * ts_srv_get_transition_graph,
+  bool default_states,
+  const rcl_allocator_t * allocator);
+
+/// Create the introspection services whose creation was deferred.
+/**
+ * A no-op if the services already exist.
+ */
+RCL_LIFECYCLE_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_lifecycle_state_machine_create_introspection_services(
+  rcl_lifecycle_state_machine_t * state_machine);
+
 RCL_LIFECYCLE_PUBLIC
 RCL_WARN_UNUSED
 rcl_ret_t
@@ -138,6 +173,44 @@ rcl_lifecycle_trigger_transition_by_label(
   const char * label,
   bool publish_notification);
 
+/// Trigger the same transition on a batch of state machines.
+/**
+ * The transition is resolved for every machine before any machine moves,
+ * so an unregistered transition on any machine leaves the whole batch
+ * unchanged.
+ * Notifications are published after all machines have transitioned.
+ */
+RCL_LIFECYCLE_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_lifecycle_trigger_transitions_by_id(
+  rcl_lifecycle_state_machine_t ** state_machines,
+  size_t state_machines_size,
+  uint8_t id,
+  bool publish_notification,
+  const rcl_allocator_t * allocator);
+
+/// Snapshot the most recent transitions of a state machine.
+/**
+ * Every executed transition is recorded in a fixed-size ring on the state
+ * machine (id, timestamp and result, see
+ * RCL_LIFECYCLE_TRANSITION_HISTORY_DEPTH), cheap enough to stay enabled in
+ * production and read after an incident instead of logging every transition.
+ *
+ * Copies up to `records_capacity` of the most recent records into `records`,
+ * oldest first, and sets `num_records` to the number copied.
+ * Reading is safe while another thread transitions the machine; records from
+ * transitions racing the snapshot may be missed or partially updated.
+ */
+RCL_LIFECYCLE_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_lifecycle_get_transition_history(
+  const rcl_lifecycle_state_machine_t * state_machine,
+  rcl_lifecycle_transition_record_t * records,
+  size_t records_capacity,
+  size_t * num_records);
+
 RCL_LIFECYCLE_PUBLIC
 void
 rcl_print_state_machine(const rcl_lifecycle_state_machine_t * state_machine);
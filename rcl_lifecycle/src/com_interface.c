@@ -44,6 +44,24 @@ static const char * srv_get_available_states_service = "~/get_available_states";
 static const char * srv_get_available_transitions_service = "~/get_available_transitions";
 static const char * srv_get_transition_graph = "~/get_transition_graph";
 
+// Implementation only
+static void
+_borrow_label(rosidl_generator_c__String * str, const char * label)
+{
+  str->data = (char *)label;
+  str->size = strlen(label);
+  str->capacity = str->size + 1;
+}
+
+// Implementation only
+static void
+_return_label(rosidl_generator_c__String * str)
+{
+  str->data = NULL;
+  str->size = 0;
+  str->capacity = 0;
+}
+
 rcl_lifecycle_com_interface_t
 rcl_lifecycle_get_zero_initialized_com_interface()
 {
@@ -55,6 +73,10 @@ rcl_lifecycle_get_zero_initialized_com_interface()
   com_interface.srv_get_available_states = rcl_get_zero_initialized_service();
   com_interface.srv_get_available_transitions = rcl_get_zero_initialized_service();
   com_interface.srv_get_transition_graph = rcl_get_zero_initialized_service();
+  com_interface.ts_srv_get_available_states = NULL;
+  com_interface.ts_srv_get_available_transitions = NULL;
+  com_interface.ts_srv_get_transition_graph = NULL;
+  com_interface.introspection_services_deferred = false;
   return com_interface;
 }
 
@@ -67,7 +89,8 @@ rcl_lifecycle_com_interface_init(
   const rosidl_service_type_support_t * ts_srv_get_state,
   const rosidl_service_type_support_t * ts_srv_get_available_states,
   const rosidl_service_type_support_t * ts_srv_get_available_transitions,
-  const rosidl_service_type_support_t * ts_srv_get_transition_graph)
+  const rosidl_service_type_support_t * ts_srv_get_transition_graph,
+  bool defer_introspection_services)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(com_interface, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(node_handle, RCL_RET_INVALID_ARGUMENT);
@@ -78,6 +101,15 @@ rcl_lifecycle_com_interface_init(
   RCL_CHECK_ARGUMENT_FOR_NULL(ts_srv_get_available_transitions, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(ts_srv_get_transition_graph, RCL_RET_INVALID_ARGUMENT);
 
+  com_interface->node_handle = node_handle;
+
+  // retain the type supports of the introspection services so their
+  // creation can be deferred until they are actually needed
+  com_interface->ts_srv_get_available_states = ts_srv_get_available_states;
+  com_interface->ts_srv_get_available_transitions = ts_srv_get_available_transitions;
+  com_interface->ts_srv_get_transition_graph = ts_srv_get_transition_graph;
+  com_interface->introspection_services_deferred = true;
+
   // initialize publisher
   {
     rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
@@ -91,6 +123,10 @@ rcl_lifecycle_com_interface_init(
 
     // initialize static message for notification
     lifecycle_msgs__msg__TransitionEvent__init(&msg);
+    // the state label fields borrow the states' statically stored labels
+    // instead of copying them, so release their owned storage up front
+    rosidl_generator_c__String__fini(&msg.start_state.label);
+    rosidl_generator_c__String__fini(&msg.goal_state.label);
   }
 
   // initialize change state service
@@ -117,12 +153,61 @@ rcl_lifecycle_com_interface_init(
     }
   }
 
+  // initialize introspection services, unless their creation is deferred
+  if (!defer_introspection_services) {
+    rcl_ret_t ret = rcl_lifecycle_com_interface_create_introspection_services(com_interface);
+
+    if (ret != RCL_RET_OK) {
+      goto fail;
+    }
+  }
+  return RCL_RET_OK;
+
+fail:
+  if (RCL_RET_OK != rcl_publisher_fini(&com_interface->pub_transition_event, node_handle)) {
+    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to destroy transition_event publisher");
+  }
+  if (RCL_RET_OK != rcl_service_fini(&com_interface->srv_change_state, node_handle)) {
+    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to destroy change_state service");
+  }
+  if (RCL_RET_OK != rcl_service_fini(&com_interface->srv_get_state, node_handle)) {
+    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to destroy get_state service");
+  }
+  if (RCL_RET_OK != rcl_service_fini(&com_interface->srv_get_available_states, node_handle)) {
+    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to destroy get_available_states service");
+  }
+  if (RCL_RET_OK != rcl_service_fini(&com_interface->srv_get_available_transitions, node_handle)) {
+    RCUTILS_LOG_ERROR_NAMED(
+      ROS_PACKAGE_NAME, "Failed to destroy get_available_transitions service");
+  }
+  if (RCL_RET_OK != rcl_service_fini(&com_interface->srv_get_transition_graph, node_handle)) {
+    RCUTILS_LOG_ERROR_NAMED(
+      ROS_PACKAGE_NAME, "Failed to destroy get_transition_graph service");
+  }
+
+  return RCL_RET_ERROR;
+}
+
+rcl_ret_t
+rcl_lifecycle_com_interface_create_introspection_services(
+  rcl_lifecycle_com_interface_t * com_interface)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(com_interface, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(com_interface->node_handle, RCL_RET_INVALID_ARGUMENT);
+
+  if (!com_interface->introspection_services_deferred) {
+    return RCL_RET_OK;
+  }
+
+  rcl_node_t * node_handle = com_interface->node_handle;
+
   // initialize get available states service
   {
     rcl_service_options_t service_options = rcl_service_get_default_options();
     rcl_ret_t ret = rcl_service_init(
       &com_interface->srv_get_available_states, node_handle,
-      ts_srv_get_available_states, srv_get_available_states_service, &service_options);
+      com_interface->ts_srv_get_available_states,
+      srv_get_available_states_service, &service_options);
 
     if (ret != RCL_RET_OK) {
       goto fail;
@@ -134,7 +219,8 @@ rcl_lifecycle_com_interface_init(
     rcl_service_options_t service_options = rcl_service_get_default_options();
     rcl_ret_t ret = rcl_service_init(
       &com_interface->srv_get_available_transitions, node_handle,
-      ts_srv_get_available_transitions, srv_get_available_transitions_service, &service_options);
+      com_interface->ts_srv_get_available_transitions,
+      srv_get_available_transitions_service, &service_options);
 
     if (ret != RCL_RET_OK) {
       goto fail;
@@ -146,24 +232,18 @@ rcl_lifecycle_com_interface_init(
     rcl_service_options_t service_options = rcl_service_get_default_options();
     rcl_ret_t ret = rcl_service_init(
       &com_interface->srv_get_transition_graph, node_handle,
-      ts_srv_get_transition_graph, srv_get_transition_graph, &service_options);
+      com_interface->ts_srv_get_transition_graph,
+      srv_get_transition_graph, &service_options);
 
     if (ret != RCL_RET_OK) {
       goto fail;
     }
   }
+
+  com_interface->introspection_services_deferred = false;
   return RCL_RET_OK;
 
 fail:
-  if (RCL_RET_OK != rcl_publisher_fini(&com_interface->pub_transition_event, node_handle)) {
-    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to destroy transition_event publisher");
-  }
-  if (RCL_RET_OK != rcl_service_fini(&com_interface->srv_change_state, node_handle)) {
-    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to destroy change_state service");
-  }
-  if (RCL_RET_OK != rcl_service_fini(&com_interface->srv_get_state, node_handle)) {
-    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to destroy get_state service");
-  }
   if (RCL_RET_OK != rcl_service_fini(&com_interface->srv_get_available_states, node_handle)) {
     RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to destroy get_available_states service");
   }
@@ -233,6 +313,9 @@ rcl_lifecycle_com_interface_fini(
 
   // destroy the publisher
   {
+    // the label fields borrow the states' storage, which must not be freed here
+    _return_label(&msg.start_state.label);
+    _return_label(&msg.goal_state.label);
     lifecycle_msgs__msg__TransitionEvent__fini(&msg);
 
     rcl_ret_t ret = rcl_publisher_fini(
@@ -242,6 +325,11 @@ rcl_lifecycle_com_interface_fini(
     }
   }
 
+  com_interface->ts_srv_get_available_states = NULL;
+  com_interface->ts_srv_get_available_transitions = NULL;
+  com_interface->ts_srv_get_transition_graph = NULL;
+  com_interface->introspection_services_deferred = false;
+
   return fcn_ret;
 }
 
@@ -250,10 +338,14 @@ rcl_lifecycle_com_interface_publish_notification(
   rcl_lifecycle_com_interface_t * com_interface,
   const rcl_lifecycle_state_t * start, const rcl_lifecycle_state_t * goal)
 {
+  // The state labels live as long as the state machine (they either point to
+  // static storage or are owned by the states), so the preallocated message
+  // borrows them instead of copying; publishing a transition touches no
+  // allocator.
   msg.start_state.id = start->id;
-  rosidl_generator_c__String__assign(&msg.start_state.label, start->label);
+  _borrow_label(&msg.start_state.label, start->label);
   msg.goal_state.id = goal->id;
-  rosidl_generator_c__String__assign(&msg.goal_state.label, goal->label);
+  _borrow_label(&msg.goal_state.label, goal->label);
 
   return rcl_publish(&com_interface->pub_transition_event, &msg, NULL);
 }
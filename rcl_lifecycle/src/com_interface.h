@@ -20,6 +20,8 @@ extern "C"
 {
 #endif
 
+#include <stdbool.h>
+
 #include "rcl/macros.h"
 
 #include "rcl_lifecycle/data_types.h"
@@ -37,7 +39,13 @@ rcl_lifecycle_com_interface_init(
   const rosidl_service_type_support_t * ts_srv_get_state,
   const rosidl_service_type_support_t * ts_srv_get_available_states,
   const rosidl_service_type_support_t * ts_srv_get_available_transitions,
-  const rosidl_service_type_support_t * ts_srv_get_transition_graph);
+  const rosidl_service_type_support_t * ts_srv_get_transition_graph,
+  bool defer_introspection_services);
+
+rcl_ret_t
+RCL_WARN_UNUSED
+rcl_lifecycle_com_interface_create_introspection_services(
+  rcl_lifecycle_com_interface_t * com_interface);
 
 rcl_ret_t
 RCL_WARN_UNUSED
@@ -14,15 +14,10 @@
 
 #include "rcl_lifecycle/default_state_machine.h"
 
-#include <stdlib.h>
-#include <stdio.h>
-#include <string.h>
-
 #include "lifecycle_msgs/msg/state.h"
 #include "lifecycle_msgs/msg/transition.h"
 
 #include "rcl/error_handling.h"
-#include "rcl/rcl.h"
 
 #include "rcl_lifecycle/transition_map.h"
 
@@ -41,613 +36,292 @@ const char * rcl_lifecycle_transition_success_label = "transition_success";
 const char * rcl_lifecycle_transition_failure_label = "transition_failure";
 const char * rcl_lifecycle_transition_error_label = "transition_error";
 
-rcl_ret_t
-_register_primary_states(
-  rcl_lifecycle_transition_map_t * transition_map, const rcutils_allocator_t * allocator)
-{
-  rcl_ret_t ret = RCL_RET_ERROR;
-
-  // default values for when registering states
-  // all states are registered with no transitions attached
-  // the valid transitions per state are filled once transitions are registered
-  rcl_lifecycle_transition_t * valid_transitions = NULL;
-  unsigned int valid_transition_size = 0;
-
-  // register unknown state
-  {
-    rcl_lifecycle_state_t rcl_state_unknown = {
-      "unknown", lifecycle_msgs__msg__State__PRIMARY_STATE_UNKNOWN,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_unknown, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register unconfigured state
-  {
-    rcl_lifecycle_state_t rcl_state_unconfigured = {
-      "unconfigured", lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_unconfigured, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register inactive state
-  {
-    rcl_lifecycle_state_t rcl_state_inactive = {
-      "inactive", lifecycle_msgs__msg__State__PRIMARY_STATE_INACTIVE,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_inactive, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register active state
-  {
-    rcl_lifecycle_state_t rcl_state_active = {
-      "active", lifecycle_msgs__msg__State__PRIMARY_STATE_ACTIVE,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_active, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register finalized state
-  {
-    rcl_lifecycle_state_t rcl_state_finalized = {
-      "finalized", lifecycle_msgs__msg__State__PRIMARY_STATE_FINALIZED,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_finalized, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  return ret;
-}
+// The default state machine is identical for every node, so it is built once
+// as immutable static storage shared by all state machine instances instead
+// of being re-registered (and reallocated) for every node.
+// See the is_static flag on rcl_lifecycle_transition_map_t.
 
-rcl_ret_t
-_register_transition_states(
-  rcl_lifecycle_transition_map_t * transition_map, const rcutils_allocator_t * allocator)
+// Indices into _default_states; the ids are the lifecycle_msgs constants.
+enum
 {
-  rcl_ret_t ret = RCL_RET_ERROR;
-
-  // default values for when registering states
-  // all states are registered with no transitions attached
-  // the valid transitions per state are filled once transitions are registered
-  rcl_lifecycle_transition_t * valid_transitions = NULL;
-  unsigned int valid_transition_size = 0;
-
-  // register configuring state
-  {
-    rcl_lifecycle_state_t rcl_state_configuring = {
-      "configuring", lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_configuring, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register cleaningup state
-  {
-    rcl_lifecycle_state_t rcl_state_cleaningup = {
-      "cleaningup", lifecycle_msgs__msg__State__TRANSITION_STATE_CLEANINGUP,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_cleaningup, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register shutting down state
-  {
-    rcl_lifecycle_state_t rcl_state_shuttingdown = {
-      "shuttingdown", lifecycle_msgs__msg__State__TRANSITION_STATE_SHUTTINGDOWN,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_shuttingdown, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register activating state
-  {
-    rcl_lifecycle_state_t rcl_state_activating = {
-      "activating", lifecycle_msgs__msg__State__TRANSITION_STATE_ACTIVATING,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_activating, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register deactivating state
-  {
-    rcl_lifecycle_state_t rcl_state_deactivating = {
-      "deactivating", lifecycle_msgs__msg__State__TRANSITION_STATE_DEACTIVATING,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_deactivating, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register errorprocessing state
-  {
-    rcl_lifecycle_state_t rcl_state_errorprocessing = {
-      "errorprocessing", lifecycle_msgs__msg__State__TRANSITION_STATE_ERRORPROCESSING,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_errorprocessing, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
+  _STATE_INDEX_UNKNOWN = 0,
+  _STATE_INDEX_UNCONFIGURED,
+  _STATE_INDEX_INACTIVE,
+  _STATE_INDEX_ACTIVE,
+  _STATE_INDEX_FINALIZED,
+  _STATE_INDEX_CONFIGURING,
+  _STATE_INDEX_CLEANINGUP,
+  _STATE_INDEX_SHUTTINGDOWN,
+  _STATE_INDEX_ACTIVATING,
+  _STATE_INDEX_DEACTIVATING,
+  _STATE_INDEX_ERRORPROCESSING,
+  _STATE_INDEX_COUNT
+};
+
+static rcl_lifecycle_state_t _default_states[_STATE_INDEX_COUNT];
+
+// All transitions as depicted on design.ros2.org, grouped by their start
+// state so that every state's valid transitions are a contiguous slice of
+// this array.
+static rcl_lifecycle_transition_t _default_transitions[] = {
+  // valid transitions out of the unconfigured state
+  {
+    "configure", lifecycle_msgs__msg__Transition__TRANSITION_CONFIGURE,
+    &_default_states[_STATE_INDEX_UNCONFIGURED], &_default_states[_STATE_INDEX_CONFIGURING]
+  },
+  {
+    "shutdown", lifecycle_msgs__msg__Transition__TRANSITION_UNCONFIGURED_SHUTDOWN,
+    &_default_states[_STATE_INDEX_UNCONFIGURED], &_default_states[_STATE_INDEX_SHUTTINGDOWN]
+  },
+  // valid transitions out of the inactive state
+  {
+    "cleanup", lifecycle_msgs__msg__Transition__TRANSITION_CLEANUP,
+    &_default_states[_STATE_INDEX_INACTIVE], &_default_states[_STATE_INDEX_CLEANINGUP]
+  },
+  {
+    "activate", lifecycle_msgs__msg__Transition__TRANSITION_ACTIVATE,
+    &_default_states[_STATE_INDEX_INACTIVE], &_default_states[_STATE_INDEX_ACTIVATING]
+  },
+  {
+    "shutdown", lifecycle_msgs__msg__Transition__TRANSITION_INACTIVE_SHUTDOWN,
+    &_default_states[_STATE_INDEX_INACTIVE], &_default_states[_STATE_INDEX_SHUTTINGDOWN]
+  },
+  // valid transitions out of the active state
+  {
+    "deactivate", lifecycle_msgs__msg__Transition__TRANSITION_DEACTIVATE,
+    &_default_states[_STATE_INDEX_ACTIVE], &_default_states[_STATE_INDEX_DEACTIVATING]
+  },
+  {
+    "shutdown", lifecycle_msgs__msg__Transition__TRANSITION_ACTIVE_SHUTDOWN,
+    &_default_states[_STATE_INDEX_ACTIVE], &_default_states[_STATE_INDEX_SHUTTINGDOWN]
+  },
+  // valid transitions out of the configuring state
+  {
+    "transition_success", lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_SUCCESS,
+    &_default_states[_STATE_INDEX_CONFIGURING], &_default_states[_STATE_INDEX_INACTIVE]
+  },
+  {
+    "transition_failure", lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_FAILURE,
+    &_default_states[_STATE_INDEX_CONFIGURING], &_default_states[_STATE_INDEX_UNCONFIGURED]
+  },
+  {
+    "transition_error", lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_ERROR,
+    &_default_states[_STATE_INDEX_CONFIGURING], &_default_states[_STATE_INDEX_ERRORPROCESSING]
+  },
+  // valid transitions out of the cleaningup state
+  {
+    "transition_success", lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_SUCCESS,
+    &_default_states[_STATE_INDEX_CLEANINGUP], &_default_states[_STATE_INDEX_UNCONFIGURED]
+  },
+  {
+    "transition_failure", lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_FAILURE,
+    &_default_states[_STATE_INDEX_CLEANINGUP], &_default_states[_STATE_INDEX_INACTIVE]
+  },
+  {
+    "transition_error", lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_ERROR,
+    &_default_states[_STATE_INDEX_CLEANINGUP], &_default_states[_STATE_INDEX_ERRORPROCESSING]
+  },
+  // valid transitions out of the activating state
+  {
+    "transition_success", lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_SUCCESS,
+    &_default_states[_STATE_INDEX_ACTIVATING], &_default_states[_STATE_INDEX_ACTIVE]
+  },
+  {
+    "transition_failure", lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_FAILURE,
+    &_default_states[_STATE_INDEX_ACTIVATING], &_default_states[_STATE_INDEX_INACTIVE]
+  },
+  {
+    "transition_error", lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_ERROR,
+    &_default_states[_STATE_INDEX_ACTIVATING], &_default_states[_STATE_INDEX_ERRORPROCESSING]
+  },
+  // valid transitions out of the deactivating state
+  {
+    "transition_success", lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_SUCCESS,
+    &_default_states[_STATE_INDEX_DEACTIVATING], &_default_states[_STATE_INDEX_INACTIVE]
+  },
+  {
+    "transition_failure", lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_FAILURE,
+    &_default_states[_STATE_INDEX_DEACTIVATING], &_default_states[_STATE_INDEX_ACTIVE]
+  },
+  {
+    "transition_error", lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_ERROR,
+    &_default_states[_STATE_INDEX_DEACTIVATING], &_default_states[_STATE_INDEX_ERRORPROCESSING]
+  },
+  // valid transitions out of the shuttingdown state
+  {
+    "transition_success", lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_SUCCESS,
+    &_default_states[_STATE_INDEX_SHUTTINGDOWN], &_default_states[_STATE_INDEX_FINALIZED]
+  },
+  {
+    "transition_failure", lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_FAILURE,
+    &_default_states[_STATE_INDEX_SHUTTINGDOWN], &_default_states[_STATE_INDEX_FINALIZED]
+  },
+  {
+    "transition_error", lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_ERROR,
+    &_default_states[_STATE_INDEX_SHUTTINGDOWN], &_default_states[_STATE_INDEX_ERRORPROCESSING]
+  },
+  // valid transitions out of the errorprocessing state
+  {
+    "transition_success", lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_SUCCESS,
+    &_default_states[_STATE_INDEX_ERRORPROCESSING], &_default_states[_STATE_INDEX_UNCONFIGURED]
+  },
+  {
+    "transition_failure", lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_FAILURE,
+    &_default_states[_STATE_INDEX_ERRORPROCESSING], &_default_states[_STATE_INDEX_FINALIZED]
+  },
+  {
+    "transition_error", lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_ERROR,
+    &_default_states[_STATE_INDEX_ERRORPROCESSING], &_default_states[_STATE_INDEX_FINALIZED]
+  },
+};
+
+// Each state's valid transitions alias the slice of _default_transitions
+// which starts with the given state.
+static rcl_lifecycle_state_t _default_states[_STATE_INDEX_COUNT] = {
+  [_STATE_INDEX_UNKNOWN] = {
+    "unknown", lifecycle_msgs__msg__State__PRIMARY_STATE_UNKNOWN,
+    NULL, 0
+  },
+  [_STATE_INDEX_UNCONFIGURED] = {
+    "unconfigured", lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED,
+    &_default_transitions[0], 2
+  },
+  [_STATE_INDEX_INACTIVE] = {
+    "inactive", lifecycle_msgs__msg__State__PRIMARY_STATE_INACTIVE,
+    &_default_transitions[2], 3
+  },
+  [_STATE_INDEX_ACTIVE] = {
+    "active", lifecycle_msgs__msg__State__PRIMARY_STATE_ACTIVE,
+    &_default_transitions[5], 2
+  },
+  [_STATE_INDEX_FINALIZED] = {
+    "finalized", lifecycle_msgs__msg__State__PRIMARY_STATE_FINALIZED,
+    NULL, 0
+  },
+  [_STATE_INDEX_CONFIGURING] = {
+    "configuring", lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING,
+    &_default_transitions[7], 3
+  },
+  [_STATE_INDEX_CLEANINGUP] = {
+    "cleaningup", lifecycle_msgs__msg__State__TRANSITION_STATE_CLEANINGUP,
+    &_default_transitions[10], 3
+  },
+  [_STATE_INDEX_ACTIVATING] = {
+    "activating", lifecycle_msgs__msg__State__TRANSITION_STATE_ACTIVATING,
+    &_default_transitions[13], 3
+  },
+  [_STATE_INDEX_DEACTIVATING] = {
+    "deactivating", lifecycle_msgs__msg__State__TRANSITION_STATE_DEACTIVATING,
+    &_default_transitions[16], 3
+  },
+  [_STATE_INDEX_SHUTTINGDOWN] = {
+    "shuttingdown", lifecycle_msgs__msg__State__TRANSITION_STATE_SHUTTINGDOWN,
+    &_default_transitions[19], 3
+  },
+  [_STATE_INDEX_ERRORPROCESSING] = {
+    "errorprocessing", lifecycle_msgs__msg__State__TRANSITION_STATE_ERRORPROCESSING,
+    &_default_transitions[22], 3
+  },
+};
+
+// Direct lookup tables for the shared default machine, indexed by the
+// lifecycle_msgs id. Entries without an initializer are NULL.
+static rcl_lifecycle_state_t * const
+  _default_state_by_id[lifecycle_msgs__msg__State__TRANSITION_STATE_ERRORPROCESSING + 1] = {
+  [lifecycle_msgs__msg__State__PRIMARY_STATE_UNKNOWN] =
+    &_default_states[_STATE_INDEX_UNKNOWN],
+  [lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED] =
+    &_default_states[_STATE_INDEX_UNCONFIGURED],
+  [lifecycle_msgs__msg__State__PRIMARY_STATE_INACTIVE] =
+    &_default_states[_STATE_INDEX_INACTIVE],
+  [lifecycle_msgs__msg__State__PRIMARY_STATE_ACTIVE] =
+    &_default_states[_STATE_INDEX_ACTIVE],
+  [lifecycle_msgs__msg__State__PRIMARY_STATE_FINALIZED] =
+    &_default_states[_STATE_INDEX_FINALIZED],
+  [lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING] =
+    &_default_states[_STATE_INDEX_CONFIGURING],
+  [lifecycle_msgs__msg__State__TRANSITION_STATE_CLEANINGUP] =
+    &_default_states[_STATE_INDEX_CLEANINGUP],
+  [lifecycle_msgs__msg__State__TRANSITION_STATE_SHUTTINGDOWN] =
+    &_default_states[_STATE_INDEX_SHUTTINGDOWN],
+  [lifecycle_msgs__msg__State__TRANSITION_STATE_ACTIVATING] =
+    &_default_states[_STATE_INDEX_ACTIVATING],
+  [lifecycle_msgs__msg__State__TRANSITION_STATE_DEACTIVATING] =
+    &_default_states[_STATE_INDEX_DEACTIVATING],
+  [lifecycle_msgs__msg__State__TRANSITION_STATE_ERRORPROCESSING] =
+    &_default_states[_STATE_INDEX_ERRORPROCESSING],
+};
+
+static rcl_lifecycle_transition_t * const
+  _default_transition_by_id[lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_ERROR + 1] = {
+  [lifecycle_msgs__msg__Transition__TRANSITION_CONFIGURE] =
+    &_default_transitions[0],
+  [lifecycle_msgs__msg__Transition__TRANSITION_UNCONFIGURED_SHUTDOWN] =
+    &_default_transitions[1],
+  [lifecycle_msgs__msg__Transition__TRANSITION_CLEANUP] =
+    &_default_transitions[2],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ACTIVATE] =
+    &_default_transitions[3],
+  [lifecycle_msgs__msg__Transition__TRANSITION_INACTIVE_SHUTDOWN] =
+    &_default_transitions[4],
+  [lifecycle_msgs__msg__Transition__TRANSITION_DEACTIVATE] =
+    &_default_transitions[5],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ACTIVE_SHUTDOWN] =
+    &_default_transitions[6],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_SUCCESS] =
+    &_default_transitions[7],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_FAILURE] =
+    &_default_transitions[8],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_ERROR] =
+    &_default_transitions[9],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_SUCCESS] =
+    &_default_transitions[10],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_FAILURE] =
+    &_default_transitions[11],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_ERROR] =
+    &_default_transitions[12],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_SUCCESS] =
+    &_default_transitions[13],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_FAILURE] =
+    &_default_transitions[14],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_ERROR] =
+    &_default_transitions[15],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_SUCCESS] =
+    &_default_transitions[16],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_FAILURE] =
+    &_default_transitions[17],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_ERROR] =
+    &_default_transitions[18],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_SUCCESS] =
+    &_default_transitions[19],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_FAILURE] =
+    &_default_transitions[20],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_ERROR] =
+    &_default_transitions[21],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_SUCCESS] =
+    &_default_transitions[22],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_FAILURE] =
+    &_default_transitions[23],
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_ERROR] =
+    &_default_transitions[24],
+};
+
+rcl_lifecycle_state_t *
+rcl_lifecycle_default_state_by_id(unsigned int state_id)
+{
+  if (state_id >= sizeof(_default_state_by_id) / sizeof(_default_state_by_id[0])) {
+    return NULL;
   }
-
-  return ret;
+  return _default_state_by_id[state_id];
 }
 
-rcl_ret_t
-_register_transitions(
-  rcl_lifecycle_transition_map_t * transition_map, const rcutils_allocator_t * allocator)
+rcl_lifecycle_transition_t *
+rcl_lifecycle_default_transition_by_id(unsigned int transition_id)
 {
-  rcl_ret_t ret = RCL_RET_ERROR;
-
-  // retrieve primary and transition states from the transition map
-  // note: These states are pointing to the states inside the map
-  // the states created before (see _register_primary_states) were copied into the map
-  // and thus have to be retrieved from the map again to not invalidate pointers.
-
-  rcl_lifecycle_state_t * unconfigured_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED);
-  rcl_lifecycle_state_t * inactive_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__PRIMARY_STATE_INACTIVE);
-  rcl_lifecycle_state_t * active_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__PRIMARY_STATE_ACTIVE);
-  rcl_lifecycle_state_t * finalized_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__PRIMARY_STATE_FINALIZED);
-
-  rcl_lifecycle_state_t * configuring_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING);
-  rcl_lifecycle_state_t * activating_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__TRANSITION_STATE_ACTIVATING);
-  rcl_lifecycle_state_t * deactivating_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__TRANSITION_STATE_DEACTIVATING);
-  rcl_lifecycle_state_t * cleaningup_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__TRANSITION_STATE_CLEANINGUP);
-  rcl_lifecycle_state_t * shuttingdown_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__TRANSITION_STATE_SHUTTINGDOWN);
-  rcl_lifecycle_state_t * errorprocessing_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__TRANSITION_STATE_ERRORPROCESSING);
-
-  // register transition from unconfigured to configuring
-  {
-    rcl_lifecycle_transition_t rcl_transition_configure = {
-      rcl_lifecycle_configure_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_CONFIGURE,
-      unconfigured_state, configuring_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_configure,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from configuring to inactive
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_configure_success = {
-      rcl_lifecycle_transition_success_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_SUCCESS,
-      configuring_state, inactive_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_configure_success,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from configuring to unconfigured
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_configure_failure = {
-      rcl_lifecycle_transition_failure_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_FAILURE,
-      configuring_state, unconfigured_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_configure_failure,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from configuring to errorprocessing
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_configure_error = {
-      rcl_lifecycle_transition_error_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_ERROR,
-      configuring_state, errorprocessing_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_configure_error,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from inactive to cleaningup
-  {
-    rcl_lifecycle_transition_t rcl_transition_cleanup = {
-      rcl_lifecycle_cleanup_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_CLEANUP,
-      inactive_state, cleaningup_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_cleanup,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from cleaningup to unconfigured
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_cleanup_success = {
-      rcl_lifecycle_transition_success_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_SUCCESS,
-      cleaningup_state, unconfigured_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_cleanup_success,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
+  if (transition_id >= sizeof(_default_transition_by_id) / sizeof(_default_transition_by_id[0])) {
+    return NULL;
   }
-
-  // register transition from cleaningup to inactive
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_cleanup_failure = {
-      rcl_lifecycle_transition_failure_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_FAILURE,
-      cleaningup_state, inactive_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_cleanup_failure,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from cleaniningup to errorprocessing
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_cleanup_error = {
-      rcl_lifecycle_transition_error_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_ERROR,
-      cleaningup_state, errorprocessing_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_cleanup_error,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from inactive to activating
-  {
-    rcl_lifecycle_transition_t rcl_transition_activate = {
-      rcl_lifecycle_activate_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ACTIVATE,
-      inactive_state, activating_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_activate,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from activating to active
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_activate_success = {
-      rcl_lifecycle_transition_success_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_SUCCESS,
-      activating_state, active_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_activate_success,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from activating to inactive
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_activate_failure = {
-      rcl_lifecycle_transition_failure_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_FAILURE,
-      activating_state, inactive_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_activate_failure,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from activating to errorprocessing
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_activate_error = {
-      rcl_lifecycle_transition_error_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_ERROR,
-      activating_state, errorprocessing_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_activate_error,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from active to deactivating
-  {
-    rcl_lifecycle_transition_t rcl_transition_deactivate = {
-      rcl_lifecycle_deactivate_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_DEACTIVATE,
-      active_state, deactivating_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_deactivate,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from deactivating to inactive
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_deactivate_success = {
-      rcl_lifecycle_transition_success_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_SUCCESS,
-      deactivating_state, inactive_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_deactivate_success,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from deactivating to active
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_deactivate_failure = {
-      rcl_lifecycle_transition_failure_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_FAILURE,
-      deactivating_state, active_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_deactivate_failure,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from deactivating to errorprocessing
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_deactivate_error = {
-      rcl_lifecycle_transition_error_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_ERROR,
-      deactivating_state, errorprocessing_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_deactivate_error,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from unconfigured to shuttingdown
-  {
-    rcl_lifecycle_transition_t rcl_transition_unconfigured_shutdown = {
-      rcl_lifecycle_shutdown_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_UNCONFIGURED_SHUTDOWN,
-      unconfigured_state, shuttingdown_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_unconfigured_shutdown,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from inactive to shuttingdown
-  {
-    rcl_lifecycle_transition_t rcl_transition_inactive_shutdown = {
-      rcl_lifecycle_shutdown_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_INACTIVE_SHUTDOWN,
-      inactive_state, shuttingdown_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_inactive_shutdown,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from active to shuttingdown
-  {
-    rcl_lifecycle_transition_t rcl_transition_active_shutdown = {
-      rcl_lifecycle_shutdown_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ACTIVE_SHUTDOWN,
-      active_state, shuttingdown_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_active_shutdown,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from shutting down to finalized
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_shutdown_success = {
-      rcl_lifecycle_transition_success_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_SUCCESS,
-      shuttingdown_state, finalized_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_shutdown_success,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from shutting down to finalized
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_shutdown_failure = {
-      rcl_lifecycle_transition_failure_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_FAILURE,
-      shuttingdown_state, finalized_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_shutdown_failure,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from shutting down to errorprocessing
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_shutdown_error = {
-      rcl_lifecycle_transition_error_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_ERROR,
-      shuttingdown_state, errorprocessing_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_shutdown_error,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from errorprocessing to uncofigured
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_error_success = {
-      rcl_lifecycle_transition_success_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_SUCCESS,
-      errorprocessing_state, unconfigured_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_error_success,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from errorprocessing to finalized
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_error_failure = {
-      rcl_lifecycle_transition_failure_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_FAILURE,
-      errorprocessing_state, finalized_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_error_failure,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from errorprocessing to finalized
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_error_error = {
-      rcl_lifecycle_transition_error_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_ERROR,
-      errorprocessing_state, finalized_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_error_error,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  return ret;
+  return _default_transition_by_id[transition_id];
 }
 
 // default implementation as despicted on
@@ -656,45 +330,31 @@ rcl_ret_t
 rcl_lifecycle_init_default_state_machine(
   rcl_lifecycle_state_machine_t * state_machine, const rcutils_allocator_t * allocator)
 {
-  rcl_ret_t ret = RCL_RET_ERROR;
+  // the shared default machine is statically allocated
+  (void) allocator;
 
-  // ***************************
-  // register all primary states
-  // ***************************
-  ret = _register_primary_states(&state_machine->transition_map, allocator);
-  if (ret != RCL_RET_OK) {
-    goto fail;
+  if (rcl_lifecycle_transition_map_is_initialized(&state_machine->transition_map) == RCL_RET_OK) {
+    RCL_SET_ERROR_MSG("transition map is already initialized");
+    return RCL_RET_ERROR;
   }
 
-  // ******************************
-  // register all transition states
-  // ******************************
-  ret = _register_transition_states(&state_machine->transition_map, allocator);
-  if (ret != RCL_RET_OK) {
-    goto fail;
-  }
-
-  // ************************
-  // register all transitions
-  // ************************
-  ret = _register_transitions(&state_machine->transition_map, allocator);
-  if (ret != RCL_RET_OK) {
-    goto fail;
-  }
+  // *********************************************
+  // reference the shared states and transitions
+  // *********************************************
+  state_machine->transition_map.states = _default_states;
+  state_machine->transition_map.states_size =
+    sizeof(_default_states) / sizeof(_default_states[0]);
+  state_machine->transition_map.transitions = _default_transitions;
+  state_machine->transition_map.transitions_size =
+    sizeof(_default_transitions) / sizeof(_default_transitions[0]);
+  state_machine->transition_map.is_static = true;
 
   // *************************************
   // set the initial state to unconfigured
   // *************************************
-  state_machine->current_state = rcl_lifecycle_get_state(
-    &state_machine->transition_map, lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED);
-
-  return ret;
+  state_machine->current_state = &_default_states[_STATE_INDEX_UNCONFIGURED];
 
-fail:
-  if (rcl_lifecycle_transition_map_fini(&state_machine->transition_map, allocator) != RCL_RET_OK) {
-    RCL_SET_ERROR_MSG("could not free lifecycle transition map. Leaking memory!\n");
-  }
-  return RCL_RET_ERROR;
+  return RCL_RET_OK;
 }
 
 #ifdef __cplusplus
@@ -0,0 +1,331 @@
+// Copyright 2016 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl_lifecycle/introspection.h"
+
+#include <string.h>
+
+#include "lifecycle_msgs/msg/state.h"
+#include "lifecycle_msgs/msg/transition_description.h"
+
+#include "rcl/error_handling.h"
+
+#include "rosidl_generator_c/string_functions.h"
+
+#include "rcl_lifecycle/transition_map.h"
+
+// The state machine is immutable once initialized, so the introspection
+// queries always produce the same answers.  The cache holds one prebuilt
+// response message per answer; every message borrows the labels owned by
+// the state machine instead of copying them, so serving a query from the
+// cache touches no allocator.
+struct rcl_lifecycle_introspection_cache_t
+{
+  // response payload for get_available_states
+  lifecycle_msgs__srv__GetAvailableStates_Response states_response;
+  bool states_response_built;
+  // response payloads for get_available_transitions, one per registered
+  // state, indexed like transition_map.states
+  lifecycle_msgs__srv__GetAvailableTransitions_Response * transitions_responses;
+  bool * transitions_responses_built;
+  unsigned int transitions_responses_size;
+  // response payload for get_transition_graph
+  lifecycle_msgs__srv__GetAvailableTransitions_Response graph_response;
+  bool graph_response_built;
+};
+
+// Implementation only
+static void
+_borrow_label(rosidl_generator_c__String * str, const char * label)
+{
+  str->data = (char *)label;
+  str->size = strlen(label);
+  str->capacity = str->size + 1;
+}
+
+// Implementation only
+static void
+_return_label(rosidl_generator_c__String * str)
+{
+  str->data = NULL;
+  str->size = 0;
+  str->capacity = 0;
+}
+
+static rcl_ret_t
+_build_states_response(
+  lifecycle_msgs__srv__GetAvailableStates_Response * response,
+  const rcl_lifecycle_transition_map_t * map)
+{
+  if (!lifecycle_msgs__srv__GetAvailableStates_Response__init(response)) {
+    RCL_SET_ERROR_MSG("failed to initialize get_available_states response");
+    return RCL_RET_ERROR;
+  }
+  if (map->states_size > 0 &&
+    !lifecycle_msgs__msg__State__Sequence__init(&response->available_states, map->states_size))
+  {
+    lifecycle_msgs__srv__GetAvailableStates_Response__fini(response);
+    RCL_SET_ERROR_MSG("failed to initialize available states sequence");
+    return RCL_RET_ERROR;
+  }
+  for (unsigned int i = 0; i < map->states_size; ++i) {
+    lifecycle_msgs__msg__State * state_msg = &response->available_states.data[i];
+    state_msg->id = (uint8_t)map->states[i].id;
+    // the label borrows the state's storage, so release the owned storage
+    rosidl_generator_c__String__fini(&state_msg->label);
+    _borrow_label(&state_msg->label, map->states[i].label);
+  }
+  return RCL_RET_OK;
+}
+
+static rcl_ret_t
+_build_transitions_response(
+  lifecycle_msgs__srv__GetAvailableTransitions_Response * response,
+  const rcl_lifecycle_transition_t * transitions,
+  unsigned int transitions_size)
+{
+  if (!lifecycle_msgs__srv__GetAvailableTransitions_Response__init(response)) {
+    RCL_SET_ERROR_MSG("failed to initialize get_available_transitions response");
+    return RCL_RET_ERROR;
+  }
+  if (transitions_size > 0 &&
+    !lifecycle_msgs__msg__TransitionDescription__Sequence__init(
+      &response->available_transitions, transitions_size))
+  {
+    lifecycle_msgs__srv__GetAvailableTransitions_Response__fini(response);
+    RCL_SET_ERROR_MSG("failed to initialize available transitions sequence");
+    return RCL_RET_ERROR;
+  }
+  for (unsigned int i = 0; i < transitions_size; ++i) {
+    lifecycle_msgs__msg__TransitionDescription * description =
+      &response->available_transitions.data[i];
+    const rcl_lifecycle_transition_t * transition = &transitions[i];
+    description->transition.id = (uint8_t)transition->id;
+    // all label fields borrow the state machine's storage, so release the
+    // owned storage; a missing start or goal state leaves an empty label
+    rosidl_generator_c__String__fini(&description->transition.label);
+    _borrow_label(&description->transition.label, transition->label);
+    rosidl_generator_c__String__fini(&description->start_state.label);
+    if (transition->start) {
+      description->start_state.id = (uint8_t)transition->start->id;
+      _borrow_label(&description->start_state.label, transition->start->label);
+    }
+    rosidl_generator_c__String__fini(&description->goal_state.label);
+    if (transition->goal) {
+      description->goal_state.id = (uint8_t)transition->goal->id;
+      _borrow_label(&description->goal_state.label, transition->goal->label);
+    }
+  }
+  return RCL_RET_OK;
+}
+
+static void
+_destroy_states_response(lifecycle_msgs__srv__GetAvailableStates_Response * response)
+{
+  // the borrowed labels must not be freed with the message
+  for (size_t i = 0; i < response->available_states.size; ++i) {
+    _return_label(&response->available_states.data[i].label);
+  }
+  lifecycle_msgs__srv__GetAvailableStates_Response__fini(response);
+}
+
+static void
+_destroy_transitions_response(lifecycle_msgs__srv__GetAvailableTransitions_Response * response)
+{
+  // the borrowed labels must not be freed with the message
+  for (size_t i = 0; i < response->available_transitions.size; ++i) {
+    lifecycle_msgs__msg__TransitionDescription * description =
+      &response->available_transitions.data[i];
+    _return_label(&description->transition.label);
+    _return_label(&description->start_state.label);
+    _return_label(&description->goal_state.label);
+  }
+  lifecycle_msgs__srv__GetAvailableTransitions_Response__fini(response);
+}
+
+// Allocates the empty cache on first use; building the individual response
+// payloads is deferred until they are queried.
+static rcl_ret_t
+_ensure_cache(
+  rcl_lifecycle_state_machine_t * state_machine,
+  const rcl_allocator_t * allocator)
+{
+  if (state_machine->introspection_cache) {
+    return RCL_RET_OK;
+  }
+
+  rcl_lifecycle_introspection_cache_t * cache = allocator->zero_allocate(
+    1, sizeof(rcl_lifecycle_introspection_cache_t), allocator->state);
+  if (!cache) {
+    RCL_SET_ERROR_MSG("failed to allocate memory for introspection cache");
+    return RCL_RET_BAD_ALLOC;
+  }
+
+  unsigned int states_size = state_machine->transition_map.states_size;
+  if (states_size > 0) {
+    cache->transitions_responses = allocator->zero_allocate(
+      states_size, sizeof(lifecycle_msgs__srv__GetAvailableTransitions_Response),
+      allocator->state);
+    cache->transitions_responses_built = allocator->zero_allocate(
+      states_size, sizeof(bool), allocator->state);
+    if (!cache->transitions_responses || !cache->transitions_responses_built) {
+      allocator->deallocate(cache->transitions_responses, allocator->state);
+      allocator->deallocate(cache->transitions_responses_built, allocator->state);
+      allocator->deallocate(cache, allocator->state);
+      RCL_SET_ERROR_MSG("failed to allocate memory for introspection cache");
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+  cache->transitions_responses_size = states_size;
+
+  state_machine->introspection_cache = cache;
+  return RCL_RET_OK;
+}
+
+const lifecycle_msgs__srv__GetAvailableStates_Response *
+rcl_lifecycle_get_available_states_message(
+  rcl_lifecycle_state_machine_t * state_machine,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(state_machine, "state machine pointer is null", return NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(allocator, "allocator pointer is null", return NULL);
+
+  if (_ensure_cache(state_machine, allocator) != RCL_RET_OK) {
+    return NULL;
+  }
+  rcl_lifecycle_introspection_cache_t * cache = state_machine->introspection_cache;
+
+  if (!cache->states_response_built) {
+    if (_build_states_response(
+        &cache->states_response, &state_machine->transition_map) != RCL_RET_OK)
+    {
+      return NULL;
+    }
+    cache->states_response_built = true;
+  }
+  return &cache->states_response;
+}
+
+const lifecycle_msgs__srv__GetAvailableTransitions_Response *
+rcl_lifecycle_get_available_transitions_message(
+  rcl_lifecycle_state_machine_t * state_machine,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(state_machine, "state machine pointer is null", return NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(allocator, "allocator pointer is null", return NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    state_machine->current_state, "state machine has no current state", return NULL);
+
+  if (_ensure_cache(state_machine, allocator) != RCL_RET_OK) {
+    return NULL;
+  }
+  rcl_lifecycle_introspection_cache_t * cache = state_machine->introspection_cache;
+
+  // the current state may be a transition-owned copy; resolve the registered
+  // state so its valid transitions and its index into the map are available
+  const rcl_lifecycle_state_t * state = rcl_lifecycle_get_state(
+    &state_machine->transition_map, state_machine->current_state->id);
+  RCL_CHECK_FOR_NULL_WITH_MSG(state, "current state is not registered", return NULL);
+  size_t index = (size_t)(state - state_machine->transition_map.states);
+  if (index >= cache->transitions_responses_size) {
+    RCL_SET_ERROR_MSG("current state is not covered by the introspection cache");
+    return NULL;
+  }
+
+  if (!cache->transitions_responses_built[index]) {
+    if (_build_transitions_response(
+        &cache->transitions_responses[index],
+        state->valid_transitions, state->valid_transition_size) != RCL_RET_OK)
+    {
+      return NULL;
+    }
+    cache->transitions_responses_built[index] = true;
+  }
+  return &cache->transitions_responses[index];
+}
+
+const lifecycle_msgs__srv__GetAvailableTransitions_Response *
+rcl_lifecycle_get_transition_graph_message(
+  rcl_lifecycle_state_machine_t * state_machine,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(state_machine, "state machine pointer is null", return NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(allocator, "allocator pointer is null", return NULL);
+
+  if (_ensure_cache(state_machine, allocator) != RCL_RET_OK) {
+    return NULL;
+  }
+  rcl_lifecycle_introspection_cache_t * cache = state_machine->introspection_cache;
+
+  if (!cache->graph_response_built) {
+    if (_build_transitions_response(
+        &cache->graph_response,
+        state_machine->transition_map.transitions,
+        state_machine->transition_map.transitions_size) != RCL_RET_OK)
+    {
+      return NULL;
+    }
+    cache->graph_response_built = true;
+  }
+  return &cache->graph_response;
+}
+
+rcl_ret_t
+rcl_lifecycle_introspection_cache_fini(
+  rcl_lifecycle_state_machine_t * state_machine,
+  const rcl_allocator_t * allocator)
+{
+  if (!allocator) {
+    RCL_SET_ERROR_MSG("can't free introspection cache, no allocator given\n");
+    return RCL_RET_ERROR;
+  }
+  if (!state_machine) {
+    RCL_SET_ERROR_MSG("state machine pointer is null\n");
+    return RCL_RET_ERROR;
+  }
+
+  rcl_lifecycle_introspection_cache_t * cache = state_machine->introspection_cache;
+  // nothing was ever queried
+  if (!cache) {
+    return RCL_RET_OK;
+  }
+
+  if (cache->states_response_built) {
+    _destroy_states_response(&cache->states_response);
+  }
+  for (unsigned int i = 0; i < cache->transitions_responses_size; ++i) {
+    if (cache->transitions_responses_built[i]) {
+      _destroy_transitions_response(&cache->transitions_responses[i]);
+    }
+  }
+  if (cache->graph_response_built) {
+    _destroy_transitions_response(&cache->graph_response);
+  }
+
+  allocator->deallocate(cache->transitions_responses, allocator->state);
+  allocator->deallocate(cache->transitions_responses_built, allocator->state);
+  allocator->deallocate(cache, allocator->state);
+  state_machine->introspection_cache = NULL;
+
+  return RCL_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
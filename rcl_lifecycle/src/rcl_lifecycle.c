@@ -19,6 +19,7 @@ extern "C"
 
 #include "rcl_lifecycle/rcl_lifecycle.h"
 
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -27,9 +28,12 @@ extern "C"
 #include "rcl/error_handling.h"
 
 #include "rcutils/logging_macros.h"
+#include "rcutils/stdatomic_helper.h"
 #include "rcutils/strdup.h"
+#include "rcutils/time.h"
 
 #include "rcl_lifecycle/default_state_machine.h"
+#include "rcl_lifecycle/introspection.h"
 #include "rcl_lifecycle/transition_map.h"
 
 #include "./com_interface.h"
@@ -176,11 +180,83 @@ rcl_lifecycle_get_zero_initialized_state_machine()
   state_machine.current_state = NULL;
   state_machine.transition_map = rcl_lifecycle_get_zero_initialized_transition_map();
   state_machine.com_interface = rcl_lifecycle_get_zero_initialized_com_interface();
+  state_machine.introspection_cache = NULL;
+  memset(&state_machine.transition_history, 0, sizeof(state_machine.transition_history));
   return state_machine;
 }
 
+// ensure assumption about the plain integer storage of the ring's write count
+static_assert(
+  sizeof(atomic_uint_least64_t) <= sizeof(uint64_t),
+  "expected the transition history write count storage to be >= size of atomic_uint_least64_t");
+
+/// Append one record to the state machine's transition history ring.
+/**
+ * The machines are driven from one thread, so the ring has a single writer;
+ * the record slot and the count are two plain atomic stores, making the
+ * recording cheap enough for high-frequency activate/deactivate cycling and
+ * letting concurrent snapshot readers see a consistent count.
+ */
+static void
+_record_transition(
+  rcl_lifecycle_state_machine_t * state_machine,
+  unsigned int transition_id,
+  rcl_ret_t result)
+{
+  rcl_lifecycle_transition_history_t * history = &state_machine->transition_history;
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_system_time_now(&now)) {
+    now = 0;  // the timestamp is best effort, the record still lands
+    rcutils_reset_error();
+  }
+  atomic_uint_least64_t * write_count =
+    (atomic_uint_least64_t *)(&history->write_count_storage);
+  uint64_t written = rcutils_atomic_load_uint64_t(write_count);
+  rcl_lifecycle_transition_record_t * record =
+    &history->records[written % RCL_LIFECYCLE_TRANSITION_HISTORY_DEPTH];
+  record->transition_id = transition_id;
+  record->timestamp = now;
+  record->result = result;
+  rcutils_atomic_store(write_count, written + 1);
+}
+
 rcl_ret_t
-rcl_lifecycle_state_machine_init(
+rcl_lifecycle_get_transition_history(
+  const rcl_lifecycle_state_machine_t * state_machine,
+  rcl_lifecycle_transition_record_t * records,
+  size_t records_capacity,
+  size_t * num_records)
+{
+  if (!state_machine) {
+    RCL_SET_ERROR_MSG("state machine pointer is null\n");
+    return RCL_RET_ERROR;
+  }
+  if (!records || !num_records) {
+    RCL_SET_ERROR_MSG("records output pointer is null\n");
+    return RCL_RET_ERROR;
+  }
+  const rcl_lifecycle_transition_history_t * history = &state_machine->transition_history;
+  uint64_t written = rcutils_atomic_load_uint64_t(
+    (atomic_uint_least64_t *)(&history->write_count_storage));
+  uint64_t available = written;
+  if (available > RCL_LIFECYCLE_TRANSITION_HISTORY_DEPTH) {
+    available = RCL_LIFECYCLE_TRANSITION_HISTORY_DEPTH;
+  }
+  if (available > records_capacity) {
+    available = records_capacity;
+  }
+  // copy the most recent records, oldest first
+  for (uint64_t i = 0; i < available; ++i) {
+    records[i] =
+      history->records[(written - available + i) % RCL_LIFECYCLE_TRANSITION_HISTORY_DEPTH];
+  }
+  *num_records = (size_t)available;
+  return RCL_RET_OK;
+}
+
+// Implementation only
+static rcl_ret_t
+_state_machine_init(
   rcl_lifecycle_state_machine_t * state_machine,
   rcl_node_t * node_handle,
   const rosidl_message_type_support_t * ts_pub_notify,
@@ -190,6 +266,7 @@ rcl_lifecycle_state_machine_init(
   const rosidl_service_type_support_t * ts_srv_get_available_transitions,
   const rosidl_service_type_support_t * ts_srv_get_transition_graph,
   bool default_states,
+  bool defer_introspection_services,
   const rcl_allocator_t * allocator)
 {
   if (!allocator) {
@@ -201,7 +278,8 @@ rcl_lifecycle_state_machine_init(
     &state_machine->com_interface, node_handle,
     ts_pub_notify,
     ts_srv_change_state, ts_srv_get_state,
-    ts_srv_get_available_states, ts_srv_get_available_transitions, ts_srv_get_transition_graph);
+    ts_srv_get_available_states, ts_srv_get_available_transitions, ts_srv_get_transition_graph,
+    defer_introspection_services);
   if (ret != RCL_RET_OK) {
     return RCL_RET_ERROR;
   }
@@ -222,6 +300,61 @@ rcl_lifecycle_state_machine_init(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_lifecycle_state_machine_init(
+  rcl_lifecycle_state_machine_t * state_machine,
+  rcl_node_t * node_handle,
+  const rosidl_message_type_support_t * ts_pub_notify,
+  const rosidl_service_type_support_t * ts_srv_change_state,
+  const rosidl_service_type_support_t * ts_srv_get_state,
+  const rosidl_service_type_support_t * ts_srv_get_available_states,
+  const rosidl_service_type_support_t * ts_srv_get_available_transitions,
+  const rosidl_service_type_support_t * ts_srv_get_transition_graph,
+  bool default_states,
+  const rcl_allocator_t * allocator)
+{
+  return _state_machine_init(
+    state_machine, node_handle,
+    ts_pub_notify,
+    ts_srv_change_state, ts_srv_get_state,
+    ts_srv_get_available_states, ts_srv_get_available_transitions, ts_srv_get_transition_graph,
+    default_states, false, allocator);
+}
+
+rcl_ret_t
+rcl_lifecycle_state_machine_init_with_deferred_services(
+  rcl_lifecycle_state_machine_t * state_machine,
+  rcl_node_t * node_handle,
+  const rosidl_message_type_support_t * ts_pub_notify,
+  const rosidl_service_type_support_t * ts_srv_change_state,
+  const rosidl_service_type_support_t * ts_srv_get_state,
+  const rosidl_service_type_support_t * ts_srv_get_available_states,
+  const rosidl_service_type_support_t * ts_srv_get_available_transitions,
+  const rosidl_service_type_support_t * ts_srv_get_transition_graph,
+  bool default_states,
+  const rcl_allocator_t * allocator)
+{
+  return _state_machine_init(
+    state_machine, node_handle,
+    ts_pub_notify,
+    ts_srv_change_state, ts_srv_get_state,
+    ts_srv_get_available_states, ts_srv_get_available_transitions, ts_srv_get_transition_graph,
+    default_states, true, allocator);
+}
+
+rcl_ret_t
+rcl_lifecycle_state_machine_create_introspection_services(
+  rcl_lifecycle_state_machine_t * state_machine)
+{
+  if (!state_machine) {
+    RCL_SET_ERROR_MSG("state machine pointer is null\n");
+    return RCL_RET_ERROR;
+  }
+
+  return rcl_lifecycle_com_interface_create_introspection_services(
+    &state_machine->com_interface);
+}
+
 rcl_ret_t
 rcl_lifecycle_state_machine_fini(
   rcl_lifecycle_state_machine_t * state_machine,
@@ -235,6 +368,12 @@ rcl_lifecycle_state_machine_fini(
 
   rcl_ret_t fcn_ret = RCL_RET_OK;
 
+  // free the cached introspection responses before the labels they borrow
+  if (rcl_lifecycle_introspection_cache_fini(state_machine, allocator) != RCL_RET_OK) {
+    RCL_SET_ERROR_MSG("could not free lifecycle introspection cache. Leaking memory!\n");
+    fcn_ret = RCL_RET_ERROR;
+  }
+
   if (rcl_lifecycle_com_interface_fini(&state_machine->com_interface, node_handle) != RCL_RET_OK) {
     RCL_SET_ERROR_MSG("could not free lifecycle com interface. Leaking memory!\n");
     fcn_ret = RCL_RET_ERROR;
@@ -329,16 +468,18 @@ _trigger_transition(
   }
   state_machine->current_state = transition->goal;
 
+  rcl_ret_t fcn_ret = RCL_RET_OK;
   if (publish_notification) {
     rcl_ret_t ret = rcl_lifecycle_com_interface_publish_notification(
       &state_machine->com_interface, transition->start, state_machine->current_state);
     if (ret != RCL_RET_OK) {
       RCL_SET_ERROR_MSG("Could not publish transition");
-      return RCL_RET_ERROR;
+      fcn_ret = RCL_RET_ERROR;
     }
   }
+  _record_transition(state_machine, transition->id, fcn_ret);
 
-  return RCL_RET_OK;
+  return fcn_ret;
 }
 
 rcl_ret_t
@@ -375,6 +516,77 @@ rcl_lifecycle_trigger_transition_by_label(
   return _trigger_transition(state_machine, transition, publish_notification);
 }
 
+rcl_ret_t
+rcl_lifecycle_trigger_transitions_by_id(
+  rcl_lifecycle_state_machine_t ** state_machines,
+  size_t state_machines_size,
+  uint8_t id,
+  bool publish_notification,
+  const rcl_allocator_t * allocator)
+{
+  if (!state_machines) {
+    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "state machines pointer is null");
+    return RCL_RET_ERROR;
+  }
+  if (!allocator) {
+    RCL_SET_ERROR_MSG("can't trigger transitions, no allocator given\n");
+    return RCL_RET_ERROR;
+  }
+  if (0 == state_machines_size) {
+    return RCL_RET_OK;
+  }
+
+  const rcl_lifecycle_transition_t ** transitions = allocator->allocate(
+    state_machines_size * sizeof(const rcl_lifecycle_transition_t *), allocator->state);
+  if (!transitions) {
+    RCL_SET_ERROR_MSG("failed to allocate memory for batched transitions");
+    return RCL_RET_BAD_ALLOC;
+  }
+
+  // resolve the transition for every machine before executing any of them,
+  // so an invalid request leaves the whole batch untouched
+  for (size_t i = 0; i < state_machines_size; ++i) {
+    if (!state_machines[i]) {
+      RCL_SET_ERROR_MSG("state machine pointer is null");
+      allocator->deallocate(transitions, allocator->state);
+      return RCL_RET_ERROR;
+    }
+    transitions[i] = rcl_lifecycle_get_transition_by_id(state_machines[i]->current_state, id);
+    if (!transitions[i] || !transitions[i]->goal) {
+      RCL_SET_ERROR_MSG("Transition is not registered.");
+      allocator->deallocate(transitions, allocator->state);
+      return RCL_RET_ERROR;
+    }
+  }
+
+  // execute all transitions
+  for (size_t i = 0; i < state_machines_size; ++i) {
+    state_machines[i]->current_state = transitions[i]->goal;
+    if (!publish_notification) {
+      _record_transition(state_machines[i], transitions[i]->id, RCL_RET_OK);
+    }
+  }
+
+  // publish the notifications as a batch after all machines have moved
+  rcl_ret_t fcn_ret = RCL_RET_OK;
+  if (publish_notification) {
+    for (size_t i = 0; i < state_machines_size; ++i) {
+      rcl_ret_t ret = rcl_lifecycle_com_interface_publish_notification(
+        &state_machines[i]->com_interface,
+        transitions[i]->start, state_machines[i]->current_state);
+      if (ret != RCL_RET_OK) {
+        RCL_SET_ERROR_MSG("Could not publish transition");
+        fcn_ret = RCL_RET_ERROR;
+      }
+      _record_transition(
+        state_machines[i], transitions[i]->id, ret == RCL_RET_OK ? RCL_RET_OK : RCL_RET_ERROR);
+    }
+  }
+
+  allocator->deallocate(transitions, allocator->state);
+  return fcn_ret;
+}
+
 void
 rcl_print_state_machine(const rcl_lifecycle_state_machine_t * state_machine)
 {
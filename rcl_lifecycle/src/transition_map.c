@@ -24,6 +24,7 @@ extern "C"
 #include "rcl/error_handling.h"
 #include "rcutils/format_string.h"
 
+#include "rcl_lifecycle/default_state_machine.h"
 #include "rcl_lifecycle/transition_map.h"
 
 rcl_lifecycle_transition_map_t
@@ -34,6 +35,7 @@ rcl_lifecycle_get_zero_initialized_transition_map()
   transition_map.states_size = 0;
   transition_map.transitions = NULL;
   transition_map.transitions_size = 0;
+  transition_map.is_static = false;
 
   return transition_map;
 }
@@ -55,6 +57,16 @@ rcl_lifecycle_transition_map_fini(
 {
   rcl_ret_t fcn_ret = RCL_RET_OK;
 
+  // a static map points into shared storage which is owned by no map instance
+  if (transition_map->is_static) {
+    transition_map->states = NULL;
+    transition_map->states_size = 0;
+    transition_map->transitions = NULL;
+    transition_map->transitions_size = 0;
+    transition_map->is_static = false;
+    return fcn_ret;
+  }
+
   // free the primary states
   allocator->deallocate(transition_map->states, allocator->state);
   transition_map->states = NULL;
@@ -71,6 +83,11 @@ rcl_lifecycle_register_state(
   rcl_lifecycle_state_t state,
   const rcutils_allocator_t * allocator)
 {
+  if (transition_map->is_static) {
+    RCL_SET_ERROR_MSG("cannot register a state in a statically initialized transition map");
+    return RCL_RET_ERROR;
+  }
+
   if (rcl_lifecycle_get_state(transition_map, state.id) != NULL) {
     RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("state %u is already registered\n", state.id);
     return RCL_RET_ERROR;
@@ -104,6 +121,11 @@ rcl_lifecycle_register_transition(
   RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
     allocator, "invalid allocator", return RCL_RET_ERROR)
 
+  if (transition_map->is_static) {
+    RCL_SET_ERROR_MSG("cannot register a transition in a statically initialized transition map");
+    return RCL_RET_ERROR;
+  }
+
   rcl_lifecycle_state_t * state = rcl_lifecycle_get_state(transition_map, transition.start->id);
   if (!state) {
     RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("state %u is not registered\n", transition.start->id);
@@ -148,6 +170,11 @@ rcl_lifecycle_get_state(
   rcl_lifecycle_transition_map_t * transition_map,
   unsigned int state_id)
 {
+  // the shared default machine has id-indexed lookup tables
+  if (transition_map->is_static) {
+    return rcl_lifecycle_default_state_by_id(state_id);
+  }
+
   for (unsigned int i = 0; i < transition_map->states_size; ++i) {
     if (transition_map->states[i].id == state_id) {
       return &transition_map->states[i];
@@ -161,6 +188,11 @@ rcl_lifecycle_get_transitions(
   rcl_lifecycle_transition_map_t * transition_map,
   unsigned int transition_id)
 {
+  // the shared default machine has id-indexed lookup tables
+  if (transition_map->is_static) {
+    return rcl_lifecycle_default_transition_by_id(transition_id);
+  }
+
   for (unsigned int i = 0; i < transition_map->transitions_size; ++i) {
     if (transition_map->transitions[i].id == transition_id) {
       return &transition_map->transitions[i];
@@ -0,0 +1,348 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Lifecycle transition latency harness: reports what rcl_lifecycle itself
+// contributes to bringing nodes up and down, as latency distributions
+// (p50, p99, max) on the steady clock.  Covered:
+//
+//  * default state machine init and fini (map only, and the full init with
+//    the com interface publisher and services),
+//  * trigger_transition_by_id and _by_label on one machine, with the
+//    transition event publish on and off, driven around the default
+//    configure/activate/deactivate/cleanup cycle,
+//  * fleet activation across N machines (one node each), comparing a
+//    per-machine trigger loop against the batch
+//    trigger_transitions_by_id call.
+//
+// The publish-on cases include whatever the middleware charges for a
+// fire-and-forget publish with no subscribers; run against the production
+// rmw to get a number comparable to deployment.
+//
+// Not registered with ctest; run the executable manually, ideally on an
+// otherwise idle machine.
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "lifecycle_msgs/msg/transition.h"
+#include "lifecycle_msgs/msg/transition_event.h"
+#include "lifecycle_msgs/srv/change_state.h"
+#include "lifecycle_msgs/srv/get_available_states.h"
+#include "lifecycle_msgs/srv/get_available_transitions.h"
+#include "lifecycle_msgs/srv/get_state.h"
+
+#include "rcl/error_handling.h"
+#include "rcl/rcl.h"
+
+#include "rcl_lifecycle/default_state_machine.h"
+#include "rcl_lifecycle/rcl_lifecycle.h"
+
+#include "rcutils/time.h"
+
+namespace
+{
+
+constexpr size_t kInitSamples = 200;
+constexpr size_t kTransitionCycles = 250;
+
+// The default machine's unconfigured -> active -> unconfigured round trip;
+// every sample set below is collected while cycling through these so the
+// lookup exercises both primary and transition states.
+constexpr uint8_t kCycleIds[] = {
+  lifecycle_msgs__msg__Transition__TRANSITION_CONFIGURE,
+  lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_SUCCESS,
+  lifecycle_msgs__msg__Transition__TRANSITION_ACTIVATE,
+  lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_SUCCESS,
+  lifecycle_msgs__msg__Transition__TRANSITION_DEACTIVATE,
+  lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_SUCCESS,
+  lifecycle_msgs__msg__Transition__TRANSITION_CLEANUP,
+  lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_SUCCESS,
+};
+const char * const kCycleLabels[] = {
+  "configure", "transition_success",
+  "activate", "transition_success",
+  "deactivate", "transition_success",
+  "cleanup", "transition_success",
+};
+constexpr size_t kCycleLength = sizeof(kCycleIds) / sizeof(kCycleIds[0]);
+
+void report(const std::string & name, std::vector<int64_t> * latency_ns)
+{
+  if (latency_ns->empty()) {
+    return;
+  }
+  std::sort(latency_ns->begin(), latency_ns->end());
+  const size_t n = latency_ns->size();
+  printf(
+    "%-44s %8zu calls  p50 %8" PRId64 " ns  p99 %8" PRId64 " ns  max %10" PRId64 " ns\n",
+    name.c_str(), n,
+    (*latency_ns)[n / 2],
+    (*latency_ns)[n - 1 - n / 100],
+    (*latency_ns)[n - 1]);
+}
+
+bool now_ns(int64_t * out)
+{
+  rcutils_time_point_value_t now;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    return false;
+  }
+  *out = now;
+  return true;
+}
+
+// A fleet is N state machines on N nodes, each with the full com interface,
+// which is what a deployment of N lifecycle nodes in one process looks like
+// to rcl_lifecycle.  `init_ns` collects the per-machine full init cost.
+struct Fleet
+{
+  std::vector<rcl_node_t> nodes;
+  std::vector<rcl_lifecycle_state_machine_t> machines;
+  size_t nodes_initialized = 0;
+  size_t machines_initialized = 0;
+};
+
+bool fleet_init(
+  Fleet * fleet, rcl_context_t * context, size_t machine_count,
+  std::vector<int64_t> * init_ns)
+{
+  fleet->nodes.resize(machine_count, rcl_get_zero_initialized_node());
+  fleet->machines.resize(machine_count, rcl_lifecycle_get_zero_initialized_state_machine());
+  rcl_node_options_t node_options = rcl_node_get_default_options();
+  for (; fleet->nodes_initialized < machine_count; ++fleet->nodes_initialized) {
+    const std::string name = "bench_lifecycle_" + std::to_string(fleet->nodes_initialized);
+    if (RCL_RET_OK != rcl_node_init(
+        &fleet->nodes[fleet->nodes_initialized], name.c_str(), "", context, &node_options))
+    {
+      return false;
+    }
+  }
+  for (; fleet->machines_initialized < machine_count; ++fleet->machines_initialized) {
+    const size_t i = fleet->machines_initialized;
+    const rcl_node_options_t * node_ops = rcl_node_get_options(&fleet->nodes[i]);
+    int64_t start, end;
+    if (!now_ns(&start)) {
+      return false;
+    }
+    rcl_ret_t ret = rcl_lifecycle_state_machine_init(
+      &fleet->machines[i], &fleet->nodes[i],
+      ROSIDL_GET_MSG_TYPE_SUPPORT(lifecycle_msgs, msg, TransitionEvent),
+      ROSIDL_GET_SRV_TYPE_SUPPORT(lifecycle_msgs, srv, ChangeState),
+      ROSIDL_GET_SRV_TYPE_SUPPORT(lifecycle_msgs, srv, GetState),
+      ROSIDL_GET_SRV_TYPE_SUPPORT(lifecycle_msgs, srv, GetAvailableStates),
+      ROSIDL_GET_SRV_TYPE_SUPPORT(lifecycle_msgs, srv, GetAvailableTransitions),
+      // the transition graph service reuses the GetAvailableTransitions type
+      ROSIDL_GET_SRV_TYPE_SUPPORT(lifecycle_msgs, srv, GetAvailableTransitions),
+      true, &node_ops->allocator);
+    if (RCL_RET_OK != ret || !now_ns(&end)) {
+      return false;
+    }
+    if (nullptr != init_ns) {
+      init_ns->push_back(end - start);
+    }
+  }
+  return true;
+}
+
+bool fleet_fini(Fleet * fleet)
+{
+  bool ok = true;
+  for (size_t i = 0; i < fleet->machines_initialized; ++i) {
+    const rcl_node_options_t * node_ops = rcl_node_get_options(&fleet->nodes[i]);
+    ok = (RCL_RET_OK == rcl_lifecycle_state_machine_fini(
+        &fleet->machines[i], &fleet->nodes[i], &node_ops->allocator)) && ok;
+  }
+  for (size_t i = 0; i < fleet->nodes_initialized; ++i) {
+    ok = (RCL_RET_OK == rcl_node_fini(&fleet->nodes[i])) && ok;
+  }
+  return ok;
+}
+
+// Bare map init/fini, no com interface: the part every lifecycle node pays
+// even when the transition map is the shared static default.  A node is
+// still needed because state_machine_fini insists on one.
+bool run_map_init_case(rcl_context_t * context)
+{
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rcl_node_options_t node_options = rcl_node_get_default_options();
+  if (RCL_RET_OK != rcl_node_init(&node, "bench_lifecycle_map", "", context, &node_options)) {
+    return false;
+  }
+  bool ok = true;
+  std::vector<int64_t> latency_ns;
+  latency_ns.reserve(kInitSamples);
+  for (size_t i = 0; ok && i < kInitSamples; ++i) {
+    rcl_lifecycle_state_machine_t machine = rcl_lifecycle_get_zero_initialized_state_machine();
+    int64_t start, end;
+    ok = now_ns(&start) &&
+      RCL_RET_OK == rcl_lifecycle_init_default_state_machine(&machine, &allocator) &&
+      now_ns(&end) &&
+      RCL_RET_OK == rcl_lifecycle_state_machine_fini(&machine, &node, &allocator);
+    if (ok) {
+      latency_ns.push_back(end - start);
+    }
+  }
+  if (ok) {
+    report("init/default_map_only", &latency_ns);
+  } else {
+    fprintf(stderr, "%-44s failed: %s\n", "init/default_map_only", rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+  return (RCL_RET_OK == rcl_node_fini(&node)) && ok;
+}
+
+// One machine, one transition per sample, by id or by label, with the
+// transition event publish on or off.
+bool run_single_machine_case(
+  rcl_context_t * context, bool by_label, bool publish_notification, const std::string & name)
+{
+  Fleet fleet;
+  std::vector<int64_t> latency_ns;
+  latency_ns.reserve(kTransitionCycles * kCycleLength);
+  bool ok = fleet_init(&fleet, context, 1, nullptr);
+  for (size_t cycle = 0; ok && cycle < kTransitionCycles; ++cycle) {
+    for (size_t step = 0; ok && step < kCycleLength; ++step) {
+      int64_t start, end;
+      ok = now_ns(&start);
+      if (ok) {
+        rcl_ret_t ret = by_label ?
+          rcl_lifecycle_trigger_transition_by_label(
+          &fleet.machines[0], kCycleLabels[step], publish_notification) :
+          rcl_lifecycle_trigger_transition_by_id(
+          &fleet.machines[0], kCycleIds[step], publish_notification);
+        ok = RCL_RET_OK == ret;
+      }
+      ok = ok && now_ns(&end);
+      if (ok) {
+        latency_ns.push_back(end - start);
+      }
+    }
+  }
+  if (ok) {
+    report(name, &latency_ns);
+  } else {
+    fprintf(stderr, "%-44s failed: %s\n", name.c_str(), rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+  return fleet_fini(&fleet) && ok;
+}
+
+// N machines walked through the cycle together; each sample is the time to
+// move the whole fleet one step, either with a per-machine trigger loop or
+// with one batch call.  This is the fleet-wide failover activation number.
+bool run_fleet_case(
+  rcl_context_t * context, size_t machine_count, bool use_batch, const std::string & name)
+{
+  Fleet fleet;
+  std::vector<int64_t> init_ns;
+  init_ns.reserve(machine_count);
+  std::vector<int64_t> latency_ns;
+  latency_ns.reserve(kTransitionCycles * kCycleLength);
+  bool ok = fleet_init(&fleet, context, machine_count, &init_ns);
+  std::vector<rcl_lifecycle_state_machine_t *> machine_ptrs;
+  for (auto & machine : fleet.machines) {
+    machine_ptrs.push_back(&machine);
+  }
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  for (size_t cycle = 0; ok && cycle < kTransitionCycles; ++cycle) {
+    for (size_t step = 0; ok && step < kCycleLength; ++step) {
+      int64_t start, end;
+      ok = now_ns(&start);
+      if (ok && use_batch) {
+        ok = RCL_RET_OK == rcl_lifecycle_trigger_transitions_by_id(
+          machine_ptrs.data(), machine_ptrs.size(), kCycleIds[step], true, &allocator);
+      } else if (ok) {
+        for (size_t i = 0; ok && i < machine_count; ++i) {
+          ok = RCL_RET_OK == rcl_lifecycle_trigger_transition_by_id(
+            &fleet.machines[i], kCycleIds[step], true);
+        }
+      }
+      ok = ok && now_ns(&end);
+      if (ok) {
+        latency_ns.push_back(end - start);
+      }
+    }
+  }
+  if (ok) {
+    report("init/full_with_com/" + name, &init_ns);
+    report(name, &latency_ns);
+  } else {
+    fprintf(stderr, "%-44s failed: %s\n", name.c_str(), rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+  return fleet_fini(&fleet) && ok;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  rcl_ret_t ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  if (RCL_RET_OK != ret) {
+    fprintf(stderr, "failed to init options: %s\n", rcl_get_error_string().str);
+    return 1;
+  }
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  ret = rcl_init(argc, argv, &init_options, &context);
+  if (RCL_RET_OK != ret) {
+    fprintf(stderr, "failed to init rcl: %s\n", rcl_get_error_string().str);
+    return 1;
+  }
+
+  int result = 0;
+  if (!run_map_init_case(&context)) {
+    result = 1;
+  }
+  struct
+  {
+    bool by_label;
+    bool publish;
+    const char * name;
+  } single_cases[] = {
+    {false, false, "trigger/by_id/publish:off"},
+    {false, true, "trigger/by_id/publish:on"},
+    {true, false, "trigger/by_label/publish:off"},
+    {true, true, "trigger/by_label/publish:on"},
+  };
+  for (const auto & c : single_cases) {
+    if (!run_single_machine_case(&context, c.by_label, c.publish, c.name)) {
+      result = 1;
+    }
+  }
+  for (size_t machine_count : {10u, 40u}) {
+    const std::string suffix = "machines:" + std::to_string(machine_count);
+    if (!run_fleet_case(&context, machine_count, false, "fleet/loop/" + suffix)) {
+      result = 1;
+    }
+    if (!run_fleet_case(&context, machine_count, true, "fleet/batch/" + suffix)) {
+      result = 1;
+    }
+  }
+
+  if (RCL_RET_OK != rcl_shutdown(&context)) {
+    result = 1;
+  }
+  if (RCL_RET_OK != rcl_context_fini(&context)) {
+    result = 1;
+  }
+  if (RCL_RET_OK != rcl_init_options_fini(&init_options)) {
+    result = 1;
+  }
+  return result;
+}
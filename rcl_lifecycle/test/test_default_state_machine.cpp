@@ -31,6 +31,8 @@
 
 #include "rcl_lifecycle/rcl_lifecycle.h"
 #include "rcl_lifecycle/default_state_machine.h"
+#include "rcl_lifecycle/introspection.h"
+#include "rcl_lifecycle/transition_map.h"
 
 class TestDefaultStateMachine : public ::testing::Test
 {
@@ -119,6 +121,57 @@ TEST_F(TestDefaultStateMachine, default_init) {
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
 }
 
+TEST_F(TestDefaultStateMachine, default_init_shared) {
+  rcl_lifecycle_state_machine_t first = rcl_lifecycle_get_zero_initialized_state_machine();
+  rcl_lifecycle_state_machine_t second = rcl_lifecycle_get_zero_initialized_state_machine();
+
+  auto ret = rcl_lifecycle_init_default_state_machine(&first, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_lifecycle_init_default_state_machine(&second, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // the default states and transitions are static and shared between instances
+  EXPECT_EQ(first.transition_map.states, second.transition_map.states);
+  EXPECT_EQ(first.transition_map.transitions, second.transition_map.transitions);
+  EXPECT_TRUE(first.transition_map.is_static);
+
+  // registering on top of the shared map is rejected
+  rcl_lifecycle_state_t state = {"dummy", 42u, nullptr, 0u};
+  ret = rcl_lifecycle_register_state(&first.transition_map, state, this->allocator);
+  EXPECT_EQ(RCL_RET_ERROR, ret);
+  rcl_reset_error();
+
+  ret = rcl_lifecycle_state_machine_fini(&first, this->node_ptr, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_lifecycle_state_machine_fini(&second, this->node_ptr, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
+
+TEST_F(TestDefaultStateMachine, default_id_lookup) {
+  rcl_lifecycle_state_machine_t state_machine = rcl_lifecycle_get_zero_initialized_state_machine();
+
+  auto ret = rcl_lifecycle_init_default_state_machine(&state_machine, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  auto * state = rcl_lifecycle_get_state(
+    &state_machine.transition_map, lifecycle_msgs__msg__State__PRIMARY_STATE_INACTIVE);
+  ASSERT_NE(nullptr, state);
+  EXPECT_STREQ("inactive", state->label);
+
+  auto * transition = rcl_lifecycle_get_transitions(
+    &state_machine.transition_map, lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_ERROR);
+  ASSERT_NE(nullptr, transition);
+  EXPECT_STREQ("transition_error", transition->label);
+  EXPECT_STREQ("cleaningup", transition->start->label);
+
+  // ids without a registered state or transition
+  EXPECT_EQ(nullptr, rcl_lifecycle_get_state(&state_machine.transition_map, 9u));
+  EXPECT_EQ(nullptr, rcl_lifecycle_get_transitions(&state_machine.transition_map, 1000u));
+
+  ret = rcl_lifecycle_state_machine_fini(&state_machine, this->node_ptr, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
+
 TEST_F(TestDefaultStateMachine, default_sequence) {
   rcl_ret_t ret;
 
@@ -811,3 +864,158 @@ TEST_F(TestDefaultStateMachine, default_sequence_error_unresolved) {
       rcl_lifecycle_state_machine_fini(&state_machine, this->node_ptr, this->allocator));
   }
 }
+
+TEST_F(TestDefaultStateMachine, introspection_messages) {
+  rcl_lifecycle_state_machine_t state_machine =
+    rcl_lifecycle_get_zero_initialized_state_machine();
+  rcl_ret_t ret = rcl_lifecycle_init_default_state_machine(&state_machine, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // the available states answer covers every registered state and the same
+  // cached message is returned on every call
+  const lifecycle_msgs__srv__GetAvailableStates_Response * states_msg =
+    rcl_lifecycle_get_available_states_message(&state_machine, this->allocator);
+  ASSERT_NE(nullptr, states_msg) << rcl_get_error_string().str;
+  EXPECT_EQ(state_machine.transition_map.states_size, states_msg->available_states.size);
+  for (size_t i = 0; i < states_msg->available_states.size; ++i) {
+    EXPECT_EQ(state_machine.transition_map.states[i].id, states_msg->available_states.data[i].id);
+    EXPECT_STREQ(
+      state_machine.transition_map.states[i].label,
+      states_msg->available_states.data[i].label.data);
+  }
+  EXPECT_EQ(
+    states_msg, rcl_lifecycle_get_available_states_message(&state_machine, this->allocator));
+
+  // the available transitions answer matches the current state
+  const lifecycle_msgs__srv__GetAvailableTransitions_Response * transitions_msg =
+    rcl_lifecycle_get_available_transitions_message(&state_machine, this->allocator);
+  ASSERT_NE(nullptr, transitions_msg) << rcl_get_error_string().str;
+  EXPECT_EQ(
+    state_machine.current_state->valid_transition_size,
+    transitions_msg->available_transitions.size);
+  for (size_t i = 0; i < transitions_msg->available_transitions.size; ++i) {
+    EXPECT_EQ(
+      state_machine.current_state->valid_transitions[i].id,
+      transitions_msg->available_transitions.data[i].transition.id);
+    EXPECT_STREQ(
+      state_machine.current_state->valid_transitions[i].label,
+      transitions_msg->available_transitions.data[i].transition.label.data);
+  }
+  EXPECT_EQ(
+    transitions_msg,
+    rcl_lifecycle_get_available_transitions_message(&state_machine, this->allocator));
+
+  // after a transition the answer tracks the new current state
+  test_trigger_transition(
+    &state_machine,
+    lifecycle_msgs__msg__Transition__TRANSITION_CONFIGURE,
+    lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED,
+    lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING);
+  const lifecycle_msgs__srv__GetAvailableTransitions_Response * configuring_msg =
+    rcl_lifecycle_get_available_transitions_message(&state_machine, this->allocator);
+  ASSERT_NE(nullptr, configuring_msg) << rcl_get_error_string().str;
+  EXPECT_NE(transitions_msg, configuring_msg);
+  EXPECT_EQ(
+    state_machine.current_state->valid_transition_size,
+    configuring_msg->available_transitions.size);
+
+  // the transition graph answer covers every registered transition
+  const lifecycle_msgs__srv__GetAvailableTransitions_Response * graph_msg =
+    rcl_lifecycle_get_transition_graph_message(&state_machine, this->allocator);
+  ASSERT_NE(nullptr, graph_msg) << rcl_get_error_string().str;
+  EXPECT_EQ(
+    state_machine.transition_map.transitions_size, graph_msg->available_transitions.size);
+  EXPECT_EQ(
+    graph_msg, rcl_lifecycle_get_transition_graph_message(&state_machine, this->allocator));
+
+  EXPECT_EQ(RCL_RET_OK,
+    rcl_lifecycle_state_machine_fini(&state_machine, this->node_ptr, this->allocator));
+}
+
+TEST_F(TestDefaultStateMachine, transition_history) {
+  rcl_lifecycle_state_machine_t state_machine = rcl_lifecycle_get_zero_initialized_state_machine();
+  auto ret = rcl_lifecycle_init_default_state_machine(&state_machine, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_lifecycle_transition_record_t records[RCL_LIFECYCLE_TRANSITION_HISTORY_DEPTH];
+  size_t num_records = 42;
+
+  // invalid arguments
+  ret = rcl_lifecycle_get_transition_history(nullptr, records, 1, &num_records);
+  EXPECT_EQ(RCL_RET_ERROR, ret);
+  rcl_reset_error();
+  ret = rcl_lifecycle_get_transition_history(&state_machine, nullptr, 1, &num_records);
+  EXPECT_EQ(RCL_RET_ERROR, ret);
+  rcl_reset_error();
+  ret = rcl_lifecycle_get_transition_history(&state_machine, records, 1, nullptr);
+  EXPECT_EQ(RCL_RET_ERROR, ret);
+  rcl_reset_error();
+
+  // nothing recorded yet
+  ret = rcl_lifecycle_get_transition_history(
+    &state_machine, records, RCL_LIFECYCLE_TRANSITION_HISTORY_DEPTH, &num_records);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, num_records);
+
+  test_trigger_transition(
+    &state_machine,
+    lifecycle_msgs__msg__Transition__TRANSITION_CONFIGURE,
+    lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED,
+    lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING);
+  test_trigger_transition(
+    &state_machine,
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_SUCCESS,
+    lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING,
+    lifecycle_msgs__msg__State__PRIMARY_STATE_INACTIVE);
+
+  // both transitions were recorded, oldest first
+  ret = rcl_lifecycle_get_transition_history(
+    &state_machine, records, RCL_LIFECYCLE_TRANSITION_HISTORY_DEPTH, &num_records);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(2u, num_records);
+  EXPECT_EQ(
+    static_cast<unsigned int>(lifecycle_msgs__msg__Transition__TRANSITION_CONFIGURE),
+    records[0].transition_id);
+  EXPECT_EQ(RCL_RET_OK, records[0].result);
+  EXPECT_EQ(RCL_RET_OK, records[1].result);
+  EXPECT_LE(records[0].timestamp, records[1].timestamp);
+
+  // a smaller output array receives only the most recent record
+  ret = rcl_lifecycle_get_transition_history(&state_machine, records, 1, &num_records);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(1u, num_records);
+  EXPECT_EQ(
+    static_cast<unsigned int>(lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_SUCCESS),
+    records[0].transition_id);
+
+  // cycle often enough to wrap the ring; the snapshot stays bounded
+  for (size_t i = 0; i < RCL_LIFECYCLE_TRANSITION_HISTORY_DEPTH; ++i) {
+    test_trigger_transition(
+      &state_machine,
+      lifecycle_msgs__msg__Transition__TRANSITION_ACTIVATE,
+      lifecycle_msgs__msg__State__PRIMARY_STATE_INACTIVE,
+      lifecycle_msgs__msg__State__TRANSITION_STATE_ACTIVATING);
+    test_trigger_transition(
+      &state_machine,
+      lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_SUCCESS,
+      lifecycle_msgs__msg__State__TRANSITION_STATE_ACTIVATING,
+      lifecycle_msgs__msg__State__PRIMARY_STATE_ACTIVE);
+    test_trigger_transition(
+      &state_machine,
+      lifecycle_msgs__msg__Transition__TRANSITION_DEACTIVATE,
+      lifecycle_msgs__msg__State__PRIMARY_STATE_ACTIVE,
+      lifecycle_msgs__msg__State__TRANSITION_STATE_DEACTIVATING);
+    test_trigger_transition(
+      &state_machine,
+      lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_SUCCESS,
+      lifecycle_msgs__msg__State__TRANSITION_STATE_DEACTIVATING,
+      lifecycle_msgs__msg__State__PRIMARY_STATE_INACTIVE);
+  }
+  ret = rcl_lifecycle_get_transition_history(
+    &state_machine, records, RCL_LIFECYCLE_TRANSITION_HISTORY_DEPTH, &num_records);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(size_t(RCL_LIFECYCLE_TRANSITION_HISTORY_DEPTH), num_records);
+
+  ret = rcl_lifecycle_state_machine_fini(&state_machine, this->node_ptr, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
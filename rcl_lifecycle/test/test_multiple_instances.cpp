@@ -129,3 +129,52 @@ TEST_F(TestMultipleInstances, default_sequence_error_unresolved) {
   ret = rcl_lifecycle_state_machine_fini(&state_machine3, this->node_ptr, this->allocator);
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
 }
+
+TEST_F(TestMultipleInstances, batched_trigger_transitions_by_id) {
+  rcl_ret_t ret;
+
+  rcl_lifecycle_state_machine_t state_machine1 =
+    rcl_lifecycle_get_zero_initialized_state_machine();
+  ret = rcl_lifecycle_init_default_state_machine(&state_machine1, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_lifecycle_state_machine_t state_machine2 =
+    rcl_lifecycle_get_zero_initialized_state_machine();
+  ret = rcl_lifecycle_init_default_state_machine(&state_machine2, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_lifecycle_state_machine_t * state_machines[] = {&state_machine1, &state_machine2};
+
+  // all machines move together
+  ret = rcl_lifecycle_trigger_transitions_by_id(
+    state_machines, 2u,
+    lifecycle_msgs__msg__Transition__TRANSITION_CONFIGURE, false, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(
+    lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING, state_machine1.current_state->id);
+  EXPECT_EQ(
+    lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING, state_machine2.current_state->id);
+
+  // move only the first machine to inactive, then trigger a batch with a
+  // transition which is invalid for the second machine; neither may move
+  test_trigger_transition(
+    &state_machine1,
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_SUCCESS,
+    lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING,
+    lifecycle_msgs__msg__State__PRIMARY_STATE_INACTIVE);
+
+  ret = rcl_lifecycle_trigger_transitions_by_id(
+    state_machines, 2u,
+    lifecycle_msgs__msg__Transition__TRANSITION_ACTIVATE, false, this->allocator);
+  EXPECT_EQ(RCL_RET_ERROR, ret);
+  rcl_reset_error();
+  EXPECT_EQ(
+    lifecycle_msgs__msg__State__PRIMARY_STATE_INACTIVE, state_machine1.current_state->id);
+  EXPECT_EQ(
+    lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING, state_machine2.current_state->id);
+
+  ret = rcl_lifecycle_state_machine_fini(&state_machine1, this->node_ptr, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_lifecycle_state_machine_fini(&state_machine2, this->node_ptr, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
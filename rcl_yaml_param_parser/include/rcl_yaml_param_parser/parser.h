@@ -32,6 +32,20 @@ RCL_YAML_PARAM_PARSER_PUBLIC
 rcl_params_t * rcl_yaml_node_struct_init(
   const rcutils_allocator_t allocator);
 
+/// \brief Copy param structure
+/// The payload (node tables, values) is shared with the original through a
+/// reference count instead of being deep copied; the common read-only copy
+/// is therefore a refcount bump regardless of the number of parameters.
+/// Parsing additional files into either structure detaches that structure
+/// onto its own deep copy first, so the sharing is never observable.
+/// The copy must be freed with rcl_yaml_node_struct_fini; the payload is
+/// released when the last structure sharing it is freed.
+/// \param[in] params_st points to the populated paramter struct
+/// \return a pointer to the copied param structure on success or NULL on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_params_t * rcl_yaml_node_struct_copy(
+  const rcl_params_t * params_st);
+
 /// \brief Free param structure
 /// \param[in] params_st points to the populated paramter struct
 RCL_YAML_PARAM_PARSER_PUBLIC
@@ -47,6 +61,152 @@ bool rcl_parse_yaml_file(
   const char * file_path,
   rcl_params_t * params_st);
 
+/// \brief Parse several YAML files, initialize and populate params_st
+/// The files are parsed in order into the one structure, so entries from a
+/// later file appear after, and take precedence over, entries from an
+/// earlier one for consumers that resolve repeated names last-wins.
+/// Stops at the first file that fails to parse; as with
+/// rcl_parse_yaml_file, params_st has been freed when that happens.
+/// \param[in] file_paths is the list of paths to the YAML files
+/// \param[in] num_files is the number of entries in file_paths
+/// \param[inout] params_st points to the populated paramter struct
+/// \return true on success and false on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_parse_yaml_files(
+  const char * const * file_paths,
+  const size_t num_files,
+  rcl_params_t * params_st);
+
+/// \brief Parse the YAML file and populate params_st with one node's parameters
+/// Only the sections whose accumulated node name matches node_fqn are
+/// materialized; every other node's section is skipped at the event level
+/// without building its values. The name is matched as the parser stores it,
+/// e.g. "ns/sub_ns/node_name" for a node nested under namespaces.
+/// \param[in] file_path is the path to the YAML file
+/// \param[in] node_fqn is the name of the node whose parameters are wanted
+/// \param[inout] params_st points to the populated paramter struct
+/// \return true on success and false on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_parse_yaml_file_for_node(
+  const char * file_path,
+  const char * node_fqn,
+  rcl_params_t * params_st);
+
+/// \brief Validate the YAML file without building a parameter structure
+/// The file is run through the same structural checks as
+/// rcl_parse_yaml_file (namespace nesting, value placement, type
+/// consistency of sequences) but no parameter structure, names or values
+/// are materialized, so the pass does not allocate per parameter.
+/// A file that validates will also parse; the error string reports the
+/// first violation the same way a parse would.
+/// \param[in] file_path is the path to the YAML file
+/// \return true when the file is structurally valid and false otherwise
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_validate_yaml_file(
+  const char * file_path);
+
+/// \brief Reparse the YAML file into an existing structure, replacing only
+/// the values that changed
+/// Parameters whose value is unchanged keep their current storage, so
+/// pointers into them stay valid across the update; parameters and nodes
+/// new to the file are appended. Entries no longer in the file are left
+/// in place. When changes_st is not NULL it must be an initialized
+/// structure, and every added or replaced parameter is also copied into
+/// it so callers can react to just the changed set.
+/// Unlike rcl_parse_yaml_file, params_st is not freed when the file fails
+/// to parse; it is left exactly as it was.
+/// \param[in] file_path is the path to the YAML file
+/// \param[inout] params_st points to the populated paramter struct
+/// \param[inout] changes_st receives the changed parameters, or NULL
+/// \return true on success and false on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_parse_yaml_file_update(
+  const char * file_path,
+  rcl_params_t * params_st,
+  rcl_params_t * changes_st);
+
+/// \brief Parse the YAML file through a sidecar binary cache
+/// The first successful parse writes a compact binary serialization of the
+/// result next to the YAML file (<file_path>.pcache); later calls load the
+/// cache directly as long as the YAML file's size and modification time are
+/// unchanged, skipping the YAML parse entirely. A stale, corrupt or missing
+/// cache falls back to rcl_parse_yaml_file and is rewritten.
+/// \param[in] file_path is the path to the YAML file
+/// \param[inout] params_st points to the populated paramter struct
+/// \return true on success and false on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_parse_yaml_file_cached(
+  const char * file_path,
+  rcl_params_t * params_st);
+
+/// \brief Serialize the parameter structure into a binary buffer
+/// The buffer holds a versioned, length prefixed binary form of the
+/// structure that rcl_params_deserialize turns back into an equivalent
+/// structure without going through YAML text. buffer->values is allocated
+/// with the structure's allocator and must be freed by the caller with
+/// that same allocator.
+/// \param[in] params_st points to the populated paramter struct
+/// \param[out] buffer receives the serialized bytes and their count
+/// \return true on success and false on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_params_serialize(
+  const rcl_params_t * params_st,
+  rcl_byte_array_t * buffer);
+
+/// \brief Deserialize a binary buffer into a new parameter structure
+/// The buffer must come from rcl_params_serialize; a truncated, corrupt or
+/// version mismatched buffer is rejected. The returned structure does not
+/// reference the buffer and must be freed with rcl_yaml_node_struct_fini.
+/// \param[in] buffer holds the serialized bytes and their count
+/// \param[in] allocator memory allocator to be used for the new structure
+/// \return a pointer to the new param structure on success or NULL on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_params_t * rcl_params_deserialize(
+  const rcl_byte_array_t * buffer,
+  const rcutils_allocator_t allocator);
+
+/// \typedef rcl_params_index_t
+/// \brief Hash index over the node and parameter names of a rcl_params_t
+typedef struct rcl_params_index_s rcl_params_index_t;
+
+/// \brief Build a hash index over a populated parameter structure
+/// The index makes node and parameter name lookups O(1) instead of linear
+/// scans. It borrows params_st without copying it, so it must be freed
+/// with rcl_yaml_node_struct_index_fini before the parameter structure is
+/// modified by further parsing or freed.
+/// \param[in] params_st points to the populated paramter struct
+/// \return a pointer to the index on success or NULL on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_params_index_t * rcl_yaml_node_struct_index_init(
+  const rcl_params_t * params_st);
+
+/// \brief Free a parameter structure index
+/// The indexed parameter structure itself is untouched
+/// \param[in] params_index points to the index
+RCL_YAML_PARAM_PARSER_PUBLIC
+void rcl_yaml_node_struct_index_fini(
+  rcl_params_index_t * params_index);
+
+/// \brief Look up the parameters of a node by its name
+/// \param[in] params_index points to the index
+/// \param[in] node_name is the name of the node
+/// \return a pointer to the node's parameters or NULL if there is no such node
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_node_params_t * rcl_yaml_node_struct_index_find_node(
+  const rcl_params_index_t * params_index,
+  const char * node_name);
+
+/// \brief Look up a parameter value by node name and parameter name
+/// \param[in] params_index points to the index
+/// \param[in] node_name is the name of the node
+/// \param[in] param_name is the name of the parameter
+/// \return a pointer to the value or NULL if there is no such parameter
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_variant_t * rcl_yaml_node_struct_index_find_parameter(
+  const rcl_params_index_t * params_index,
+  const char * node_name,
+  const char * param_name);
+
 /// \brief Print the parameter structure to stdout
 /// \param[in] params_st points to the populated parameter struct
 RCL_YAML_PARAM_PARSER_PUBLIC
@@ -82,6 +82,12 @@ typedef struct rcl_params_s
   rcl_node_params_t * params;  ///<  Array of parameters
   size_t num_nodes;       ///< Number of nodes
   rcl_allocator_t allocator;  ///< Allocator used
+  /// Table owning the interned copies of the structure's names and string
+  /// values; managed by the parser, do not touch
+  struct rcl_yaml_intern_table_s * intern_table;
+  /// Reference count shared between this structure and the copies made of it
+  /// with rcl_yaml_node_struct_copy; managed by the parser, do not touch
+  struct rcl_yaml_params_refcount_s * refcount;
 } rcl_params_t;
 
 #endif  // RCL_YAML_PARAM_PARSER__TYPES_H_
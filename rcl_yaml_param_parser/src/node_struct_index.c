@@ -0,0 +1,261 @@
+// Copyright 2019 Apex.AI, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rcl_yaml_param_parser/parser.h"
+#include "rcl_yaml_param_parser/types.h"
+
+#include "rcl/error_handling.h"
+#include "rcl/types.h"
+
+/// Hash index over the node names and parameter names of a populated
+/// rcl_params_t, so repeated lookups are O(1) instead of linear scans.
+/// The buckets are open addressed with linear probing and store idx + 1,
+/// with 0 marking an empty bucket. The index borrows the parameter
+/// structure and holds no copies of its strings.
+struct rcl_params_index_s
+{
+  const rcl_params_t * params_st;
+  size_t * node_buckets;
+  size_t num_node_buckets;
+  size_t ** param_buckets;
+  size_t * num_param_buckets;
+  rcl_allocator_t allocator;
+};
+
+///
+/// FNV-1a hash over a name string
+///
+static uint64_t hash_name(const char * name)
+{
+  uint64_t hash = 0xcbf29ce484222325ULL;
+
+  while ('\0' != *name) {
+    hash = ((hash ^ (uint64_t)(unsigned char)*name) * 0x100000001b3ULL);
+    name++;
+  }
+  return hash;
+}
+
+///
+/// Number of buckets for num_entries names: the next power of two at or
+/// above twice the count, keeping the load factor at half or less
+///
+static size_t num_buckets_for(const size_t num_entries)
+{
+  size_t num_buckets = 2U;
+
+  while (num_buckets < (2U * num_entries)) {
+    num_buckets *= 2U;
+  }
+  return num_buckets;
+}
+
+///
+/// Build a bucket array over names and store each index + 1 in its bucket
+///
+static size_t * build_buckets(
+  char * const * names,
+  const size_t num_names,
+  const size_t num_buckets,
+  const rcl_allocator_t allocator)
+{
+  size_t * buckets;
+  size_t name_idx;
+
+  buckets = allocator.zero_allocate(num_buckets, sizeof(size_t), allocator.state);
+  if (NULL == buckets) {
+    return NULL;
+  }
+  for (name_idx = 0U; name_idx < num_names; name_idx++) {
+    size_t bucket_idx = (size_t)(hash_name(names[name_idx]) & (num_buckets - 1U));
+    while (0U != buckets[bucket_idx]) {
+      /// A repeated name keeps the later index, so lookups see the same
+      /// last-wins entry a linear scan from the back would find
+      if (0 == strcmp(names[buckets[bucket_idx] - 1U], names[name_idx])) {
+        break;
+      }
+      bucket_idx = ((bucket_idx + 1U) & (num_buckets - 1U));
+    }
+    buckets[bucket_idx] = (name_idx + 1U);
+  }
+  return buckets;
+}
+
+///
+/// Look a name up in a bucket array, returning true and its index on a hit
+///
+static bool find_in_buckets(
+  const size_t * buckets,
+  const size_t num_buckets,
+  char * const * names,
+  const char * name,
+  size_t * name_idx)
+{
+  size_t bucket_idx;
+
+  if (NULL == buckets) {
+    return false;
+  }
+  bucket_idx = (size_t)(hash_name(name) & (num_buckets - 1U));
+  while (0U != buckets[bucket_idx]) {
+    const size_t candidate_idx = (buckets[bucket_idx] - 1U);
+    if (0 == strcmp(names[candidate_idx], name)) {
+      *name_idx = candidate_idx;
+      return true;
+    }
+    bucket_idx = ((bucket_idx + 1U) & (num_buckets - 1U));
+  }
+  return false;
+}
+
+///
+/// Build the index over a populated parameter structure
+///
+rcl_params_index_t * rcl_yaml_node_struct_index_init(
+  const rcl_params_t * params_st)
+{
+  rcl_params_index_t * params_index;
+  rcl_allocator_t allocator;
+  size_t node_idx;
+
+  if (NULL == params_st) {
+    RCL_SET_ERROR_MSG("Pass a initialized paramter structure");
+    return NULL;
+  }
+  allocator = params_st->allocator;
+
+  params_index = allocator.zero_allocate(1U, sizeof(rcl_params_index_t), allocator.state);
+  if (NULL == params_index) {
+    RCL_SET_ERROR_MSG("Error allocating mem");
+    return NULL;
+  }
+  params_index->params_st = params_st;
+  params_index->allocator = allocator;
+
+  if (params_st->num_nodes > 0U) {
+    params_index->num_node_buckets = num_buckets_for(params_st->num_nodes);
+    params_index->node_buckets = build_buckets(params_st->node_names,
+        params_st->num_nodes, params_index->num_node_buckets, allocator);
+    params_index->param_buckets = allocator.zero_allocate(params_st->num_nodes,
+        sizeof(size_t *), allocator.state);
+    params_index->num_param_buckets = allocator.zero_allocate(params_st->num_nodes,
+        sizeof(size_t), allocator.state);
+    if ((NULL == params_index->node_buckets) ||
+      (NULL == params_index->param_buckets) ||
+      (NULL == params_index->num_param_buckets))
+    {
+      RCL_SET_ERROR_MSG("Error allocating mem");
+      rcl_yaml_node_struct_index_fini(params_index);
+      return NULL;
+    }
+    for (node_idx = 0U; node_idx < params_st->num_nodes; node_idx++) {
+      const rcl_node_params_t * node_params = &(params_st->params[node_idx]);
+      if (0U == node_params->num_params) {
+        continue;
+      }
+      params_index->num_param_buckets[node_idx] = num_buckets_for(node_params->num_params);
+      params_index->param_buckets[node_idx] = build_buckets(node_params->parameter_names,
+          node_params->num_params, params_index->num_param_buckets[node_idx], allocator);
+      if (NULL == params_index->param_buckets[node_idx]) {
+        RCL_SET_ERROR_MSG("Error allocating mem");
+        rcl_yaml_node_struct_index_fini(params_index);
+        return NULL;
+      }
+    }
+  }
+  return params_index;
+}
+
+///
+/// Free the index; the indexed parameter structure is untouched
+///
+void rcl_yaml_node_struct_index_fini(
+  rcl_params_index_t * params_index)
+{
+  rcl_allocator_t allocator;
+  size_t node_idx;
+
+  if (NULL == params_index) {
+    return;
+  }
+  allocator = params_index->allocator;
+
+  if (NULL != params_index->param_buckets) {
+    for (node_idx = 0U; node_idx < params_index->params_st->num_nodes; node_idx++) {
+      if (NULL != params_index->param_buckets[node_idx]) {
+        allocator.deallocate(params_index->param_buckets[node_idx], allocator.state);
+      }
+    }
+    allocator.deallocate(params_index->param_buckets, allocator.state);
+  }
+  if (NULL != params_index->num_param_buckets) {
+    allocator.deallocate(params_index->num_param_buckets, allocator.state);
+  }
+  if (NULL != params_index->node_buckets) {
+    allocator.deallocate(params_index->node_buckets, allocator.state);
+  }
+  allocator.deallocate(params_index, allocator.state);
+}
+
+///
+/// Look up a node by name
+///
+rcl_node_params_t * rcl_yaml_node_struct_index_find_node(
+  const rcl_params_index_t * params_index,
+  const char * node_name)
+{
+  size_t node_idx;
+
+  if ((NULL == params_index) || (NULL == node_name)) {
+    return NULL;
+  }
+  if (!find_in_buckets(params_index->node_buckets, params_index->num_node_buckets,
+    params_index->params_st->node_names, node_name, &node_idx))
+  {
+    return NULL;
+  }
+  return &(params_index->params_st->params[node_idx]);
+}
+
+///
+/// Look up a parameter value by node name and parameter name
+///
+rcl_variant_t * rcl_yaml_node_struct_index_find_parameter(
+  const rcl_params_index_t * params_index,
+  const char * node_name,
+  const char * param_name)
+{
+  size_t node_idx;
+  size_t param_idx;
+
+  if ((NULL == params_index) || (NULL == node_name) || (NULL == param_name)) {
+    return NULL;
+  }
+  if (!find_in_buckets(params_index->node_buckets, params_index->num_node_buckets,
+    params_index->params_st->node_names, node_name, &node_idx))
+  {
+    return NULL;
+  }
+  if (!find_in_buckets(params_index->param_buckets[node_idx],
+    params_index->num_param_buckets[node_idx],
+    params_index->params_st->params[node_idx].parameter_names, param_name, &param_idx))
+  {
+    return NULL;
+  }
+  return &(params_index->params_st->params[node_idx].parameter_values[param_idx]);
+}
@@ -18,8 +18,15 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/stat.h>
 #include <yaml.h>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include "rcl_yaml_param_parser/parser.h"
 #include "rcl_yaml_param_parser/types.h"
 
@@ -67,8 +74,44 @@ typedef struct namespace_tracker_s
 #define NODE_NS_SEPERATOR "/"
 #define PARAMETER_NS_SEPERATOR "."
 
-#define MAX_NUM_NODE_ENTRIES 256U
-#define MAX_NUM_PARAMS_PER_NODE 512U
+#define INITIAL_ARRAY_CAPACITY 8U
+
+/// Interned copies of a parameter structure's node names, parameter names
+/// and scalar string values. Parameter files repeat key names and enum-like
+/// values many times; every occurrence shares the one copy owned by this
+/// table, and the individual fini paths leave the strings to the table.
+/// The strings are kept sorted for binary search.
+typedef struct rcl_yaml_intern_table_s
+{
+  char ** strings;
+  size_t size;
+  size_t capacity;
+} rcl_yaml_intern_table_t;
+
+/// Reference count shared between a parameter structure and the copies made
+/// of it with rcl_yaml_node_struct_copy. While the count is above one the
+/// payload (node tables, values, intern table) is shared; a parse into one of
+/// the sharing structures detaches it onto its own deep copy first.
+typedef struct rcl_yaml_params_refcount_s
+{
+  uint64_t count;
+} rcl_yaml_params_refcount_t;
+
+static rcl_ret_t params_struct_ensure_owned(
+  rcl_params_t * params_st);
+
+static char * intern_string(
+  rcl_params_t * params_st,
+  const char * str);
+
+static void intern_table_fini(
+  rcl_params_t * params_st);
+
+static rcl_ret_t ensure_array_capacity(
+  void ** array,
+  const size_t element_size,
+  const size_t new_size,
+  const rcl_allocator_t allocator);
 
 static rcl_ret_t node_params_init(
   rcl_node_params_t * node_params,
@@ -76,17 +119,17 @@ static rcl_ret_t node_params_init(
 
 static rcl_ret_t add_val_to_bool_arr(
   rcl_bool_array_t * const val_array,
-  bool * value,
+  const bool * value,
   const rcl_allocator_t allocator);
 
 static rcl_ret_t add_val_to_int_arr(
   rcl_int64_array_t * const val_array,
-  int64_t * value,
+  const int64_t * value,
   const rcl_allocator_t allocator);
 
 static rcl_ret_t add_val_to_double_arr(
   rcl_double_array_t * const val_array,
-  double * value,
+  const double * value,
   const rcl_allocator_t allocator);
 
 static rcl_ret_t add_val_to_string_arr(
@@ -120,6 +163,7 @@ static void * get_value(
   const char * const value,
   yaml_scalar_style_t style,
   data_types_t * val_type,
+  void * const scalar_storage,
   const rcl_allocator_t allocator);
 
 static rcl_ret_t parse_value(
@@ -135,8 +179,12 @@ static rcl_ret_t parse_key(
   namespace_tracker_t * ns_tracker,
   rcl_params_t * params_st);
 
+static rcl_ret_t skip_subtree(
+  yaml_parser_t * parser);
+
 static rcl_ret_t parse_events(
   yaml_parser_t * parser,
+  const char * node_fqn,
   namespace_tracker_t * ns_tracker,
   rcl_params_t * params_st);
 
@@ -328,29 +376,148 @@ static rcl_ret_t replace_ns(
   return res;
 }
 
+///
+/// Return the structure's shared copy of str, interning it on first use
+/// Returns NULL if allocating memory failed
+///
+static char * intern_string(
+  rcl_params_t * params_st,
+  const char * str)
+{
+  rcl_yaml_intern_table_t * table = params_st->intern_table;
+  rcl_allocator_t allocator = params_st->allocator;
+  size_t low = 0U;
+  size_t high;
+  char * copy;
+
+  if (NULL == table) {
+    table = allocator.zero_allocate(1U, sizeof(rcl_yaml_intern_table_t), allocator.state);
+    if (NULL == table) {
+      return NULL;
+    }
+    params_st->intern_table = table;
+  }
+  high = table->size;
+  while (low < high) {
+    const size_t mid = (low + ((high - low) / 2U));
+    if (strcmp(table->strings[mid], str) < 0) {
+      low = (mid + 1U);
+    } else {
+      high = mid;
+    }
+  }
+  if ((low < table->size) && (0 == strcmp(table->strings[low], str))) {
+    return table->strings[low];
+  }
+  if (table->size == table->capacity) {
+    const size_t new_capacity = (0U == table->capacity) ?
+      INITIAL_ARRAY_CAPACITY : (2U * table->capacity);
+    char ** new_strings = allocator.reallocate(table->strings,
+        (new_capacity * sizeof(char *)), allocator.state);
+    if (NULL == new_strings) {
+      return NULL;
+    }
+    table->strings = new_strings;
+    table->capacity = new_capacity;
+  }
+  copy = rcutils_strdup(str, allocator);
+  if (NULL == copy) {
+    return NULL;
+  }
+  memmove(&(table->strings[low + 1U]), &(table->strings[low]),
+    ((table->size - low) * sizeof(char *)));
+  table->strings[low] = copy;
+  table->size++;
+  return copy;
+}
+
+///
+/// Free the intern table and every string owned by it
+///
+static void intern_table_fini(
+  rcl_params_t * params_st)
+{
+  rcl_yaml_intern_table_t * table = params_st->intern_table;
+  rcl_allocator_t allocator = params_st->allocator;
+  size_t idx;
+
+  if (NULL == table) {
+    return;
+  }
+  for (idx = 0U; idx < table->size; idx++) {
+    allocator.deallocate(table->strings[idx], allocator.state);
+  }
+  if (NULL != table->strings) {
+    allocator.deallocate(table->strings, allocator.state);
+  }
+  allocator.deallocate(table, allocator.state);
+  params_st->intern_table = NULL;
+}
+
+///
+/// Grow an array to hold new_size elements, doubling the allocation so
+/// repeated appends stay amortized O(1). The capacity is implicit in the
+/// size (the smallest power of two at or above it, starting from
+/// INITIAL_ARRAY_CAPACITY), so the public structures need no capacity field.
+/// New elements are zero initialized.
+///
+static rcl_ret_t ensure_array_capacity(
+  void ** array,
+  const size_t element_size,
+  const size_t new_size,
+  const rcl_allocator_t allocator)
+{
+  size_t new_capacity = INITIAL_ARRAY_CAPACITY;
+  size_t old_capacity = INITIAL_ARRAY_CAPACITY;
+  void * new_array;
+
+  if ((NULL == array) || (0U == element_size) || (0U == new_size)) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  while (new_capacity < new_size) {
+    new_capacity *= 2U;
+  }
+  if (NULL == *array) {
+    *array = allocator.zero_allocate(new_capacity, element_size, allocator.state);
+    if (NULL == *array) {
+      RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+      return RCL_RET_BAD_ALLOC;
+    }
+    return RCL_RET_OK;
+  }
+  while (old_capacity < (new_size - 1U)) {
+    old_capacity *= 2U;
+  }
+  if (new_capacity == old_capacity) {
+    return RCL_RET_OK;
+  }
+  new_array = allocator.zero_allocate(new_capacity, element_size, allocator.state);
+  if (NULL == new_array) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+    return RCL_RET_BAD_ALLOC;
+  }
+  memmove(new_array, *array, ((new_size - 1U) * element_size));
+  allocator.deallocate(*array, allocator.state);
+  *array = new_array;
+  return RCL_RET_OK;
+}
+
 ///
 /// Create rcl_node_params_t structure
+/// The parameter arrays start empty and grow on demand while parsing
 ///
 static rcl_ret_t node_params_init(
   rcl_node_params_t * node_params,
   const rcl_allocator_t allocator)
 {
+  (void) allocator;
   if (NULL == node_params) {
     return RCL_RET_INVALID_ARGUMENT;
   }
 
-  node_params->parameter_names = allocator.zero_allocate(MAX_NUM_PARAMS_PER_NODE,
-      sizeof(char *), allocator.state);
-  if (NULL == node_params->parameter_names) {
-    return RCL_RET_BAD_ALLOC;
-  }
-
-  node_params->parameter_values = allocator.zero_allocate(MAX_NUM_PARAMS_PER_NODE,
-      sizeof(rcl_variant_t), allocator.state);
-  if (NULL == node_params->parameter_values) {
-    allocator.deallocate(node_params->parameter_names, allocator.state);
-    return RCL_RET_BAD_ALLOC;
-  }
+  node_params->parameter_names = NULL;
+  node_params->parameter_values = NULL;
+  node_params->num_params = 0U;
 
   return RCL_RET_OK;
 }
@@ -369,109 +536,112 @@ rcl_params_t * rcl_yaml_node_struct_init(
     return NULL;
   }
 
-  params_st->node_names = allocator.zero_allocate(MAX_NUM_NODE_ENTRIES,
-      sizeof(char *), allocator.state);
-  if (NULL == params_st->node_names) {
-    rcl_yaml_node_struct_fini(params_st);
-    RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
-    return NULL;
-  }
+  /// The node tables start empty and grow geometrically while parsing
+  params_st->node_names = NULL;
+  params_st->params = NULL;
+  params_st->num_nodes = 0U;
+  params_st->allocator = allocator;
 
-  params_st->params = allocator.zero_allocate(MAX_NUM_NODE_ENTRIES, sizeof(rcl_node_params_t),
-      allocator.state);
-  if (NULL == params_st->params) {
-    rcl_yaml_node_struct_fini(params_st);
+  params_st->refcount =
+    allocator.zero_allocate(1U, sizeof(rcl_yaml_params_refcount_t), allocator.state);
+  if (NULL == params_st->refcount) {
     RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+    allocator.deallocate(params_st, allocator.state);
     return NULL;
   }
-
-  params_st->num_nodes = 0U;
-  params_st->allocator = allocator;
+  params_st->refcount->count = 1U;
 
   return params_st;
 }
 
 ///
-/// Free param structure
-/// NOTE: If there is an error, would recommend just to safely exit the process instead
-/// of calling this free function and continuing
+/// Free the value stored in a parameter variant
 ///
-void rcl_yaml_node_struct_fini(
-  rcl_params_t * params_st)
+static void param_variant_fini(
+  rcl_variant_t * param_var,
+  const rcl_allocator_t allocator)
 {
-  uint32_t node_idx;
-  size_t parameter_idx = 0U;
-  rcl_allocator_t allocator;
-
-  if (NULL == params_st) {
+  if (NULL == param_var) {
     return;
   }
-  allocator = params_st->allocator;
+  if (NULL != param_var->bool_value) {
+    allocator.deallocate(param_var->bool_value, allocator.state);
+  } else if (NULL != param_var->integer_value) {
+    allocator.deallocate(param_var->integer_value, allocator.state);
+  } else if (NULL != param_var->double_value) {
+    allocator.deallocate(param_var->double_value, allocator.state);
+  } else if (NULL != param_var->string_value) {
+    /// Interned; the structure's intern table owns the string
+  } else if (NULL != param_var->bool_array_value) {
+    if (NULL != param_var->bool_array_value->values) {
+      allocator.deallocate(param_var->bool_array_value->values, allocator.state);
+    }
+    allocator.deallocate(param_var->bool_array_value, allocator.state);
+  } else if (NULL != param_var->integer_array_value) {
+    if (NULL != param_var->integer_array_value->values) {
+      allocator.deallocate(param_var->integer_array_value->values, allocator.state);
+    }
+    allocator.deallocate(param_var->integer_array_value, allocator.state);
+  } else if (NULL != param_var->double_array_value) {
+    if (NULL != param_var->double_array_value->values) {
+      allocator.deallocate(param_var->double_array_value->values, allocator.state);
+    }
+    allocator.deallocate(param_var->double_array_value, allocator.state);
+  } else if (NULL != param_var->string_array_value) {
+    if (RCL_RET_OK != rcutils_string_array_fini(param_var->string_array_value)) {
+      // Log and continue ...
+      RCUTILS_SAFE_FWRITE_TO_STDERR("Error deallocating string array");
+    }
+    allocator.deallocate(param_var->string_array_value, allocator.state);
+  } else {
+    /// Nothing to do to keep pclint happy
+  }
+}
 
-  for (node_idx = 0; node_idx < params_st->num_nodes; node_idx++) {
-    char * node_name = params_st->node_names[node_idx];
-    if (NULL != node_name) {
-      allocator.deallocate(node_name, allocator.state);
+///
+/// Free the parameter names and values of a single node
+///
+static void node_params_fini(
+  rcl_node_params_t * node_params,
+  const rcl_allocator_t allocator)
+{
+  size_t parameter_idx;
+
+  if (NULL == node_params) {
+    return;
+  }
+  /// The parameter names are interned; the structure's intern table owns them
+  for (parameter_idx = 0U; parameter_idx < node_params->num_params; parameter_idx++) {
+    if ((NULL != node_params->parameter_names) && (NULL != node_params->parameter_values)) {
+      param_variant_fini(&(node_params->parameter_values[parameter_idx]), allocator);
     }
+  }
+  if (NULL != node_params->parameter_values) {
+    allocator.deallocate(node_params->parameter_values, allocator.state);
+    node_params->parameter_values = NULL;
+  }
+  if (NULL != node_params->parameter_names) {
+    allocator.deallocate(node_params->parameter_names, allocator.state);
+    node_params->parameter_names = NULL;
+  }
+  node_params->num_params = 0U;
+}
 
-    if (NULL != params_st->params) {
-      char * param_name;
-      rcl_variant_t * param_var;
-      for (parameter_idx = 0; parameter_idx < params_st->params[node_idx].num_params;
-        parameter_idx++)
-      {
-        if ((NULL != params_st->params[node_idx].parameter_names) &&
-          (NULL != params_st->params[node_idx].parameter_values))
-        {
-          param_name = params_st->params[node_idx].parameter_names[parameter_idx];
-          param_var = &(params_st->params[node_idx].parameter_values[parameter_idx]);
-          if (NULL != param_name) {
-            allocator.deallocate(param_name, allocator.state);
-          }
+///
+/// Free a parameter structure's payload (node tables, values, intern table),
+/// leaving the envelope and the reference count alone
+///
+static void params_payload_fini(
+  rcl_params_t * params_st)
+{
+  uint32_t node_idx;
+  rcl_allocator_t allocator = params_st->allocator;
 
-          if (NULL != param_var) {
-            if (NULL != param_var->bool_value) {
-              allocator.deallocate(param_var->bool_value, allocator.state);
-            } else if (NULL != param_var->integer_value) {
-              allocator.deallocate(param_var->integer_value, allocator.state);
-            } else if (NULL != param_var->double_value) {
-              allocator.deallocate(param_var->double_value, allocator.state);
-            } else if (NULL != param_var->string_value) {
-              allocator.deallocate(param_var->string_value, allocator.state);
-            } else if (NULL != param_var->bool_array_value) {
-              if (NULL != param_var->bool_array_value->values) {
-                allocator.deallocate(param_var->bool_array_value->values, allocator.state);
-              }
-              allocator.deallocate(param_var->bool_array_value, allocator.state);
-            } else if (NULL != param_var->integer_array_value) {
-              if (NULL != param_var->integer_array_value->values) {
-                allocator.deallocate(param_var->integer_array_value->values, allocator.state);
-              }
-              allocator.deallocate(param_var->integer_array_value, allocator.state);
-            } else if (NULL != param_var->double_array_value) {
-              if (NULL != param_var->double_array_value->values) {
-                allocator.deallocate(param_var->double_array_value->values, allocator.state);
-              }
-              allocator.deallocate(param_var->double_array_value, allocator.state);
-            } else if (NULL != param_var->string_array_value) {
-              if (RCL_RET_OK != rcutils_string_array_fini(param_var->string_array_value)) {
-                // Log and continue ...
-                RCUTILS_SAFE_FWRITE_TO_STDERR("Error deallocating string array");
-              }
-              allocator.deallocate(param_var->string_array_value, allocator.state);
-            } else {
-              /// Nothing to do to keep pclint happy
-            }
-          }  // if (param_var)
-        }
-      }  // for (parameter_idx)
-      if (NULL != params_st->params[node_idx].parameter_values) {
-        allocator.deallocate(params_st->params[node_idx].parameter_values, allocator.state);
-      }
-      if (NULL != params_st->params[node_idx].parameter_names) {
-        allocator.deallocate(params_st->params[node_idx].parameter_names, allocator.state);
-      }
-    }  // if (params)
+  /// The node names are interned; the intern table owns them
+  for (node_idx = 0; node_idx < params_st->num_nodes; node_idx++) {
+    if (NULL != params_st->params) {
+      node_params_fini(&(params_st->params[node_idx]), allocator);
+    }
   }  // for (node_idx)
   if (NULL != params_st->node_names) {
     allocator.deallocate(params_st->node_names, allocator.state);
@@ -482,466 +652,1116 @@ void rcl_yaml_node_struct_fini(
     params_st->params = NULL;
   }
   params_st->num_nodes = 0U;
-  allocator.deallocate(params_st, allocator.state);
+  intern_table_fini(params_st);
 }
 
 ///
-/// Dump the param structure
+/// Free param structure
+/// NOTE: If there is an error, would recommend just to safely exit the process instead
+/// of calling this free function and continuing
 ///
-void rcl_yaml_node_struct_print(
-  const rcl_params_t * const params_st)
+void rcl_yaml_node_struct_fini(
+  rcl_params_t * params_st)
 {
-  size_t node_idx;
-  size_t parameter_idx = 0U;
+  rcl_allocator_t allocator;
 
   if (NULL == params_st) {
     return;
   }
+  allocator = params_st->allocator;
 
-  printf("\n Node Name\t\t\t\tParameters\n");
-  for (node_idx = 0; node_idx < params_st->num_nodes; node_idx++) {
-    int32_t param_col = 50;
-    const char * const node_name = params_st->node_names[node_idx];
-    if (NULL != node_name) {
-      printf("%s\n", node_name);
-    }
-
-    if (NULL != params_st->params) {
-      char * param_name;
-      rcl_variant_t * param_var;
-      for (parameter_idx = 0; parameter_idx < params_st->params[node_idx].num_params;
-        parameter_idx++)
-      {
-        if ((NULL != params_st->params[node_idx].parameter_names) &&
-          (NULL != params_st->params[node_idx].parameter_values))
-        {
-          param_name = params_st->params[node_idx].parameter_names[parameter_idx];
-          param_var = &(params_st->params[node_idx].parameter_values[parameter_idx]);
-          if (NULL != param_name) {
-            printf("%*s", param_col, param_name);
-          }
+  if ((NULL != params_st->refcount) && (params_st->refcount->count > 1U)) {
+    /// the payload lives on in the other copies of the structure
+    params_st->refcount->count--;
+    allocator.deallocate(params_st, allocator.state);
+    return;
+  }
 
-          if (NULL != param_var) {
-            if (NULL != param_var->bool_value) {
-              printf(": %s\n", *(param_var->bool_value) ? "true" : "false");
-            } else if (NULL != param_var->integer_value) {
-              printf(": %" PRId64 "\n", *(param_var->integer_value));
-            } else if (NULL != param_var->double_value) {
-              printf(": %lf\n", *(param_var->double_value));
-            } else if (NULL != param_var->string_value) {
-              printf(": %s\n", param_var->string_value);
-            } else if (NULL != param_var->bool_array_value) {
-              printf(": ");
-              for (size_t i = 0; i < param_var->bool_array_value->size; i++) {
-                if (param_var->bool_array_value->values) {
-                  printf("%s, ",
-                    (param_var->bool_array_value->values[i]) ? "true" : "false");
-                }
-              }
-              printf("\n");
-            } else if (NULL != param_var->integer_array_value) {
-              printf(": ");
-              for (size_t i = 0; i < param_var->integer_array_value->size; i++) {
-                if (param_var->integer_array_value->values) {
-                  printf("%" PRId64 ", ", param_var->integer_array_value->values[i]);
-                }
-              }
-              printf("\n");
-            } else if (NULL != param_var->double_array_value) {
-              printf(": ");
-              for (size_t i = 0; i < param_var->double_array_value->size; i++) {
-                if (param_var->double_array_value->values) {
-                  printf("%lf, ", param_var->double_array_value->values[i]);
-                }
-              }
-              printf("\n");
-            } else if (NULL != param_var->string_array_value) {
-              printf(": ");
-              for (size_t i = 0; i < param_var->string_array_value->size; i++) {
-                if (param_var->string_array_value->data[i]) {
-                  printf("%s, ", param_var->string_array_value->data[i]);
-                }
-              }
-              printf("\n");
-            }
-          }
-        }
-      }
-    }
+  params_payload_fini(params_st);
+  if (NULL != params_st->refcount) {
+    allocator.deallocate(params_st->refcount, allocator.state);
   }
+  allocator.deallocate(params_st, allocator.state);
 }
 
 ///
-/// Add a value to a bool array. Create the array if it does not exist
+/// Deep copy the value stored in a parameter variant. String values are
+/// interned into dst_params_st's table, arrays keep the implicit capacity
+/// invariant of ensure_array_capacity so they can still be appended to
 ///
-static rcl_ret_t add_val_to_bool_arr(
-  rcl_bool_array_t * const val_array,
-  bool * value,
+static rcl_ret_t param_variant_copy(
+  const rcl_variant_t * src,
+  rcl_variant_t * dst,
+  rcl_params_t * dst_params_st,
   const rcl_allocator_t allocator)
 {
-  if ((NULL == value) || (NULL == val_array)) {
-    return RCL_RET_INVALID_ARGUMENT;
-  }
+  rcl_ret_t res;
+  size_t idx;
 
-  if (NULL == val_array->values) {
-    val_array->values = value;
-    val_array->size++;
-  } else {
-    /// Increase the array size by one and add the new value
-    bool * tmp_arr = val_array->values;
-    val_array->values = allocator.zero_allocate(val_array->size + 1U, sizeof(bool),
-        allocator.state);
-    if (NULL == val_array->values) {
-      RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+  if (NULL != src->bool_value) {
+    dst->bool_value = allocator.zero_allocate(1U, sizeof(bool), allocator.state);
+    if (NULL == dst->bool_value) {
       return RCL_RET_BAD_ALLOC;
     }
-    memmove(val_array->values, tmp_arr, (val_array->size * sizeof(bool)));
-    val_array->values[val_array->size] = *value;
-    val_array->size++;
-    allocator.deallocate(value, allocator.state);
-    allocator.deallocate(tmp_arr, allocator.state);
-  }
-  return RCL_RET_OK;
-}
-
-///
-/// Add a value to an integer array. Create the array if it does not exist
-///
-static rcl_ret_t add_val_to_int_arr(
-  rcl_int64_array_t * const val_array,
-  int64_t * value,
-  const rcl_allocator_t allocator)
-{
-  if ((NULL == value) || (NULL == val_array)) {
-    return RCL_RET_INVALID_ARGUMENT;
-  }
-
-  if (NULL == val_array->values) {
-    val_array->values = value;
-    val_array->size++;
-  } else {
-    /// Increase the array size by one and add the new value
-    int64_t * tmp_arr = val_array->values;
-    val_array->values = allocator.zero_allocate(val_array->size + 1U, sizeof(int64_t),
-        allocator.state);
-    if (NULL == val_array->values) {
-      RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+    *(dst->bool_value) = *(src->bool_value);
+  } else if (NULL != src->integer_value) {
+    dst->integer_value = allocator.zero_allocate(1U, sizeof(int64_t), allocator.state);
+    if (NULL == dst->integer_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    *(dst->integer_value) = *(src->integer_value);
+  } else if (NULL != src->double_value) {
+    dst->double_value = allocator.zero_allocate(1U, sizeof(double), allocator.state);
+    if (NULL == dst->double_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    *(dst->double_value) = *(src->double_value);
+  } else if (NULL != src->string_value) {
+    dst->string_value = intern_string(dst_params_st, src->string_value);
+    if (NULL == dst->string_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+  } else if (NULL != src->bool_array_value) {
+    dst->bool_array_value =
+      allocator.zero_allocate(1U, sizeof(rcl_bool_array_t), allocator.state);
+    if (NULL == dst->bool_array_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    if (src->bool_array_value->size > 0U) {
+      res = ensure_array_capacity((void **)&(dst->bool_array_value->values),
+          sizeof(bool), src->bool_array_value->size, allocator);
+      if (RCL_RET_OK != res) {
+        return res;
+      }
+      memcpy(dst->bool_array_value->values, src->bool_array_value->values,
+        (src->bool_array_value->size * sizeof(bool)));
+      dst->bool_array_value->size = src->bool_array_value->size;
+    }
+  } else if (NULL != src->integer_array_value) {
+    dst->integer_array_value =
+      allocator.zero_allocate(1U, sizeof(rcl_int64_array_t), allocator.state);
+    if (NULL == dst->integer_array_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    if (src->integer_array_value->size > 0U) {
+      res = ensure_array_capacity((void **)&(dst->integer_array_value->values),
+          sizeof(int64_t), src->integer_array_value->size, allocator);
+      if (RCL_RET_OK != res) {
+        return res;
+      }
+      memcpy(dst->integer_array_value->values, src->integer_array_value->values,
+        (src->integer_array_value->size * sizeof(int64_t)));
+      dst->integer_array_value->size = src->integer_array_value->size;
+    }
+  } else if (NULL != src->double_array_value) {
+    dst->double_array_value =
+      allocator.zero_allocate(1U, sizeof(rcl_double_array_t), allocator.state);
+    if (NULL == dst->double_array_value) {
       return RCL_RET_BAD_ALLOC;
     }
-    memmove(val_array->values, tmp_arr, (val_array->size * sizeof(int64_t)));
-    val_array->values[val_array->size] = *value;
-    val_array->size++;
-    allocator.deallocate(value, allocator.state);
-    allocator.deallocate(tmp_arr, allocator.state);
+    if (src->double_array_value->size > 0U) {
+      res = ensure_array_capacity((void **)&(dst->double_array_value->values),
+          sizeof(double), src->double_array_value->size, allocator);
+      if (RCL_RET_OK != res) {
+        return res;
+      }
+      memcpy(dst->double_array_value->values, src->double_array_value->values,
+        (src->double_array_value->size * sizeof(double)));
+      dst->double_array_value->size = src->double_array_value->size;
+    }
+  } else if (NULL != src->string_array_value) {
+    dst->string_array_value =
+      allocator.zero_allocate(1U, sizeof(rcutils_string_array_t), allocator.state);
+    if (NULL == dst->string_array_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    /// Adopt the allocator as add_val_to_string_arr() does
+    dst->string_array_value->allocator = allocator;
+    if (src->string_array_value->size > 0U) {
+      res = ensure_array_capacity((void **)&(dst->string_array_value->data),
+          sizeof(char *), src->string_array_value->size, allocator);
+      if (RCL_RET_OK != res) {
+        return res;
+      }
+      for (idx = 0U; idx < src->string_array_value->size; idx++) {
+        dst->string_array_value->data[idx] =
+          rcutils_strdup(src->string_array_value->data[idx], allocator);
+        if (NULL == dst->string_array_value->data[idx]) {
+          return RCL_RET_BAD_ALLOC;
+        }
+        dst->string_array_value->size = (idx + 1U);
+      }
+    }
+  } else {
+    /// Nothing to do to keep pclint happy
   }
   return RCL_RET_OK;
 }
 
 ///
-/// Add a value to a double array. Create the array if it does not exist
+/// Deep copy the parameter names and values of a single node.
+/// dst->num_params tracks the copied entries so a partial copy can be
+/// cleaned up with node_params_fini
 ///
-static rcl_ret_t add_val_to_double_arr(
-  rcl_double_array_t * const val_array,
-  double * value,
+static rcl_ret_t node_params_copy(
+  const rcl_node_params_t * src,
+  rcl_node_params_t * dst,
+  rcl_params_t * dst_params_st,
   const rcl_allocator_t allocator)
 {
-  if ((NULL == value) || (NULL == val_array)) {
-    return RCL_RET_INVALID_ARGUMENT;
-  }
+  size_t parameter_idx;
+  rcl_ret_t res;
 
-  if (NULL == val_array->values) {
-    val_array->values = value;
-    val_array->size++;
-  } else {
-    /// Increase the array size by one and add the new value
-    double * tmp_arr = val_array->values;
-    val_array->values = allocator.zero_allocate(val_array->size + 1U, sizeof(double),
-        allocator.state);
-    if (NULL == val_array->values) {
-      RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+  if (0U == src->num_params) {
+    return RCL_RET_OK;
+  }
+  res = ensure_array_capacity((void **)&(dst->parameter_names), sizeof(char *),
+      src->num_params, allocator);
+  if (RCL_RET_OK != res) {
+    return res;
+  }
+  res = ensure_array_capacity((void **)&(dst->parameter_values), sizeof(rcl_variant_t),
+      src->num_params, allocator);
+  if (RCL_RET_OK != res) {
+    return res;
+  }
+  for (parameter_idx = 0U; parameter_idx < src->num_params; parameter_idx++) {
+    dst->num_params = (parameter_idx + 1U);
+    dst->parameter_names[parameter_idx] =
+      intern_string(dst_params_st, src->parameter_names[parameter_idx]);
+    if (NULL == dst->parameter_names[parameter_idx]) {
       return RCL_RET_BAD_ALLOC;
     }
-    memmove(val_array->values, tmp_arr, (val_array->size * sizeof(double)));
-    val_array->values[val_array->size] = *value;
-    val_array->size++;
-    allocator.deallocate(value, allocator.state);
-    allocator.deallocate(tmp_arr, allocator.state);
+    res = param_variant_copy(&(src->parameter_values[parameter_idx]),
+        &(dst->parameter_values[parameter_idx]), dst_params_st, allocator);
+    if (RCL_RET_OK != res) {
+      return res;
+    }
   }
   return RCL_RET_OK;
 }
 
 ///
-/// Add a value to a string array. Create the array if it does not exist
+/// Compare two parameter variants for equal type and value
 ///
-static rcl_ret_t add_val_to_string_arr(
-  rcutils_string_array_t * const val_array,
-  char * value,
-  const rcl_allocator_t allocator)
+static bool param_variant_equal(
+  const rcl_variant_t * lhs,
+  const rcl_variant_t * rhs)
 {
-  if ((NULL == value) || (NULL == val_array)) {
-    return RCL_RET_INVALID_ARGUMENT;
-  }
-
-  if (NULL == val_array->data) {
-    rcl_ret_t res;
-
-    res = rcutils_string_array_init(val_array, 1, &allocator);
-    if (RCL_RET_OK != res) {
-      return res;
+  size_t idx;
+
+  if ((NULL != lhs->bool_value) && (NULL != rhs->bool_value)) {
+    return *(lhs->bool_value) == *(rhs->bool_value);
+  } else if ((NULL != lhs->integer_value) && (NULL != rhs->integer_value)) {
+    return *(lhs->integer_value) == *(rhs->integer_value);
+  } else if ((NULL != lhs->double_value) && (NULL != rhs->double_value)) {
+    return *(lhs->double_value) == *(rhs->double_value);
+  } else if ((NULL != lhs->string_value) && (NULL != rhs->string_value)) {
+    return 0 == strcmp(lhs->string_value, rhs->string_value);
+  } else if ((NULL != lhs->bool_array_value) && (NULL != rhs->bool_array_value)) {
+    if (lhs->bool_array_value->size != rhs->bool_array_value->size) {
+      return false;
     }
-    val_array->data[0U] = value;
-  } else {
-    /// Increase the array size by one and add the new value
-    val_array->data = allocator.reallocate(val_array->data,
-        ((val_array->size + 1U) * sizeof(char *)), allocator.state);
-    if (NULL == val_array->data) {
-      RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
-      return RCL_RET_BAD_ALLOC;
+    return (0U == lhs->bool_array_value->size) ||
+           (0 == memcmp(lhs->bool_array_value->values, rhs->bool_array_value->values,
+           lhs->bool_array_value->size * sizeof(bool)));
+  } else if ((NULL != lhs->integer_array_value) && (NULL != rhs->integer_array_value)) {
+    if (lhs->integer_array_value->size != rhs->integer_array_value->size) {
+      return false;
+    }
+    return (0U == lhs->integer_array_value->size) ||
+           (0 == memcmp(lhs->integer_array_value->values, rhs->integer_array_value->values,
+           lhs->integer_array_value->size * sizeof(int64_t)));
+  } else if ((NULL != lhs->double_array_value) && (NULL != rhs->double_array_value)) {
+    if (lhs->double_array_value->size != rhs->double_array_value->size) {
+      return false;
+    }
+    return (0U == lhs->double_array_value->size) ||
+           (0 == memcmp(lhs->double_array_value->values, rhs->double_array_value->values,
+           lhs->double_array_value->size * sizeof(double)));
+  } else if ((NULL != lhs->string_array_value) && (NULL != rhs->string_array_value)) {
+    if (lhs->string_array_value->size != rhs->string_array_value->size) {
+      return false;
+    }
+    for (idx = 0U; idx < lhs->string_array_value->size; idx++) {
+      if (0 != strcmp(lhs->string_array_value->data[idx],
+        rhs->string_array_value->data[idx]))
+      {
+        return false;
+      }
     }
-    val_array->data[val_array->size] = value;
-    val_array->size++;
+    return true;
   }
-  return RCL_RET_OK;
+  /// Different types (or no value at all) never compare equal
+  return false;
 }
 
 ///
-/// Determine the type of the value and return the converted value
-/// NOTE: Only canonical forms supported as of now
+/// Find a node's parameter entry by name, appending an empty one when the
+/// node is not in the structure yet
 ///
-static void * get_value(
-  const char * const value,
-  yaml_scalar_style_t style,
-  data_types_t * val_type,
-  const rcl_allocator_t allocator)
+static rcl_ret_t params_find_or_append_node(
+  rcl_params_t * params_st,
+  const char * node_name,
+  rcl_node_params_t ** node_params)
 {
-  void * ret_val;
-  int64_t ival;
-  double dval;
-  char * endptr = NULL;
+  const rcl_allocator_t allocator = params_st->allocator;
+  size_t node_idx;
+  char * interned;
+  rcl_ret_t res;
 
-  if ((NULL == value) || (NULL == val_type)) {
-    RCL_SET_ERROR_MSG("Invalid arguments");
-    return NULL;
+  for (node_idx = 0U; node_idx < params_st->num_nodes; node_idx++) {
+    if (0 == strcmp(params_st->node_names[node_idx], node_name)) {
+      *node_params = &(params_st->params[node_idx]);
+      return RCL_RET_OK;
+    }
+  }
+  interned = intern_string(params_st, node_name);
+  if (NULL == interned) {
+    return RCL_RET_BAD_ALLOC;
+  }
+  res = ensure_array_capacity((void **)&(params_st->node_names), sizeof(char *),
+      (params_st->num_nodes + 1U), allocator);
+  if (RCL_RET_OK != res) {
+    return res;
+  }
+  res = ensure_array_capacity((void **)&(params_st->params), sizeof(rcl_node_params_t),
+      (params_st->num_nodes + 1U), allocator);
+  if (RCL_RET_OK != res) {
+    return res;
+  }
+  params_st->node_names[params_st->num_nodes] = interned;
+  res = node_params_init(&(params_st->params[params_st->num_nodes]), allocator);
+  if (RCL_RET_OK != res) {
+    return res;
   }
+  *node_params = &(params_st->params[params_st->num_nodes]);
+  params_st->num_nodes++;
+  return RCL_RET_OK;
+}
 
-  /// Check if it is bool
-  if (style != YAML_SINGLE_QUOTED_SCALAR_STYLE &&
-    style != YAML_DOUBLE_QUOTED_SCALAR_STYLE)
-  {
-    if ((0 == strcmp(value, "Y")) ||
-      (0 == strcmp(value, "y")) ||
-      (0 == strcmp(value, "yes")) ||
-      (0 == strcmp(value, "Yes")) ||
-      (0 == strcmp(value, "YES")) ||
-      (0 == strcmp(value, "true")) ||
-      (0 == strcmp(value, "True")) ||
-      (0 == strcmp(value, "TRUE")) ||
-      (0 == strcmp(value, "on")) ||
-      (0 == strcmp(value, "On")) ||
-      (0 == strcmp(value, "ON")))
-    {
-      *val_type = DATA_TYPE_BOOL;
-      ret_val = allocator.zero_allocate(1U, sizeof(bool), allocator.state);
-      if (NULL == ret_val) {
-        return NULL;
-      }
-      *((bool *)ret_val) = true;
-      return ret_val;
-    }
-
-    if ((0 == strcmp(value, "N")) ||
-      (0 == strcmp(value, "n")) ||
-      (0 == strcmp(value, "no")) ||
-      (0 == strcmp(value, "No")) ||
-      (0 == strcmp(value, "NO")) ||
-      (0 == strcmp(value, "false")) ||
-      (0 == strcmp(value, "False")) ||
-      (0 == strcmp(value, "FALSE")) ||
-      (0 == strcmp(value, "off")) ||
-      (0 == strcmp(value, "Off")) ||
-      (0 == strcmp(value, "OFF")))
-    {
-      *val_type = DATA_TYPE_BOOL;
-      ret_val = allocator.zero_allocate(1U, sizeof(bool), allocator.state);
-      if (NULL == ret_val) {
-        return NULL;
-      }
-      *((bool *)ret_val) = false;
-      return ret_val;
+///
+/// Apply one parsed value to node_params, replacing the stored value only
+/// when it differs; changed reports whether anything was written
+///
+static rcl_ret_t update_node_parameter(
+  rcl_params_t * params_st,
+  rcl_node_params_t * node_params,
+  const char * param_name,
+  const rcl_variant_t * new_value,
+  bool * changed)
+{
+  const rcl_allocator_t allocator = params_st->allocator;
+  size_t parameter_idx;
+  rcl_variant_t * param_var = NULL;
+  rcl_ret_t res;
+
+  for (parameter_idx = 0U; parameter_idx < node_params->num_params; parameter_idx++) {
+    if (0 == strcmp(node_params->parameter_names[parameter_idx], param_name)) {
+      param_var = &(node_params->parameter_values[parameter_idx]);
+      break;
     }
   }
+  if (NULL != param_var) {
+    if (param_variant_equal(param_var, new_value)) {
+      *changed = false;
+      return RCL_RET_OK;
+    }
+    param_variant_fini(param_var, allocator);
+    memset(param_var, 0, sizeof(rcl_variant_t));
+  } else {
+    char * interned = intern_string(params_st, param_name);
 
-  /// Check for int
-  errno = 0;
-  ival = strtol(value, &endptr, 0);
-  if ((0 == errno) && (NULL != endptr)) {
-    if ((NULL != endptr) && (endptr != value)) {
-      if (('\0' != *value) && ('\0' == *endptr)) {
-        *val_type = DATA_TYPE_INT64;
-        ret_val = allocator.zero_allocate(1U, sizeof(int64_t), allocator.state);
-        if (NULL == ret_val) {
-          return NULL;
-        }
-        *((int64_t *)ret_val) = ival;
-        return ret_val;
-      }
+    if (NULL == interned) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    res = ensure_array_capacity((void **)&(node_params->parameter_names), sizeof(char *),
+        (node_params->num_params + 1U), allocator);
+    if (RCL_RET_OK != res) {
+      return res;
+    }
+    res = ensure_array_capacity((void **)&(node_params->parameter_values), sizeof(rcl_variant_t),
+        (node_params->num_params + 1U), allocator);
+    if (RCL_RET_OK != res) {
+      return res;
     }
+    node_params->parameter_names[node_params->num_params] = interned;
+    param_var = &(node_params->parameter_values[node_params->num_params]);
+    node_params->num_params++;
   }
+  *changed = true;
+  return param_variant_copy(new_value, param_var, params_st, allocator);
+}
 
-  /// Check for float
-  errno = 0;
-  endptr = NULL;
-  dval = strtod(value, &endptr);
-  if ((0 == errno) && (NULL != endptr)) {
-    if ((NULL != endptr) && (endptr != value)) {
-      if (('\0' != *value) && ('\0' == *endptr)) {
-        *val_type = DATA_TYPE_DOUBLE;
-        ret_val = allocator.zero_allocate(1U, sizeof(double), allocator.state);
-        if (NULL == ret_val) {
-          return NULL;
-        }
-        *((double *)ret_val) = dval;
-        return ret_val;
-      }
+///
+/// Deep copy the payload of src into dst, whose payload fields must be
+/// zero initialized and whose allocator must already be set
+///
+static rcl_ret_t params_payload_copy(
+  const rcl_params_t * src,
+  rcl_params_t * dst)
+{
+  const rcl_allocator_t allocator = dst->allocator;
+  size_t node_idx;
+  rcl_ret_t res;
+
+  if (0U == src->num_nodes) {
+    return RCL_RET_OK;
+  }
+  res = ensure_array_capacity((void **)&(dst->node_names), sizeof(char *),
+      src->num_nodes, allocator);
+  if (RCL_RET_OK != res) {
+    return res;
+  }
+  res = ensure_array_capacity((void **)&(dst->params), sizeof(rcl_node_params_t),
+      src->num_nodes, allocator);
+  if (RCL_RET_OK != res) {
+    return res;
+  }
+  for (node_idx = 0U; node_idx < src->num_nodes; node_idx++) {
+    dst->num_nodes = (node_idx + 1U);
+    dst->node_names[node_idx] = intern_string(dst, src->node_names[node_idx]);
+    if (NULL == dst->node_names[node_idx]) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    res = node_params_copy(&(src->params[node_idx]), &(dst->params[node_idx]),
+        dst, allocator);
+    if (RCL_RET_OK != res) {
+      return res;
     }
   }
-  errno = 0;
-
-  /// It is a string
-  *val_type = DATA_TYPE_STRING;
-  ret_val = rcutils_strdup(value, allocator);
-  return ret_val;
+  return RCL_RET_OK;
 }
 
 ///
-/// Parse the value part of the <key:value> pair
+/// Copy the param structure by sharing its payload
 ///
-static rcl_ret_t parse_value(
-  const yaml_event_t event,
-  const bool is_seq,
-  data_types_t * seq_data_type,
-  rcl_params_t * params_st)
+rcl_params_t * rcl_yaml_node_struct_copy(
+  const rcl_params_t * params_st)
 {
-  void * ret_val;
-  data_types_t val_type;
-  int res = RCL_RET_OK;
   rcl_allocator_t allocator;
+  rcl_params_t * copy;
 
-  if ((NULL == params_st) || (0U == params_st->num_nodes) || (NULL == seq_data_type)) {
-    return RCL_RET_INVALID_ARGUMENT;
+  if (NULL == params_st) {
+    return NULL;
   }
   allocator = params_st->allocator;
 
-  const size_t node_idx = (params_st->num_nodes - 1U);
-  if (0U == params_st->params[node_idx].num_params) {
-    return RCL_RET_INVALID_ARGUMENT;
+  copy = allocator.zero_allocate(1U, sizeof(rcl_params_t), allocator.state);
+  if (NULL == copy) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+    return NULL;
   }
 
-  const size_t parameter_idx = ((params_st->params[node_idx].num_params) - 1U);
-  const size_t val_size = event.data.scalar.length;
-  const char * value = (char *)event.data.scalar.value;
-  yaml_scalar_style_t style = event.data.scalar.style;
-  const uint32_t line_num = ((uint32_t)(event.start_mark.line) + 1U);
-  rcl_variant_t * param_value;
+  if (NULL != params_st->refcount) {
+    /// the common case: share the payload and bump the reference count
+    *copy = *params_st;
+    copy->refcount->count++;
+    return copy;
+  }
 
-  if (val_size > MAX_STRING_SIZE) {
-    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-      "Scalar value at line %d is bigger than %d bytes", line_num, MAX_STRING_SIZE);
-    return RCL_RET_ERROR;
-  } else {
-    if (0U == val_size) {
-      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("No value at line %d", line_num);
-      return RCL_RET_ERROR;
-    }
+  /// no reference count to share (the structure was built by hand);
+  /// fall back to a deep copy with its own count
+  copy->allocator = allocator;
+  copy->refcount =
+    allocator.zero_allocate(1U, sizeof(rcl_yaml_params_refcount_t), allocator.state);
+  if (NULL == copy->refcount) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+    allocator.deallocate(copy, allocator.state);
+    return NULL;
+  }
+  copy->refcount->count = 1U;
+  if (RCL_RET_OK != params_payload_copy(params_st, copy)) {
+    rcl_yaml_node_struct_fini(copy);
+    return NULL;
   }
+  return copy;
+}
 
-  if (NULL == value) {
-    return RCL_RET_INVALID_ARGUMENT;
+///
+/// Make params_st the sole owner of its payload, detaching it onto a deep
+/// copy when the payload is currently shared with other copies
+///
+static rcl_ret_t params_struct_ensure_owned(
+  rcl_params_t * params_st)
+{
+  const rcl_allocator_t allocator = params_st->allocator;
+  rcl_params_t owned;
+  rcl_yaml_params_refcount_t * refcount;
+
+  if ((NULL == params_st->refcount) || (params_st->refcount->count <= 1U)) {
+    return RCL_RET_OK;
   }
 
-  if (NULL == params_st->params[node_idx].parameter_values) {
-    RCL_SET_ERROR_MSG("Internal error: Invalid mem");
+  refcount = allocator.zero_allocate(1U, sizeof(rcl_yaml_params_refcount_t), allocator.state);
+  if (NULL == refcount) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
     return RCL_RET_BAD_ALLOC;
   }
+  refcount->count = 1U;
 
-  param_value = &(params_st->params[node_idx].parameter_values[parameter_idx]);
+  memset(&owned, 0, sizeof(owned));
+  owned.allocator = allocator;
+  if (RCL_RET_OK != params_payload_copy(params_st, &owned)) {
+    params_payload_fini(&owned);
+    allocator.deallocate(refcount, allocator.state);
+    return RCL_RET_BAD_ALLOC;
+  }
 
-  // param_value->string_value = rcutils_strdup(value, allocator);
-  ret_val = get_value(value, style, &val_type, allocator);
-  if (NULL == ret_val) {
-    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Error parsing value %s at line %d", value, line_num);
-    return RCL_RET_ERROR;
+  /// adopt the owned payload; the shared one lives on in the other copies
+  params_st->refcount->count--;
+  params_st->node_names = owned.node_names;
+  params_st->params = owned.params;
+  params_st->num_nodes = owned.num_nodes;
+  params_st->intern_table = owned.intern_table;
+  params_st->refcount = refcount;
+  return RCL_RET_OK;
+}
+
+///
+/// Dump the param structure
+///
+void rcl_yaml_node_struct_print(
+  const rcl_params_t * const params_st)
+{
+  size_t node_idx;
+  size_t parameter_idx = 0U;
+
+  if (NULL == params_st) {
+    return;
   }
 
-  switch (val_type) {
-    case DATA_TYPE_UNKNOWN:
-      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-        "Unknown data type of value %s at line %d\n", value, line_num);
-      res = RCL_RET_ERROR;
-      break;
-    case DATA_TYPE_BOOL:
-      if (false == is_seq) {
-        param_value->bool_value = (bool *)ret_val;
-      } else {
-        if (DATA_TYPE_UNKNOWN == *seq_data_type) {
-          *seq_data_type = val_type;
-          param_value->bool_array_value =
-            allocator.zero_allocate(1U, sizeof(rcl_bool_array_t), allocator.state);
-          if (NULL == param_value->bool_array_value) {
-            RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
-            return RCL_RET_BAD_ALLOC;
-          }
-        } else {
-          if (*seq_data_type != val_type) {
-            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-              "Sequence should be of same type. Value type 'bool' do not belong at line_num %d",
-              line_num);
-            allocator.deallocate(ret_val, allocator.state);
-            return RCL_RET_ERROR;
+  printf("\n Node Name\t\t\t\tParameters\n");
+  for (node_idx = 0; node_idx < params_st->num_nodes; node_idx++) {
+    int32_t param_col = 50;
+    const char * const node_name = params_st->node_names[node_idx];
+    if (NULL != node_name) {
+      printf("%s\n", node_name);
+    }
+
+    if (NULL != params_st->params) {
+      char * param_name;
+      rcl_variant_t * param_var;
+      for (parameter_idx = 0; parameter_idx < params_st->params[node_idx].num_params;
+        parameter_idx++)
+      {
+        if ((NULL != params_st->params[node_idx].parameter_names) &&
+          (NULL != params_st->params[node_idx].parameter_values))
+        {
+          param_name = params_st->params[node_idx].parameter_names[parameter_idx];
+          param_var = &(params_st->params[node_idx].parameter_values[parameter_idx]);
+          if (NULL != param_name) {
+            printf("%*s", param_col, param_name);
           }
-        }
-        res = add_val_to_bool_arr(param_value->bool_array_value, ret_val, allocator);
-        if (RCL_RET_OK != res) {
-          if (NULL != ret_val) {
-            allocator.deallocate(ret_val, allocator.state);
+
+          if (NULL != param_var) {
+            if (NULL != param_var->bool_value) {
+              printf(": %s\n", *(param_var->bool_value) ? "true" : "false");
+            } else if (NULL != param_var->integer_value) {
+              printf(": %" PRId64 "\n", *(param_var->integer_value));
+            } else if (NULL != param_var->double_value) {
+              printf(": %lf\n", *(param_var->double_value));
+            } else if (NULL != param_var->string_value) {
+              printf(": %s\n", param_var->string_value);
+            } else if (NULL != param_var->bool_array_value) {
+              printf(": ");
+              for (size_t i = 0; i < param_var->bool_array_value->size; i++) {
+                if (param_var->bool_array_value->values) {
+                  printf("%s, ",
+                    (param_var->bool_array_value->values[i]) ? "true" : "false");
+                }
+              }
+              printf("\n");
+            } else if (NULL != param_var->integer_array_value) {
+              printf(": ");
+              for (size_t i = 0; i < param_var->integer_array_value->size; i++) {
+                if (param_var->integer_array_value->values) {
+                  printf("%" PRId64 ", ", param_var->integer_array_value->values[i]);
+                }
+              }
+              printf("\n");
+            } else if (NULL != param_var->double_array_value) {
+              printf(": ");
+              for (size_t i = 0; i < param_var->double_array_value->size; i++) {
+                if (param_var->double_array_value->values) {
+                  printf("%lf, ", param_var->double_array_value->values[i]);
+                }
+              }
+              printf("\n");
+            } else if (NULL != param_var->string_array_value) {
+              printf(": ");
+              for (size_t i = 0; i < param_var->string_array_value->size; i++) {
+                if (param_var->string_array_value->data[i]) {
+                  printf("%s, ", param_var->string_array_value->data[i]);
+                }
+              }
+              printf("\n");
+            }
           }
-          return res;
         }
       }
-      break;
-    case DATA_TYPE_INT64:
-      if (false == is_seq) {
-        param_value->integer_value = (int64_t *)ret_val;
+    }
+  }
+}
+
+///
+/// Add a value to a bool array. Create the array if it does not exist
+///
+static rcl_ret_t add_val_to_bool_arr(
+  rcl_bool_array_t * const val_array,
+  const bool * value,
+  const rcl_allocator_t allocator)
+{
+  rcl_ret_t res;
+
+  if ((NULL == value) || (NULL == val_array)) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  res = ensure_array_capacity((void **)&(val_array->values), sizeof(bool),
+      (val_array->size + 1U), allocator);
+  if (RCL_RET_OK != res) {
+    return res;
+  }
+  val_array->values[val_array->size] = *value;
+  val_array->size++;
+  return RCL_RET_OK;
+}
+
+///
+/// Add a value to an integer array. Create the array if it does not exist
+///
+static rcl_ret_t add_val_to_int_arr(
+  rcl_int64_array_t * const val_array,
+  const int64_t * value,
+  const rcl_allocator_t allocator)
+{
+  rcl_ret_t res;
+
+  if ((NULL == value) || (NULL == val_array)) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  res = ensure_array_capacity((void **)&(val_array->values), sizeof(int64_t),
+      (val_array->size + 1U), allocator);
+  if (RCL_RET_OK != res) {
+    return res;
+  }
+  val_array->values[val_array->size] = *value;
+  val_array->size++;
+  return RCL_RET_OK;
+}
+
+///
+/// Add a value to a double array. Create the array if it does not exist
+///
+static rcl_ret_t add_val_to_double_arr(
+  rcl_double_array_t * const val_array,
+  const double * value,
+  const rcl_allocator_t allocator)
+{
+  rcl_ret_t res;
+
+  if ((NULL == value) || (NULL == val_array)) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  res = ensure_array_capacity((void **)&(val_array->values), sizeof(double),
+      (val_array->size + 1U), allocator);
+  if (RCL_RET_OK != res) {
+    return res;
+  }
+  val_array->values[val_array->size] = *value;
+  val_array->size++;
+  return RCL_RET_OK;
+}
+
+///
+/// Add a value to a string array. Create the array if it does not exist
+///
+static rcl_ret_t add_val_to_string_arr(
+  rcutils_string_array_t * const val_array,
+  char * value,
+  const rcl_allocator_t allocator)
+{
+  rcl_ret_t res;
+
+  if ((NULL == value) || (NULL == val_array)) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  if (NULL == val_array->data) {
+    /// Adopt the allocator as rcutils_string_array_init() would, so that
+    /// rcutils_string_array_fini() can release the array
+    val_array->allocator = allocator;
+  }
+  res = ensure_array_capacity((void **)&(val_array->data), sizeof(char *),
+      (val_array->size + 1U), allocator);
+  if (RCL_RET_OK != res) {
+    return res;
+  }
+  val_array->data[val_array->size] = value;
+  val_array->size++;
+  return RCL_RET_OK;
+}
+
+///
+/// Fast path for plain decimal integers; returns true and sets *out when the
+/// value is a (possibly signed) run of decimal digits fitting an int64_t.
+/// Anything else (hex, octal, overflow, trailing characters) is left to the
+/// strtol() slow path.
+///
+static bool fast_parse_int64(const char * value, int64_t * out)
+{
+  const char * str = value;
+  bool negative = false;
+  if (('+' == *str) || ('-' == *str)) {
+    negative = ('-' == *str);
+    ++str;
+  }
+  if ((*str < '0') || (*str > '9')) {
+    return false;
+  }
+  /// a leading zero would be parsed as octal (or hex) by strtol(.., 0)
+  if (('0' == str[0]) && ('\0' != str[1])) {
+    return false;
+  }
+  uint64_t magnitude = 0U;
+  size_t num_digits = 0U;
+  while ((*str >= '0') && (*str <= '9')) {
+    magnitude = (magnitude * 10U) + (uint64_t)(*str - '0');
+    ++str;
+    ++num_digits;
+  }
+  if (('\0' != *str) || (num_digits > 18U)) {
+    /// trailing characters, or close enough to 2^63 to risk overflow
+    return false;
+  }
+  *out = negative ? -((int64_t)magnitude) : (int64_t)magnitude;
+  return true;
+}
+
+/// Powers of ten which are exactly representable in a double
+static const double fast_pow10[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+///
+/// Fast path for doubles of the common [-]digits[.digits][e[+-]digits] form.
+/// When the decimal mantissa fits 53 bits and the power of ten is exactly
+/// representable, a single multiply or divide produces the correctly rounded
+/// result and strtod() is skipped; calibration dumps are dominated by such
+/// numbers. Everything else falls back to strtod().
+///
+static bool fast_parse_double(const char * value, double * out)
+{
+  const char * str = value;
+  bool negative = false;
+  if (('+' == *str) || ('-' == *str)) {
+    negative = ('-' == *str);
+    ++str;
+  }
+  uint64_t mantissa = 0U;
+  size_t num_digits = 0U;
+  int exponent = 0;
+  bool any_digits = false;
+  bool dropped_digits = false;
+  while ((*str >= '0') && (*str <= '9')) {
+    if (num_digits < 19U) {
+      mantissa = (mantissa * 10U) + (uint64_t)(*str - '0');
+      ++num_digits;
+    } else {
+      /// leading zeros count toward the cap, so a small mantissa can still
+      /// have dropped digits; force the fallback below
+      ++exponent;
+      dropped_digits = true;
+    }
+    any_digits = true;
+    ++str;
+  }
+  if ('.' == *str) {
+    ++str;
+    while ((*str >= '0') && (*str <= '9')) {
+      if (num_digits < 19U) {
+        mantissa = (mantissa * 10U) + (uint64_t)(*str - '0');
+        ++num_digits;
+        --exponent;
       } else {
-        if (DATA_TYPE_UNKNOWN == *seq_data_type) {
-          *seq_data_type = val_type;
-          param_value->integer_array_value =
-            allocator.zero_allocate(1U, sizeof(rcl_int64_array_t), allocator.state);
-          if (NULL == param_value->integer_array_value) {
-            RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
-            return RCL_RET_BAD_ALLOC;
-          }
-        } else {
-          if (*seq_data_type != val_type) {
-            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-              "Sequence should be of same type. Value type 'integer' do not belong at line_num %d",
-              line_num);
-            allocator.deallocate(ret_val, allocator.state);
-            return RCL_RET_ERROR;
-          }
+        dropped_digits = true;
+      }
+      any_digits = true;
+      ++str;
+    }
+  }
+  if (!any_digits) {
+    return false;
+  }
+  if (('e' == *str) || ('E' == *str)) {
+    ++str;
+    bool exp_negative = false;
+    if (('+' == *str) || ('-' == *str)) {
+      exp_negative = ('-' == *str);
+      ++str;
+    }
+    if ((*str < '0') || (*str > '9')) {
+      return false;
+    }
+    int exp_value = 0;
+    while ((*str >= '0') && (*str <= '9')) {
+      if (exp_value < 10000) {
+        exp_value = (exp_value * 10) + (*str - '0');
+      }
+      ++str;
+    }
+    exponent += exp_negative ? -exp_value : exp_value;
+  }
+  if ('\0' != *str) {
+    return false;
+  }
+  if (dropped_digits || (mantissa > (1ULL << 53)) || (exponent < -22) || (exponent > 22)) {
+    return false;
+  }
+  double result = (double)mantissa;
+  if (exponent < 0) {
+    result /= fast_pow10[-exponent];
+  } else {
+    result *= fast_pow10[exponent];
+  }
+  *out = negative ? -result : result;
+  return true;
+}
+
+///
+/// Check whether the scalar is one of the YAML boolean words
+///
+static bool scalar_is_bool(const char * value, bool * bool_value)
+{
+  if ((0 == strcmp(value, "Y")) ||
+    (0 == strcmp(value, "y")) ||
+    (0 == strcmp(value, "yes")) ||
+    (0 == strcmp(value, "Yes")) ||
+    (0 == strcmp(value, "YES")) ||
+    (0 == strcmp(value, "true")) ||
+    (0 == strcmp(value, "True")) ||
+    (0 == strcmp(value, "TRUE")) ||
+    (0 == strcmp(value, "on")) ||
+    (0 == strcmp(value, "On")) ||
+    (0 == strcmp(value, "ON")))
+  {
+    *bool_value = true;
+    return true;
+  }
+  if ((0 == strcmp(value, "N")) ||
+    (0 == strcmp(value, "n")) ||
+    (0 == strcmp(value, "no")) ||
+    (0 == strcmp(value, "No")) ||
+    (0 == strcmp(value, "NO")) ||
+    (0 == strcmp(value, "false")) ||
+    (0 == strcmp(value, "False")) ||
+    (0 == strcmp(value, "FALSE")) ||
+    (0 == strcmp(value, "off")) ||
+    (0 == strcmp(value, "Off")) ||
+    (0 == strcmp(value, "OFF")))
+  {
+    *bool_value = false;
+    return true;
+  }
+  return false;
+}
+
+///
+/// Classify a scalar the same way get_value() would, without producing or
+/// allocating the value; used by the validate-only pass
+///
+static data_types_t scalar_data_type(
+  const char * const value,
+  yaml_scalar_style_t style)
+{
+  bool bval;
+  int64_t ival;
+  double dval;
+  char * endptr = NULL;
+
+  if (style != YAML_SINGLE_QUOTED_SCALAR_STYLE &&
+    style != YAML_DOUBLE_QUOTED_SCALAR_STYLE)
+  {
+    if (scalar_is_bool(value, &bval)) {
+      return DATA_TYPE_BOOL;
+    }
+  }
+
+  if (fast_parse_int64(value, &ival)) {
+    return DATA_TYPE_INT64;
+  }
+  if (fast_parse_double(value, &dval)) {
+    return DATA_TYPE_DOUBLE;
+  }
+
+  const char first = value[0];
+  const bool maybe_number =
+    ((first >= '0') && (first <= '9')) ||
+    ('+' == first) || ('-' == first) || ('.' == first) ||
+    ('n' == first) || ('N' == first) || ('i' == first) || ('I' == first);
+
+  if (maybe_number) {
+    errno = 0;
+    ival = strtol(value, &endptr, 0);
+    if ((0 == errno) && (NULL != endptr) && (endptr != value) &&
+      ('\0' != *value) && ('\0' == *endptr))
+    {
+      return DATA_TYPE_INT64;
+    }
+    errno = 0;
+    endptr = NULL;
+    dval = strtod(value, &endptr);
+    if ((0 == errno) && (NULL != endptr) && (endptr != value) &&
+      ('\0' != *value) && ('\0' == *endptr))
+    {
+      return DATA_TYPE_DOUBLE;
+    }
+    errno = 0;
+  }
+  return DATA_TYPE_STRING;
+}
+
+///
+/// Determine the type of the value and return the converted value.
+/// Scalar (bool/int/double) results are stored into scalar_storage, which
+/// must be at least 8 bytes; only strings are heap allocated.
+/// NOTE: Only canonical forms supported as of now
+///
+static void * get_value(
+  const char * const value,
+  yaml_scalar_style_t style,
+  data_types_t * val_type,
+  void * const scalar_storage,
+  const rcl_allocator_t allocator)
+{
+  void * ret_val;
+  int64_t ival;
+  double dval;
+  char * endptr = NULL;
+
+  if ((NULL == value) || (NULL == val_type) || (NULL == scalar_storage)) {
+    RCL_SET_ERROR_MSG("Invalid arguments");
+    return NULL;
+  }
+
+  /// Check if it is bool
+  if (style != YAML_SINGLE_QUOTED_SCALAR_STYLE &&
+    style != YAML_DOUBLE_QUOTED_SCALAR_STYLE)
+  {
+    bool bval;
+    if (scalar_is_bool(value, &bval)) {
+      *val_type = DATA_TYPE_BOOL;
+      *((bool *)scalar_storage) = bval;
+      return scalar_storage;
+    }
+  }
+
+  /// Fast paths for the common decimal forms; anything unusual falls through
+  /// to the strtol()/strtod() checks below
+  if (fast_parse_int64(value, &ival)) {
+    *val_type = DATA_TYPE_INT64;
+    *((int64_t *)scalar_storage) = ival;
+    return scalar_storage;
+  }
+  if (fast_parse_double(value, &dval)) {
+    *val_type = DATA_TYPE_DOUBLE;
+    *((double *)scalar_storage) = dval;
+    return scalar_storage;
+  }
+
+  /// Skip the slow conversions entirely when the first character cannot start
+  /// a number ('n' and 'i' are kept for nan/inf, which strtod() accepts)
+  const char first = value[0];
+  const bool maybe_number =
+    ((first >= '0') && (first <= '9')) ||
+    ('+' == first) || ('-' == first) || ('.' == first) ||
+    ('n' == first) || ('N' == first) || ('i' == first) || ('I' == first);
+
+  /// Check for int
+  if (maybe_number) {
+    errno = 0;
+    ival = strtol(value, &endptr, 0);
+    if ((0 == errno) && (NULL != endptr)) {
+      if ((NULL != endptr) && (endptr != value)) {
+        if (('\0' != *value) && ('\0' == *endptr)) {
+          *val_type = DATA_TYPE_INT64;
+          *((int64_t *)scalar_storage) = ival;
+          return scalar_storage;
         }
-        res = add_val_to_int_arr(param_value->integer_array_value, ret_val, allocator);
-        if (RCL_RET_OK != res) {
-          if (NULL != ret_val) {
-            allocator.deallocate(ret_val, allocator.state);
-          }
-          return res;
+      }
+    }
+
+    /// Check for float
+    errno = 0;
+    endptr = NULL;
+    dval = strtod(value, &endptr);
+    if ((0 == errno) && (NULL != endptr)) {
+      if ((NULL != endptr) && (endptr != value)) {
+        if (('\0' != *value) && ('\0' == *endptr)) {
+          *val_type = DATA_TYPE_DOUBLE;
+          *((double *)scalar_storage) = dval;
+          return scalar_storage;
         }
       }
-      break;
-    case DATA_TYPE_DOUBLE:
-      if (false == is_seq) {
-        param_value->double_value = (double *)ret_val;
+    }
+    errno = 0;
+  }
+
+  /// It is a string
+  *val_type = DATA_TYPE_STRING;
+  ret_val = rcutils_strdup(value, allocator);
+  return ret_val;
+}
+
+///
+/// Parse the value part of the <key:value> pair
+///
+static rcl_ret_t parse_value(
+  const yaml_event_t event,
+  const bool is_seq,
+  data_types_t * seq_data_type,
+  rcl_params_t * params_st)
+{
+  void * ret_val;
+  data_types_t val_type;
+  int res = RCL_RET_OK;
+  rcl_allocator_t allocator;
+
+  if ((NULL == params_st) || (0U == params_st->num_nodes) || (NULL == seq_data_type)) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  allocator = params_st->allocator;
+
+  const size_t node_idx = (params_st->num_nodes - 1U);
+  if (0U == params_st->params[node_idx].num_params) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  const size_t parameter_idx = ((params_st->params[node_idx].num_params) - 1U);
+  const size_t val_size = event.data.scalar.length;
+  const char * value = (char *)event.data.scalar.value;
+  yaml_scalar_style_t style = event.data.scalar.style;
+  const uint32_t line_num = ((uint32_t)(event.start_mark.line) + 1U);
+  rcl_variant_t * param_value;
+
+  if (val_size > MAX_STRING_SIZE) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Scalar value at line %d is bigger than %d bytes", line_num, MAX_STRING_SIZE);
+    return RCL_RET_ERROR;
+  } else {
+    if (0U == val_size) {
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("No value at line %d", line_num);
+      return RCL_RET_ERROR;
+    }
+  }
+
+  if (NULL == value) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  if (NULL == params_st->params[node_idx].parameter_values) {
+    RCL_SET_ERROR_MSG("Internal error: Invalid mem");
+    return RCL_RET_BAD_ALLOC;
+  }
+
+  param_value = &(params_st->params[node_idx].parameter_values[parameter_idx]);
+
+  /// scalar (bool/int/double) results land here instead of the heap, so
+  /// appending to a typed sequence does not allocate per element
+  union {
+    bool b;
+    int64_t i;
+    double d;
+  } scalar_storage;
+  ret_val = get_value(value, style, &val_type, &scalar_storage, allocator);
+  if (NULL == ret_val) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Error parsing value %s at line %d", value, line_num);
+    return RCL_RET_ERROR;
+  }
+
+  switch (val_type) {
+    case DATA_TYPE_UNKNOWN:
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Unknown data type of value %s at line %d\n", value, line_num);
+      res = RCL_RET_ERROR;
+      break;
+    case DATA_TYPE_BOOL:
+      if (false == is_seq) {
+        param_value->bool_value =
+          allocator.zero_allocate(1U, sizeof(bool), allocator.state);
+        if (NULL == param_value->bool_value) {
+          RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+          return RCL_RET_BAD_ALLOC;
+        }
+        *(param_value->bool_value) = *((bool *)ret_val);
+      } else {
+        if (DATA_TYPE_UNKNOWN == *seq_data_type) {
+          *seq_data_type = val_type;
+          param_value->bool_array_value =
+            allocator.zero_allocate(1U, sizeof(rcl_bool_array_t), allocator.state);
+          if (NULL == param_value->bool_array_value) {
+            RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+            return RCL_RET_BAD_ALLOC;
+          }
+        } else {
+          if (*seq_data_type != val_type) {
+            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+              "Sequence should be of same type. Value type 'bool' do not belong at line_num %d",
+              line_num);
+            return RCL_RET_ERROR;
+          }
+        }
+        res = add_val_to_bool_arr(param_value->bool_array_value, ret_val, allocator);
+        if (RCL_RET_OK != res) {
+          return res;
+        }
+      }
+      break;
+    case DATA_TYPE_INT64:
+      if (false == is_seq) {
+        param_value->integer_value =
+          allocator.zero_allocate(1U, sizeof(int64_t), allocator.state);
+        if (NULL == param_value->integer_value) {
+          RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+          return RCL_RET_BAD_ALLOC;
+        }
+        *(param_value->integer_value) = *((int64_t *)ret_val);
+      } else {
+        if (DATA_TYPE_UNKNOWN == *seq_data_type) {
+          *seq_data_type = val_type;
+          param_value->integer_array_value =
+            allocator.zero_allocate(1U, sizeof(rcl_int64_array_t), allocator.state);
+          if (NULL == param_value->integer_array_value) {
+            RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+            return RCL_RET_BAD_ALLOC;
+          }
+        } else {
+          if (*seq_data_type != val_type) {
+            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+              "Sequence should be of same type. Value type 'integer' do not belong at line_num %d",
+              line_num);
+            return RCL_RET_ERROR;
+          }
+        }
+        res = add_val_to_int_arr(param_value->integer_array_value, ret_val, allocator);
+        if (RCL_RET_OK != res) {
+          return res;
+        }
+      }
+      break;
+    case DATA_TYPE_DOUBLE:
+      if (false == is_seq) {
+        param_value->double_value =
+          allocator.zero_allocate(1U, sizeof(double), allocator.state);
+        if (NULL == param_value->double_value) {
+          RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+          return RCL_RET_BAD_ALLOC;
+        }
+        *(param_value->double_value) = *((double *)ret_val);
       } else {
         if (DATA_TYPE_UNKNOWN == *seq_data_type) {
           *seq_data_type = val_type;
@@ -956,22 +1776,23 @@ static rcl_ret_t parse_value(
             RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
               "Sequence should be of same type. Value type 'double' do not belong at line_num %d",
               line_num);
-            allocator.deallocate(ret_val, allocator.state);
             return RCL_RET_ERROR;
           }
         }
         res = add_val_to_double_arr(param_value->double_array_value, ret_val, allocator);
         if (RCL_RET_OK != res) {
-          if (NULL != ret_val) {
-            allocator.deallocate(ret_val, allocator.state);
-          }
           return res;
         }
       }
       break;
     case DATA_TYPE_STRING:
       if (false == is_seq) {
-        param_value->string_value = (char *)ret_val;
+        param_value->string_value = intern_string(params_st, (char *)ret_val);
+        allocator.deallocate(ret_val, allocator.state);
+        if (NULL == param_value->string_value) {
+          RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+          return RCL_RET_BAD_ALLOC;
+        }
       } else {
         if (DATA_TYPE_UNKNOWN == *seq_data_type) {
           *seq_data_type = val_type;
@@ -1002,398 +1823,1917 @@ static rcl_ret_t parse_value(
         }
       }
       break;
-    default:
-      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-        "Unknown data type of value %s at line %d", value, line_num);
-      res = RCL_RET_ERROR;
+    default:
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Unknown data type of value %s at line %d", value, line_num);
+      res = RCL_RET_ERROR;
+      break;
+  }
+  return res;
+}
+
+///
+/// Parse the key part of the <key:value> pair
+///
+static rcl_ret_t parse_key(
+  const yaml_event_t event,
+  uint32_t * map_level,
+  bool * is_new_map,
+  namespace_tracker_t * ns_tracker,
+  rcl_params_t * params_st)
+{
+  int32_t res = RCL_RET_OK;
+  const size_t val_size = event.data.scalar.length;
+  const char * value = (char *)event.data.scalar.value;
+  const uint32_t line_num = ((uint32_t)(event.start_mark.line) + 1U);
+  size_t num_nodes;
+  size_t node_idx = 0U;
+  rcl_allocator_t allocator;
+
+  if ((NULL == map_level) || (NULL == params_st)) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  allocator = params_st->allocator;
+
+  if (val_size > MAX_STRING_SIZE) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Scalar value at line %d is bigger than %d bytes",
+      line_num, MAX_STRING_SIZE);
+    return RCL_RET_ERROR;
+  } else {
+    if (0U == val_size) {
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("No key at line %d", line_num);
+      return RCL_RET_ERROR;
+    }
+  }
+
+  if (NULL == value) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  num_nodes = params_st->num_nodes;  // New node index
+  if (num_nodes > 0U) {
+    node_idx = (num_nodes - 1U);  // Current node index
+  }
+
+  switch (*map_level) {
+    case MAP_UNINIT_LVL:
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Unintialized map level at line %d", line_num);
+      res = RCL_RET_ERROR;
+      break;
+    case MAP_NODE_NAME_LVL:
+      {
+        /// Till we get PARAMS_KEY, keep adding to node namespace
+        if (0 != strncmp(PARAMS_KEY, value, strlen(PARAMS_KEY))) {
+          res = add_name_to_ns(ns_tracker, value, NS_TYPE_NODE, allocator);
+          if (RCL_RET_OK != res) {
+            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+              "Internal error adding node namespace at line %d", line_num);
+            return res;
+          }
+        } else {
+          if (0U == ns_tracker->num_node_ns) {
+            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+              "There are no node names before %s at line %d", PARAMS_KEY, line_num);
+            return RCL_RET_ERROR;
+          }
+          /// The previous key(last name in namespace) was the node name. Remove it
+          /// from the namespace
+          char * node_name_ns = intern_string(params_st, ns_tracker->node_ns);
+          if (NULL == node_name_ns) {
+            return RCL_RET_BAD_ALLOC;
+          }
+          res = ensure_array_capacity((void **)&(params_st->node_names), sizeof(char *),
+              (num_nodes + 1U), allocator);
+          if (RCL_RET_OK == res) {
+            res = ensure_array_capacity((void **)&(params_st->params),
+                sizeof(rcl_node_params_t), (num_nodes + 1U), allocator);
+          }
+          if (RCL_RET_OK != res) {
+            return res;
+          }
+          params_st->node_names[num_nodes] = node_name_ns;
+
+          res = rem_name_from_ns(ns_tracker, NS_TYPE_NODE, allocator);
+          if (RCL_RET_OK != res) {
+            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+              "Internal error adding node namespace at line %d", line_num);
+            return res;
+          }
+          res = node_params_init(&(params_st->params[num_nodes]), allocator);
+          if (RCL_RET_OK != res) {
+            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+              "Error creating node parameter at line %d", line_num);
+            return RCL_RET_ERROR;
+          }
+          params_st->num_nodes++;
+          /// Bump the map level to PARAMS
+          (*map_level)++;
+        }
+      }
+      break;
+    case MAP_PARAMS_LVL:
+      {
+        char * parameter_ns;
+        size_t parameter_idx;
+        char * param_name;
+
+        /// If it is a new map, the previous key is param namespace
+        if (true == *is_new_map) {
+          params_st->params[node_idx].num_params--;
+          parameter_idx = params_st->params[node_idx].num_params;
+          parameter_ns = params_st->params[node_idx].parameter_names[parameter_idx];
+          if (NULL == parameter_ns) {
+            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+              "Internal error creating param namespace at line %d", line_num);
+            return RCL_RET_ERROR;
+          }
+          /// The tracker owns and reshapes its namespace string, so hand it
+          /// a private copy rather than the interned name
+          parameter_ns = rcutils_strdup(parameter_ns, allocator);
+          if (NULL == parameter_ns) {
+            return RCL_RET_BAD_ALLOC;
+          }
+          res = replace_ns(ns_tracker, parameter_ns, (ns_tracker->num_parameter_ns + 1U),
+              NS_TYPE_PARAM, allocator);
+          if (RCL_RET_OK != res) {
+            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+              "Internal error replacing namespace at line %d", line_num);
+            return RCL_RET_ERROR;
+          }
+          *is_new_map = false;
+        }
+        /// Add a parameter name into the node parameters
+        parameter_idx = params_st->params[node_idx].num_params;
+        parameter_ns = ns_tracker->parameter_ns;
+        if (NULL == parameter_ns) {
+          param_name = intern_string(params_st, value);
+          if (NULL == param_name) {
+            return RCL_RET_BAD_ALLOC;
+          }
+        } else {
+          char param_name_buf[MAX_STRING_SIZE + 1U];
+          const size_t params_ns_len = strlen(parameter_ns);
+          const size_t param_name_len = strlen(value);
+          const size_t tot_len = (params_ns_len + param_name_len + 2U);
+
+          if (tot_len > MAX_STRING_SIZE) {
+            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+              "The name length exceeds the MAX size %d at line %d", MAX_STRING_SIZE, line_num);
+            return RCL_RET_OK;
+          }
+
+          memmove(param_name_buf, parameter_ns, params_ns_len);
+          param_name_buf[params_ns_len] = '.';
+          memmove((param_name_buf + params_ns_len + 1U), value, param_name_len);
+          param_name_buf[tot_len - 1U] = '\0';
+          param_name = intern_string(params_st, param_name_buf);
+          if (NULL == param_name) {
+            return RCL_RET_BAD_ALLOC;
+          }
+        }
+        res = ensure_array_capacity((void **)&(params_st->params[node_idx].parameter_names),
+            sizeof(char *), (parameter_idx + 1U), allocator);
+        if (RCL_RET_OK == res) {
+          res = ensure_array_capacity((void **)&(params_st->params[node_idx].parameter_values),
+              sizeof(rcl_variant_t), (parameter_idx + 1U), allocator);
+        }
+        if (RCL_RET_OK != res) {
+          return res;
+        }
+        params_st->params[node_idx].parameter_names[parameter_idx] = param_name;
+        params_st->params[node_idx].num_params++;
+      }
+      break;
+    default:
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Unknown map level at line %d", line_num);
+      res = RCL_RET_ERROR;
+      break;
+  }
+  return res;
+}
+
+///
+/// Consume the events of the value that is about to start, without
+/// materializing anything from it
+///
+static rcl_ret_t skip_subtree(
+  yaml_parser_t * parser)
+{
+  yaml_event_t event;
+  uint32_t depth = 0U;
+
+  do {
+    if (0 == yaml_parser_parse(parser, &event)) {
+      RCL_SET_ERROR_MSG("Error parsing an event while skipping a node section");
+      return RCL_RET_ERROR;
+    }
+    switch (event.type) {
+      case YAML_MAPPING_START_EVENT:
+      case YAML_SEQUENCE_START_EVENT:
+        depth++;
+        break;
+      case YAML_MAPPING_END_EVENT:
+      case YAML_SEQUENCE_END_EVENT:
+        depth--;
+        break;
+      case YAML_STREAM_END_EVENT:
+      case YAML_NO_EVENT:
+        RCL_SET_ERROR_MSG("Unexpected end of stream while skipping a node section");
+        yaml_event_delete(&event);
+        return RCL_RET_ERROR;
+      default:
+        break;
+    }
+    yaml_event_delete(&event);
+  } while (depth > 0U);
+  return RCL_RET_OK;
+}
+
+///
+/// Get events from the parser and process the events
+/// If node_fqn is not NULL, only the sections of the matching node are
+/// materialized; other nodes' sections are skipped at the event level
+///
+static rcl_ret_t parse_events(
+  yaml_parser_t * parser,
+  const char * node_fqn,
+  namespace_tracker_t * ns_tracker,
+  rcl_params_t * params_st)
+{
+  int32_t done_parsing = 0;
+  yaml_event_t event;
+  rcl_ret_t res = RCL_RET_OK;
+  bool is_key = true;
+  bool is_seq = false;
+  uint32_t line_num = 0;
+  data_types_t seq_data_type = DATA_TYPE_UNKNOWN;
+  uint32_t map_level = 1U;
+  uint32_t map_depth = 0U;
+  bool is_new_map = false;
+  rcl_allocator_t allocator;
+
+  if ((NULL == parser) || (NULL == params_st)) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  allocator = params_st->allocator;
+
+  while (0 == done_parsing) {
+    if (RCL_RET_OK != res) {
+      return res;
+    }
+    res = yaml_parser_parse(parser, &event);
+    if (0 == res) {
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Error parsing a event near line %d", line_num);
+      return RCL_RET_ERROR;
+    } else {
+      res = RCL_RET_OK;
+    }
+    line_num = ((uint32_t)(event.start_mark.line) + 1U);
+    switch (event.type) {
+      case YAML_STREAM_END_EVENT:
+        done_parsing = 1;
+        yaml_event_delete(&event);
+        break;
+      case YAML_SCALAR_EVENT:
+        {
+          /// Need to toggle between key and value at params level
+          if (true == is_key) {
+            /// A section of some other node starts here: drop its name from
+            /// the namespace and skip the whole section without materializing
+            if ((NULL != node_fqn) && (MAP_NODE_NAME_LVL == map_level) &&
+              (NULL != ns_tracker->node_ns) &&
+              (0 == strncmp(PARAMS_KEY, (char *)event.data.scalar.value, strlen(PARAMS_KEY))) &&
+              (0 != strcmp(node_fqn, ns_tracker->node_ns)))
+            {
+              yaml_event_delete(&event);
+              res = rem_name_from_ns(ns_tracker, NS_TYPE_NODE, allocator);
+              if (RCL_RET_OK != res) {
+                RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                  "Internal error removing node namespace at line %d", line_num);
+                return res;
+              }
+              res = skip_subtree(parser);
+              if (RCL_RET_OK != res) {
+                return res;
+              }
+              break;
+            }
+            res = parse_key(event, &map_level, &is_new_map, ns_tracker,
+                params_st);
+            if (RCL_RET_OK != res) {
+              yaml_event_delete(&event);
+              return res;
+            }
+            is_key = false;
+          } else {
+            /// It is a value
+            if (map_level < (uint32_t)(MAP_PARAMS_LVL)) {
+              RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                "Cannot have a value before %s at line %d", PARAMS_KEY, line_num);
+              yaml_event_delete(&event);
+              return RCL_RET_ERROR;
+            }
+            res = parse_value(event, is_seq, &seq_data_type, params_st);
+            if (RCL_RET_OK != res) {
+              yaml_event_delete(&event);
+              return res;
+            }
+            if (false == is_seq) {
+              is_key = true;
+            }
+          }
+        }
+        yaml_event_delete(&event);
+        break;
+      case YAML_SEQUENCE_START_EVENT:
+        if (true == is_key) {
+          RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Sequences cannot be key at line %d", line_num);
+          yaml_event_delete(&event);
+          return RCL_RET_ERROR;
+        }
+        if (map_level < (uint32_t)(MAP_PARAMS_LVL)) {
+          RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+            "Sequences can only be values and not keys in params. Error at line %d\n", line_num);
+          yaml_event_delete(&event);
+          return RCL_RET_ERROR;
+        }
+        is_seq = true;
+        seq_data_type = DATA_TYPE_UNKNOWN;
+        yaml_event_delete(&event);
+        break;
+      case YAML_SEQUENCE_END_EVENT:
+        is_seq = false;
+        is_key = true;
+        yaml_event_delete(&event);
+        break;
+      case YAML_MAPPING_START_EVENT:
+        map_depth++;
+        is_new_map = true;
+        is_key = true;
+        /// Disable new map if it is PARAMS_KEY map
+        if ((MAP_PARAMS_LVL == map_level) &&
+          ((map_depth - (ns_tracker->num_node_ns + 1U)) == 2U))
+        {
+          is_new_map = false;
+        }
+        yaml_event_delete(&event);
+        break;
+      case YAML_MAPPING_END_EVENT:
+        if (MAP_PARAMS_LVL == map_level) {
+          if (ns_tracker->num_parameter_ns > 0U) {
+            /// Remove param namesapce
+            res = rem_name_from_ns(ns_tracker, NS_TYPE_PARAM, allocator);
+            if (RCL_RET_OK != res) {
+              RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                "Internal error removing parameter namespace at line %d", line_num);
+              yaml_event_delete(&event);
+              return res;
+            }
+          } else {
+            map_level--;
+          }
+        } else {
+          if ((MAP_NODE_NAME_LVL == map_level) &&
+            (map_depth == (ns_tracker->num_node_ns + 1U)))
+          {
+            /// Remove node namespace
+            res = rem_name_from_ns(ns_tracker, NS_TYPE_NODE, allocator);
+            if (RCL_RET_OK != res) {
+              RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                "Internal error removing node namespace at line %d", line_num);
+              yaml_event_delete(&event);
+              return res;
+            }
+          }
+        }
+        map_depth--;
+        yaml_event_delete(&event);
+        break;
+      case YAML_ALIAS_EVENT:
+        RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "Will not support aliasing at line %d\n", line_num);
+        res = RCL_RET_ERROR;
+        yaml_event_delete(&event);
+        break;
+      case YAML_STREAM_START_EVENT:
+        yaml_event_delete(&event);
+        break;
+      case YAML_DOCUMENT_START_EVENT:
+        yaml_event_delete(&event);
+        break;
+      case YAML_DOCUMENT_END_EVENT:
+        yaml_event_delete(&event);
+        break;
+      case YAML_NO_EVENT:
+        RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "Received an empty event at line %d", line_num);
+        res = RCL_RET_ERROR;
+        yaml_event_delete(&event);
+        break;
+      default:
+        RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Unknown YAML event at line %d", line_num);
+        res = RCL_RET_ERROR;
+        yaml_event_delete(&event);
+        break;
+    }
+  }
+  return res;
+}
+
+///
+/// Run the event stream through the structural checks of parse_events()
+/// without building anything: no parameter structure, no namespace strings,
+/// no values. Only the namespace depths are tracked, which is all the
+/// structural rules need
+///
+static rcl_ret_t validate_events(
+  yaml_parser_t * parser)
+{
+  int32_t done_parsing = 0;
+  yaml_event_t event;
+  rcl_ret_t res = RCL_RET_OK;
+  bool is_key = true;
+  bool is_seq = false;
+  uint32_t line_num = 0;
+  data_types_t seq_data_type = DATA_TYPE_UNKNOWN;
+  uint32_t map_level = 1U;
+  uint32_t map_depth = 0U;
+  bool is_new_map = false;
+  uint32_t num_node_ns = 0U;
+  uint32_t num_parameter_ns = 0U;
+
+  if (NULL == parser) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  while (0 == done_parsing) {
+    if (RCL_RET_OK != res) {
+      return res;
+    }
+    res = yaml_parser_parse(parser, &event);
+    if (0 == res) {
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Error parsing a event near line %d", line_num);
+      return RCL_RET_ERROR;
+    } else {
+      res = RCL_RET_OK;
+    }
+    line_num = ((uint32_t)(event.start_mark.line) + 1U);
+    switch (event.type) {
+      case YAML_STREAM_END_EVENT:
+        done_parsing = 1;
+        yaml_event_delete(&event);
+        break;
+      case YAML_SCALAR_EVENT:
+        {
+          const size_t val_size = event.data.scalar.length;
+          const char * value = (char *)event.data.scalar.value;
+          const yaml_scalar_style_t style = event.data.scalar.style;
+
+          if (val_size > MAX_STRING_SIZE) {
+            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+              "Scalar value at line %d is bigger than %d bytes", line_num, MAX_STRING_SIZE);
+            yaml_event_delete(&event);
+            return RCL_RET_ERROR;
+          }
+          if ((0U == val_size) || (NULL == value)) {
+            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+              is_key ? "No key at line %d" : "No value at line %d", line_num);
+            yaml_event_delete(&event);
+            return RCL_RET_ERROR;
+          }
+          if (true == is_key) {
+            switch (map_level) {
+              case MAP_UNINIT_LVL:
+                RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                  "Unintialized map level at line %d", line_num);
+                res = RCL_RET_ERROR;
+                break;
+              case MAP_NODE_NAME_LVL:
+                if (0 != strncmp(PARAMS_KEY, value, strlen(PARAMS_KEY))) {
+                  num_node_ns++;
+                } else {
+                  if (0U == num_node_ns) {
+                    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                      "There are no node names before %s at line %d", PARAMS_KEY, line_num);
+                    res = RCL_RET_ERROR;
+                    break;
+                  }
+                  /// The previous key was the node name, not a namespace
+                  num_node_ns--;
+                  map_level++;
+                }
+                break;
+              case MAP_PARAMS_LVL:
+                /// If it is a new map, the previous key is param namespace
+                if (true == is_new_map) {
+                  num_parameter_ns++;
+                  is_new_map = false;
+                }
+                break;
+              default:
+                RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Unknown map level at line %d", line_num);
+                res = RCL_RET_ERROR;
+                break;
+            }
+            if (RCL_RET_OK != res) {
+              yaml_event_delete(&event);
+              return res;
+            }
+            is_key = false;
+          } else {
+            if (map_level < (uint32_t)(MAP_PARAMS_LVL)) {
+              RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                "Cannot have a value before %s at line %d", PARAMS_KEY, line_num);
+              yaml_event_delete(&event);
+              return RCL_RET_ERROR;
+            }
+            const data_types_t val_type = scalar_data_type(value, style);
+            if (true == is_seq) {
+              if (DATA_TYPE_UNKNOWN == seq_data_type) {
+                seq_data_type = val_type;
+              } else if (seq_data_type != val_type) {
+                RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                  "Sequence should be of same type. Error at line_num %d", line_num);
+                yaml_event_delete(&event);
+                return RCL_RET_ERROR;
+              }
+            } else {
+              is_key = true;
+            }
+          }
+        }
+        yaml_event_delete(&event);
+        break;
+      case YAML_SEQUENCE_START_EVENT:
+        if (true == is_key) {
+          RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Sequences cannot be key at line %d", line_num);
+          yaml_event_delete(&event);
+          return RCL_RET_ERROR;
+        }
+        if (map_level < (uint32_t)(MAP_PARAMS_LVL)) {
+          RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+            "Sequences can only be values and not keys in params. Error at line %d\n", line_num);
+          yaml_event_delete(&event);
+          return RCL_RET_ERROR;
+        }
+        is_seq = true;
+        seq_data_type = DATA_TYPE_UNKNOWN;
+        yaml_event_delete(&event);
+        break;
+      case YAML_SEQUENCE_END_EVENT:
+        is_seq = false;
+        is_key = true;
+        yaml_event_delete(&event);
+        break;
+      case YAML_MAPPING_START_EVENT:
+        map_depth++;
+        is_new_map = true;
+        is_key = true;
+        /// Disable new map if it is PARAMS_KEY map
+        if ((MAP_PARAMS_LVL == map_level) &&
+          ((map_depth - (num_node_ns + 1U)) == 2U))
+        {
+          is_new_map = false;
+        }
+        yaml_event_delete(&event);
+        break;
+      case YAML_MAPPING_END_EVENT:
+        if (MAP_PARAMS_LVL == map_level) {
+          if (num_parameter_ns > 0U) {
+            num_parameter_ns--;
+          } else {
+            map_level--;
+          }
+        } else {
+          if ((MAP_NODE_NAME_LVL == map_level) &&
+            (map_depth == (num_node_ns + 1U)) &&
+            (num_node_ns > 0U))
+          {
+            num_node_ns--;
+          }
+        }
+        map_depth--;
+        yaml_event_delete(&event);
+        break;
+      case YAML_ALIAS_EVENT:
+        RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "Will not support aliasing at line %d\n", line_num);
+        res = RCL_RET_ERROR;
+        yaml_event_delete(&event);
+        break;
+      case YAML_STREAM_START_EVENT:
+        yaml_event_delete(&event);
+        break;
+      case YAML_DOCUMENT_START_EVENT:
+        yaml_event_delete(&event);
+        break;
+      case YAML_DOCUMENT_END_EVENT:
+        yaml_event_delete(&event);
+        break;
+      case YAML_NO_EVENT:
+        RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "Received an empty event at line %d", line_num);
+        res = RCL_RET_ERROR;
+        yaml_event_delete(&event);
+        break;
+      default:
+        RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Unknown YAML event at line %d", line_num);
+        res = RCL_RET_ERROR;
+        yaml_event_delete(&event);
+        break;
+    }
+  }
+  return res;
+}
+
+/// The resources backing a libyaml file input
+typedef struct yaml_file_input_s
+{
+  FILE * file;
+#ifndef _WIN32
+  unsigned char * mapped;
+  size_t mapped_size;
+  int fd;
+#endif
+} yaml_file_input_t;
+
+///
+/// Point the parser at the file
+/// Feed the scanner straight from a memory mapping of the file when
+/// possible; this avoids the read() syscalls and stdio copying of the
+/// buffered path, which add up when loading many files from slow media.
+/// Scalars still get copied out of the parser events into final storage,
+/// so nothing references the mapping after the parse
+///
+static bool yaml_file_input_open(
+  const char * file_path,
+  yaml_parser_t * parser,
+  yaml_file_input_t * input)
+{
+  memset(input, 0, sizeof(yaml_file_input_t));
+#ifndef _WIN32
+  input->fd = open(file_path, O_RDONLY);
+  if (-1 != input->fd) {
+    struct stat file_info;
+    if (0 == fstat(input->fd, &file_info) && file_info.st_size > 0) {
+      void * addr = mmap(NULL, (size_t)file_info.st_size, PROT_READ, MAP_PRIVATE, input->fd, 0);
+      if (MAP_FAILED != addr) {
+        input->mapped = (unsigned char *)addr;
+        input->mapped_size = (size_t)file_info.st_size;
+      }
+    }
+    if (NULL == input->mapped) {
+      close(input->fd);
+      input->fd = -1;
+    }
+  }
+  if (NULL != input->mapped) {
+    yaml_parser_set_input_string(parser, input->mapped, input->mapped_size);
+    return true;
+  }
+#endif
+  input->file = fopen(file_path, "r");
+  if (NULL == input->file) {
+    RCL_SET_ERROR_MSG("Error opening YAML file");
+    return false;
+  }
+  yaml_parser_set_input_file(parser, input->file);
+  return true;
+}
+
+///
+/// Release whatever yaml_file_input_open() acquired
+///
+static void yaml_file_input_close(
+  yaml_file_input_t * input)
+{
+#ifndef _WIN32
+  if (NULL != input->mapped) {
+    munmap(input->mapped, input->mapped_size);
+    close(input->fd);
+    input->mapped = NULL;
+  }
+#endif
+  if (NULL != input->file) {
+    fclose(input->file);
+    input->file = NULL;
+  }
+}
+
+///
+/// TODO (anup.pemmaiah): Support string yaml similar to yaml file
+/// TODO (anup.pemmaiah): Support Mutiple yaml files
+///
+///
+/// Parse the YAML file and populate params_st, optionally for a single node
+///
+static bool parse_yaml_file_impl(
+  const char * file_path,
+  const char * node_fqn,
+  rcl_params_t * params_st)
+{
+  int32_t res;
+  yaml_parser_t parser;
+  yaml_file_input_t input;
+  namespace_tracker_t ns_tracker;
+  rcutils_allocator_t allocator;
+
+  if (NULL == params_st) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Pass a initialized paramter structure");
+    return false;
+  }
+  allocator = params_st->allocator;
+
+  if (NULL == file_path) {
+    RCL_SET_ERROR_MSG("YAML file path is NULL");
+    return false;
+  }
+
+  /// parsing mutates params_st in place, so detach it from any copies first
+  if (RCL_RET_OK != params_struct_ensure_owned(params_st)) {
+    RCL_SET_ERROR_MSG("Failed to detach shared parameter struct");
+    return false;
+  }
+
+  res = yaml_parser_initialize(&parser);
+  if (0 == res) {
+    RCL_SET_ERROR_MSG("Could not initialize the parser");
+    return false;
+  }
+  if (!yaml_file_input_open(file_path, &parser, &input)) {
+    yaml_parser_delete(&parser);
+    return false;
+  }
+
+  memset(&ns_tracker, 0, sizeof(namespace_tracker_t));
+  res = parse_events(&parser, node_fqn, &ns_tracker, params_st);
+
+  yaml_parser_delete(&parser);
+  yaml_file_input_close(&input);
+
+  if (RCL_RET_OK != res) {
+    if (NULL != ns_tracker.node_ns) {
+      allocator.deallocate(ns_tracker.node_ns, allocator.state);
+    }
+    if (NULL != ns_tracker.parameter_ns) {
+      allocator.deallocate(ns_tracker.parameter_ns, allocator.state);
+    }
+    rcl_yaml_node_struct_fini(params_st);
+    return false;
+  }
+
+  return true;
+}
+
+///
+/// Parse the YAML file and populate params_st
+///
+bool rcl_parse_yaml_file(
+  const char * file_path,
+  rcl_params_t * params_st)
+{
+  return parse_yaml_file_impl(file_path, NULL, params_st);
+}
+
+///
+/// Parse several YAML files into params_st in order
+///
+bool rcl_parse_yaml_files(
+  const char * const * file_paths,
+  const size_t num_files,
+  rcl_params_t * params_st)
+{
+  size_t file_idx;
+
+  if (NULL == params_st) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Pass a initialized paramter structure");
+    return false;
+  }
+  if ((NULL == file_paths) && (num_files > 0U)) {
+    RCL_SET_ERROR_MSG("YAML file path list is NULL");
+    return false;
+  }
+  for (file_idx = 0U; file_idx < num_files; file_idx++) {
+    if (!rcl_parse_yaml_file(file_paths[file_idx], params_st)) {
+      /// params_st has already been freed; the error message names the file
+      return false;
+    }
+  }
+  return true;
+}
+
+///
+/// Parse the YAML file and populate params_st with one node's parameters only
+///
+bool rcl_parse_yaml_file_for_node(
+  const char * file_path,
+  const char * node_fqn,
+  rcl_params_t * params_st)
+{
+  if (NULL == node_fqn) {
+    RCL_SET_ERROR_MSG("Node name is NULL");
+    return false;
+  }
+  return parse_yaml_file_impl(file_path, node_fqn, params_st);
+}
+
+///
+/// Validate the YAML file without building a parameter structure
+///
+bool rcl_validate_yaml_file(
+  const char * file_path)
+{
+  int32_t res;
+  yaml_parser_t parser;
+  yaml_file_input_t input;
+
+  if (NULL == file_path) {
+    RCL_SET_ERROR_MSG("YAML file path is NULL");
+    return false;
+  }
+  res = yaml_parser_initialize(&parser);
+  if (0 == res) {
+    RCL_SET_ERROR_MSG("Could not initialize the parser");
+    return false;
+  }
+  if (!yaml_file_input_open(file_path, &parser, &input)) {
+    yaml_parser_delete(&parser);
+    return false;
+  }
+
+  res = validate_events(&parser);
+
+  yaml_parser_delete(&parser);
+  yaml_file_input_close(&input);
+  return RCL_RET_OK == res;
+}
+
+///
+/// Reparse the YAML file into an existing structure, touching only what changed
+///
+bool rcl_parse_yaml_file_update(
+  const char * file_path,
+  rcl_params_t * params_st,
+  rcl_params_t * changes_st)
+{
+  rcl_params_t * staging;
+  size_t node_idx;
+  size_t parameter_idx;
+  bool update_ok = true;
+  rcl_allocator_t allocator;
+
+  if (NULL == params_st) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Pass a initialized paramter structure");
+    return false;
+  }
+  allocator = params_st->allocator;
+
+  staging = rcl_yaml_node_struct_init(allocator);
+  if (NULL == staging) {
+    return false;
+  }
+  if (!rcl_parse_yaml_file(file_path, staging)) {
+    /// staging has already been freed; the error message names the file
+    return false;
+  }
+  if (RCL_RET_OK != params_struct_ensure_owned(params_st)) {
+    RCL_SET_ERROR_MSG("Failed to detach shared parameter struct");
+    rcl_yaml_node_struct_fini(staging);
+    return false;
+  }
+
+  for (node_idx = 0U; update_ok && (node_idx < staging->num_nodes); node_idx++) {
+    const rcl_node_params_t * new_params = &(staging->params[node_idx]);
+    const char * node_name = staging->node_names[node_idx];
+    rcl_node_params_t * node_params;
+
+    update_ok =
+      (RCL_RET_OK == params_find_or_append_node(params_st, node_name, &node_params));
+    for (parameter_idx = 0U; update_ok && (parameter_idx < new_params->num_params);
+      parameter_idx++)
+    {
+      const char * param_name = new_params->parameter_names[parameter_idx];
+      const rcl_variant_t * new_value = &(new_params->parameter_values[parameter_idx]);
+      bool changed = false;
+
+      update_ok = (RCL_RET_OK == update_node_parameter(params_st, node_params,
+          param_name, new_value, &changed));
+      if (update_ok && changed && (NULL != changes_st)) {
+        rcl_node_params_t * changed_params;
+
+        update_ok = (RCL_RET_OK ==
+          params_find_or_append_node(changes_st, node_name, &changed_params));
+        if (update_ok) {
+          update_ok = (RCL_RET_OK == update_node_parameter(changes_st, changed_params,
+              param_name, new_value, &changed));
+        }
+      }
+    }
+  }
+  rcl_yaml_node_struct_fini(staging);
+
+  if (!update_ok) {
+    RCL_SET_ERROR_MSG("Error updating parameter structure");
+    return false;
+  }
+  return true;
+}
+
+/// Binary parameter cache written next to the YAML file.
+/// The header pins the format version and the size and modification time of
+/// the YAML file it was built from; a mismatch on any of them makes the
+/// cache stale and the YAML file is parsed again.
+#define CACHE_FILE_SUFFIX ".pcache"
+#define CACHE_MAGIC 0x52505043U
+#define CACHE_VERSION 1U
+
+typedef struct cache_header_s
+{
+  uint32_t magic;
+  uint32_t version;
+  int64_t yaml_mtime;
+  int64_t yaml_size;
+  uint64_t num_nodes;
+} cache_header_t;
+
+/// Tag identifying which member of rcl_variant_t a cached value belongs to
+typedef enum cache_value_tag_e
+{
+  CACHE_VALUE_BOOL = 1U,
+  CACHE_VALUE_INT64 = 2U,
+  CACHE_VALUE_DOUBLE = 3U,
+  CACHE_VALUE_STRING = 4U,
+  CACHE_VALUE_BOOL_ARRAY = 5U,
+  CACHE_VALUE_INT64_ARRAY = 6U,
+  CACHE_VALUE_DOUBLE_ARRAY = 7U,
+  CACHE_VALUE_STRING_ARRAY = 8U
+} cache_value_tag_t;
+
+///
+/// Write a length prefixed string to the cache file
+///
+static bool cache_write_string(FILE * cache_file, const char * str)
+{
+  uint64_t len = (uint64_t)strlen(str);
+
+  if (1U != fwrite(&len, sizeof(len), 1U, cache_file)) {
+    return false;
+  }
+  if ((len > 0U) && (len != fwrite(str, 1U, len, cache_file))) {
+    return false;
+  }
+  return true;
+}
+
+///
+/// Read a length prefixed string from the cache file
+/// The parser caps every stored string at MAX_STRING_SIZE, so a longer
+/// length means the cache is corrupt
+///
+static char * cache_read_string(FILE * cache_file, const rcl_allocator_t allocator)
+{
+  uint64_t len;
+  char * str;
+
+  if (1U != fread(&len, sizeof(len), 1U, cache_file)) {
+    return NULL;
+  }
+  if (len > MAX_STRING_SIZE) {
+    return NULL;
+  }
+  str = allocator.zero_allocate((len + 1U), sizeof(char), allocator.state);
+  if (NULL == str) {
+    return NULL;
+  }
+  if ((len > 0U) && (len != fread(str, 1U, len, cache_file))) {
+    allocator.deallocate(str, allocator.state);
+    return NULL;
+  }
+  return str;
+}
+
+///
+/// Read a length prefixed string from the cache file and intern it in the
+/// parameter structure's table
+///
+static char * cache_read_interned_string(FILE * cache_file, rcl_params_t * params_st)
+{
+  rcl_allocator_t allocator = params_st->allocator;
+  char * interned = NULL;
+  char * str = cache_read_string(cache_file, allocator);
+
+  if (NULL != str) {
+    interned = intern_string(params_st, str);
+    allocator.deallocate(str, allocator.state);
+  }
+  return interned;
+}
+
+///
+/// Write one parameter value to the cache file
+///
+static bool cache_write_value(FILE * cache_file, const rcl_variant_t * param_var)
+{
+  uint8_t tag;
+  uint64_t count;
+
+  if (NULL != param_var->bool_value) {
+    tag = CACHE_VALUE_BOOL;
+    return (1U == fwrite(&tag, sizeof(tag), 1U, cache_file)) &&
+           (1U == fwrite(param_var->bool_value, sizeof(bool), 1U, cache_file));
+  } else if (NULL != param_var->integer_value) {
+    tag = CACHE_VALUE_INT64;
+    return (1U == fwrite(&tag, sizeof(tag), 1U, cache_file)) &&
+           (1U == fwrite(param_var->integer_value, sizeof(int64_t), 1U, cache_file));
+  } else if (NULL != param_var->double_value) {
+    tag = CACHE_VALUE_DOUBLE;
+    return (1U == fwrite(&tag, sizeof(tag), 1U, cache_file)) &&
+           (1U == fwrite(param_var->double_value, sizeof(double), 1U, cache_file));
+  } else if (NULL != param_var->string_value) {
+    tag = CACHE_VALUE_STRING;
+    return (1U == fwrite(&tag, sizeof(tag), 1U, cache_file)) &&
+           cache_write_string(cache_file, param_var->string_value);
+  } else if (NULL != param_var->bool_array_value) {
+    tag = CACHE_VALUE_BOOL_ARRAY;
+    count = (uint64_t)param_var->bool_array_value->size;
+    return (1U == fwrite(&tag, sizeof(tag), 1U, cache_file)) &&
+           (1U == fwrite(&count, sizeof(count), 1U, cache_file)) &&
+           (count == fwrite(param_var->bool_array_value->values, sizeof(bool), count, cache_file));
+  } else if (NULL != param_var->integer_array_value) {
+    tag = CACHE_VALUE_INT64_ARRAY;
+    count = (uint64_t)param_var->integer_array_value->size;
+    return (1U == fwrite(&tag, sizeof(tag), 1U, cache_file)) &&
+           (1U == fwrite(&count, sizeof(count), 1U, cache_file)) &&
+           (count ==
+           fwrite(param_var->integer_array_value->values, sizeof(int64_t), count, cache_file));
+  } else if (NULL != param_var->double_array_value) {
+    tag = CACHE_VALUE_DOUBLE_ARRAY;
+    count = (uint64_t)param_var->double_array_value->size;
+    return (1U == fwrite(&tag, sizeof(tag), 1U, cache_file)) &&
+           (1U == fwrite(&count, sizeof(count), 1U, cache_file)) &&
+           (count ==
+           fwrite(param_var->double_array_value->values, sizeof(double), count, cache_file));
+  } else if (NULL != param_var->string_array_value) {
+    tag = CACHE_VALUE_STRING_ARRAY;
+    count = (uint64_t)param_var->string_array_value->size;
+    if ((1U != fwrite(&tag, sizeof(tag), 1U, cache_file)) ||
+      (1U != fwrite(&count, sizeof(count), 1U, cache_file)))
+    {
+      return false;
+    }
+    for (uint64_t idx = 0U; idx < count; idx++) {
+      if (!cache_write_string(cache_file, param_var->string_array_value->data[idx])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  /// A parameter without a value cannot come out of a successful parse
+  return false;
+}
+
+///
+/// Read one parameter value from the cache file into a zero initialized variant
+/// On failure the variant members stay consistent, so param_variant_fini()
+/// can release whatever was read
+///
+static bool cache_read_value(
+  FILE * cache_file,
+  rcl_variant_t * param_var,
+  rcl_params_t * params_st)
+{
+  uint8_t tag;
+  uint64_t count;
+  rcl_allocator_t allocator = params_st->allocator;
+
+  if (1U != fread(&tag, sizeof(tag), 1U, cache_file)) {
+    return false;
+  }
+  switch (tag) {
+    case CACHE_VALUE_BOOL:
+      param_var->bool_value = allocator.zero_allocate(1U, sizeof(bool), allocator.state);
+      return (NULL != param_var->bool_value) &&
+             (1U == fread(param_var->bool_value, sizeof(bool), 1U, cache_file));
+    case CACHE_VALUE_INT64:
+      param_var->integer_value = allocator.zero_allocate(1U, sizeof(int64_t), allocator.state);
+      return (NULL != param_var->integer_value) &&
+             (1U == fread(param_var->integer_value, sizeof(int64_t), 1U, cache_file));
+    case CACHE_VALUE_DOUBLE:
+      param_var->double_value = allocator.zero_allocate(1U, sizeof(double), allocator.state);
+      return (NULL != param_var->double_value) &&
+             (1U == fread(param_var->double_value, sizeof(double), 1U, cache_file));
+    case CACHE_VALUE_STRING:
+      param_var->string_value = cache_read_interned_string(cache_file, params_st);
+      return NULL != param_var->string_value;
+    case CACHE_VALUE_BOOL_ARRAY:
+      if (1U != fread(&count, sizeof(count), 1U, cache_file)) {
+        return false;
+      }
+      param_var->bool_array_value =
+        allocator.zero_allocate(1U, sizeof(rcl_bool_array_t), allocator.state);
+      if (NULL == param_var->bool_array_value) {
+        return false;
+      }
+      param_var->bool_array_value->values =
+        allocator.zero_allocate(count, sizeof(bool), allocator.state);
+      if (NULL == param_var->bool_array_value->values) {
+        return false;
+      }
+      param_var->bool_array_value->size = (size_t)count;
+      return count ==
+             fread(param_var->bool_array_value->values, sizeof(bool), count, cache_file);
+    case CACHE_VALUE_INT64_ARRAY:
+      if (1U != fread(&count, sizeof(count), 1U, cache_file)) {
+        return false;
+      }
+      param_var->integer_array_value =
+        allocator.zero_allocate(1U, sizeof(rcl_int64_array_t), allocator.state);
+      if (NULL == param_var->integer_array_value) {
+        return false;
+      }
+      param_var->integer_array_value->values =
+        allocator.zero_allocate(count, sizeof(int64_t), allocator.state);
+      if (NULL == param_var->integer_array_value->values) {
+        return false;
+      }
+      param_var->integer_array_value->size = (size_t)count;
+      return count ==
+             fread(param_var->integer_array_value->values, sizeof(int64_t), count, cache_file);
+    case CACHE_VALUE_DOUBLE_ARRAY:
+      if (1U != fread(&count, sizeof(count), 1U, cache_file)) {
+        return false;
+      }
+      param_var->double_array_value =
+        allocator.zero_allocate(1U, sizeof(rcl_double_array_t), allocator.state);
+      if (NULL == param_var->double_array_value) {
+        return false;
+      }
+      param_var->double_array_value->values =
+        allocator.zero_allocate(count, sizeof(double), allocator.state);
+      if (NULL == param_var->double_array_value->values) {
+        return false;
+      }
+      param_var->double_array_value->size = (size_t)count;
+      return count ==
+             fread(param_var->double_array_value->values, sizeof(double), count, cache_file);
+    case CACHE_VALUE_STRING_ARRAY:
+      if (1U != fread(&count, sizeof(count), 1U, cache_file)) {
+        return false;
+      }
+      param_var->string_array_value =
+        allocator.zero_allocate(1U, sizeof(rcutils_string_array_t), allocator.state);
+      if (NULL == param_var->string_array_value) {
+        return false;
+      }
+      param_var->string_array_value->allocator = allocator;
+      param_var->string_array_value->data =
+        allocator.zero_allocate(count, sizeof(char *), allocator.state);
+      if (NULL == param_var->string_array_value->data) {
+        return false;
+      }
+      param_var->string_array_value->size = (size_t)count;
+      for (uint64_t idx = 0U; idx < count; idx++) {
+        param_var->string_array_value->data[idx] = cache_read_string(cache_file, allocator);
+        if (NULL == param_var->string_array_value->data[idx]) {
+          return false;
+        }
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+///
+/// Serialize the nodes starting at first_node_idx into the cache file
+/// Written to a temporary file first and renamed into place, so readers
+/// never see a partially written cache
+///
+static bool save_params_cache(
+  const char * cache_path,
+  const cache_header_t * header,
+  const rcl_params_t * params_st,
+  const size_t first_node_idx)
+{
+  FILE * cache_file;
+  char * tmp_path;
+  size_t node_idx;
+  size_t parameter_idx;
+  bool write_ok = true;
+  rcl_allocator_t allocator = params_st->allocator;
+  const size_t tmp_path_len = (strlen(cache_path) + 5U);
+
+  tmp_path = allocator.zero_allocate(tmp_path_len, sizeof(char), allocator.state);
+  if (NULL == tmp_path) {
+    return false;
+  }
+  snprintf(tmp_path, tmp_path_len, "%s.tmp", cache_path);
+
+  cache_file = fopen(tmp_path, "wb");
+  if (NULL == cache_file) {
+    allocator.deallocate(tmp_path, allocator.state);
+    return false;
+  }
+
+  write_ok = (1U == fwrite(header, sizeof(cache_header_t), 1U, cache_file));
+  for (node_idx = first_node_idx; write_ok && (node_idx < params_st->num_nodes); node_idx++) {
+    const rcl_node_params_t * node_params = &(params_st->params[node_idx]);
+    const uint64_t num_params = (uint64_t)node_params->num_params;
+
+    write_ok = cache_write_string(cache_file, params_st->node_names[node_idx]) &&
+      (1U == fwrite(&num_params, sizeof(num_params), 1U, cache_file));
+    for (parameter_idx = 0U; write_ok && (parameter_idx < node_params->num_params);
+      parameter_idx++)
+    {
+      write_ok = cache_write_string(cache_file, node_params->parameter_names[parameter_idx]) &&
+        cache_write_value(cache_file, &(node_params->parameter_values[parameter_idx]));
+    }
+  }
+
+  if (0 != fclose(cache_file)) {
+    write_ok = false;
+  }
+  if (write_ok && (0 != rename(tmp_path, cache_path))) {
+    write_ok = false;
+  }
+  if (!write_ok) {
+    (void)remove(tmp_path);
+  }
+  allocator.deallocate(tmp_path, allocator.state);
+  return write_ok;
+}
+
+///
+/// Load the cached nodes into params_st
+/// On failure every node appended so far is rolled back, leaving params_st
+/// exactly as it was before the call
+///
+static bool load_params_cache(
+  FILE * cache_file,
+  const uint64_t num_nodes,
+  rcl_params_t * params_st)
+{
+  uint64_t node_idx;
+  uint64_t parameter_idx;
+  bool read_ok = true;
+  rcl_allocator_t allocator = params_st->allocator;
+  const size_t first_node_idx = params_st->num_nodes;
+
+  for (node_idx = 0U; read_ok && (node_idx < num_nodes); node_idx++) {
+    rcl_node_params_t * node_params;
+    uint64_t num_params;
+    char * node_name = cache_read_interned_string(cache_file, params_st);
+
+    if (NULL == node_name) {
+      read_ok = false;
+      break;
+    }
+    if ((RCL_RET_OK != ensure_array_capacity((void **)&(params_st->node_names), sizeof(char *),
+      (params_st->num_nodes + 1U), allocator)) ||
+      (RCL_RET_OK != ensure_array_capacity((void **)&(params_st->params),
+      sizeof(rcl_node_params_t), (params_st->num_nodes + 1U), allocator)))
+    {
+      read_ok = false;
+      break;
+    }
+    params_st->node_names[params_st->num_nodes] = node_name;
+    node_params = &(params_st->params[params_st->num_nodes]);
+    (void)node_params_init(node_params, allocator);
+    params_st->num_nodes++;
+
+    if (1U != fread(&num_params, sizeof(num_params), 1U, cache_file)) {
+      read_ok = false;
       break;
+    }
+    for (parameter_idx = 0U; read_ok && (parameter_idx < num_params); parameter_idx++) {
+      char * param_name = cache_read_interned_string(cache_file, params_st);
+      if (NULL == param_name) {
+        read_ok = false;
+        break;
+      }
+      if ((RCL_RET_OK != ensure_array_capacity((void **)&(node_params->parameter_names),
+        sizeof(char *), (node_params->num_params + 1U), allocator)) ||
+        (RCL_RET_OK != ensure_array_capacity((void **)&(node_params->parameter_values),
+        sizeof(rcl_variant_t), (node_params->num_params + 1U), allocator)))
+      {
+        read_ok = false;
+        break;
+      }
+      node_params->parameter_names[node_params->num_params] = param_name;
+      node_params->num_params++;
+      read_ok = cache_read_value(cache_file,
+          &(node_params->parameter_values[node_params->num_params - 1U]), params_st);
+    }
   }
-  return res;
+
+  if (!read_ok) {
+    /// Roll back the nodes appended from the cache; the interned names stay
+    /// in the table until the whole structure is freed
+    while (params_st->num_nodes > first_node_idx) {
+      params_st->num_nodes--;
+      params_st->node_names[params_st->num_nodes] = NULL;
+      node_params_fini(&(params_st->params[params_st->num_nodes]), allocator);
+    }
+  }
+  return read_ok;
 }
 
 ///
-/// Parse the key part of the <key:value> pair
+/// Parse the YAML file through a sidecar binary cache and populate params_st
 ///
-static rcl_ret_t parse_key(
-  const yaml_event_t event,
-  uint32_t * map_level,
-  bool * is_new_map,
-  namespace_tracker_t * ns_tracker,
+bool rcl_parse_yaml_file_cached(
+  const char * file_path,
   rcl_params_t * params_st)
 {
-  int32_t res = RCL_RET_OK;
-  const size_t val_size = event.data.scalar.length;
-  const char * value = (char *)event.data.scalar.value;
-  const uint32_t line_num = ((uint32_t)(event.start_mark.line) + 1U);
-  size_t num_nodes;
-  size_t node_idx = 0U;
+  FILE * cache_file;
+  char * cache_path;
+  cache_header_t header;
+  struct stat yaml_stat;
+  size_t cache_path_len;
+  size_t first_node_idx;
   rcl_allocator_t allocator;
 
-  if ((NULL == map_level) || (NULL == params_st)) {
-    return RCL_RET_INVALID_ARGUMENT;
+  if (NULL == params_st) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Pass a initialized paramter structure");
+    return false;
   }
   allocator = params_st->allocator;
 
-  if (val_size > MAX_STRING_SIZE) {
-    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-      "Scalar value at line %d is bigger than %d bytes",
-      line_num, MAX_STRING_SIZE);
-    return RCL_RET_ERROR;
-  } else {
-    if (0U == val_size) {
-      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("No key at line %d", line_num);
-      return RCL_RET_ERROR;
+  if (NULL == file_path) {
+    RCL_SET_ERROR_MSG("YAML file path is NULL");
+    return false;
+  }
+  if (0 != stat(file_path, &yaml_stat)) {
+    RCL_SET_ERROR_MSG("Error opening YAML file");
+    return false;
+  }
+
+  cache_path_len = (strlen(file_path) + strlen(CACHE_FILE_SUFFIX) + 1U);
+  cache_path = allocator.zero_allocate(cache_path_len, sizeof(char), allocator.state);
+  if (NULL == cache_path) {
+    /// No memory for the cache path; parse the file without the cache
+    return rcl_parse_yaml_file(file_path, params_st);
+  }
+  snprintf(cache_path, cache_path_len, "%s%s", file_path, CACHE_FILE_SUFFIX);
+
+  /// the cache loads straight into params_st, so detach it from any copies
+  if (RCL_RET_OK != params_struct_ensure_owned(params_st)) {
+    RCL_SET_ERROR_MSG("Failed to detach shared parameter struct");
+    allocator.deallocate(cache_path, allocator.state);
+    return false;
+  }
+
+  cache_file = fopen(cache_path, "rb");
+  if (NULL != cache_file) {
+    if ((1U == fread(&header, sizeof(header), 1U, cache_file)) &&
+      (CACHE_MAGIC == header.magic) &&
+      (CACHE_VERSION == header.version) &&
+      ((int64_t)yaml_stat.st_mtime == header.yaml_mtime) &&
+      ((int64_t)yaml_stat.st_size == header.yaml_size))
+    {
+      if (load_params_cache(cache_file, header.num_nodes, params_st)) {
+        fclose(cache_file);
+        allocator.deallocate(cache_path, allocator.state);
+        return true;
+      }
+      /// A fresh cache failed to load: it is corrupt, drop it and reparse
+      (void)remove(cache_path);
     }
+    fclose(cache_file);
   }
 
-  if (NULL == value) {
-    return RCL_RET_INVALID_ARGUMENT;
+  first_node_idx = params_st->num_nodes;
+  if (!rcl_parse_yaml_file(file_path, params_st)) {
+    allocator.deallocate(cache_path, allocator.state);
+    return false;
   }
-  num_nodes = params_st->num_nodes;  // New node index
-  if (num_nodes > 0U) {
-    node_idx = (num_nodes - 1U);  // Current node index
+
+  header.magic = CACHE_MAGIC;
+  header.version = CACHE_VERSION;
+  header.yaml_mtime = (int64_t)yaml_stat.st_mtime;
+  header.yaml_size = (int64_t)yaml_stat.st_size;
+  header.num_nodes = (uint64_t)(params_st->num_nodes - first_node_idx);
+  /// Failing to write the cache only loses the speedup, not the parse
+  (void)save_params_cache(cache_path, &header, params_st, first_node_idx);
+
+  allocator.deallocate(cache_path, allocator.state);
+  return true;
+}
+
+/// In-memory binary serialization of a parameter structure.
+/// The wire format is versioned and length prefixed: a fixed header, then
+/// per node its name, a parameter count and each parameter's name and
+/// tagged value. Strings are stored with their NUL terminator so the
+/// deserializer can intern them straight out of the buffer, and POD arrays
+/// are stored as raw element blocks copied with a single memcpy.
+#define SERIAL_MAGIC 0x53505052U
+#define SERIAL_VERSION 1U
+
+typedef struct serial_header_s
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t num_nodes;
+} serial_header_t;
+
+/// Bounds checked cursor over a serialization buffer
+typedef struct serial_cursor_s
+{
+  uint8_t * data;
+  size_t size;
+  size_t pos;
+} serial_cursor_t;
+
+///
+/// Copy length bytes into the buffer at the cursor position
+///
+static bool serial_write(serial_cursor_t * cursor, const void * src, const size_t length)
+{
+  if (length > (cursor->size - cursor->pos)) {
+    return false;
   }
+  memcpy(&(cursor->data[cursor->pos]), src, length);
+  cursor->pos += length;
+  return true;
+}
 
-  switch (*map_level) {
-    case MAP_UNINIT_LVL:
-      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Unintialized map level at line %d", line_num);
-      res = RCL_RET_ERROR;
-      break;
-    case MAP_NODE_NAME_LVL:
-      {
-        /// Till we get PARAMS_KEY, keep adding to node namespace
-        if (0 != strncmp(PARAMS_KEY, value, strlen(PARAMS_KEY))) {
-          res = add_name_to_ns(ns_tracker, value, NS_TYPE_NODE, allocator);
-          if (RCL_RET_OK != res) {
-            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-              "Internal error adding node namespace at line %d", line_num);
-            return res;
-          }
-        } else {
-          if (0U == ns_tracker->num_node_ns) {
-            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-              "There are no node names before %s at line %d", PARAMS_KEY, line_num);
-            return RCL_RET_ERROR;
-          }
-          /// The previous key(last name in namespace) was the node name. Remove it
-          /// from the namespace
-          char * node_name_ns = rcutils_strdup(ns_tracker->node_ns, allocator);
-          if (NULL == node_name_ns) {
-            return RCL_RET_BAD_ALLOC;
-          }
-          params_st->node_names[num_nodes] = node_name_ns;
+///
+/// Copy length bytes out of the buffer at the cursor position
+///
+static bool serial_read(serial_cursor_t * cursor, void * dst, const size_t length)
+{
+  if (length > (cursor->size - cursor->pos)) {
+    return false;
+  }
+  memcpy(dst, &(cursor->data[cursor->pos]), length);
+  cursor->pos += length;
+  return true;
+}
 
-          res = rem_name_from_ns(ns_tracker, NS_TYPE_NODE, allocator);
-          if (RCL_RET_OK != res) {
-            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-              "Internal error adding node namespace at line %d", line_num);
-            return res;
-          }
-          res = node_params_init(&(params_st->params[num_nodes]), allocator);
-          if (RCL_RET_OK != res) {
-            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-              "Error creating node parameter at line %d", line_num);
-            return RCL_RET_ERROR;
-          }
-          params_st->num_nodes++;
-          /// Bump the map level to PARAMS
-          (*map_level)++;
-        }
-      }
-      break;
-    case MAP_PARAMS_LVL:
-      {
-        char * parameter_ns;
-        size_t parameter_idx;
-        char * param_name;
+///
+/// Write a length prefixed string, NUL terminator included, to the buffer
+///
+static bool serial_write_string(serial_cursor_t * cursor, const char * str)
+{
+  const uint32_t len = (uint32_t)(strlen(str) + 1U);
 
-        /// If it is a new map, the previous key is param namespace
-        if (true == *is_new_map) {
-          params_st->params[node_idx].num_params--;
-          parameter_idx = params_st->params[node_idx].num_params;
-          parameter_ns = params_st->params[node_idx].parameter_names[parameter_idx];
-          if (NULL == parameter_ns) {
-            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-              "Internal error creating param namespace at line %d", line_num);
-            return RCL_RET_ERROR;
-          }
-          res = replace_ns(ns_tracker, parameter_ns, (ns_tracker->num_parameter_ns + 1U),
-              NS_TYPE_PARAM, allocator);
-          if (RCL_RET_OK != res) {
-            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-              "Internal error replacing namespace at line %d", line_num);
-            return RCL_RET_ERROR;
-          }
-          *is_new_map = false;
-        }
-        /// Add a parameter name into the node parameters
-        parameter_idx = params_st->params[node_idx].num_params;
-        parameter_ns = ns_tracker->parameter_ns;
-        if (NULL == parameter_ns) {
-          param_name = rcutils_strdup(value, allocator);
-          if (NULL == param_name) {
-            return RCL_RET_BAD_ALLOC;
-          }
-        } else {
-          const size_t params_ns_len = strlen(parameter_ns);
-          const size_t param_name_len = strlen(value);
-          const size_t tot_len = (params_ns_len + param_name_len + 2U);
+  return serial_write(cursor, &len, sizeof(len)) && serial_write(cursor, str, len);
+}
 
-          if (tot_len > MAX_STRING_SIZE) {
-            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-              "The name length exceeds the MAX size %d at line %d", MAX_STRING_SIZE, line_num);
-            return RCL_RET_OK;
-          }
+///
+/// Return a pointer to the next length prefixed string inside the buffer
+/// The string is not copied; it stays valid as long as the buffer does
+///
+static const char * serial_read_string(serial_cursor_t * cursor)
+{
+  uint32_t len;
+  const char * str;
 
-          param_name = allocator.zero_allocate(1U, tot_len, allocator.state);
-          if (NULL == param_name) {
-            return RCL_RET_BAD_ALLOC;
-          }
+  if (!serial_read(cursor, &len, sizeof(len))) {
+    return NULL;
+  }
+  if ((0U == len) || (len > (MAX_STRING_SIZE + 1U)) ||
+    (len > (cursor->size - cursor->pos)))
+  {
+    return NULL;
+  }
+  str = (const char *)&(cursor->data[cursor->pos]);
+  if ('\0' != str[len - 1U]) {
+    return NULL;
+  }
+  cursor->pos += len;
+  return str;
+}
 
-          memmove(param_name, parameter_ns, params_ns_len);
-          param_name[params_ns_len] = '.';
-          memmove((param_name + params_ns_len + 1U), value, param_name_len);
-          param_name[tot_len - 1U] = '\0';
-        }
-        params_st->params[node_idx].parameter_names[parameter_idx] = param_name;
-        params_st->params[node_idx].num_params++;
+///
+/// Number of buffer bytes a length prefixed string occupies
+///
+static size_t serial_string_size(const char * str)
+{
+  return sizeof(uint32_t) + strlen(str) + 1U;
+}
+
+///
+/// Number of buffer bytes one tagged parameter value occupies
+/// Returns zero for a parameter without a value, which cannot come out of
+/// a successful parse
+///
+static size_t serial_value_size(const rcl_variant_t * param_var)
+{
+  size_t size = sizeof(uint8_t);
+
+  if (NULL != param_var->bool_value) {
+    return size + sizeof(bool);
+  } else if (NULL != param_var->integer_value) {
+    return size + sizeof(int64_t);
+  } else if (NULL != param_var->double_value) {
+    return size + sizeof(double);
+  } else if (NULL != param_var->string_value) {
+    return size + serial_string_size(param_var->string_value);
+  } else if (NULL != param_var->bool_array_value) {
+    return size + sizeof(uint32_t) + (param_var->bool_array_value->size * sizeof(bool));
+  } else if (NULL != param_var->integer_array_value) {
+    return size + sizeof(uint32_t) + (param_var->integer_array_value->size * sizeof(int64_t));
+  } else if (NULL != param_var->double_array_value) {
+    return size + sizeof(uint32_t) + (param_var->double_array_value->size * sizeof(double));
+  } else if (NULL != param_var->string_array_value) {
+    size += sizeof(uint32_t);
+    for (size_t idx = 0U; idx < param_var->string_array_value->size; idx++) {
+      size += serial_string_size(param_var->string_array_value->data[idx]);
+    }
+    return size;
+  }
+  return 0U;
+}
+
+///
+/// Number of buffer bytes the whole structure occupies, or zero when it
+/// holds a parameter that cannot be serialized
+///
+static size_t serial_params_size(const rcl_params_t * params_st)
+{
+  size_t size = sizeof(serial_header_t);
+  size_t node_idx;
+  size_t parameter_idx;
+
+  for (node_idx = 0U; node_idx < params_st->num_nodes; node_idx++) {
+    const rcl_node_params_t * node_params = &(params_st->params[node_idx]);
+
+    size += serial_string_size(params_st->node_names[node_idx]);
+    size += sizeof(uint32_t);
+    for (parameter_idx = 0U; parameter_idx < node_params->num_params; parameter_idx++) {
+      const size_t value_size =
+        serial_value_size(&(node_params->parameter_values[parameter_idx]));
+
+      if (0U == value_size) {
+        return 0U;
       }
-      break;
-    default:
-      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Unknown map level at line %d", line_num);
-      res = RCL_RET_ERROR;
-      break;
+      size += serial_string_size(node_params->parameter_names[parameter_idx]);
+      size += value_size;
+    }
+  }
+  return size;
+}
+
+///
+/// Write one tagged parameter value into the buffer
+///
+static bool serial_write_value(serial_cursor_t * cursor, const rcl_variant_t * param_var)
+{
+  uint8_t tag;
+  uint32_t count;
+
+  if (NULL != param_var->bool_value) {
+    tag = CACHE_VALUE_BOOL;
+    return serial_write(cursor, &tag, sizeof(tag)) &&
+           serial_write(cursor, param_var->bool_value, sizeof(bool));
+  } else if (NULL != param_var->integer_value) {
+    tag = CACHE_VALUE_INT64;
+    return serial_write(cursor, &tag, sizeof(tag)) &&
+           serial_write(cursor, param_var->integer_value, sizeof(int64_t));
+  } else if (NULL != param_var->double_value) {
+    tag = CACHE_VALUE_DOUBLE;
+    return serial_write(cursor, &tag, sizeof(tag)) &&
+           serial_write(cursor, param_var->double_value, sizeof(double));
+  } else if (NULL != param_var->string_value) {
+    tag = CACHE_VALUE_STRING;
+    return serial_write(cursor, &tag, sizeof(tag)) &&
+           serial_write_string(cursor, param_var->string_value);
+  } else if (NULL != param_var->bool_array_value) {
+    tag = CACHE_VALUE_BOOL_ARRAY;
+    count = (uint32_t)param_var->bool_array_value->size;
+    return serial_write(cursor, &tag, sizeof(tag)) &&
+           serial_write(cursor, &count, sizeof(count)) &&
+           serial_write(cursor, param_var->bool_array_value->values, count * sizeof(bool));
+  } else if (NULL != param_var->integer_array_value) {
+    tag = CACHE_VALUE_INT64_ARRAY;
+    count = (uint32_t)param_var->integer_array_value->size;
+    return serial_write(cursor, &tag, sizeof(tag)) &&
+           serial_write(cursor, &count, sizeof(count)) &&
+           serial_write(cursor, param_var->integer_array_value->values, count * sizeof(int64_t));
+  } else if (NULL != param_var->double_array_value) {
+    tag = CACHE_VALUE_DOUBLE_ARRAY;
+    count = (uint32_t)param_var->double_array_value->size;
+    return serial_write(cursor, &tag, sizeof(tag)) &&
+           serial_write(cursor, &count, sizeof(count)) &&
+           serial_write(cursor, param_var->double_array_value->values, count * sizeof(double));
+  } else if (NULL != param_var->string_array_value) {
+    tag = CACHE_VALUE_STRING_ARRAY;
+    count = (uint32_t)param_var->string_array_value->size;
+    if (!serial_write(cursor, &tag, sizeof(tag)) ||
+      !serial_write(cursor, &count, sizeof(count)))
+    {
+      return false;
+    }
+    for (uint32_t idx = 0U; idx < count; idx++) {
+      if (!serial_write_string(cursor, param_var->string_array_value->data[idx])) {
+        return false;
+      }
+    }
+    return true;
   }
-  return res;
+  return false;
 }
 
 ///
-/// Get events from the parser and process the events
+/// Read one tagged parameter value out of the buffer into a zero
+/// initialized variant
+/// On failure the variant members stay consistent, so param_variant_fini()
+/// can release whatever was read
 ///
-static rcl_ret_t parse_events(
-  yaml_parser_t * parser,
-  namespace_tracker_t * ns_tracker,
+static bool serial_read_value(
+  serial_cursor_t * cursor,
+  rcl_variant_t * param_var,
   rcl_params_t * params_st)
 {
-  int32_t done_parsing = 0;
-  yaml_event_t event;
-  rcl_ret_t res = RCL_RET_OK;
-  bool is_key = true;
-  bool is_seq = false;
-  uint32_t line_num = 0;
-  data_types_t seq_data_type = DATA_TYPE_UNKNOWN;
-  uint32_t map_level = 1U;
-  uint32_t map_depth = 0U;
-  bool is_new_map = false;
-  rcl_allocator_t allocator;
+  uint8_t tag;
+  uint32_t count;
+  const char * str;
+  rcl_allocator_t allocator = params_st->allocator;
 
-  if ((NULL == parser) || (NULL == params_st)) {
-    return RCL_RET_INVALID_ARGUMENT;
+  if (!serial_read(cursor, &tag, sizeof(tag))) {
+    return false;
   }
-  allocator = params_st->allocator;
-
-  while (0 == done_parsing) {
-    if (RCL_RET_OK != res) {
-      return res;
-    }
-    res = yaml_parser_parse(parser, &event);
-    if (0 == res) {
-      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Error parsing a event near line %d", line_num);
-      return RCL_RET_ERROR;
-    } else {
-      res = RCL_RET_OK;
-    }
-    line_num = ((uint32_t)(event.start_mark.line) + 1U);
-    switch (event.type) {
-      case YAML_STREAM_END_EVENT:
-        done_parsing = 1;
-        yaml_event_delete(&event);
-        break;
-      case YAML_SCALAR_EVENT:
-        {
-          /// Need to toggle between key and value at params level
-          if (true == is_key) {
-            res = parse_key(event, &map_level, &is_new_map, ns_tracker,
-                params_st);
-            if (RCL_RET_OK != res) {
-              yaml_event_delete(&event);
-              return res;
-            }
-            is_key = false;
-          } else {
-            /// It is a value
-            if (map_level < (uint32_t)(MAP_PARAMS_LVL)) {
-              RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-                "Cannot have a value before %s at line %d", PARAMS_KEY, line_num);
-              yaml_event_delete(&event);
-              return RCL_RET_ERROR;
-            }
-            res = parse_value(event, is_seq, &seq_data_type, params_st);
-            if (RCL_RET_OK != res) {
-              yaml_event_delete(&event);
-              return res;
-            }
-            if (false == is_seq) {
-              is_key = true;
-            }
-          }
-        }
-        yaml_event_delete(&event);
-        break;
-      case YAML_SEQUENCE_START_EVENT:
-        if (true == is_key) {
-          RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Sequences cannot be key at line %d", line_num);
-          yaml_event_delete(&event);
-          return RCL_RET_ERROR;
-        }
-        if (map_level < (uint32_t)(MAP_PARAMS_LVL)) {
-          RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-            "Sequences can only be values and not keys in params. Error at line %d\n", line_num);
-          yaml_event_delete(&event);
-          return RCL_RET_ERROR;
-        }
-        is_seq = true;
-        seq_data_type = DATA_TYPE_UNKNOWN;
-        yaml_event_delete(&event);
-        break;
-      case YAML_SEQUENCE_END_EVENT:
-        is_seq = false;
-        is_key = true;
-        yaml_event_delete(&event);
-        break;
-      case YAML_MAPPING_START_EVENT:
-        map_depth++;
-        is_new_map = true;
-        is_key = true;
-        /// Disable new map if it is PARAMS_KEY map
-        if ((MAP_PARAMS_LVL == map_level) &&
-          ((map_depth - (ns_tracker->num_node_ns + 1U)) == 2U))
-        {
-          is_new_map = false;
+  switch (tag) {
+    case CACHE_VALUE_BOOL:
+      param_var->bool_value = allocator.zero_allocate(1U, sizeof(bool), allocator.state);
+      return (NULL != param_var->bool_value) &&
+             serial_read(cursor, param_var->bool_value, sizeof(bool));
+    case CACHE_VALUE_INT64:
+      param_var->integer_value = allocator.zero_allocate(1U, sizeof(int64_t), allocator.state);
+      return (NULL != param_var->integer_value) &&
+             serial_read(cursor, param_var->integer_value, sizeof(int64_t));
+    case CACHE_VALUE_DOUBLE:
+      param_var->double_value = allocator.zero_allocate(1U, sizeof(double), allocator.state);
+      return (NULL != param_var->double_value) &&
+             serial_read(cursor, param_var->double_value, sizeof(double));
+    case CACHE_VALUE_STRING:
+      str = serial_read_string(cursor);
+      if (NULL == str) {
+        return false;
+      }
+      param_var->string_value = intern_string(params_st, str);
+      return NULL != param_var->string_value;
+    case CACHE_VALUE_BOOL_ARRAY:
+      if (!serial_read(cursor, &count, sizeof(count)) ||
+        (count > (cursor->size - cursor->pos)))
+      {
+        return false;
+      }
+      param_var->bool_array_value =
+        allocator.zero_allocate(1U, sizeof(rcl_bool_array_t), allocator.state);
+      if (NULL == param_var->bool_array_value) {
+        return false;
+      }
+      param_var->bool_array_value->values =
+        allocator.zero_allocate(count, sizeof(bool), allocator.state);
+      if (NULL == param_var->bool_array_value->values) {
+        return false;
+      }
+      param_var->bool_array_value->size = (size_t)count;
+      return serial_read(cursor, param_var->bool_array_value->values, count * sizeof(bool));
+    case CACHE_VALUE_INT64_ARRAY:
+      if (!serial_read(cursor, &count, sizeof(count)) ||
+        (count > (cursor->size - cursor->pos)))
+      {
+        return false;
+      }
+      param_var->integer_array_value =
+        allocator.zero_allocate(1U, sizeof(rcl_int64_array_t), allocator.state);
+      if (NULL == param_var->integer_array_value) {
+        return false;
+      }
+      param_var->integer_array_value->values =
+        allocator.zero_allocate(count, sizeof(int64_t), allocator.state);
+      if (NULL == param_var->integer_array_value->values) {
+        return false;
+      }
+      param_var->integer_array_value->size = (size_t)count;
+      return serial_read(cursor, param_var->integer_array_value->values,
+               count * sizeof(int64_t));
+    case CACHE_VALUE_DOUBLE_ARRAY:
+      if (!serial_read(cursor, &count, sizeof(count)) ||
+        (count > (cursor->size - cursor->pos)))
+      {
+        return false;
+      }
+      param_var->double_array_value =
+        allocator.zero_allocate(1U, sizeof(rcl_double_array_t), allocator.state);
+      if (NULL == param_var->double_array_value) {
+        return false;
+      }
+      param_var->double_array_value->values =
+        allocator.zero_allocate(count, sizeof(double), allocator.state);
+      if (NULL == param_var->double_array_value->values) {
+        return false;
+      }
+      param_var->double_array_value->size = (size_t)count;
+      return serial_read(cursor, param_var->double_array_value->values,
+               count * sizeof(double));
+    case CACHE_VALUE_STRING_ARRAY:
+      if (!serial_read(cursor, &count, sizeof(count)) ||
+        (count > (cursor->size - cursor->pos)))
+      {
+        return false;
+      }
+      param_var->string_array_value =
+        allocator.zero_allocate(1U, sizeof(rcutils_string_array_t), allocator.state);
+      if (NULL == param_var->string_array_value) {
+        return false;
+      }
+      param_var->string_array_value->allocator = allocator;
+      param_var->string_array_value->data =
+        allocator.zero_allocate(count, sizeof(char *), allocator.state);
+      if (NULL == param_var->string_array_value->data) {
+        return false;
+      }
+      param_var->string_array_value->size = (size_t)count;
+      for (uint32_t idx = 0U; idx < count; idx++) {
+        str = serial_read_string(cursor);
+        if (NULL == str) {
+          return false;
         }
-        yaml_event_delete(&event);
-        break;
-      case YAML_MAPPING_END_EVENT:
-        if (MAP_PARAMS_LVL == map_level) {
-          if (ns_tracker->num_parameter_ns > 0U) {
-            /// Remove param namesapce
-            res = rem_name_from_ns(ns_tracker, NS_TYPE_PARAM, allocator);
-            if (RCL_RET_OK != res) {
-              RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-                "Internal error removing parameter namespace at line %d", line_num);
-              yaml_event_delete(&event);
-              return res;
-            }
-          } else {
-            map_level--;
-          }
-        } else {
-          if ((MAP_NODE_NAME_LVL == map_level) &&
-            (map_depth == (ns_tracker->num_node_ns + 1U)))
-          {
-            /// Remove node namespace
-            res = rem_name_from_ns(ns_tracker, NS_TYPE_NODE, allocator);
-            if (RCL_RET_OK != res) {
-              RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-                "Internal error removing node namespace at line %d", line_num);
-              yaml_event_delete(&event);
-              return res;
-            }
-          }
+        param_var->string_array_value->data[idx] = rcutils_strdup(str, allocator);
+        if (NULL == param_var->string_array_value->data[idx]) {
+          return false;
         }
-        map_depth--;
-        yaml_event_delete(&event);
-        break;
-      case YAML_ALIAS_EVENT:
-        RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-          "Will not support aliasing at line %d\n", line_num);
-        res = RCL_RET_ERROR;
-        yaml_event_delete(&event);
-        break;
-      case YAML_STREAM_START_EVENT:
-        yaml_event_delete(&event);
-        break;
-      case YAML_DOCUMENT_START_EVENT:
-        yaml_event_delete(&event);
-        break;
-      case YAML_DOCUMENT_END_EVENT:
-        yaml_event_delete(&event);
-        break;
-      case YAML_NO_EVENT:
-        RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-          "Received an empty event at line %d", line_num);
-        res = RCL_RET_ERROR;
-        yaml_event_delete(&event);
-        break;
-      default:
-        RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Unknown YAML event at line %d", line_num);
-        res = RCL_RET_ERROR;
-        yaml_event_delete(&event);
-        break;
-    }
+      }
+      return true;
+    default:
+      return false;
   }
-  return res;
 }
 
 ///
-/// TODO (anup.pemmaiah): Support string yaml similar to yaml file
-/// TODO (anup.pemmaiah): Support Mutiple yaml files
-///
+/// Serialize the param structure into a binary buffer
 ///
-/// Parse the YAML file and populate params_st
-///
-bool rcl_parse_yaml_file(
-  const char * file_path,
-  rcl_params_t * params_st)
+bool rcl_params_serialize(
+  const rcl_params_t * params_st,
+  rcl_byte_array_t * buffer)
 {
-  int32_t res;
-  FILE * yaml_file;
-  yaml_parser_t parser;
-  namespace_tracker_t ns_tracker;
-  rcutils_allocator_t allocator;
+  serial_cursor_t cursor;
+  serial_header_t header;
+  size_t total_size;
+  size_t node_idx;
+  size_t parameter_idx;
+  bool write_ok = true;
+  rcl_allocator_t allocator;
 
   if (NULL == params_st) {
     RCUTILS_SAFE_FWRITE_TO_STDERR("Pass a initialized paramter structure");
     return false;
   }
+  if (NULL == buffer) {
+    RCL_SET_ERROR_MSG("Serialization buffer is NULL");
+    return false;
+  }
   allocator = params_st->allocator;
 
-  if (NULL == file_path) {
-    RCL_SET_ERROR_MSG("YAML file path is NULL");
+  total_size = serial_params_size(params_st);
+  if (0U == total_size) {
+    RCL_SET_ERROR_MSG("Cannot serialize a parameter without a value");
     return false;
   }
 
-  res = yaml_parser_initialize(&parser);
-  if (0 == res) {
-    RCL_SET_ERROR_MSG("Could not initialize the parser");
+  buffer->values = allocator.zero_allocate(total_size, sizeof(uint8_t), allocator.state);
+  if (NULL == buffer->values) {
+    RCL_SET_ERROR_MSG("Error allocating serialization buffer");
     return false;
   }
+  buffer->size = total_size;
+
+  cursor.data = buffer->values;
+  cursor.size = total_size;
+  cursor.pos = 0U;
+
+  header.magic = SERIAL_MAGIC;
+  header.version = SERIAL_VERSION;
+  header.num_nodes = (uint64_t)params_st->num_nodes;
+  write_ok = serial_write(&cursor, &header, sizeof(header));
+  for (node_idx = 0U; write_ok && (node_idx < params_st->num_nodes); node_idx++) {
+    const rcl_node_params_t * node_params = &(params_st->params[node_idx]);
+    const uint32_t num_params = (uint32_t)node_params->num_params;
+
+    write_ok = serial_write_string(&cursor, params_st->node_names[node_idx]) &&
+      serial_write(&cursor, &num_params, sizeof(num_params));
+    for (parameter_idx = 0U; write_ok && (parameter_idx < node_params->num_params);
+      parameter_idx++)
+    {
+      write_ok = serial_write_string(&cursor, node_params->parameter_names[parameter_idx]) &&
+        serial_write_value(&cursor, &(node_params->parameter_values[parameter_idx]));
+    }
+  }
 
-  yaml_file = fopen(file_path, "r");
-  if (NULL == yaml_file) {
-    yaml_parser_delete(&parser);
-    RCL_SET_ERROR_MSG("Error opening YAML file");
+  if (!write_ok || (cursor.pos != total_size)) {
+    allocator.deallocate(buffer->values, allocator.state);
+    buffer->values = NULL;
+    buffer->size = 0U;
+    RCL_SET_ERROR_MSG("Error serializing parameter structure");
     return false;
   }
+  return true;
+}
 
-  yaml_parser_set_input_file(&parser, yaml_file);
+///
+/// Deserialize a binary buffer into a new param structure
+///
+rcl_params_t * rcl_params_deserialize(
+  const rcl_byte_array_t * buffer,
+  const rcutils_allocator_t allocator)
+{
+  serial_cursor_t cursor;
+  serial_header_t header;
+  uint64_t node_idx;
+  uint32_t parameter_idx;
+  bool read_ok = true;
+  rcl_params_t * params_st;
 
-  memset(&ns_tracker, 0, sizeof(namespace_tracker_t));
-  res = parse_events(&parser, &ns_tracker, params_st);
+  if ((NULL == buffer) || (NULL == buffer->values)) {
+    RCL_SET_ERROR_MSG("Serialization buffer is NULL");
+    return NULL;
+  }
 
-  yaml_parser_delete(&parser);
-  fclose(yaml_file);
+  cursor.data = buffer->values;
+  cursor.size = buffer->size;
+  cursor.pos = 0U;
 
-  if (RCL_RET_OK != res) {
-    if (NULL != ns_tracker.node_ns) {
-      allocator.deallocate(ns_tracker.node_ns, allocator.state);
+  if (!serial_read(&cursor, &header, sizeof(header)) ||
+    (SERIAL_MAGIC != header.magic) ||
+    (SERIAL_VERSION != header.version))
+  {
+    RCL_SET_ERROR_MSG("Malformed parameter serialization header");
+    return NULL;
+  }
+
+  params_st = rcl_yaml_node_struct_init(allocator);
+  if (NULL == params_st) {
+    return NULL;
+  }
+
+  for (node_idx = 0U; read_ok && (node_idx < header.num_nodes); node_idx++) {
+    rcl_node_params_t * node_params;
+    uint32_t num_params;
+    char * node_name;
+    const char * str = serial_read_string(&cursor);
+
+    if (NULL == str) {
+      read_ok = false;
+      break;
     }
-    if (NULL != ns_tracker.parameter_ns) {
-      allocator.deallocate(ns_tracker.parameter_ns, allocator.state);
+    node_name = intern_string(params_st, str);
+    if (NULL == node_name) {
+      read_ok = false;
+      break;
+    }
+    if ((RCL_RET_OK != ensure_array_capacity((void **)&(params_st->node_names), sizeof(char *),
+      (params_st->num_nodes + 1U), allocator)) ||
+      (RCL_RET_OK != ensure_array_capacity((void **)&(params_st->params),
+      sizeof(rcl_node_params_t), (params_st->num_nodes + 1U), allocator)))
+    {
+      read_ok = false;
+      break;
+    }
+    params_st->node_names[params_st->num_nodes] = node_name;
+    node_params = &(params_st->params[params_st->num_nodes]);
+    (void)node_params_init(node_params, allocator);
+    params_st->num_nodes++;
+
+    if (!serial_read(&cursor, &num_params, sizeof(num_params))) {
+      read_ok = false;
+      break;
+    }
+    for (parameter_idx = 0U; read_ok && (parameter_idx < num_params); parameter_idx++) {
+      char * param_name;
+
+      str = serial_read_string(&cursor);
+      if (NULL == str) {
+        read_ok = false;
+        break;
+      }
+      param_name = intern_string(params_st, str);
+      if (NULL == param_name) {
+        read_ok = false;
+        break;
+      }
+      if ((RCL_RET_OK != ensure_array_capacity((void **)&(node_params->parameter_names),
+        sizeof(char *), (node_params->num_params + 1U), allocator)) ||
+        (RCL_RET_OK != ensure_array_capacity((void **)&(node_params->parameter_values),
+        sizeof(rcl_variant_t), (node_params->num_params + 1U), allocator)))
+      {
+        read_ok = false;
+        break;
+      }
+      node_params->parameter_names[node_params->num_params] = param_name;
+      node_params->num_params++;
+      read_ok = serial_read_value(&cursor,
+          &(node_params->parameter_values[node_params->num_params - 1U]), params_st);
     }
-    rcl_yaml_node_struct_fini(params_st);
-    return false;
   }
 
-  return true;
+  if (!read_ok || (cursor.pos != cursor.size)) {
+    RCL_SET_ERROR_MSG("Malformed parameter serialization");
+    rcl_yaml_node_struct_fini(params_st);
+    return NULL;
+  }
+  return params_st;
 }
@@ -0,0 +1,162 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Parser benchmarks over a corpus of pathological parameter files: a huge
+// double array, deeply nested namespaces, a file with many nodes, and a
+// string-heavy file.  Each case reports the mean parse time and, through
+// rcl's instrumented allocator, the allocation count and peak bytes in use
+// per parse, so parser performance work has a yardstick and regressions in
+// either time or allocation behavior show up as changed numbers.
+//
+// The corpus is generated deterministically into the working directory at
+// startup (the interesting files are megabytes of repetitive YAML, which is
+// not worth committing) and removed afterwards.  Not registered with ctest;
+// run the executable manually.
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+
+#include "rcl/instrumented_allocator.h"
+#include "rcl_yaml_param_parser/parser.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+
+namespace
+{
+
+constexpr int kWarmupIterations = 2;
+constexpr int kBenchmarkIterations = 20;
+
+bool generate_huge_double_array(FILE * out)
+{
+  fprintf(out, "benchmark_node:\n  ros__parameters:\n    big_array: [");
+  for (int i = 0; i < 100000; ++i) {
+    fprintf(out, "%s%d.%06d", i ? ", " : "", i, i);
+  }
+  fprintf(out, "]\n");
+  return true;
+}
+
+bool generate_deep_namespaces(FILE * out)
+{
+  constexpr int kDepth = 64;
+  fprintf(out, "benchmark_node:\n  ros__parameters:\n");
+  std::string indent = "    ";
+  for (int level = 0; level < kDepth; ++level) {
+    fprintf(out, "%slevel_%d:\n", indent.c_str(), level);
+    indent += "  ";
+    fprintf(out, "%sparam_at_%d: %d\n", indent.c_str(), level, level);
+  }
+  return true;
+}
+
+bool generate_many_nodes(FILE * out)
+{
+  for (int node = 0; node < 1000; ++node) {
+    fprintf(out, "node_%d:\n  ros__parameters:\n", node);
+    for (int param = 0; param < 10; ++param) {
+      fprintf(out, "    param_%d: %d\n", param, node * 10 + param);
+    }
+  }
+  return true;
+}
+
+bool generate_string_heavy(FILE * out)
+{
+  const std::string filler(96, 'x');
+  for (int node = 0; node < 100; ++node) {
+    fprintf(out, "string_node_%d:\n  ros__parameters:\n", node);
+    for (int param = 0; param < 50; ++param) {
+      fprintf(
+        out, "    string_param_%d: \"%d_%s\"\n", param, node * 50 + param, filler.c_str());
+    }
+  }
+  return true;
+}
+
+// Writes one corpus file, parses it repeatedly with an instrumented
+// allocator, and prints the mean parse time with the per-parse allocation
+// statistics (which are identical every iteration, being the same input).
+bool run_case(const std::string & name, bool (* generate)(FILE *))
+{
+  const std::string path = "benchmark_" + name + ".yaml";
+  FILE * out = fopen(path.c_str(), "w");
+  if (nullptr == out) {
+    fprintf(stderr, "%-24s failed to create %s\n", name.c_str(), path.c_str());
+    return false;
+  }
+  bool ok = generate(out);
+  ok = (0 == fclose(out)) && ok;
+  if (!ok) {
+    remove(path.c_str());
+    return false;
+  }
+
+  rcl_allocator_t base_allocator = rcutils_get_default_allocator();
+  int64_t total_ns = 0;
+  rcl_allocator_stats_t stats = rcl_get_zero_initialized_allocator_stats();
+  for (int i = 0; ok && i < kWarmupIterations + kBenchmarkIterations; ++i) {
+    stats = rcl_get_zero_initialized_allocator_stats();
+    stats.tag = name.c_str();
+    rcl_allocator_t allocator = rcl_get_instrumented_allocator(&base_allocator, &stats);
+    const auto start = std::chrono::steady_clock::now();
+    rcl_params_t * params = rcl_yaml_node_struct_init(allocator);
+    if (nullptr == params || !rcl_parse_yaml_file(path.c_str(), params)) {
+      // rcl_parse_yaml_file frees the structure when it fails
+      fprintf(
+        stderr, "%-24s failed to parse: %s\n", name.c_str(),
+        rcutils_get_error_string().str);
+      rcutils_reset_error();
+      ok = false;
+      break;
+    }
+    const auto parsed = std::chrono::steady_clock::now();
+    rcl_yaml_node_struct_fini(params);
+    if (i >= kWarmupIterations) {
+      total_ns +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(parsed - start).count();
+    }
+  }
+  if (ok) {
+    printf(
+      "%-24s %8" PRId64 " us/parse %10" PRIu64 " allocs %12" PRIu64 " peak bytes\n",
+      name.c_str(), total_ns / kBenchmarkIterations / 1000,
+      stats.allocation_count, stats.peak_bytes_in_use);
+  }
+  remove(path.c_str());
+  return ok;
+}
+
+}  // namespace
+
+int main()
+{
+  int result = 0;
+  if (!run_case("huge_double_array", generate_huge_double_array)) {
+    result = 1;
+  }
+  if (!run_case("deep_namespaces", generate_deep_namespaces)) {
+    result = 1;
+  }
+  if (!run_case("many_nodes", generate_many_nodes)) {
+    result = 1;
+  }
+  if (!run_case("string_heavy", generate_string_heavy)) {
+    result = 1;
+  }
+  return result;
+}
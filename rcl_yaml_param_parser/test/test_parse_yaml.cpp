@@ -13,8 +13,11 @@
 // limitations under the License.
 
 #include <stdio.h>
+#include <string.h>
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include "rcl_yaml_param_parser/parser.h"
 
 #include "rcutils/allocator.h"
@@ -121,6 +124,388 @@ TEST(test_file_parser, seq_map2) {
   allocator.deallocate(path, allocator.state);
 }
 
+// Several files parse into one structure, later files after earlier ones
+TEST(test_file_parser, multiple_files) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path1 = rcutils_join_path(test_path, "correct_config.yaml", allocator);
+  char * path2 = rcutils_join_path(test_path, "multi_ns_correct.yaml", allocator);
+  EXPECT_TRUE(rcutils_exists(path1));
+  EXPECT_TRUE(rcutils_exists(path2));
+  const char * paths[2] = {path1, path2};
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  size_t num_nodes_single = 0U;
+  {
+    rcl_params_t * single_hdl = rcl_yaml_node_struct_init(allocator);
+    EXPECT_FALSE(NULL == single_hdl);
+    EXPECT_TRUE(rcl_parse_yaml_file(path1, single_hdl));
+    num_nodes_single = single_hdl->num_nodes;
+    rcl_yaml_node_struct_fini(single_hdl);
+  }
+  bool res = rcl_parse_yaml_files(paths, 2U, params_hdl);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  EXPECT_TRUE(res);
+  EXPECT_GT(params_hdl->num_nodes, num_nodes_single);
+  // Nodes of the first file come first
+  EXPECT_STREQ(params_hdl->node_names[0], "lidar_ns/lidar_1");
+  rcl_yaml_node_struct_fini(params_hdl);
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(path1, allocator.state);
+  allocator.deallocate(path2, allocator.state);
+}
+
+// Repeated names across nodes share one interned copy
+TEST(test_file_parser, interned_names) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path = rcutils_join_path(test_path, "multi_ns_correct.yaml", allocator);
+  fprintf(stderr, "cur_path: %s\n", path);
+  EXPECT_TRUE(rcutils_exists(path));
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  bool res = rcl_parse_yaml_file(path, params_hdl);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  EXPECT_TRUE(res);
+  // "drive_px" and "intel" both declare "num_cores" and "arch"
+  const char * first_seen = NULL;
+  size_t num_occurrences = 0U;
+  for (size_t node_idx = 0U; node_idx < params_hdl->num_nodes; node_idx++) {
+    const rcl_node_params_t * node_params = &(params_hdl->params[node_idx]);
+    for (size_t parameter_idx = 0U; parameter_idx < node_params->num_params; parameter_idx++) {
+      if (0 == strcmp("num_cores", node_params->parameter_names[parameter_idx])) {
+        if (NULL == first_seen) {
+          first_seen = node_params->parameter_names[parameter_idx];
+        }
+        EXPECT_EQ(first_seen, node_params->parameter_names[parameter_idx]);
+        num_occurrences++;
+      }
+    }
+  }
+  EXPECT_EQ(2U, num_occurrences);
+  rcl_yaml_node_struct_fini(params_hdl);
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(path, allocator.state);
+}
+
+// Copies share the payload until one of them is parsed into again
+TEST(test_file_parser, node_struct_copy) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path = rcutils_join_path(test_path, "multi_ns_correct.yaml", allocator);
+  char * second_path = rcutils_join_path(test_path, "correct_config.yaml", allocator);
+  fprintf(stderr, "cur_path: %s\n", path);
+  EXPECT_TRUE(rcutils_exists(path));
+  EXPECT_TRUE(rcutils_exists(second_path));
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  bool res = rcl_parse_yaml_file(path, params_hdl);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  EXPECT_TRUE(res);
+  const size_t num_nodes = params_hdl->num_nodes;
+  rcl_params_t * copy_hdl = rcl_yaml_node_struct_copy(params_hdl);
+  ASSERT_FALSE(NULL == copy_hdl);
+  // the payload is shared, not duplicated
+  EXPECT_EQ(params_hdl->params, copy_hdl->params);
+  EXPECT_EQ(num_nodes, copy_hdl->num_nodes);
+  // parsing into the copy detaches it onto its own payload
+  res = rcl_parse_yaml_file(second_path, copy_hdl);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  EXPECT_TRUE(res);
+  EXPECT_NE(params_hdl->params, copy_hdl->params);
+  EXPECT_EQ(num_nodes, params_hdl->num_nodes);
+  EXPECT_GT(copy_hdl->num_nodes, num_nodes);
+  // the original is untouched and survives the copy being freed
+  rcl_yaml_node_struct_fini(copy_hdl);
+  EXPECT_STREQ(params_hdl->node_names[0], "camera/camera1");
+  rcl_yaml_node_struct_fini(params_hdl);
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(path, allocator.state);
+  allocator.deallocate(second_path, allocator.state);
+}
+
+// Name lookups through the hash index find the same entries a scan would
+TEST(test_file_parser, node_struct_index) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path = rcutils_join_path(test_path, "multi_ns_correct.yaml", allocator);
+  fprintf(stderr, "cur_path: %s\n", path);
+  EXPECT_TRUE(rcutils_exists(path));
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  bool res = rcl_parse_yaml_file(path, params_hdl);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  EXPECT_TRUE(res);
+  rcl_params_index_t * params_index = rcl_yaml_node_struct_index_init(params_hdl);
+  EXPECT_FALSE(NULL == params_index);
+  rcl_node_params_t * node_params =
+    rcl_yaml_node_struct_index_find_node(params_index, "camera/camera1");
+  EXPECT_FALSE(NULL == node_params);
+  EXPECT_TRUE(NULL == rcl_yaml_node_struct_index_find_node(params_index, "no/such_node"));
+  rcl_variant_t * param_value =
+    rcl_yaml_node_struct_index_find_parameter(params_index, "intel", "num_cores");
+  EXPECT_FALSE(NULL == param_value);
+  ASSERT_FALSE(NULL == param_value->integer_value);
+  EXPECT_EQ(8, *(param_value->integer_value));
+  EXPECT_TRUE(NULL == rcl_yaml_node_struct_index_find_parameter(params_index, "intel", "nope"));
+  rcl_yaml_node_struct_index_fini(params_index);
+  rcl_yaml_node_struct_fini(params_hdl);
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(path, allocator.state);
+}
+
+// A serialized structure deserializes back to equivalent contents
+TEST(test_file_parser, serialize_roundtrip) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path = rcutils_join_path(test_path, "multi_ns_correct.yaml", allocator);
+  fprintf(stderr, "cur_path: %s\n", path);
+  EXPECT_TRUE(rcutils_exists(path));
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  bool res = rcl_parse_yaml_file(path, params_hdl);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  EXPECT_TRUE(res);
+  rcl_byte_array_t buffer = {NULL, 0U};
+  res = rcl_params_serialize(params_hdl, &buffer);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  ASSERT_TRUE(res);
+  ASSERT_FALSE(NULL == buffer.values);
+  EXPECT_GT(buffer.size, 0U);
+  rcl_params_t * copy_hdl = rcl_params_deserialize(&buffer, allocator);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  ASSERT_FALSE(NULL == copy_hdl);
+  EXPECT_EQ(params_hdl->num_nodes, copy_hdl->num_nodes);
+  rcl_params_index_t * params_index = rcl_yaml_node_struct_index_init(copy_hdl);
+  EXPECT_FALSE(NULL == params_index);
+  rcl_variant_t * param_value =
+    rcl_yaml_node_struct_index_find_parameter(params_index, "intel", "num_cores");
+  EXPECT_FALSE(NULL == param_value);
+  ASSERT_FALSE(NULL == param_value->integer_value);
+  EXPECT_EQ(8, *(param_value->integer_value));
+  rcl_yaml_node_struct_index_fini(params_index);
+  rcl_yaml_node_struct_fini(copy_hdl);
+  // A corrupted header is rejected rather than deserialized
+  buffer.values[0] = static_cast<uint8_t>(buffer.values[0] + 1U);
+  EXPECT_TRUE(NULL == rcl_params_deserialize(&buffer, allocator));
+  rcutils_reset_error();
+  allocator.deallocate(buffer.values, allocator.state);
+  rcl_yaml_node_struct_fini(params_hdl);
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(path, allocator.state);
+}
+
+// The validate-only pass accepts what the parser accepts and rejects what
+// the parser rejects, without building a structure
+TEST(test_file_parser, validate_only) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path = rcutils_join_path(test_path, "correct_config.yaml", allocator);
+  fprintf(stderr, "cur_path: %s\n", path);
+  EXPECT_TRUE(rcutils_exists(path));
+  EXPECT_TRUE(rcl_validate_yaml_file(path));
+  allocator.deallocate(path, allocator.state);
+  path = rcutils_join_path(test_path, "multi_ns_correct.yaml", allocator);
+  EXPECT_TRUE(rcutils_exists(path));
+  EXPECT_TRUE(rcl_validate_yaml_file(path));
+  allocator.deallocate(path, allocator.state);
+  path = rcutils_join_path(test_path, "no_value1.yaml", allocator);
+  EXPECT_TRUE(rcutils_exists(path));
+  EXPECT_FALSE(rcl_validate_yaml_file(path));
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  rcutils_reset_error();
+  allocator.deallocate(path, allocator.state);
+  path = rcutils_join_path(test_path, "params_with_no_node.yaml", allocator);
+  EXPECT_TRUE(rcutils_exists(path));
+  EXPECT_FALSE(rcl_validate_yaml_file(path));
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  rcutils_reset_error();
+  allocator.deallocate(path, allocator.state);
+  allocator.deallocate(test_path, allocator.state);
+}
+
+// Reparsing an unchanged file updates nothing; a different file reports
+// its additions as changes
+TEST(test_file_parser, incremental_update) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path = rcutils_join_path(test_path, "multi_ns_correct.yaml", allocator);
+  char * second_path = rcutils_join_path(test_path, "correct_config.yaml", allocator);
+  fprintf(stderr, "cur_path: %s\n", path);
+  EXPECT_TRUE(rcutils_exists(path));
+  EXPECT_TRUE(rcutils_exists(second_path));
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  bool res = rcl_parse_yaml_file(path, params_hdl);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  EXPECT_TRUE(res);
+  const size_t num_nodes = params_hdl->num_nodes;
+  rcl_variant_t * param_value = nullptr;
+  for (size_t node_idx = 0U; node_idx < params_hdl->num_nodes; node_idx++) {
+    if (0 == strcmp(params_hdl->node_names[node_idx], "intel")) {
+      param_value = &(params_hdl->params[node_idx].parameter_values[0]);
+    }
+  }
+  ASSERT_FALSE(nullptr == param_value);
+  // an unchanged file leaves the structure and the change set untouched
+  rcl_params_t * changes_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == changes_hdl);
+  res = rcl_parse_yaml_file_update(path, params_hdl, changes_hdl);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  EXPECT_TRUE(res);
+  EXPECT_EQ(0U, changes_hdl->num_nodes);
+  EXPECT_EQ(num_nodes, params_hdl->num_nodes);
+  // unchanged values keep their storage across the update
+  rcl_variant_t * param_value_after = nullptr;
+  for (size_t node_idx = 0U; node_idx < params_hdl->num_nodes; node_idx++) {
+    if (0 == strcmp(params_hdl->node_names[node_idx], "intel")) {
+      param_value_after = &(params_hdl->params[node_idx].parameter_values[0]);
+    }
+  }
+  EXPECT_EQ(param_value, param_value_after);
+  // a different file appends its nodes and reports them as changes
+  res = rcl_parse_yaml_file_update(second_path, params_hdl, changes_hdl);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  EXPECT_TRUE(res);
+  EXPECT_GT(params_hdl->num_nodes, num_nodes);
+  EXPECT_GT(changes_hdl->num_nodes, 0U);
+  rcl_yaml_node_struct_fini(changes_hdl);
+  rcl_yaml_node_struct_fini(params_hdl);
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(path, allocator.state);
+  allocator.deallocate(second_path, allocator.state);
+}
+
+// Only the requested node's section is materialized from a multi node file
+TEST(test_file_parser, parse_for_node) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path = rcutils_join_path(test_path, "multi_ns_correct.yaml", allocator);
+  fprintf(stderr, "cur_path: %s\n", path);
+  EXPECT_TRUE(rcutils_exists(path));
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  bool res = rcl_parse_yaml_file_for_node(path, "camera/camera1", params_hdl);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  EXPECT_TRUE(res);
+  EXPECT_EQ(1U, params_hdl->num_nodes);
+  EXPECT_STREQ("camera/camera1", params_hdl->node_names[0]);
+  rcl_yaml_node_struct_print(params_hdl);
+  rcl_yaml_node_struct_fini(params_hdl);
+  // A name matching no section yields an empty result, not an error
+  params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  res = rcl_parse_yaml_file_for_node(path, "no/such_node", params_hdl);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  EXPECT_TRUE(res);
+  EXPECT_EQ(0U, params_hdl->num_nodes);
+  rcl_yaml_node_struct_fini(params_hdl);
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(path, allocator.state);
+}
+
+// A cold call writes the sidecar cache, a warm call loads it back
+TEST(test_file_parser, cached_parse) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path = rcutils_join_path(test_path, "correct_config.yaml", allocator);
+  fprintf(stderr, "cur_path: %s\n", path);
+  EXPECT_TRUE(rcutils_exists(path));
+  std::string cache_path = std::string(path) + ".pcache";
+  remove(cache_path.c_str());
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  bool res = rcl_parse_yaml_file_cached(path, params_hdl);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  EXPECT_TRUE(res);
+  EXPECT_TRUE(rcutils_exists(cache_path.c_str()));
+  size_t num_nodes = params_hdl->num_nodes;
+  rcl_yaml_node_struct_fini(params_hdl);
+  // Second parse should be served from the cache and yield the same nodes
+  params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  res = rcl_parse_yaml_file_cached(path, params_hdl);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  EXPECT_TRUE(res);
+  EXPECT_EQ(num_nodes, params_hdl->num_nodes);
+  rcl_yaml_node_struct_print(params_hdl);
+  rcl_yaml_node_struct_fini(params_hdl);
+  remove(cache_path.c_str());
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(path, allocator.state);
+}
+
+// Doubles whose leading zeros exhaust the fast-path digit budget must fall
+// back to strtod instead of silently dropping the remaining digits
+TEST(test_file_parser, small_magnitude_doubles) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path = rcutils_join_path(test_path, "small_doubles.yaml", allocator);
+  fprintf(stderr, "cur_path: %s\n", path);
+  EXPECT_TRUE(rcutils_exists(path));
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  bool res = rcl_parse_yaml_file(path, params_hdl);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  EXPECT_TRUE(res);
+  ASSERT_EQ(1U, params_hdl->num_nodes);
+  rcl_node_params_t * node_params = &(params_hdl->params[0]);
+  ASSERT_EQ(2U, node_params->num_params);
+  EXPECT_STREQ("tiny", node_params->parameter_names[0]);
+  ASSERT_FALSE(NULL == node_params->parameter_values[0].double_value);
+  EXPECT_DOUBLE_EQ(1e-19, *(node_params->parameter_values[0].double_value));
+  EXPECT_STREQ("padded", node_params->parameter_names[1]);
+  ASSERT_FALSE(NULL == node_params->parameter_values[1].double_value);
+  EXPECT_DOUBLE_EQ(12.5, *(node_params->parameter_values[1].double_value));
+  rcl_yaml_node_struct_fini(params_hdl);
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(path, allocator.state);
+}
+
+// Sequences and parameter lists longer than the initial array capacity,
+// to exercise the geometric growth of the parsed arrays
+TEST(test_file_parser, long_sequences) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path = rcutils_join_path(test_path, "long_sequences.yaml", allocator);
+  fprintf(stderr, "cur_path: %s\n", path);
+  EXPECT_TRUE(rcutils_exists(path));
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  bool res = rcl_parse_yaml_file(path, params_hdl);
+  fprintf(stderr, "%s\n", rcutils_get_error_string().str);
+  EXPECT_TRUE(res);
+  EXPECT_EQ(1U, params_hdl->num_nodes);
+  EXPECT_EQ(10U, params_hdl->params[0].num_params);
+  EXPECT_EQ(18U, params_hdl->params[0].parameter_values[0].integer_array_value->size);
+  rcl_yaml_node_struct_print(params_hdl);
+  rcl_yaml_node_struct_fini(params_hdl);
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(path, allocator.state);
+}
+
 TEST(test_file_parser, params_with_no_node) {
   rcutils_reset_error();
   EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));